@@ -262,6 +262,11 @@ class _SlowFieldUsageChecker(_FieldUsageCheckerBase):
                             'ctxt.throwMissingField(%s);' % (_get_field_constant_name(field)))
 
 
+# Structs with at least this many parsed fields dispatch on the length of the field name before
+# comparing names, instead of comparing against every field in turn.
+_MIN_FIELDS_FOR_LENGTH_DISPATCH = 6
+
+
 def _gen_field_usage_constant(field):
     # type: (ast.Field) -> str
     """Get the name for a bitset constant in field usage checking."""
@@ -1343,6 +1348,79 @@ class _CppSourceFileWriter(_CppFileWriterBase):
             # Generate namespace check now that "$db" has been read or defaulted
             struct_type_info.gen_namespace_check(self._writer, "_dbName", "commandElement")
 
+    def _gen_field_dispatch_body(self, field, bson_object, field_usage_check):
+        # type: (ast.Field, str, _FieldUsageCheckerBase) -> None
+        """Generate the code run when an element matches the given field."""
+        if field.ignore:
+            field_usage_check.add(field, "element")
+
+            self._writer.write_line('// ignore field')
+        else:
+            self.gen_field_deserializer(field, bson_object, "element", field_usage_check)
+
+    def _gen_unknown_field_check(self, struct):
+        # type: (ast.Struct) -> None
+        """Generate the strict check for a field that matched none of the struct's fields."""
+        # For commands, check if this a well known command field that the IDL parser
+        # should ignore regardless of strict mode.
+        command_predicate = None
+        if isinstance(struct, ast.Command):
+            command_predicate = "!mongo::isGenericArgument(fieldName)"
+
+        with self._predicate(command_predicate):
+            self._writer.write_line('ctxt.throwUnknownField(fieldName);')
+
+    def _gen_fields_chain_dispatch(self, struct, fields, bson_object, field_usage_check):
+        # type: (ast.Struct, List[ast.Field], str, _FieldUsageCheckerBase) -> None
+        """Generate an if/else if chain comparing the field name against each field in turn."""
+        first_field = True
+        for field in fields:
+            field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
+
+            with self._predicate(field_predicate, not first_field):
+                self._gen_field_dispatch_body(field, bson_object, field_usage_check)
+
+            first_field = False
+
+        # Generate strict check for extranous fields
+        if struct.strict:
+            with self._block('else {', '}'):
+                self._gen_unknown_field_check(struct)
+
+    def _gen_fields_length_dispatch(self, struct, fields, bson_object, field_usage_check):
+        # type: (ast.Struct, List[ast.Field], str, _FieldUsageCheckerBase) -> None
+        """
+        Generate a switch on the length of the field name.
+
+        Only the fields whose names have the same length as the element's are compared, so
+        structs with many fields avoid walking every field name for each element.
+        """
+        fields_by_length = {}  # type: Dict[int, List[ast.Field]]
+        for field in fields:
+            fields_by_length.setdefault(len(field.name.encode('utf-8')), []).append(field)
+
+        with self._block('switch (fieldName.size()) {', '}'):
+            for length in sorted(fields_by_length):
+                with self._block('case %d: {' % (length), '}'):
+                    for field in fields_by_length[length]:
+                        field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
+
+                        with self._predicate(field_predicate):
+                            self._gen_field_dispatch_body(field, bson_object, field_usage_check)
+                            self._writer.write_line('continue;')
+
+                    self._writer.write_line('break;')
+
+            self._writer.write_line('default:')
+            self._writer.indent()
+            self._writer.write_line('break;')
+            self._writer.unindent()
+
+        # Every matched field continues the loop, so reaching here means the field is unknown.
+        if struct.strict:
+            self._writer.write_empty_line()
+            self._gen_unknown_field_check(struct)
+
     def _gen_fields_deserializer_common(self, struct, bson_object):
         # type: (ast.Struct, str) -> _FieldUsageCheckerBase
         """Generate the C++ code to deserialize list of fields."""
@@ -1372,39 +1450,18 @@ class _CppSourceFileWriter(_CppFileWriterBase):
             field_usage_check.add_store("fieldName")
             self._writer.write_empty_line()
 
-            first_field = True
-            for field in struct.fields:
-                # Do not parse chained fields as fields since they are actually chained types.
-                if field.chained and not field.chained_struct_field:
-                    continue
-
-                field_predicate = 'fieldName == %s' % (_get_field_constant_name(field))
-
-                with self._predicate(field_predicate, not first_field):
-
-                    if field.ignore:
-                        field_usage_check.add(field, "element")
-
-                        self._writer.write_line('// ignore field')
-                    else:
-                        self.gen_field_deserializer(field, bson_object, "element",
-                                                    field_usage_check)
-
-                if first_field:
-                    first_field = False
-
-            # End of for fields
-            # Generate strict check for extranous fields
-            if struct.strict:
-                with self._block('else {', '}'):
-                    # For commands, check if this a well known command field that the IDL parser
-                    # should ignore regardless of strict mode.
-                    command_predicate = None
-                    if isinstance(struct, ast.Command):
-                        command_predicate = "!mongo::isGenericArgument(fieldName)"
+            # Do not parse chained fields as fields since they are actually chained types.
+            dispatch_fields = [
+                field for field in struct.fields
+                if not field.chained or field.chained_struct_field
+            ]
 
-                    with self._predicate(command_predicate):
-                        self._writer.write_line('ctxt.throwUnknownField(fieldName);')
+            if len(dispatch_fields) >= _MIN_FIELDS_FOR_LENGTH_DISPATCH:
+                self._gen_fields_length_dispatch(struct, dispatch_fields, bson_object,
+                                                 field_usage_check)
+            else:
+                self._gen_fields_chain_dispatch(struct, dispatch_fields, bson_object,
+                                                field_usage_check)
 
         # Parse chained structs if not inlined
         # Parse chained types always here
@@ -23,6 +23,9 @@ const expected = {
     },
 };
 
+// The time spent authenticating with each mechanism only ever grows.
+const lastAuthenticationMicros = {};
+
 function assertStats() {
     const mechStats = assert.commandWorked(admin.runCommand({serverStatus: 1}))
                           .security.authentication.mechanisms;
@@ -30,6 +33,9 @@ function assertStats() {
         try {
             assert.eq(mechStats[mech].authenticate.received, expected[mech].received);
             assert.eq(mechStats[mech].authenticate.successful, expected[mech].successful);
+            assert.gte(mechStats[mech].totalAuthenticationMicros,
+                       lastAuthenticationMicros[mech] || 0);
+            lastAuthenticationMicros[mech] = mechStats[mech].totalAuthenticationMicros;
         } catch (e) {
             print("Mechanism: " + mech);
             print("mechStats: " + tojson(mechStats));
@@ -88,6 +94,8 @@ assertFailure({user: 'user256', pwd: 'pwd', mechanism: 'SCRAM-SHA-1'}, 'SCRAM-SH
 
 const finalStats =
     assert.commandWorked(admin.runCommand({serverStatus: 1})).security.authentication.mechanisms;
+assert.gt(finalStats['SCRAM-SHA-1'].totalAuthenticationMicros, 0, finalStats);
+assert.gt(finalStats['SCRAM-SHA-256'].totalAuthenticationMicros, 0, finalStats);
 MongoRunner.stopMongod(mongod);
 
 printjson(finalStats);
@@ -0,0 +1,55 @@
+// Tests benchRun's open-loop mode and latency percentiles.
+// @tags: [
+//   uses_multiple_connections,
+// ]
+(function() {
+"use strict";
+
+const t = db.bench_open_loop;
+t.drop();
+
+assert.commandWorked(t.insert({_id: 1, x: 1}));
+
+const seconds = 5;
+const opsPerSecond = 100;
+
+const benchArgs = {
+    ops: [
+        {op: "findOne", ns: t.getFullName(), query: {_id: 1}},
+        {
+            op: "insert",
+            ns: t.getFullName(),
+            doc: {key: {"#ZIPF_INT": [1000, 1.0]}, tag: {"#RAND_CHOICE": ["a", "b", "c"]}}
+        }
+    ],
+    parallel: 2,
+    seconds: seconds,
+    opsPerSecond: opsPerSecond,
+    host: db.getMongo().host
+};
+
+if (jsTest.options().auth) {
+    benchArgs['db'] = 'admin';
+    benchArgs['username'] = jsTest.options().authUser;
+    benchArgs['password'] = jsTest.options().authPassword;
+}
+const res = benchRun(benchArgs);
+
+// The fixed schedule caps the rate; allow for slow test machines falling behind it.
+assert.lte(res["totalOps/s"], opsPerSecond * 1.1, tojson(res));
+
+for (let name of ["findOneLatencyPercentilesMicros", "insertLatencyPercentilesMicros"]) {
+    const percentiles = res[name];
+    assert(percentiles, tojson(res));
+    assert.lte(percentiles.p50, percentiles.p95, tojson(res));
+    assert.lte(percentiles.p95, percentiles.p99, tojson(res));
+    assert.lte(percentiles.p99, percentiles.p999, tojson(res));
+    assert.lte(percentiles.p999, percentiles.max, tojson(res));
+}
+
+t.find({_id: {$ne: 1}}).forEach(doc => {
+    assert.gte(doc.key, 0, tojson(doc));
+    assert.lt(doc.key, 1000, tojson(doc));
+    assert.contains(doc.tag, ["a", "b", "c"], tojson(doc));
+});
+}());
@@ -0,0 +1,62 @@
+/**
+ * Tests that the 'analyze' command builds histograms of a collection's fields, and that the planner
+ * uses them to skip multi-planning when one index scan reads far fewer keys than the others.
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/analyze_plan.js');
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, a: i, b: i < 900 ? 1 : i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function explainRejectedPlans(filter) {
+    const explain = coll.find(filter).explain();
+    return explain.queryPlanner.rejectedPlans.length;
+}
+
+// Without histograms, both index scans are multi-planned.
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryPlannerUseCollectionStatistics: true}));
+assert.eq(1, explainRejectedPlans({a: 5, b: 1}));
+
+let res = assert.commandWorked(testDB.runCommand({analyze: coll.getName(), key: 'a'}));
+assert.eq(1000, res.numSampledDocuments, tojson(res));
+assert.eq(1000, res.numDistinctValues, tojson(res));
+res = assert.commandWorked(testDB.runCommand({analyze: coll.getName(), key: 'b', numBuckets: 10}));
+assert.eq(101, res.numDistinctValues, tojson(res));
+assert.lte(res.buckets.length, 11, tojson(res));
+
+// The scan of 'a' reads one key and the scan of 'b' 900, so only the former is planned.
+const explain = coll.find({a: 5, b: 1}).explain();
+assert.eq(0, explain.queryPlanner.rejectedPlans.length, tojson(explain));
+assert(isIxscan(testDB, explain.queryPlanner.winningPlan), tojson(explain));
+assert.eq('a_1', getPlanStage(explain.queryPlanner.winningPlan, 'IXSCAN').indexName);
+assert.eq([{_id: 5, a: 5, b: 1}], coll.find({a: 5, b: 1}).toArray());
+assert.eq([{_id: 950, a: 950, b: 950}], coll.find({a: 950, b: 950}).toArray());
+
+// Estimates that are close are left to multi-planning.
+assert.eq(1, explainRejectedPlans({a: {$lt: 200}, b: 1}));
+
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryPlannerUseCollectionStatistics: false}));
+assert.eq(1, explainRejectedPlans({a: 5, b: 1}));
+
+assert.commandFailedWithCode(testDB.runCommand({analyze: coll.getName()}), 5160001);
+assert.commandFailedWithCode(testDB.runCommand({analyze: coll.getName(), key: '$a'}), 5160001);
+assert.commandFailedWithCode(
+    testDB.runCommand({analyze: coll.getName(), key: 'a', sampleSize: 0}), 5160000);
+assert.commandFailedWithCode(testDB.runCommand({analyze: 'missing', key: 'a'}),
+                             ErrorCodes.NamespaceNotFound);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,44 @@
+/**
+ * Test that background compaction compacts the collections with enough space available for reuse
+ * and leaves the others alone.
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        backgroundCompactionEnabled: true,
+        backgroundCompactionIntervalSecs: 0,
+        backgroundCompactionMinFreeBytes: 1024 * 1024,
+        backgroundCompactionMinFreeRatio: 0.25,
+    }
+});
+const testDB = conn.getDB(jsTestName());
+
+function backgroundCompactionMetrics() {
+    return testDB.serverStatus().metrics.backgroundCompaction;
+}
+
+const pad = "x".repeat(1024);
+for (let collName of ["deleted", "kept"]) {
+    const bulk = testDB[collName].initializeUnorderedBulkOp();
+    for (let i = 0; i < 10000; ++i) {
+        bulk.insert({_id: i, pad: pad});
+    }
+    assert.commandWorked(bulk.execute());
+}
+assert.commandWorked(testDB.deleted.remove({_id: {$gte: 10}}));
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+checkLog.containsJson(conn, 5155037, {namespace: testDB.deleted.getFullName()});
+assert.gte(backgroundCompactionMetrics().passes, 1);
+assert.gte(backgroundCompactionMetrics().collectionsCompacted, 1);
+assert(!checkLog.checkContainsOnceJson(conn, 5155037, {namespace: testDB.kept.getFullName()}));
+
+// The compacted collection is intact.
+assert.eq(10, testDB.deleted.find().itcount());
+assert.eq(10000, testDB.kept.find().itcount());
+
+MongoRunner.stopMongod(conn);
+})();
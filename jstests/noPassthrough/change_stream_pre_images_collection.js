@@ -0,0 +1,56 @@
+/**
+ * Test that the pre-images of updates and deletes to a collection which records them are stored
+ * in local.system.preimages on every node instead of in no-op oplog entries, and that change
+ * streams return them from there.
+ * @tags: [requires_replication, requires_wiredtiger, uses_change_streams]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB(jsTestName());
+const coll = testDB.test;
+assert.commandWorked(testDB.createCollection(coll.getName(), {recordPreImages: true}));
+const collUUID = testDB.getCollectionInfos({name: coll.getName()})[0].info.uuid;
+
+assert.commandWorked(coll.insert([{_id: 0, x: 0}, {_id: 1, x: 1}]));
+
+const stream = coll.watch([], {fullDocumentBeforeChange: "required"});
+assert.commandWorked(coll.update({_id: 0}, {$set: {x: 10}}));
+assert.commandWorked(coll.replaceOne({_id: 1}, {y: 1}));
+assert.commandWorked(coll.remove({_id: 0}));
+
+const expected = [
+    {operationType: "update", fullDocumentBeforeChange: {_id: 0, x: 0}},
+    {operationType: "replace", fullDocumentBeforeChange: {_id: 1, x: 1}},
+    {operationType: "delete", fullDocumentBeforeChange: {_id: 0, x: 10}},
+];
+for (let expectedEvent of expected) {
+    assert.soon(() => stream.hasNext());
+    const event = stream.next();
+    assert.eq(expectedEvent.operationType, event.operationType, event);
+    assert.eq(expectedEvent.fullDocumentBeforeChange, event.fullDocumentBeforeChange, event);
+}
+stream.close();
+
+// No pre-image went to the oplog.
+const oplog = primary.getDB("local").oplog.rs;
+assert.eq(0, oplog.find({op: "n", ns: coll.getFullName()}).itcount());
+assert.eq(0, oplog.find({ns: "local.system.preimages"}).itcount());
+
+// Each node stored the pre-images of the writes it performed or applied.
+rst.awaitReplication();
+for (let node of rst.nodes) {
+    node.setSlaveOk();
+    const preImages = node.getDB("local").system.preimages.find({nsUUID: collUUID}).toArray();
+    assert.eq(expected.map(event => event.fullDocumentBeforeChange),
+              preImages.map(preImage => preImage.preImage),
+              preImages);
+}
+
+rst.stopSet();
+})();
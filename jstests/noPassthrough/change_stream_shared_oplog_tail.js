@@ -0,0 +1,55 @@
+/**
+ * Test that change streams tailing the oplog at the same time share the oplog entries read by the
+ * first of them, and that each still sees every event exactly once.
+ * @tags: [requires_replication, requires_journaling, uses_change_streams]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const testDB = rst.getPrimary().getDB(jsTestName());
+const coll = testDB.test;
+assert.commandWorked(coll.insert({_id: -1}));
+
+function oplogTailCacheHits() {
+    return testDB.serverStatus().metrics.query.oplogTailCache.hits;
+}
+
+const numStreams = 4;
+const numDocs = 50;
+const streams = [];
+for (let i = 0; i < numStreams; ++i) {
+    streams.push(coll.watch([{$match: {operationType: "insert"}}]));
+}
+
+const hitsBefore = oplogTailCacheHits();
+for (let i = 0; i < numDocs; ++i) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+
+for (let stream of streams) {
+    for (let i = 0; i < numDocs; ++i) {
+        assert.soon(() => stream.hasNext());
+        const event = stream.next();
+        assert.eq("insert", event.operationType, event);
+        assert.eq(i, event.documentKey._id, event);
+    }
+    stream.close();
+}
+
+// All but the first stream to read an entry took it from the cache.
+assert.gt(oplogTailCacheHits(), hitsBefore);
+
+// With the cache disabled the streams read every entry themselves and see the same events.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, internalQueryOplogTailCacheMaxBytes: 0}));
+const stream = coll.watch([{$match: {operationType: "insert"}}]);
+assert.commandWorked(coll.insert({_id: numDocs}));
+assert.soon(() => stream.hasNext());
+assert.eq(numDocs, stream.next().documentKey._id);
+stream.close();
+
+rst.stopSet();
+})();
@@ -0,0 +1,53 @@
+// Test that a clustered collection stores documents by _id without an _id index, enforces _id
+// uniqueness itself and answers _id lookups directly from the record store.
+// @tags: [requires_wiredtiger]
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.clustered_collection_basic;
+
+assert.commandFailedWithCode(db.createCollection("bad", {clustered: true, capped: true, size: 100}),
+                             ErrorCodes.InvalidOptions);
+assert.commandWorked(db.createCollection(coll.getName(), {clustered: true}));
+
+// There is no _id index.
+assert.eq([], coll.getIndexes());
+
+assert.commandWorked(coll.insert([{_id: 3, x: 3}, {_id: 1, x: 1}, {_id: 2, x: 2}]));
+assert.commandFailedWithCode(coll.insert({_id: 1, x: 10}), ErrorCodes.DuplicateKey);
+assert.commandFailedWithCode(coll.insert([{_id: 4}, {_id: 4}]), ErrorCodes.DuplicateKey);
+assert.commandFailedWithCode(coll.insert({_id: "a"}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.insert({_id: 1.5}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.insert({_id: -1}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.insert({x: 5}), ErrorCodes.BadValue);
+
+// A collection scan returns the documents in _id order.
+assert.eq([1, 2, 3, 4], coll.find().toArray().map(doc => doc._id));
+
+// Lookups by _id, including of equal numbers of another type, go straight to the record.
+assert.eq({_id: 2, x: 2}, coll.findOne({_id: 2}));
+assert.eq({_id: 2, x: 2}, coll.findOne({_id: 2.0}));
+assert.eq({_id: 2, x: 2}, coll.findOne({_id: NumberLong(2)}));
+assert.eq(null, coll.findOne({_id: 10}));
+assert(isIdhack(db, coll.find({_id: 2}).explain().queryPlanner.winningPlan));
+
+assert.commandWorked(coll.update({_id: 3}, {$set: {x: 30}}));
+assert.eq({_id: 3, x: 30}, coll.findOne({_id: 3}));
+assert.commandWorked(coll.update({_id: 5}, {$set: {x: 5}}, {upsert: true}));
+assert.eq({_id: 5, x: 5}, coll.findOne({_id: 5}));
+assert(isIdhack(db, coll.explain().update({_id: 3}, {$set: {x: 31}}).queryPlanner.winningPlan));
+
+assert.commandWorked(coll.remove({_id: 1}));
+assert.eq(null, coll.findOne({_id: 1}));
+assert(isIdhack(db, coll.explain().remove({_id: 2}).queryPlanner.winningPlan));
+
+// A deleted _id may be inserted again.
+assert.commandWorked(coll.insert({_id: 1, x: 100}));
+assert.eq([1, 2, 3, 4, 5], coll.find().toArray().map(doc => doc._id));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,58 @@
+/**
+ * Test that the dbHash command reports hashed _id ranges of a collection when given 'rangeSize', and
+ * that changing one document changes the hash of only the range containing it.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.test;
+
+const numDocs = 1000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, x: i});
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandFailedWithCode(testDB.runCommand({dbHash: 1, rangeSize: "a"}),
+                             ErrorCodes.TypeMismatch);
+assert.commandFailedWithCode(testDB.runCommand({dbHash: 1, rangeSize: 0}), ErrorCodes.BadValue);
+
+// Without 'rangeSize' no ranges are reported, and asking for them doesn't change the md5.
+const plain = assert.commandWorked(testDB.runCommand({dbHash: 1}));
+assert(!plain.hasOwnProperty("ranges"), plain);
+
+function getRanges() {
+    const res = assert.commandWorked(testDB.runCommand({dbHash: 1, rangeSize: 50}));
+    assert.eq(plain.md5, res.md5, res);
+    return res.ranges[coll.getName()];
+}
+
+const before = getRanges();
+assert.gt(before.length, 1, before);
+assert.eq(numDocs, before.reduce((total, range) => total + range.count, 0), before);
+assert.eq(0, before[0].min, before);
+assert.eq(numDocs - 1, before[before.length - 1].max, before);
+for (let i = 1; i < before.length; ++i) {
+    assert.eq(before[i - 1].max + 1, before[i].min, before);
+}
+
+// Hashing is deterministic.
+assert.eq(before, getRanges());
+
+// Changing one document changes only the hash of the range it falls in.
+const changedId = 500;
+assert.commandWorked(coll.update({_id: changedId}, {$set: {x: -1}}));
+const after = getRanges();
+assert.eq(before.length, after.length, after);
+for (let i = 0; i < before.length; ++i) {
+    assert.eq(before[i].min, after[i].min, after);
+    assert.eq(before[i].count, after[i].count, after);
+    const containsChange = before[i].min <= changedId && changedId <= before[i].max;
+    assert.eq(containsChange, before[i].hash !== after[i].hash, {before: before[i], after: after[i]});
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,62 @@
+/**
+ * Test that index scans of a 2dsphere index for $geoWithin and $geoIntersects skip the keys whose
+ * cells lie outside the query region, so that fewer documents are fetched for the same results.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.test;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 2500; ++i) {
+    const coordinates = [(i % 50) * 0.01, Math.floor(i / 50) * 0.01];
+    bulk.insert({_id: i, loc: {type: "Point", coordinates: coordinates}});
+}
+bulk.insert({_id: "line", loc: {type: "LineString", coordinates: [[-1, 0.105], [1, 0.105]]}});
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+// A thin diagonal triangle, whose covering includes many cells it does not intersect.
+const triangle = {
+    type: "Polygon",
+    coordinates: [[[0, 0], [0.4, 0.4], [0.4, 0.38], [0, 0]]]
+};
+
+function runQuery(query) {
+    const explain = coll.find(query).explain("executionStats");
+    const ixscan = getPlanStage(explain.executionStats.executionStages, "IXSCAN");
+    return {
+        ids: coll.find(query).sort({_id: 1}).toArray().map(doc => doc._id),
+        docsExamined: explain.executionStats.totalDocsExamined,
+        s2KeysFiltered: ixscan.s2KeysFiltered,
+    };
+}
+
+for (let query of [{loc: {$geoWithin: {$geometry: triangle}}},
+                   {loc: {$geoIntersects: {$geometry: triangle}}}]) {
+    const filtered = runQuery(query);
+    assert.gt(filtered.s2KeysFiltered, 0, filtered);
+
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryS2GeoFilterIndexKeys: false}));
+    const unfiltered = runQuery(query);
+    assert.commandWorked(
+        testDB.adminCommand({setParameter: 1, internalQueryS2GeoFilterIndexKeys: true}));
+
+    assert.eq(filtered.ids, unfiltered.ids, {filtered, unfiltered});
+    assert.lt(filtered.docsExamined, unfiltered.docsExamined, {filtered, unfiltered});
+    assert.eq(undefined, unfiltered.s2KeysFiltered, unfiltered);
+}
+
+// A document with several keys is still found through the keys in the region.
+assert.eq(1,
+          coll.find({_id: "line", loc: {$geoIntersects: {$geometry: triangle}}})
+              .hint({loc: "2dsphere"})
+              .itcount());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,46 @@
+/**
+ * Test that $near searches over a 2dsphere index repeated around the same center reuse the
+ * coverings and first annulus width of the first search, and return the same results.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.test;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 2000; ++i) {
+    bulk.insert({_id: i, loc: {type: "Point", coordinates: [(i % 50) * 0.001, (i / 50) * 0.001]}});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+function geoNearCacheMetrics() {
+    return testDB.serverStatus().metrics.query.geoNearCache;
+}
+
+function nearest(limit) {
+    return coll
+        .find({loc: {$near: {$geometry: {type: "Point", coordinates: [0.0123, 0.0234]}}}})
+        .limit(limit)
+        .toArray();
+}
+
+const expected = nearest(500);
+const before = geoNearCacheMetrics();
+assert.eq(expected, nearest(500));
+const after = geoNearCacheMetrics();
+assert.eq(before.firstAnnulusWidthHits + 1, after.firstAnnulusWidthHits, {before, after});
+assert.gt(after.coveringHits, before.coveringHits, {before, after});
+
+// With the cache disabled the search is computed from scratch, with the same results.
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryGeoNearUseCoveringCache: false}));
+assert.eq(expected, nearest(500));
+const disabled = geoNearCacheMetrics();
+assert.eq(after.firstAnnulusWidthHits, disabled.firstAnnulusWidthHits, {after, disabled});
+assert.eq(after.coveringHits, disabled.coveringHits, {after, disabled});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,57 @@
+/**
+ * Tests that an aggregation whose leading $group only reads indexed fields is answered by a covered
+ * scan of the whole index, rather than by a collection scan.
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/analyze_plan.js');
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+const statuses = ['active', 'closed', 'pending'];
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 300; i++) {
+    bulk.insert({_id: i, status: statuses[i % 3], size: i, other: 'x'.repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({status: 1, size: 1}));
+
+const pipeline = [
+    {$group: {_id: '$status', count: {$sum: 1}, maxSize: {$max: '$size'}}},
+    {$sort: {_id: 1}}
+];
+const expected = [
+    {_id: 'active', count: 100, maxSize: 297},
+    {_id: 'closed', count: 100, maxSize: 298},
+    {_id: 'pending', count: 100, maxSize: 299}
+];
+
+let explain = coll.explain().aggregate(pipeline);
+assert(aggPlanHasStage(explain, 'IXSCAN'), tojson(explain));
+assert(aggPlanHasStage(explain, 'PROJECTION_COVERED'), tojson(explain));
+assert(!aggPlanHasStage(explain, 'FETCH'), tojson(explain));
+assert.eq(expected, coll.aggregate(pipeline).toArray());
+
+// A $group reading a field the index does not hold still scans the collection.
+explain = coll.explain().aggregate([{$group: {_id: '$status', other: {$first: '$other'}}}]);
+assert(aggPlanHasStage(explain, 'COLLSCAN'), tojson(explain));
+
+// A multikey index does not hold the arrays the $group needs.
+assert.commandWorked(coll.insert({_id: 300, status: ['active', 'closed'], size: 0}));
+explain = coll.explain().aggregate(pipeline);
+assert(aggPlanHasStage(explain, 'COLLSCAN'), tojson(explain));
+assert.commandWorked(coll.remove({_id: 300}));
+
+assert.commandWorked(coll.dropIndexes());
+assert.commandWorked(coll.createIndex({status: 1, size: 1}));
+assert.commandWorked(testDB.adminCommand(
+    {setParameter: 1, internalQueryPlannerGenerateCoveredWholeIndexScansForGroup: false}));
+explain = coll.explain().aggregate(pipeline);
+assert(aggPlanHasStage(explain, 'COLLSCAN'), tojson(explain));
+assert.eq(expected, coll.aggregate(pipeline).toArray());
+
+MongoRunner.stopMongod(conn);
+})();
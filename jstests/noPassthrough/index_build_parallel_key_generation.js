@@ -0,0 +1,40 @@
+/**
+ * Tests that index builds which generate keys on several threads during the collection scan phase
+ * produce the same indexes as a build on a single thread.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({setParameter: {maxIndexBuildKeyGenerationThreads: 4}});
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+// Enough documents to fill several key generation batches, some of them multikey.
+const numDocs = 5000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, a: i % 100, b: [i, i + 1, i + 2], c: 'str' + i, d: (i % 2 === 0)});
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandWorked(coll.createIndexes([
+    {a: 1, b: 1, c: -1},
+    {c: 1},
+]));
+assert.commandWorked(coll.createIndex({a: 1}, {partialFilterExpression: {d: true}}));
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+
+assert.eq(numDocs * 3, validateRes.keysPerIndex['a_1_b_1_c_-1'], tojson(validateRes));
+assert.eq(numDocs, validateRes.keysPerIndex.c_1, tojson(validateRes));
+assert.eq(numDocs / 2, validateRes.keysPerIndex.a_1, tojson(validateRes));
+assert.eq(1, coll.find({a: 7, b: 8}).hint({a: 1, b: 1, c: -1}).itcount());
+
+// Going back to a single thread at runtime builds the same index.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, maxIndexBuildKeyGenerationThreads: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+assert.eq(numDocs, coll.find({b: {$gte: 0}}).hint({b: 1}).itcount());
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that builds of partial indexes whose filters an existing index can answer read only the
+ * matching documents through that index, and that they scan the whole collection instead when the
+ * filters match more than maxIndexBuildIndexScanFraction of it.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({setParameter: {maxIndexBuildIndexScanFraction: 0.05}});
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+const numDocs = 2000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, a: i, b: 'str' + i, c: i % 2});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function assertValid(indexName, expectedKeys) {
+    const validateRes = assert.commandWorked(coll.validate({full: true}));
+    assert(validateRes.valid, tojson(validateRes));
+    assert.eq(expectedKeys, validateRes.keysPerIndex[indexName], tojson(validateRes));
+}
+
+// Matches 1% of the collection, which the index on 'a' finds.
+assert.commandWorked(coll.createIndex({b: 1}, {partialFilterExpression: {a: {$lt: 20}}}));
+checkLog.containsJson(conn, 5155011);
+assertValid('b_1', 20);
+
+// Several indexes built together are sourced from the union of their filters.
+assert.commandWorked(coll.createIndexes([{b: -1}, {c: 1}], [
+    {partialFilterExpression: {a: {$gte: 1990}}},
+    {partialFilterExpression: {a: {$lt: 10}}},
+]));
+assertValid('b_-1', 10);
+assertValid('c_1', 10);
+
+// Matches half of the collection, so the build falls back to a collection scan part way through.
+assert.commandWorked(coll.createIndex({b: 1, c: 1}, {partialFilterExpression: {a: {$lt: 1000}}}));
+checkLog.containsJson(conn, 5155009);
+assertValid('b_1_c_1', 1000);
+
+// No index can answer a filter on 'c', so the collection is scanned from the start.
+assert.commandWorked(coll.createIndex({a: 1, b: 1}, {partialFilterExpression: {c: 1}}));
+assertValid('a_1_b_1', numDocs / 2);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -116,6 +116,9 @@ function verifyMirrorReads(rst, cmd) {
     jsTestLog("Verifying mirrored reads for 'distinct' commands");
     verifyMirrorReads(rst, {distinct: kCollName, key: "x"});
 
+    jsTestLog("Verifying mirrored reads for 'aggregate' commands");
+    verifyMirrorReads(rst, {aggregate: kCollName, pipeline: [{$match: {x: 1}}], cursor: {}});
+
     jsTestLog("Verifying mirrored reads for 'findAndModify' commands");
     verifyMirrorReads(rst, {findAndModify: kCollName, query: {}, update: {'$inc': {x: 1}}});
 
@@ -0,0 +1,45 @@
+/**
+ * Test that with collectPerOperationStorageStats set, storage statistics are gathered for every
+ * operation, profiled with it, and summed per collection in the top command's output.
+ * @tags: [requires_wiredtiger, requires_profiling]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {collectPerOperationStorageStats: true}});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.test;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({_id: i, padding: "x".repeat(1024)});
+}
+assert.commandWorked(bulk.execute());
+
+// Restart to start from a cold cache, so that the scan reads from disk.
+MongoRunner.stopMongod(conn);
+const restarted = MongoRunner.runMongod({
+    dbpath: conn.dbpath,
+    noCleanData: true,
+    setParameter: {collectPerOperationStorageStats: true}
+});
+const restartedDB = restarted.getDB(jsTestName());
+// Profile every operation but log none as slow, so that only the parameter explains the storage
+// statistics of the profiled operations.
+assert.commandWorked(restartedDB.setProfilingLevel(2, {slowms: 100000}));
+
+assert.eq(1000, restartedDB.test.find({padding: {$exists: true}}).itcount());
+
+const profile =
+    restartedDB.system.profile.findOne({ns: restartedDB.test.getFullName(), op: "query"});
+assert(profile, restartedDB.system.profile.find().toArray());
+assert.gt(profile.storage.data.bytesRead, 0, profile);
+
+const top = restartedDB.adminCommand("top");
+assert.commandWorked(top);
+const collTop = top.totals[restartedDB.test.getFullName()];
+assert.gte(collTop.storage.count, 1, collTop);
+assert.gt(collTop.storage.data.bytesRead, 0, collTop);
+
+MongoRunner.stopMongod(restarted);
+})();
@@ -0,0 +1,56 @@
+/**
+ * Tests that a resumable index build writes its state to disk during the collection scan every
+ * resumableIndexBuildCheckpointIntervalSecs, and that the build still completes afterwards.
+ *
+ * @tags: [requires_persistence, requires_replication]
+ */
+(function() {
+'use strict';
+
+load('jstests/noPassthrough/libs/index_build.js');
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter: {
+            enableResumableIndexBuilds: true,
+            resumableIndexBuildCheckpointIntervalSecs: 1,
+            logComponentVerbosity: tojson({index: 1}),
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+if (!IndexBuildTest.resumableIndexBuildsEnabled(primary)) {
+    jsTestLog('Skipping test because resumable index builds are not enabled');
+    rst.stopSet();
+    return;
+}
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({i: i, a: [i, i + 1]}));
+}
+
+// Stop the collection scan long enough for the next document to be due for a checkpoint.
+assert.commandWorked(primary.adminCommand(
+    {configureFailPoint: 'hangAfterIndexBuildOf', mode: 'alwaysOn', data: {i: 4}}));
+const awaitIndexBuild = IndexBuildTest.startIndexBuild(primary, coll.getFullName(), {a: 1});
+checkLog.containsJson(primary, 20386);
+sleep(1500);
+assert.commandWorked(
+    primary.adminCommand({configureFailPoint: 'hangAfterIndexBuildOf', mode: 'off'}));
+awaitIndexBuild();
+
+checkLog.containsJson(primary, 5155014);
+IndexBuildTest.assertIndexes(coll, 2, ['_id_', 'a_1']);
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+assert.eq(20, validateRes.keysPerIndex['a_1'], tojson(validateRes));
+
+rst.stopSet();
+})();
@@ -0,0 +1,24 @@
+/**
+ * Test that serverStatus reports how long each phase of startup took.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const timeline = assert.commandWorked(conn.adminCommand({serverStatus: 1})).startupTimeline;
+
+const phases = Object.keys(timeline.phases);
+assert.eq("setUpListener", phases[0], timeline);
+assert(phases.includes("initializeStorageEngine"), timeline);
+assert(phases.includes("recoverReplication"), timeline);
+assert.eq("startListener", phases[phases.length - 1], timeline);
+
+let total = 0;
+for (let phase of phases) {
+    assert.gte(timeline.phases[phase], 0, timeline);
+    total += timeline.phases[phase];
+}
+assert.eq(total, timeline.totalMillis, timeline);
+
+MongoRunner.stopMongod(conn);
+})();
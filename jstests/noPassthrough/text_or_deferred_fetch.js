@@ -0,0 +1,53 @@
+/**
+ * Test that a $text query with textScore returns every candidate with its score once, fetching
+ * each candidate a single time, even when it yields after every index key, and does not return
+ * documents removed while it was reading the index.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+load("jstests/libs/fail_point_util.js");
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryExecYieldIterations: 1}});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.test;
+
+const words = ["red", "green", "blue", "yellow"];
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 200; ++i) {
+    bulk.insert({_id: i, text: words[i % 4] + " " + words[(i + 1) % 4] + " " + i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({text: "text"}));
+
+const query = {$text: {$search: "red blue"}};
+const projection = {score: {$meta: "textScore"}};
+
+const results = coll.find(query, projection).sort({score: {$meta: "textScore"}}).toArray();
+assert.eq(150, results.length, results);
+for (let doc of results) {
+    assert.gt(doc.score, 0, doc);
+}
+
+const explain = coll.find(query, projection).explain("executionStats");
+const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.eq(150, textOr.fetches, textOr);
+
+// Remove documents while the query is paused in the index scan, between reading the keys and
+// fetching the documents.
+const fp = configureFailPoint(conn, "setYieldAllLocksHang", {namespace: coll.getFullName()});
+const awaitQuery = startParallelShell(() => {
+    const coll = db.getSiblingDB(jsTestName()).test;
+    const ids = coll.find({$text: {$search: "red blue"}}, {score: {$meta: "textScore"}})
+                    .toArray()
+                    .map(doc => doc._id);
+    assert(!ids.includes(0), ids);
+}, conn.port);
+fp.wait();
+assert.commandWorked(coll.deleteOne({_id: 0}));
+fp.off();
+awaitQuery();
+
+MongoRunner.stopMongod(conn);
+})();
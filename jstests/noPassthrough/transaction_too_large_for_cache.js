@@ -0,0 +1,49 @@
+/**
+ * Test that a multi-document transaction whose writes would take up too much of the storage engine
+ * cache is aborted with TransactionTooLargeForCache.
+ * @tags: [requires_replication, requires_wiredtiger, uses_transactions]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1, nodeOptions: {wiredTigerCacheSizeGB: 0.25}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const dbName = jsTestName();
+const testDB = primary.getDB(dbName);
+assert.commandWorked(testDB.createCollection("test"));
+
+// Allow transactions about 256KB in size.
+assert.commandWorked(
+    primary.adminCommand({setParameter: 1, transactionTooLargeForCacheThreshold: 0.001}));
+
+const bigString = "x".repeat(100 * 1024);
+const session = primary.startSession();
+const sessionColl = session.getDatabase(dbName).test;
+
+session.startTransaction();
+assert.commandWorked(sessionColl.insert({x: bigString}));
+assert.commandWorked(sessionColl.insert({x: bigString}));
+const res = assert.commandFailedWithCode(sessionColl.insert({x: bigString}),
+                                         ErrorCodes.TransactionTooLargeForCache);
+// The error isn't transient, retrying the transaction would fail the same way.
+assert(!res.hasOwnProperty("errorLabels") || !res.errorLabels.includes("TransientTransactionError"),
+       res);
+assert.commandFailedWithCode(session.abortTransaction_forTesting(), ErrorCodes.NoSuchTransaction);
+assert.eq(0, testDB.test.find().itcount());
+
+// A value of 1 disables the check.
+assert.commandWorked(
+    primary.adminCommand({setParameter: 1, transactionTooLargeForCacheThreshold: 1}));
+session.startTransaction();
+for (let i = 0; i < 3; ++i) {
+    assert.commandWorked(sessionColl.insert({x: bigString}));
+}
+assert.commandWorked(session.commitTransaction_forTesting());
+assert.eq(3, testDB.test.find().itcount());
+
+session.endSession();
+rst.stopSet();
+})();
@@ -0,0 +1,45 @@
+// Test that the TTL monitor deletes expired documents in batches across several collections in
+// parallel, and reports how far behind it is.
+(function() {
+"use strict";
+
+const runner = MongoRunner.runMongod({
+    setParameter: {
+        ttlMonitorSleepSecs: 1,
+        ttlMonitorDeleteBatchSize: 10,
+        ttlMonitorConcurrency: 2,
+    }
+});
+const db = runner.getDB("test");
+
+const past = new Date(Date.now() - 60 * 60 * 1000);
+const collNames = ["ttl_batched_a", "ttl_batched_b", "ttl_batched_c"];
+for (let collName of collNames) {
+    const coll = db[collName];
+    coll.drop();
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+
+    const docs = [];
+    for (let i = 0; i < 95; ++i) {
+        docs.push({x: new Date(past.getTime() + i * 1000)});
+    }
+    docs.push({x: new Date(Date.now() + 60 * 60 * 1000)});
+    assert.commandWorked(coll.insert(docs));
+}
+
+// Deleting batches of 10 documents takes several rounds, but every expired document is deleted.
+assert.soon(function() {
+    return collNames.every((collName) => db[collName].count() === 1);
+}, "TTL monitor didn't delete the expired documents before timing out.");
+
+const ttlPass = db.serverStatus().metrics.ttl.passes;
+assert.soon(function() {
+    return db.serverStatus().metrics.ttl.passes >= ttlPass + 2;
+}, "TTL monitor didn't run before timing out.");
+
+const ttlMetrics = db.serverStatus().metrics.ttl;
+assert.eq(0, ttlMetrics.lagSecs, tojson(ttlMetrics));
+assert.gte(ttlMetrics.deletedDocuments, 95 * collNames.length, tojson(ttlMetrics));
+
+MongoRunner.stopMongod(runner);
+})();
@@ -0,0 +1,81 @@
+/**
+ * Tests that equalities on the only field of a unique index are answered with an IDHACK plan on
+ * that index when internalQueryUseIdHackForUniqueIndexes is enabled, and that indexes which could
+ * miss or misreport matching documents are not used that way.
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/analyze_plan.js');
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryUseIdHackForUniqueIndexes: true}});
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert(
+        {_id: i, a: i, b: {c: 'str' + i}, d: i, e: 'str' + i, f: i, m: [i * 1000, i * 1000 + 1]}));
+}
+assert.commandWorked(coll.createIndex({a: 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({'b.c': 1}, {unique: true}));
+assert.commandWorked(coll.createIndex({d: 1}, {unique: true, sparse: true}));
+assert.commandWorked(
+    coll.createIndex({e: 1}, {unique: true, collation: {locale: 'en_US', strength: 2}}));
+assert.commandWorked(coll.createIndex({f: 1}));
+assert.commandWorked(coll.createIndex({m: 1}, {unique: true}));
+
+function assertIdHackOn(filter, indexName, expectedIds) {
+    const explain = coll.find(filter).explain();
+    const idhack = getPlanStage(explain.queryPlanner.winningPlan, 'IDHACK');
+    assert.neq(null, idhack, tojson(explain));
+    assert.eq(indexName, idhack.indexName, tojson(explain));
+    assert.eq(expectedIds, coll.find(filter).toArray().map(doc => doc._id), tojson(filter));
+}
+
+function assertNoIdHack(filter, expectedIds) {
+    const explain = coll.find(filter).explain();
+    assert.eq(null, getPlanStage(explain.queryPlanner.winningPlan, 'IDHACK'), tojson(explain));
+    assert.eq(expectedIds, coll.find(filter).sort({_id: 1}).toArray().map(doc => doc._id));
+}
+
+assertIdHackOn({_id: 7}, '_id_', [7]);
+assertIdHackOn({a: 7}, 'a_1', [7]);
+assertIdHackOn({a: 7.0}, 'a_1', [7]);
+assertIdHackOn({a: 1000}, 'a_1', []);
+assertIdHackOn({'b.c': 'str7'}, 'b.c_1', [7]);
+assertIdHackOn({m: 7001}, 'm_1', [7]);
+
+// Only the first field of a compound filter could use the index, so it needs a real plan.
+assertNoIdHack({a: 7, f: 7}, [7]);
+assertNoIdHack({a: {$gte: 98}}, [98, 99]);
+assertNoIdHack({a: null}, []);
+
+// A sparse or non-unique index may not hold the document, or may hold several.
+assertNoIdHack({d: 7}, [7]);
+assertNoIdHack({f: 7}, [7]);
+
+// The collation of the query must match the collation of the index.
+assertNoIdHack({e: 'STR7'}, []);
+assert.eq(1, coll.find({e: 'STR7'}).collation({locale: 'en_US', strength: 2}).itcount());
+const explain =
+    coll.find({e: 'STR7'}).collation({locale: 'en_US', strength: 2}).explain('executionStats');
+assert.eq('e_1', getPlanStage(explain.queryPlanner.winningPlan, 'IDHACK').indexName);
+assert.eq(1, explain.executionStats.nReturned, tojson(explain));
+
+// Hidden indexes are not used.
+assert.commandWorked(coll.hideIndex('a_1'));
+assertNoIdHack({a: 7}, [7]);
+assert.commandWorked(coll.unhideIndex('a_1'));
+
+// Writes that find their document by a unique index use the same fast path.
+assert.commandWorked(coll.update({a: 7}, {$set: {g: 1}}));
+assert.eq(1, coll.findOne({_id: 7}).g);
+assert.commandWorked(coll.remove({'b.c': 'str8'}));
+assert.eq(null, coll.findOne({_id: 8}));
+
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryUseIdHackForUniqueIndexes: false}));
+assertNoIdHack({a: 7}, [7]);
+
+MongoRunner.stopMongod(conn);
+})();
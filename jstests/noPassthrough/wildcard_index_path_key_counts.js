@@ -0,0 +1,50 @@
+/**
+ * Tests that when internalQueryWildcardIndexPathKeyCounts is enabled, a query over several paths
+ * of a $** index uses the path with the fewest keys without multi-planning, and that the counts
+ * follow inserts, updates and deletes.
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/analyze_plan.js');
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryWildcardIndexPathKeyCounts: true}});
+const testDB = conn.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+// Many documents have 'a', few have 'b'. The index is built over existing documents.
+for (let i = 0; i < 200; i++) {
+    assert.commandWorked(coll.insert(i < 5 ? {_id: i, a: i % 2, b: i} : {_id: i, a: i % 2}));
+}
+assert.commandWorked(coll.createIndex({'$**': 1}));
+
+function assertScannedPath(filter, path, expectedCount) {
+    const explain = coll.find(filter).explain();
+    assert.eq(0, explain.queryPlanner.rejectedPlans.length, tojson(explain));
+    const ixscan = getPlanStage(explain.queryPlanner.winningPlan, 'IXSCAN');
+    assert.neq(null, ixscan, tojson(explain));
+    assert.eq({$_path: 1, [path]: 1}, ixscan.keyPattern, tojson(explain));
+    assert.eq(expectedCount, coll.find(filter).itcount());
+}
+
+assertScannedPath({a: 1, b: {$gte: 0}}, 'b', 2);
+
+// After 'b' is added to every document, 'a' has fewer keys than 'b'.
+assert.commandWorked(coll.updateMany({}, {$set: {b: 1}}));
+assert.commandWorked(coll.updateMany({_id: {$gte: 10}}, {$unset: {a: 1}}));
+assertScannedPath({a: 1, b: {$gte: 0}}, 'a', 5);
+
+// Deletes are counted too. Inserts into a new collection start counting from an empty index.
+assert.commandWorked(coll.deleteMany({a: {$exists: true}}));
+assert.commandWorked(coll.insert([{_id: 1000, a: 1, b: 1}, {_id: 1001, a: 1, b: 1}]));
+assertScannedPath({a: 1, b: {$gte: 0}}, 'a', 2);
+
+const other = testDB.getCollection(jsTestName() + '_empty');
+assert.commandWorked(other.createIndex({'$**': 1}));
+assert.commandWorked(other.insert([{a: 1, b: 1}, {a: 1}, {a: 1}]));
+const explain = other.find({a: 1, b: 1}).explain();
+assert.eq(0, explain.queryPlanner.rejectedPlans.length, tojson(explain));
+assert.eq({$_path: 1, b: 1}, getPlanStage(explain.queryPlanner.winningPlan, 'IXSCAN').keyPattern);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -57,7 +57,10 @@ function runTestWithoutSubset(client) {
                                            'a["1.2"] = NumberLong(' + expectedCounts[2] + ');' +
                                            'a["1.3"] = NumberLong(' + expectedCounts[3] + ');' +
                                            'a["unknown"] = NumberLong(' + expectedCounts[4] + ');' +
-                                           'assert.eq(db.serverStatus().transportSecurity, a);');
+                                           'const s = db.serverStatus().transportSecurity;' +
+                                           'assert.eq({"1.0": s["1.0"], "1.1": s["1.1"],' +
+                                           '"1.2": s["1.2"], "1.3": s["1.3"],' +
+                                           'unknown: s.unknown}, a);');
 
     if (expectedDefaultProtocol === "TLS1_2" && client === "TLS1_3") {
         // If the runtime environment does not support TLS 1.3, a client cannot connect to a
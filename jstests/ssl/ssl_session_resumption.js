@@ -0,0 +1,45 @@
+// Ensure that outgoing TLS connections resume the sessions of earlier connections to the same host,
+// and that the server reports its handshakes and the bytes it encrypted.
+(function() {
+'use strict';
+
+load("jstests/ssl/libs/ssl_helpers.js");
+
+if (determineSSLProvider() !== "openssl") {
+    print("Skipping test, TLS session resumption is only implemented for OpenSSL");
+    return;
+}
+
+const conn = MongoRunner.runMongod({
+    sslMode: 'allowSSL',
+    sslPEMKeyFile: SERVER_CERT,
+    sslCAFile: CA_CERT,
+});
+
+const before = conn.getDB("admin").serverStatus().transportSecurity;
+
+// The first connection of the shell makes a full handshake, the next ones resume its session.
+assert.eq(0,
+          runMongoProgram('mongo',
+                          '--ssl',
+                          '--sslAllowInvalidHostnames',
+                          '--sslPEMKeyFile',
+                          CLIENT_CERT,
+                          '--sslCAFile',
+                          CA_CERT,
+                          '--port',
+                          conn.port,
+                          '--eval',
+                          'for (let i = 0; i < 3; ++i) {' +
+                              '    const other = new Mongo(db.getMongo().host);' +
+                              '    assert.commandWorked(other.adminCommand({ping: 1}));' +
+                              '}'));
+
+const after = conn.getDB("admin").serverStatus().transportSecurity;
+assert.gte(after.handshakes.count - before.handshakes.count, 4, tojson(after));
+assert.gte(after.handshakes.resumed - before.handshakes.resumed, 1, tojson(after));
+assert.gt(after.handshakes.totalMicros, before.handshakes.totalMicros, tojson(after));
+assert.gt(after.bytesEncrypted, before.bytesEncrypted, tojson(after));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -32,6 +32,7 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 
 namespace mongo {
 
@@ -63,7 +64,58 @@ void BM_arrayLookup(benchmark::State& state) {
     state.SetItemsProcessed(totalLen);
 }
 
+// Builds a document of 'numFields' fields cycling through strings, numbers, dates and ObjectIds,
+// which covers the common cases of both extended JSON formats.
+BSONObj makeJsonTestDocument(int64_t numFields) {
+    BSONObjBuilder builder;
+    for (int64_t i = 0; i < numFields; ++i) {
+        auto fieldName = "field" + std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                builder.append(fieldName, "a moderately long string value, as in a log line");
+                break;
+            case 1:
+                builder.append(fieldName, i * 1.5);
+                break;
+            case 2:
+                builder.appendDate(fieldName, Date_t::fromMillisSinceEpoch(i));
+                break;
+            case 3:
+                builder.append(fieldName, OID::gen());
+                break;
+        }
+    }
+    return builder.obj();
+}
+
+void BM_jsonString(benchmark::State& state, JsonStringFormat format) {
+    BSONObj doc = makeJsonTestDocument(state.range(0));
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        std::string json = doc.jsonString(format);
+        totalBytes += json.size();
+        benchmark::DoNotOptimize(json);
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+void BM_fromjson(benchmark::State& state, JsonStringFormat format) {
+    std::string json = makeJsonTestDocument(state.range(0)).jsonString(format);
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(fromjson(json));
+        totalBytes += json.size();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
+BENCHMARK_CAPTURE(BM_jsonString, Canonical, ExtendedCanonicalV2_0_0)->Range(1, 10'000);
+BENCHMARK_CAPTURE(BM_jsonString, Relaxed, ExtendedRelaxedV2_0_0)->Range(1, 10'000);
+BENCHMARK_CAPTURE(BM_fromjson, Canonical, ExtendedCanonicalV2_0_0)->Range(1, 10'000);
+BENCHMARK_CAPTURE(BM_fromjson, Relaxed, ExtendedRelaxedV2_0_0)->Range(1, 10'000);
 
 }  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr size_t kMinSlots = 8;
+
+/**
+ * Returns a power of two number of slots which keeps the table at most half full, so that probe
+ * sequences stay short.
+ */
+size_t numSlotsFor(size_t numFields) {
+    size_t numSlots = kMinSlots;
+    while (numSlots < 2 * numFields) {
+        numSlots *= 2;
+    }
+    return numSlots;
+}
+
+}  // namespace
+
+uint32_t BSONFieldIndex::hashFieldName(StringData name) {
+    // FNV-1a. Field names are short, so a simple byte-wise hash is cheap to compute.
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void BSONFieldIndex::build() {
+    _slots.resize(numSlotsFor(_obj.nFields()));
+    const size_t mask = _slots.size() - 1;
+
+    for (auto&& elem : _obj) {
+        const auto name = elem.fieldNameStringData();
+        const uint32_t hash = hashFieldName(name);
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            auto& slot = _slots[i];
+            if (slot.offset == 0) {
+                slot.hash = hash;
+                slot.offset = static_cast<uint32_t>(elem.rawdata() - _obj.objdata());
+                break;
+            }
+            if (slot.hash == hash && elementAt(slot.offset).fieldNameStringData() == name) {
+                // Keep the first occurrence of a duplicated field name.
+                break;
+            }
+        }
+    }
+}
+
+BSONElement BSONFieldIndex::getField(StringData name) {
+    if (!isBuilt()) {
+        if (_numLookups++ < _buildThreshold) {
+            return _obj.getField(name);
+        }
+        build();
+    }
+
+    const size_t mask = _slots.size() - 1;
+    const uint32_t hash = hashFieldName(name);
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const auto& slot = _slots[i];
+        if (slot.offset == 0) {
+            return BSONElement();
+        }
+        if (slot.hash == hash) {
+            auto elem = elementAt(slot.offset);
+            if (elem.fieldNameStringData() == name) {
+                return elem;
+            }
+        }
+    }
+}
+
+}  // namespace mongo
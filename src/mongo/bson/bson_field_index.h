@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * A side index from top-level field name to the offset of that field within a BSONObj, used to
+ * avoid repeated linear scans when many different fields are looked up in the same wide document.
+ *
+ * The index is built lazily: the first 'buildThreshold' lookups are answered by scanning the
+ * object, and the next one builds an open-addressing hash table over all of the object's fields,
+ * which answers that lookup and all subsequent ones. As with BSONObj::getField(), if a field name
+ * appears more than once, the first occurrence is returned.
+ *
+ * The BSONObj must outlive this index.
+ */
+class BSONFieldIndex {
+public:
+    BSONFieldIndex(const BSONObj& obj, size_t buildThreshold)
+        : _obj(obj), _buildThreshold(buildThreshold) {}
+
+    /**
+     * Returns the first top-level element named 'name', or an EOO element if there is none.
+     */
+    BSONElement getField(StringData name);
+
+    /**
+     * Returns true if the hash table has been built.
+     */
+    bool isBuilt() const {
+        return !_slots.empty();
+    }
+
+private:
+    struct Slot {
+        // The hash of the field name.
+        uint32_t hash = 0;
+
+        // The offset of the element from the start of the object. The first element of an object
+        // follows its four-byte length, so a zero offset marks an empty slot.
+        uint32_t offset = 0;
+    };
+
+    static uint32_t hashFieldName(StringData name);
+
+    void build();
+
+    BSONElement elementAt(uint32_t offset) const {
+        return BSONElement(_obj.objdata() + offset);
+    }
+
+    const BSONObj& _obj;
+    const size_t _buildThreshold;
+
+    size_t _numLookups = 0;
+
+    // The hash table, whose size is a power of two. Empty until built.
+    std::vector<Slot> _slots;
+};
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeWideObject(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    return bob.obj();
+}
+
+TEST(BSONFieldIndex, ScansUntilThresholdIsReached) {
+    BSONObj obj = makeWideObject(10);
+    BSONFieldIndex index(obj, 2);
+
+    ASSERT_EQ(index.getField("f3").numberInt(), 3);
+    ASSERT_EQ(index.getField("f7").numberInt(), 7);
+    ASSERT_FALSE(index.isBuilt());
+
+    ASSERT_EQ(index.getField("f9").numberInt(), 9);
+    ASSERT_TRUE(index.isBuilt());
+}
+
+TEST(BSONFieldIndex, FindsEveryFieldOnceBuilt) {
+    BSONObj obj = makeWideObject(300);
+    BSONFieldIndex index(obj, 0);
+
+    for (int i = 0; i < 300; ++i) {
+        auto name = "f" + std::to_string(i);
+        auto elem = index.getField(name);
+        ASSERT_EQ(elem.fieldNameStringData(), name);
+        ASSERT_EQ(elem.numberInt(), i);
+    }
+    ASSERT_TRUE(index.isBuilt());
+}
+
+TEST(BSONFieldIndex, MissingFieldReturnsEOO) {
+    BSONObj obj = makeWideObject(20);
+    BSONFieldIndex index(obj, 0);
+
+    ASSERT_TRUE(index.getField("missing").eoo());
+    ASSERT_TRUE(index.getField("").eoo());
+    ASSERT_TRUE(index.getField("f20").eoo());
+}
+
+TEST(BSONFieldIndex, EmptyObject) {
+    BSONObj obj;
+    BSONFieldIndex index(obj, 0);
+
+    ASSERT_TRUE(index.getField("a").eoo());
+}
+
+TEST(BSONFieldIndex, DuplicateFieldNameReturnsFirstOccurrence) {
+    BSONObj obj = BSON("a" << 1 << "b" << 2 << "a" << 3);
+    BSONFieldIndex index(obj, 0);
+
+    ASSERT_EQ(index.getField("a").numberInt(), 1);
+    ASSERT_EQ(index.getField("b").numberInt(), 2);
+}
+
+TEST(BSONFieldIndex, MatchesGetFieldBeforeAndAfterBuild) {
+    BSONObj obj = BSON("a" << 1 << "" << 2 << "a.b" << 3 << "c" << BSON("d" << 4));
+    BSONFieldIndex index(obj, 3);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (auto name : {"a", "", "a.b", "c", "d", "x"}) {
+            ASSERT_TRUE(index.getField(name).binaryEqual(obj.getField(name))) << name;
+        }
+    }
+    ASSERT_TRUE(index.isBuilt());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -27,21 +27,51 @@
  *    it in the license file.
  */
 
+#include <boost/container/small_vector.hpp>
 #include <cstring>
 #include <limits>
-#include <vector>
 
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 
 namespace mongo {
 
 namespace {
 
+// Most documents are shallow, so validating them should not require a heap allocation for the
+// stack of enclosing objects.
+constexpr size_t kFewValidationFrames = 16;
+
+/**
+ * Returns a pointer to the first NUL byte in the 'len' bytes starting at 'data', or nullptr if
+ * there is none. Field names are typically short, so rather than paying for a call to memchr()
+ * for each one, this scans eight bytes at a time within a register, falling back to memchr() for
+ * longer strings.
+ */
+const char* findNul(const char* data, uint64_t len) {
+    constexpr uint64_t kLowBits = 0x0101010101010101ULL;
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    constexpr uint64_t kMaxInlineWords = 4;
+
+    uint64_t offset = 0;
+    for (uint64_t word = 0; word < kMaxInlineWords && offset + sizeof(uint64_t) <= len; ++word) {
+        const uint64_t chunk = ConstDataView(data).read<LittleEndian<uint64_t>>(offset);
+        // The lowest set bit of 'zeroes' marks the first zero byte. Bits above it may be spurious.
+        const uint64_t zeroes = (chunk - kLowBits) & ~chunk & kHighBits;
+        if (zeroes) {
+            return data + offset + countTrailingZeros64(zeroes) / 8;
+        }
+        offset += sizeof(uint64_t);
+    }
+
+    return static_cast<const char*>(memchr(data + offset, 0, len - offset));
+}
+
 /**
  * Creates a status with InvalidBSON code and adds information about _id if available.
  * WARNING: only pass in a non-EOO idElem if it has been fully validated already!
@@ -90,10 +120,10 @@ public:
      * reading, if it exists. Otherwise, it should be empty.
      */
     Status readCString(StringData elemName, StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
+        const char* x = findNul(_buffer + _position, _maxLength - _position);
         if (!x)
             return makeError("no end of c-string", _idElem, elemName);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
+        uint64_t len = static_cast<uint64_t>(x - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -309,8 +339,7 @@ Status validateElementInfo(Buffer* buffer,
 }
 
 Status validateBSONIterative(Buffer* buffer) {
-    std::vector<ValidationObjectFrame> frames;
-    frames.reserve(16);
+    boost::container::small_vector<ValidationObjectFrame, kFewValidationFrames> frames;
     ValidationObjectFrame* curr = nullptr;
     ValidationState::State state = ValidationState::BeginObj;
 
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeFlatNumbers(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append("field" + std::to_string(i), i);
+    }
+    return bob.obj();
+}
+
+BSONObj makeFlatStrings(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append("field" + std::to_string(i), "value of field " + std::to_string(i));
+    }
+    return bob.obj();
+}
+
+BSONObj makeLongFieldNames(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append(std::string(64, 'f') + std::to_string(i), i);
+    }
+    return bob.obj();
+}
+
+BSONObj makeArrayOfSubdocuments(int numElements) {
+    BSONObjBuilder bob;
+    BSONArrayBuilder arr(bob.subarrayStart("array"));
+    for (int i = 0; i < numElements; ++i) {
+        arr.append(BSON("a" << i << "b"
+                            << "string"
+                            << "c" << static_cast<double>(i)));
+    }
+    arr.doneFast();
+    return bob.obj();
+}
+
+BSONObj makeNested(int depth) {
+    BSONObj obj = BSON("leaf" << 1);
+    for (int i = 0; i < depth; ++i) {
+        obj = BSON("level" << i << "child" << obj);
+    }
+    return obj;
+}
+
+void runValidation(benchmark::State& state, const BSONObj& obj) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    }
+    invariant(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    state.SetBytesProcessed(state.iterations() * obj.objsize());
+}
+
+void BM_validateFlatNumbers(benchmark::State& state) {
+    runValidation(state, makeFlatNumbers(state.range(0)));
+}
+
+void BM_validateFlatStrings(benchmark::State& state) {
+    runValidation(state, makeFlatStrings(state.range(0)));
+}
+
+void BM_validateLongFieldNames(benchmark::State& state) {
+    runValidation(state, makeLongFieldNames(state.range(0)));
+}
+
+void BM_validateArrayOfSubdocuments(benchmark::State& state) {
+    runValidation(state, makeArrayOfSubdocuments(state.range(0)));
+}
+
+void BM_validateNested(benchmark::State& state) {
+    runValidation(state, makeNested(state.range(0)));
+}
+
+BENCHMARK(BM_validateFlatNumbers)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateFlatStrings)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateLongFieldNames)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateArrayOfSubdocuments)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateNested)->Ranges({{{1}, {100}}});
+
+}  // namespace
+}  // namespace mongo
@@ -365,5 +365,29 @@ TEST(BSONValidateFast, InvalidType) {
     ASSERT_THROWS_CODE(obj.woCompare(BSON("A" << 1)), DBException, 10320);
 }
 
+TEST(BSONValidateFast, FieldNamesOfManyLengths) {
+    // Exercise field names which end within, at the boundary of, and beyond the words which are
+    // scanned before falling back to memchr().
+    for (size_t len = 0; len <= 48; ++len) {
+        const std::string fieldName(len, 'f');
+        BSONObj obj = BSON(fieldName << 1 << "b" << fieldName);
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+        ASSERT_EQ(obj.firstElementFieldNameStringData(), fieldName);
+    }
+}
+
+TEST(BSONValidateFast, UnterminatedFieldName) {
+    // The field name runs to the end of the buffer without a NUL.
+    for (size_t len = 1; len <= 48; ++len) {
+        BufBuilder bb;
+        bb.appendNum(static_cast<int>(sizeof(int) + 1 + len));
+        bb.appendChar(NumberInt);
+        bb.appendStr(std::string(len, 'f'), /*withNUL*/ false);
+        const Status status = validateBSON(bb.buf(), bb.len(), BSONVersion::kLatest);
+        ASSERT_NOT_OK(status);
+        ASSERT_STRING_CONTAINS(status.reason(), "no end of c-string");
+    }
+}
+
 
 }  // namespace
@@ -1255,8 +1255,23 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
         return parseError("Unexpected end of input");
     }
     const char* q = _input;
+    // Quoted strings and regexes end at a single terminal character, so runs of characters needing
+    // no special handling can be found without consulting the character sets and copied at once.
+    const bool singleTerminal = !allowedSet && terminalSet[0] != '\0' && terminalSet[1] == '\0';
     while (q < _input_end && !match(*q, terminalSet)) {
         MONGO_JSON_DEBUG("q: " << q);
+        if (singleTerminal) {
+            const char* runEnd = q;
+            while (runEnd < _input_end && *runEnd != terminalSet[0] && *runEnd != '\\' &&
+                   static_cast<unsigned char>(*runEnd) > 0x1F) {
+                ++runEnd;
+            }
+            if (runEnd != q) {
+                result->append(q, runEnd);
+                q = runEnd;
+                continue;
+            }
+        }
         if (allowedSet != nullptr) {
             if (!match(*q, allowedSet)) {
                 _input = q;
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/mutable/damage_calculator.h"
+
+#include <cstring>
+
+namespace mongo {
+namespace mutablebson {
+
+namespace {
+
+// Nesting depth below which objects which differ are replaced wholesale rather than descended
+// into. Keeps the recursion bounded for pathologically nested documents.
+constexpr int kMaxDepth = 32;
+
+class DamageCalculator {
+public:
+    DamageCalculator(const BSONObj& post, size_t maxDamages, size_t maxDamageBytes)
+        : _postBase(post.objdata()), _maxDamages(maxDamages), _maxDamageBytes(maxDamageBytes) {}
+
+    /**
+     * Appends the damages which turn the object 'pre' into 'post'. Returns false once the limits
+     * have been exceeded.
+     */
+    bool compareObjects(const BSONObj& pre, const BSONObj& post, int depth) {
+        if (pre.objsize() != post.objsize() && !addDamage(post.objdata(), 4, 4)) {
+            return false;
+        }
+
+        BSONObjIterator preIt(pre);
+        BSONObjIterator postIt(post);
+        while (preIt.more() && postIt.more()) {
+            BSONElement preElt = *preIt;
+            BSONElement postElt = *postIt;
+            if (preElt.fieldNameStringData() != postElt.fieldNameStringData()) {
+                break;
+            }
+            preIt.next();
+            postIt.next();
+
+            if (preElt.size() == postElt.size() &&
+                std::memcmp(preElt.rawdata(), postElt.rawdata(), preElt.size()) == 0) {
+                continue;
+            }
+
+            if (preElt.type() == postElt.type() && preElt.isABSONObj() && depth < kMaxDepth) {
+                if (!compareObjects(preElt.Obj(), postElt.Obj(), depth + 1)) {
+                    return false;
+                }
+            } else if (!addDamage(postElt.rawdata(), postElt.size(), preElt.size())) {
+                return false;
+            }
+        }
+
+        // Whatever is left of the two objects, up to their terminating EOO bytes, differs.
+        const char* preRest = preIt.more() ? (*preIt).rawdata() : pre.objdata() + pre.objsize() - 1;
+        const char* postRest =
+            postIt.more() ? (*postIt).rawdata() : post.objdata() + post.objsize() - 1;
+        const size_t preRestSize = pre.objdata() + pre.objsize() - 1 - preRest;
+        const size_t postRestSize = post.objdata() + post.objsize() - 1 - postRest;
+        if ((preRestSize > 0 || postRestSize > 0) &&
+            !addDamage(postRest, postRestSize, preRestSize)) {
+            return false;
+        }
+        return true;
+    }
+
+    ResizingDamageVector releaseDamages() {
+        return std::move(_damages);
+    }
+
+private:
+    bool addDamage(const char* source, size_t sourceSize, size_t targetSize) {
+        _damageBytes += sourceSize;
+        if (_damages.size() >= _maxDamages || _damageBytes > _maxDamageBytes) {
+            return false;
+        }
+        _damages.push_back({static_cast<ResizingDamageEvent::OffsetSizeType>(source - _postBase),
+                            sourceSize,
+                            targetSize});
+        return true;
+    }
+
+    const char* _postBase;
+    const size_t _maxDamages;
+    const size_t _maxDamageBytes;
+    size_t _damageBytes = 0;
+    ResizingDamageVector _damages;
+};
+
+}  // namespace
+
+boost::optional<ResizingDamageVector> computeResizingDamages(const BSONObj& pre,
+                                                             const BSONObj& post,
+                                                             size_t maxDamages,
+                                                             size_t maxDamageBytes) {
+    DamageCalculator calculator(post, maxDamages, maxDamageBytes);
+    if (!calculator.compareObjects(pre, post, 0)) {
+        return boost::none;
+    }
+    return calculator.releaseDamages();
+}
+
+}  // namespace mutablebson
+}  // namespace mongo
@@ -0,0 +1,59 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/mutable/damage_vector.h"
+
+namespace mongo {
+namespace mutablebson {
+
+/**
+ * Computes the damages which turn the BSON 'pre' into 'post', by walking the two objects together
+ * element by element. Elements which are byte-for-byte equal are skipped. A document or array
+ * which is present in both under the same field name is descended into, so that a small change
+ * deep inside a large document results in a small damage to the changed element, along with
+ * 4-byte damages to the sizes of the objects enclosing it. When the field names of the two objects
+ * stop lining up, for example because a field was added or removed, the rest of the object is
+ * reported as a single damage.
+ *
+ * Returns boost::none if more than 'maxDamages' damages, or damages totalling more than
+ * 'maxDamageBytes' bytes of 'post', would be needed. Returns an empty vector if 'pre' and 'post'
+ * are identical.
+ */
+boost::optional<ResizingDamageVector> computeResizingDamages(const BSONObj& pre,
+                                                             const BSONObj& post,
+                                                             size_t maxDamages,
+                                                             size_t maxDamageBytes);
+
+}  // namespace mutablebson
+}  // namespace mongo
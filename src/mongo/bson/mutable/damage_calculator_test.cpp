@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/mutable/damage_calculator.h"
+
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+namespace mmb = mongo::mutablebson;
+
+const size_t kNoLimit = std::numeric_limits<size_t>::max();
+
+/**
+ * Applies 'damages', in order, to the bytes of 'pre', taking the replacement bytes from 'post'.
+ */
+std::string applyDamages(const BSONObj& pre,
+                         const BSONObj& post,
+                         const mmb::ResizingDamageVector& damages) {
+    std::string buffer(pre.objdata(), pre.objsize());
+    for (auto&& damage : damages) {
+        buffer.replace(
+            damage.offset, damage.targetSize, post.objdata() + damage.offset, damage.sourceSize);
+    }
+    return buffer;
+}
+
+mmb::ResizingDamageVector assertDamagesProducePost(const BSONObj& pre, const BSONObj& post) {
+    auto damages = mmb::computeResizingDamages(pre, post, kNoLimit, kNoLimit);
+    ASSERT(damages);
+    ASSERT_EQ(applyDamages(pre, post, *damages), std::string(post.objdata(), post.objsize()))
+        << "pre: " << pre << ", post: " << post;
+    return std::move(*damages);
+}
+
+TEST(ResizingDamageCalculatorTest, IdenticalObjectsHaveNoDamages) {
+    BSONObj obj = fromjson("{a: 1, b: {c: 'foo'}}");
+    ASSERT_EQ(assertDamagesProducePost(obj, obj.copy()).size(), 0U);
+}
+
+TEST(ResizingDamageCalculatorTest, SameSizeChangeIsOneDamage) {
+    BSONObj pre = fromjson("{a: 1, b: 2, c: 3}");
+    BSONObj post = fromjson("{a: 1, b: 5, c: 3}");
+    auto damages = assertDamagesProducePost(pre, post);
+    ASSERT_EQ(damages.size(), 1U);
+    ASSERT_EQ(damages[0].sourceSize, damages[0].targetSize);
+}
+
+TEST(ResizingDamageCalculatorTest, NestedGrowthDamagesOnlySizesAndChangedElement) {
+    BSONObjBuilder padding;
+    padding.append("big", std::string(10000, 'x'));
+    BSONObj pre = BSON("_id" << 1 << "stats" << BSON("count" << 1 << "other" << 2) << "padding"
+                             << padding.obj());
+    BSONObj post = BSON("_id" << 1 << "stats" << BSON("count" << 1LL << "other" << 2) << "padding"
+                              << pre["padding"].Obj());
+    auto damages = assertDamagesProducePost(pre, post);
+
+    // The document size, the 'stats' size and the 'count' element.
+    ASSERT_EQ(damages.size(), 3U);
+    size_t damageBytes = 0;
+    for (auto&& damage : damages) {
+        damageBytes += damage.sourceSize;
+    }
+    ASSERT_LT(damageBytes, 32U);
+}
+
+TEST(ResizingDamageCalculatorTest, AddedAndRemovedFields) {
+    assertDamagesProducePost(fromjson("{a: 1, b: 2}"), fromjson("{a: 1, b: 2, c: 3}"));
+    assertDamagesProducePost(fromjson("{a: 1, b: 2, c: 3}"), fromjson("{a: 1, b: 2}"));
+    assertDamagesProducePost(fromjson("{a: 1, b: 2, c: 3}"), fromjson("{a: 1, c: 3}"));
+    assertDamagesProducePost(fromjson("{a: 1}"), fromjson("{b: 1}"));
+    assertDamagesProducePost(fromjson("{}"), fromjson("{a: {b: 1}}"));
+    assertDamagesProducePost(fromjson("{a: {b: 1}}"), fromjson("{}"));
+}
+
+TEST(ResizingDamageCalculatorTest, ArraysAndTypeChanges) {
+    assertDamagesProducePost(fromjson("{a: [1, 2, 3]}"), fromjson("{a: [1, 2, 3, 4]}"));
+    assertDamagesProducePost(fromjson("{a: [1, {b: 2}, 3]}"), fromjson("{a: [1, {b: 'two'}, 3]}"));
+    assertDamagesProducePost(fromjson("{a: [1, 2]}"), fromjson("{a: {'0': 1, '1': 2}}"));
+    assertDamagesProducePost(fromjson("{a: {b: 1}, c: 1}"), fromjson("{a: 'x', c: 2}"));
+    assertDamagesProducePost(fromjson("{a: {b: {c: {d: 1}}}, e: 1}"),
+                             fromjson("{a: {b: {c: {d: 'longer'}}}, e: 2}"));
+}
+
+TEST(ResizingDamageCalculatorTest, RespectsLimits) {
+    BSONObj pre = fromjson("{a: 1, b: 1, c: 1}");
+    BSONObj post = fromjson("{a: 2, b: 2, c: 2}");
+    ASSERT(mmb::computeResizingDamages(pre, post, 3, kNoLimit));
+    ASSERT_FALSE(mmb::computeResizingDamages(pre, post, 2, kNoLimit));
+    ASSERT_FALSE(mmb::computeResizingDamages(pre, post, kNoLimit, 1));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -54,5 +54,25 @@ struct DamageEvent {
 
 typedef std::vector<DamageEvent> DamageVector;
 
+// A resizing damage event describes one region in which a new version of a buffer differs from
+// the old version: the 'targetSize' bytes at offset 'offset' of the old version are replaced by
+// the 'sourceSize' bytes at offset 'offset' of the new version. The events of a
+// ResizingDamageVector are sorted by offset and do not overlap. Applying them in order, each
+// 'offset' is also the offset in the old version once all events before it have been applied.
+struct ResizingDamageEvent {
+    typedef uint32_t OffsetSizeType;
+
+    // Offset of the damaged region in the new version of the buffer.
+    OffsetSizeType offset;
+
+    // Size of the damaged region in the new version of the buffer.
+    size_t sourceSize;
+
+    // Size of the region being replaced in the old version of the buffer.
+    size_t targetSize;
+};
+
+typedef std::vector<ResizingDamageEvent> ResizingDamageVector;
+
 }  // namespace mutablebson
 }  // namespace mongo
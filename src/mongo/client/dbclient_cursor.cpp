@@ -159,7 +159,14 @@ Message DBClientCursor::_assembleInit() {
                           .obj();
             }
 
-            return assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            auto msg = assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            // Servers that support it stream the batches following the first one straight away.
+            // Tailable cursors start the stream with their first getMore instead.
+            if (opts & QueryOption_Exhaust && !(opts & QueryOption_CursorTailable) &&
+                msg.operation() == dbMsg) {
+                OpMsg::setFlag(&msg, OpMsg::kExhaustSupported);
+            }
+            return msg;
         }
         // else use legacy OP_QUERY request.
         // Legacy OP_QUERY request does not support UUIDs.
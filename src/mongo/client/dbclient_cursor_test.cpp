@@ -214,7 +214,7 @@ TEST_F(DBClientCursorTest, DBClientCursorHandlesOpMsgExhaustCorrectly) {
     auto m = conn.getLastSentMessage();
     ASSERT(!m.empty());
     auto msg = OpMsg::parse(m);
-    ASSERT_EQ(OpMsg::flags(m), OpMsg::kChecksumPresent);
+    ASSERT_EQ(OpMsg::flags(m), OpMsg::kChecksumPresent | OpMsg::kExhaustSupported);
     ASSERT_EQ(msg.body.getStringField("find"), nss.coll());
     ASSERT_EQ(msg.body["batchSize"].number(), 0);
 
@@ -258,6 +258,54 @@ TEST_F(DBClientCursorTest, DBClientCursorHandlesOpMsgExhaustCorrectly) {
     ASSERT(cursor.isDead());
 }
 
+TEST_F(DBClientCursorTest, DBClientCursorReceivesBatchesStreamedAfterExhaustFind) {
+
+    // Set up the DBClientCursor and a mock client connection.
+    DBClientConnectionForTest conn;
+    const NamespaceString nss("test", "coll");
+    DBClientCursor cursor(
+        &conn, NamespaceStringOrUUID(nss), Query().obj, 0, 0, nullptr, QueryOption_Exhaust, 0);
+    cursor.setBatchSize(2);
+
+    // Set up a mock 'find' response with the 'moreToCome' flag set, as sent by a server which
+    // streams the batches following the first one.
+    const long long cursorId = 42;
+    Message findResponseMsg = mockFindResponse(nss, cursorId, {docObj(1), docObj(2)});
+    OpMsg::setFlag(&findResponseMsg, OpMsg::kMoreToCome);
+
+    conn.setCallResponse(findResponseMsg);
+    ASSERT(cursor.init());
+
+    auto m = conn.getLastSentMessage();
+    ASSERT(!m.empty());
+    ASSERT(OpMsg::isFlagSet(m, OpMsg::kExhaustSupported));
+    ASSERT_EQ(OpMsg::parse(m).body.getStringField("find"), nss.coll());
+    ASSERT_BSONOBJ_EQ(docObj(1), cursor.next());
+    ASSERT_BSONOBJ_EQ(docObj(2), cursor.next());
+
+    // The next batch is received without sending a 'getMore'.
+    auto getMoreResponseMsg = mockGetMoreResponse(nss, cursorId, {docObj(3), docObj(4)});
+    OpMsg::setFlag(&getMoreResponseMsg, OpMsg::kMoreToCome);
+    conn.setRecvResponse(getMoreResponseMsg);
+
+    conn.clearLastSentMessage();
+    ASSERT(cursor.more());
+    ASSERT(conn.getLastSentMessage().empty());
+    ASSERT_BSONOBJ_EQ(docObj(3), cursor.next());
+    ASSERT_BSONOBJ_EQ(docObj(4), cursor.next());
+
+    // So is the terminal batch, after which the cursor is exhausted.
+    auto terminalDoc = BSON("_id"
+                            << "terminal");
+    conn.setRecvResponse(mockGetMoreResponse(nss, 0, {terminalDoc}));
+
+    ASSERT(cursor.more());
+    ASSERT(conn.getLastSentMessage().empty());
+    ASSERT_BSONOBJ_EQ(terminalDoc, cursor.next());
+    ASSERT(!cursor.more());
+    ASSERT(cursor.isDead());
+}
+
 TEST_F(DBClientCursorTest, DBClientCursorResendsGetMoreIfMoreToComeFlagIsOmittedInExhaustMessage) {
 
     // Set up the DBClientCursor and a mock client connection.
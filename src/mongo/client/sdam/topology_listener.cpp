@@ -48,71 +48,75 @@ void TopologyEventsPublisher::close() {
 
 void TopologyEventsPublisher::onTopologyDescriptionChangedEvent(
     TopologyDescriptionPtr previousDescription, TopologyDescriptionPtr newDescription) {
-    {
-        stdx::lock_guard lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::TOPOLOGY_DESCRIPTION_CHANGED;
-        event->previousDescription = previousDescription;
-        event->newDescription = newDescription;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::TOPOLOGY_DESCRIPTION_CHANGED;
+    event->previousDescription = previousDescription;
+    event->newDescription = newDescription;
+    _enqueueEvent(std::move(event));
 }
 
 void TopologyEventsPublisher::onServerHandshakeCompleteEvent(IsMasterRTT durationMs,
                                                              const HostAndPort& address,
                                                              const BSONObj reply) {
-    {
-        stdx::lock_guard<Mutex> lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::HANDSHAKE_COMPLETE;
-        event->duration = duration_cast<IsMasterRTT>(durationMs);
-        event->hostAndPort = address;
-        event->reply = reply;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::HANDSHAKE_COMPLETE;
+    event->duration = duration_cast<IsMasterRTT>(durationMs);
+    event->hostAndPort = address;
+    event->reply = reply;
+    _enqueueEvent(std::move(event));
 }
 
 void TopologyEventsPublisher::onServerHandshakeFailedEvent(const HostAndPort& address,
                                                            const Status& status,
                                                            const BSONObj reply) {
-    {
-        stdx::lock_guard<Mutex> lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::HANDSHAKE_FAILURE;
-        event->hostAndPort = address;
-        event->reply = reply;
-        event->status = status;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::HANDSHAKE_FAILURE;
+    event->hostAndPort = address;
+    event->reply = reply;
+    event->status = status;
+    _enqueueEvent(std::move(event));
 }
 
 void TopologyEventsPublisher::onServerHeartbeatSucceededEvent(const HostAndPort& hostAndPort,
                                                               const BSONObj reply) {
-    {
-        stdx::lock_guard lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::HEARTBEAT_SUCCESS;
-        event->hostAndPort = hostAndPort;
-        event->reply = reply;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::HEARTBEAT_SUCCESS;
+    event->hostAndPort = hostAndPort;
+    event->reply = reply;
+    _enqueueEvent(std::move(event));
 }
 
 void TopologyEventsPublisher::onServerHeartbeatFailureEvent(Status errorStatus,
                                                             const HostAndPort& hostAndPort,
                                                             const BSONObj reply) {
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::HEARTBEAT_FAILURE;
+    event->hostAndPort = hostAndPort;
+    event->reply = reply;
+    event->status = errorStatus;
+    _enqueueEvent(std::move(event));
+}
+
+void TopologyEventsPublisher::_enqueueEvent(EventPtr event) {
     {
         stdx::lock_guard lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::HEARTBEAT_FAILURE;
-        event->hostAndPort = hostAndPort;
-        event->reply = reply;
-        event->status = errorStatus;
+
+        // A topology description change that has not been delivered yet is superseded by the
+        // next one; listeners only care about the transition from the oldest undelivered
+        // description to the newest, so fold the two into a single event.
+        if (event->type == EventType::TOPOLOGY_DESCRIPTION_CHANGED && !_eventQueue.empty() &&
+            _eventQueue.back()->type == EventType::TOPOLOGY_DESCRIPTION_CHANGED) {
+            _eventQueue.back()->newDescription = std::move(event->newDescription);
+            return;
+        }
+
         _eventQueue.push_back(std::move(event));
+
+        // A delivery that is already scheduled or running drains the whole queue.
+        if (_isDeliveryScheduled) {
+            return;
+        }
+        _isDeliveryScheduled = true;
     }
     _scheduleNextDelivery();
 }
@@ -125,57 +129,59 @@ void TopologyEventsPublisher::_scheduleNextDelivery() {
 
 void TopologyEventsPublisher::onServerPingFailedEvent(const HostAndPort& hostAndPort,
                                                       const Status& status) {
-    {
-        stdx::lock_guard lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::PING_FAILURE;
-        event->hostAndPort = hostAndPort;
-        event->status = status;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::PING_FAILURE;
+    event->hostAndPort = hostAndPort;
+    event->status = status;
+    _enqueueEvent(std::move(event));
 }
 
 void TopologyEventsPublisher::onServerPingSucceededEvent(IsMasterRTT durationMS,
                                                          const HostAndPort& hostAndPort) {
-    {
-        stdx::lock_guard lock(_eventQueueMutex);
-        EventPtr event = std::make_unique<Event>();
-        event->type = EventType::PING_SUCCESS;
-        event->duration = duration_cast<IsMasterRTT>(durationMS);
-        event->hostAndPort = hostAndPort;
-        _eventQueue.push_back(std::move(event));
-    }
-    _scheduleNextDelivery();
+    EventPtr event = std::make_unique<Event>();
+    event->type = EventType::PING_SUCCESS;
+    event->duration = duration_cast<IsMasterRTT>(durationMS);
+    event->hostAndPort = hostAndPort;
+    _enqueueEvent(std::move(event));
 }
 
-// note that this could be done in batches if it is a bottleneck.
 void TopologyEventsPublisher::_nextDelivery() {
-    // get the next event to send
-    EventPtr nextEvent;
-    {
-        stdx::lock_guard lock(_eventQueueMutex);
-        if (!_eventQueue.size()) {
-            return;
+    // Deliver events in batches until the queue is empty. Only one delivery runs at a time, so
+    // listeners observe events in the order they were published.
+    while (true) {
+        std::deque<EventPtr> batch;
+        {
+            stdx::lock_guard lock(_eventQueueMutex);
+            if (_eventQueue.empty()) {
+                _isDeliveryScheduled = false;
+                return;
+            }
+            batch.swap(_eventQueue);
         }
-        nextEvent = std::move(_eventQueue.front());
-        _eventQueue.pop_front();
-    }
 
-    // release the lock before sending to avoid deadlock in the case there
-    // are events generated by sending the current one.
-    std::vector<TopologyListenerPtr> listeners;
-    {
-        stdx::lock_guard lock(_mutex);
-        if (_isClosed) {
+        // release the lock before sending to avoid deadlock in the case there
+        // are events generated by sending the current ones.
+        std::vector<TopologyListenerPtr> listeners;
+        bool isClosed;
+        {
+            stdx::lock_guard lock(_mutex);
+            isClosed = _isClosed;
+            listeners = _listeners;
+        }
+
+        if (isClosed) {
+            stdx::lock_guard lock(_eventQueueMutex);
+            _eventQueue.clear();
+            _isDeliveryScheduled = false;
             return;
         }
-        listeners = _listeners;
-    }
 
-    // send to the listeners outside of the lock.
-    for (auto listener : listeners) {
-        _sendEvent(listener, *nextEvent);
+        // send to the listeners outside of the lock.
+        for (const auto& event : batch) {
+            for (const auto& listener : listeners) {
+                _sendEvent(listener, *event);
+            }
+        }
     }
 }
 
@@ -144,6 +144,7 @@ private:
     using EventPtr = std::unique_ptr<Event>;
 
     void _sendEvent(TopologyListenerPtr listener, const TopologyEventsPublisher::Event& event);
+    void _enqueueEvent(EventPtr event);
     void _nextDelivery();
     void _scheduleNextDelivery();
 
@@ -151,6 +152,8 @@ private:
     Mutex _eventQueueMutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(6),
                                               "TopologyEventsPublisher::_eventQueueMutex");
     std::deque<EventPtr> _eventQueue;
+    // True while a delivery task is scheduled or draining _eventQueue.
+    bool _isDeliveryScheduled = false;
 
     Mutex _mutex =
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(5), "TopologyEventsPublisher::_mutex");
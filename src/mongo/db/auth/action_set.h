@@ -95,6 +95,11 @@ public:
         return lhs.equals(rhs);
     }
 
+    template <typename H>
+    friend H AbslHashValue(H h, const ActionSet& actionSet) {
+        return H::combine(std::move(h), actionSet._actions);
+    }
+
 private:
     // bitmask of actions this privilege grants
     std::bitset<kNumActionTypes> _actions;
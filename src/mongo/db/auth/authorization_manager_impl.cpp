@@ -322,6 +322,7 @@ auto authorizationManagerCreateRegistration =
 }  // namespace
 
 int authorizationManagerCacheSize;
+int authorizationManagerCacheStaleWhileRevalidateMillis;
 
 void AuthorizationManagerPinnedUsersServerParameter::append(OperationContext* opCtx,
                                                             BSONObjBuilder& out,
@@ -687,7 +688,9 @@ AuthorizationManagerImpl::UserCacheImpl::UserCacheImpl(
                 },
                 cacheSize),
       _authSchemaVersionCache(authSchemaVersionCache),
-      _externalState(externalState) {}
+      _externalState(externalState) {
+    setStaleWhileRevalidateBound(Milliseconds(authorizationManagerCacheStaleWhileRevalidateMillis));
+}
 
 AuthorizationManagerImpl::UserCacheImpl::LookupResult
 AuthorizationManagerImpl::UserCacheImpl::_lookup(OperationContext* opCtx,
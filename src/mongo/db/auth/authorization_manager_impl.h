@@ -201,5 +201,6 @@ private:
 };
 
 extern int authorizationManagerCacheSize;
+extern int authorizationManagerCacheStaleWhileRevalidateMillis;
 
 }  // namespace mongo
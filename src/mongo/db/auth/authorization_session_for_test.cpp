@@ -67,6 +67,7 @@ void AuthorizationSessionForTest::revokePrivilegesForDB(StringData dbName) {
                        _testUsers.end(),
                        [&](const auto& user) { return dbName == user->getName().getDB(); }),
         _testUsers.end());
+    _buildAuthenticatedRolesVector();
 }
 
 void AuthorizationSessionForTest::revokeAllPrivileges() {
@@ -77,5 +78,6 @@ void AuthorizationSessionForTest::revokeAllPrivileges() {
                                         return true;
                                     }),
                      _testUsers.end());
+    _buildAuthenticatedRolesVector();
 }
 }  // namespace mongo
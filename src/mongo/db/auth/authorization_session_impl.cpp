@@ -735,10 +735,13 @@ bool AuthorizationSessionImpl::isAuthenticated() {
 void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
     AuthorizationManager& authMan = getAuthorizationManager();
     UserSet::iterator it = _authenticatedUsers.begin();
+    bool usersChanged = false;
 
     while (it != _authenticatedUsers.end()) {
         auto& user = *it;
         if (!user.isValid()) {
+            usersChanged = true;
+
             // Make a good faith effort to acquire an up-to-date user object, since the one
             // we've cached is marked "out-of-date."
             UserName name = user->getName();
@@ -822,10 +825,16 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
         }
         ++it;
     }
-    _buildAuthenticatedRolesVector();
+
+    // The users of a session only change here when one has been marked invalid, so the roles and
+    // the memoized authorization checks of a session whose users are all valid stay as they are.
+    if (usersChanged) {
+        _buildAuthenticatedRolesVector();
+    }
 }
 
 void AuthorizationSessionImpl::_buildAuthenticatedRolesVector() {
+    _memoizedPrivilegeChecks.clear();
     _authenticatedRoleNames.clear();
     for (UserSet::iterator it = _authenticatedUsers.begin(); it != _authenticatedUsers.end();
          ++it) {
@@ -904,6 +913,28 @@ bool AuthorizationSessionImpl::isAuthorizedForAnyActionOnResource(const Resource
 
 
 bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privilege) {
+    // The default privileges come and go with the localhost exception, independently of the
+    // authenticated users, so checks which may depend on them are not memoized.
+    PrivilegeVector defaultPrivileges = getDefaultPrivileges();
+    if (!defaultPrivileges.empty()) {
+        return _checkPrivilege(privilege, defaultPrivileges);
+    }
+
+    auto key = std::make_pair(privilege.getResourcePattern(), privilege.getActions());
+    if (auto it = _memoizedPrivilegeChecks.find(key); it != _memoizedPrivilegeChecks.end()) {
+        return it->second;
+    }
+
+    const bool authorized = _checkPrivilege(privilege, defaultPrivileges);
+    if (_memoizedPrivilegeChecks.size() >= kMaxMemoizedPrivilegeChecks) {
+        _memoizedPrivilegeChecks.clear();
+    }
+    _memoizedPrivilegeChecks.emplace(std::move(key), authorized);
+    return authorized;
+}
+
+bool AuthorizationSessionImpl::_checkPrivilege(const Privilege& privilege,
+                                               const PrivilegeVector& defaultPrivileges) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
     ResourcePattern resourceSearchList[resourceSearchListCapacity];
@@ -911,8 +942,8 @@ bool AuthorizationSessionImpl::_isAuthorizedForPrivilege(const Privilege& privil
 
     ActionSet unmetRequirements = privilege.getActions();
 
-    PrivilegeVector defaultPrivileges = getDefaultPrivileges();
-    for (PrivilegeVector::iterator it = defaultPrivileges.begin(); it != defaultPrivileges.end();
+    for (PrivilegeVector::const_iterator it = defaultPrivileges.begin();
+         it != defaultPrivileges.end();
          ++it) {
         for (int i = 0; i < resourceSearchListLength; ++i) {
             if (!(it->getResourcePattern() == resourceSearchList[i]))
@@ -43,6 +43,7 @@
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -198,7 +199,8 @@ public:
 protected:
     // Builds a vector of all roles held by users who are authenticated on this connection. The
     // vector is stored in _authenticatedRoleNames. This function is called when users are
-    // logged in or logged out, as well as when the user cache is determined to be out of date.
+    // logged in or logged out, as well as when the user cache is determined to be out of date,
+    // and so also forgets the authorization checks memoized for the previous set of users.
     void _buildAuthenticatedRolesVector();
 
     // All Users who have been authenticated on this connection.
@@ -219,6 +221,10 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Checks 'privilege' against the privileges of the authenticated users and 'defaultPrivileges'
+    // without consulting the memoized authorization checks.
+    bool _checkPrivilege(const Privilege& privilege, const PrivilegeVector& defaultPrivileges);
+
     std::tuple<std::vector<UserName>*, std::vector<RoleName>*> _getImpersonations() override {
         return std::make_tuple(&_impersonatedUserNames, &_impersonatedRoleNames);
     }
@@ -230,5 +236,12 @@ private:
     std::vector<UserName> _impersonatedUserNames;
     std::vector<RoleName> _impersonatedRoleNames;
     bool _impersonationFlag;
+
+    // The results of the authorization checks made against the current set of authenticated
+    // users, so that the commands of a connection don't walk the users' privileges again for
+    // every check. The User objects of a session are immutable, and every change to the set of
+    // users clears this map. Dropped wholesale when it reaches kMaxMemoizedPrivilegeChecks.
+    static constexpr size_t kMaxMemoizedPrivilegeChecks = 256;
+    stdx::unordered_map<std::pair<ResourcePattern, ActionSet>, bool> _memoizedPrivilegeChecks;
 };
 }  // namespace mongo
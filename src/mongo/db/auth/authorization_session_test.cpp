@@ -234,6 +234,51 @@ TEST_F(AuthorizationSessionTest, AddUserAndCheckAuthorization) {
         authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::collMod));
 }
 
+TEST_F(AuthorizationSessionTest, MemoizedChecksFollowLocalhostExceptionAndUserChanges) {
+    const auto adminDBResource = ResourcePattern::forDatabaseName("admin");
+
+    // The localhost exception grants createUser on admin without any authenticated users.
+    sessionState->setReturnValueForShouldAllowLocalhost(true);
+    ASSERT_TRUE(
+        authzSession->isAuthorizedForActionsOnResource(adminDBResource, ActionType::createUser));
+
+    // Once it is gone, the earlier answer is not reused.
+    sessionState->setReturnValueForShouldAllowLocalhost(false);
+    ASSERT_FALSE(
+        authzSession->isAuthorizedForActionsOnResource(adminDBResource, ActionType::createUser));
+    ASSERT_FALSE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::insert));
+
+    // Nor is a denial made before a user who holds the privilege authenticated.
+    ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
+                                                    BSON("user"
+                                                         << "spencer"
+                                                         << "db"
+                                                         << "test"
+                                                         << "credentials" << credentials << "roles"
+                                                         << BSON_ARRAY(BSON("role"
+                                                                            << "readWrite"
+                                                                            << "db"
+                                                                            << "test"))),
+                                                    BSONObj()));
+    ASSERT_OK(authzSession->addAndAuthorizeUser(_opCtx.get(), UserName("spencer", "test")));
+    ASSERT_TRUE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::insert));
+
+    // Requests which find every user valid keep the memoized answers.
+    for (int i = 0; i < 3; ++i) {
+        authzSession->startRequest(_opCtx.get());
+        ASSERT_TRUE(authzSession->isAuthorizedForActionsOnResource(testFooCollResource,
+                                                                   ActionType::insert));
+        ASSERT_FALSE(authzSession->isAuthorizedForActionsOnResource(adminDBResource,
+                                                                    ActionType::createUser));
+    }
+
+    authzSession->logoutDatabase(_opCtx.get(), "test");
+    ASSERT_FALSE(
+        authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::insert));
+}
+
 TEST_F(AuthorizationSessionTest, DuplicateRolesOK) {
     // Add a user with doubled-up readWrite and single dbAdmin on the test DB
     ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
@@ -55,8 +55,10 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/base64.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/sequence_util.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -183,10 +185,24 @@ Status doSaslStep(OperationContext* opCtx,
 
     auto& mechanism = session->getMechanism();
 
+    // Account for the time spent verifying the client, but not for the delay on failure.
+    Timer timer;
+    auto recordTime = makeGuard([&] {
+        authCounter
+            .incAuthenticationTime(mechanism.mechanismName().toString(),
+                                   Microseconds(timer.micros()))
+            .ignore();
+    });
+
     // Passing in a payload and extracting a responsePayload
     StatusWith<std::string> swResponse = mechanism.step(opCtx, payload);
 
     if (!swResponse.isOK()) {
+        recordTime.dismiss();
+        authCounter
+            .incAuthenticationTime(mechanism.mechanismName().toString(),
+                                   Microseconds(timer.micros()))
+            .ignore();
         LOGV2(20249,
               "SASL {mechanism} authentication failed for "
               "{principalName} on {authenticationDatabase} from client "
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cmath>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/decimal128.h"
+
+namespace mongo {
+namespace clustered_util {
+
+/**
+ * Returns the RecordId under which a clustered collection stores the document with _id 'id', or
+ * boost::none if no document of a clustered collection can have that _id.
+ *
+ * A clustered collection stores each document under the RecordId equal to its _id, which must
+ * therefore be a number with a positive integral value in the range of normal RecordIds. Numbers
+ * of different types compare equal as _id values when their values are equal, so they map to the
+ * same RecordId.
+ */
+inline boost::optional<RecordId> recordIdForId(const BSONElement& id) {
+    long long value;
+    switch (id.type()) {
+        case NumberInt:
+        case NumberLong:
+            value = id.numberLong();
+            break;
+        case NumberDouble: {
+            const double d = id.numberDouble();
+            // 2^63 is not representable as a long long.
+            if (!(d >= 1 && d < 9223372036854775808.0) || std::trunc(d) != d) {
+                return boost::none;
+            }
+            value = static_cast<long long>(d);
+            break;
+        }
+        case NumberDecimal: {
+            uint32_t signalingFlags = Decimal128::kNoFlag;
+            value = id.numberDecimal().toLongExact(&signalingFlags);
+            if (signalingFlags != Decimal128::kNoFlag) {
+                return boost::none;
+            }
+            break;
+        }
+        default:
+            return boost::none;
+    }
+
+    RecordId recordId(value);
+    if (!recordId.isNormal()) {
+        return boost::none;
+    }
+    return recordId;
+}
+
+}  // namespace clustered_util
+}  // namespace mongo
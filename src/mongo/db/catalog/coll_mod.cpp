@@ -75,6 +75,7 @@ struct CollModRequest {
     boost::optional<std::string> collValidationAction;
     boost::optional<std::string> collValidationLevel;
     bool recordPreImages = false;
+    boost::optional<bool> appendOnly;
 };
 
 StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
@@ -257,6 +258,17 @@ StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
             }
 
             cmr.recordPreImages = e.trueValue();
+        } else if (fieldName == "appendOnly") {
+            if (isView) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream() << "option not supported on a view: " << fieldName};
+            }
+            if (coll->isCapped()) {
+                return {ErrorCodes::InvalidOptions,
+                        "'appendOnly' option not supported on a capped collection"};
+            }
+
+            cmr.appendOnly = e.trueValue();
         } else {
             if (isView) {
                 return Status(ErrorCodes::InvalidOptions,
@@ -491,6 +503,10 @@ Status _collModInternal(OperationContext* opCtx,
             coll->setRecordPreImages(opCtx, cmrNew.recordPreImages);
         }
 
+        if (cmrNew.appendOnly && *cmrNew.appendOnly != oldCollOptions.appendOnly) {
+            coll->setAppendOnly(opCtx, *cmrNew.appendOnly);
+        }
+
         // Only observe non-view collMods, as view operations are observed as operations on the
         // system.views collection.
         auto* const opObserver = opCtx->getServiceContext()->getOpObserver();
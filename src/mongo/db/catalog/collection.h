@@ -242,7 +242,7 @@ public:
     };
 
     /**
-     * Callback function for callers of insertDocumentForBulkLoader().
+     * Callback function for callers of insertDocumentsForBulkLoader().
      */
     using OnRecordInsertedFn = std::function<Status(const RecordId& loc)>;
 
@@ -363,15 +363,16 @@ public:
                                            const std::vector<Timestamp>& timestamps) = 0;
 
     /**
-     * Inserts a document into the record store for a bulk loader that manages the index building
-     * outside this Collection. The bulk loader is notified with the RecordId of the document
-     * inserted into the RecordStore.
+     * Inserts the documents in [begin, end) into the record store, with a single batched write,
+     * for a bulk loader that manages the index building outside this Collection. The bulk loader
+     * is notified, in order, with the RecordId of each document inserted into the RecordStore.
      *
      * NOTE: It is up to caller to commit the indexes.
      */
-    virtual Status insertDocumentForBulkLoader(OperationContext* const opCtx,
-                                               const BSONObj& doc,
-                                               const OnRecordInsertedFn& onRecordInserted) = 0;
+    virtual Status insertDocumentsForBulkLoader(OperationContext* const opCtx,
+                                                std::vector<BSONObj>::const_iterator begin,
+                                                std::vector<BSONObj>::const_iterator end,
+                                                const OnRecordInsertedFn& onRecordInserted) = 0;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -468,6 +469,19 @@ public:
     virtual bool getRecordPreImages() const = 0;
     virtual void setRecordPreImages(OperationContext* opCtx, bool val) = 0;
 
+    /**
+     * Returns true if updates and deletes of the documents in this collection are forbidden, other
+     * than those applied by replication or chunk migration.
+     */
+    virtual bool isAppendOnly() const = 0;
+    virtual void setAppendOnly(OperationContext* opCtx, bool val) = 0;
+
+    /**
+     * Returns true if this collection stores each document under the RecordId given by its _id,
+     * in place of an _id index. See clustered_util::recordIdForId().
+     */
+    virtual bool isClustered() const = 0;
+
     /**
      * Returns true if this is a temporary collection.
      *
@@ -520,6 +534,27 @@ public:
 
     virtual void setMinimumVisibleSnapshot(const Timestamp name) = 0;
 
+    /**
+     * Returns a version which changes after every committed write to this collection. Versions are
+     * unique across all Collection instances in the process, so an unchanged version means that the
+     * contents of the collection are unchanged since the version was last observed.
+     */
+    virtual uint64_t getWriteVersion() const = 0;
+
+    /**
+     * Returns a version drawn from the same sequence as the write version, which changes after
+     * every committed write to this collection except for inserts whose _id is greater than that of
+     * every document inserted before. While it is unchanged, results over the documents of an
+     * append-only collection whose _id is no greater than getNewestInsertedId() are unchanged.
+     */
+    virtual uint64_t getAppendVersion() const = 0;
+
+    /**
+     * Returns the greatest _id inserted into this append-only collection since it was loaded, as
+     * the only element of the returned object, or an empty object if it is not known.
+     */
+    virtual BSONObj getNewestInsertedId() const = 0;
+
     /**
      * Get a pointer to the collection's default collator. The pointer must not be used after this
      * Collection is destroyed.
@@ -546,6 +581,17 @@ public:
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         ScanDirection scanDirection) = 0;
 
+    /**
+     * Returns a plan executor over the documents of this collection that match 'filter' under
+     * 'collation', planned like a find. Returns an error if the planner cannot answer the filter
+     * without scanning the whole collection.
+     */
+    virtual StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
+    makeIndexedPlanExecutor(OperationContext* opCtx,
+                            const BSONObj& filter,
+                            const BSONObj& collation,
+                            PlanYieldPolicy::YieldPolicy yieldPolicy) = 0;
+
     virtual void indexBuildSuccess(OperationContext* opCtx, IndexCatalogEntry* index) = 0;
 
     /**
@@ -291,8 +291,10 @@ Collection* CollectionCatalog::lookupCollectionByNamespace(OperationContext* opC
         return coll;
     }
 
+    // Hash the namespace before taking the lock, which every catalog lookup contends on.
+    const auto hash = _collections.hash_function()(nss);
     stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
+    auto it = _collections.find(nss, hash);
     auto coll = (it == _collections.end() ? nullptr : it->second);
     return (coll && coll->isCommitted()) ? coll : nullptr;
 }
@@ -306,9 +308,14 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
     stdx::lock_guard<Latch> lock(_catalogLock);
     auto foundIt = _catalog.find(uuid);
     if (foundIt != _catalog.end()) {
-        boost::optional<NamespaceString> ns = foundIt->second->ns();
-        invariant(!ns.get().isEmpty());
-        return _collections.find(ns.get())->second->isCommitted() ? ns : boost::none;
+        // Only copy the namespace once it is known to be returned. The entry in '_collections'
+        // for this namespace is the same collection, so there is no need to look it up again.
+        const NamespaceString& ns = foundIt->second->ns();
+        invariant(!ns.isEmpty());
+        if (!foundIt->second->isCommitted()) {
+            return boost::none;
+        }
+        return ns;
     }
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
@@ -328,8 +335,9 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return coll->uuid();
     }
 
+    const auto hash = _collections.hash_function()(nss);
     stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
+    auto it = _collections.find(nss, hash);
     if (it != _collections.end()) {
         boost::optional<CollectionUUID> uuid = it->second->uuid();
         return it->second->isCommitted() ? uuid : boost::none;
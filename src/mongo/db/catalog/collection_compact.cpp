@@ -76,10 +76,11 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     Database* database = autoDb.getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
 
-    // The collection lock will be downgraded to an intent lock if the record store supports
-    // online compaction.
+    // The collection lock will be upgraded to an exclusive lock unless the record store supports
+    // online compaction. Starting with the intent lock means that online compaction never queues
+    // an exclusive lock request which would stall readers and writers of the collection.
     boost::optional<Lock::CollectionLock> collLk;
-    collLk.emplace(opCtx, collectionNss, MODE_X);
+    collLk.emplace(opCtx, collectionNss, MODE_IX);
 
     Collection* collection = getCollectionForCompact(opCtx, database, collectionNss);
     DisableDocumentValidation validationDisabler(opCtx);
@@ -93,10 +94,9 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
                       str::stream() << "cannot compact collection with record store: "
                                     << recordStore->name());
 
-    if (recordStore->supportsOnlineCompaction()) {
-        // Storage engines that allow online compaction should do so using an intent lock on the
-        // collection.
-        collLk.emplace(opCtx, collectionNss, MODE_IX);
+    if (!recordStore->supportsOnlineCompaction()) {
+        collLk.reset();
+        collLk.emplace(opCtx, collectionNss, MODE_X);
 
         // Ensure the collection was not dropped during the re-lock.
         collection = getCollectionForCompact(opCtx, database, collectionNss);
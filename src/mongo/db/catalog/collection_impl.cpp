@@ -33,13 +33,17 @@
 
 #include "mongo/db/catalog/collection_impl.h"
 
+#include <set>
+
 #include "mongo/base/counter.h"
 #include "mongo/base/init.h"
 #include "mongo/base/owned_pointer_map.h"
+#include "mongo/bson/mutable/damage_calculator.h"
 #include "mongo/bson/ordering.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/clustered_collection_util.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_catalog_impl.h"
@@ -50,6 +54,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/exec/oplog_tail_cache.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/keypattern.h"
@@ -61,11 +66,14 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/update/update_driver.h"
@@ -102,6 +110,14 @@ MONGO_FAIL_POINT_DEFINE(failAfterBulkLoadDocInsert);
 // will not (and cannot) be enforced but it will be persisted.
 MONGO_FAIL_POINT_DEFINE(allowSettingMalformedCollectionValidators);
 
+// Updates to documents of at most this size are written as a whole, without computing where they
+// changed, which matches the smallest record WiredTiger will modify in place.
+constexpr int kMinDocumentSizeForResizingDamages = 1024;
+
+// The most damages an update may pass to the record store, which matches the most modifications
+// WiredTiger will apply in place to a record.
+constexpr size_t kMaxResizingDamages = 16;
+
 /**
  * Checks the 'failCollectionInserts' fail point at the beginning of an insert operation to see if
  * the insert should fail. Returns Status::OK if The function should proceed with the insertion.
@@ -238,6 +254,14 @@ Status validatePreImageRecording(OperationContext* opCtx, const NamespaceString&
     return Status::OK();
 }
 
+// Source of collection write versions. Shared by all collections so that a version is never
+// reused, even by a new Collection instance for the same collection.
+AtomicWord<uint64_t> writeVersionCounter{0};
+
+uint64_t nextWriteVersion() {
+    return writeVersionCounter.addAndFetch(1);
+}
+
 }  // namespace
 
 CollectionImpl::CollectionImpl(OperationContext* opCtx,
@@ -255,7 +279,9 @@ CollectionImpl::CollectionImpl(OperationContext* opCtx,
       _indexCatalog(std::make_unique<IndexCatalogImpl>(this)),
       _cappedNotifier(_recordStore && _recordStore->isCapped()
                           ? std::make_shared<CappedInsertNotifier>()
-                          : nullptr) {
+                          : nullptr),
+      _writeVersion(nextWriteVersion()),
+      _appendVersion(nextWriteVersion()) {
     if (isCapped())
         _recordStore->setCappedCallback(this);
 }
@@ -301,6 +327,14 @@ void CollectionImpl::init(OperationContext* opCtx) {
         uassertStatusOK(validatePreImageRecording(opCtx, _ns));
         _recordPreImages = true;
     }
+    _appendOnly = collectionOptions.appendOnly;
+    if (collectionOptions.clustered) {
+        uassert(5160007,
+                str::stream() << "Collection " << _ns
+                              << " is clustered, which the storage engine does not support",
+                _recordStore->isClustered());
+        _clustered = true;
+    }
 
     // Store the result (OK / error) of parsing the validator, but do not enforce that the result is
     // OK. This is intentional, as users may have validators on disk which were considered well
@@ -340,6 +374,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (_clustered) {
+        // The record store itself is keyed by _id.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -466,6 +505,7 @@ Status CollectionImpl::insertDocumentsForOplog(OperationContext* opCtx,
     if (!status.isOK())
         return status;
 
+    bumpWriteVersionOnCommit(opCtx);
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
 
@@ -511,6 +551,7 @@ Status CollectionImpl::insertDocuments(OperationContext* opCtx,
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), begin, end, fromMigrate);
 
+    bumpWriteVersionForInsertsOnCommit(opCtx, begin, end);
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
 
@@ -551,31 +592,55 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
     return insertDocuments(opCtx, docs.begin(), docs.end(), opDebug, fromMigrate);
 }
 
-Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
-                                                   const BSONObj& doc,
-                                                   const OnRecordInsertedFn& onRecordInserted) {
-
-    auto status = checkFailCollectionInsertsFailPoint(_ns, doc);
-    if (!status.isOK()) {
-        return status;
+Status CollectionImpl::insertDocumentsForBulkLoader(OperationContext* opCtx,
+                                                    std::vector<BSONObj>::const_iterator begin,
+                                                    std::vector<BSONObj>::const_iterator end,
+                                                    const OnRecordInsertedFn& onRecordInserted) {
+    const size_t count = std::distance(begin, end);
+    if (count == 0) {
+        return Status::OK();
     }
 
-    status = checkValidation(opCtx, doc);
-    if (!status.isOK()) {
-        return status;
+    std::vector<Record> records;
+    records.reserve(count);
+    for (auto it = begin; it != end; ++it) {
+        auto status = checkFailCollectionInsertsFailPoint(_ns, *it);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        status = checkValidation(opCtx, *it);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        records.emplace_back(Record{RecordId(), RecordData(it->objdata(), it->objsize())});
     }
 
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
 
-    // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
-    // timestamp to use.
-    StatusWith<RecordId> loc =
-        _recordStore->insertRecord(opCtx, doc.objdata(), doc.objsize(), Timestamp());
+    if (_clustered) {
+        auto status = _setClusteredRecordIds(opCtx, &records);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
 
-    if (!loc.isOK())
-        return loc.getStatus();
+    // Using timestamp 0 for these inserts, which are non-oplog so we don't have an appropriate
+    // timestamp to use. Inserting the whole batch at once lets the record store reuse a single
+    // cursor and update its size statistics once for all of the documents.
+    std::vector<Timestamp> timestamps(count);
+    auto status = _recordStore->insertRecords(opCtx, &records, timestamps);
+    if (!status.isOK()) {
+        return status;
+    }
 
-    status = onRecordInserted(loc.getValue());
+    for (auto&& record : records) {
+        status = onRecordInserted(record.id);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
 
     if (MONGO_unlikely(failAfterBulkLoadDocInsert.shouldFail())) {
         LOGV2(20290,
@@ -585,23 +650,54 @@ Status CollectionImpl::insertDocumentForBulkLoader(OperationContext* opCtx,
         throw WriteConflictException();
     }
 
-    std::vector<InsertStatement> inserts;
-    OplogSlot slot;
-    // Fetch a new optime now, if necessary.
+    // Fetch new optimes now, if necessary.
+    std::vector<OplogSlot> slots(count);
     auto replCoord = repl::ReplicationCoordinator::get(opCtx);
     if (!replCoord->isOplogDisabledFor(opCtx, _ns)) {
-        // Populate 'slot' with a new optime.
-        slot = repl::getNextOpTime(opCtx);
+        slots = repl::getNextOpTimes(opCtx, count);
+    }
+
+    std::vector<InsertStatement> inserts;
+    inserts.reserve(count);
+    size_t i = 0;
+    for (auto it = begin; it != end; ++it) {
+        inserts.emplace_back(kUninitializedStmtId, *it, slots[i++]);
     }
-    inserts.emplace_back(kUninitializedStmtId, doc, slot);
 
     getGlobalServiceContext()->getOpObserver()->onInserts(
         opCtx, ns(), uuid(), inserts.begin(), inserts.end(), false);
 
+    bumpWriteVersionOnCommit(opCtx);
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp>) { notifyCappedWaitersIfNeeded(); });
 
-    return loc.getStatus();
+    return Status::OK();
+}
+
+Status CollectionImpl::_setClusteredRecordIds(OperationContext* opCtx,
+                                              std::vector<Record>* records) const {
+    std::set<RecordId> batchIds;
+    for (auto&& record : *records) {
+        BSONObj doc = record.data.toBson();
+        BSONElement id = doc["_id"];
+        auto recordId = clustered_util::recordIdForId(id);
+        if (!recordId) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Documents in clustered collection " << _ns
+                                  << " must have a positive integral _id, got: " << id};
+        }
+
+        // There is no _id index to enforce uniqueness, so check both the batch and the record
+        // store. A concurrent insert of the same _id write conflicts in the storage engine.
+        RecordData existing;
+        if (!batchIds.insert(*recordId).second ||
+            _recordStore->findRecord(opCtx, *recordId, &existing)) {
+            return buildDupKeyErrorStatus(
+                BSON("" << id), _ns, "_id_", BSON("_id" << 1), BSONObj());
+        }
+        record.id = *recordId;
+    }
+    return Status::OK();
 }
 
 Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
@@ -637,6 +733,13 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
         records.emplace_back(Record{RecordId(), RecordData(it->doc.objdata(), it->doc.objsize())});
         timestamps.emplace_back(it->oplogSlot.getTimestamp());
     }
+
+    if (_clustered) {
+        Status status = _setClusteredRecordIds(opCtx, &records);
+        if (!status.isOK())
+            return status;
+    }
+
     Status status = _recordStore->insertRecords(opCtx, &records, timestamps);
     if (!status.isOK())
         return status;
@@ -687,6 +790,7 @@ Status CollectionImpl::aboutToDeleteCapped(OperationContext* opCtx,
     BSONObj doc = data.releaseToBson();
     int64_t* const nullKeysDeleted = nullptr;
     _indexCatalog->unindexRecord(opCtx, doc, loc, false, nullKeysDeleted);
+    bumpWriteVersionOnCommit(opCtx);
 
     // We are not capturing and reporting to OpDebug the 'keysDeleted' by unindexRecord(). It is
     // questionable whether reporting will add diagnostic value to users and may instead be
@@ -704,6 +808,10 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
                                     bool fromMigrate,
                                     bool noWarn,
                                     Collection::StoreDeletedDoc storeDeletedDoc) {
+    uassert(5160003,
+            str::stream() << "cannot remove from an append-only collection: " << _ns,
+            !_appendOnly || fromMigrate || !opCtx->writesAreReplicated());
+
     if (isCapped()) {
         LOGV2(20291,
               "failing remove on a capped ns {ns}",
@@ -725,6 +833,7 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     int64_t keysDeleted;
     _indexCatalog->unindexRecord(opCtx, doc.value(), loc, noWarn, &keysDeleted);
     _recordStore->deleteRecord(opCtx, loc);
+    bumpWriteVersionOnCommit(opCtx);
 
     getGlobalServiceContext()->getOpObserver()->onDelete(
         opCtx, ns(), uuid(), stmtId, fromMigrate, deletedDoc);
@@ -744,6 +853,10 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                         bool indexesAffected,
                                         OpDebug* opDebug,
                                         CollectionUpdateArgs* args) {
+    uassert(5160002,
+            str::stream() << "cannot update a document in an append-only collection: " << _ns,
+            !_appendOnly || args->fromMigrate || !opCtx->writesAreReplicated());
+
     {
         auto status = checkValidation(opCtx, newDoc);
         if (!status.isOK()) {
@@ -799,8 +912,23 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
     }
     args->preImageRecordingEnabledForCollection = getRecordPreImages();
 
-    uassertStatusOK(
-        _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    // Work out where the document changed, so that a storage engine which can modify records in
+    // place doesn't need to search the old and new versions for the differences, or rewrite the
+    // whole record. This is not worth it unless the changes are a small part of the document.
+    boost::optional<mutablebson::ResizingDamageVector> damages;
+    if (_recordStore->updateWithDamagesSupported() &&
+        newDoc.objsize() > kMinDocumentSizeForResizingDamages) {
+        damages = mutablebson::computeResizingDamages(
+            oldDoc.value(), newDoc, kMaxResizingDamages, newDoc.objsize() / 10);
+    }
+    if (damages) {
+        uassertStatusOK(_recordStore->updateRecordWithDamages(
+            opCtx, oldLocation, newDoc.objdata(), newDoc.objsize(), *damages));
+    } else {
+        uassertStatusOK(
+            _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    }
+    bumpWriteVersionOnCommit(opCtx);
 
     if (indexesAffected) {
         int64_t keysInserted, keysDeleted;
@@ -840,6 +968,9 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
+    uassert(5160002,
+            str::stream() << "cannot update a document in an append-only collection: " << _ns,
+            !_appendOnly || args->fromMigrate || !opCtx->writesAreReplicated());
 
     // For in-place updates we need to grab an owned copy of the pre-image doc if pre-image
     // recording is enabled and we haven't already set the pre-image due to this update being
@@ -852,6 +983,7 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
         _recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
 
     if (newRecStatus.isOK()) {
+        bumpWriteVersionOnCommit(opCtx);
         args->updatedDoc = newRecStatus.getValue().toBson();
         args->preImageRecordingEnabledForCollection = getRecordPreImages();
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
@@ -876,6 +1008,21 @@ void CollectionImpl::setRecordPreImages(OperationContext* opCtx, bool val) {
     _recordPreImages = val;
 }
 
+void CollectionImpl::setAppendOnly(OperationContext* opCtx, bool val) {
+    DurableCatalog::get(opCtx)->setAppendOnly(opCtx, getCatalogId(), val);
+    _appendOnly = val;
+
+    // Inserts are not tracked while the collection is not append-only, so the newest inserted _id
+    // is unknown until it is established again.
+    stdx::lock_guard<Latch> lk(_newestInsertedIdMutex);
+    _newestInsertedId = BSONObj();
+}
+
+BSONObj CollectionImpl::getNewestInsertedId() const {
+    stdx::lock_guard<Latch> lk(_newestInsertedIdMutex);
+    return _newestInsertedId;
+}
+
 bool CollectionImpl::isCapped() const {
     return _cappedNotifier.get();
 }
@@ -886,7 +1033,11 @@ CappedCallback* CollectionImpl::getCappedCallback() {
 
 std::shared_ptr<CappedInsertNotifier> CollectionImpl::getCappedInsertNotifier() const {
     invariant(isCapped());
-    return _cappedNotifier;
+    // Take the reference before telling the record store, so that haveCappedWaiters() already
+    // counts this waiter when the record store checks it.
+    auto notifier = _cappedNotifier;
+    _recordStore->onCappedWaiterAdded();
+    return notifier;
 }
 
 uint64_t CollectionImpl::numRecords(OperationContext* opCtx) const {
@@ -976,6 +1127,10 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     auto status = _recordStore->truncate(opCtx);
     if (!status.isOK())
         return status;
+    if (_ns.isOplog()) {
+        OplogTailCache::get(opCtx).clear();
+    }
+    bumpWriteVersionOnCommit(opCtx);
 
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
@@ -993,6 +1148,76 @@ void CollectionImpl::cappedTruncateAfter(OperationContext* opCtx, RecordId end,
     invariant(_indexCatalog->numIndexesInProgress(opCtx) == 0);
 
     _recordStore->cappedTruncateAfter(opCtx, end, inclusive);
+    if (_ns.isOplog()) {
+        OplogTailCache::get(opCtx).clear();
+    }
+    bumpWriteVersionOnCommit(opCtx);
+}
+
+void CollectionImpl::bumpWriteVersionOnCommit(OperationContext* opCtx) {
+    // Readers compare versions to decide whether results they computed earlier are still current,
+    // so the version may only change once the write is visible to them.
+    auto bumpVersions = [this] {
+        _writeVersion.store(nextWriteVersion());
+        _appendVersion.store(nextWriteVersion());
+    };
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        bumpVersions();
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [bumpVersions](boost::optional<Timestamp>) { bumpVersions(); });
+}
+
+void CollectionImpl::bumpWriteVersionForInsertsOnCommit(
+    OperationContext* opCtx,
+    std::vector<InsertStatement>::const_iterator begin,
+    std::vector<InsertStatement>::const_iterator end) {
+    if (!_appendOnly) {
+        bumpWriteVersionOnCommit(opCtx);
+        return;
+    }
+
+    // The documents are not guaranteed to outlive the storage transaction, so keep owned copies of
+    // their _ids for the commit handler.
+    std::vector<BSONObj> ids;
+    ids.reserve(std::distance(begin, end));
+    for (auto it = begin; it != end; ++it) {
+        auto id = it->doc["_id"];
+        ids.push_back(id.eoo() ? BSONObj() : id.wrap(""));
+    }
+
+    auto bumpVersions = [this, ids = std::move(ids)] {
+        _writeVersion.store(nextWriteVersion());
+        if (!_advanceNewestInsertedId(ids)) {
+            _appendVersion.store(nextWriteVersion());
+        }
+    };
+    if (!opCtx->lockState()->inAWriteUnitOfWork()) {
+        bumpVersions();
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [bumpVersions](boost::optional<Timestamp>) { bumpVersions(); });
+}
+
+bool CollectionImpl::_advanceNewestInsertedId(const std::vector<BSONObj>& ids) {
+    stdx::lock_guard<Latch> lk(_newestInsertedIdMutex);
+
+    // Documents which were in the collection before the newest _id was established may follow any
+    // of the inserted ones, so the first insert after that can't be known to be in order.
+    bool inOrder = !_newestInsertedId.isEmpty();
+    for (auto&& id : ids) {
+        if (id.isEmpty()) {
+            inOrder = false;
+        } else if (_newestInsertedId.isEmpty() ||
+                   SimpleBSONObjComparator::kInstance.evaluate(id > _newestInsertedId)) {
+            _newestInsertedId = id;
+        } else {
+            inOrder = false;
+        }
+    }
+    return inOrder;
 }
 
 void CollectionImpl::setValidator(OperationContext* opCtx, Validator validator) {
@@ -1198,6 +1423,25 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> CollectionImpl::makePlanExe
     return InternalPlanner::collectionScan(opCtx, _ns.ns(), this, yieldPolicy, direction);
 }
 
+StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
+CollectionImpl::makeIndexedPlanExecutor(OperationContext* opCtx,
+                                        const BSONObj& filter,
+                                        const BSONObj& collation,
+                                        PlanYieldPolicy::YieldPolicy yieldPolicy) {
+    auto qr = std::make_unique<QueryRequest>(_ns);
+    qr->setFilter(filter);
+    qr->setCollation(collation);
+    auto statusWithCQ = CanonicalQuery::canonicalize(opCtx, std::move(qr));
+    if (!statusWithCQ.isOK()) {
+        return statusWithCQ.getStatus();
+    }
+    return getExecutor(opCtx,
+                       this,
+                       std::move(statusWithCQ.getValue()),
+                       yieldPolicy,
+                       QueryPlannerParams::NO_TABLE_SCAN);
+}
+
 void CollectionImpl::setNs(NamespaceString nss) {
     _ns = std::move(nss);
     _recordStore.get()->setNs(_ns);
@@ -33,6 +33,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 class IndexConsistency;
@@ -173,15 +174,16 @@ public:
                                    const std::vector<Timestamp>& timestamps) final;
 
     /**
-     * Inserts a document into the record store for a bulk loader that manages the index building
-     * outside this Collection. The bulk loader is notified with the RecordId of the document
-     * inserted into the RecordStore.
+     * Inserts the documents in [begin, end) into the record store, with a single batched write,
+     * for a bulk loader that manages the index building outside this Collection. The bulk loader
+     * is notified, in order, with the RecordId of each document inserted into the RecordStore.
      *
      * NOTE: It is up to caller to commit the indexes.
      */
-    Status insertDocumentForBulkLoader(OperationContext* opCtx,
-                                       const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) final;
+    Status insertDocumentsForBulkLoader(OperationContext* opCtx,
+                                        std::vector<BSONObj>::const_iterator begin,
+                                        std::vector<BSONObj>::const_iterator end,
+                                        const OnRecordInsertedFn& onRecordInserted) final;
 
     /**
      * Updates the document @ oldLocation with newDoc.
@@ -275,6 +277,15 @@ public:
     bool getRecordPreImages() const final;
     void setRecordPreImages(OperationContext* opCtx, bool val) final;
 
+    bool isAppendOnly() const final {
+        return _appendOnly;
+    }
+    void setAppendOnly(OperationContext* opCtx, bool val) final;
+
+    bool isClustered() const final {
+        return _clustered;
+    }
+
     bool isTemporary(OperationContext* opCtx) const final;
 
     //
@@ -333,6 +344,16 @@ public:
      */
     void setMinimumVisibleSnapshot(Timestamp newMinimumVisibleSnapshot) final;
 
+    uint64_t getWriteVersion() const final {
+        return _writeVersion.load();
+    }
+
+    uint64_t getAppendVersion() const final {
+        return _appendVersion.load();
+    }
+
+    BSONObj getNewestInsertedId() const final;
+
     bool haveCappedWaiters() final;
 
     /**
@@ -354,6 +375,12 @@ public:
         PlanYieldPolicy::YieldPolicy yieldPolicy,
         ScanDirection scanDirection) final;
 
+    StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> makeIndexedPlanExecutor(
+        OperationContext* opCtx,
+        const BSONObj& filter,
+        const BSONObj& collation,
+        PlanYieldPolicy::YieldPolicy yieldPolicy) final;
+
     void indexBuildSuccess(OperationContext* opCtx, IndexCatalogEntry* index) final;
 
     void establishOplogCollectionForLogging(OperationContext* opCtx) final;
@@ -366,6 +393,27 @@ private:
 
     Status aboutToDeleteCapped(OperationContext* opCtx, const RecordId& loc, RecordData data);
 
+    /**
+     * Advances the write version once the current storage transaction commits.
+     */
+    void bumpWriteVersionOnCommit(OperationContext* opCtx);
+
+    /**
+     * Advances the write version once the current storage transaction commits, and for an
+     * append-only collection advances the newest inserted _id past the _ids of the documents in
+     * [begin, end). The append version is advanced too unless they all follow the previous newest.
+     */
+    void bumpWriteVersionForInsertsOnCommit(OperationContext* opCtx,
+                                            std::vector<InsertStatement>::const_iterator begin,
+                                            std::vector<InsertStatement>::const_iterator end);
+
+    /**
+     * Advances '_newestInsertedId' past 'ids', each of which is an _id wrapped in an object or an
+     * empty object if the document had no _id. Returns true if every _id was greater than all of
+     * those before it and than a previously known newest _id.
+     */
+    bool _advanceNewestInsertedId(const std::vector<BSONObj>& ids);
+
     /**
      * same semantics as insertDocument, but doesn't do:
      *  - some user error checks
@@ -373,6 +421,12 @@ private:
      */
     Status _insertDocument(OperationContext* opCtx, const BSONObj& doc);
 
+    /**
+     * Assigns each record of a clustered collection the RecordId derived from its _id. Fails if an
+     * _id has no RecordId form or is already taken, either earlier in 'records' or on disk.
+     */
+    Status _setClusteredRecordIds(OperationContext* opCtx, std::vector<Record>* records) const;
+
     Status _insertDocuments(OperationContext* opCtx,
                             std::vector<InsertStatement>::const_iterator begin,
                             std::vector<InsertStatement>::const_iterator end,
@@ -408,6 +462,8 @@ private:
     ValidationLevel _validationLevel;
 
     bool _recordPreImages = false;
+    bool _appendOnly = false;
+    bool _clustered = false;
 
     // Notifier object for awaitData. Threads polling a capped collection for new data can wait
     // on this object until notified of the arrival of new data.
@@ -418,6 +474,17 @@ private:
     // The earliest snapshot that is allowed to use this collection.
     boost::optional<Timestamp> _minVisibleSnapshot;
 
+    // Changes after every committed write. See getWriteVersion().
+    AtomicWord<uint64_t> _writeVersion;
+
+    // Changes after every committed write other than an in-order insert. See getAppendVersion().
+    AtomicWord<uint64_t> _appendVersion;
+
+    // Protects '_newestInsertedId', which is only maintained while the collection is append-only.
+    mutable Mutex _newestInsertedIdMutex =
+        MONGO_MAKE_LATCH("CollectionImpl::_newestInsertedIdMutex");
+    BSONObj _newestInsertedId;
+
     bool _initialized = false;
 };
 }  // namespace mongo
@@ -137,9 +137,10 @@ public:
         std::abort();
     }
 
-    Status insertDocumentForBulkLoader(OperationContext* opCtx,
-                                       const BSONObj& doc,
-                                       const OnRecordInsertedFn& onRecordInserted) {
+    Status insertDocumentsForBulkLoader(OperationContext* opCtx,
+                                        std::vector<BSONObj>::const_iterator begin,
+                                        std::vector<BSONObj>::const_iterator end,
+                                        const OnRecordInsertedFn& onRecordInserted) {
         std::abort();
     }
 
@@ -219,6 +220,18 @@ public:
         std::abort();
     }
 
+    bool isAppendOnly() const {
+        std::abort();
+    }
+
+    void setAppendOnly(OperationContext* opCtx, bool val) {
+        std::abort();
+    }
+
+    bool isClustered() const {
+        std::abort();
+    }
+
     bool isCapped() const {
         std::abort();
     }
@@ -259,6 +272,18 @@ public:
         std::abort();
     }
 
+    uint64_t getWriteVersion() const {
+        std::abort();
+    }
+
+    uint64_t getAppendVersion() const {
+        std::abort();
+    }
+
+    BSONObj getNewestInsertedId() const {
+        std::abort();
+    }
+
     const CollatorInterface* getDefaultCollator() const {
         std::abort();
     }
@@ -275,6 +300,14 @@ public:
         std::abort();
     }
 
+    StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> makeIndexedPlanExecutor(
+        OperationContext* opCtx,
+        const BSONObj& filter,
+        const BSONObj& collation,
+        PlanYieldPolicy::YieldPolicy yieldPolicy) {
+        std::abort();
+    }
+
     void establishOplogCollectionForLogging(OperationContext* opCtx) {
         std::abort();
     }
@@ -170,6 +170,12 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             collectionOptions.temp = e.trueValue();
         } else if (fieldName == "recordPreImages") {
             collectionOptions.recordPreImages = e.trueValue();
+        } else if (fieldName == "appendOnly") {
+            collectionOptions.appendOnly = e.trueValue();
+        } else if (fieldName == "clustered") {
+            collectionOptions.clustered = e.trueValue();
+        } else if (fieldName == "coldStorage") {
+            collectionOptions.coldStorage = e.trueValue();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -260,6 +266,14 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (collectionOptions.clustered &&
+        (collectionOptions.capped || !collectionOptions.viewOn.empty() ||
+         collectionOptions.autoIndexId == YES || !collectionOptions.idIndex.isEmpty())) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "'clustered' cannot be combined with 'capped', 'viewOn', 'autoIndexId' or "
+                      "'idIndex'");
+    }
+
     return collectionOptions;
 }
 
@@ -292,6 +306,18 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendBool("recordPreImages", true);
     }
 
+    if (appendOnly) {
+        builder->appendBool("appendOnly", true);
+    }
+
+    if (clustered) {
+        builder->appendBool("clustered", true);
+    }
+
+    if (coldStorage) {
+        builder->appendBool("coldStorage", true);
+    }
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -351,6 +377,18 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (appendOnly != other.appendOnly) {
+        return false;
+    }
+
+    if (clustered != other.clustered) {
+        return false;
+    }
+
+    if (coldStorage != other.coldStorage) {
+        return false;
+    }
+
     if (temp != other.temp) {
         return false;
     }
@@ -121,6 +121,18 @@ struct CollectionOptions {
     bool temp = false;
     bool recordPreImages = false;
 
+    // Forbids updates and deletes of the documents in the collection, so that results computed over
+    // documents inserted before some point remain valid as later documents are appended.
+    bool appendOnly = false;
+
+    // Stores each document under the RecordId equal to its _id, which must be a positive integer,
+    // in place of a separate _id index. See clustered_util::recordIdForId().
+    bool clustered = false;
+
+    // Places the data files of the collection and its indexes under the cold storage directory of
+    // the dbpath, which may be mounted on cheaper, higher latency storage.
+    bool coldStorage = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
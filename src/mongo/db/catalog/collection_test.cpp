@@ -207,4 +207,91 @@ TEST_F(CollectionTest, AsynchronouslyNotifyCappedWaitersIfNeeded) {
     ASSERT_EQ(notifier->getVersion(), thisVersion);
 }
 
+TEST_F(CollectionTest, WriteVersionChangesOnlyWhenWriteCommits) {
+    NamespaceString nss("test.t");
+    auto opCtx = operationContext();
+    ASSERT_OK(storageInterface()->createCollection(opCtx, nss, CollectionOptions()));
+
+    AutoGetCollection autoColl(opCtx, nss, MODE_X);
+    Collection* coll = autoColl.getCollection();
+    const auto initialVersion = coll->getWriteVersion();
+
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocument(opCtx, InsertStatement(BSON("_id" << 0)), nullptr));
+        ASSERT_EQ(coll->getWriteVersion(), initialVersion);
+    }
+    ASSERT_EQ(coll->getWriteVersion(), initialVersion);
+
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocument(opCtx, InsertStatement(BSON("_id" << 1)), nullptr));
+        wuow.commit();
+    }
+    const auto versionAfterInsert = coll->getWriteVersion();
+    ASSERT_NE(versionAfterInsert, initialVersion);
+
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->truncate(opCtx));
+        wuow.commit();
+    }
+    ASSERT_NE(coll->getWriteVersion(), versionAfterInsert);
+}
+
+TEST_F(CollectionTest, AppendVersionChangesOnlyForOutOfOrderInserts) {
+    NamespaceString nss("test.t");
+    auto opCtx = operationContext();
+    ASSERT_OK(storageInterface()->createCollection(opCtx, nss, CollectionOptions()));
+
+    AutoGetCollection autoColl(opCtx, nss, MODE_X);
+    Collection* coll = autoColl.getCollection();
+    {
+        WriteUnitOfWork wuow(opCtx);
+        coll->setAppendOnly(opCtx, true);
+        wuow.commit();
+    }
+    ASSERT(coll->isAppendOnly());
+    ASSERT_BSONOBJ_EQ(coll->getNewestInsertedId(), BSONObj());
+
+    auto insert = [&](int id) {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocument(opCtx, InsertStatement(BSON("_id" << id)), nullptr));
+        wuow.commit();
+    };
+
+    // The first insert establishes the newest _id, but can't be known to follow the documents
+    // already in the collection.
+    auto appendVersion = coll->getAppendVersion();
+    insert(1);
+    ASSERT_NE(coll->getAppendVersion(), appendVersion);
+    ASSERT_BSONOBJ_EQ(coll->getNewestInsertedId(), BSON("" << 1));
+
+    appendVersion = coll->getAppendVersion();
+    const auto writeVersion = coll->getWriteVersion();
+    insert(2);
+    ASSERT_EQ(coll->getAppendVersion(), appendVersion);
+    ASSERT_NE(coll->getWriteVersion(), writeVersion);
+    ASSERT_BSONOBJ_EQ(coll->getNewestInsertedId(), BSON("" << 2));
+
+    insert(0);
+    ASSERT_NE(coll->getAppendVersion(), appendVersion);
+    ASSERT_BSONOBJ_EQ(coll->getNewestInsertedId(), BSON("" << 2));
+}
+
+TEST_F(CollectionTest, AppendOnlyCollectionRejectsDeletes) {
+    NamespaceString nss("test.t");
+    auto opCtx = operationContext();
+    ASSERT_OK(storageInterface()->createCollection(opCtx, nss, CollectionOptions()));
+
+    AutoGetCollection autoColl(opCtx, nss, MODE_X);
+    Collection* coll = autoColl.getCollection();
+    WriteUnitOfWork wuow(opCtx);
+    coll->setAppendOnly(opCtx, true);
+    ASSERT_OK(coll->insertDocument(opCtx, InsertStatement(BSON("_id" << 0)), nullptr));
+    ASSERT_THROWS_CODE(coll->deleteDocument(opCtx, kUninitializedStmtId, RecordId(1), nullptr),
+                       AssertionException,
+                       5160003);
+}
+
 }  // namespace
@@ -33,10 +33,12 @@
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/validate_gen.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -271,6 +273,31 @@ TEST_F(CollectionValidationTest, ValidateEnforceFastCountError) {
                        {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
 }
 
+// Verify that validating records on several threads finds the same records and invalid documents.
+TEST_F(CollectionValidationTest, ValidateWithSeveralThreads) {
+    gMaxValidateThreads.store(4);
+    ON_BLOCK_EXIT([] { gMaxValidateThreads.store(1); });
+    auto opCtx = operationContext();
+    foregroundValidate(opCtx,
+                       /*valid*/ true,
+                       /*numRecords*/ insertDataRange(opCtx, 0, 3000),
+                       /*numInvalidDocuments*/ 0,
+                       /*numErrors*/ 0);
+}
+TEST_F(CollectionValidationTest, ValidateErrorWithSeveralThreads) {
+    gMaxValidateThreads.store(4);
+    ON_BLOCK_EXIT([] { gMaxValidateThreads.store(1); });
+    auto opCtx = operationContext();
+    int numRecords = insertDataRange(opCtx, 0, 1500);
+    numRecords += setUpInvalidData(opCtx);
+    numRecords += insertDataRange(opCtx, 1500, 3000);
+    foregroundValidate(opCtx,
+                       /*valid*/ false,
+                       numRecords,
+                       /*numInvalidDocuments*/ 1,
+                       /*numErrors*/ 1);
+}
+
 /**
  * Waits for a parallel running collection validation operation to start and then hang at a
  * failpoint.
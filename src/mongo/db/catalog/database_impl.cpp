@@ -786,7 +786,7 @@ void DatabaseImpl::checkForIdIndexesAndDropPendingCollections(OperationContext*
         if (!coll)
             continue;
 
-        if (coll->getIndexCatalog()->findIdIndex(opCtx))
+        if (coll->isClustered() || coll->getIndexCatalog()->findIdIndex(opCtx))
             continue;
 
         LOGV2_OPTIONS(
@@ -1381,13 +1381,16 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
+    // Only timestamp the transaction when the timestamp changes between consecutive records.
+    Timestamp lastTs;
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
-        if (!bsonRecord.ts.isNull()) {
+        if (!bsonRecord.ts.isNull() && bsonRecord.ts != lastTs) {
             Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecord.ts);
             if (!status.isOK())
                 return status;
+            lastTs = bsonRecord.ts;
         }
 
         auto keys = executionCtx.keys();
@@ -48,6 +48,7 @@
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -55,7 +56,9 @@
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/scopeguard.h"
@@ -103,6 +106,7 @@ void MultiIndexBlock::abortIndexBuild(OperationContext* opCtx,
                 _indexes[i].block->finalizeTemporaryTables(
                     opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
             }
+            _finalizeStateTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
 
             // Nodes building an index on behalf of a user (e.g: `createIndexes`, `applyOps`) may
             // fail, removing the existence of the index from the catalog. This update must be
@@ -213,12 +217,13 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(OperationContext* opCtx,
 
         std::vector<BSONObj> indexInfoObjs;
         indexInfoObjs.reserve(indexSpecs.size());
-        std::size_t eachIndexBuildMaxMemoryUsageBytes = 0;
-        if (!indexSpecs.empty()) {
-            eachIndexBuildMaxMemoryUsageBytes =
-                static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
-                indexSpecs.size();
-        }
+        // The sorters of all of the indexes share the memory limit, so that an index only has to
+        // spill while the others leave it no memory, rather than whenever it outgrows an equal
+        // split of the limit.
+        const auto maxMemoryUsageBytes =
+            static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024;
+        auto sharedMemoryBudget =
+            std::make_shared<SorterMemoryBudget>(maxMemoryUsageBytes, indexSpecs.size());
 
         for (size_t i = 0; i < indexSpecs.size(); i++) {
             BSONObj info = indexSpecs[i];
@@ -258,7 +263,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(OperationContext* opCtx,
             if (!status.isOK())
                 return status;
 
-            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+            index.bulk = index.real->initiateBulk(maxMemoryUsageBytes, sharedMemoryBudget);
 
             const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
 
@@ -278,8 +283,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(OperationContext* opCtx,
                   "buildUUID"_attr = _buildUUID,
                   "properties"_attr = *descriptor,
                   "method"_attr = _method,
-                  "maxTemporaryMemoryUsageMB"_attr =
-                      eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024);
+                  "maxTemporaryMemoryUsageMB"_attr = maxMemoryUsageBytes / 1024 / 1024);
 
             index.filterExpression = index.block->getEntry()->getFilterExpression();
 
@@ -322,6 +326,15 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(OperationContext* opCtx,
     }
 }
 
+namespace {
+
+// Bounds on the documents buffered by the collection scan while their keys are being generated in
+// parallel.
+const size_t kKeyGenerationBatchDocuments = 1024;
+const size_t kKeyGenerationBatchBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
 void failPointHangDuringBuild(FailPoint* fp, StringData where, const BSONObj& doc) {
     fp->executeIf(
         [&](const BSONObj& data) {
@@ -387,6 +400,7 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
     }
 
     Timer t;
+    _lastCheckpoint = opCtx->getServiceContext()->getFastClockSource()->now();
 
     unsigned long long n = 0;
 
@@ -396,13 +410,63 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
     } else {
         yieldPolicy = PlanYieldPolicy::YieldPolicy::WRITE_CONFLICT_RETRY_ONLY;
     }
-    auto exec =
-        collection->makePlanExecutor(opCtx, yieldPolicy, Collection::ScanDirection::kForward);
+    // Partial indexes often only need a small part of the collection, which an existing index on
+    // the fields of their filters can find without reading the rest. If the filters turn out to
+    // match too many documents for that to pay off, the build scans the collection after all.
+    auto exec = _makeIndexScanPlanExecutor(opCtx, collection, yieldPolicy);
+    bool scanningIndex = exec != nullptr;
+    const auto maxDocsFromIndexScan =
+        static_cast<long long>(maxIndexBuildIndexScanFraction.load() * numRecords);
+    long long numDocsFromIndexScan = 0;
+    if (!scanningIndex) {
+        exec =
+            collection->makePlanExecutor(opCtx, yieldPolicy, Collection::ScanDirection::kForward);
+    }
 
     // Hint to the storage engine that this collection scan should not keep data in the cache.
     bool readOnce = useReadOnceCursorsForIndexBuilds.load();
     opCtx->recoveryUnit()->setReadOnce(readOnce);
 
+    // Key generation is CPU-bound, so when configured, the documents read by the scan are buffered
+    // and their keys generated by several threads. The keys are still added to the BulkBuilders,
+    // whose sorters are not thread-safe, in scan order on this thread.
+    const size_t keyGenerationThreads = maxIndexBuildKeyGenerationThreads.load();
+    std::unique_ptr<ThreadPool> keyGenerationPool;
+    if (keyGenerationThreads > 1) {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGeneration";
+        options.minThreads = 0;
+        options.maxThreads = keyGenerationThreads - 1;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+        };
+        keyGenerationPool = std::make_unique<ThreadPool>(options);
+        keyGenerationPool->startup();
+    }
+    ON_BLOCK_EXIT([&] {
+        if (keyGenerationPool) {
+            keyGenerationPool->shutdown();
+            keyGenerationPool->join();
+        }
+    });
+
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+    auto insertBatch = [&] {
+        Status ret = _insertBatch(opCtx, keyGenerationPool.get(), keyGenerationThreads, batch);
+        if (!ret.isOK()) {
+            return ret;
+        }
+        for (const auto& [doc, docLoc] : batch) {
+            failPointHangDuringBuild(&hangAfterIndexBuildOf, "after", doc);
+            progress->hit();
+            n++;
+        }
+        batch.clear();
+        batchBytes = 0;
+        return Status::OK();
+    };
+
     try {
         BSONObj objToIndex;
         RecordId loc;
@@ -417,10 +481,39 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
                 continue;
             }
 
+            if (scanningIndex && ++numDocsFromIndexScan > maxDocsFromIndexScan) {
+                // The documents already inserted are read again. Their keys come out of the
+                // sorters twice, and the second copy is dropped when the keys are committed.
+                LOGV2(5155009,
+                      "Index build: partial filters match too many documents for an index scan, "
+                      "scanning the collection instead",
+                      "buildUUID"_attr = _buildUUID,
+                      "documentsFromIndexScan"_attr = numDocsFromIndexScan);
+                scanningIndex = false;
+                exec = collection->makePlanExecutor(
+                    opCtx, yieldPolicy, Collection::ScanDirection::kForward);
+                continue;
+            }
+
             progress->setTotalWhileRunning(collection->numRecords(opCtx));
 
             failPointHangDuringBuild(&hangBeforeIndexBuildOf, "before", objToIndex);
 
+            if (keyGenerationPool) {
+                // The document is only valid until the executor advances, so the batch owns a copy.
+                batchBytes += objToIndex.objsize();
+                batch.emplace_back(objToIndex.getOwned(), loc);
+                if (batch.size() >= kKeyGenerationBatchDocuments ||
+                    batchBytes >= kKeyGenerationBatchBytes) {
+                    Status ret = insertBatch();
+                    if (!ret.isOK()) {
+                        return ret;
+                    }
+                    _checkpointIfDue(opCtx, exec.get());
+                }
+                continue;
+            }
+
             // The external sorter is not part of the storage engine and therefore does not need a
             // WriteUnitOfWork to write keys.
             Status ret = insert(opCtx, objToIndex, loc);
@@ -433,6 +526,15 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
             // Go to the next document.
             progress->hit();
             n++;
+
+            _checkpointIfDue(opCtx, exec.get());
+        }
+
+        if (!batch.empty()) {
+            Status ret = insertBatch();
+            if (!ret.isOK()) {
+                return ret;
+            }
         }
     } catch (...) {
         return exceptionToStatus();
@@ -481,6 +583,54 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(OperationContext* opCtx,
     return Status::OK();
 }
 
+std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> MultiIndexBlock::_makeIndexScanPlanExecutor(
+    OperationContext* opCtx, Collection* collection, PlanYieldPolicy::YieldPolicy yieldPolicy) {
+    if (maxIndexBuildIndexScanFraction.load() <= 0 || _indexes.empty()) {
+        return nullptr;
+    }
+
+    // The filters were parsed with the collation of their index, so a query for all of them needs
+    // the indexes to share one.
+    BSONArrayBuilder filters;
+    boost::optional<BSONObj> collation;
+    for (const auto& index : _indexes) {
+        const IndexDescriptor* desc = index.block->getEntry()->descriptor();
+        if (!desc->isPartial()) {
+            return nullptr;
+        }
+        const BSONObj& indexCollation =
+            desc->collation().isEmpty() ? CollationSpec::kSimpleSpec : desc->collation();
+        if (collation && indexCollation.woCompare(*collation) != 0) {
+            return nullptr;
+        }
+        collation = indexCollation;
+        filters.append(desc->partialFilterExpression());
+    }
+
+    const BSONObj filter = _indexes.size() == 1 ? _indexes.front()
+                                                      .block->getEntry()
+                                                      ->descriptor()
+                                                      ->partialFilterExpression()
+                                                : BSON("$or" << filters.arr());
+    auto statusWithExec =
+        collection->makeIndexedPlanExecutor(opCtx, filter, *collation, yieldPolicy);
+    if (!statusWithExec.isOK()) {
+        LOGV2_DEBUG(5155010,
+                    1,
+                    "Index build: no index can be used to find the documents to index",
+                    "buildUUID"_attr = _buildUUID,
+                    "reason"_attr = statusWithExec.getStatus());
+        return nullptr;
+    }
+
+    LOGV2(5155011,
+          "Index build: reading the documents to index through an index scan",
+          "buildUUID"_attr = _buildUUID,
+          "filter"_attr = redact(filter));
+    _scannedIndex = true;
+    return std::move(statusWithExec.getValue());
+}
+
 Status MultiIndexBlock::insert(OperationContext* opCtx, const BSONObj& doc, const RecordId& loc) {
     invariant(!_buildIsCleanedUp);
     for (size_t i = 0; i < _indexes.size(); i++) {
@@ -508,6 +658,105 @@ Status MultiIndexBlock::insert(OperationContext* opCtx, const BSONObj& doc, cons
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     ThreadPool* keyGenerationPool,
+                                     size_t numThreads,
+                                     const std::vector<std::pair<BSONObj, RecordId>>& batch) {
+    invariant(!_buildIsCleanedUp);
+
+    struct DocumentKeys {
+        bool matchesFilter = false;
+        Status status = Status::OK();
+        IndexAccessMethod::BulkBuilder::GeneratedKeys keys;
+    };
+
+    // The keys of document 'd' for index 'i' are at d * _indexes.size() + i. Each thread only
+    // writes the entries of its own slice of documents.
+    const size_t numIndexes = _indexes.size();
+    std::vector<DocumentKeys> generated(batch.size() * numIndexes);
+    auto generateSlice = [&](size_t begin, size_t end) {
+        SharedBufferFragmentBuilder pooledBufferBuilder(BufBuilder::kDefaultInitSizeBytes);
+        for (size_t d = begin; d < end; ++d) {
+            const auto& [doc, loc] = batch[d];
+            for (size_t i = 0; i < numIndexes; ++i) {
+                auto& out = generated[d * numIndexes + i];
+                const auto& index = _indexes[i];
+                try {
+                    out.matchesFilter =
+                        !index.filterExpression || index.filterExpression->matchesBSON(doc);
+                    if (out.matchesFilter) {
+                        out.status = index.bulk->generateKeys(
+                            pooledBufferBuilder, doc, loc, index.options, &out.keys);
+                    }
+                } catch (...) {
+                    out.matchesFilter = true;
+                    out.status = exceptionToStatus();
+                }
+            }
+        }
+    };
+
+    // This thread generates the first slice while the pool generates the others. All of them must
+    // be finished before 'generated' goes out of scope.
+    const size_t sliceSize = (batch.size() + numThreads - 1) / numThreads;
+    std::vector<Future<void>> slices;
+    ON_BLOCK_EXIT([&] {
+        for (auto& slice : slices) {
+            slice.wait();
+        }
+    });
+    for (size_t begin = sliceSize; begin < batch.size(); begin += sliceSize) {
+        const size_t end = std::min(begin + sliceSize, batch.size());
+        auto pf = makePromiseFuture<void>();
+        keyGenerationPool->schedule(
+            [&generateSlice, begin, end, promise = std::move(pf.promise)](Status status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(status);
+                    return;
+                }
+                generateSlice(begin, end);
+                promise.emplaceValue();
+            });
+        slices.push_back(std::move(pf.future));
+    }
+    generateSlice(0, std::min(sliceSize, batch.size()));
+
+    for (auto& slice : slices) {
+        Status status = slice.getNoThrow();
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    for (size_t d = 0; d < batch.size(); ++d) {
+        const auto& [doc, loc] = batch[d];
+        for (size_t i = 0; i < numIndexes; ++i) {
+            const auto& out = generated[d * numIndexes + i];
+            if (!out.matchesFilter) {
+                continue;
+            }
+            if (!out.status.isOK()) {
+                return out.status;
+            }
+
+            // When calling addKeys, BulkBuilderImpl's Sorter performs file I/O that may result in
+            // an exception.
+            Status idxStatus = Status::OK();
+            try {
+                idxStatus = _indexes[i].bulk->addKeys(opCtx, doc, loc, out.keys);
+            } catch (...) {
+                return exceptionToStatus();
+            }
+            if (!idxStatus.isOK()) {
+                return idxStatus;
+            }
+        }
+        _lastRecordIdInserted = loc;
+    }
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx) {
     return dumpInsertsFromBulk(opCtx, nullptr);
 }
@@ -707,6 +956,9 @@ Status MultiIndexBlock::commit(OperationContext* opCtx,
                 opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
         });
     }
+    opCtx->recoveryUnit()->onCommit([opCtx, this](auto commitTs) {
+        _finalizeStateTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
+    });
 
     onCommit();
 
@@ -739,29 +991,48 @@ void MultiIndexBlock::_abortWithoutCleanup(OperationContext* opCtx, bool shutdow
     auto action = TemporaryRecordStore::FinalizationAction::kDelete;
 
     if (_shouldWriteStateToDisk(opCtx, shutdown)) {
-        _writeStateToDisk(opCtx);
+        _writeStateToDisk(opCtx, shutdown);
         action = TemporaryRecordStore::FinalizationAction::kKeep;
     }
 
     for (auto& index : _indexes) {
         index.block->finalizeTemporaryTables(opCtx, action);
     }
+    _finalizeStateTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
 
     _buildIsCleanedUp = true;
 }
 
-bool MultiIndexBlock::_shouldWriteStateToDisk(OperationContext* opCtx, bool shutdown) const {
-    return shutdown && _buildUUID && !_buildIsCleanedUp && _method == IndexBuildMethod::kHybrid &&
+bool MultiIndexBlock::_isResumable(OperationContext* opCtx) const {
+    return _buildUUID && !_buildIsCleanedUp && _method == IndexBuildMethod::kHybrid &&
+        !_scannedIndex &&
         opCtx->getServiceContext()->getStorageEngine()->supportsResumableIndexBuilds();
 }
 
-void MultiIndexBlock::_writeStateToDisk(OperationContext* opCtx) const {
-    auto obj = _constructStateObject();
-    auto rs = opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(opCtx);
+bool MultiIndexBlock::_shouldWriteStateToDisk(OperationContext* opCtx, bool shutdown) const {
+    return shutdown && _isResumable(opCtx);
+}
+
+void MultiIndexBlock::_writeStateToDisk(OperationContext* opCtx, bool shutdown) {
+    auto obj = _constructStateObject(shutdown);
+    if (!_stateTable) {
+        _stateTable =
+            opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(opCtx);
+    }
 
     WriteUnitOfWork wuow(opCtx);
 
-    auto status = rs->rs()->insertRecord(opCtx, obj.objdata(), obj.objsize(), Timestamp());
+    // A checkpoint overwrites the state of the previous one, so that the table only ever holds
+    // the state of a single point of the build.
+    StatusWith<RecordId> status = _stateRecordId;
+    if (_stateRecordId.isNull()) {
+        status = _stateTable->rs()->insertRecord(opCtx, obj.objdata(), obj.objsize(), Timestamp());
+    } else {
+        auto updateStatus = _stateTable->rs()->updateRecord(
+            opCtx, _stateRecordId, obj.objdata(), obj.objsize());
+        if (!updateStatus.isOK())
+            status = updateStatus;
+    }
     if (!status.isOK()) {
         LOGV2_ERROR(4841501,
                     "Failed to write resumable index build state to disk",
@@ -771,18 +1042,55 @@ void MultiIndexBlock::_writeStateToDisk(OperationContext* opCtx) const {
                 str::stream() << "Failed to write resumable index build state to disk. UUID: "
                               << *_buildUUID);
 
-        rs->finalizeTemporaryTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
+        _finalizeStateTable(opCtx, TemporaryRecordStore::FinalizationAction::kDelete);
         return;
     }
 
     wuow.commit();
+    _stateRecordId = status.getValue();
+
+    if (!shutdown) {
+        LOGV2_DEBUG(5155014,
+                    1,
+                    "Checkpointed resumable index build state to disk",
+                    logAttrs(*_buildUUID),
+                    "collectionScanPosition"_attr = _lastRecordIdInserted);
+        return;
+    }
 
     LOGV2(4841502, "Wrote resumable index build state to disk", logAttrs(*_buildUUID));
 
-    rs->finalizeTemporaryTable(opCtx, TemporaryRecordStore::FinalizationAction::kKeep);
+    _finalizeStateTable(opCtx, TemporaryRecordStore::FinalizationAction::kKeep);
 }
 
-BSONObj MultiIndexBlock::_constructStateObject() const {
+void MultiIndexBlock::_checkpointIfDue(OperationContext* opCtx, PlanExecutor* exec) {
+    auto interval = resumableIndexBuildCheckpointIntervalSecs.load();
+    if (interval == 0 || _phase != Phase::kCollectionScan || !_isResumable(opCtx))
+        return;
+
+    auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    if (now < _lastCheckpoint + Seconds(interval))
+        return;
+    _lastCheckpoint = now;
+
+    // The state is written outside of the snapshot the collection scan reads from.
+    exec->saveState();
+    opCtx->recoveryUnit()->abandonSnapshot();
+    _writeStateToDisk(opCtx, false /* shutdown */);
+    exec->restoreState();
+}
+
+void MultiIndexBlock::_finalizeStateTable(OperationContext* opCtx,
+                                          TemporaryRecordStore::FinalizationAction action) {
+    if (!_stateTable)
+        return;
+
+    _stateTable->finalizeTemporaryTable(opCtx, action);
+    _stateTable.reset();
+    _stateRecordId = RecordId();
+}
+
+BSONObj MultiIndexBlock::_constructStateObject(bool shutdown) {
     BSONObjBuilder builder;
     _buildUUID->appendToBuilder(&builder, "_id");
     builder.append("phase", _phaseToString(_phase));
@@ -796,6 +1104,14 @@ BSONObj MultiIndexBlock::_constructStateObject() const {
     for (const auto& index : _indexes) {
         BSONObjBuilder indexInfo(indexesArray.subobjStart());
 
+        // Ensure the data we are referencing has been persisted to disk. This spills the keys held
+        // in memory, so it must come before the ranges of the sorter are recorded.
+        if (shutdown) {
+            index.bulk->persistDataForShutdown();
+        } else {
+            index.bulk->persistDataForCheckpoint();
+        }
+
         if (_phase == Phase::kCollectionScan || _phase == Phase::kBulkLoad) {
             auto state = index.bulk->getSorterState();
 
@@ -827,9 +1143,6 @@ BSONObj MultiIndexBlock::_constructStateObject() const {
             indexInfo.append("skippedRecordTrackerTable", *skippedRecordTrackerTableIdent);
 
         indexInfo.done();
-
-        // Ensure the data we are referencing has been persisted to disk.
-        index.bulk->persistDataForShutdown();
     }
     indexesArray.done();
 
@@ -45,7 +45,9 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_build_interceptor.h"
+#include "mongo/db/query/plan_executor.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
@@ -57,6 +59,7 @@ class Collection;
 class MatchExpression;
 class NamespaceString;
 class OperationContext;
+class ThreadPool;
 
 /**
  * Builds one or more indexes.
@@ -299,11 +302,47 @@ private:
 
     void _abortWithoutCleanup(OperationContext* opCtx, bool shutdown);
 
+    /**
+     * Generates the keys of 'batch' for every index, spreading the documents over this thread and
+     * the threads of 'keyGenerationPool' in 'numThreads' contiguous slices, then adds them to the
+     * BulkBuilders in document order on this thread.
+     */
+    Status _insertBatch(OperationContext* opCtx,
+                        ThreadPool* keyGenerationPool,
+                        size_t numThreads,
+                        const std::vector<std::pair<BSONObj, RecordId>>& batch);
+
+    /**
+     * When every index being built is partial, returns an executor that finds the documents
+     * matching any of their filters through existing indexes, or nullptr if the planner cannot.
+     */
+    std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _makeIndexScanPlanExecutor(
+        OperationContext* opCtx, Collection* collection, PlanYieldPolicy::YieldPolicy yieldPolicy);
+
+    /**
+     * Whether the state of this build can be written to disk for it to be resumed later.
+     */
+    bool _isResumable(OperationContext* opCtx) const;
+
     bool _shouldWriteStateToDisk(OperationContext* opCtx, bool shutdown) const;
 
-    void _writeStateToDisk(OperationContext* opCtx) const;
+    /**
+     * Writes the state of this build to '_stateTable', replacing any state an earlier checkpoint
+     * wrote. At shutdown, the table is kept for the build to be resumed from it.
+     */
+    void _writeStateToDisk(OperationContext* opCtx, bool shutdown);
+
+    BSONObj _constructStateObject(bool shutdown);
 
-    BSONObj _constructStateObject() const;
+    /**
+     * Writes the state of this build to disk if it is resumable and the collection scan has run
+     * for resumableIndexBuildCheckpointIntervalSecs since the last time it did. 'exec' is saved
+     * and restored around the write.
+     */
+    void _checkpointIfDue(OperationContext* opCtx, PlanExecutor* exec);
+
+    void _finalizeStateTable(OperationContext* opCtx,
+                             TemporaryRecordStore::FinalizationAction action);
 
     std::string _phaseToString(Phase phase) const;
 
@@ -330,5 +369,17 @@ private:
 
     // The current phase of the index build.
     Phase _phase = Phase::kCollectionScan;
+
+    // Whether the documents to index were read, at least in part, through an index scan. The
+    // order of such a scan does not let the build resume from the last RecordId it inserted.
+    bool _scannedIndex = false;
+
+    // The table holding the state written by the last checkpoint of this build, and the record
+    // within it, or nullptr if no checkpoint was written.
+    std::unique_ptr<TemporaryRecordStore> _stateTable;
+    RecordId _stateRecordId;
+
+    // When the state of this build was last written to disk, or the collection scan started.
+    Date_t _lastCheckpoint;
 };
 }  // namespace mongo
@@ -38,6 +38,8 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/throttle_cursor.h"
+#include "mongo/db/catalog/validate_gen.h"
+#include "mongo/db/client.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -50,7 +52,10 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/object_check.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -61,6 +66,10 @@ MONGO_FAIL_POINT_DEFINE(crashOnMultikeyValidateFailure);
 const long long kInterruptIntervalNumRecords = 4096;
 const long long kInterruptIntervalNumBytes = 50 * 1024 * 1024;  // 50MB.
 
+// The records buffered for validation by several threads, see traverseRecordStore().
+const size_t kValidateBatchRecords = 1024;
+const size_t kValidateBatchBytes = 16 * 1024 * 1024;
+
 }  // namespace
 
 Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
@@ -68,21 +77,8 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
                                        const RecordData& record,
                                        size_t* dataSize) {
     BSONObj recordBson;
-    try {
-        recordBson = record.toBson();
-    } catch (...) {
-        return exceptionToStatus();
-    }
-
-    if (MONGO_unlikely(_validateState->extraLoggingForTest())) {
-        LOGV2(46666001, "[validate]", "recordId"_attr = recordId, "recordData"_attr = recordBson);
-    }
-
-    const Status status = validateBSON(
-        recordBson.objdata(), recordBson.objsize(), Validator<BSONObj>::enabledBSONVersion());
-    if (status.isOK()) {
-        *dataSize = recordBson.objsize();
-    } else {
+    Status status = _validateRecordBson(recordId, record, &recordBson, dataSize);
+    if (!status.isOK()) {
         return status;
     }
 
@@ -95,7 +91,6 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
 
     for (const auto& index : _validateState->getIndexes()) {
         const IndexDescriptor* descriptor = index->descriptor();
-        const IndexAccessMethod* iam = index->accessMethod();
 
         if (descriptor->isPartial() && !index->getFilterExpression()->matchesBSON(recordBson))
             continue;
@@ -104,63 +99,218 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
         auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
         auto documentMultikeyPaths = executionCtx.multikeyPaths();
 
-        iam->getKeys(executionCtx.pooledBufferBuilder(),
-                     recordBson,
-                     IndexAccessMethod::GetKeysMode::kEnforceConstraints,
-                     IndexAccessMethod::GetKeysContext::kAddingKeys,
-                     documentKeySet.get(),
-                     multikeyMetadataKeys.get(),
-                     documentMultikeyPaths.get(),
-                     recordId,
-                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
-
-        if (!index->isMultikey() &&
-            iam->shouldMarkIndexAsMultikey(
-                documentKeySet->size(),
-                {multikeyMetadataKeys->begin(), multikeyMetadataKeys->end()},
-                *documentMultikeyPaths)) {
+        index->accessMethod()->getKeys(executionCtx.pooledBufferBuilder(),
+                                       recordBson,
+                                       IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                                       IndexAccessMethod::GetKeysContext::kAddingKeys,
+                                       documentKeySet.get(),
+                                       multikeyMetadataKeys.get(),
+                                       documentMultikeyPaths.get(),
+                                       recordId,
+                                       IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        status = _addDocKeys(opCtx,
+                             index.get(),
+                             recordId,
+                             *documentKeySet,
+                             *multikeyMetadataKeys,
+                             *documentMultikeyPaths);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return status;
+}
+
+Status ValidateAdaptor::_validateRecordBson(const RecordId& recordId,
+                                            const RecordData& record,
+                                            BSONObj* recordBson,
+                                            size_t* dataSize) const {
+    try {
+        *recordBson = record.toBson();
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    if (MONGO_unlikely(_validateState->extraLoggingForTest())) {
+        LOGV2(46666001, "[validate]", "recordId"_attr = recordId, "recordData"_attr = *recordBson);
+    }
+
+    const Status status = validateBSON(
+        recordBson->objdata(), recordBson->objsize(), Validator<BSONObj>::enabledBSONVersion());
+    if (status.isOK()) {
+        *dataSize = recordBson->objsize();
+    }
+    return status;
+}
+
+Status ValidateAdaptor::_addDocKeys(OperationContext* opCtx,
+                                    const IndexCatalogEntry* index,
+                                    const RecordId& recordId,
+                                    const KeyStringSet& documentKeySet,
+                                    const KeyStringSet& multikeyMetadataKeys,
+                                    const MultikeyPaths& documentMultikeyPaths) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    const IndexAccessMethod* iam = index->accessMethod();
+
+    if (!index->isMultikey() &&
+        iam->shouldMarkIndexAsMultikey(
+            documentKeySet.size(),
+            {multikeyMetadataKeys.begin(), multikeyMetadataKeys.end()},
+            documentMultikeyPaths)) {
+        std::string msg = str::stream()
+            << "Index " << descriptor->indexName() << " is not multi-key but has more than one"
+            << " key in document " << recordId;
+        ValidateResults& curRecordResults = (*_indexNsResultsMap)[descriptor->indexName()];
+        curRecordResults.errors.push_back(msg);
+        curRecordResults.valid = false;
+        if (crashOnMultikeyValidateFailure.shouldFail()) {
+            invariant(false, msg);
+        }
+    }
+
+    if (index->isMultikey()) {
+        const MultikeyPaths& indexPaths = index->getMultikeyPaths(opCtx);
+        if (!MultikeyPathTracker::covers(indexPaths, documentMultikeyPaths)) {
             std::string msg = str::stream()
-                << "Index " << descriptor->indexName() << " is not multi-key but has more than one"
-                << " key in document " << recordId;
+                << "Index " << descriptor->indexName()
+                << " multi-key paths do not cover a document. RecordId: " << recordId;
             ValidateResults& curRecordResults = (*_indexNsResultsMap)[descriptor->indexName()];
             curRecordResults.errors.push_back(msg);
             curRecordResults.valid = false;
-            if (crashOnMultikeyValidateFailure.shouldFail()) {
-                invariant(false, msg);
-            }
         }
+    }
 
-        if (index->isMultikey()) {
-            const MultikeyPaths& indexPaths = index->getMultikeyPaths(opCtx);
-            if (!MultikeyPathTracker::covers(indexPaths, *documentMultikeyPaths.get())) {
-                std::string msg = str::stream()
-                    << "Index " << descriptor->indexName()
-                    << " multi-key paths do not cover a document. RecordId: " << recordId;
-                ValidateResults& curRecordResults = (*_indexNsResultsMap)[descriptor->indexName()];
-                curRecordResults.errors.push_back(msg);
-                curRecordResults.valid = false;
-            }
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
+    for (const auto& keyString : multikeyMetadataKeys) {
+        try {
+            _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
+        } catch (...) {
+            return exceptionToStatus();
+        }
+    }
+
+    for (const auto& keyString : documentKeySet) {
+        try {
+            _totalIndexKeys++;
+            _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
+        } catch (...) {
+            return exceptionToStatus();
         }
+    }
+    return Status::OK();
+}
+
+void ValidateAdaptor::_validateRecordBatch(OperationContext* opCtx,
+                                           ThreadPool* validatePool,
+                                           size_t numThreads,
+                                           std::vector<BatchedRecord>* batch) {
+    struct IndexKeys {
+        bool matchesFilter = false;
+        Status status = Status::OK();
+        KeyStringSet documentKeySet;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths documentMultikeyPaths;
+    };
+
+    // The keys of record 'r' for index 'i' are at r * numIndexes + i. Each thread only writes the
+    // entries of its own slice of records.
+    const auto& indexes = _validateState->getIndexes();
+    const size_t numIndexes =
+        _validateState->getCollection()->getIndexCatalog()->haveAnyIndexes() ? indexes.size() : 0;
+    std::vector<IndexKeys> generated(batch->size() * numIndexes);
+    auto validateSlice = [&](size_t begin, size_t end) {
+        SharedBufferFragmentBuilder pooledBufferBuilder(BufBuilder::kDefaultInitSizeBytes);
+        for (size_t r = begin; r < end; ++r) {
+            auto& record = (*batch)[r];
+            BSONObj recordBson;
+            record.status =
+                _validateRecordBson(record.id, record.data, &recordBson, &record.validatedSize);
+            if (!record.status.isOK()) {
+                continue;
+            }
 
-        IndexInfo& indexInfo = _indexConsistency->getIndexInfo(descriptor->indexName());
-        for (const auto& keyString : *multikeyMetadataKeys) {
-            try {
-                _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
-            } catch (...) {
-                return exceptionToStatus();
+            for (size_t i = 0; i < numIndexes; ++i) {
+                auto& out = generated[r * numIndexes + i];
+                const auto& index = indexes[i];
+                try {
+                    out.matchesFilter = !index->descriptor()->isPartial() ||
+                        index->getFilterExpression()->matchesBSON(recordBson);
+                    if (out.matchesFilter) {
+                        index->accessMethod()->getKeys(
+                            pooledBufferBuilder,
+                            recordBson,
+                            IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                            IndexAccessMethod::GetKeysContext::kAddingKeys,
+                            &out.documentKeySet,
+                            &out.multikeyMetadataKeys,
+                            &out.documentMultikeyPaths,
+                            record.id,
+                            IndexAccessMethod::kNoopOnSuppressedErrorFn);
+                    }
+                } catch (...) {
+                    out.matchesFilter = true;
+                    out.status = exceptionToStatus();
+                }
             }
         }
+    };
+
+    // This thread validates the first slice while the pool validates the others. All of them must
+    // be finished before 'generated' goes out of scope.
+    const size_t sliceSize = (batch->size() + numThreads - 1) / numThreads;
+    std::vector<Future<void>> slices;
+    ON_BLOCK_EXIT([&] {
+        for (auto& slice : slices) {
+            slice.wait();
+        }
+    });
+    for (size_t begin = sliceSize; begin < batch->size(); begin += sliceSize) {
+        const size_t end = std::min(begin + sliceSize, batch->size());
+        auto pf = makePromiseFuture<void>();
+        validatePool->schedule(
+            [&validateSlice, begin, end, promise = std::move(pf.promise)](Status status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(status);
+                    return;
+                }
+                validateSlice(begin, end);
+                promise.emplaceValue();
+            });
+        slices.push_back(std::move(pf.future));
+    }
+    validateSlice(0, std::min(sliceSize, batch->size()));
 
-        for (const auto& keyString : *documentKeySet) {
-            try {
-                _totalIndexKeys++;
-                _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
-            } catch (...) {
-                return exceptionToStatus();
+    for (auto& slice : slices) {
+        uassertStatusOK(slice.getNoThrow());
+    }
+
+    // The keys are added in record order, on this thread, as validateRecord() would have. Errors
+    // generating keys are thrown from here, as they are thrown from validateRecord().
+    for (size_t r = 0; r < batch->size(); ++r) {
+        auto& record = (*batch)[r];
+        if (!record.status.isOK()) {
+            continue;
+        }
+
+        for (size_t i = 0; i < numIndexes; ++i) {
+            const auto& out = generated[r * numIndexes + i];
+            if (!out.matchesFilter) {
+                continue;
+            }
+            uassertStatusOK(out.status);
+
+            record.status = _addDocKeys(opCtx,
+                                        indexes[i].get(),
+                                        record.id,
+                                        out.documentKeySet,
+                                        out.multikeyMetadataKeys,
+                                        out.documentMultikeyPaths);
+            if (!record.status.isOK()) {
+                break;
             }
         }
     }
-    return status;
 }
 
 namespace {
@@ -317,25 +467,34 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, totalRecords));
     }
 
-    const std::unique_ptr<SeekableRecordThrottleCursor>& traverseRecordStoreCursor =
-        _validateState->getTraverseRecordStoreCursor();
-    for (auto record =
-             traverseRecordStoreCursor->seekExact(opCtx, _validateState->getFirstRecordId());
-         record;
-         record = traverseRecordStoreCursor->next(opCtx)) {
-        _progress->hit();
-        ++_numRecords;
-        auto dataSize = record->data.size();
-        interruptIntervalNumBytes += dataSize;
-        dataSizeTotal += dataSize;
-        size_t validatedSize = 0;
-        Status status = validateRecord(opCtx, record->id, record->data, &validatedSize);
-
-        // Checks to ensure isInRecordIdOrder() is being used properly.
-        if (prevRecordId.isValid()) {
-            invariant(prevRecordId < record->id);
+    // Validating records and generating their keys is CPU-bound, so when configured, the records
+    // read are buffered and validated by several threads. Their keys are still added to the
+    // IndexConsistency in record order on this thread.
+    const size_t validateThreads =
+        _validateState->extraLoggingForTest() ? 1 : gMaxValidateThreads.load();
+    std::unique_ptr<ThreadPool> validatePool;
+    if (validateThreads > 1) {
+        ThreadPool::Options options;
+        options.poolName = "ValidateRecords";
+        options.minThreads = 0;
+        options.maxThreads = validateThreads - 1;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+        };
+        validatePool = std::make_unique<ThreadPool>(options);
+        validatePool->startup();
+    }
+    ON_BLOCK_EXIT([&] {
+        if (validatePool) {
+            validatePool->shutdown();
+            validatePool->join();
         }
+    });
 
+    auto recordValidated = [&](const RecordId& recordId,
+                               long long dataSize,
+                               const Status& status,
+                               size_t validatedSize) {
         // validatedSize = dataSize is not a general requirement as some storage engines may use
         // padding, but we still require that they return the unpadded record data.
         if (!status.isOK() || validatedSize != static_cast<size_t>(dataSize)) {
@@ -343,19 +502,19 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
                 LOGV2(4835000,
                       "Document corruption details - Multiple causes for document validation "
                       "failure; error status and size mismatch",
-                      "recordId"_attr = record->id,
+                      "recordId"_attr = recordId,
                       "validatedBytes"_attr = validatedSize,
                       "recordBytes"_attr = dataSize,
                       "error"_attr = status);
             } else if (!status.isOK()) {
                 LOGV2(4835001,
                       "Document corruption details - Document validation failed with error",
-                      "recordId"_attr = record->id,
+                      "recordId"_attr = recordId,
                       "error"_attr = status);
             } else {
                 LOGV2(4835002,
                       "Document corruption details - Document validation failure; size mismatch",
-                      "recordId"_attr = record->id,
+                      "recordId"_attr = recordId,
                       "validatedBytes"_attr = validatedSize,
                       "recordBytes"_attr = dataSize);
             }
@@ -367,12 +526,58 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
             }
             nInvalid++;
         }
+    };
+
+    std::vector<BatchedRecord> batch;
+    size_t batchBytes = 0;
+    auto validateBatch = [&] {
+        if (batch.empty()) {
+            return;
+        }
+        _validateRecordBatch(opCtx, validatePool.get(), validateThreads, &batch);
+        for (const auto& record : batch) {
+            recordValidated(record.id, record.data.size(), record.status, record.validatedSize);
+        }
+        batch.clear();
+        batchBytes = 0;
+    };
+
+    const std::unique_ptr<SeekableRecordThrottleCursor>& traverseRecordStoreCursor =
+        _validateState->getTraverseRecordStoreCursor();
+    for (auto record =
+             traverseRecordStoreCursor->seekExact(opCtx, _validateState->getFirstRecordId());
+         record;
+         record = traverseRecordStoreCursor->next(opCtx)) {
+        _progress->hit();
+        ++_numRecords;
+        auto dataSize = record->data.size();
+        interruptIntervalNumBytes += dataSize;
+        dataSizeTotal += dataSize;
 
+        // Checks to ensure isInRecordIdOrder() is being used properly.
+        if (prevRecordId.isValid()) {
+            invariant(prevRecordId < record->id);
+        }
         prevRecordId = record->id;
 
+        if (validatePool) {
+            // The record is only valid until the cursor advances, so the batch owns a copy.
+            batchBytes += dataSize;
+            batch.push_back({record->id, record->data.getOwned()});
+            if (batch.size() >= kValidateBatchRecords || batchBytes >= kValidateBatchBytes) {
+                validateBatch();
+            }
+        } else {
+            size_t validatedSize = 0;
+            Status status = validateRecord(opCtx, record->id, record->data, &validatedSize);
+            recordValidated(record->id, dataSize, status, validatedSize);
+        }
+
         if (_numRecords % kInterruptIntervalNumRecords == 0 ||
             interruptIntervalNumBytes >= kInterruptIntervalNumBytes) {
-            // Periodically checks for interrupts and yields.
+            // Periodically checks for interrupts and yields. The batch is validated first, as the
+            // indexes it refers to may be dropped while yielding.
+            validateBatch();
             opCtx->checkForInterrupt();
             _validateState->yield(opCtx);
 
@@ -381,6 +586,7 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
             }
         }
     }
+    validateBatch();
 
     const auto fastCount = _validateState->getCollection()->numRecords(opCtx);
     if (_validateState->shouldEnforceFastCount() &&
@@ -30,6 +30,8 @@
 #pragma once
 
 #include "mongo/db/catalog/validate_state.h"
+#include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -37,6 +39,7 @@ namespace mongo {
 class IndexConsistency;
 class IndexDescriptor;
 class OperationContext;
+class ThreadPool;
 
 /**
  * The validate adaptor is used to keep track of collection and index consistency during a running
@@ -87,6 +90,45 @@ public:
     void validateIndexKeyCount(const IndexCatalogEntry* index, ValidateResults& results);
 
 private:
+    /**
+     * A record read by traverseRecordStore() for _validateRecordBatch() to validate.
+     */
+    struct BatchedRecord {
+        RecordId id;
+        RecordData data;
+        Status status = Status::OK();
+        size_t validatedSize = 0;
+    };
+
+    /**
+     * Validates the BSON of the record. Safe to call from several threads at once.
+     */
+    Status _validateRecordBson(const RecordId& recordId,
+                               const RecordData& record,
+                               BSONObj* recordBson,
+                               size_t* dataSize) const;
+
+    /**
+     * Checks the keys generated from a record for 'index' against its multikey state and adds them
+     * to the index consistency.
+     */
+    Status _addDocKeys(OperationContext* opCtx,
+                       const IndexCatalogEntry* index,
+                       const RecordId& recordId,
+                       const KeyStringSet& documentKeySet,
+                       const KeyStringSet& multikeyMetadataKeys,
+                       const MultikeyPaths& documentMultikeyPaths);
+
+    /**
+     * Does the work of validateRecord() for each record of 'batch', validating the BSON of the
+     * records and generating their keys on up to 'numThreads' threads from 'validatePool' and
+     * this one. Sets the status and validated size of each record.
+     */
+    void _validateRecordBatch(OperationContext* opCtx,
+                              ThreadPool* validatePool,
+                              size_t numThreads,
+                              std::vector<BatchedRecord>* batch);
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
     ValidateResultsMap* _indexNsResultsMap;
@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/change_stream_pre_images.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_builds_coordinator.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/storage/storage_options.h"
+
+namespace mongo {
+namespace change_stream_pre_images {
+
+void createPreImagesCollectionIfNeeded(OperationContext* opCtx) {
+    const auto& nss = NamespaceString::kChangeStreamPreImagesNamespace;
+    writeConflictRetry(opCtx, "createPreImagesCollection", nss.ns(), [&] {
+        AutoGetOrCreateDb autoDb(opCtx, nss.db(), MODE_X);
+        if (CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss)) {
+            return;
+        }
+
+        CollectionOptions options;
+        options.uuid = UUID::gen();
+        // Only WiredTiger record stores can be clustered. Elsewhere the pre-images are found
+        // through the _id index instead.
+        options.clustered = storageGlobalParams.engine == "wiredTiger";
+
+        WriteUnitOfWork wuow(opCtx);
+        auto collection = autoDb.getDb()->createCollection(opCtx, nss, options);
+        invariant(collection);
+
+        const auto ttlIndexSpec =
+            BSON("v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion) << "key"
+                     << BSON(kExpireAtFieldName << 1) << "name"
+                     << (kExpireAtFieldName + "_1") << "expireAfterSeconds" << 0);
+        IndexBuildsCoordinator::get(opCtx)->createIndexesOnEmptyCollection(
+            opCtx, collection->uuid(), {ttlIndexSpec}, false /* fromMigrate */);
+        wuow.commit();
+    });
+}
+
+bool preImagesCollectionExists(OperationContext* opCtx) {
+    return CollectionCatalog::get(opCtx).lookupCollectionByNamespace(
+        opCtx, NamespaceString::kChangeStreamPreImagesNamespace);
+}
+
+void writePreImage(OperationContext* opCtx,
+                   const UUID& nsUUID,
+                   Timestamp ts,
+                   const BSONObj& preImage) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(!ts.isNull());
+
+    AutoGetCollection autoColl(opCtx, NamespaceString::kChangeStreamPreImagesNamespace, MODE_IX);
+    auto collection = autoColl.getCollection();
+    invariant(collection);
+
+    const auto id = idForTimestamp(ts);
+    BSONObjBuilder builder;
+    builder.append("_id", id);
+    nsUUID.appendToBuilder(&builder, kNsUUIDFieldName);
+    builder.append(kTsFieldName, ts);
+    builder.append(
+        kExpireAtFieldName,
+        Date_t::now() + Seconds(repl::changeStreamPreImagesExpireAfterSeconds.load()));
+    builder.append(kPreImageFieldName, preImage);
+    const auto doc = builder.obj();
+
+    // Replace rather than delete a leftover pre-image, since a delete here would run the delete
+    // observers in the middle of observing the write whose pre-image this is.
+    const auto idQuery = BSON("_id" << id);
+    const auto staleRecordId = Helpers::findById(opCtx, collection, idQuery);
+    if (!staleRecordId.isNull()) {
+        auto staleDoc = collection->docFor(opCtx, staleRecordId);
+        CollectionUpdateArgs args;
+        args.update = doc;
+        args.criteria = idQuery;
+        args.updatedDoc = doc;
+        collection->updateDocument(opCtx, staleRecordId, staleDoc, doc, true, nullptr, &args);
+        return;
+    }
+
+    uassertStatusOK(collection->insertDocument(opCtx, InsertStatement(doc), nullptr));
+}
+
+}  // namespace change_stream_pre_images
+}  // namespace mongo
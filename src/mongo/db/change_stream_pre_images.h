@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Storage for the pre-images of updates and deletes to collections created or modified with
+ * {recordPreImages: true}, which change streams return as 'fullDocumentBeforeChange'.
+ *
+ * Outside of multi-document transactions these pre-images are kept in the unreplicated collection
+ * NamespaceString::kChangeStreamPreImagesNamespace rather than in no-op oplog entries. Every node
+ * stores the pre-images of the writes it performs or applies, under the timestamp of the write's
+ * oplog entry, so that they take no space in the oplog nor in replication traffic. The collection
+ * is clustered by that timestamp and a TTL index removes each pre-image once it is
+ * changeStreamPreImagesExpireAfterSeconds old.
+ *
+ * Each document has the form
+ *     {_id: <NumberLong timestamp>, nsUUID: <collection UUID>, ts: <timestamp>,
+ *      expireAt: <Date>, preImage: <document before the write>}
+ */
+namespace change_stream_pre_images {
+
+constexpr StringData kNsUUIDFieldName = "nsUUID"_sd;
+constexpr StringData kTsFieldName = "ts"_sd;
+constexpr StringData kExpireAtFieldName = "expireAt"_sd;
+constexpr StringData kPreImageFieldName = "preImage"_sd;
+
+/**
+ * Returns the _id of the pre-image of the write whose oplog entry has timestamp 'ts'. Oplog
+ * timestamps are unique, so the collection's UUID need not be part of the _id.
+ */
+inline long long idForTimestamp(Timestamp ts) {
+    return static_cast<long long>(ts.asULL());
+}
+
+/**
+ * Creates the pre-images collection and its TTL index if the collection does not exist yet.
+ */
+void createPreImagesCollectionIfNeeded(OperationContext* opCtx);
+
+/**
+ * Returns whether the pre-images collection exists. Writes keep recording pre-images in the
+ * oplog when it does not, which is the case when mongod runs read-only.
+ */
+bool preImagesCollectionExists(OperationContext* opCtx);
+
+/**
+ * Stores 'preImage' as the pre-image of the write to the collection with UUID 'nsUUID' whose
+ * oplog entry has timestamp 'ts', in the current WriteUnitOfWork. Replaces any pre-image already
+ * stored under 'ts', which can only be left over from a write that was rolled back.
+ */
+void writePreImage(OperationContext* opCtx,
+                   const UUID& nsUUID,
+                   Timestamp ts,
+                   const BSONObj& preImage);
+
+}  // namespace change_stream_pre_images
+}  // namespace mongo
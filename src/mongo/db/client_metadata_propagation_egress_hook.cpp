@@ -29,6 +29,7 @@
 
 #include "mongo/db/client_metadata_propagation_egress_hook.h"
 
+#include "mongo/db/operation_trace.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
 
@@ -40,6 +41,7 @@ Status ClientMetadataPropagationEgressHook::writeRequestMetadata(OperationContex
     try {
         writeAuthDataToImpersonatedUserMetadata(opCtx, metadataBob);
         ClientMetadataIsMasterState::writeToMetadata(opCtx, metadataBob);
+        OperationTrace::writeToMetadata(opCtx, metadataBob);
         return Status::OK();
     } catch (...) {
         return exceptionToStatus();
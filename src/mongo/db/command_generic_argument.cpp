@@ -52,7 +52,7 @@ struct SpecialArgRecord {
 // If that changes, it should be added. When you add to this list, consider whether you
 // should also change the filterCommandRequestForPassthrough() function.
 // clang-format off
-static constexpr std::array<SpecialArgRecord, 30> specials{{
+static constexpr std::array<SpecialArgRecord, 32> specials{{
     //                                       /-isGeneric
     //                                       |  /-stripFromRequest
     //                                       |  |  /-stripFromReply
@@ -71,6 +71,7 @@ static constexpr std::array<SpecialArgRecord, 30> specials{{
     {"databaseVersion"_sd,                   1, 1, 0},
     {"shardVersion"_sd,                      1, 1, 0},
     {"tracking_info"_sd,                     1, 1, 0},
+    {"$traceparent"_sd,                      1, 1, 0},
     {"writeConcern"_sd,                      1, 0, 0},
     {"lsid"_sd,                              1, 0, 0},
     {"clientOperationKey"_sd,                1, 0, 0},
@@ -85,6 +86,7 @@ static constexpr std::array<SpecialArgRecord, 30> specials{{
     {"readOnly"_sd,                          0, 0, 1},
     {"comment"_sd,                           1, 0, 0},
     {"maxTimeMSOpOnly"_sd,                   1, 0, 0},
+    {"admissionPriority"_sd,                 1, 0, 0},
     {"$configTime"_sd,                       1, 1, 1}}};
 // clang-format on
 
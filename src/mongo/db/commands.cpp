@@ -308,9 +308,24 @@ Command* CommandHelpers::findCommand(StringData name) {
 }
 
 bool CommandHelpers::appendCommandStatusNoThrow(BSONObjBuilder& result, const Status& status) {
-    appendSimpleCommandStatus(result, status.isOK(), status.reason());
-    BSONObj tmp = result.asTempObj();
-    if (!status.isOK() && !tmp.hasField("code")) {
+    // Look for the fields we may add in a single pass over the reply built so far.
+    bool haveOk = false;
+    bool haveErrmsg = false;
+    bool haveCode = false;
+    for (auto&& elem : result.asTempObj()) {
+        const auto fieldName = elem.fieldNameStringData();
+        haveOk = haveOk || fieldName == "ok"_sd;
+        haveErrmsg = haveErrmsg || fieldName == "errmsg"_sd;
+        haveCode = haveCode || fieldName == "code"_sd;
+    }
+
+    if (!haveOk) {
+        result.append("ok", status.isOK() ? 1.0 : 0.0);
+    }
+    if (!status.isOK() && !haveErrmsg) {
+        result.append("errmsg", status.reason());
+    }
+    if (!status.isOK() && !haveCode) {
         result.append("code", status.code());
         result.append("codeName", ErrorCodes::errorString(status.code()));
     }
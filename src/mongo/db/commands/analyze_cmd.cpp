@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+namespace dps = ::mongo::dotted_path_support;
+
+constexpr long long kDefaultSampleSize = 10000;
+constexpr long long kMaxSampleSize = 1000000;
+constexpr long long kDefaultNumBuckets = 100;
+constexpr long long kMaxNumBuckets = 1000;
+
+long long parsePositiveLong(const BSONObj& cmdObj,
+                            StringData fieldName,
+                            long long defaultValue,
+                            long long maxValue) {
+    auto elt = cmdObj[fieldName];
+    if (elt.eoo()) {
+        return defaultValue;
+    }
+    uassert(5160000,
+            str::stream() << "'" << fieldName << "' must be a number between 1 and " << maxValue,
+            elt.isNumber() && elt.safeNumberLong() >= 1 && elt.safeNumberLong() <= maxValue);
+    return elt.safeNumberLong();
+}
+
+/**
+ * Returns the index keys that 'doc' generates for the dotted 'path', each as a single-field object.
+ * A document without the field generates a null key, as it would in an index.
+ */
+std::vector<BSONObj> extractKeys(const BSONObj& doc, StringData path) {
+    BSONElementSet elements;
+    dps::extractAllElementsAlongPath(doc, path, elements);
+
+    std::vector<BSONObj> keys;
+    if (elements.empty()) {
+        keys.push_back(BSON("" << BSONNULL));
+    }
+    for (const auto& elt : elements) {
+        BSONObjBuilder builder;
+        builder.appendAs(elt, "");
+        keys.push_back(builder.obj());
+    }
+    return keys;
+}
+
+/**
+ * The 'analyze' command builds a histogram of the index keys of one field of a collection from a
+ * sample of its documents, for the planner to estimate how many keys index scans read:
+ *
+ *    {
+ *        analyze: <collection>,
+ *        key: <dotted path>,
+ *        sampleSize: <number of documents, 10000 by default>,
+ *        numBuckets: <number of histogram buckets, 100 by default>
+ *    }
+ *
+ * The histograms are held in memory by each node, and running the command again on a field
+ * replaces its histogram.
+ */
+class AnalyzeCmd final : public BasicCommand {
+public:
+    AnalyzeCmd() : BasicCommand("analyze") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override;
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        AuthorizationSession* authzSession = AuthorizationSession::get(client);
+        ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+        if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+            return Status::OK();
+        }
+
+        return Status(ErrorCodes::Unauthorized, "unauthorized");
+    }
+
+    std::string help() const override {
+        return "Builds the histogram of a field of a collection that the query planner uses to "
+               "estimate the cost of index scans.";
+    }
+} analyzeCmd;
+
+bool AnalyzeCmd::run(OperationContext* opCtx,
+                     const std::string& dbname,
+                     const BSONObj& cmdObj,
+                     BSONObjBuilder& result) {
+    const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+    auto keyElt = cmdObj["key"];
+    uassert(5160001,
+            "'key' must be a field path",
+            keyElt.type() == BSONType::String && !keyElt.valueStringData().empty() &&
+                !keyElt.valueStringData().startsWith("$"));
+    const auto path = keyElt.valueStringData();
+    const auto sampleSize =
+        parsePositiveLong(cmdObj, "sampleSize", kDefaultSampleSize, kMaxSampleSize);
+    const auto numBuckets =
+        parsePositiveLong(cmdObj, "numBuckets", kDefaultNumBuckets, kMaxNumBuckets);
+
+    // This is a read lock. The statistics, like the query cache, are owned by the collection.
+    AutoGetCollectionForReadCommand ctx(opCtx, nss);
+    Collection* collection = ctx.getCollection();
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nss << " does not exist",
+            collection);
+
+    const long long numDocuments = collection->numRecords(opCtx);
+    std::vector<std::vector<BSONObj>> sample;
+    std::unique_ptr<RecordCursor> randomCursor;
+    if (numDocuments > sampleSize) {
+        randomCursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    }
+    if (randomCursor) {
+        while (static_cast<long long>(sample.size()) < sampleSize) {
+            auto record = randomCursor->next();
+            if (!record) {
+                break;
+            }
+            sample.push_back(extractKeys(record->data.toBson(), path));
+        }
+    } else {
+        // Without a random cursor, the sample is drawn from a scan of the whole collection.
+        auto& prng = opCtx->getClient()->getPrng();
+        long long numSeen = 0;
+        auto cursor = collection->getCursor(opCtx);
+        while (auto record = cursor->next()) {
+            opCtx->checkForInterrupt();
+            ++numSeen;
+            if (static_cast<long long>(sample.size()) < sampleSize) {
+                sample.push_back(extractKeys(record->data.toBson(), path));
+            } else if (auto slot = prng.nextInt64(numSeen); slot < sampleSize) {
+                sample[slot] = extractKeys(record->data.toBson(), path);
+            }
+        }
+    }
+
+    std::vector<BSONObj> keys;
+    for (auto& docKeys : sample) {
+        std::move(docKeys.begin(), docKeys.end(), std::back_inserter(keys));
+    }
+    auto histogram = FieldHistogram::make(std::move(keys),
+                                          sample.size(),
+                                          std::max<long long>(numDocuments, sample.size()),
+                                          numBuckets);
+
+    LOGV2_DEBUG(5155016,
+                1,
+                "Built field histogram",
+                "namespace"_attr = nss,
+                "key"_attr = path,
+                "numSampledDocuments"_attr = histogram.numSampledDocuments(),
+                "numDistinctValues"_attr = histogram.numDistinctValues());
+
+    result.append("key", path);
+    histogram.appendToBuilder(&result);
+    CollectionQueryInfo::get(collection).setFieldHistogram(collection, path, std::move(histogram));
+    return true;
+}
+
+}  // namespace
+}  // namespace mongo
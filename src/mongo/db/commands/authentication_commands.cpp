@@ -63,6 +63,7 @@
 #include "mongo/util/net/ssl_manager.h"
 #include "mongo/util/net/ssl_types.h"
 #include "mongo/util/text.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -287,7 +288,9 @@ bool CmdAuthenticate::run(OperationContext* opCtx,
 
     Status status = authCounter.incAuthenticateReceived(mechanism);
     if (status.isOK()) {
+        Timer timer;
         status = _authenticate(opCtx, mechanism, user, cmdObj);
+        authCounter.incAuthenticationTime(mechanism, Microseconds(timer.micros())).ignore();
     }
     audit::logAuthentication(Client::getCurrent(), mechanism, user, status.code());
 
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/optional.hpp>
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
@@ -52,14 +53,88 @@
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/hex.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/timer.h"
+#include "third_party/murmurhash3/MurmurHash3.h"
 
 namespace mongo {
 
 namespace {
 
+/**
+ * Splits the documents of a collection, visited in _id order, into ranges and hashes each range.
+ * A range ends after any document whose _id hashes to a multiple of the requested range size, so
+ * the boundaries depend only on the _id values and not on how many documents precede them. A
+ * document which is missing or differs on one node then changes the hash of the single range
+ * containing it, which lets the caller narrow an inconsistency down without comparing every
+ * document of the collection.
+ */
+class RangeHasher {
+public:
+    explicit RangeHasher(long long rangeSize) : _rangeSize(rangeSize) {}
+
+    void append(const BSONObj& doc) {
+        auto id = doc["_id"];
+        _maxId = id.eoo() ? BSONObj() : id.wrap("max");
+        if (_count == 0) {
+            _minId = id.eoo() ? BSONObj() : id.wrap("min");
+        }
+
+        // Chaining the document hashes makes the range hash depend on the order of the documents.
+        uint64_t chained[4] = {_hash[0], _hash[1], 0, 0};
+        MurmurHash3_x64_128(doc.objdata(), doc.objsize(), 0, &chained[2]);
+        MurmurHash3_x64_128(chained, sizeof(chained), 0, _hash);
+        ++_count;
+
+        // Capped collections may hold documents without an _id; their own hash decides instead.
+        uint32_t boundaryHash = static_cast<uint32_t>(chained[2]);
+        if (!id.eoo()) {
+            MurmurHash3_x86_32(id.value(), id.valuesize(), 0, &boundaryHash);
+        }
+        if (boundaryHash % _rangeSize == 0) {
+            _finishRange();
+        }
+    }
+
+    BSONArray done() {
+        if (_count > 0) {
+            _finishRange();
+        }
+        return _ranges.arr();
+    }
+
+private:
+    void _finishRange() {
+        BSONObjBuilder range(_ranges.subobjStart());
+        if (_minId.isEmpty()) {
+            range.appendNull("min");
+        } else {
+            range.append(_minId.firstElement());
+        }
+        if (_maxId.isEmpty()) {
+            range.appendNull("max");
+        } else {
+            range.append(_maxId.firstElement());
+        }
+        range.appendNumber("count", _count);
+        range.append("hash", toHexLower(_hash, sizeof(_hash)));
+        range.done();
+
+        _count = 0;
+        _hash[0] = _hash[1] = 0;
+    }
+
+    const long long _rangeSize;
+
+    BSONArrayBuilder _ranges;
+    BSONObj _minId;
+    BSONObj _maxId;
+    long long _count = 0;
+    uint64_t _hash[2] = {0, 0};
+};
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -132,6 +207,20 @@ public:
             }
         }
 
+        // When 'rangeSize' is given, each collection's documents are additionally reported as
+        // hashed _id ranges of about that many documents each.
+        long long rangeSize = 0;
+        if (auto elem = cmdObj["rangeSize"]) {
+            uassert(ErrorCodes::TypeMismatch,
+                    "The 'rangeSize' option must be a number",
+                    elem.isNumber());
+            rangeSize = elem.safeNumberLong();
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "The 'rangeSize' option must be between 1 and "
+                                  << std::numeric_limits<int>::max(),
+                    rangeSize >= 1 && rangeSize <= std::numeric_limits<int>::max());
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -233,6 +322,7 @@ public:
         md5_init(&globalState);
 
         std::map<std::string, std::string> collectionToHashMap;
+        std::map<std::string, BSONArray> collectionToRangesMap;
         std::map<std::string, OptionalCollectionUUID> collectionToUUIDMap;
         std::set<std::string> cappedCollectionSet;
 
@@ -273,9 +363,17 @@ public:
             }
 
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss);
+            boost::optional<RangeHasher> rangeHasher;
+            if (rangeSize > 0) {
+                rangeHasher.emplace(rangeSize);
+            }
+            std::string hash =
+                _hashCollection(opCtx, db, collNss, rangeHasher ? &*rangeHasher : nullptr);
 
             collectionToHashMap[collNss.coll().toString()] = hash;
+            if (rangeHasher) {
+                collectionToRangesMap[collNss.coll().toString()] = rangeHasher->done();
+            }
 
             return true;
         });
@@ -308,6 +406,13 @@ public:
         result.append("capped", BSONArray(cappedCollections.done()));
         result.append("uuids", collectionsByUUID.done());
 
+        if (rangeSize > 0) {
+            BSONObjBuilder rangesBuilder(result.subobjStart("ranges"));
+            for (const auto& entry : collectionToRangesMap) {
+                rangesBuilder.append(entry.first, entry.second);
+            }
+        }
+
         md5digest d;
         md5_finish(&globalState, d);
         std::string hash = digestToString(d);
@@ -319,7 +424,10 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+    std::string _hashCollection(OperationContext* opCtx,
+                                Database* db,
+                                const NamespaceString& nss,
+                                RangeHasher* rangeHasher) {
 
         Collection* collection =
             CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss);
@@ -362,7 +470,8 @@ private:
                                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
                                               InternalPlanner::FORWARD,
                                               InternalPlanner::IXSCAN_FETCH);
-        } else if (collection->isCapped()) {
+        } else if (collection->isCapped() || collection->isClustered()) {
+            // A clustered collection's natural order is its _id order.
             exec = InternalPlanner::collectionScan(
                 opCtx, nss.ns(), collection, PlanYieldPolicy::YieldPolicy::NO_YIELD);
         } else {
@@ -382,6 +491,9 @@ private:
             verify(nullptr != exec.get());
             while (exec->getNext(&c, nullptr) == PlanExecutor::ADVANCED) {
                 md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+                if (rangeHasher) {
+                    rangeHasher->append(c);
+                }
                 n++;
             }
         } catch (DBException& exception) {
@@ -48,6 +48,7 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/getmore_request.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -519,6 +520,14 @@ public:
 
             // Generate the response object to send to the client.
             firstBatch.done(cursorId, nss.ns());
+
+            // If the client allows exhaust, stream the remaining batches with getMores that the
+            // server issues on its behalf, so that the client need not ask for each one. Tailable
+            // cursors are left to the client, whose getMores carry awaitData timeouts and terms.
+            if (opCtx->isExhaust() && cursorId && !originalQR.isTailable() &&
+                !opCtx->inMultiDocumentTransaction()) {
+                result->setNextInvocation(_makeExhaustGetMore(nss, originalQR, cursorId));
+            }
         }
 
         void appendMirrorableRequest(BSONObjBuilder* bob) const override {
@@ -545,6 +554,24 @@ public:
         }
 
     private:
+        BSONObj _makeExhaustGetMore(const NamespaceString& nss,
+                                    const QueryRequest& qr,
+                                    CursorId cursorId) const {
+            boost::optional<std::int64_t> batchSize;
+            if (auto size = qr.getBatchSize()) {
+                batchSize = *size;
+            }
+            BSONObjBuilder bob(
+                GetMoreRequest(nss, cursorId, batchSize, boost::none, boost::none, boost::none)
+                    .toBSON());
+            bob.append("$db", _dbName);
+            // A cursor opened in a session must be continued in the same session.
+            if (auto lsid = _request.body["lsid"]) {
+                bob.append(lsid);
+            }
+            return bob.obj();
+        }
+
         const OpMsgRequest _request;
         const StringData _dbName;
     };
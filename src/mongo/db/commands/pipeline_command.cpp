@@ -120,6 +120,44 @@ public:
             return true;
         }
 
+        bool supportsReadMirroring() const override {
+            // Only mirror plain reads of a collection. Explains, change streams, collectionless
+            // aggregations and pipelines that write through $out or $merge are never mirrored.
+            return !_aggregationRequest.getExplain() && !_liteParsedPipeline.hasChangeStream() &&
+                !_aggregationRequest.getNamespaceString().isCollectionlessAggregateNS() &&
+                !Pipeline::aggHasWriteStage(_request.body);
+        }
+
+        void appendMirrorableRequest(BSONObjBuilder* bob) const override {
+            // Mirroring happens after the command has returned, so build the request from the
+            // parsed AggregationRequest that this invocation owns rather than from '_request'.
+            bob->append(AggregationRequest::kCommandName,
+                        _aggregationRequest.getNamespaceString().coll());
+            {
+                BSONArrayBuilder pipelineBuilder(
+                    bob->subarrayStart(AggregationRequest::kPipelineName));
+                for (auto&& stage : _aggregationRequest.getPipeline()) {
+                    pipelineBuilder.append(stage);
+                }
+
+                // Like a mirrored find, only ask for a single document. Any blocking stage still
+                // consumes its whole input, and the cursor is exhausted by the first batch.
+                pipelineBuilder.append(BSON("$limit" << 1));
+            }
+
+            if (auto collation = _aggregationRequest.getCollation(); !collation.isEmpty()) {
+                bob->append(AggregationRequest::kCollationName, collation);
+            }
+            if (auto hint = _aggregationRequest.getHint(); !hint.isEmpty()) {
+                bob->append(AggregationRequest::kHintName, hint);
+            }
+            if (_aggregationRequest.shouldAllowDiskUse()) {
+                bob->append(AggregationRequest::kAllowDiskUseName, true);
+            }
+
+            bob->append(AggregationRequest::kCursorName, BSONObj());
+        }
+
         void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
             CommandHelpers::handleMarkKillOnClientDisconnect(
                 opCtx, !Pipeline::aggHasWriteStage(_request.body));
@@ -50,6 +50,14 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_pipeline_result_cache.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -61,6 +69,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -68,6 +77,7 @@
 #include "mongo/db/repl/speculative_majority_read_info.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_catalog.h"
@@ -446,6 +456,223 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
     return pipelines;
 }
 
+/**
+ * Returns true if the operation reads the latest local data outside of a transaction, and so may
+ * be answered from the pipeline result cache. Readers which asked for a particular point in time
+ * must not observe results computed at another.
+ */
+bool readsLatestLocalData(OperationContext* opCtx, const AggregationRequest& request) {
+    if (request.getExplain() || opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    return readConcernArgs.getLevel() == repl::ReadConcernLevel::kLocalReadConcern &&
+        !readConcernArgs.getArgsAfterClusterTime() && !readConcernArgs.getArgsAtClusterTime() &&
+        !readConcernArgs.getArgsOpTime();
+}
+
+/**
+ * Returns true if an aggregation on a view may be answered from the pipeline result cache, which
+ * requires that the operation is tolerant of reading results which are up to
+ * 'internalQueryViewResultCacheMaxStalenessMS' old.
+ */
+bool canUseViewResultCache(OperationContext* opCtx,
+                           const AggregationRequest& request,
+                           const ResolvedView& resolvedView) {
+    if (internalQueryViewResultCacheMaxStalenessMS.load() <= 0 ||
+        resolvedView.getPipeline().empty() || !readsLatestLocalData(opCtx, request)) {
+        return false;
+    }
+
+    // The cached results are keyed on the underlying collection alone, so the view pipeline may
+    // not read from any other namespace.
+    LiteParsedPipeline liteParsedViewPipeline(resolvedView.getNamespace(),
+                                              resolvedView.getPipeline());
+    return liteParsedViewPipeline.getInvolvedNamespaces().empty() &&
+        !liteParsedViewPipeline.hasChangeStream();
+}
+
+/**
+ * Returns true if 'obj' contains an expression or operator whose result is not a function of the
+ * documents it is applied to.
+ */
+bool containsNonDeterministicExpression(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "$rand"_sd || fieldName == "$sampleRate"_sd ||
+            fieldName == "$function"_sd || fieldName == "$accumulator"_sd ||
+            fieldName == "$where"_sd) {
+            return true;
+        }
+        if (fieldName == "$meta"_sd && elem.type() == BSONType::String &&
+            elem.valueStringData() == "randVal"_sd) {
+            return true;
+        }
+        if (elem.type() == BSONType::String &&
+            (elem.valueStringData().startsWith("$$NOW"_sd) ||
+             elem.valueStringData().startsWith("$$CLUSTER_TIME"_sd))) {
+            return true;
+        }
+        if (elem.isABSONObj() && containsNonDeterministicExpression(elem.Obj())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Finds the longest prefix of 'pipeline' which ends in a blocking stage and whose output is a
+ * function of the collection contents alone. Returns the number of stages in the prefix, which is
+ * zero if there is no such prefix, and fills out 'serializedPrefix' with their serialization.
+ */
+size_t findCacheablePrefix(const Pipeline& pipeline, std::vector<BSONObj>* serializedPrefix) {
+    size_t prefixLength = 0;
+    size_t numStages = 0;
+    for (auto&& source : pipeline.getSources()) {
+        auto stage = source.get();
+        if (dynamic_cast<DocumentSourceGroup*>(stage) || dynamic_cast<DocumentSourceSort*>(stage)) {
+            prefixLength = ++numStages;
+        } else if (dynamic_cast<DocumentSourceMatch*>(stage) ||
+                   dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage) ||
+                   dynamic_cast<DocumentSourceUnwind*>(stage) ||
+                   dynamic_cast<DocumentSourceLimit*>(stage) ||
+                   dynamic_cast<DocumentSourceSkip*>(stage)) {
+            ++numStages;
+        } else {
+            break;
+        }
+    }
+
+    std::vector<Value> serialized;
+    auto it = pipeline.getSources().begin();
+    for (size_t i = 0; i < prefixLength; ++i, ++it) {
+        (*it)->serializeToArray(serialized);
+    }
+    for (auto&& stage : serialized) {
+        auto stageObj = stage.getDocument().toBson();
+        if (containsNonDeterministicExpression(stageObj)) {
+            return 0;
+        }
+        serializedPrefix->push_back(std::move(stageObj));
+    }
+    return prefixLength;
+}
+
+/**
+ * Returns true if 'filter' only matches documents whose _id is no greater than 'newestId', because
+ * it bounds the _id from above by a value of a type which is compared the same way under every
+ * collation.
+ */
+bool boundsIdNoGreaterThan(const BSONObj& filter, const BSONElement& newestId) {
+    auto isBoundNoGreater = [&](const BSONElement& bound) {
+        switch (bound.type()) {
+            case NumberInt:
+            case NumberLong:
+            case NumberDouble:
+            case NumberDecimal:
+            case jstOID:
+            case Date:
+            case bsonTimestamp:
+                return bound.woCompare(newestId, false) <= 0;
+            default:
+                return false;
+        }
+    };
+
+    for (auto&& elem : filter) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "$and"_sd && elem.type() == BSONType::Array) {
+            for (auto&& child : elem.Obj()) {
+                if (child.type() == BSONType::Object &&
+                    boundsIdNoGreaterThan(child.Obj(), newestId)) {
+                    return true;
+                }
+            }
+        } else if (fieldName == "_id"_sd) {
+            if (elem.type() != BSONType::Object ||
+                !elem.Obj().firstElementFieldNameStringData().startsWith("$"_sd)) {
+                if (isBoundNoGreater(elem)) {
+                    return true;
+                }
+                continue;
+            }
+            for (auto&& op : elem.Obj()) {
+                const auto opName = op.fieldNameStringData();
+                if ((opName == "$lt"_sd || opName == "$lte"_sd || opName == "$eq"_sd) &&
+                    isBoundNoGreater(op)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns true if 'collection' is append-only and the leading $match of 'pipeline' only admits
+ * documents inserted no later than the newest document the collection knows of. Inserts can then
+ * only change the output of the pipeline if they are out of _id order, so its results may be
+ * keyed on the collection's append version rather than its write version.
+ */
+bool readsOnlyAppendedPrefix(const Collection* collection, const Pipeline& pipeline) {
+    if (!collection->isAppendOnly() || pipeline.getSources().empty()) {
+        return false;
+    }
+    auto match = dynamic_cast<DocumentSourceMatch*>(pipeline.getSources().front().get());
+    if (!match) {
+        return false;
+    }
+    const auto newestId = collection->getNewestInsertedId();
+    return !newestId.isEmpty() && boundsIdNoGreaterThan(match->getQuery(), newestId.firstElement());
+}
+
+/**
+ * Replaces a deterministic prefix of 'pipeline' ending in a blocking stage, if one exists, with a
+ * stage which serves the output of the prefix from the pipeline result cache while the contents of
+ * 'collection' are unchanged.
+ */
+void replaceCacheablePrefix(OperationContext* opCtx,
+                            const Collection* collection,
+                            const AggregationRequest& request,
+                            const LiteParsedPipeline& liteParsedPipeline,
+                            Pipeline* pipeline) {
+    if (!internalQueryEnablePipelinePrefixCache.load() || !collection ||
+        liteParsedPipeline.hasChangeStream() || request.getExchangeSpec() ||
+        !request.getLetParameters().isEmpty() || ShardingState::get(opCtx)->enabled() ||
+        !readsLatestLocalData(opCtx, request)) {
+        return;
+    }
+
+    // Reads on secondaries use a timestamp which may precede writes that have already advanced
+    // the collection's write version.
+    const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+    if (readSource != RecoveryUnit::ReadSource::kUnset &&
+        readSource != RecoveryUnit::ReadSource::kNoTimestamp) {
+        return;
+    }
+
+    std::vector<BSONObj> serializedPrefix;
+    const auto prefixLength = findCacheablePrefix(*pipeline, &serializedPrefix);
+    if (prefixLength == 0) {
+        return;
+    }
+
+    // The write version must be observed before the snapshot that the prefix will read from is
+    // opened. Otherwise a write committing in between would be reflected in the version but not
+    // in the cached results.
+    opCtx->recoveryUnit()->abandonSnapshot();
+    const auto writeVersion = readsOnlyAppendedPrefix(collection, *pipeline)
+        ? collection->getAppendVersion()
+        : collection->getWriteVersion();
+
+    for (size_t i = 0; i < prefixLength; ++i) {
+        pipeline->popFront();
+    }
+    pipeline->addInitialSource(DocumentSourcePipelineResultCache::create(
+        pipeline->getContext(), std::move(serializedPrefix), writeVersion));
+}
+
 /**
  * Create a PlanExecutor to execute the given 'pipeline'.
  */
@@ -595,6 +822,14 @@ Status runAggregate(OperationContext* opCtx,
             // With the view & collation resolved, we can relinquish locks.
             ctx.reset();
 
+            // Replace the view pipeline with a stage which may serve its results from the cache.
+            if (canUseViewResultCache(opCtx, request, resolvedView)) {
+                resolvedView = ResolvedView(
+                    resolvedView.getNamespace(),
+                    {DocumentSourcePipelineResultCache::makeSpec(resolvedView.getPipeline())},
+                    resolvedView.getDefaultCollation());
+            }
+
             // Parse the resolved view into a new aggregation request.
             auto newRequest = resolvedView.asExpandedViewAggregation(request);
             auto newCmd = newRequest.serializeToCommandObj().toBson();
@@ -629,6 +864,8 @@ Status runAggregate(OperationContext* opCtx,
 
         pipeline->optimizePipeline();
 
+        replaceCacheablePrefix(opCtx, collection, request, liteParsedPipeline, pipeline.get());
+
         // Check if the pipeline has a $geoNear stage, as it will be ripped away during the build
         // query executor phase below (to be replaced with a $geoNearCursorStage later during the
         // executor attach phase).
@@ -125,6 +125,8 @@ public:
  * Note: Clients are only not counted if they try to connect to the server with a unsupported TLS
  * version. They are still counted if the server rejects them for certificate issues in
  * parseAndValidatePeerCertificate.
+ * It also reports the TLS handshakes completed, with their time and how many resumed a session,
+ * and the bytes encrypted for sending.
  */
 class TLSVersionStatus : public ServerStatusSection {
 public:
@@ -144,6 +146,14 @@ public:
         builder.append("1.2", counts.tls12.load());
         builder.append("1.3", counts.tls13.load());
         builder.append("unknown", counts.tlsUnknown.load());
+
+        auto& sessionCounts = TLSSessionCounts::get(opCtx->getServiceContext());
+        BSONObjBuilder handshakes(builder.subobjStart("handshakes"));
+        handshakes.append("count", sessionCounts.handshakes.load());
+        handshakes.append("totalMicros", sessionCounts.handshakeMicros.load());
+        handshakes.append("resumed", sessionCounts.resumedHandshakes.load());
+        handshakes.done();
+        builder.append("bytesEncrypted", sessionCounts.bytesEncrypted.load());
         return builder.obj();
     }
 } tlsVersionStatus;
@@ -32,7 +32,14 @@
 #include <benchmark/benchmark.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/command_generic_argument.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine_mock.h"
+#include "mongo/rpc/op_msg_rpc_impls.h"
 
 namespace mongo {
 namespace {
@@ -70,9 +77,48 @@ void BM_IsReplyStripArgument(benchmark::State& state) {
     }
 }
 
+/**
+ * Returns the global ServiceContext with a mock storage engine installed, so that its operations
+ * get a LockerImpl and a RecoveryUnit as they would in mongod.
+ */
+ServiceContext* serviceContextWithStorage() {
+    static auto service = [] {
+        auto service = getGlobalServiceContext();
+        service->setStorageEngine(std::make_unique<StorageEngineMock>());
+        return service;
+    }();
+    return service;
+}
+
+// The fixed cost every command pays before doing any work: creating and destroying its
+// OperationContext, with its decorations, Locker and RecoveryUnit, and the CurOp and OpDebug it
+// reports through.
+void BM_OperationContextLifetime(benchmark::State& state) {
+    auto client = serviceContextWithStorage()->makeClient("BM_OperationContextLifetime");
+    for (auto _ : state) {
+        auto opCtx = client->makeOperationContext();
+        benchmark::DoNotOptimize(&CurOp::get(opCtx.get())->debug());
+    }
+}
+
+void BM_Ping(benchmark::State& state) {
+    auto client = serviceContextWithStorage()->makeClient("BM_Ping");
+    auto command = CommandHelpers::findCommand("ping");
+    const auto request = OpMsgRequest::fromDBAndBody("admin", BSON("ping" << 1));
+    for (auto _ : state) {
+        auto opCtx = client->makeOperationContext();
+        auto invocation = command->parse(opCtx.get(), request);
+        rpc::OpMsgReplyBuilder replyBuilder;
+        invocation->run(opCtx.get(), &replyBuilder);
+        benchmark::DoNotOptimize(replyBuilder.releaseBody());
+    }
+}
+
 BENCHMARK(BM_IsGeneric)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsRequestStripArgument)->DenseRange(0, keys.size() - 1);
 BENCHMARK(BM_IsReplyStripArgument)->DenseRange(0, keys.size() - 1);
+BENCHMARK(BM_OperationContextLifetime);
+BENCHMARK(BM_Ping);
 
 }  // namespace
 }  // namespace mongo
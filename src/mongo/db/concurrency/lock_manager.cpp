@@ -414,8 +414,10 @@ void LockHead::migratePartitionedLockHeads() {
 const unsigned LockManager::_numLockBuckets(128);
 
 // Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// The exact value doesn't appear very important, but should be power of two. A conflicting
+// request only migrates the partitions that actually hold the resource, so this cost is bounded
+// by the number of concurrent intent lockers rather than by the number of partitions.
+const unsigned LockManager::_numPartitions = 64;
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -444,8 +446,8 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
 }
 
 LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+    _lockBuckets = new CacheAligned<LockBucket>[_numLockBuckets];
+    _partitions = new CacheAligned<Partition>[_numPartitions];
 }
 
 LockManager::~LockManager() {
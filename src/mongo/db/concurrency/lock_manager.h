@@ -44,6 +44,7 @@
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -216,10 +217,12 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
+    // Buckets and partitions are each locked by many threads at once, so each gets its own cache
+    // line to keep acquiring one from invalidating its neighbours.
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    CacheAligned<LockBucket>* _lockBuckets;
 
     static const unsigned _numPartitions;
-    Partition* _partitions;
+    CacheAligned<Partition>* _partitions;
 };
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/logv2/log.h"
@@ -48,8 +49,10 @@
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/latency_histogram.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -106,7 +109,9 @@ private:
         AtomicLockStats stats;
     };
 
-    enum { NumPartitions = 8 };
+    // Every lock acquisition increments counters here, so use as many partitions as the lock
+    // manager has for intent locks to keep lockers on different cores from sharing counters.
+    enum { NumPartitions = 32 };
 
 
     AtomicLockStats& _get(LockerId id) {
@@ -268,6 +273,9 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+
+// Time spent queued for a ticket by the operations that had to acquire one.
+LatencyHistogram ticketWaitHistogram("ticketWait");
 }  // namespace
 
 
@@ -310,6 +318,25 @@ LockerImpl::~LockerImpl() {
     _stats.reset();
 }
 
+void LockerImpl::resetForReuse() {
+    invariant(!inAWriteUnitOfWork());
+    invariant(_numResourcesToUnlockAtEndUnitOfWork == 0);
+    invariant(_requests.empty());
+    invariant(_modeForTicket == MODE_NONE);
+    invariant(_uninterruptibleLocksRequested == 0);
+
+    _resetSettings();
+    _stats.reset();
+    _clientState.store(kInactive);
+    _threadId = stdx::this_thread::get_id();
+    _sharedLocksShouldTwoPhaseLock = false;
+    _maxLockTimeout = boost::none;
+    _flowControlStats = FlowControlTicketholder::CurOp();
+    _globalLockMode = (1 << MODE_NONE);
+    _wasGlobalLockTakenInModeConflictingWithWrites.store(false);
+    _waitingResource = ResourceId();
+}
+
 Locker::ClientState LockerImpl::getClientState() const {
     auto state = _clientState.load();
     if (state == kActiveReader && hasLockPending())
@@ -360,11 +387,17 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        OperationTrace::Span waitSpan(opCtx, "ticketWait"_sd);
+        if (OperationTrace::get(opCtx)) {
+            waitSpan.setAttributes(BSON("mode" << modeName(mode)));
+        }
+        Timer waitTimer;
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, getAdmissionPriority());
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, getAdmissionPriority())) {
             return false;
         }
+        ticketWaitHistogram.record(Microseconds(waitTimer.micros()));
         restoreStateOnErrorGuard.dismiss();
     }
     _clientState.store(reader ? kActiveReader : kActiveWriter);
@@ -899,6 +932,11 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
         _setWaitingResource(ResourceId());
     });
 
+    OperationTrace::Span waitSpan(opCtx, "lockWait"_sd);
+    if (OperationTrace::get(opCtx)) {
+        waitSpan.setAttributes(BSON("resource" << resId.toString() << "mode" << modeName(mode)));
+    }
+
     // This failpoint is used to time out non-intent locks if they cannot be granted immediately
     // for user operations. Testing-only.
     const bool isUserOperation = opCtx && opCtx->getClient()->isFromUserConnection();
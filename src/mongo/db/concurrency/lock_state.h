@@ -102,6 +102,13 @@ public:
 
     virtual ~LockerImpl();
 
+    /**
+     * Returns this locker to the state of a newly constructed one, owned by the current thread, so
+     * that a later operation of the same client can use it instead of allocating its own. The
+     * locker must not hold any locks or be in a write unit of work. It keeps its identifier.
+     */
+    void resetForReuse();
+
     virtual ClientState getClientState() const;
 
     virtual LockerId getId() const {
@@ -686,6 +686,34 @@ TEST_F(LockerImplTest, DefaultLocker) {
     ASSERT(locker.unlockGlobal());
 }
 
+TEST_F(LockerImplTest, ResetForReuseRestoresDefaults) {
+    LockerImpl locker;
+    const auto id = locker.getId();
+    locker.lockGlobal(MODE_IX);
+    ASSERT(locker.unlockGlobal());
+    locker.setMaxLockTimeout(Milliseconds(10));
+    locker.setSharedLocksShouldTwoPhaseLock(true);
+    locker.setShouldConflictWithSecondaryBatchApplication(false);
+    locker.skipAcquireTicket();
+    locker.setAdmissionPriority(AdmissionPriority::kLow);
+    locker.setDebugInfo("previous operation");
+
+    locker.resetForReuse();
+
+    ASSERT_EQ(id, locker.getId());
+    ASSERT_FALSE(locker.hasMaxLockTimeout());
+    ASSERT(locker.shouldConflictWithSecondaryBatchApplication());
+    ASSERT(locker.shouldAcquireTicket());
+    ASSERT(locker.getAdmissionPriority() == AdmissionPriority::kNormal);
+    ASSERT(locker.getDebugInfo().empty());
+    ASSERT_FALSE(locker.wasGlobalLockTaken());
+    ASSERT_EQ(Locker::kInactive, locker.getClientState());
+
+    Locker::LockerInfo info;
+    locker.getLockerInfo(&info, boost::none);
+    ASSERT_EQ(0, info.stats.get(resourceIdGlobal, MODE_IX).numAcquisitions);
+}
+
 TEST_F(LockerImplTest, SharedLocksShouldTwoPhaseLockIsTrue) {
     // Test that when setSharedLocksShouldTwoPhaseLock is true and we are in a WUOW, unlock on IS
     // and S locks are postponed until endWriteUnitOfWork() is called. Mode IX and X locks always
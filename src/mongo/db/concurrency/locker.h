@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/admission_priority.h"
 
 namespace mongo {
 
@@ -492,6 +493,19 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Sets the priority with which this locker queues for tickets. Must not be changed while a
+     * ticket is held or being waited for.
+     */
+    void setAdmissionPriority(AdmissionPriority priority) {
+        invariant(isNoop() || getClientState() == Locker::ClientState::kInactive);
+        _admissionPriority = priority;
+    }
+
+    AdmissionPriority getAdmissionPriority() const {
+        return _admissionPriority;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -524,6 +538,16 @@ public:
 protected:
     Locker() {}
 
+    /**
+     * Restores the settings that operations may change on a Locker to their defaults.
+     */
+    void _resetSettings() {
+        _shouldConflictWithSecondaryBatchApplication = true;
+        _shouldAcquireTicket = true;
+        _admissionPriority = AdmissionPriority::kNormal;
+        _debugInfo.clear();
+    }
+
     /**
      * The number of callers that are guarding from lock interruptions.
      * When 0, all lock acquisitions are interruptible. When positive, no lock acquisitions are
@@ -540,6 +564,7 @@ protected:
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    AdmissionPriority _admissionPriority = AdmissionPriority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
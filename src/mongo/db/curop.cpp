@@ -36,6 +36,7 @@
 #include "mongo/db/curop.h"
 
 #include <iomanip>
+#include <time.h>
 
 #include "mongo/bson/mutable/document.h"
 #include "mongo/config.h"
@@ -45,10 +46,13 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/db/curop_gen.h"
 #include "mongo/db/json.h"
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/query_stats_store.h"
+#include "mongo/db/stats/top.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
@@ -84,6 +88,20 @@ TimerStats oplogGetMoreStats;
 ServerStatusMetricField<TimerStats> displayBatchesReceived("repl.network.oplogGetMoresProcessed",
                                                            &oplogGetMoreStats);
 
+/**
+ * Returns the CPU time consumed so far by the calling thread, or boost::none if the platform does
+ * not expose a per-thread CPU clock.
+ */
+boost::optional<Microseconds> threadCpuTime() {
+#if defined(__linux__)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return Microseconds(ts.tv_sec * 1000 * 1000 + ts.tv_nsec / 1000);
+    }
+#endif
+    return boost::none;
+}
+
 }  // namespace
 
 BSONObj upconvertQueryEntry(const BSONObj& query,
@@ -350,6 +368,8 @@ CurOp::CurOp(OperationContext* opCtx) : CurOp(opCtx, &_curopStack(opCtx)) {
 
 CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
     _tickSource = SystemTickSource::get();
+    _threadCpuTimeAtStart = threadCpuTime();
+    _threadAtStart = stdx::this_thread::get_id();
 
     if (opCtx) {
         _stack->push(opCtx, this);
@@ -406,7 +426,8 @@ ProgressMeter& CurOp::setProgress_inlock(StringData message,
 }
 
 void CurOp::setNS_inlock(StringData ns) {
-    _ns = ns.toString();
+    // Assign in place so the existing capacity is reused rather than building a temporary.
+    _ns.assign(ns.rawData(), ns.size());
 }
 
 void CurOp::ensureStarted() {
@@ -441,6 +462,27 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     _end = _tickSource->getTicks();
     _debug.executionTime = duration_cast<Microseconds>(elapsedTimeExcludingPauses());
 
+    // The thread CPU clock is only meaningful if the whole operation ran on this thread.
+    if (_threadCpuTimeAtStart && _threadAtStart == stdx::this_thread::get_id()) {
+        if (auto cpuTimeNow = threadCpuTime()) {
+            _debug.cpuTime = *cpuTimeNow - *_threadCpuTimeAtStart;
+        }
+    }
+
+    if (_debug.queryHash) {
+        QueryStatsStore::Metrics metrics;
+        metrics.latency = _debug.executionTime;
+        metrics.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+        metrics.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+        metrics.nreturned = std::max(_debug.nreturned, 0LL);
+        metrics.bytesReturned = std::max(_debug.responseLength, 0);
+        QueryStatsStore::get(opCtx->getServiceContext())
+            .record(_ns,
+                    *_debug.queryHash,
+                    _command ? StringData(_command->getName()) : logicalOpToString(_logicalOp),
+                    metrics);
+    }
+
     const auto executionTimeMillis = durationCount<Milliseconds>(_debug.executionTime);
 
     if (_debug.isReplOplogGetMore) {
@@ -453,47 +495,25 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     std::tie(shouldLogSlowOp, shouldSample) = shouldLogSlowOpWithSampling(
         opCtx, component, Milliseconds(executionTimeMillis), Milliseconds(slowMs));
 
-    if (forceLog || shouldLogSlowOp) {
-        auto lockerInfo = opCtx->lockState()->getLockerInfo(_lockStatsBase);
-        if (_debug.storageStats == nullptr && opCtx->lockState()->wasGlobalLockTaken() &&
-            opCtx->getServiceContext()->getStorageEngine()) {
-            // Do not fetch operation statistics again if we have already got them (for instance,
-            // as a part of stashing the transaction).
-            // Take a lock before calling into the storage engine to prevent racing against a
-            // shutdown. Any operation that used a storage engine would have at-least held a
-            // global lock at one point, hence we limit our lock acquisition to such operations.
-            // We can get here and our lock acquisition be timed out or interrupted, log a
-            // message if that happens.
-            try {
-                // Retrieving storage stats should not be blocked by oplog application.
-                ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
-                    opCtx->lockState());
-                Lock::GlobalLock lk(opCtx,
-                                    MODE_IS,
-                                    Date_t::now() + Milliseconds(500),
-                                    Lock::InterruptBehavior::kLeaveUnlocked);
-                if (lk.isLocked()) {
-                    _debug.storageStats = opCtx->recoveryUnit()->getOperationStatistics();
-                } else {
-                    LOGV2_WARNING_OPTIONS(
-                        20525,
-                        {component},
-                        "Failed to gather storage statistics for {opId} due to {reason}",
-                        "Failed to gather storage statistics for slow operation",
-                        "opId"_attr = opCtx->getOpID(),
-                        "error"_attr = "lock acquire timeout"_sd);
-                }
-            } catch (const ExceptionForCat<ErrorCategory::Interruption>& ex) {
-                LOGV2_WARNING_OPTIONS(
-                    20526,
-                    {component},
-                    "Failed to gather storage statistics for {opId} due to {reason}",
-                    "Failed to gather storage statistics for slow operation",
-                    "opId"_attr = opCtx->getOpID(),
-                    "error"_attr = redact(ex));
-            }
-        }
+    const bool collectStorageStats = gCollectPerOperationStorageStats.load();
+    const bool shouldLog = forceLog || shouldLogSlowOp;
 
+    // Take the lock statistics before gathering storage statistics, which may lock again.
+    boost::optional<Locker::LockerInfo> lockerInfo;
+    if (shouldLog) {
+        lockerInfo = opCtx->lockState()->getLockerInfo(_lockStatsBase);
+    }
+
+    if (shouldLog || collectStorageStats) {
+        _fetchStorageStatsIfNecessary(opCtx, component);
+    }
+
+    if (collectStorageStats && _debug.storageStats) {
+        Top::get(opCtx->getServiceContext())
+            .recordStorageStats(_ns, _debug.storageStats->toBSON());
+    }
+
+    if (shouldLog) {
         // Gets the time spent blocked on prepare conflicts.
         auto prepareConflictDurationMicros =
             PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
@@ -509,6 +529,48 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     return shouldDBProfile(shouldSample);
 }
 
+void CurOp::_fetchStorageStatsIfNecessary(OperationContext* opCtx,
+                                          logv2::LogComponent component) {
+    if (_debug.storageStats == nullptr && opCtx->lockState()->wasGlobalLockTaken() &&
+        opCtx->getServiceContext()->getStorageEngine()) {
+        // Do not fetch operation statistics again if we have already got them (for instance,
+        // as a part of stashing the transaction).
+        // Take a lock before calling into the storage engine to prevent racing against a
+        // shutdown. Any operation that used a storage engine would have at-least held a
+        // global lock at one point, hence we limit our lock acquisition to such operations.
+        // We can get here and our lock acquisition be timed out or interrupted, log a
+        // message if that happens.
+        try {
+            // Retrieving storage stats should not be blocked by oplog application.
+            ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+                opCtx->lockState());
+            Lock::GlobalLock lk(opCtx,
+                                MODE_IS,
+                                Date_t::now() + Milliseconds(500),
+                                Lock::InterruptBehavior::kLeaveUnlocked);
+            if (lk.isLocked()) {
+                _debug.storageStats = opCtx->recoveryUnit()->getOperationStatistics();
+            } else {
+                LOGV2_WARNING_OPTIONS(
+                    20525,
+                    {component},
+                    "Failed to gather storage statistics for {opId} due to {reason}",
+                    "Failed to gather storage statistics for slow operation",
+                    "opId"_attr = opCtx->getOpID(),
+                    "error"_attr = "lock acquire timeout"_sd);
+            }
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>& ex) {
+            LOGV2_WARNING_OPTIONS(
+                20526,
+                {component},
+                "Failed to gather storage statistics for {opId} due to {reason}",
+                "Failed to gather storage statistics for slow operation",
+                "opId"_attr = opCtx->getOpID(),
+                "error"_attr = redact(ex));
+        }
+    }
+}
+
 Command::ReadWriteType CurOp::getReadWriteType() const {
     if (_command) {
         return _command->getReadWriteType();
@@ -846,6 +908,10 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " remoteOpWaitMillis:" << durationCount<Milliseconds>(*remoteOpWaitTime);
     }
 
+    if (cpuTime) {
+        s << " cpuMicros:" << durationCount<Microseconds>(*cpuTime);
+    }
+
     s << " " << durationCount<Milliseconds>(executionTime) << "ms";
 
     return s.str();
@@ -1015,6 +1081,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("remoteOpWaitMillis", durationCount<Milliseconds>(*remoteOpWaitTime));
     }
 
+    if (cpuTime) {
+        pAttrs->add("cpuMicros", durationCount<Microseconds>(*cpuTime));
+    }
+
     pAttrs->add("durationMillis", durationCount<Milliseconds>(executionTime));
 }
 
@@ -1137,6 +1207,10 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("remoteOpWaitMillis", durationCount<Milliseconds>(*remoteOpWaitTime));
     }
 
+    if (cpuTime) {
+        b.appendNumber("cpuMicros", durationCount<Microseconds>(*cpuTime));
+    }
+
     b.appendIntOrLL("millis", durationCount<Milliseconds>(executionTime));
 
     if (!curop.getPlanSummary().empty()) {
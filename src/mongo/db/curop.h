@@ -40,6 +40,7 @@
 #include "mongo/logv2/attribute_storage.h"
 #include "mongo/logv2/log_component.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/time_support.h"
 
@@ -250,6 +251,10 @@ public:
     // Used to track the amount of time spent waiting for a response from remote operations.
     boost::optional<Microseconds> remoteOpWaitTime;
 
+    // CPU time consumed by the thread running the operation. Only set on platforms that can
+    // measure per-thread CPU time, and when the operation did not move between threads.
+    boost::optional<Microseconds> cpuTime;
+
     // Stores additive metrics.
     AdditiveMetrics additiveMetrics;
 
@@ -401,7 +406,7 @@ public:
     /**
      * Gets the name of the namespace on which the current operation operates.
      */
-    std::string getNS() const {
+    const std::string& getNS() const {
         return _ns;
     }
 
@@ -736,6 +741,12 @@ private:
 
     CurOp(OperationContext*, CurOpStack*);
 
+    /**
+     * Gathers the operation's storage engine statistics into '_debug', unless they were already
+     * gathered or the operation never used the storage engine.
+     */
+    void _fetchStorageStatsIfNecessary(OperationContext* opCtx, logv2::LogComponent component);
+
     CurOpStack* _stack;
     CurOp* _parent{nullptr};
     const Command* _command{nullptr};
@@ -753,6 +764,11 @@ private:
     // The cumulative duration for which the timer has been paused.
     Microseconds _totalPausedDuration{0};
 
+    // The CPU time of the thread that created this CurOp, sampled at construction, used to charge
+    // the operation with the CPU time it consumes.
+    boost::optional<Microseconds> _threadCpuTimeAtStart;
+    stdx::thread::id _threadAtStart;
+
     // The elapsedTimeTotal() value at which the remoteOpWait timer was started, or empty if the
     // remoteOpWait timer is not currently running.
     boost::optional<Microseconds> _remoteOpStartTime;
@@ -220,6 +220,24 @@ TEST(CurOpTest, OptionalAdditiveMetricsNotDisplayedIfUninitialized) {
     ASSERT_EQ(reportString, expectedReportString);
 }
 
+TEST(CurOpTest, CpuTimeDisplayedInLogsAndProfilerWhenSet) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    SingleThreadedLockStats ls;
+
+    auto curop = CurOp::get(*opCtx);
+    curop->setGenericOpRequestDetails(
+        opCtx.get(), NamespaceString("myDb.coll"), nullptr, BSON("a" << 3), NetworkOp::dbQuery);
+    curop->debug().cpuTime = Microseconds(1500);
+
+    BSONObjBuilder builder;
+    curop->debug().append(opCtx.get(), ls, {}, builder);
+    ASSERT_EQ(builder.done()["cpuMicros"].numberLong(), 1500);
+
+    std::string reportString = curop->debug().report(opCtx.get(), nullptr);
+    ASSERT_EQ(reportString, "query myDb.coll command: { a: 3 } numYields:0 cpuMicros:1500 0ms");
+}
+
 TEST(CurOpTest, ShouldNotReportFailpointMsgIfNotSet) {
     QueryTestServiceContext serviceContext;
     auto opCtx = serviceContext.makeOperationContext();
@@ -0,0 +1,316 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+#include <gperftools/malloc_hook.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/read_write_concern_defaults.h"
+#include "mongo/db/read_write_concern_defaults_cache_lookup_mock.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+constexpr StringData kDbName = "db_bm"_sd;
+constexpr StringData kCollName = "coll"_sd;
+constexpr StringData kForeignCollName = "foreign"_sd;
+
+constexpr int kNumDocs = 10 * 1000;
+constexpr int kNumGroups = 100;
+constexpr int kRangeSize = 100;
+
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+AtomicWord<long long> allocationCount;
+
+void countAllocation(const void*, size_t) {
+    allocationCount.fetchAndAddRelaxed(1);
+}
+#endif
+
+/**
+ * A mongod on the ephemeralForTest storage engine, which runs commands by handing OP_MSG requests
+ * to ServiceEntryPointMongod as they would arrive from a client. It is shared by all the
+ * benchmarks, which only run on the thread that created it.
+ */
+class DbBenchmarkEnvironment : public ServiceContextMongoDTest {
+public:
+    static DbBenchmarkEnvironment& get() {
+        static auto& environment = *new DbBenchmarkEnvironment();
+        return environment;
+    }
+
+    BSONObj runCommand(BSONObj cmdObj) {
+        auto opCtx = cc().makeOperationContext();
+        const auto request = OpMsgRequest::fromDBAndBody(kDbName, std::move(cmdObj));
+        auto dbResponse = getServiceContext()->getServiceEntryPoint()->handleRequest(
+            opCtx.get(), request.serialize());
+        auto reply = OpMsg::parseOwned(dbResponse.response).body;
+        uassertStatusOK(getStatusFromCommandResult(reply));
+        return reply;
+    }
+
+    /**
+     * Returns a name for a collection which no other benchmark has written to.
+     */
+    std::string makeCollectionName(StringData prefix) {
+        return str::stream() << prefix << "_" << _nextCollectionId++;
+    }
+
+private:
+    DbBenchmarkEnvironment() {
+        setUp();
+
+        auto service = getServiceContext();
+        repl::StorageInterface::set(service, std::make_unique<repl::StorageInterfaceImpl>());
+        auto replCoord = std::make_unique<repl::ReplicationCoordinatorMock>(service);
+        invariant(replCoord->setFollowerMode(repl::MemberState::RS_PRIMARY));
+        repl::ReplicationCoordinator::set(service, std::move(replCoord));
+        ReadWriteConcernDefaults::create(service, _lookupMock.getFetchDefaultsFn());
+
+        _loadData();
+
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+        MallocHook::AddNewHook(countAllocation);
+#endif
+    }
+
+    void _doTest() override {
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Fills the collection the read benchmarks query, whose documents look like
+     * {_id: i, x: i, g: i % kNumGroups, s: "..."} with an index on x, and the collection they
+     * $lookup into, which has a document for each group.
+     */
+    void _loadData() {
+        const std::string padding(64, 'p');
+        constexpr int kBatchSize = 1000;
+        for (int batchStart = 0; batchStart < kNumDocs; batchStart += kBatchSize) {
+            BSONArrayBuilder docs;
+            for (int i = batchStart; i < batchStart + kBatchSize; ++i) {
+                docs.append(
+                    BSON("_id" << i << "x" << i << "g" << i % kNumGroups << "s" << padding));
+            }
+            runCommand(BSON("insert" << kCollName << "documents" << docs.arr()));
+        }
+        runCommand(BSON("createIndexes" << kCollName << "indexes"
+                                        << BSON_ARRAY(BSON("key" << BSON("x" << 1) << "name"
+                                                                 << "x_1"))));
+
+        BSONArrayBuilder groups;
+        for (int g = 0; g < kNumGroups; ++g) {
+            groups.append(
+                BSON("_id" << g << "name" << std::string(str::stream() << "group " << g)));
+        }
+        runCommand(BSON("insert" << kForeignCollName << "documents" << groups.arr()));
+    }
+
+    ReadWriteConcernDefaultsLookupMock _lookupMock;
+    int _nextCollectionId = 0;
+};
+
+/**
+ * Selects the execution engine for the duration of a benchmark run.
+ */
+class ScopedExecutionEngine {
+public:
+    ScopedExecutionEngine(benchmark::State& state, bool sbe)
+        : _wasSbe(internalQueryEnableSlotBasedExecutionEngine.load()) {
+        internalQueryEnableSlotBasedExecutionEngine.store(sbe);
+        state.SetLabel(sbe ? "sbe" : "classic");
+    }
+
+    ~ScopedExecutionEngine() {
+        internalQueryEnableSlotBasedExecutionEngine.store(_wasSbe);
+    }
+
+private:
+    const bool _wasSbe;
+};
+
+/**
+ * Reports each iteration as one operation, and the heap allocations made per operation when the
+ * allocator lets us count them.
+ */
+class OperationCounters {
+public:
+    explicit OperationCounters(benchmark::State& state) : _state(state) {
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+        _startAllocations = allocationCount.load();
+#endif
+    }
+
+    ~OperationCounters() {
+        _state.SetItemsProcessed(_state.iterations());
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+        _state.counters["allocsPerOp"] =
+            benchmark::Counter(static_cast<double>(allocationCount.load() - _startAllocations),
+                               benchmark::Counter::kAvgIterations);
+#endif
+    }
+
+private:
+    benchmark::State& _state;
+#ifdef MONGO_DB_BM_COUNT_ALLOCATIONS
+    long long _startAllocations;
+#endif
+};
+
+void BM_FindById(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    ScopedExecutionEngine engine(state, state.range(0));
+    OperationCounters counters(state);
+
+    int id = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(environment.runCommand(
+            BSON("find" << kCollName << "filter" << BSON("_id" << id) << "singleBatch" << true)));
+        id = (id + 1) % kNumDocs;
+    }
+}
+
+void BM_FindIndexedRange(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    ScopedExecutionEngine engine(state, state.range(0));
+    OperationCounters counters(state);
+
+    int start = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(environment.runCommand(
+            BSON("find" << kCollName << "filter"
+                        << BSON("x" << BSON("$gte" << start << "$lt" << start + kRangeSize))
+                        << "batchSize" << kRangeSize << "singleBatch" << true)));
+        start = (start + kRangeSize) % kNumDocs;
+    }
+}
+
+void BM_AggregateGroup(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    ScopedExecutionEngine engine(state, state.range(0));
+    OperationCounters counters(state);
+
+    const auto pipeline =
+        BSON_ARRAY(BSON("$group" << BSON("_id"
+                                         << "$g"
+                                         << "total" << BSON("$sum"
+                                                            << "$x"))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(environment.runCommand(
+            BSON("aggregate" << kCollName << "pipeline" << pipeline << "cursor"
+                             << BSON("batchSize" << kNumGroups))));
+    }
+}
+
+void BM_AggregateLookup(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    ScopedExecutionEngine engine(state, state.range(0));
+    OperationCounters counters(state);
+
+    const auto pipeline = BSON_ARRAY(
+        BSON("$match" << BSON("x" << BSON("$lt" << kRangeSize)))
+        << BSON("$lookup" << BSON("from" << kForeignCollName << "localField"
+                                         << "g"
+                                         << "foreignField"
+                                         << "_id"
+                                         << "as"
+                                         << "group")));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(environment.runCommand(
+            BSON("aggregate" << kCollName << "pipeline" << pipeline << "cursor"
+                             << BSON("batchSize" << kRangeSize))));
+    }
+}
+
+void BM_InsertBatch(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    const auto collName = environment.makeCollectionName("insert");
+    const int batchSize = state.range(0);
+    const std::string padding(state.range(1), 'p');
+    OperationCounters counters(state);
+
+    int nextId = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        BSONArrayBuilder docs;
+        for (int i = 0; i < batchSize; ++i, ++nextId) {
+            docs.append(BSON("_id" << nextId << "x" << nextId << "s" << padding));
+        }
+        auto cmdObj = BSON("insert" << collName << "documents" << docs.arr());
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(environment.runCommand(std::move(cmdObj)));
+    }
+    state.counters["docsPerSecond"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * batchSize, benchmark::Counter::kIsRate);
+}
+
+void BM_UpdateMany(benchmark::State& state) {
+    auto& environment = DbBenchmarkEnvironment::get();
+    OperationCounters counters(state);
+
+    int group = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(environment.runCommand(BSON(
+            "update" << kCollName << "updates"
+                     << BSON_ARRAY(BSON("q" << BSON("g" << group) << "u"
+                                            << BSON("$inc" << BSON("n" << 1)) << "multi"
+                                            << true)))));
+        group = (group + 1) % kNumGroups;
+    }
+}
+
+// The argument of the read benchmarks selects the classic (0) or slot-based (1) engine.
+BENCHMARK(BM_FindById)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindIndexedRange)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateGroup)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateLookup)->Arg(0)->Arg(1);
+// The arguments of the insert benchmark are the number of documents per batch and the size of
+// their padding, which makes the 1024 byte variant insert documents of about 1KB.
+BENCHMARK(BM_InsertBatch)->Args({1, 64})->Args({10, 64})->Args({100, 64})->Args({1000, 1024});
+BENCHMARK(BM_UpdateMany);
+
+}  // namespace
+}  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/db_raii.h"
 
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii_gen.h"
@@ -53,6 +54,48 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
     OperationContext::declareDecoration<boost::optional<bool>>();
 
+// Number of reads at lastApplied that found pending catalog changes on their collection and
+// waited for batch application to make them visible.
+Counter64 secondaryReadsWaitedForBatchApplication;
+ServerStatusMetricField<Counter64> displaySecondaryReadsWaitedForBatchApplication(
+    "repl.secondaryReads.waitedForBatchApplication", &secondaryReadsWaitedForBatchApplication);
+
+// Number of reads at lastApplied that gave up waiting and took the PBWM lock, blocking on and
+// blocking batch application.
+Counter64 secondaryReadsConflictedWithBatchApplication;
+ServerStatusMetricField<Counter64> displaySecondaryReadsConflictedWithBatchApplication(
+    "repl.secondaryReads.conflictedWithBatchApplication",
+    &secondaryReadsConflictedWithBatchApplication);
+
+/**
+ * Waits, for at most 'secondaryReadWaitForPendingCatalogChangesMillis' and until 'deadline',
+ * for lastApplied to reach 'minSnapshot'. Returns false without waiting if the caller holds locks
+ * or this node is not a replica set member.
+ */
+bool waitForLastAppliedToReach(OperationContext* opCtx,
+                               repl::ReplicationCoordinator* replCoord,
+                               const Timestamp& minSnapshot,
+                               Date_t deadline) {
+    const auto maxWait = Milliseconds(gSecondaryReadWaitForPendingCatalogChangesMillis.load());
+    if (maxWait <= Milliseconds(0) || opCtx->lockState()->isLocked() ||
+        replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return false;
+    }
+
+    const auto waitDeadline =
+        std::min(deadline, opCtx->getServiceContext()->getFastClockSource()->now() + maxWait);
+    const repl::ReadConcernArgs waitArgs(LogicalTime(minSnapshot),
+                                         repl::ReadConcernLevel::kLocalReadConcern);
+    auto status = replCoord->waitUntilOpTimeForReadUntil(opCtx, waitArgs, waitDeadline);
+    if (!status.isOK()) {
+        // Timing out at 'waitDeadline' falls back to conflicting with batch application, but an
+        // interrupted operation must not go on to read.
+        opCtx->checkForInterrupt();
+        return false;
+    }
+    return true;
+}
+
 }  // namespace
 
 AutoStatsTracker::AutoStatsTracker(OperationContext* opCtx,
@@ -108,6 +151,10 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
     repl::ReplicationCoordinator* const replCoord = repl::ReplicationCoordinator::get(opCtx);
     const auto readConcernLevel = repl::ReadConcernArgs::get(opCtx).getLevel();
 
+    // Whether we have already waited for lastApplied to pass pending catalog changes. We only wait
+    // once, so that a kNoOverlap reader whose all_durable timestamp lags does not spin.
+    bool waitedForLastApplied = false;
+
     // If the collection doesn't exist or disappears after releasing locks and waiting, there is no
     // need to check for pending catalog changes.
     while (auto coll = _autoColl->getCollection()) {
@@ -196,6 +243,29 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
         if (readSource == RecoveryUnit::ReadSource::kLastApplied ||
             readSource == RecoveryUnit::ReadSource::kNoOverlap) {
             invariant(readTimestamp);
+
+            // The pending catalog changes usually belong to the batch being applied, so first
+            // wait for that batch to move lastApplied past them. Unlike taking the PBWM lock,
+            // this does not keep the next batch from starting for the duration of our read.
+            if (_shouldNotConflictWithSecondaryBatchApplicationBlock && !waitedForLastApplied &&
+                waitForLastAppliedToReach(opCtx, replCoord, *minSnapshot, deadline)) {
+                waitedForLastApplied = true;
+                secondaryReadsWaitedForBatchApplication.increment();
+                LOGV2_DEBUG(5153000,
+                            1,
+                            "Waited for pending catalog changes to be applied before reading",
+                            "readTimestamp"_attr = *readTimestamp,
+                            "collection"_attr = nss.ns(),
+                            "collectionMinSnapshot"_attr = *minSnapshot);
+                opCtx->recoveryUnit()->abandonSnapshot();
+                {
+                    stdx::lock_guard<Client> lk(*opCtx->getClient());
+                    CurOp::get(opCtx)->yielded();
+                }
+                _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+                continue;
+            }
+
             LOGV2(20576,
                   "Tried reading at a timestamp, but future catalog changes are pending. "
                   "Trying again without reading at a timestamp",
@@ -206,6 +276,9 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             // previous value. If the previous value is false (because there is another
             // shouldNotConflictWithSecondaryBatchApplicationBlock outside of this function), this
             // does not take the PBWM lock.
+            if (_shouldNotConflictWithSecondaryBatchApplicationBlock) {
+                secondaryReadsConflictedWithBatchApplication.increment();
+            }
             _shouldNotConflictWithSecondaryBatchApplicationBlock = boost::none;
 
             // As alluded to above, if we are AutoGetting multiple collections, it
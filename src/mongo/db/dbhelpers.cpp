@@ -33,6 +33,7 @@
 
 #include "mongo/db/dbhelpers.h"
 
+#include "mongo/db/catalog/clustered_collection_util.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/btree_access_method.h"
@@ -138,16 +139,14 @@ bool Helpers::findById(OperationContext* opCtx,
     if (nsFound)
         *nsFound = true;
 
-    IndexCatalog* catalog = collection->getIndexCatalog();
-    const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
-
-    if (!desc)
+    // A clustered collection answers the lookup as authoritatively as an _id index would.
+    if (!collection->isClustered() && !collection->getIndexCatalog()->findIdIndex(opCtx))
         return false;
 
     if (indexFound)
         *indexFound = 1;
 
-    RecordId loc = catalog->getEntry(desc)->accessMethod()->findSingle(opCtx, query["_id"].wrap());
+    RecordId loc = findById(opCtx, collection, query);
     if (loc.isNull())
         return false;
     result = collection->docFor(opCtx, loc).value();
@@ -158,6 +157,14 @@ RecordId Helpers::findById(OperationContext* opCtx,
                            Collection* collection,
                            const BSONObj& idquery) {
     verify(collection);
+    if (collection->isClustered()) {
+        auto loc = clustered_util::recordIdForId(idquery["_id"]);
+        RecordData unused;
+        if (!loc || !collection->getRecordStore()->findRecord(opCtx, *loc, &unused))
+            return RecordId();
+        return *loc;
+    }
+
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
     uassert(13430, "no _id index", desc);
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -65,6 +66,10 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
       _params(params) {
+    if (_filter && internalQueryCompileMatchExpressions.load()) {
+        _compiledFilter = CompiledMatcher::compile(_filter);
+    }
+
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
     _specificStats.minTs = params.minTs;
@@ -78,6 +83,9 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         invariant(!params.resumeAfterRecordId);
     }
     invariant(!_params.shouldTrackLatestOplogTimestamp || collection->ns().isOplog());
+    invariant(!_params.shouldUseOplogTailCache ||
+              (params.tailable && params.direction == CollectionScanParams::FORWARD &&
+               collection->ns().isOplog()));
 
     if (params.resumeAfterRecordId) {
         // The 'resumeAfterRecordId' parameter is used for resumable collection scans, which we
@@ -98,6 +106,14 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_params.shouldUseOplogTailCache && !_lastSeenId.isNull()) {
+        if (auto cached = nextFromOplogTailCache()) {
+            // The storage engine cursor must seek past this entry before it is used again.
+            _cursor.reset();
+            return returnRecord(cached->id, std::move(cached->obj), out);
+        }
+    }
+
     boost::optional<Record> record;
     const bool needToMakeCursor = !_cursor;
     try {
@@ -199,15 +215,39 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    _lastSeenId = record->id;
+    if (_params.shouldUseOplogTailCache) {
+        // Copy the entry once, for both the working set and the other readers of the oplog.
+        record->data = record->data.getOwned();
+        OplogTailCache::get(opCtx()).append(_lastSeenId,
+                                            record->id,
+                                            record->data.toBson(),
+                                            internalQueryOplogTailCacheMaxBytes.load());
+    }
+
+    return returnRecord(record->id, record->data.releaseToBson(), out);
+}
+
+boost::optional<OplogTailCache::Entry> CollectionScan::nextFromOplogTailCache() {
+    // A scan at a read timestamp, such as the majority commit point, must not see later entries.
+    // Oplog RecordIds are the timestamps of their entries.
+    const auto readTimestamp = opCtx()->recoveryUnit()->getPointInTimeReadTimestamp();
+    const RecordId maxId = readTimestamp ? RecordId(readTimestamp->asULL()) : RecordId::max();
+
+    return OplogTailCache::get(opCtx()).next(_lastSeenId, maxId);
+}
+
+PlanStage::StageState CollectionScan::returnRecord(const RecordId& recordId,
+                                                   BSONObj obj,
+                                                   WorkingSetID* out) {
+    _lastSeenId = recordId;
     if (_params.shouldTrackLatestOplogTimestamp) {
-        setLatestOplogEntryTimestamp(*record);
+        setLatestOplogEntryTimestamp(Record{recordId, RecordData(obj.objdata(), obj.objsize())});
     }
 
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), std::move(obj));
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
@@ -227,9 +267,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
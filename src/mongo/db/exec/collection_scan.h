@@ -32,7 +32,9 @@
 #include <memory>
 
 #include "mongo/db/exec/collection_scan_common.h"
+#include "mongo/db/exec/oplog_tail_cache.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/matcher/compiled_matcher.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -100,12 +102,27 @@ private:
      */
     void setLatestOplogEntryTimestamp(const Record& record);
 
+    /**
+     * Returns the oplog entry after '_lastSeenId' from the OplogTailCache, if it is there and is
+     * visible at this operation's read timestamp.
+     */
+    boost::optional<OplogTailCache::Entry> nextFromOplogTailCache();
+
+    /**
+     * Makes the record 'obj' with RecordId 'recordId' the scan's position and puts it in the
+     * working set, returning it through returnIfMatches().
+     */
+    StageState returnRecord(const RecordId& recordId, BSONObj obj, WorkingSetID* out);
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Evaluates '_filter', if enabled by 'internalQueryCompileMatchExpressions' and worthwhile.
+    std::unique_ptr<CompiledMatcher> _compiledFilter;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -77,6 +77,10 @@ struct CollectionScanParams {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // Whether a forward, tailable scan of the oplog should take the entries after its position
+    // from the OplogTailCache when they are there, and add those it reads itself.
+    bool shouldUseOplogTailCache = false;
 };
 
 }  // namespace mongo
@@ -31,7 +31,7 @@
 
 #include "mongo/db/exec/document_value/document.h"
 
-#include <boost/functional/hash.hpp>
+#include <absl/hash/internal/city.h>
 
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/jsobj.h"
@@ -118,7 +118,7 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
             _it = nullptr;
         }
     } else if (!atEnd()) {
-        if (_it->val.missing() || _it->kind == ValueElement::Kind::kCached) {
+        if (_it->val.missing() || _it->hasBsonImage()) {
             return true;
         }
     }
@@ -174,7 +174,7 @@ Position DocumentStorage::constructInCache(const BSONElement& elem) {
     auto savedModified = _modified;
     auto pos = getNextPosition();
     const auto fieldName = elem.fieldNameStringData();
-    appendField(fieldName, ValueElement::Kind::kCached) = Value(elem);
+    appendField(fieldName, ValueElement::Kind::kCachedUnmodified) = Value(elem);
     _modified = savedModified;
 
     return pos;
@@ -208,7 +208,7 @@ Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
 #undef append
 
     // Make sure next field starts where we expect it
-    fassert(16486, getField(pos).next()->ptr() == _cache + _usedBytes);
+    fassert(16486, elementAt(pos).next()->ptr() == _cache + _usedBytes);
 
     _numFields++;
 
@@ -219,12 +219,13 @@ Value& DocumentStorage::appendField(StringData name, ValueElement::Kind kind) {
         rehash();
     }
 
-    return getField(pos).val;
+    _modified = true;
+    return elementAt(pos).val;
 }
 
 // Call after adding field to _fields and increasing _numFields
 void DocumentStorage::addFieldToHashTable(Position pos) {
-    ValueElement& elem = getField(pos);
+    ValueElement& elem = elementAt(pos);
     elem.nextCollision = Position();
 
     const unsigned bucket = bucketForKey(elem.nameSD());
@@ -232,7 +233,7 @@ void DocumentStorage::addFieldToHashTable(Position pos) {
     Position* posPtr = &_hashTab[bucket];
     while (posPtr->found()) {
         // collision: walk links and add new to end
-        posPtr = &getField(*posPtr).nextCollision;
+        posPtr = &elementAt(*posPtr).nextCollision;
     }
     *posPtr = Position(pos.index);
 }
@@ -435,8 +436,18 @@ void Document::toBson(BSONObjBuilder* builder, size_t recursionLevel) const {
                           << BSONDepth::getMaxAllowableDepth() << " levels of nesting",
             recursionLevel <= BSONDepth::getMaxAllowableDepth());
 
+    // An unmodified document can be copied from its backing BSON wholesale.
+    if (!storage().isModified() && !storage().stripMetadata()) {
+        builder->appendElements(storage().bsonObj());
+        return;
+    }
+
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
-        if (auto cached = it.cachedValue()) {
+        auto cached = it.cachedValue();
+        // While walking the backing BSON, a cached value which has not been modified since it was
+        // loaded is the same as the current BSON element, which is cheaper to copy.
+        if (cached &&
+            (!it.bsonIter().more() || cached->kind != ValueElement::Kind::kCachedUnmodified)) {
             cached->val.addToBsonObj(builder, cached->nameSD(), recursionLevel);
         } else {
             builder->append(*it.bsonIter());
@@ -665,7 +676,7 @@ void Document::hash_combine(size_t& seed,
                             const StringData::ComparatorInterface* stringComparator) const {
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
         StringData name = it->nameSD();
-        boost::hash_range(seed, name.rawData(), name.rawData() + name.size());
+        seed = absl::hash_internal::CityHash64WithSeed(name.rawData(), name.size(), seed);
         it->val.hash_combine(seed, stringComparator);
     }
 }
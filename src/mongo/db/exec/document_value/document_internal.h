@@ -90,9 +90,20 @@ public:
         // The value has the image in the underlying BSON.
         kCached,
         // The value has been opportunistically inserted into the cache without checking the BSON.
-        kMaybeInserted
+        kMaybeInserted,
+        // The value has the image in the underlying BSON and has not been modified since it was
+        // loaded from there, so the BSON element can be used in its place.
+        kCachedUnmodified
     };
 
+    /**
+     * Returns true if this value has an image in the underlying BSON, whether or not it has since
+     * been modified.
+     */
+    bool hasBsonImage() const {
+        return kind == Kind::kCached || kind == Kind::kCachedUnmodified;
+    }
+
     Value val;
     Position nextCollision;  // Position of next field with same hashBucket
     const int nameLen;       // doesn't include '\0'
@@ -343,7 +354,12 @@ public:
     ValueElement& getField(Position pos) {
         _modified = true;
         verify(pos.found());
-        return *(_firstElement->plusBytes(pos.index));
+        auto& elem = *(_firstElement->plusBytes(pos.index));
+        // The caller may modify the value, so it can no longer stand in for its BSON image.
+        if (elem.kind == ValueElement::Kind::kCachedUnmodified) {
+            elem.kind = ValueElement::Kind::kCached;
+        }
+        return elem;
     }
     Value& getField(StringData name, LookupPolicy policy) {
         _modified = true;
@@ -496,6 +512,12 @@ private:
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
 
+    /// Returns the element at 'pos' for internal bookkeeping, without marking it as modified.
+    ValueElement& elementAt(Position pos) {
+        verify(pos.found());
+        return *(_firstElement->plusBytes(pos.index));
+    }
+
     /// Allocates space in _cache. Copies existing data if there is any.
     void alloc(unsigned newSize);
 
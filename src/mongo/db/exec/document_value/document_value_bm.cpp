@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+
+namespace mongo {
+namespace {
+
+void BM_hashStringValue(benchmark::State& state) {
+    Value value(std::string(state.range(0), 'x'));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ValueComparator::kInstance.hash(value));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_hashDocumentValue(benchmark::State& state) {
+    // A compound group key such as {_id: {customerId: ..., region: ..., day: ...}}.
+    MutableDocument doc;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        doc.addField("groupKeyField" + std::to_string(i),
+                     i % 2 ? Value(static_cast<long long>(i)) : Value("string value"_sd));
+    }
+    Value value(doc.freeze());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ValueComparator::kInstance.hash(value));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_groupStringKeys(benchmark::State& state) {
+    std::vector<Value> keys;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        keys.emplace_back("customer-" + std::to_string(i));
+    }
+    for (auto _ : state) {
+        auto groups = ValueComparator::kInstance.makeUnorderedValueMap<int>();
+        for (const auto& key : keys) {
+            ++groups[key];
+        }
+        benchmark::DoNotOptimize(groups.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_hashStringValue)->Range(1, 1024);
+BENCHMARK(BM_hashDocumentValue)->Range(1, 64);
+BENCHMARK(BM_groupStringKeys)->Range(16, 100'000);
+
+}  // namespace
+}  // namespace mongo
@@ -176,6 +176,33 @@ TEST(DocumentSerialization, CannotSerializeDocumentThatExceedsDepthLimit) {
     throwaway.abandon();
 }
 
+TEST(DocumentSerialization, ModifyingFewFieldsOfBsonBackedDocumentPreservesTheRest) {
+    BSONObj bson = BSON("a" << 1 << "b" << BSON("c" << 2 << "d" << BSON_ARRAY(3 << 4)) << "e"
+                            << "str"
+                            << "f" << 5.5);
+    Document document = fromBson(bson);
+
+    // Load 'b' and 'e' into the cache without modifying them.
+    ASSERT_EQ(document["b"]["c"].getInt(), 2);
+    ASSERT_EQ(document["e"].getString(), "str");
+    ASSERT_BSONOBJ_EQ(document.toBson(), bson);
+
+    MutableDocument md(document);
+    md.setField("a", Value(10));
+    md.setField("g", Value(6));
+    md.setNestedField(FieldPath("b.c"), Value(20));
+    md.remove("f");
+    Document modified = md.freeze();
+
+    ASSERT_BSONOBJ_EQ(modified.toBson(),
+                      BSON("a" << 10 << "b" << BSON("c" << 20 << "d" << BSON_ARRAY(3 << 4)) << "e"
+                               << "str"
+                               << "g" << 6));
+
+    // The original document is unaffected.
+    ASSERT_BSONOBJ_EQ(document.toBson(), bson);
+}
+
 TEST(DocumentGetFieldNonCaching, UncachedTopLevelFields) {
     BSONObj bson = BSON("scalar" << 1 << "array" << BSON_ARRAY(1 << 2 << 3) << "scalar2" << true);
     Document document = fromBson(bson);
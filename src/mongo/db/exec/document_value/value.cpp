@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/document_value/value.h"
 
+#include <absl/hash/internal/city.h>
 #include <boost/functional/hash.hpp>
 #include <cmath>
 #include <limits>
@@ -926,7 +927,7 @@ void Value::hash_combine(size_t& seed,
         case Code:
         case Symbol: {
             StringData sd = getRawData();
-            MurmurHash3_x86_32(sd.rawData(), sd.size(), seed, &seed);
+            seed = absl::hash_internal::CityHash64WithSeed(sd.rawData(), sd.size(), seed);
             break;
         }
 
@@ -935,7 +936,7 @@ void Value::hash_combine(size_t& seed,
             if (stringComparator) {
                 stringComparator->hash_combine(seed, sd);
             } else {
-                MurmurHash3_x86_32(sd.rawData(), sd.size(), seed, &seed);
+                seed = absl::hash_internal::CityHash64WithSeed(sd.rawData(), sd.size(), seed);
             }
             break;
         }
@@ -959,14 +960,14 @@ void Value::hash_combine(size_t& seed,
 
         case BinData: {
             StringData sd = getRawData();
-            MurmurHash3_x86_32(sd.rawData(), sd.size(), seed, &seed);
+            seed = absl::hash_internal::CityHash64WithSeed(sd.rawData(), sd.size(), seed);
             boost::hash_combine(seed, _storage.binDataType());
             break;
         }
 
         case RegEx: {
             StringData sd = getRawData();
-            MurmurHash3_x86_32(sd.rawData(), sd.size(), seed, &seed);
+            seed = absl::hash_internal::CityHash64WithSeed(sd.rawData(), sd.size(), seed);
             break;
         }
 
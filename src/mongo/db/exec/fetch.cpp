@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -38,7 +39,9 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -57,7 +60,11 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _readAheadWindow(static_cast<size_t>(internalQueryFetchReadAheadWindow.load())) {
+    if (_filter && internalQueryCompileMatchExpressions.load()) {
+        _compiledFilter = CompiledMatcher::compile(_filter);
+    }
     _children.emplace_back(std::move(child));
 }
 
@@ -69,14 +76,28 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_readAheadPending.empty() || !_readAheadReady.empty()) {
+        // There are buffered members which have not been returned yet.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
+void FetchStage::ensureCursor() {
+    if (!_cursor)
+        _cursor = collection()->getCursor(opCtx());
+}
+
 PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     if (isEOF()) {
         return PlanStage::IS_EOF;
     }
 
+    if (_readAheadWindow > 1) {
+        return doWorkWithReadAhead(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -100,8 +121,7 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
             verify(member->hasRecordId());
 
             try {
-                if (!_cursor)
-                    _cursor = collection()->getCursor(opCtx());
+                ensureCursor();
 
                 if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor, collection()->ns())) {
                     _ws->free(id);
@@ -125,6 +145,96 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkWithReadAhead(WorkingSetID* out) {
+    if (!_readAheadReady.empty()) {
+        WorkingSetID id = _readAheadReady.front();
+        _readAheadReady.pop_front();
+        return returnIfMatches(_ws->get(id), id, out);
+    }
+
+    // Keep pulling from the child until the window is full or the child is exhausted.
+    if (_readAheadPending.size() < _readAheadWindow && !child()->isEOF()) {
+        WorkingSetID id;
+        StageState status = child()->work(&id);
+        if (PlanStage::ADVANCED == status) {
+            WorkingSetMember* member = _ws->get(id);
+            if (member->hasObj()) {
+                ++_specificStats.alreadyHasObj;
+            } else {
+                // We need a valid RecordId to fetch from and this is the only state that has one.
+                verify(WorkingSetMember::RID_AND_IDX == member->getState());
+                verify(member->hasRecordId());
+            }
+            _readAheadPending.push_back(id);
+            return NEED_TIME;
+        } else if (PlanStage::NEED_YIELD == status) {
+            *out = id;
+            return status;
+        } else if (PlanStage::IS_EOF != status) {
+            return status;
+        }
+    }
+
+    try {
+        fetchReadAheadWindow();
+    } catch (const WriteConflictException&) {
+        // Ensure that the BSONObjs underlying the buffered members are owned because they may be
+        // freed when we yield.
+        for (auto id : _readAheadPending) {
+            _ws->get(id)->makeObjOwnedIfNeeded();
+        }
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    _readAheadReady.swap(_readAheadPending);
+    return NEED_TIME;
+}
+
+void FetchStage::fetchReadAheadWindow() {
+    std::vector<WorkingSetID> toFetch;
+    toFetch.reserve(_readAheadPending.size());
+    for (auto id : _readAheadPending) {
+        if (!_ws->get(id)->hasObj()) {
+            toFetch.push_back(id);
+        }
+    }
+    if (toFetch.empty()) {
+        return;
+    }
+
+    std::sort(toFetch.begin(), toFetch.end(), [this](WorkingSetID lhs, WorkingSetID rhs) {
+        return _ws->get(lhs)->recordId < _ws->get(rhs)->recordId;
+    });
+
+    ensureCursor();
+
+    // Drop the members whose records were deleted from the window, including when a write
+    // conflict interrupts the batch, so that a retry never touches a freed member.
+    bool anyDeleted = false;
+    auto removeDeleted = makeGuard([&] {
+        if (anyDeleted) {
+            _readAheadPending.erase(
+                std::remove_if(_readAheadPending.begin(),
+                               _readAheadPending.end(),
+                               [this](WorkingSetID id) { return _ws->isFree(id); }),
+                _readAheadPending.end());
+        }
+    });
+
+    for (auto id : toFetch) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor, collection()->ns())) {
+            _ws->free(id);
+            anyDeleted = true;
+            continue;
+        }
+        // Later seeks reposition the cursor, so each document must be copied out of the storage
+        // engine's buffer before the next record in the window is read.
+        member->makeObjOwnedIfNeeded();
+    }
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
@@ -167,7 +277,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
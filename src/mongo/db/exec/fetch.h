@@ -29,10 +29,12 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/compiled_matcher.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 
@@ -46,6 +48,11 @@ class SeekableRecordCursor;
  * In WorkingSetMember terms, it transitions from RID_AND_IDX to RID_AND_OBJ by reading
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
+ * When 'internalQueryFetchReadAheadWindow' is greater than one, the stage buffers up to that many
+ * results from its child and reads the records for the whole window in RecordId order, so that
+ * records which are adjacent on disk are read together rather than in index order. Results are
+ * still returned in the order in which the child produced them.
+ *
  * Preconditions: Valid RecordId.
  */
 class FetchStage : public RequiresCollectionStage {
@@ -86,6 +93,23 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Implementation of doWork() used when read-ahead is enabled. Fills '_readAheadPending' from
+     * the child, fetches the buffered records in RecordId order, and then returns them one at a
+     * time from '_readAheadReady'.
+     */
+    StageState doWorkWithReadAhead(WorkingSetID* out);
+
+    /**
+     * Fetches every buffered member of '_readAheadPending' which does not yet have an object,
+     * visiting them in RecordId order. Members whose records have been deleted are freed and
+     * dropped from the window. Throws WriteConflictException, in which case the members fetched
+     * so far retain their (owned) documents and the remainder are fetched on the next call.
+     */
+    void fetchReadAheadWindow();
+
+    void ensureCursor();
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -95,9 +119,22 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Evaluates '_filter', if enabled by 'internalQueryCompileMatchExpressions' and worthwhile.
+    std::unique_ptr<CompiledMatcher> _compiledFilter;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The read-ahead window size, sampled from 'internalQueryFetchReadAheadWindow' at construction.
+    const size_t _readAheadWindow;
+
+    // Members produced by the child which have not been fetched yet, in the child's order.
+    std::deque<WorkingSetID> _readAheadPending;
+
+    // Members whose documents have been fetched and which are waiting to be returned, in the
+    // child's order.
+    std::deque<WorkingSetID> _readAheadReady;
+
     // Stats
     FetchStats _specificStats;
 };
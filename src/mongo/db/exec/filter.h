@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/compiled_matcher.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/matchable.h"
 
@@ -159,6 +160,19 @@ public:
         return filter->matches(&doc, nullptr);
     }
 
+    /**
+     * Same as above, but evaluates the filter with 'compiledFilter', which must have been compiled
+     * from 'filter', when it is non-null and 'wsm' has a document.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       const CompiledMatcher* compiledFilter) {
+        if (compiledFilter && wsm->hasObj()) {
+            return compiledFilter->matches(wsm->doc.value().toBson());
+        }
+        return passes(wsm, filter);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
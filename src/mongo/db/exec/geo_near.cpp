@@ -760,6 +760,30 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+std::vector<S2CellId> getAnnulusCovering(OperationContext* opCtx,
+                                         const R2Annulus& annulus,
+                                         const S2Region& region) {
+    if (!gInternalQueryGeoNearUseCoveringCache.load()) {
+        return ExpressionMapping::get2dsphereCovering(region);
+    }
+
+    const GeoNearCoveringCache::CoveringKey key{annulus.center().x,
+                                                annulus.center().y,
+                                                annulus.getInner(),
+                                                annulus.getOuter(),
+                                                gInternalQueryS2GeoCoarsestLevel.load(),
+                                                gInternalQueryS2GeoFinestLevel.load(),
+                                                gInternalQueryS2GeoMaxCells.load()};
+    auto& cache = GeoNearCoveringCache::get(opCtx);
+    if (auto cover = cache.getCovering(key)) {
+        return std::move(*cover);
+    }
+
+    auto cover = ExpressionMapping::get2dsphereCovering(region);
+    cache.putCovering(key, cover);
+    return cover;
+}
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const Collection* collection,
@@ -888,9 +912,27 @@ PlanStage::StageState GeoNear2DSphereStage::DensityEstimator::work(ExpressionCon
 }
 
 
+GeoNearCoveringCache::DensityKey GeoNear2DSphereStage::densityKey() const {
+    const BSONObj baseBounds = _nearParams.baseBounds.toBSON();
+    return {str::stream() << collection()->uuid().toString() << '\0'
+                          << indexDescriptor()->indexName() << '\0'
+                          << StringData(baseBounds.objdata(), baseBounds.objsize()),
+            _nearParams.nearQuery->centroid->cell.id().id(),
+            _fullBounds.getOuter()};
+}
+
 PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* opCtx,
                                                        WorkingSet* workingSet,
                                                        WorkingSetID* out) {
+    const bool useCache = gInternalQueryGeoNearUseCoveringCache.load();
+    if (!_densityEstimator && useCache) {
+        // A search around this center already estimated the density of the data near it.
+        if (auto width = GeoNearCoveringCache::get(opCtx).getFirstAnnulusWidth(densityKey())) {
+            _boundsIncrement = *width;
+            return IS_EOF;
+        }
+    }
+
     if (!_densityEstimator) {
         _densityEstimator.reset(new DensityEstimator(
             collection(), &_children, &_nearParams, _indexParams, _fullBounds));
@@ -911,6 +953,10 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* opCtx,
         _boundsIncrement = 3 * estimatedDistance;
         invariant(_boundsIncrement > 0.0);
 
+        if (useCache) {
+            GeoNearCoveringCache::get(opCtx).putFirstAnnulusWidth(densityKey(), _boundsIncrement);
+        }
+
         // Clean up
         _densityEstimator.reset(nullptr);
     }
@@ -964,7 +1010,7 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    std::vector<S2CellId> cover = getAnnulusCovering(opCtx, _currBounds, *region);
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/geo_near_covering_cache.h"
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/near.h"
 #include "mongo/db/exec/plan_stats.h"
@@ -155,6 +156,9 @@ protected:
                                      WorkingSetID* out) final;
 
 private:
+    // The key under which the first annulus width of searches like this one is cached.
+    GeoNearCoveringCache::DensityKey densityKey() const;
+
     // Estimate the density of data by search the nearest cells level by level around center.
     class DensityEstimator {
     public:
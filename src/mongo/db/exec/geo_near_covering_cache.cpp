@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/geo_near_covering_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getGeoNearCoveringCache = ServiceContext::declareDecoration<GeoNearCoveringCache>();
+
+Counter64 coveringHits;
+Counter64 coveringMisses;
+Counter64 firstAnnulusWidthHits;
+Counter64 firstAnnulusWidthMisses;
+ServerStatusMetricField<Counter64> displayCoveringHits("query.geoNearCache.coveringHits",
+                                                       &coveringHits);
+ServerStatusMetricField<Counter64> displayCoveringMisses("query.geoNearCache.coveringMisses",
+                                                         &coveringMisses);
+ServerStatusMetricField<Counter64> displayFirstAnnulusWidthHits(
+    "query.geoNearCache.firstAnnulusWidthHits", &firstAnnulusWidthHits);
+ServerStatusMetricField<Counter64> displayFirstAnnulusWidthMisses(
+    "query.geoNearCache.firstAnnulusWidthMisses", &firstAnnulusWidthMisses);
+
+}  // namespace
+
+GeoNearCoveringCache& GeoNearCoveringCache::get(ServiceContext* serviceContext) {
+    return getGeoNearCoveringCache(serviceContext);
+}
+
+GeoNearCoveringCache& GeoNearCoveringCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<std::vector<S2CellId>> GeoNearCoveringCache::getCovering(const CoveringKey& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _coverings.find(key);
+    if (it == _coverings.end()) {
+        coveringMisses.increment();
+        return boost::none;
+    }
+    coveringHits.increment();
+    return it->second;
+}
+
+void GeoNearCoveringCache::putCovering(const CoveringKey& key, std::vector<S2CellId> covering) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _coverings.add(key, std::move(covering));
+}
+
+boost::optional<double> GeoNearCoveringCache::getFirstAnnulusWidth(const DensityKey& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _firstAnnulusWidths.find(key);
+    if (it == _firstAnnulusWidths.end()) {
+        firstAnnulusWidthMisses.increment();
+        return boost::none;
+    }
+    firstAnnulusWidthHits.increment();
+    return it->second;
+}
+
+void GeoNearCoveringCache::putFirstAnnulusWidth(const DensityKey& key, double width) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _firstAnnulusWidths.add(key, width);
+}
+
+void GeoNearCoveringCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _coverings.clear();
+    _firstAnnulusWidths.clear();
+}
+
+}  // namespace mongo
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "third_party/s2/s2cellid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Remembers the work a $near search over a 2dsphere index does before ever scanning for results,
+ * so that searches repeated around the same center skip it:
+ *
+ *  - the S2 covering of each annulus the search scans, which the region coverer otherwise builds
+ *    from scratch for every annulus of every query, and
+ *  - the width of the first annulus, which density estimation otherwise finds by scanning the
+ *    index around the center level by level.
+ *
+ * A covering depends only on its annulus and the coverer settings, so it is always exact. The
+ * first annulus width is a guess at how far away the nearest documents are; a stale one only
+ * changes how the search is split into annuli, never the documents it returns.
+ *
+ * This class is thread-safe.
+ */
+class GeoNearCoveringCache {
+public:
+    struct CoveringKey {
+        double centerX;
+        double centerY;
+        double inner;
+        double outer;
+        int minLevel;
+        int maxLevel;
+        int maxCells;
+
+        bool operator==(const CoveringKey& other) const {
+            return centerX == other.centerX && centerY == other.centerY &&
+                inner == other.inner && outer == other.outer && minLevel == other.minLevel &&
+                maxLevel == other.maxLevel && maxCells == other.maxCells;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H h, const CoveringKey& key) {
+            return H::combine(std::move(h),
+                              key.centerX,
+                              key.centerY,
+                              key.inner,
+                              key.outer,
+                              key.minLevel,
+                              key.maxLevel,
+                              key.maxCells);
+        }
+    };
+
+    struct DensityKey {
+        // Identifies the collection, index and bounds on the index's other fields searched.
+        std::string scope;
+        uint64_t centerCellId;
+        double maxDistance;
+
+        bool operator==(const DensityKey& other) const {
+            return centerCellId == other.centerCellId && maxDistance == other.maxDistance &&
+                scope == other.scope;
+        }
+
+        template <typename H>
+        friend H AbslHashValue(H h, const DensityKey& key) {
+            return H::combine(std::move(h), key.scope, key.centerCellId, key.maxDistance);
+        }
+    };
+
+    // The number of coverings, and separately of first annulus widths, kept.
+    static constexpr size_t kMaxEntries = 1024;
+
+    static GeoNearCoveringCache& get(ServiceContext* serviceContext);
+    static GeoNearCoveringCache& get(OperationContext* opCtx);
+
+    boost::optional<std::vector<S2CellId>> getCovering(const CoveringKey& key);
+    void putCovering(const CoveringKey& key, std::vector<S2CellId> covering);
+
+    boost::optional<double> getFirstAnnulusWidth(const DensityKey& key);
+    void putFirstAnnulusWidth(const DensityKey& key, double width);
+
+    void clear();
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("GeoNearCoveringCache::_mutex");
+
+    LRUCache<CoveringKey, std::vector<S2CellId>> _coverings{kMaxEntries};
+    LRUCache<DensityKey, double> _firstAnnulusWidths{kMaxEntries};
+};
+
+}  // namespace mongo
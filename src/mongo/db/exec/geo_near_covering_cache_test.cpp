@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/geo_near_covering_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+GeoNearCoveringCache::CoveringKey coveringKey(double outer) {
+    return {-73.98, 40.75, 0, outer, 0, 23, 20};
+}
+
+GeoNearCoveringCache::DensityKey densityKey(uint64_t centerCellId) {
+    return {"scope", centerCellId, 1000};
+}
+
+TEST(GeoNearCoveringCacheTest, ReturnsCoveringsByAnnulus) {
+    GeoNearCoveringCache cache;
+    const std::vector<S2CellId> cover{S2CellId::FromFacePosLevel(0, 0, 10)};
+    ASSERT_FALSE(cache.getCovering(coveringKey(100)));
+
+    cache.putCovering(coveringKey(100), cover);
+    auto cached = cache.getCovering(coveringKey(100));
+    ASSERT(cached);
+    ASSERT(*cached == cover);
+    ASSERT_FALSE(cache.getCovering(coveringKey(200)));
+
+    // The same annulus covered with other coverer settings is a different entry.
+    auto finerKey = coveringKey(100);
+    finerKey.maxLevel = 24;
+    ASSERT_FALSE(cache.getCovering(finerKey));
+}
+
+TEST(GeoNearCoveringCacheTest, ReturnsFirstAnnulusWidthsByCenter) {
+    GeoNearCoveringCache cache;
+    cache.putFirstAnnulusWidth(densityKey(1), 30.0);
+    ASSERT(cache.getFirstAnnulusWidth(densityKey(1)));
+    ASSERT_EQ(*cache.getFirstAnnulusWidth(densityKey(1)), 30.0);
+    ASSERT_FALSE(cache.getFirstAnnulusWidth(densityKey(2)));
+
+    auto otherScope = densityKey(1);
+    otherScope.scope = "other";
+    ASSERT_FALSE(cache.getFirstAnnulusWidth(otherScope));
+}
+
+TEST(GeoNearCoveringCacheTest, EvictsLeastRecentlyUsedEntries) {
+    GeoNearCoveringCache cache;
+    for (size_t i = 0; i <= GeoNearCoveringCache::kMaxEntries; ++i) {
+        cache.putFirstAnnulusWidth(densityKey(i), i);
+    }
+    ASSERT_FALSE(cache.getFirstAnnulusWidth(densityKey(0)));
+    ASSERT(cache.getFirstAnnulusWidth(densityKey(1)));
+    ASSERT(cache.getFirstAnnulusWidth(densityKey(GeoNearCoveringCache::kMaxEntries)));
+
+    cache.clear();
+    ASSERT_FALSE(cache.getFirstAnnulusWidth(densityKey(1)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include <memory>
 
+#include "mongo/db/catalog/clustered_collection_util.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/index_scan.h"
@@ -56,7 +57,8 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
       _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+      _key(query->getQueryObj()[descriptor->keyPattern().firstElementFieldNameStringData()]
+               .wrap()) {
     _specificStats.indexName = descriptor->indexName();
     _addKeyMetadata = query->getQueryRequest().returnKey();
 }
@@ -173,4 +175,84 @@ const SpecificStats* IDHackStage::getSpecificStats() const {
     return &_specificStats;
 }
 
+ClusteredIDHackStage::ClusteredIDHackStage(ExpressionContext* expCtx,
+                                           const BSONObj& key,
+                                           WorkingSet* ws,
+                                           const Collection* collection)
+    : RequiresCollectionStage(IDHackStage::kStageType, expCtx, collection),
+      _workingSet(ws),
+      _key(key) {
+    invariant(collection->isClustered());
+}
+
+PlanStage::StageState ClusteredIDHackStage::doWork(WorkingSetID* out) {
+    if (_done) {
+        return PlanStage::IS_EOF;
+    }
+
+    // An _id without a RecordId form can never have been inserted.
+    auto recordId = clustered_util::recordIdForId(_key.firstElement());
+    if (!recordId) {
+        _done = true;
+        return PlanStage::IS_EOF;
+    }
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    try {
+        id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = *recordId;
+        _workingSet->transitionToRecordIdAndIdx(id);
+
+        if (!_recordCursor)
+            _recordCursor = collection()->getCursor(opCtx());
+
+        if (!WorkingSetCommon::fetch(opCtx(), _workingSet, id, _recordCursor, collection()->ns())) {
+            _workingSet->free(id);
+            _commonStats.isEOF = true;
+            _done = true;
+            return IS_EOF;
+        }
+
+        ++_specificStats.docsExamined;
+        _done = true;
+        *out = id;
+        return PlanStage::ADVANCED;
+    } catch (const WriteConflictException&) {
+        _recordCursor.reset();
+        if (id != WorkingSet::INVALID_ID)
+            _workingSet->free(id);
+
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+}
+
+void ClusteredIDHackStage::doSaveStateRequiresCollection() {
+    if (_recordCursor)
+        _recordCursor->saveUnpositioned();
+}
+
+void ClusteredIDHackStage::doRestoreStateRequiresCollection() {
+    if (_recordCursor)
+        _recordCursor->restore();
+}
+
+void ClusteredIDHackStage::doDetachFromOperationContext() {
+    if (_recordCursor)
+        _recordCursor->detachFromOperationContext();
+}
+
+void ClusteredIDHackStage::doReattachToOperationContext() {
+    if (_recordCursor)
+        _recordCursor->reattachToOperationContext(opCtx());
+}
+
+unique_ptr<PlanStageStats> ClusteredIDHackStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    unique_ptr<PlanStageStats> ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_IDHACK);
+    ret->specific = std::make_unique<IDHackStats>(_specificStats);
+    return ret;
+}
+
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include <memory>
 
+#include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/record_id.h"
@@ -44,6 +45,9 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * The same fast path serves an equality on the only field of a non-sparse, non-partial unique
+ * index whose collation matches the query's.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -108,4 +112,53 @@ private:
     IDHackStats _specificStats;
 };
 
+/**
+ * The IDHackStage counterpart for clustered collections, which have no _id index. The _id is
+ * mapped to its RecordId and the document is read from the record store directly.
+ */
+class ClusteredIDHackStage final : public RequiresCollectionStage {
+public:
+    ClusteredIDHackStage(ExpressionContext* expCtx,
+                         const BSONObj& key,
+                         WorkingSet* ws,
+                         const Collection* collection);
+
+    bool isEOF() final {
+        return _done;
+    }
+
+    StageState doWork(WorkingSetID* out) final;
+
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_IDHACK;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats();
+
+    const SpecificStats* getSpecificStats() const final {
+        return &_specificStats;
+    }
+
+protected:
+    void doSaveStateRequiresCollection() final;
+
+    void doRestoreStateRequiresCollection() final;
+
+private:
+    std::unique_ptr<SeekableRecordCursor> _recordCursor;
+
+    // The WorkingSet we annotate with results.  Not owned by us.
+    WorkingSet* _workingSet;
+
+    // The value to match against the _id field.
+    BSONObj _key;
+
+    bool _done = false;
+
+    IDHackStats _specificStats;
+};
+
 }  // namespace mongo
@@ -35,6 +35,8 @@
 
 #include <memory>
 
+#include "third_party/s2/s2cell.h"
+
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
@@ -73,6 +75,8 @@ IndexScan::IndexScan(ExpressionContext* expCtx,
       _forward(params.direction == 1),
       _shouldDedup(params.shouldDedup),
       _addKeyMetadata(params.addKeyMetadata),
+      _s2KeyFilter(std::move(params.s2KeyFilter)),
+      _s2KeyFilterPosition(params.s2KeyFilterPosition),
       _startKeyInclusive(IndexBounds::isStartIncludedInBound(params.bounds.boundInclusion)),
       _endKeyInclusive(IndexBounds::isEndIncludedInBound(params.bounds.boundInclusion)) {
     _specificStats.indexName = params.name;
@@ -82,6 +86,7 @@ IndexScan::IndexScan(ExpressionContext* expCtx,
     _specificStats.isUnique = params.indexDescriptor->unique();
     _specificStats.isSparse = params.indexDescriptor->isSparse();
     _specificStats.isPartial = params.indexDescriptor->isPartial();
+    _specificStats.filtersS2Keys = static_cast<bool>(_s2KeyFilter);
     _specificStats.indexVersion = static_cast<int>(params.indexDescriptor->version());
     _specificStats.collation = params.indexDescriptor->infoObj()
                                    .getObjectField(IndexDescriptor::kCollationFieldName)
@@ -211,6 +216,13 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     _scanState = GETTING_NEXT;
 
+    // This must come before deduping: a document that has several keys is only skipped if none
+    // of its keys is in the region.
+    if (_s2KeyFilter && !s2KeyMayMatch(kv->key)) {
+        ++_specificStats.s2KeysFiltered;
+        return PlanStage::NEED_TIME;
+    }
+
     if (_shouldDedup) {
         ++_specificStats.dupsTested;
         if (!_returned.insert(kv->loc).second) {
@@ -243,6 +255,27 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+bool IndexScan::s2KeyMayMatch(const BSONObj& key) const {
+    BSONObjIterator it(key);
+    for (size_t i = 0; i < _s2KeyFilterPosition && it.more(); ++i) {
+        it.next();
+    }
+    if (!it.more()) {
+        return true;
+    }
+
+    // Version 3 2dsphere keys hold the cell id as a long, see S2CellIdToIndexKey().
+    BSONElement cellElt = it.next();
+    if (cellElt.type() != NumberLong) {
+        return true;
+    }
+    const S2CellId cellId(static_cast<uint64_t>(cellElt.Long()));
+    if (!cellId.is_valid()) {
+        return true;
+    }
+    return _s2KeyFilter->getGeometry().getS2Region().MayIntersect(S2Cell(cellId));
+}
+
 bool IndexScan::isEOF() {
     return _commonStats.isEOF;
 }
@@ -33,6 +33,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
@@ -80,6 +81,11 @@ struct IndexScanParams {
 
     // Do we want to add the key as metadata?
     bool addKeyMetadata{false};
+
+    // If set, keys whose version 3 2dsphere cell at position 's2KeyFilterPosition' does not
+    // intersect this predicate's region are skipped without being returned.
+    std::shared_ptr<const GeoExpression> s2KeyFilter;
+    size_t s2KeyFilterPosition{0};
 };
 
 /**
@@ -140,6 +146,12 @@ private:
      */
     boost::optional<IndexKeyEntry> initIndexScan();
 
+    /**
+     * Returns false if the S2 cell in 'key' lies outside the region of '_s2KeyFilter', meaning
+     * no document matching the geo predicate can be found through this key.
+     */
+    bool s2KeyMayMatch(const BSONObj& key) const;
+
     // The WorkingSet we fill with results.  Not owned by us.
     WorkingSet* const _workingSet;
 
@@ -161,6 +173,9 @@ private:
     // Do we want to add the key as metadata?
     const bool _addKeyMetadata;
 
+    const std::shared_ptr<const GeoExpression> _s2KeyFilter;
+    const size_t _s2KeyFilterPosition;
+
     // Stats
     IndexScanStats _specificStats;
 
@@ -49,6 +49,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -165,6 +166,7 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 
     size_t numWorks = trial_period::getTrialPeriodMaxWorks(opCtx(), collection());
     size_t numResults = trial_period::getTrialPeriodNumToReturn(*_query);
+    const size_t halvingWorks = internalQueryPlanEvaluationHalvingWorks.load();
 
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
@@ -173,6 +175,12 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+
+            // Successive halving: the clearly dominated half of the candidates is not worked any
+            // further, and the trial period ends once a single candidate is left.
+            if (halvingWorks > 0 && (ix + 1) % halvingWorks == 0 && !abandonDominatedPlans()) {
+                break;
+            }
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -251,7 +259,7 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
 
             // If all children have failed, then rethrow. Otherwise, swallow the error and move onto
             // the next candidate plan.
-            if (_failureCount == _candidates.size()) {
+            if (_failureCount + _abandonedCount == _candidates.size()) {
                 throw;
             }
 
@@ -291,6 +299,55 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+bool MultiPlanStage::abandonDominatedPlans() {
+    // Holds (productivity, candidateIndex) for the candidates which may be abandoned. Plans with a
+    // blocking stage produce nothing until the stage is done, so their productivity tells nothing.
+    std::vector<std::pair<double, size_t>> productivities;
+    size_t numRunning = 0;
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        const auto& candidate = _candidates[ix];
+        if (candidate.failed) {
+            continue;
+        }
+        ++numRunning;
+        if (candidate.solution->hasBlockingStage) {
+            continue;
+        }
+
+        const auto* stats = candidate.root->getCommonStats();
+        productivities.emplace_back(
+            stats->works ? static_cast<double>(stats->advanced) / stats->works : 0, ix);
+    }
+    if (productivities.size() < 2) {
+        return numRunning > 1;
+    }
+
+    std::stable_sort(productivities.begin(),
+                     productivities.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    // Candidates as productive as the median are all kept, so that ties are left to the ranking.
+    const double median = productivities[(productivities.size() - 1) / 2].first;
+    size_t numAbandoned = 0;
+    for (const auto& [productivity, ix] : productivities) {
+        if (productivity < median) {
+            _candidates[ix].failed = true;
+            ++numAbandoned;
+        }
+    }
+    _abandonedCount += numAbandoned;
+
+    if (numAbandoned > 0) {
+        LOGV2_DEBUG(5155017,
+                    5,
+                    "Abandoning candidate plans less productive than the median",
+                    "numAbandoned"_attr = numAbandoned,
+                    "numRemaining"_attr = numRunning - numAbandoned,
+                    "medianProductivity"_attr = median);
+    }
+    return numRunning - numAbandoned > 1;
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
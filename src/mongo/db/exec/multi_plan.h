@@ -160,6 +160,12 @@ private:
      */
     void tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops working the candidates which have been less productive than the median candidate so
+     * far, by marking them as failed. Returns true if more than one candidate is still worked.
+     */
+    bool abandonDominatedPlans();
+
     static const int kNoSuchPlan = -1;
 
     // Describes the cases in which we should write an entry for the winning plan to the plan cache.
@@ -192,6 +198,10 @@ private:
     // is safe for the query to continue executing.
     size_t _failureCount = 0u;
 
+    // Count of the candidate plans that the trial period stopped working because other candidates
+    // were more productive. They are marked as failed too, so that they are ranked below the rest.
+    size_t _abandonedCount = 0u;
+
     // Stats
     MultiPlanStats _specificStats;
 };
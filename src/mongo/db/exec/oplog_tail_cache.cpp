@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/oplog_tail_cache.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+const auto getOplogTailCache = ServiceContext::declareDecoration<OplogTailCache>();
+
+Counter64 oplogTailCacheHits;
+Counter64 oplogTailCacheMisses;
+ServerStatusMetricField<Counter64> displayOplogTailCacheHits("query.oplogTailCache.hits",
+                                                             &oplogTailCacheHits);
+ServerStatusMetricField<Counter64> displayOplogTailCacheMisses("query.oplogTailCache.misses",
+                                                               &oplogTailCacheMisses);
+}  // namespace
+
+OplogTailCache& OplogTailCache::get(ServiceContext* serviceContext) {
+    return getOplogTailCache(serviceContext);
+}
+
+OplogTailCache& OplogTailCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<OplogTailCache::Entry> OplogTailCache::next(const RecordId& lastSeenId,
+                                                            const RecordId& maxId) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = std::lower_bound(
+        _entries.begin(), _entries.end(), lastSeenId, [](const Entry& entry, const RecordId& id) {
+            return entry.id < id;
+        });
+    if (it == _entries.end() || it->id != lastSeenId || ++it == _entries.end() ||
+        it->id > maxId) {
+        oplogTailCacheMisses.increment();
+        return boost::none;
+    }
+    oplogTailCacheHits.increment();
+    return *it;
+}
+
+void OplogTailCache::append(const RecordId& prevId,
+                            const RecordId& id,
+                            BSONObj obj,
+                            long long maxBytes) {
+    invariant(obj.isOwned());
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (maxBytes <= 0) {
+        _entries.clear();
+        _bytes = 0;
+        return;
+    }
+
+    if (!_entries.empty()) {
+        if (id <= _entries.back().id) {
+            // Another reader got here first, or this one is behind the newest end of the window.
+            return;
+        }
+        if (prevId.isNull()) {
+            // A reader's first entry is not known to continue the window.
+            return;
+        }
+        if (prevId != _entries.back().id) {
+            // The entry does not continue the window, so it starts a new one.
+            _entries.clear();
+            _bytes = 0;
+        }
+    }
+
+    _bytes += obj.objsize();
+    _entries.push_back({id, std::move(obj)});
+    while (_bytes > maxBytes && _entries.size() > 1) {
+        _bytes -= _entries.front().obj.objsize();
+        _entries.pop_front();
+    }
+}
+
+void OplogTailCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _bytes = 0;
+}
+
+size_t OplogTailCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <deque>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A window of the most recently read entries of the oplog, shared by all of the tailing scans of
+ * the oplog which change streams perform. Without it every change stream cursor reads each new
+ * oplog entry from the storage engine itself; with it the first cursor to reach an entry reads it
+ * and every other cursor takes it from here.
+ *
+ * The window only ever holds a contiguous run of the oplog: an entry is appended only by a scan
+ * which has just read the entry before it from the storage engine. Entries are served only to a
+ * scan positioned on the entry before them, and never beyond a scan's read timestamp, so a scan
+ * sees exactly the entries it would have read itself. Anything which removes entries from the
+ * newest end of the oplog must clear the window.
+ *
+ * This class is thread-safe.
+ */
+class OplogTailCache {
+public:
+    struct Entry {
+        RecordId id;
+        BSONObj obj;
+    };
+
+    static OplogTailCache& get(ServiceContext* serviceContext);
+    static OplogTailCache& get(OperationContext* opCtx);
+
+    /**
+     * Returns the entry which follows 'lastSeenId' in the oplog if the window holds both and the
+     * entry's RecordId is no greater than 'maxId', and boost::none otherwise.
+     */
+    boost::optional<Entry> next(const RecordId& lastSeenId, const RecordId& maxId) const;
+
+    /**
+     * Records that 'obj', which must be owned, was read from the oplog under RecordId 'id'
+     * immediately after the entry with RecordId 'prevId', which is null if the reader had no
+     * position. The oldest entries are dropped once the window exceeds 'maxBytes', and the window
+     * is emptied if 'maxBytes' is not positive.
+     */
+    void append(const RecordId& prevId, const RecordId& id, BSONObj obj, long long maxBytes);
+
+    /**
+     * Empties the window.
+     */
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogTailCache::_mutex");
+
+    // Ordered by RecordId, each entry the oplog successor of the one before it.
+    std::deque<Entry> _entries;
+    long long _bytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/oplog_tail_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const long long kNoLimit = 1024 * 1024;
+
+BSONObj entry(int i) {
+    return BSON("ts" << Timestamp(i, 0) << "o" << BSON("x" << i));
+}
+
+RecordId id(int i) {
+    return RecordId(Timestamp(i, 0).asULL());
+}
+
+TEST(OplogTailCacheTest, ServesTheEntryAfterAPositionInTheWindow) {
+    OplogTailCache cache;
+    cache.append(RecordId(), id(1), entry(1), kNoLimit);
+    cache.append(id(1), id(2), entry(2), kNoLimit);
+    cache.append(id(2), id(3), entry(3), kNoLimit);
+
+    auto next = cache.next(id(1), RecordId::max());
+    ASSERT(next);
+    ASSERT_EQ(id(2), next->id);
+    ASSERT_BSONOBJ_EQ(entry(2), next->obj);
+
+    // Nothing is known after the newest entry, nor about positions outside the window.
+    ASSERT_FALSE(cache.next(id(3), RecordId::max()));
+    ASSERT_FALSE(cache.next(id(0), RecordId::max()));
+    ASSERT_FALSE(cache.next(RecordId(id(1).repr() + 1), RecordId::max()));
+}
+
+TEST(OplogTailCacheTest, DoesNotServeEntriesPastTheReadTimestamp) {
+    OplogTailCache cache;
+    cache.append(RecordId(), id(1), entry(1), kNoLimit);
+    cache.append(id(1), id(2), entry(2), kNoLimit);
+
+    ASSERT_FALSE(cache.next(id(1), id(1)));
+    ASSERT(cache.next(id(1), id(2)));
+}
+
+TEST(OplogTailCacheTest, OnlyAppendsEntriesWhichContinueTheWindow) {
+    OplogTailCache cache;
+    cache.append(RecordId(), id(1), entry(1), kNoLimit);
+    cache.append(id(1), id(2), entry(2), kNoLimit);
+
+    // Entries already in the window, or read by a scan without a position, are ignored.
+    cache.append(id(1), id(2), entry(2), kNoLimit);
+    cache.append(RecordId(), id(3), entry(3), kNoLimit);
+    ASSERT_EQ(2U, cache.size());
+
+    // An entry which does not follow the newest one starts a new window.
+    cache.append(id(5), id(6), entry(6), kNoLimit);
+    ASSERT_EQ(1U, cache.size());
+    ASSERT_FALSE(cache.next(id(1), RecordId::max()));
+}
+
+TEST(OplogTailCacheTest, DropsTheOldestEntriesOverTheSizeLimit) {
+    OplogTailCache cache;
+    const long long maxBytes = 2 * entry(1).objsize();
+    cache.append(RecordId(), id(1), entry(1), maxBytes);
+    cache.append(id(1), id(2), entry(2), maxBytes);
+    cache.append(id(2), id(3), entry(3), maxBytes);
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_FALSE(cache.next(id(1), RecordId::max()));
+    ASSERT(cache.next(id(2), RecordId::max()));
+
+    // A limit of zero disables the cache.
+    cache.append(id(3), id(4), entry(4), 0);
+    ASSERT_EQ(0U, cache.size());
+}
+
+TEST(OplogTailCacheTest, ClearEmptiesTheWindow) {
+    OplogTailCache cache;
+    cache.append(RecordId(), id(1), entry(1), kNoLimit);
+    cache.append(id(1), id(2), entry(2), kNoLimit);
+    cache.clear();
+    ASSERT_EQ(0U, cache.size());
+    ASSERT_FALSE(cache.next(id(1), RecordId::max()));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -529,6 +529,11 @@ struct IndexScanStats : public SpecificStats {
     size_t dupsTested;
     size_t dupsDropped;
 
+    // Whether the scan skips 2dsphere keys whose cells miss the region of a geo predicate, and how
+    // many keys it skipped.
+    bool filtersS2Keys = false;
+    size_t s2KeysFiltered = 0;
+
     // Number of entries retrieved from the index during the scan.
     size_t keysExamined;
 
@@ -637,6 +642,10 @@ struct SortStats : public SpecificStats {
 
     // Whether we spilled data to disk during the execution of this query.
     bool wasDiskUsed = false;
+
+    // The number of leading fields of the sort pattern by which the input was already ordered, so
+    // that only runs of documents sharing those fields needed sorting.
+    uint64_t sortedPrefixLength = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
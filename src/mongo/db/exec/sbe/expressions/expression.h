@@ -171,6 +171,10 @@ public:
 
     std::vector<DebugPrinter::Block> debugPrint() const override;
 
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
+
 private:
     value::TypeTags _tag;
     value::Value _val;
@@ -27,9 +27,18 @@
  *    it in the license file.
  */
 
+#include "mongo/db/exec/sbe/stages/bson_scan.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/merge_join.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/exec/sbe/values/id_generators.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 
@@ -42,6 +51,22 @@ TEST(SBEValues, Basic) {
         value::releaseValue(tag, val);
     }
 
+    {
+        // The longest string which still fits in a Value alongside its terminating zero.
+        auto [tag, val] = value::makeNewString("seven c"sv);
+        ASSERT_EQUALS(tag, value::TypeTags::StringSmall);
+        ASSERT_EQUALS(value::getStringView(tag, val), "seven c"sv);
+
+        value::releaseValue(tag, val);
+    }
+
+    {
+        const auto [tag, val] = value::makeNewString("eight ch"sv);
+        ASSERT_EQUALS(tag, value::TypeTags::StringBig);
+
+        value::releaseValue(tag, val);
+    }
+
     {
         const auto [tag, val] = value::makeNewString("not so small string"sv);
         ASSERT_EQUALS(tag, value::TypeTags::StringBig);
@@ -99,6 +124,262 @@ TEST(SBEValues, Hash) {
     value::releaseValue(tagDecimal, valDecimal);
 }
 
+TEST(SBEValues, MaterializedRowSerialization) {
+    using namespace std::literals;
+
+    value::MaterializedRow row;
+    row._fields.resize(4);
+    row._fields[0].reset(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(42));
+    {
+        auto [tag, val] = value::makeNewString("not so small string"sv);
+        row._fields[1].reset(tag, val);
+    }
+    {
+        auto [tag, val] = value::makeNewArray();
+        auto arr = value::getArrayView(val);
+        arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(1.5));
+        auto [decTag, decVal] = value::makeCopyDecimal(mongo::Decimal128(-7.25));
+        arr->push_back(decTag, decVal);
+        row._fields[2].reset(tag, val);
+    }
+    {
+        auto [tag, val] = value::makeNewObject();
+        auto obj = value::getObjectView(val);
+        auto [fieldTag, fieldVal] = value::makeNewString("small"sv);
+        obj->push_back("field"sv, fieldTag, fieldVal);
+        row._fields[3].reset(tag, val);
+    }
+
+    BufBuilder buf;
+    row.serializeForSorter(buf);
+
+    BufReader reader(buf.buf(), buf.len());
+    auto copy = value::MaterializedRow::deserializeForSorter(reader, {});
+    ASSERT_TRUE(reader.atEof());
+    ASSERT_EQUALS(copy._fields.size(), row._fields.size());
+    ASSERT_TRUE(copy == row);
+}
+
+TEST(SBEValues, MaterializedRowMakeOwned) {
+    using namespace std::literals;
+
+    auto [unownedTag, unownedVal] = value::makeNewString("not so small string"sv);
+    ON_BLOCK_EXIT([&] { value::releaseValue(unownedTag, unownedVal); });
+
+    value::MaterializedRow row;
+    row._fields.resize(2);
+    row._fields[0].reset(false, unownedTag, unownedVal);
+    {
+        auto [tag, val] = value::makeNewString("another not so small string"sv);
+        row._fields[1].reset(tag, val);
+    }
+    const auto ownedVal = row._fields[1].getViewOfValue().second;
+
+    // Only the unowned value needs to be copied.
+    row.makeOwned();
+    ASSERT_NOT_EQUALS(row._fields[0].getViewOfValue().second, unownedVal);
+    ASSERT_EQUALS(value::getStringView(unownedTag, unownedVal), "not so small string"sv);
+    ASSERT_EQUALS(row._fields[1].getViewOfValue().second, ownedVal);
+}
+
+class SBEHashAggTest : public ScopedGlobalServiceContextForTest, public unittest::Test {};
+
+TEST_F(SBEHashAggTest, SpillsToDiskWhenMemoryLimitIsExceeded) {
+    const int kNumGroups = 100;
+    const int kNumDocsPerGroup = 10;
+
+    BufBuilder docs;
+    for (int i = 0; i < kNumGroups * kNumDocsPerGroup; ++i) {
+        auto doc = BSON("a" << (i % kNumGroups) << "b" << 1);
+        docs.appendBuf(doc.objdata(), doc.objsize());
+    }
+
+    unittest::TempDir tempDir("SBEHashAggTest");
+    const auto oldMemoryLimit = internalDocumentSourceGroupMaxMemoryBytes.load();
+    internalDocumentSourceGroupMaxMemoryBytes.store(1024);
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGroupMaxMemoryBytes.store(oldMemoryLimit); });
+
+    value::SlotIdGenerator slotIdGenerator;
+    auto keySlot = slotIdGenerator.generate();
+    auto valSlot = slotIdGenerator.generate();
+    auto sumSlot = slotIdGenerator.generate();
+
+    auto scan = makeS<BSONScanStage>(docs.buf(),
+                                     docs.buf() + docs.len(),
+                                     boost::none,
+                                     std::vector<std::string>{"a", "b"},
+                                     makeSV(keySlot, valSlot));
+    auto stage = makeS<HashAggStage>(
+        std::move(scan),
+        makeSV(keySlot),
+        makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(valSlot)))),
+        true,
+        tempDir.path());
+
+    CompileCtx ctx;
+    stage->prepare(ctx);
+    auto keyAccessor = stage->getAccessor(ctx, keySlot);
+    auto sumAccessor = stage->getAccessor(ctx, sumSlot);
+
+    stage->open(false);
+    std::map<int32_t, int64_t> results;
+    while (stage->getNext() == PlanState::ADVANCED) {
+        auto [keyTag, keyVal] = keyAccessor->getViewOfValue();
+        auto [sumTag, sumVal] = sumAccessor->getViewOfValue();
+        ASSERT_EQUALS(keyTag, value::TypeTags::NumberInt32);
+        ASSERT_TRUE(value::isNumber(sumTag));
+        ASSERT_TRUE(results
+                        .emplace(value::bitcastTo<int32_t>(keyVal),
+                                 value::numericCast<int64_t>(sumTag, sumVal))
+                        .second);
+    }
+    stage->close();
+
+    ASSERT_EQUALS(results.size(), static_cast<size_t>(kNumGroups));
+    for (auto&& [key, sum] : results) {
+        ASSERT_EQUALS(sum, kNumDocsPerGroup);
+    }
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_GT(stats->spilledRecords, 0);
+}
+
+class SBESortTest : public ScopedGlobalServiceContextForTest, public unittest::Test {
+protected:
+    /**
+     * Sorts the documents {a: <key>} for each of 'keys' by descending 'a', returning the keys in
+     * the order produced by the sort stage along with its stats.
+     */
+    std::pair<std::vector<int32_t>, SortStats> runSort(const std::vector<int>& keys,
+                                                       size_t limit,
+                                                       bool allowDiskUse,
+                                                       const std::string& tempDir) {
+        BufBuilder docs;
+        for (auto key : keys) {
+            auto doc = BSON("a" << key);
+            docs.appendBuf(doc.objdata(), doc.objsize());
+        }
+
+        value::SlotIdGenerator slotIdGenerator;
+        auto keySlot = slotIdGenerator.generate();
+        auto stage = makeS<SortStage>(makeS<BSONScanStage>(docs.buf(),
+                                                           docs.buf() + docs.len(),
+                                                           boost::none,
+                                                           std::vector<std::string>{"a"},
+                                                           makeSV(keySlot)),
+                                      makeSV(keySlot),
+                                      std::vector<value::SortDirection>{
+                                          value::SortDirection::Descending},
+                                      makeSV(),
+                                      limit,
+                                      allowDiskUse,
+                                      tempDir,
+                                      nullptr);
+
+        CompileCtx ctx;
+        stage->prepare(ctx);
+        auto keyAccessor = stage->getAccessor(ctx, keySlot);
+
+        stage->open(false);
+        std::vector<int32_t> results;
+        while (stage->getNext() == PlanState::ADVANCED) {
+            auto [tag, val] = keyAccessor->getViewOfValue();
+            ASSERT_EQUALS(tag, value::TypeTags::NumberInt32);
+            results.push_back(value::bitcastTo<int32_t>(val));
+        }
+        stage->close();
+
+        return {results, *static_cast<const SortStats*>(stage->getSpecificStats())};
+    }
+};
+
+TEST_F(SBESortTest, SpillsToDiskWhenMemoryLimitIsExceeded) {
+    const int kNumDocs = 1000;
+
+    std::vector<int> keys;
+    for (int i = 0; i < kNumDocs; ++i) {
+        keys.push_back((i * 7) % kNumDocs);
+    }
+
+    unittest::TempDir tempDir("SBESortTest");
+    const auto oldMemoryLimit = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(1024);
+    ON_BLOCK_EXIT([&] { internalQueryMaxBlockingSortMemoryUsageBytes.store(oldMemoryLimit); });
+
+    auto [results, stats] =
+        runSort(keys, std::numeric_limits<size_t>::max(), true, tempDir.path());
+
+    ASSERT_EQUALS(results.size(), static_cast<size_t>(kNumDocs));
+    for (int i = 0; i < kNumDocs; ++i) {
+        ASSERT_EQUALS(results[i], kNumDocs - 1 - i);
+    }
+    ASSERT_TRUE(stats.wasDiskUsed);
+
+    ASSERT_THROWS_CODE(runSort(keys, std::numeric_limits<size_t>::max(), false, ""),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(SBESortTest, KeepsOnlyTopRowsWhenLimited) {
+    auto [results, stats] = runSort({5, 1, 9, 3, 7, 9, 2}, 3, false, "");
+
+    ASSERT_TRUE((results == std::vector<int32_t>{9, 9, 7}));
+    ASSERT_FALSE(stats.wasDiskUsed);
+    ASSERT_EQUALS(stats.limit, 3u);
+}
+
+TEST(SBEMergeJoin, IntersectsSortedInputs) {
+    auto makeDocs = [](std::vector<int> keys) {
+        BufBuilder docs;
+        for (auto key : keys) {
+            auto doc = BSON("a" << key);
+            docs.appendBuf(doc.objdata(), doc.objsize());
+        }
+        return docs;
+    };
+    auto outerDocs = makeDocs({1, 2, 4, 7, 9});
+    auto innerDocs = makeDocs({2, 3, 4, 5, 9, 10});
+
+    value::SlotIdGenerator slotIdGenerator;
+    auto outerSlot = slotIdGenerator.generate();
+    auto innerSlot = slotIdGenerator.generate();
+
+    auto stage = makeS<MergeJoinStage>(makeS<BSONScanStage>(outerDocs.buf(),
+                                                            outerDocs.buf() + outerDocs.len(),
+                                                            boost::none,
+                                                            std::vector<std::string>{"a"},
+                                                            makeSV(outerSlot)),
+                                       makeS<BSONScanStage>(innerDocs.buf(),
+                                                            innerDocs.buf() + innerDocs.len(),
+                                                            boost::none,
+                                                            std::vector<std::string>{"a"},
+                                                            makeSV(innerSlot)),
+                                       makeSV(outerSlot),
+                                       makeSV(),
+                                       makeSV(innerSlot),
+                                       makeSV());
+
+    CompileCtx ctx;
+    stage->prepare(ctx);
+    auto outerAccessor = stage->getAccessor(ctx, outerSlot);
+    auto innerAccessor = stage->getAccessor(ctx, innerSlot);
+
+    stage->open(false);
+    std::vector<int32_t> results;
+    while (stage->getNext() == PlanState::ADVANCED) {
+        auto [outerTag, outerVal] = outerAccessor->getViewOfValue();
+        auto [innerTag, innerVal] = innerAccessor->getViewOfValue();
+        ASSERT_EQUALS(outerTag, value::TypeTags::NumberInt32);
+        ASSERT_EQUALS(innerTag, value::TypeTags::NumberInt32);
+        ASSERT_EQUALS(value::bitcastTo<int32_t>(outerVal), value::bitcastTo<int32_t>(innerVal));
+        results.push_back(value::bitcastTo<int32_t>(outerVal));
+    }
+    stage->close();
+
+    ASSERT_TRUE((results == std::vector<int32_t>{2, 4, 9}));
+}
+
 TEST(SBEVM, Add) {
     {
         auto tagInt32 = value::TypeTags::NumberInt32;
@@ -159,4 +440,21 @@ TEST(SBEVM, Add) {
     }
 }
 
+TEST(SBEVM, GetFieldImm) {
+    auto obj = BSON("a" << 1 << "b" << 2);
+    auto [fieldTag, fieldVal] = value::makeNewString("b");
+    ON_BLOCK_EXIT([&] { value::releaseValue(fieldTag, fieldVal); });
+
+    vm::CodeFragment code;
+    code.appendConstVal(value::TypeTags::bsonObject, value::bitcastFrom(obj.objdata()));
+    code.appendGetField(fieldTag, fieldVal);
+
+    vm::ByteCode interpreter;
+    auto [owned, tag, val] = interpreter.run(&code);
+
+    ASSERT_FALSE(owned);
+    ASSERT_EQUALS(tag, value::TypeTags::NumberInt32);
+    ASSERT_EQUALS(value::bitcastTo<int32_t>(val), 2);
+}
+
 }  // namespace mongo::sbe
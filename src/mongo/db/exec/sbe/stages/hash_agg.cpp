@@ -31,23 +31,57 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
+namespace {
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. Each user of the Sorter must provide its own version of this function, see the comment
+ * in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> hashAggStageFileCounter;
+    return "extsort-sbe-hash-agg." + std::to_string(hashAggStageFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
 namespace sbe {
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
-                           value::SlotMap<std::unique_ptr<EExpression>> aggs)
-    : PlanStage("group"_sd), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+                           value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                           bool allowDiskUse,
+                           std::string tempDir)
+    : PlanStage("group"_sd),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _allowDiskUse(allowDiskUse),
+      _tempDir(std::move(tempDir)),
+      _maxMemoryUsageBytes(internalDocumentSourceGroupMaxMemoryBytes.load()) {
     _children.emplace_back(std::move(input));
 }
 
+HashAggStage::~HashAggStage() {
+    if (!_spillFileName.empty()) {
+        _spillIt.reset();
+        _spillWriter.reset();
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+    }
+}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(_children[0]->clone(), _gbs, std::move(aggs));
+    return std::make_unique<HashAggStage>(
+        _children[0]->clone(), _gbs, std::move(aggs), _allowDiskUse, _tempDir);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -60,7 +94,8 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         auto [it, inserted] = dupCheck.emplace(slot);
         uassert(4822827, str::stream() << "duplicate field: " << slot, inserted);
 
-        _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
+        _inKeyAccessors.emplace_back(std::make_unique<InputAccessor>(
+            _children[0]->getAccessor(ctx, slot), _spilledKey, counter, _readSpilled));
         _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter++));
         _outAccessors[slot] = _outKeyAccessors.back().get();
     }
@@ -93,43 +128,127 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
             return it->second;
         }
     } else {
-        return _children[0]->getAccessor(ctx, slot);
+        // We are compiling the aggregate expressions. Remember every input slot they read, so
+        // that its value can be written to the spill file along with the group by key.
+        if (auto it = _inAggAccessors.find(slot); it != _inAggAccessors.end()) {
+            return it->second.get();
+        }
+        auto accessor = std::make_unique<InputAccessor>(_children[0]->getAccessor(ctx, slot),
+                                                        _spilledVals,
+                                                        _inAggAccessors.size(),
+                                                        _readSpilled);
+        return _inAggAccessors.emplace(slot, std::move(accessor)).first->second.get();
     }
 
     return ctx.getAccessor(slot);
 }
 
-void HashAggStage::open(bool reOpen) {
-    _commonStats.opens++;
-    _children[0]->open(reOpen);
-
+void HashAggStage::accumulate() {
     value::MaterializedRow key;
-    while (_children[0]->getNext() == PlanState::ADVANCED) {
-        key._fields.resize(_inKeyAccessors.size());
-        // Copy keys in order to do the lookup.
-        size_t idx = 0;
-        for (auto& p : _inKeyAccessors) {
-            auto [tag, val] = p->getViewOfValue();
-            key._fields[idx++].reset(false, tag, val);
-        }
+    key._fields.resize(_inKeyAccessors.size());
+    // Copy keys in order to do the lookup.
+    size_t idx = 0;
+    for (auto& p : _inKeyAccessors) {
+        auto [tag, val] = p->getViewOfValue();
+        key._fields[idx++].reset(false, tag, val);
+    }
 
-        auto [it, inserted] = _ht.emplace(std::move(key), value::MaterializedRow{});
+    TableType::iterator it;
+    if (_allowDiskUse && _memoryUsageBytes > _maxMemoryUsageBytes) {
+        // Only the groups which are already in memory can be updated in this pass.
+        it = _ht.find(key);
+        if (it == _ht.end()) {
+            spillRow(key);
+            return;
+        }
+    } else {
+        bool inserted;
+        std::tie(it, inserted) = _ht.emplace(std::move(key), value::MaterializedRow{});
         if (inserted) {
             // Copy keys.
             const_cast<value::MaterializedRow&>(it->first).makeOwned();
             // Initialize accumulators.
             it->second._fields.resize(_outAggAccessors.size());
+
+            if (_allowDiskUse) {
+                _memoryUsageBytes += it->first.memUsage() + it->second.memUsage();
+            }
         }
+    }
+
+    // Accumulate.
+    _htIt = it;
+    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+        _outAggAccessors[idx]->reset(owned, tag, val);
+    }
+}
 
-        // Accumulate.
-        _htIt = it;
-        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
-            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
-            _outAggAccessors[idx]->reset(owned, tag, val);
+void HashAggStage::spillRow(const value::MaterializedRow& key) {
+    if (!_spillWriter) {
+        if (_spillFileName.empty()) {
+            _spillFileName = _tempDir + "/" + nextFileName();
         }
+        _spillWriter = std::make_unique<SpillWriter>(
+            SortOptions().TempDir(_tempDir), _spillFileName, _nextSpillFileOffset);
+        _specificStats.usedDisk = true;
+    }
+
+    value::MaterializedRow vals;
+    vals._fields.resize(_inAggAccessors.size());
+    for (auto& [slot, accessor] : _inAggAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        vals._fields[accessor->index()].reset(false, tag, val);
+    }
+
+    _spillWriter->addAlreadySorted(key, vals);
+    _specificStats.spilledRecords++;
+}
+
+void HashAggStage::finishPass() {
+    if (_spillWriter) {
+        _spillIt.reset(_spillWriter->done());
+        _nextSpillFileOffset = _spillWriter->getFileEndOffset();
+        _spillWriter.reset();
+    }
+}
+
+void HashAggStage::aggregateSpilledRows() {
+    invariant(_spillIt);
+    auto spillIt = std::move(_spillIt);
+
+    _ht.clear();
+    _memoryUsageBytes = 0;
+
+    _readSpilled = true;
+    spillIt->openSource();
+    while (spillIt->more()) {
+        std::tie(_spilledKey, _spilledVals) = spillIt->next();
+        accumulate();
+    }
+    spillIt->closeSource();
+    _readSpilled = false;
+
+    finishPass();
+}
+
+void HashAggStage::open(bool reOpen) {
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+
+    if (reOpen) {
+        _ht.clear();
+        _memoryUsageBytes = 0;
+        _spillWriter.reset();
+        _spillIt.reset();
+    }
+
+    while (_children[0]->getNext() == PlanState::ADVANCED) {
+        accumulate();
     }
 
     _children[0]->close();
+    finishPass();
 
     _htIt = _ht.end();
 }
@@ -141,6 +260,13 @@ PlanState HashAggStage::getNext() {
         ++_htIt;
     }
 
+    // Once the groups held in memory are exhausted, move on to the groups that were spilled. Every
+    // pass admits at least one new group into the hash table, so this loop always terminates.
+    while (_htIt == _ht.end() && _spillIt) {
+        aggregateSpilledRows();
+        _htIt = _ht.begin();
+    }
+
     if (_htIt == _ht.end()) {
         return trackPlanState(PlanState::IS_EOF);
     }
@@ -150,16 +276,19 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     return ret;
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
     _commonStats.closes++;
+    _spillWriter.reset();
+    _spillIt.reset();
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
@@ -197,3 +326,6 @@ std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
 }
 }  // namespace sbe
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
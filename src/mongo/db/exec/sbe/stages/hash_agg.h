@@ -34,15 +34,33 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 namespace sbe {
+/**
+ * Groups the input rows by the values of the 'gbs' slots and computes the aggregate expressions
+ * 'aggs' for every group.
+ *
+ * If 'allowDiskUse' is true, the memory consumed by the hash table is bounded by the
+ * 'internalDocumentSourceGroupMaxMemoryBytes' knob. Once the limit is reached, input rows which
+ * belong to groups already present in the hash table continue to be aggregated in memory, while
+ * the rows of any new group are written to a spill file under 'tempDir' in arrival order. After
+ * the in-memory groups have been returned, the spilled rows are aggregated in the same manner,
+ * which may in turn spill again. Because every group is aggregated entirely within a single pass
+ * and the rows are replayed in their original order, the aggregate expressions do not need to be
+ * mergeable.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
-                 value::SlotMap<std::unique_ptr<EExpression>> aggs);
+                 value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                 bool allowDiskUse,
+                 std::string tempDir);
+
+    ~HashAggStage();
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -63,13 +81,79 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+    using SpillWriter = SortedFileWriter<value::MaterializedRow, value::MaterializedRow>;
+
+    /**
+     * Provides the value of an input slot to the group by keys and the aggregate expressions. The
+     * value comes from the child's accessor while the child is being consumed, and from the row
+     * most recently read back from the spill file while spilled input is being aggregated.
+     */
+    class InputAccessor final : public value::SlotAccessor {
+    public:
+        InputAccessor(value::SlotAccessor* input,
+                      value::MaterializedRow& spilledRow,
+                      size_t idx,
+                      const bool& readSpilled)
+            : _input(input), _spilledRow(spilledRow), _idx(idx), _readSpilled(readSpilled) {}
+
+        std::pair<value::TypeTags, value::Value> getViewOfValue() const override {
+            return _readSpilled ? _spilledRow._fields[_idx].getViewOfValue()
+                                : _input->getViewOfValue();
+        }
+        std::pair<value::TypeTags, value::Value> copyOrMoveValue() override {
+            return _readSpilled ? _spilledRow._fields[_idx].copyOrMoveValue()
+                                : _input->copyOrMoveValue();
+        }
+
+        size_t index() const {
+            return _idx;
+        }
+
+    private:
+        value::SlotAccessor* const _input;
+        value::MaterializedRow& _spilledRow;
+        const size_t _idx;
+        const bool& _readSpilled;
+    };
+
+    /**
+     * Adds the current input row to its group, or writes it to the spill file if the group is not
+     * in the hash table and the memory limit has been reached.
+     */
+    void accumulate();
+
+    /**
+     * Appends the current input row to the spill file, creating a new sorted file range if this is
+     * the first row spilled during the current pass.
+     */
+    void spillRow(const value::MaterializedRow& key);
+
+    /**
+     * Ends a pass over the input. If any rows were spilled during the pass, the spill file range
+     * that they were written to becomes the input of the next pass.
+     */
+    void finishPass();
+
+    /**
+     * Clears the hash table and aggregates the input of the next pass from the spill file.
+     */
+    void aggregateSpilledRows();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const bool _allowDiskUse;
+    const std::string _tempDir;
+    const long long _maxMemoryUsageBytes;
 
     value::SlotAccessorMap _outAccessors;
-    std::vector<value::SlotAccessor*> _inKeyAccessors;
+    std::vector<std::unique_ptr<InputAccessor>> _inKeyAccessors;
     std::vector<std::unique_ptr<HashKeyAccessor>> _outKeyAccessors;
 
+    // Accessors for the slots produced by the child which are referenced by the aggregate
+    // expressions, keyed by the slot id.
+    value::SlotMap<std::unique_ptr<InputAccessor>> _inAggAccessors;
+
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
@@ -78,6 +162,22 @@ private:
 
     vm::ByteCode _bytecode;
 
+    // An approximation of the memory used by the groups in '_ht'.
+    long long _memoryUsageBytes{0};
+
+    // The row currently read back from the spill file, split into the group by key and the values
+    // of the input slots in '_inAggAccessors'.
+    value::MaterializedRow _spilledKey;
+    value::MaterializedRow _spilledVals;
+    bool _readSpilled{false};
+
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset{0};
+    std::unique_ptr<SpillWriter> _spillWriter;
+    std::unique_ptr<SpillIterator> _spillIt;
+
+    HashAggStats _specificStats;
+
     bool _compiled{false};
 };
 }  // namespace sbe
@@ -0,0 +1,202 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/merge_join.h"
+
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+MergeJoinStage::MergeJoinStage(std::unique_ptr<PlanStage> outer,
+                               std::unique_ptr<PlanStage> inner,
+                               value::SlotVector outerKeys,
+                               value::SlotVector outerProjects,
+                               value::SlotVector innerKeys,
+                               value::SlotVector innerProjects)
+    : PlanStage("mj"_sd),
+      _outerKeys(std::move(outerKeys)),
+      _outerProjects(std::move(outerProjects)),
+      _innerKeys(std::move(innerKeys)),
+      _innerProjects(std::move(innerProjects)) {
+    uassert(5150500,
+            "left and right size do not match",
+            _outerKeys.size() == _innerKeys.size() && !_outerKeys.empty());
+
+    _children.emplace_back(std::move(outer));
+    _children.emplace_back(std::move(inner));
+}
+
+std::unique_ptr<PlanStage> MergeJoinStage::clone() const {
+    return std::make_unique<MergeJoinStage>(_children[0]->clone(),
+                                            _children[1]->clone(),
+                                            _outerKeys,
+                                            _outerProjects,
+                                            _innerKeys,
+                                            _innerProjects);
+}
+
+void MergeJoinStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+    _children[1]->prepare(ctx);
+
+    value::SlotSet dupCheck;
+    for (auto& slot : _outerKeys) {
+        auto [it, inserted] = dupCheck.emplace(slot);
+        uassert(5150501, str::stream() << "duplicate field: " << slot, inserted);
+
+        _outerKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
+    }
+
+    for (auto& slot : _innerKeys) {
+        auto [it, inserted] = dupCheck.emplace(slot);
+        uassert(5150502, str::stream() << "duplicate field: " << slot, inserted);
+
+        _innerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+    }
+}
+
+value::SlotAccessor* MergeJoinStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    for (auto& outerSlots : {std::cref(_outerKeys), std::cref(_outerProjects)}) {
+        if (std::find(outerSlots.get().begin(), outerSlots.get().end(), slot) !=
+            outerSlots.get().end()) {
+            return _children[0]->getAccessor(ctx, slot);
+        }
+    }
+
+    return _children[1]->getAccessor(ctx, slot);
+}
+
+void MergeJoinStage::open(bool reOpen) {
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+    _children[1]->open(reOpen);
+
+    _advanceOuter = true;
+    _advanceInner = true;
+    _isEOF = false;
+}
+
+int MergeJoinStage::compareKeys() const {
+    for (size_t idx = 0; idx < _outerKeyAccessors.size(); ++idx) {
+        auto [lhsTag, lhsVal] = _outerKeyAccessors[idx]->getViewOfValue();
+        auto [rhsTag, rhsVal] = _innerKeyAccessors[idx]->getViewOfValue();
+
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+        uassert(5150503,
+                "merge join keys are not comparable",
+                tag == value::TypeTags::NumberInt32);
+        if (auto result = value::bitcastTo<int32_t>(val); result != 0) {
+            return result;
+        }
+    }
+
+    return 0;
+}
+
+PlanState MergeJoinStage::getNext() {
+    while (!_isEOF) {
+        if (_advanceOuter && _children[0]->getNext() == PlanState::IS_EOF) {
+            _isEOF = true;
+            break;
+        }
+        if (_advanceInner && _children[1]->getNext() == PlanState::IS_EOF) {
+            _isEOF = true;
+            break;
+        }
+
+        auto cmp = compareKeys();
+        _advanceOuter = cmp <= 0;
+        _advanceInner = cmp >= 0;
+
+        if (cmp == 0) {
+            return trackPlanState(PlanState::ADVANCED);
+        }
+    }
+
+    return trackPlanState(PlanState::IS_EOF);
+}
+
+void MergeJoinStage::close() {
+    _commonStats.closes++;
+    _children[1]->close();
+    _children[0]->close();
+}
+
+std::unique_ptr<PlanStageStats> MergeJoinStage::getStats() const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->children.emplace_back(_children[0]->getStats());
+    ret->children.emplace_back(_children[1]->getStats());
+    return ret;
+}
+
+const SpecificStats* MergeJoinStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> MergeJoinStage::debugPrint() const {
+    std::vector<DebugPrinter::Block> ret;
+    DebugPrinter::addKeyword(ret, "mj");
+
+    auto addSlots = [&ret](const value::SlotVector& slots) {
+        ret.emplace_back(DebugPrinter::Block("[`"));
+        for (size_t idx = 0; idx < slots.size(); ++idx) {
+            if (idx) {
+                ret.emplace_back(DebugPrinter::Block("`,"));
+            }
+
+            DebugPrinter::addIdentifier(ret, slots[idx]);
+        }
+        ret.emplace_back(DebugPrinter::Block("`]"));
+    };
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+
+    DebugPrinter::addKeyword(ret, "left");
+    addSlots(_outerKeys);
+    addSlots(_outerProjects);
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    DebugPrinter::addKeyword(ret, "right");
+    addSlots(_innerKeys);
+    addSlots(_innerProjects);
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[1]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    return ret;
+}
+}  // namespace mongo::sbe
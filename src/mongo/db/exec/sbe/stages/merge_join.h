@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+
+namespace mongo::sbe {
+/**
+ * A sort-merge inner join. Both inputs must be sorted in ascending order on their respective key
+ * slots, and each key must occur at most once per input, which is the case for streams of
+ * RecordIds produced by point index scans. Unlike the hash join neither side is materialized, so
+ * the rows are produced in key order and all slots of both children remain visible above the join.
+ */
+class MergeJoinStage final : public PlanStage {
+public:
+    MergeJoinStage(std::unique_ptr<PlanStage> outer,
+                   std::unique_ptr<PlanStage> inner,
+                   value::SlotVector outerKeys,
+                   value::SlotVector outerProjects,
+                   value::SlotVector innerKeys,
+                   value::SlotVector innerProjects);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats() const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+private:
+    /**
+     * Compares the current outer and inner keys. Returns a negative number if the outer key is
+     * smaller, a positive number if the inner key is smaller and 0 if they are equal.
+     */
+    int compareKeys() const;
+
+    const value::SlotVector _outerKeys;
+    const value::SlotVector _outerProjects;
+    const value::SlotVector _innerKeys;
+    const value::SlotVector _innerProjects;
+
+    std::vector<value::SlotAccessor*> _outerKeyAccessors;
+    std::vector<value::SlotAccessor*> _innerKeyAccessors;
+
+    // Set when the corresponding side has to be advanced before the next comparison.
+    bool _advanceOuter{true};
+    bool _advanceInner{true};
+    bool _isEOF{false};
+};
+}  // namespace mongo::sbe
@@ -99,6 +99,21 @@ struct LimitSkipStats : public SpecificStats {
     boost::optional<long long> skip;
 };
 
+struct HashAggStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashAggStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return sizeof(*this);
+    }
+
+    bool usedDisk{false};
+    // The number of input rows which were written to the spill file because their group did not
+    // fit into memory.
+    long long spilledRecords{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
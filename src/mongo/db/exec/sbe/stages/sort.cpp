@@ -32,30 +32,79 @@
 #include "mongo/db/exec/sbe/stages/sort.h"
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
+namespace {
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. Each user of the Sorter must provide its own version of this function, see the comment
+ * in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> sortStageFileCounter;
+    return "extsort-sbe-sort." + std::to_string(sortStageFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
 namespace sbe {
 SortStage::SortStage(std::unique_ptr<PlanStage> input,
                      value::SlotVector obs,
                      std::vector<value::SortDirection> dirs,
                      value::SlotVector vals,
                      size_t limit,
-                     TrialRunProgressTracker* tracker)
+                     bool allowDiskUse,
+                     std::string tempDir,
+                     TrialRunProgressTracker* tracker,
+                     size_t sortedPrefixLength)
     : PlanStage("sort"_sd),
       _obs(std::move(obs)),
       _dirs(std::move(dirs)),
       _vals(std::move(vals)),
       _limit(limit),
-      _st(value::MaterializedRowComparator{_dirs}),
+      _allowDiskUse(allowDiskUse),
+      _tempDir(std::move(tempDir)),
+      _maxMemoryUsageBytes(internalQueryMaxBlockingSortMemoryUsageBytes.load()),
+      _sortedPrefixLength(sortedPrefixLength),
       _tracker(tracker) {
     _children.emplace_back(std::move(input));
 
     invariant(_obs.size() == _dirs.size());
+    invariant(_sortedPrefixLength < _obs.size());
+
+    _specificStats.limit = _limit != std::numeric_limits<size_t>::max() ? _limit : 0;
+    _specificStats.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    _specificStats.sortedPrefixLength = _sortedPrefixLength;
 }
 
 std::unique_ptr<PlanStage> SortStage::clone() const {
-    return std::make_unique<SortStage>(_children[0]->clone(), _obs, _dirs, _vals, _limit, _tracker);
+    return std::make_unique<SortStage>(_children[0]->clone(),
+                                       _obs,
+                                       _dirs,
+                                       _vals,
+                                       _limit,
+                                       _allowDiskUse,
+                                       _tempDir,
+                                       _tracker,
+                                       _sortedPrefixLength);
+}
+
+int SortStage::SortKeyComparator::operator()(const SorterData& lhs, const SorterData& rhs) const {
+    for (size_t idx = 0; idx < lhs.first._fields.size(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs.first._fields[idx].getViewOfValue();
+        auto [rhsTag, rhsVal] = rhs.first._fields[idx].getViewOfValue();
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+        if (tag != value::TypeTags::NumberInt32) {
+            return 0;
+        }
+
+        if (auto result = value::bitcastTo<int32_t>(val); result != 0) {
+            return _dirs[idx] == value::SortDirection::Ascending ? result : -result;
+        }
+    }
+
+    return 0;
 }
 
 void SortStage::prepare(CompileCtx& ctx) {
@@ -70,7 +119,7 @@ void SortStage::prepare(CompileCtx& ctx) {
         uassert(4822812, str::stream() << "duplicate field: " << slot, inserted);
 
         _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        _outAccessors.emplace(slot, std::make_unique<SortKeyAccessor>(_stIt, counter++));
+        _outAccessors.emplace(slot, std::make_unique<SortKeyAccessor>(_outputRow, counter++));
     }
 
     counter = 0;
@@ -80,7 +129,7 @@ void SortStage::prepare(CompileCtx& ctx) {
         uassert(4822813, str::stream() << "duplicate field: " << slot, inserted);
 
         _inValueAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        _outAccessors.emplace(slot, std::make_unique<SortValueAccessor>(_stIt, counter++));
+        _outAccessors.emplace(slot, std::make_unique<SortValueAccessor>(_outputRow, counter++));
     }
 }
 
@@ -92,31 +141,74 @@ value::SlotAccessor* SortStage::getAccessor(CompileCtx& ctx, value::SlotId slot)
     return ctx.getAccessor(slot);
 }
 
+bool SortStage::samePrefix(const value::MaterializedRow& lhs,
+                           const value::MaterializedRow& rhs) const {
+    for (size_t idx = 0; idx < _sortedPrefixLength; ++idx) {
+        auto [lhsTag, lhsVal] = lhs._fields[idx].getViewOfValue();
+        auto [rhsTag, rhsVal] = rhs._fields[idx].getViewOfValue();
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        if (tag != value::TypeTags::NumberInt32 || val != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void SortStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
+    _outputRow = boost::none;
+    _nextRunRow = boost::none;
+    _childIsEOF = false;
+    _numReturned = 0;
+
+    loadRun();
+}
+
+SortOptions SortStage::makeSortOptions() const {
+    // Each run only needs to hold as many rows as are still to be returned, so a limited sort keeps
+    // no more than that many rows in the sorter.
+    const size_t runLimit =
+        _limit != std::numeric_limits<size_t>::max() ? _limit - _numReturned : 0;
+
+    return SortOptions()
+        .Limit(runLimit)
+        .MaxMemoryUsageBytes(_maxMemoryUsageBytes)
+        .ExtSortAllowed(_allowDiskUse)
+        .TempDir(_tempDir);
+}
+
+void SortStage::loadRun() {
+    _sorterIt.reset();
+    _sorter.reset(SorterType::make(makeSortOptions(), SortKeyComparator{_dirs}));
+
+    // The keys of the first row of the run, against which the rows that follow are checked to find
+    // where the run ends.
+    boost::optional<value::MaterializedRow> runKeys;
+    if (_nextRunRow) {
+        _sorter->add(_nextRunRow->first, _nextRunRow->second);
+        runKeys = std::move(_nextRunRow->first);
+        _nextRunRow = boost::none;
+    }
+
+    // The sorter copies the rows which it retains, so the rows passed to it only hold views of the
+    // child's values.
     value::MaterializedRow keys;
     value::MaterializedRow vals;
+    keys._fields.resize(_inKeyAccessors.size());
+    vals._fields.resize(_inValueAccessors.size());
 
     while (_children[0]->getNext() == PlanState::ADVANCED) {
-        keys._fields.reserve(_inKeyAccessors.size());
-        vals._fields.reserve(_inValueAccessors.size());
-
-        for (auto accesor : _inKeyAccessors) {
-            keys._fields.push_back(value::OwnedValueAccessor{});
-            auto [tag, val] = accesor->copyOrMoveValue();
-            keys._fields.back().reset(true, tag, val);
-        }
-        for (auto accesor : _inValueAccessors) {
-            vals._fields.push_back(value::OwnedValueAccessor{});
-            auto [tag, val] = accesor->copyOrMoveValue();
-            vals._fields.back().reset(true, tag, val);
+        for (size_t idx = 0; idx < _inKeyAccessors.size(); ++idx) {
+            auto [tag, val] = _inKeyAccessors[idx]->getViewOfValue();
+            keys._fields[idx].reset(false, tag, val);
         }
-
-        _st.emplace(std::move(keys), std::move(vals));
-        if (_st.size() - 1 == _limit) {
-            _st.erase(--_st.end());
+        for (size_t idx = 0; idx < _inValueAccessors.size(); ++idx) {
+            auto [tag, val] = _inValueAccessors[idx]->getViewOfValue();
+            vals._fields[idx].reset(false, tag, val);
         }
 
         if (_tracker && _tracker->trackProgress<TrialRunProgressTracker::kNumResults>(1)) {
@@ -129,43 +221,73 @@ void SortStage::open(bool reOpen) {
             // special is mechanism to stop the trial run without affecting the plan stats of the
             // higher level stages.
             _tracker = nullptr;
+            _childIsEOF = true;
             _children[0]->close();
             uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit");
         }
+
+        if (_sortedPrefixLength > 0) {
+            if (!runKeys) {
+                runKeys = keys.getOwned();
+            } else if (!samePrefix(*runKeys, keys)) {
+                // This row starts the next run. Hold on to it and return the current run first.
+                _nextRunRow.emplace(keys.getOwned(), vals.getOwned());
+                break;
+            }
+        }
+
+        _sorter->add(keys, vals);
     }
 
-    _children[0]->close();
+    if (!_nextRunRow) {
+        _childIsEOF = true;
+        _children[0]->close();
+    }
 
-    _stIt = _st.end();
+    _sorterIt.reset(_sorter->done());
+    _specificStats.wasDiskUsed = _specificStats.wasDiskUsed || _sorter->usedDisk();
 }
 
 PlanState SortStage::getNext() {
-    if (_stIt == _st.end()) {
-        _stIt = _st.begin();
-    } else {
-        ++_stIt;
+    if (_numReturned == _limit) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    if (!_sorterIt->more() && !_childIsEOF) {
+        // The current run has been exhausted, so move on to the next one.
+        loadRun();
     }
 
-    if (_stIt == _st.end()) {
+    if (!_sorterIt->more()) {
         return trackPlanState(PlanState::IS_EOF);
     }
 
+    _outputRow = _sorterIt->next();
+    ++_numReturned;
     return trackPlanState(PlanState::ADVANCED);
 }
 
 void SortStage::close() {
     _commonStats.closes++;
-    _st.clear();
+    if (!_childIsEOF) {
+        _children[0]->close();
+        _childIsEOF = true;
+    }
+    _outputRow = boost::none;
+    _sorterIt.reset();
+    _sorter.reset();
+    _nextRunRow = boost::none;
 }
 
 std::unique_ptr<PlanStageStats> SortStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<SortStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     return ret;
 }
 
 const SpecificStats* SortStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> SortStage::debugPrint() const {
@@ -196,6 +318,11 @@ std::vector<DebugPrinter::Block> SortStage::debugPrint() const {
         ret.emplace_back(std::to_string(_limit));
     }
 
+    if (_sortedPrefixLength > 0) {
+        DebugPrinter::addKeyword(ret, "prefix");
+        ret.emplace_back(std::to_string(_sortedPrefixLength));
+    }
+
     DebugPrinter::addNewLine(ret);
     DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
 
@@ -203,3 +330,6 @@ std::vector<DebugPrinter::Block> SortStage::debugPrint() const {
 }
 }  // namespace sbe
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
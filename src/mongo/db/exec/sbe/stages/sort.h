@@ -29,10 +29,26 @@
 
 #pragma once
 
+#include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/trial_run_progress_tracker.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo::sbe {
+/**
+ * Sorts the rows produced by 'input' by the values in the 'obs' slots, returning at most 'limit'
+ * rows.
+ *
+ * If 'sortedPrefixLength' is non-zero, 'input' must produce its rows already ordered by the first
+ * 'sortedPrefixLength' slots in 'obs'. In that case only each run of rows sharing the same values
+ * in those slots is sorted, and 'input' is no longer read once 'limit' rows have been returned.
+ *
+ * The rows are buffered in a Sorter, which only retains the best 'limit' rows of each run when a
+ * limit is given. The memory it uses is bounded by the
+ * 'internalQueryMaxBlockingSortMemoryUsageBytes' knob. Once the limit is exceeded, the buffered rows
+ * are spilled to a sorted file under 'tempDir' and merged back when the run is returned if
+ * 'allowDiskUse' is true, or the query fails otherwise.
+ */
 class SortStage final : public PlanStage {
 public:
     SortStage(std::unique_ptr<PlanStage> input,
@@ -40,7 +56,10 @@ public:
               std::vector<value::SortDirection> dirs,
               value::SlotVector vals,
               size_t limit,
-              TrialRunProgressTracker* tracker);
+              bool allowDiskUse,
+              std::string tempDir,
+              TrialRunProgressTracker* tracker,
+              size_t sortedPrefixLength = 0);
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -55,24 +74,68 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
-    using TableType = std::
-        multimap<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowComparator>;
+    using SorterType = Sorter<value::MaterializedRow, value::MaterializedRow>;
+    using SorterData = SorterType::Data;
+
+    using SortKeyAccessor = value::MaterializedRowKeyAccessor<boost::optional<SorterData>>;
+    using SortValueAccessor = value::MaterializedRowValueAccessor<boost::optional<SorterData>>;
+
+    /**
+     * Compares the keys of two rows in the manner expected by the Sorter, returning a value less
+     * than, equal to or greater than zero.
+     */
+    class SortKeyComparator {
+    public:
+        SortKeyComparator(const std::vector<value::SortDirection>& dirs) : _dirs(dirs) {}
+
+        int operator()(const SorterData& lhs, const SorterData& rhs) const;
 
-    using SortKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
-    using SortValueAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
+    private:
+        const std::vector<value::SortDirection>& _dirs;
+    };
+
+    /**
+     * Loads the next run of rows from the child into a new sorter, starting with the row which
+     * ended the previous run, if any, and positions '_sorterIt' at the start of the sorted run.
+     */
+    void loadRun();
+
+    SortOptions makeSortOptions() const;
+
+    /**
+     * Returns true if the rows with keys 'lhs' and 'rhs' belong to the same run.
+     */
+    bool samePrefix(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) const;
 
     const value::SlotVector _obs;
     const std::vector<value::SortDirection> _dirs;
     const value::SlotVector _vals;
     const size_t _limit;
+    const bool _allowDiskUse;
+    const std::string _tempDir;
+    const size_t _maxMemoryUsageBytes;
+    const size_t _sortedPrefixLength;
 
     std::vector<value::SlotAccessor*> _inKeyAccessors;
     std::vector<value::SlotAccessor*> _inValueAccessors;
 
     value::SlotMap<std::unique_ptr<value::SlotAccessor>> _outAccessors;
 
-    TableType _st;
-    TableType::iterator _stIt;
+    // The iterator must not outlive the sorter, so it is declared after it.
+    std::unique_ptr<SorterType> _sorter;
+    std::unique_ptr<SorterType::Iterator> _sorterIt;
+
+    // The row most recently returned from '_sorterIt', which the output accessors read from.
+    boost::optional<SorterData> _outputRow;
+
+    // The keys and values of the first row of the next run, which was read from the child while
+    // loading the current run.
+    boost::optional<std::pair<value::MaterializedRow, value::MaterializedRow>> _nextRunRow;
+
+    bool _childIsEOF{false};
+    size_t _numReturned{0};
+
+    SortStats _specificStats;
 
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
@@ -119,7 +119,7 @@ std::pair<value::TypeTags, value::Value> convertFrom(bool view,
             // len includes trailing zero.
             auto len = ConstDataView(be).read<LittleEndian<uint32_t>>();
             be += sizeof(len);
-            if (len < value::kSmallStringThreshold) {
+            if (len <= value::kSmallStringThreshold) {
                 value::Value smallString;
                 // Copy 8 bytes fast if we have space.
                 if (be + 8 < end) {
@@ -0,0 +1,256 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/slot.h"
+
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo::sbe::value {
+namespace {
+void serializeValue(BufBuilder& buf, TypeTags tag, Value val);
+
+std::pair<TypeTags, Value> deserializeValue(BufReader& buf);
+
+void serializeString(BufBuilder& buf, std::string_view str) {
+    buf.appendNum(static_cast<int>(str.size()));
+    buf.appendBuf(str.data(), str.size());
+}
+
+std::string_view deserializeString(BufReader& buf) {
+    auto size = buf.read<LittleEndian<int>>();
+    return {static_cast<const char*>(buf.skip(size)), static_cast<size_t>(size)};
+}
+
+void serializeValue(BufBuilder& buf, TypeTags tag, Value val) {
+    buf.appendUChar(static_cast<uint8_t>(tag));
+
+    switch (tag) {
+        case TypeTags::Nothing:
+        case TypeTags::Null:
+            break;
+        case TypeTags::NumberInt32:
+            buf.appendNum(bitcastTo<int32_t>(val));
+            break;
+        case TypeTags::NumberInt64:
+        case TypeTags::Date:
+            buf.appendNum(static_cast<long long>(bitcastTo<int64_t>(val)));
+            break;
+        case TypeTags::Timestamp:
+            buf.appendNum(static_cast<unsigned long long>(bitcastTo<uint64_t>(val)));
+            break;
+        case TypeTags::NumberDouble:
+            buf.appendNum(bitcastTo<double>(val));
+            break;
+        case TypeTags::NumberDecimal:
+            buf.appendNum(bitcastTo<Decimal128>(val));
+            break;
+        case TypeTags::Boolean:
+            buf.appendChar(val != 0);
+            break;
+        case TypeTags::StringSmall:
+        case TypeTags::StringBig:
+        case TypeTags::bsonString:
+            serializeString(buf, getStringView(tag, val));
+            break;
+        case TypeTags::ObjectId:
+            buf.appendBuf(getObjectIdView(val)->data(), sizeof(ObjectIdType));
+            break;
+        case TypeTags::bsonObjectId:
+            buf.appendBuf(getRawPointerView(val), sizeof(ObjectIdType));
+            break;
+        case TypeTags::bsonObject:
+        case TypeTags::bsonArray: {
+            auto bson = getRawPointerView(val);
+            buf.appendBuf(bson, ConstDataView(bson).read<LittleEndian<uint32_t>>());
+            break;
+        }
+        case TypeTags::Array: {
+            auto arr = getArrayView(val);
+            buf.appendNum(static_cast<int>(arr->size()));
+            for (size_t idx = 0; idx < arr->size(); ++idx) {
+                auto [elemTag, elemVal] = arr->getAt(idx);
+                serializeValue(buf, elemTag, elemVal);
+            }
+            break;
+        }
+        case TypeTags::ArraySet: {
+            auto arrSet = getArraySetView(val);
+            buf.appendNum(static_cast<int>(arrSet->size()));
+            for (auto& [elemTag, elemVal] : arrSet->values()) {
+                serializeValue(buf, elemTag, elemVal);
+            }
+            break;
+        }
+        case TypeTags::Object: {
+            auto obj = getObjectView(val);
+            buf.appendNum(static_cast<int>(obj->size()));
+            for (size_t idx = 0; idx < obj->size(); ++idx) {
+                serializeString(buf, obj->field(idx));
+                auto [fieldTag, fieldVal] = obj->getAt(idx);
+                serializeValue(buf, fieldTag, fieldVal);
+            }
+            break;
+        }
+        case TypeTags::ksValue: {
+            auto ks = getKeyStringView(val);
+            buf.appendUChar(static_cast<uint8_t>(ks->getVersion()));
+            ks->serializeForSorter(buf);
+            break;
+        }
+        default:
+            uasserted(5150100,
+                      str::stream() << "cannot spill value of type: " << static_cast<int>(tag));
+    }
+}
+
+std::pair<TypeTags, Value> deserializeValue(BufReader& buf) {
+    auto tag = static_cast<TypeTags>(buf.read<uint8_t>());
+
+    switch (tag) {
+        case TypeTags::Nothing:
+        case TypeTags::Null:
+            return {tag, 0};
+        case TypeTags::NumberInt32:
+            return {tag, bitcastFrom(buf.read<LittleEndian<int32_t>>().value)};
+        case TypeTags::NumberInt64:
+        case TypeTags::Date:
+            return {tag, bitcastFrom(buf.read<LittleEndian<int64_t>>().value)};
+        case TypeTags::Timestamp:
+            return {tag, bitcastFrom(buf.read<LittleEndian<uint64_t>>().value)};
+        case TypeTags::NumberDouble:
+            return {tag, bitcastFrom(buf.read<LittleEndian<double>>().value)};
+        case TypeTags::NumberDecimal: {
+            Decimal128::Value decimal;
+            decimal.low64 = buf.read<LittleEndian<uint64_t>>();
+            decimal.high64 = buf.read<LittleEndian<uint64_t>>();
+            return makeCopyDecimal(Decimal128{decimal});
+        }
+        case TypeTags::Boolean:
+            return {tag, bitcastFrom(buf.read<char>() != 0)};
+        case TypeTags::StringSmall:
+        case TypeTags::StringBig:
+        case TypeTags::bsonString:
+            return makeNewString(deserializeString(buf));
+        case TypeTags::ObjectId:
+        case TypeTags::bsonObjectId: {
+            auto [oidTag, oidVal] = makeNewObjectId();
+            memcpy(getObjectIdView(oidVal)->data(),
+                   buf.skip(sizeof(ObjectIdType)),
+                   sizeof(ObjectIdType));
+            return {oidTag, oidVal};
+        }
+        case TypeTags::bsonObject:
+        case TypeTags::bsonArray: {
+            auto size = buf.peek<LittleEndian<uint32_t>>();
+            auto dst = new uint8_t[size];
+            memcpy(dst, buf.skip(size), size);
+            return {tag, bitcastFrom(dst)};
+        }
+        case TypeTags::Array: {
+            auto [arrTag, arrVal] = makeNewArray();
+            ValueGuard guard{arrTag, arrVal};
+            auto arr = getArrayView(arrVal);
+            auto size = buf.read<LittleEndian<int>>();
+            arr->reserve(size);
+            for (int idx = 0; idx < size; ++idx) {
+                auto [elemTag, elemVal] = deserializeValue(buf);
+                arr->push_back(elemTag, elemVal);
+            }
+            guard.reset();
+            return {arrTag, arrVal};
+        }
+        case TypeTags::ArraySet: {
+            auto [arrTag, arrVal] = makeNewArraySet();
+            ValueGuard guard{arrTag, arrVal};
+            auto arrSet = getArraySetView(arrVal);
+            auto size = buf.read<LittleEndian<int>>();
+            arrSet->reserve(size);
+            for (int idx = 0; idx < size; ++idx) {
+                auto [elemTag, elemVal] = deserializeValue(buf);
+                arrSet->push_back(elemTag, elemVal);
+            }
+            guard.reset();
+            return {arrTag, arrVal};
+        }
+        case TypeTags::Object: {
+            auto [objTag, objVal] = makeNewObject();
+            ValueGuard guard{objTag, objVal};
+            auto obj = getObjectView(objVal);
+            auto size = buf.read<LittleEndian<int>>();
+            obj->reserve(size);
+            for (int idx = 0; idx < size; ++idx) {
+                auto name = deserializeString(buf);
+                auto [fieldTag, fieldVal] = deserializeValue(buf);
+                obj->push_back(name, fieldTag, fieldVal);
+            }
+            guard.reset();
+            return {objTag, objVal};
+        }
+        case TypeTags::ksValue: {
+            auto version = static_cast<KeyString::Version>(buf.read<uint8_t>());
+            return makeCopyKeyString(KeyString::Value::deserializeForSorter(buf, {version}));
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+}  // namespace
+
+size_t MaterializedRow::memUsage() const {
+    size_t result = sizeof(MaterializedRow);
+    for (auto& f : _fields) {
+        auto [tag, val] = f.getViewOfValue();
+        result += sizeof(OwnedValueAccessor) + getApproximateSize(tag, val);
+    }
+    return result;
+}
+
+void MaterializedRow::serializeForSorter(BufBuilder& buf) const {
+    buf.appendNum(static_cast<int>(_fields.size()));
+    for (auto& f : _fields) {
+        auto [tag, val] = f.getViewOfValue();
+        serializeValue(buf, tag, val);
+    }
+}
+
+MaterializedRow MaterializedRow::deserializeForSorter(BufReader& buf,
+                                                      const SorterDeserializeSettings&) {
+    MaterializedRow result;
+    auto size = buf.read<LittleEndian<int>>();
+    result._fields.resize(size);
+    for (auto& f : result._fields) {
+        auto [tag, val] = deserializeValue(buf);
+        f.reset(tag, val);
+    }
+    return result;
+}
+}  // namespace mongo::sbe::value
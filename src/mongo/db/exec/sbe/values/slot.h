@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/util/bufreader.h"
 
 namespace mongo::sbe::value {
 /**
@@ -176,6 +178,18 @@ public:
         _owned = owned;
     }
 
+    /**
+     * Replaces an unowned value with an owned copy of it. Owned values are left untouched.
+     */
+    void makeOwned() {
+        if (!_owned) {
+            auto [tag, val] = copyValue(_tag, _val);
+            _tag = tag;
+            _val = val;
+            _owned = true;
+        }
+    }
+
 private:
     void release() {
         if (_owned) {
@@ -315,9 +329,7 @@ private:
 struct MaterializedRow {
     void makeOwned() {
         for (auto& f : _fields) {
-            auto [tag, val] = f.getViewOfValue();
-            auto [copyTag, copyVal] = copyValue(tag, val);
-            f.reset(copyTag, copyVal);
+            f.makeOwned();
         }
     }
 
@@ -335,6 +347,32 @@ struct MaterializedRow {
         return true;
     }
 
+    /**
+     * Returns an estimate of the memory footprint of this row, including the values it owns.
+     */
+    size_t memUsage() const;
+
+    /**
+     * Members for Sorter. These allow materialized rows to be spilled to and read back from
+     * temporary files by the stages which must bound their memory consumption.
+     */
+    struct SorterDeserializeSettings {};
+
+    void serializeForSorter(BufBuilder& buf) const;
+
+    static MaterializedRow deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&);
+
+    int memUsageForSorter() const {
+        return memUsage();
+    }
+
+    MaterializedRow getOwned() const {
+        // Copying the row already copies the values owned by this row.
+        auto result = *this;
+        result.makeOwned();
+        return result;
+    }
+
     std::vector<OwnedValueAccessor> _fields;
 };
 
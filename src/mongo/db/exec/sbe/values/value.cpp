@@ -392,6 +392,60 @@ std::size_t hashValue(TypeTags tag, Value val) noexcept {
     return 0;
 }
 
+std::size_t getApproximateSize(TypeTags tag, Value val) {
+    size_t result = 0;
+    switch (tag) {
+        case TypeTags::NumberDecimal:
+            result = sizeof(Decimal128);
+            break;
+        case TypeTags::StringBig:
+            result = strlen(getBigStringView(val)) + 1;
+            break;
+        case TypeTags::ObjectId:
+        case TypeTags::bsonObjectId:
+            result = sizeof(ObjectIdType);
+            break;
+        case TypeTags::bsonObject:
+        case TypeTags::bsonArray:
+        case TypeTags::bsonString:
+            result = ConstDataView(getRawPointerView(val)).read<LittleEndian<uint32_t>>();
+            break;
+        case TypeTags::Array: {
+            auto arr = getArrayView(val);
+            result = sizeof(Array);
+            for (size_t idx = 0; idx < arr->size(); ++idx) {
+                auto [elemTag, elemVal] = arr->getAt(idx);
+                result += sizeof(TypeTags) + sizeof(Value) + getApproximateSize(elemTag, elemVal);
+            }
+            break;
+        }
+        case TypeTags::ArraySet: {
+            auto arrSet = getArraySetView(val);
+            result = sizeof(ArraySet);
+            for (auto& [elemTag, elemVal] : arrSet->values()) {
+                result += sizeof(TypeTags) + sizeof(Value) + getApproximateSize(elemTag, elemVal);
+            }
+            break;
+        }
+        case TypeTags::Object: {
+            auto obj = getObjectView(val);
+            result = sizeof(Object);
+            for (size_t idx = 0; idx < obj->size(); ++idx) {
+                auto [fieldTag, fieldVal] = obj->getAt(idx);
+                result += sizeof(TypeTags) + sizeof(Value) + sizeof(std::string) +
+                    obj->field(idx).size() + getApproximateSize(fieldTag, fieldVal);
+            }
+            break;
+        }
+        case TypeTags::ksValue:
+            result = sizeof(KeyString::Value) + getKeyStringView(val)->memUsageForSorter();
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
 
 /**
  * Performs a three-way comparison for any type that has < and == operators. Additionally,
@@ -144,6 +144,12 @@ std::pair<TypeTags, Value> copyValue(TypeTags tag, Value val);
 void printValue(std::ostream& os, TypeTags tag, Value val);
 std::size_t hashValue(TypeTags tag, Value val) noexcept;
 
+/**
+ * Returns an estimate of the number of bytes of memory occupied by the given value, including any
+ * out-of-line storage it owns. Blocking stages use this to enforce their memory limits.
+ */
+std::size_t getApproximateSize(TypeTags tag, Value val);
+
 /**
  * Three ways value comparison (aka spaceship operator).
  */
@@ -380,7 +386,9 @@ private:
     SetType _values;
 };
 
-constexpr size_t kSmallStringThreshold = 8;
+// Strings which fit in a Value together with their terminating zero, i.e. of up to 7 characters,
+// are stored inline as StringSmall instead of being heap-allocated.
+constexpr size_t kSmallStringThreshold = sizeof(Value);
 using ObjectIdType = std::array<uint8_t, 12>;
 static_assert(sizeof(ObjectIdType) == 12);
 
@@ -464,7 +472,7 @@ inline std::string_view getStringView(TypeTags tag, Value& val) noexcept {
 
 inline std::pair<TypeTags, Value> makeNewString(std::string_view input) {
     size_t len = input.size();
-    if (len < kSmallStringThreshold - 1) {
+    if (len < kSmallStringThreshold) {
         Value smallString;
         // This is OK - we are aliasing to char*.
         auto stringAlias = getSmallStringView(smallString);
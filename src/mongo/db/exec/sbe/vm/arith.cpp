@@ -35,10 +35,51 @@ namespace vm {
 
 using namespace value;
 
+namespace {
+/**
+ * Most arithmetic in queries combines two values of the same numeric type. For int32, int64 and
+ * double operands this applies 'op' directly to the values, skipping the type widening done on the
+ * generic path. Returns false if the fast path does not apply to the given operands.
+ */
+template <typename Op>
+MONGO_COMPILER_ALWAYS_INLINE bool sameTypeArithmetic(value::TypeTags lhsTag,
+                                                     value::Value lhsValue,
+                                                     value::TypeTags rhsTag,
+                                                     value::Value rhsValue,
+                                                     Op op,
+                                                     value::Value& result) {
+    if (lhsTag != rhsTag) {
+        return false;
+    }
+
+    switch (lhsTag) {
+        case value::TypeTags::NumberInt32:
+            result = value::bitcastFrom<int32_t>(
+                op(value::bitcastTo<int32_t>(lhsValue), value::bitcastTo<int32_t>(rhsValue)));
+            return true;
+        case value::TypeTags::NumberInt64:
+            result = value::bitcastFrom<int64_t>(
+                op(value::bitcastTo<int64_t>(lhsValue), value::bitcastTo<int64_t>(rhsValue)));
+            return true;
+        case value::TypeTags::NumberDouble:
+            result = value::bitcastFrom<double>(
+                op(value::bitcastTo<double>(lhsValue), value::bitcastTo<double>(rhsValue)));
+            return true;
+        default:
+            return false;
+    }
+}
+}  // namespace
+
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::genericAdd(value::TypeTags lhsTag,
                                                                      value::Value lhsValue,
                                                                      value::TypeTags rhsTag,
                                                                      value::Value rhsValue) {
+    value::Value result;
+    if (sameTypeArithmetic(lhsTag, lhsValue, rhsTag, rhsValue, std::plus<>{}, result)) {
+        return {false, lhsTag, result};
+    }
+
     if (value::isNumber(lhsTag) && value::isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
             case value::TypeTags::NumberInt32: {
@@ -74,6 +115,11 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::genericSub(value::Type
                                                                      value::Value lhsValue,
                                                                      value::TypeTags rhsTag,
                                                                      value::Value rhsValue) {
+    value::Value result;
+    if (sameTypeArithmetic(lhsTag, lhsValue, rhsTag, rhsValue, std::minus<>{}, result)) {
+        return {false, lhsTag, result};
+    }
+
     if (value::isNumber(lhsTag) && value::isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
             case value::TypeTags::NumberInt32: {
@@ -109,6 +155,11 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::genericMul(value::Type
                                                                      value::Value lhsValue,
                                                                      value::TypeTags rhsTag,
                                                                      value::Value rhsValue) {
+    value::Value result;
+    if (sameTypeArithmetic(lhsTag, lhsValue, rhsTag, rhsValue, std::multiplies<>{}, result)) {
+        return {false, lhsTag, result};
+    }
+
     if (value::isNumber(lhsTag) && value::isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
             case value::TypeTags::NumberInt32: {
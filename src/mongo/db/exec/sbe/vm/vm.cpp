@@ -75,6 +75,7 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -1,  // fillEmpty
 
     -1,  // getField
+    0,   // getFieldImm
 
     -1,  // sum
     -1,  // min
@@ -234,6 +235,18 @@ void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetField(value::TypeTags fieldTag, value::Value fieldVal) {
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(fieldTag) + sizeof(fieldVal));
+
+    offset += value::writeToMemory(offset, i);
+    offset += value::writeToMemory(offset, fieldTag);
+    offset += value::writeToMemory(offset, fieldVal);
+}
+
 void CodeFragment::appendSum() {
     appendSimpleInstruction(Instruction::aggSum);
 }
@@ -1125,6 +1138,23 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(CodeFragment* c
                     }
                     break;
                 }
+                case Instruction::getFieldImm: {
+                    auto fieldTag = value::readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(fieldTag);
+                    auto fieldVal = value::readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(fieldVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldTag, fieldVal);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    break;
+                }
                 case Instruction::aggSum: {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
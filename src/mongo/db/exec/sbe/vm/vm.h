@@ -45,6 +45,28 @@ std::pair<value::TypeTags, value::Value> genericNumericCompare(value::TypeTags l
                                                                value::TypeTags rhsTag,
                                                                value::Value rhsValue,
                                                                Op op) {
+    // Fast path for the common case of comparing two values of the same non-decimal numeric type.
+    if (lhsTag == rhsTag) {
+        switch (lhsTag) {
+            case value::TypeTags::NumberInt32: {
+                auto result =
+                    op(value::bitcastTo<int32_t>(lhsValue), value::bitcastTo<int32_t>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom(result)};
+            }
+            case value::TypeTags::NumberInt64: {
+                auto result =
+                    op(value::bitcastTo<int64_t>(lhsValue), value::bitcastTo<int64_t>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom(result)};
+            }
+            case value::TypeTags::NumberDouble: {
+                auto result =
+                    op(value::bitcastTo<double>(lhsValue), value::bitcastTo<double>(rhsValue));
+                return {value::TypeTags::Boolean, value::bitcastFrom(result)};
+            }
+            default:
+                break;
+        }
+    }
 
     if (value::isNumber(lhsTag) && value::isNumber(rhsTag)) {
         switch (getWidestNumericalType(lhsTag, rhsTag)) {
@@ -125,6 +147,9 @@ struct Instruction {
         fillEmpty,
 
         getField,
+        // getField with the field name encoded in the instruction itself. This fuses the common
+        // 'pushConstVal; getField' sequence into a single dispatch.
+        getFieldImm,
 
         aggSum,
         aggMin,
@@ -222,6 +247,7 @@ public:
         appendSimpleInstruction(Instruction::fillEmpty);
     }
     void appendGetField();
+    void appendGetField(value::TypeTags fieldTag, value::Value fieldVal);
     void appendSum();
     void appendMin();
     void appendMax();
@@ -38,15 +38,34 @@ namespace mongo {
 SortStage::SortStage(boost::intrusive_ptr<ExpressionContext> expCtx,
                      WorkingSet* ws,
                      SortPattern sortPattern,
+                     uint64_t limit,
+                     size_t sortedPrefixLength,
                      bool addSortKeyMetadata,
                      std::unique_ptr<PlanStage> child)
     : PlanStage(kStageType.rawData(), expCtx.get()),
       _ws(ws),
       _sortKeyGen(sortPattern, expCtx->getCollator()),
-      _addSortKeyMetadata(addSortKeyMetadata) {
+      _addSortKeyMetadata(addSortKeyMetadata),
+      _limit(limit),
+      _sortedPrefixLength(sortedPrefixLength) {
+    invariant(_sortedPrefixLength < sortPattern.size());
     _children.emplace_back(std::move(child));
 }
 
+bool SortStage::samePrefix(const Value& lhs, const Value& rhs) const {
+    // A non-empty prefix is always shorter than the sort pattern, so the sort keys are arrays.
+    invariant(lhs.isArray() && rhs.isArray());
+    const auto& lhsArr = lhs.getArray();
+    const auto& rhsArr = rhs.getArray();
+    for (size_t i = 0; i < _sortedPrefixLength; ++i) {
+        // The sort keys have already had the collation applied, so they are compared without one.
+        if (Value::compare(lhsArr[i], rhsArr[i], nullptr) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     if (isEOF()) {
         return PlanStage::IS_EOF;
@@ -59,11 +78,24 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
         if (code == PlanStage::ADVANCED) {
             // The plan must be structured such that a previous stage has attached the sort key
             // metadata.
-            spool(id);
+            auto sortKey = computeSortKey(id);
+            if (_sortedPrefixLength > 0) {
+                if (!_runSortKey) {
+                    _runSortKey = sortKey;
+                } else if (!samePrefix(*_runSortKey, sortKey)) {
+                    // This member starts the next run. Hold on to it and sort the current run.
+                    _nextRunMember.emplace(std::move(sortKey), id);
+                    _populated = true;
+                    loadingDone();
+                    return PlanStage::NEED_TIME;
+                }
+            }
+            spool(std::move(sortKey), id);
             return PlanStage::NEED_TIME;
         } else if (code == PlanStage::IS_EOF) {
             // The child has returned all of its results. Record this fact so that subsequent calls
             // to 'doWork()' will perform sorting and unspool the sorted results.
+            _childIsEOF = true;
             _populated = true;
             loadingDone();
             return PlanStage::NEED_TIME;
@@ -74,14 +106,40 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
         return code;
     }
 
-    return unspool(out);
+    const StageState code = unspool(out);
+    if (code == PlanStage::ADVANCED) {
+        if (_limit > 0 && ++_numReturned == _limit) {
+            _isEOF = true;
+        }
+        return code;
+    }
+
+    invariant(code == PlanStage::IS_EOF);
+    if (_childIsEOF) {
+        _isEOF = true;
+        return code;
+    }
+
+    // The current run has been exhausted. Start loading the next one, beginning with the member
+    // which ended the previous run.
+    invariant(_nextRunMember);
+    startNextRun();
+    _populated = false;
+    auto [sortKey, id] = std::move(*_nextRunMember);
+    _nextRunMember.reset();
+    _runSortKey = sortKey;
+    spool(std::move(sortKey), id);
+    return PlanStage::NEED_TIME;
 }
 
 std::unique_ptr<PlanStageStats> SortStage::getStats() {
     _commonStats.isEOF = isEOF();
     std::unique_ptr<PlanStageStats> ret =
         std::make_unique<PlanStageStats>(_commonStats, stageType());
-    ret->specific = std::unique_ptr<SpecificStats>{getSpecificStats()->clone()};
+    auto sortStats = std::unique_ptr<SortStats>{
+        static_cast<SortStats*>(getSpecificStats()->clone())};
+    sortStats->sortedPrefixLength = _sortedPrefixLength;
+    ret->specific = std::move(sortStats);
     ret->children.emplace_back(child()->getStats());
     return ret;
 }
@@ -92,17 +150,27 @@ SortStageDefault::SortStageDefault(boost::intrusive_ptr<ExpressionContext> expCt
                                    uint64_t limit,
                                    uint64_t maxMemoryUsageBytes,
                                    bool addSortKeyMetadata,
-                                   std::unique_ptr<PlanStage> child)
-    : SortStage(expCtx, ws, sortPattern, addSortKeyMetadata, std::move(child)),
+                                   std::unique_ptr<PlanStage> child,
+                                   size_t sortedPrefixLength)
+    : SortStage(expCtx,
+                ws,
+                sortPattern,
+                limit,
+                sortedPrefixLength,
+                addSortKeyMetadata,
+                std::move(child)),
       _sortExecutor(std::move(sortPattern),
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
                     expCtx->allowDiskUse) {}
 
-void SortStageDefault::spool(WorkingSetID wsid) {
+Value SortStageDefault::computeSortKey(WorkingSetID wsid) const {
+    return _sortKeyGen.computeSortKey(*_ws->get(wsid));
+}
+
+void SortStageDefault::spool(Value sortKey, WorkingSetID wsid) {
     SortableWorkingSetMember extractedMember{_ws->extract(wsid)};
-    auto sortKey = _sortKeyGen.computeSortKey(*extractedMember);
     _sortExecutor.add(sortKey, extractedMember);
 }
 
@@ -128,22 +196,32 @@ SortStageSimple::SortStageSimple(boost::intrusive_ptr<ExpressionContext> expCtx,
                                  uint64_t limit,
                                  uint64_t maxMemoryUsageBytes,
                                  bool addSortKeyMetadata,
-                                 std::unique_ptr<PlanStage> child)
-    : SortStage(expCtx, ws, sortPattern, addSortKeyMetadata, std::move(child)),
+                                 std::unique_ptr<PlanStage> child,
+                                 size_t sortedPrefixLength)
+    : SortStage(expCtx,
+                ws,
+                sortPattern,
+                limit,
+                sortedPrefixLength,
+                addSortKeyMetadata,
+                std::move(child)),
       _sortExecutor(std::move(sortPattern),
                     limit,
                     maxMemoryUsageBytes,
                     expCtx->tempDir,
                     expCtx->allowDiskUse) {}
 
-void SortStageSimple::spool(WorkingSetID wsid) {
+Value SortStageSimple::computeSortKey(WorkingSetID wsid) const {
     auto member = _ws->get(wsid);
     invariant(!member->metadata());
     invariant(!member->doc.value().metadata());
     invariant(member->hasObj());
 
-    auto sortKey = _sortKeyGen.computeSortKeyFromDocument(member->doc.value());
+    return _sortKeyGen.computeSortKeyFromDocument(member->doc.value());
+}
 
+void SortStageSimple::spool(Value sortKey, WorkingSetID wsid) {
+    auto member = _ws->get(wsid);
     _sortExecutor.add(std::move(sortKey), member->doc.value().toBson());
     _ws->free(wsid);
 }
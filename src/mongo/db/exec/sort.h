@@ -46,6 +46,12 @@ namespace mongo {
  * 'addSortKeyMetadata' is true, then also attaches the sort key as metadata. This could be consumed
  * downstream for a sort-merge on a merging node, or by a $meta:"sortKey" expression.
  *
+ * If 'sortedPrefixLength' is non-zero, the child must return its results in order of the first
+ * 'sortedPrefixLength' fields of the sort pattern, such as when the child is an index scan over
+ * those fields. The stage then only sorts each run of results sharing the same prefix, returning
+ * the run before reading the next one, and stops reading from the child as soon as 'limit' results
+ * have been returned.
+ *
  * Concrete implementations derive from this abstract base class by implementing methods for
  * spooling and unspooling.
  */
@@ -56,22 +62,36 @@ public:
     SortStage(boost::intrusive_ptr<ExpressionContext> expCtx,
               WorkingSet* ws,
               SortPattern sortPattern,
+              uint64_t limit,
+              size_t sortedPrefixLength,
               bool addSortKeyMetadata,
               std::unique_ptr<PlanStage> child);
 
     /**
-     * Loads the WorkingSetMember pointed to by 'wsid' into the set of objects being sorted. This
-     * should be called repeatedly until all documents are loaded, followed by a single call to
-     * 'loadingDone()'. Illegal to call after 'loadingDone()' has been called.
+     * Computes the sort key of the WorkingSetMember pointed to by 'wsid'.
+     */
+    virtual Value computeSortKey(WorkingSetID wsid) const = 0;
+
+    /**
+     * Loads the WorkingSetMember pointed to by 'wsid', whose sort key is 'sortKey', into the set of
+     * objects being sorted. This should be called repeatedly until all documents are loaded,
+     * followed by a single call to 'loadingDone()'. Illegal to call after 'loadingDone()' has been
+     * called, unless 'startNextRun()' has been called since.
      */
-    virtual void spool(WorkingSetID wsid) = 0;
+    virtual void spool(Value sortKey, WorkingSetID wsid) = 0;
 
     /**
      * Indicates that all documents to be sorted have been loaded via 'spool()'. This method must
-     * not be called more than once.
+     * not be called more than once per run.
      */
     virtual void loadingDone() = 0;
 
+    /**
+     * Prepares to load the next run of documents once the sorted stream of the current run has been
+     * exhausted.
+     */
+    virtual void startNextRun() = 0;
+
     /**
      * Returns an id referring to the next WorkingSetMember in the sorted stream of results.
      *
@@ -85,6 +105,10 @@ public:
 
     StageState doWork(WorkingSetID* out) final;
 
+    bool isEOF() final {
+        return _isEOF;
+    }
+
     std::unique_ptr<PlanStageStats> getStats() override final;
 
 protected:
@@ -96,8 +120,34 @@ protected:
     const bool _addSortKeyMetadata;
 
 private:
-    // Whether or not we have finished loading data into '_sortExecutor'.
+    /**
+     * Returns true if the sort keys 'lhs' and 'rhs' are equal in their first '_sortedPrefixLength'
+     * components.
+     */
+    bool samePrefix(const Value& lhs, const Value& rhs) const;
+
+    // The number of results to return, or zero if there is no limit.
+    const uint64_t _limit;
+
+    // The number of leading fields of the sort pattern by which the input is already ordered.
+    const size_t _sortedPrefixLength;
+
+    // Whether or not we have finished loading the current run of data into '_sortExecutor'.
     bool _populated = false;
+
+    // Whether or not the child has returned all of its results.
+    bool _childIsEOF = false;
+
+    bool _isEOF = false;
+
+    uint64_t _numReturned = 0;
+
+    // The sort key of the first member in the run being loaded.
+    boost::optional<Value> _runSortKey;
+
+    // The first member of the next run, which was read from the child while loading the current
+    // run, along with its sort key.
+    boost::optional<std::pair<Value, WorkingSetID>> _nextRunMember;
 };
 
 /**
@@ -112,24 +162,27 @@ public:
                      uint64_t limit,
                      uint64_t maxMemoryUsageBytes,
                      bool addSortKeyMetadata,
-                     std::unique_ptr<PlanStage> child);
+                     std::unique_ptr<PlanStage> child,
+                     size_t sortedPrefixLength = 0);
 
-    void spool(WorkingSetID wsid) override final;
+    Value computeSortKey(WorkingSetID wsid) const override final;
+
+    void spool(Value sortKey, WorkingSetID wsid) override final;
 
     void loadingDone() override final {
         _sortExecutor.loadingDone();
     }
 
+    void startNextRun() override final {
+        _sortExecutor.startNextRun();
+    }
+
     StageState unspool(WorkingSetID* out) override final;
 
     StageType stageType() const final {
         return STAGE_SORT_DEFAULT;
     }
 
-    bool isEOF() final {
-        return _sortExecutor.isEOF();
-    }
-
     const SpecificStats* getSpecificStats() const final {
         return &_sortExecutor.stats();
     }
@@ -155,24 +208,27 @@ public:
                     uint64_t limit,
                     uint64_t maxMemoryUsageBytes,
                     bool addSortKeyMetadata,
-                    std::unique_ptr<PlanStage> child);
+                    std::unique_ptr<PlanStage> child,
+                    size_t sortedPrefixLength = 0);
 
-    virtual void spool(WorkingSetID wsid) override final;
+    Value computeSortKey(WorkingSetID wsid) const override final;
+
+    virtual void spool(Value sortKey, WorkingSetID wsid) override final;
 
     void loadingDone() override final {
         _sortExecutor.loadingDone();
     }
 
+    void startNextRun() override final {
+        _sortExecutor.startNextRun();
+    }
+
     virtual StageState unspool(WorkingSetID* out) override final;
 
     StageType stageType() const final {
         return STAGE_SORT_SIMPLE;
     }
 
-    bool isEOF() final {
-        return _sortExecutor.isEOF();
-    }
-
     const SpecificStats* getSpecificStats() const final {
         return &_sortExecutor.stats();
     }
@@ -144,6 +144,15 @@ public:
         _sorter.reset();
     }
 
+    /**
+     * Allows a new set of input documents to be loaded and sorted once the output of the previous
+     * set has been exhausted. The stats continue to accumulate across all sets of input.
+     */
+    void startNextRun() {
+        invariant(_isEOF);
+        _isEOF = false;
+    }
+
     /**
      * Returns true if there are more results which can be returned via 'getNext()', or false to
      * indicate end-of-stream. Should only be called after 'loadingDone()' is called.
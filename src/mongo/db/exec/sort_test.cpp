@@ -67,7 +67,7 @@ public:
 
     /**
      * Test function to verify sort stage. SortStageDefault will be initialized using 'patternStr',
-     * 'collator', and 'limit;.
+     * 'collator', 'limit' and 'sortedPrefixLength'.
      *
      * 'inputStr' represents the input data set in a BSONObj.
      *     {input: [doc1, doc2, doc3, ...]}
@@ -79,7 +79,8 @@ public:
                   CollatorInterface* collator,
                   int limit,
                   const char* inputStr,
-                  const char* expectedStr) {
+                  const char* expectedStr,
+                  size_t sortedPrefixLength = 0) {
         // WorkingSet is not owned by stages
         // so it's fine to declare
         WorkingSet ws;
@@ -117,7 +118,8 @@ public:
                               limit,
                               kMaxMemoryUsageBytes,
                               false,  // addSortKeyMetadata
-                              std::move(sortKeyGen));
+                              std::move(sortKeyGen),
+                              sortedPrefixLength);
 
         WorkingSetID id = WorkingSet::INVALID_ID;
         PlanStage::StageState state = PlanStage::NEED_TIME;
@@ -127,18 +129,24 @@ public:
             state = sort.work(&id);
         }
 
-        // QueuedDataStage's state should be EOF when sort is ready to advance.
-        ASSERT_TRUE(sort.child()->child()->isEOF());
+        // QueuedDataStage's state should be EOF when sort is ready to advance, unless the sort only
+        // has to sort the first run of an input which is already ordered by a prefix.
+        if (sortedPrefixLength == 0) {
+            ASSERT_TRUE(sort.child()->child()->isEOF());
+        }
 
-        // While there's data to be retrieved, state should be equal to ADVANCED.
+        // While there's data to be retrieved, state should be equal to ADVANCED, or NEED_TIME while
+        // the next run of a sorted prefix is loaded.
         // Insert documents into BSON document in this format:
         //     {output: [docA, docB, docC, ...]}
         BSONObjBuilder bob;
         BSONArrayBuilder arr(bob.subarrayStart("output"));
-        while (state == PlanStage::ADVANCED) {
-            WorkingSetMember* member = ws.get(id);
-            BSONObj obj = member->doc.value().toBson();
-            arr.append(obj);
+        while (state == PlanStage::ADVANCED || state == PlanStage::NEED_TIME) {
+            if (state == PlanStage::ADVANCED) {
+                WorkingSetMember* member = ws.get(id);
+                BSONObj obj = member->doc.value().toBson();
+                arr.append(obj);
+            }
             state = sort.work(&id);
         }
         arr.doneFast();
@@ -304,4 +312,81 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+//
+// Sort within runs of a sorted prefix
+// Implementation should sort each run of items sharing the prefix separately.
+//
+
+TEST_F(SortStageDefaultTest, SortWithinSortedPrefix) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 1, b: 1}, {a: 1, b: 3}, {a: 1, b: 2}, {a: 2, b: 1}, {a: 3, b: 1}, "
+             "{a: 3, b: 2}]}",
+             "{output: [{a: 1, b: 3}, {a: 1, b: 2}, {a: 1, b: 1}, {a: 2, b: 1}, {a: 3, b: 2}, "
+             "{a: 3, b: 1}]}",
+             1);
+}
+
+TEST_F(SortStageDefaultTest, SortWithinSortedPrefixWithLimitSpanningRuns) {
+    testWork("{a: 1, b: 1}",
+             nullptr,
+             3,
+             "{input: [{a: 1, b: 2}, {a: 1, b: 1}, {a: 2, b: 3}, {a: 2, b: 2}, {a: 2, b: 1}]}",
+             "{output: [{a: 1, b: 1}, {a: 1, b: 2}, {a: 2, b: 1}]}",
+             1);
+}
+
+TEST_F(SortStageDefaultTest, SortWithinSortedPrefixStopsReadingChildOnceLimitIsReached) {
+    WorkingSet ws;
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx(), nullptr, kNss);
+
+    auto queuedDataStage = std::make_unique<QueuedDataStage>(expCtx.get(), &ws);
+    for (auto&& obj : {BSON("a" << 1 << "b" << 2),
+                       BSON("a" << 1 << "b" << 1),
+                       BSON("a" << 2 << "b" << 1),
+                       BSON("a" << 3 << "b" << 1)}) {
+        WorkingSetID id = ws.allocate();
+        WorkingSetMember* wsm = ws.get(id);
+        wsm->doc = {SnapshotId(), Document{obj}};
+        wsm->transitionToOwnedObj();
+        queuedDataStage->pushBack(id);
+    }
+
+    auto sortPattern = BSON("a" << 1 << "b" << 1);
+    auto sortKeyGen = std::make_unique<SortKeyGeneratorStage>(
+        expCtx, std::move(queuedDataStage), &ws, sortPattern);
+    SortStageDefault sort(expCtx,
+                          &ws,
+                          SortPattern{sortPattern, expCtx},
+                          2u,
+                          kMaxMemoryUsageBytes,
+                          false,  // addSortKeyMetadata
+                          std::move(sortKeyGen),
+                          1u);
+
+    std::vector<BSONObj> results;
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    PlanStage::StageState state = PlanStage::NEED_TIME;
+    while (state != PlanStage::IS_EOF) {
+        state = sort.work(&id);
+        if (state == PlanStage::ADVANCED) {
+            results.push_back(ws.get(id)->doc.value().toBson());
+        }
+    }
+
+    ASSERT_EQ(results.size(), 2u);
+    ASSERT_BSONOBJ_EQ(results[0], BSON("a" << 1 << "b" << 1));
+    ASSERT_BSONOBJ_EQ(results[1], BSON("a" << 1 << "b" << 2));
+
+    // Only the first run and the member which ended it should have been read from the child.
+    ASSERT_FALSE(sort.child()->child()->isEOF());
+    ASSERT_TRUE(sort.isEOF());
+
+    auto stats = sort.getStats();
+    auto sortStats = static_cast<const SortStats*>(stats->specific.get());
+    ASSERT_EQ(sortStats->sortedPrefixLength, 1u);
+}
+
 }  // namespace
@@ -46,6 +46,9 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * While reading the index it keeps only the first index key seen for each document. Documents are
+ * fetched as they are returned, so the documents of all of the candidates are never held at once.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public RequiresCollectionStage {
@@ -116,10 +119,11 @@ private:
      * Helper called from readFromChildren to update aggregate score with a newfound (term, score)
      * pair for this document.
      */
-    StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
+    StageState addTerm(WorkingSetID wsid);
 
     /**
-     * Worker for kReturningResults. Returns a wsm with RecordID and Score.
+     * Worker for kReturningResults. Fetches the next scored document and returns a wsm with its
+     * RecordID, document and Score.
      */
     StageState returnResults(WorkingSetID* out);
 
@@ -154,7 +158,6 @@ private:
 
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
-    WorkingSetID _idRetrying;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 };
 }  // namespace mongo
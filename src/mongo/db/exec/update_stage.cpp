@@ -169,19 +169,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
 
     Status status = Status::OK();
     const bool isInsert = false;
-    FieldRefSet immutablePaths;
-
-    if (_isUserInitiatedWrite) {
-        // Documents coming directly from users should be validated for storage. It is safe to
-        // access the CollectionShardingState in this write context and to throw SSV if the sharding
-        // metadata has not been initialized.
-        const auto collDesc = CollectionShardingState::get(opCtx(), collection()->ns())
-                                  ->getCollectionDescription(opCtx());
-        if (collDesc.isSharded() && !OperationShardingState::isOperationVersioned(opCtx())) {
-            immutablePaths.fillFrom(collDesc.getKeyPatternFields());
-        }
-        immutablePaths.keepShortest(&idFieldRef);
-    }
+    const FieldRefSet& immutablePaths = _getImmutablePaths();
     if (!driver->needMatchDetails()) {
         // If we don't need match details, avoid doing the rematch
         status = driver->update(StringData(),
@@ -248,9 +236,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
             args.stmtId = request->getStmtId();
             args.update = logObj;
             if (_isUserInitiatedWrite) {
-                args.criteria = CollectionShardingState::get(opCtx(), collection()->ns())
-                                    ->getCollectionDescription(opCtx())
-                                    .extractDocumentKey(newObj);
+                args.criteria = _getCollectionDescription().extractDocumentKey(newObj);
             } else {
                 const auto docId = newObj[idFieldName];
                 args.criteria = docId ? docId.wrap() : newObj;
@@ -607,6 +593,36 @@ void UpdateStage::_ensureIdFieldIsFirst(mb::Document* doc, bool generateOIDIfMis
     }
 }
 
+void UpdateStage::doSaveStateRequiresCollection() {
+    _immutablePaths.reset();
+    _collDesc.reset();
+}
+
+const ScopedCollectionDescription& UpdateStage::_getCollectionDescription() {
+    if (!_collDesc) {
+        // It is safe to access the CollectionShardingState in this write context and to throw SSV
+        // if the sharding metadata has not been initialized.
+        _collDesc.emplace(CollectionShardingState::get(opCtx(), collection()->ns())
+                              ->getCollectionDescription(opCtx()));
+    }
+    return *_collDesc;
+}
+
+const FieldRefSet& UpdateStage::_getImmutablePaths() {
+    if (!_immutablePaths) {
+        _immutablePaths.emplace();
+        if (_isUserInitiatedWrite) {
+            // Documents coming directly from users should be validated for storage.
+            const auto& collDesc = _getCollectionDescription();
+            if (collDesc.isSharded() && !OperationShardingState::isOperationVersioned(opCtx())) {
+                _immutablePaths->fillFrom(collDesc.getKeyPatternFields());
+            }
+            _immutablePaths->keepShortest(&idFieldRef);
+        }
+    }
+    return *_immutablePaths;
+}
+
 void UpdateStage::doRestoreStateRequiresCollection() {
     const UpdateRequest& request = *_params.request;
     const NamespaceString& nsString(request.getNamespaceString());
@@ -687,8 +703,7 @@ PlanStage::StageState UpdateStage::prepareToRetryWSM(WorkingSetID idToRetry, Wor
 }
 
 bool UpdateStage::checkUpdateChangesShardKeyFields(const Snapshotted<BSONObj>& oldObj) {
-    auto* const css = CollectionShardingState::get(opCtx(), collection()->ns());
-    const auto collDesc = css->getCollectionDescription(opCtx());
+    const auto& collDesc = _getCollectionDescription();
     if (!collDesc.isSharded()) {
         return false;
     }
@@ -740,6 +755,7 @@ bool UpdateStage::checkUpdateChangesShardKeyFields(const Snapshotted<BSONObj>& o
     // At this point we already asserted that the complete shardKey have been specified in the
     // query, this implies that mongos is not doing a broadcast update and that it attached a
     // shardVersion to the command. Thus it is safe to call getOwnershipFilter
+    auto* const css = CollectionShardingState::get(opCtx(), collection()->ns());
     const auto collFilter = css->getOwnershipFilter(
         opCtx(), CollectionShardingState::OrphanCleanupPolicy::kAllowOrphanCleanup);
 
@@ -131,7 +131,7 @@ protected:
                 WorkingSet* ws,
                 Collection* collection);
 
-    void doSaveStateRequiresCollection() final {}
+    void doSaveStateRequiresCollection() final;
 
     void doRestoreStateRequiresCollection() final;
 
@@ -156,6 +156,19 @@ protected:
     mutablebson::DamageVector _damages;
 
 private:
+    /**
+     * Returns the sharding description of the collection. It is looked up on first use after each
+     * yield rather than for every document, since it cannot change while the collection lock is
+     * held.
+     */
+    const ScopedCollectionDescription& _getCollectionDescription();
+
+    /**
+     * Returns the paths which a user-initiated update may not modify: _id and, when the operation
+     * is not versioned, the shard key. Cached along with the collection description.
+     */
+    const FieldRefSet& _getImmutablePaths();
+
     static const UpdateStats kEmptyUpdateStats;
 
     /**
@@ -190,6 +203,11 @@ private:
      */
     bool checkUpdateChangesShardKeyFields(const Snapshotted<BSONObj>& oldObj);
 
+    // Cached until the next yield, since the collection description is not safe to access after
+    // the collection lock has been dropped. '_immutablePaths' points into '_collDesc'.
+    boost::optional<ScopedCollectionDescription> _collDesc;
+    boost::optional<FieldRefSet> _immutablePaths;
+
     // If not WorkingSet::INVALID_ID, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
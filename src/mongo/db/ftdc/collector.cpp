@@ -31,6 +31,8 @@
 
 #include "mongo/db/ftdc/collector.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -46,9 +48,17 @@ namespace mongo {
 void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
     // TODO: ensure the collectors all have unique names.
     _collectors.emplace_back(std::move(collector));
+    _lastResults.emplace_back();
+}
+
+bool FTDCCollectorCollection::hasHighFrequencyCollectors() const {
+    return std::any_of(_collectors.begin(), _collectors.end(), [](const auto& collector) {
+        return collector->isHighFrequency();
+    });
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             bool collectExpensive) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -58,7 +68,7 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     BSONObjBuilder builder;
 
     Date_t start = client->getServiceContext()->getPreciseClockSource()->now();
-    Date_t end;
+    Date_t end = start;
     bool firstLoop = true;
 
     builder.appendDate(kFTDCCollectStartField, start);
@@ -73,7 +83,17 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
 
-    for (auto& collector : _collectors) {
+    for (size_t i = 0; i < _collectors.size(); ++i) {
+        auto& collector = _collectors[i];
+        auto& lastResult = _lastResults[i];
+
+        // Repeating the last result keeps the schema stable, so the compressor only stores zero
+        // deltas for it.
+        if (!collectExpensive && !collector->isHighFrequency() && !lastResult.isEmpty()) {
+            builder.append(collector->name(), lastResult);
+            continue;
+        }
+
         BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
 
         // Add a Date_t before and after each BSON is collected so that we can track timing of the
@@ -92,6 +112,10 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
+
+        if (!collector->isHighFrequency()) {
+            lastResult = subObjBuilder.done().getOwned();
+        }
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
@@ -34,10 +34,10 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
 class Date_t;
 class Client;
@@ -70,6 +70,17 @@ public:
      */
     virtual void collect(OperationContext* opCtx, BSONObjBuilder& builder) = 0;
 
+    /**
+     * Whether the collector is cheap enough to run on every sample, i.e. it only reads counters
+     * without taking locks or running commands.
+     *
+     * Other collectors only run once per expensive collection period. The samples in between
+     * repeat their last result, which costs next to nothing once delta compressed.
+     */
+    virtual bool isHighFrequency() const {
+        return false;
+    }
+
 protected:
     FTDCCollectorInterface() = default;
 };
@@ -92,10 +103,19 @@ public:
      */
     void add(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Returns true if any collector in the collection is high frequency.
+     */
+    bool hasHighFrequencyCollectors() const;
+
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
      * Returns a tuple of a sample, and the time at which collecting started.
      *
+     * If collectExpensive is false, collectors that are not high frequency are not run, and their
+     * last result, including its start and end dates, is repeated instead. A collector that has
+     * never run is always run.
+     *
      * Sample schema:
      * {
      *    "start" : Date_t,    <- Time at which all collecting started
@@ -108,11 +128,14 @@ public:
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(Client* client, bool collectExpensive = true);
 
 private:
     // collection of collectors
     std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+
+    // Last result of each collector that is not high frequency, indexed like _collectors
+    std::vector<BSONObj> _lastResults;
 };
 
 }  // namespace mongo
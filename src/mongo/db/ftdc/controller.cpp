@@ -70,6 +70,12 @@ void FTDCController::setPeriod(Milliseconds millis) {
     _condvar.notify_one();
 }
 
+void FTDCController::setExpensivePeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.expensivePeriod = millis;
+    _condvar.notify_one();
+}
+
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
@@ -200,6 +206,9 @@ void FTDCController::doLoop() noexcept {
         _config = _configTemp;
     }
 
+    // Time of the last sample that ran every collector
+    Date_t lastExpensiveTime;
+
     while (true) {
         // Compute the next interval to run regardless of how we were woken up
         // Skipping an interval due to a race condition with a config signal is harmless.
@@ -246,7 +255,18 @@ void FTDCController::doLoop() noexcept {
                 _mgr = uassertStatusOK(std::move(swMgr));
             }
 
-            auto collectSample = _periodicCollectors.collect(client);
+            // Collectors that are not high frequency only run once per expensive period. If
+            // there is nothing else to collect, skip the sample entirely.
+            const bool collectExpensive =
+                next_time - lastExpensiveTime >= _config.expensivePeriod;
+            if (!collectExpensive && !_periodicCollectors.hasHighFrequencyCollectors()) {
+                continue;
+            }
+            if (collectExpensive) {
+                lastExpensiveTime = next_time;
+            }
+
+            auto collectSample = _periodicCollectors.collect(client, collectExpensive);
 
             Status s = _mgr->writeSampleAndRotateIfNeeded(
                 client, std::get<0>(collectSample), std::get<1>(collectSample));
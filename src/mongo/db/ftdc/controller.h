@@ -75,6 +75,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the minimum period for running collectors that are not high frequency.
+     */
+    void setExpensivePeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -44,6 +44,7 @@
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_test.h"
+#include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
 #include "mongo/unittest/temp_dir.h"
@@ -166,6 +167,7 @@ TEST_F(FTDCControllerTest, TestFull) {
     FTDCConfig config;
     config.enabled = true;
     config.period = Milliseconds(1);
+    config.expensivePeriod = Milliseconds(1);
     config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
     config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
 
@@ -219,6 +221,7 @@ TEST_F(FTDCControllerTest, TestStartStop) {
     FTDCConfig config;
     config.enabled = false;
     config.period = Milliseconds(1);
+    config.expensivePeriod = Milliseconds(1);
     config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
     config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
 
@@ -240,6 +243,7 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     FTDCConfig config;
     config.enabled = false;
     config.period = Milliseconds(1);
+    config.expensivePeriod = Milliseconds(1);
     config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
     config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
 
@@ -280,4 +284,65 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+class FTDCCountingCollector : public FTDCCollectorInterface {
+public:
+    FTDCCountingCollector(std::string name, bool highFrequency)
+        : _name(std::move(name)), _highFrequency(highFrequency) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+    bool isHighFrequency() const final {
+        return _highFrequency;
+    }
+
+    int getCount() const {
+        return _count;
+    }
+
+private:
+    const std::string _name;
+    const bool _highFrequency;
+    int _count{0};
+};
+
+// Test that collectors that are not high frequency are only run when asked to, and that the
+// samples in between repeat their last result
+TEST_F(FTDCControllerTest, TestHighFrequencyCollectors) {
+    FTDCCollectorCollection collectors;
+
+    auto fast = std::make_unique<FTDCCountingCollector>("fast", true);
+    auto slow = std::make_unique<FTDCCountingCollector>("slow", false);
+    auto fastPtr = fast.get();
+    auto slowPtr = slow.get();
+    collectors.add(std::move(fast));
+    collectors.add(std::move(slow));
+    ASSERT_TRUE(collectors.hasHighFrequencyCollectors());
+
+    // A collector that has never run is run even if expensive collection is not requested.
+    auto first = std::get<0>(collectors.collect(getClient(), false));
+    ASSERT_EQUALS(fastPtr->getCount(), 1);
+    ASSERT_EQUALS(slowPtr->getCount(), 1);
+
+    auto second = std::get<0>(collectors.collect(getClient(), false));
+    ASSERT_EQUALS(fastPtr->getCount(), 2);
+    ASSERT_EQUALS(slowPtr->getCount(), 1);
+    ASSERT_EQUALS(second["fast"].Obj()["count"].numberInt(), 2);
+    ASSERT_BSONOBJ_EQ(second["slow"].Obj(), first["slow"].Obj());
+
+    auto third = std::get<0>(collectors.collect(getClient(), true));
+    ASSERT_EQUALS(fastPtr->getCount(), 3);
+    ASSERT_EQUALS(slowPtr->getCount(), 2);
+    ASSERT_EQUALS(third["slow"].Obj()["count"].numberInt(), 2);
+
+    // The repeated samples share a schema so they compress into the same chunk.
+    std::vector<std::uint64_t> metrics;
+    ASSERT_TRUE(FTDCBSONUtil::extractMetricsFromDocument(first, second, &metrics).getValue());
+}
+
 }  // namespace mongo
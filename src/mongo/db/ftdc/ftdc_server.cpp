@@ -46,6 +46,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/mirror_maestro.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
 #include "mongo/util/synchronized_value.h"
 
 namespace mongo {
@@ -116,6 +117,15 @@ Status onUpdateFTDCPeriod(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCExpensivePeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setExpensivePeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
 Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
     if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
         return Status(
@@ -240,6 +250,32 @@ public:
     }
 };
 
+/**
+ * A high frequency FTDC Collector for process wide counters that are read without locks. Their
+ * values also appear in serverStatus, which is only collected once per expensive period.
+ */
+class FTDCCountersCollector : public FTDCCollectorInterface {
+private:
+    constexpr static StringData kName = "counters"_sd;
+
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("opcounters", globalOpCounters.getObj());
+        builder.append("opcountersRepl", replOpCounters.getObj());
+
+        BSONObjBuilder networkBuilder(builder.subobjStart("network"));
+        networkCounter.append(networkBuilder);
+    }
+
+    std::string name() const final {
+        return kName.toString();
+    }
+
+    bool isHighFrequency() const final {
+        return true;
+    }
+};
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -249,6 +285,7 @@ void startFTDC(boost::filesystem::path& path,
                RegisterCollectorsFunction registerCollectors) {
     FTDCConfig config;
     config.period = Milliseconds(ftdcStartupParams.periodMillis.load());
+    config.expensivePeriod = Milliseconds(ftdcStartupParams.expensivePeriodMillis.load());
     // Only enable FTDC if our caller says to enable FTDC, MongoS may not have a valid path to write
     // files to so update the diagnosticDataCollectionEnabled set parameter to reflect that.
     ftdcStartupParams.enabled.store(startupMode == FTDCStartMode::kStart &&
@@ -270,6 +307,7 @@ void startFTDC(boost::filesystem::path& path,
     // NOTE: For each command here, there must be an equivalent privilege check in
     // GetDiagnosticDataCommand
     controller->addPeriodicCollector(std::make_unique<FTDCServerStatusCommandCollector>());
+    controller->addPeriodicCollector(std::make_unique<FTDCCountersCollector>());
 
     registerCollectors(controller.get());
 
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <iterator>
+
+#include "mongo/db/fts/fts_index_format.h"
+#include "mongo/db/fts/fts_spec.h"
+#include "mongo/db/fts/fts_tokenizer.h"
+
+namespace mongo {
+namespace fts {
+namespace {
+
+struct Corpus {
+    const char* language;
+    const char* text;
+};
+
+// Short passages which are repeated to build a document of the requested size.
+const Corpus kCorpora[] = {
+    {"english",
+     "The quick brown foxes were jumping over the lazy dogs while the farmers kept running "
+     "between their fields, counting the sheep and complaining about the weather. "},
+    {"french",
+     "Les renards bruns sautaient rapidement par-dessus les chiens paresseux pendant que les "
+     "fermiers couraient entre leurs champs en comptant les moutons et se plaignant du temps. "},
+    {"german",
+     "Die schnellen braunen Füchse sprangen über die faulen Hunde, während die Bauern zwischen "
+     "ihren Feldern liefen, die Schafe zählten und sich über das Wetter beklagten. "},
+    {"russian",
+     "Быстрые коричневые лисы прыгали через ленивых собак, "
+     "пока фермеры бегали между своими полями, "
+     "считали овец и жаловались на погоду. "},
+};
+
+std::string makeText(const Corpus& corpus, size_t minBytes) {
+    std::string text;
+    while (text.size() < minBytes) {
+        text += corpus.text;
+    }
+    return text;
+}
+
+void setLabel(benchmark::State& state, const Corpus& corpus) {
+    state.SetLabel(corpus.language);
+}
+
+/**
+ * Tokenizes and stems a document with a tokenizer created for it, as text index key generation
+ * did for every field before tokenizers were reused.
+ */
+void BM_TokenizeFreshTokenizer(benchmark::State& state) {
+    const Corpus& corpus = kCorpora[state.range(0)];
+    const FTSLanguage& language = FTSLanguage::make(corpus.language, TEXT_INDEX_VERSION_3);
+    std::string text = makeText(corpus, state.range(1));
+
+    size_t tokens = 0;
+    for (auto _ : state) {
+        auto tokenizer = language.createTokenizer();
+        tokenizer->reset(text, FTSTokenizer::kFilterStopWords);
+        while (tokenizer->moveNext()) {
+            benchmark::DoNotOptimize(tokenizer->get());
+            ++tokens;
+        }
+    }
+    state.SetItemsProcessed(tokens);
+    state.SetBytesProcessed(state.iterations() * text.size());
+    setLabel(state, corpus);
+}
+
+/**
+ * Tokenizes and stems a document with a tokenizer which is reset for every document, so that its
+ * stemmer, stem cache and buffers are reused.
+ */
+void BM_TokenizeReusedTokenizer(benchmark::State& state) {
+    const Corpus& corpus = kCorpora[state.range(0)];
+    const FTSLanguage& language = FTSLanguage::make(corpus.language, TEXT_INDEX_VERSION_3);
+    std::string text = makeText(corpus, state.range(1));
+    auto tokenizer = language.createTokenizer();
+
+    size_t tokens = 0;
+    for (auto _ : state) {
+        tokenizer->reset(text, FTSTokenizer::kFilterStopWords);
+        while (tokenizer->moveNext()) {
+            benchmark::DoNotOptimize(tokenizer->get());
+            ++tokens;
+        }
+    }
+    state.SetItemsProcessed(tokens);
+    state.SetBytesProcessed(state.iterations() * text.size());
+    setLabel(state, corpus);
+}
+
+/**
+ * Generates the text index keys of a document with a single text field.
+ */
+void BM_GetKeys(benchmark::State& state) {
+    const Corpus& corpus = kCorpora[state.range(0)];
+    FTSSpec spec(uassertStatusOK(FTSSpec::fixSpec(BSON("key" << BSON("data"
+                                                                     << "text")
+                                                             << "default_language"
+                                                             << corpus.language))));
+    BSONObj doc = BSON("data" << makeText(corpus, state.range(1)));
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+
+    for (auto _ : state) {
+        KeyStringSet keys;
+        FTSIndexFormat::getKeys(allocator,
+                                spec,
+                                doc,
+                                &keys,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj()));
+        benchmark::DoNotOptimize(keys);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+    setLabel(state, corpus);
+}
+
+void corpusArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t corpus = 0; corpus < int64_t(std::size(kCorpora)); ++corpus) {
+        for (int64_t bytes : {256, 4 << 10}) {
+            b->Args({corpus, bytes});
+        }
+    }
+}
+
+BENCHMARK(BM_TokenizeFreshTokenizer)->Apply(corpusArgs);
+BENCHMARK(BM_TokenizeReusedTokenizer)->Apply(corpusArgs);
+BENCHMARK(BM_GetKeys)->Apply(corpusArgs);
+
+}  // namespace
+}  // namespace fts
+}  // namespace mongo
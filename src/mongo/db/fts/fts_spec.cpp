@@ -175,11 +175,19 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
         return _scoreDocumentV1(obj, term_freqs);
     }
 
+    // Tokenizers are kept per thread and per language and reset for every string, so that their
+    // stemmers, stem caches and buffers are reused across the fields and documents of an index
+    // build rather than rebuilt for every field. Languages live for the lifetime of the process.
+    thread_local stdx::unordered_map<const FTSLanguage*, std::unique_ptr<FTSTokenizer>> tokenizers;
+
     FTSElementIterator it(*this, obj);
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
+        auto& tokenizer = tokenizers[val._language];
+        if (!tokenizer) {
+            tokenizer = val._language->createTokenizer();
+        }
         _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
     }
 }
@@ -32,6 +32,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
+#include "mongo/util/string_map.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
 
 namespace mongo {
@@ -42,6 +43,9 @@ namespace fts {
  * maintains case
  * but works
  * running/Running -> run/Run
+ *
+ * Stems are remembered in a bounded per-stemmer cache, since a tokenizer stems the same words many
+ * times over the documents of a text index build.
  */
 class Stemmer {
     Stemmer(const Stemmer&) = delete;
@@ -60,8 +64,17 @@ public:
      */
     StringData stem(StringData word) const;
 
+    /**
+     * The number of stems remembered before the cache is dropped and refilled from scratch.
+     */
+    static constexpr size_t kMaxCachedStems = 4096;
+
 private:
     struct sb_stemmer* _stemmer;
+
+    // Maps words to their stems. Dropped wholesale when it reaches kMaxCachedStems, which keeps a
+    // hit to a single allocation-free hash lookup.
+    mutable StringMap<std::string> _stemCache;
 };
 }  // namespace fts
 }  // namespace mongo
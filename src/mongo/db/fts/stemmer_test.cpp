@@ -56,5 +56,17 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, CachedStemsMatchUncached) {
+    Stemmer s(languageEnglishV2());
+    // Stem enough distinct words to overflow the stem cache, then stem them all again.
+    for (int round = 0; round < 2; ++round) {
+        for (size_t i = 0; i < Stemmer::kMaxCachedStems + 10; ++i) {
+            ASSERT_EQUALS("run" + std::to_string(i), s.stem("run" + std::to_string(i)));
+            ASSERT_EQUALS("run", s.stem("running"));
+            ASSERT_EQUALS("Run", s.stem("Running"));
+        }
+    }
+}
 }  // namespace fts
 }  // namespace mongo
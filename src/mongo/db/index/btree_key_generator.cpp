@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -104,9 +105,33 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
       _collator(collator) {
 
     for (const char* fieldName : fieldNames) {
-        size_t pathLength = FieldRef{fieldName}.numParts();
+        FieldRef path{fieldName};
+        size_t pathLength = path.numParts();
         invariant(pathLength > 0);
         _pathLengths.push_back(pathLength);
+
+        // The components refer to 'fieldName', which outlives this generator, rather than to
+        // 'path'.
+        StringData remaining = fieldName;
+        auto nextComponent = [&] {
+            auto dotOffset = remaining.find('.');
+            StringData component = remaining.substr(0, dotOffset);
+            remaining = dotOffset == std::string::npos ? ""_sd : remaining.substr(dotOffset + 1);
+            return component;
+        };
+
+        StringData topLevelField = nextComponent();
+        auto it = std::find(_topLevelFields.begin(), _topLevelFields.end(), topLevelField);
+        _pathTopLevelField.push_back(it - _topLevelFields.begin());
+        if (it == _topLevelFields.end()) {
+            _topLevelFields.push_back(topLevelField);
+        }
+
+        std::vector<StringData> suffix;
+        for (size_t i = 1; i < pathLength; ++i) {
+            suffix.push_back(nextComponent());
+        }
+        _pathSuffixes.push_back(std::move(suffix));
     }
 }
 
@@ -274,6 +299,113 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
     }
 }
 
+void BtreeKeyGenerator::getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const std::vector<BSONObj>& objs,
+                                        bool skipMultikey,
+                                        std::vector<KeyStringSet>* keys,
+                                        std::vector<MultikeyPaths>* multikeyPaths,
+                                        const std::vector<RecordId>* ids) const {
+    invariant(!ids || ids->size() == objs.size());
+    keys->resize(objs.size());
+    if (multikeyPaths) {
+        multikeyPaths->resize(objs.size());
+    }
+
+    // Scratch space for _extractNonArrayElements(), shared by all documents of the batch.
+    std::vector<BSONElement> topLevelElts(_topLevelFields.size());
+    std::vector<BSONElement> elts(_fieldNames.size());
+    for (size_t d = 0; d < objs.size(); ++d) {
+        const BSONObj& obj = objs[d];
+        KeyStringSet* docKeys = &(*keys)[d];
+        MultikeyPaths* docMultikeyPaths = multikeyPaths ? &(*multikeyPaths)[d] : nullptr;
+        boost::optional<RecordId> id;
+        if (ids) {
+            id = (*ids)[d];
+        }
+
+        if (_isIdIndex || !_extractNonArrayElements(obj, &topLevelElts, &elts)) {
+            getKeys(pooledBufferBuilder, obj, skipMultikey, docKeys, docMultikeyPaths, id);
+            continue;
+        }
+
+        // Without an array along any of the paths, the document has the single key the generic
+        // algorithm would build from 'elts', where a missing field is null, and no multikey path.
+        if (docMultikeyPaths) {
+            invariant(docMultikeyPaths->empty());
+            docMultikeyPaths->resize(_fieldNames.size());
+        }
+
+        size_t numNotFound = 0;
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        for (const auto& elem : elts) {
+            if (elem.eoo()) {
+                ++numNotFound;
+            }
+
+            if (_collator) {
+                keyString.appendBSONElement(elem.eoo() ? nullElt : elem,
+                                            [&](StringData stringData) {
+                                                return _collator->getComparisonString(stringData);
+                                            });
+            } else {
+                keyString.appendBSONElement(elem.eoo() ? nullElt : elem);
+            }
+        }
+
+        if (_isSparse && numNotFound == _fieldNames.size()) {
+            continue;
+        }
+
+        if (id) {
+            keyString.appendRecordId(*id);
+        }
+        docKeys->insert(keyString.release());
+    }
+}
+
+bool BtreeKeyGenerator::_extractNonArrayElements(const BSONObj& obj,
+                                                 std::vector<BSONElement>* topLevelElts,
+                                                 std::vector<BSONElement>* elts) const {
+    // Find the first component of every path in one pass over the document. Like getField(), the
+    // first of several fields with the same name is used.
+    const size_t numTopLevelFields = _topLevelFields.size();
+    std::fill(topLevelElts->begin(), topLevelElts->end(), BSONElement());
+    size_t numFound = 0;
+    for (auto&& elem : obj) {
+        const StringData fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < numTopLevelFields; ++i) {
+            if ((*topLevelElts)[i].eoo() && _topLevelFields[i] == fieldName) {
+                (*topLevelElts)[i] = elem;
+                ++numFound;
+                break;
+            }
+        }
+        if (numFound == numTopLevelFields) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        BSONElement elem = (*topLevelElts)[_pathTopLevelField[i]];
+        for (const auto& component : _pathSuffixes[i]) {
+            if (elem.type() == BSONType::Array) {
+                return false;
+            }
+            if (elem.type() != BSONType::Object) {
+                // Either the path is missing, or there is a scalar where it expects an object.
+                elem = BSONElement();
+                break;
+            }
+            elem = elem.embeddedObject().getField(component);
+        }
+        if (elem.type() == BSONType::Array) {
+            return false;
+        }
+        (*elts)[i] = elem;
+    }
+    return true;
+}
+
 void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              const BSONObj& obj,
                                              boost::optional<RecordId> id,
@@ -82,6 +82,24 @@ public:
                  MultikeyPaths* multikeyPaths,
                  boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * Generates the index keys for every document in 'objs' as getKeys() would, storing the keys
+     * of objs[i] in (*keys)[i] and, if 'multikeyPaths' is non-null, its multikey paths in
+     * (*multikeyPaths)[i]. Both vectors are resized to the size of 'objs'. If 'ids' is non-null,
+     * it must have the same size as 'objs' and ids[i] is appended to the keys of objs[i].
+     *
+     * Documents without an array along any of the indexed paths, the common case even for
+     * multikey indexes, are handled without the recursion of the generic algorithm: a single pass
+     * over the top-level fields of the document finds the first component of every indexed path.
+     * The other documents fall back to getKeys().
+     */
+    void getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                         const std::vector<BSONObj>& objs,
+                         bool skipMultikey,
+                         std::vector<KeyStringSet>* keys,
+                         std::vector<MultikeyPaths>* multikeyPaths,
+                         const std::vector<RecordId>* ids = nullptr) const;
+
 private:
     const KeyString::Version _keyStringVersion;
     const Ordering _ordering;
@@ -230,12 +248,29 @@ private:
 
     KeyString::Value _buildNullKeyString() const;
 
+    /**
+     * Looks up every indexed path of 'obj' using the paths compiled by the constructor, storing
+     * the element found for _fieldNames[i], or EOO if there is none, in (*elts)[i]. Returns false
+     * if any of the paths traverses or ends in an array, in which case 'elts' is unspecified.
+     * 'topLevelElts' is scratch space with one element per entry of '_topLevelFields'.
+     */
+    bool _extractNonArrayElements(const BSONObj& obj,
+                                  std::vector<BSONElement>* topLevelElts,
+                                  std::vector<BSONElement>* elts) const;
+
     const std::vector<PositionalPathInfo> _emptyPositionalInfo;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector is the number of path components in the indexed field.
     std::vector<size_t> _pathLengths;
 
+    // The indexed paths compiled for getKeysForBatch(). '_topLevelFields' holds the distinct first
+    // components of the indexed fields, and '_pathTopLevelField[i]' is the position in it of the
+    // first component of '_fieldNames[i]'. '_pathSuffixes[i]' holds the remaining components.
+    std::vector<StringData> _topLevelFields;
+    std::vector<size_t> _pathTopLevelField;
+    std::vector<std::vector<StringData>> _pathSuffixes;
+
     // Null if this key generator orders strings according to the simple binary compare. If
     // non-null, represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
@@ -143,6 +143,27 @@ bool testKeygen(const BSONObj& kp,
         MultikeyPaths actualMultikeyPaths;
         keyGen->getKeys(allocator, obj, skipMultikey, &actualKeys, &actualMultikeyPaths);
 
+        //
+        // Check that generating the keys of a batch holding the object twice gives the same keys
+        // and multikey paths for both copies.
+        //
+        std::vector<KeyStringSet> batchKeys;
+        std::vector<MultikeyPaths> batchMultikeyPaths;
+        keyGen->getKeysForBatch(
+            allocator, {obj, obj}, skipMultikey, &batchKeys, &batchMultikeyPaths);
+        for (size_t i = 0; i < 2; ++i) {
+            if (!keysetsEqual(actualKeys, batchKeys[i]) ||
+                actualMultikeyPaths != batchMultikeyPaths[i]) {
+                LOGV2(5155012,
+                      "Batch key generation differs",
+                      "keys"_attr = dumpKeyset(actualKeys),
+                      "batchKeys"_attr = dumpKeyset(batchKeys[i]),
+                      "multikeyPaths"_attr = dumpMultikeyPaths(actualMultikeyPaths),
+                      "batchMultikeyPaths"_attr = dumpMultikeyPaths(batchMultikeyPaths[i]));
+                return false;
+            }
+        }
+
         //
         // Check that the results match the expected result.
         //
@@ -1385,4 +1406,37 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysForBatchMixingArraysAndRecordIds) {
+    BtreeKeyGenerator keyGen({"a", "b.c"},
+                             {BSONElement(), BSONElement()},
+                             true,
+                             nullptr,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(BSONObj()));
+    std::vector<BSONObj> objs{fromjson("{b: {c: 1}, a: 2}"),
+                              fromjson("{a: [1, 2], b: {c: 3}}"),
+                              fromjson("{x: 1}"),
+                              fromjson("{a: 1, a: 2, b: 5}")};
+    std::vector<RecordId> ids{RecordId(1), RecordId(2), RecordId(3), RecordId(4)};
+
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+    std::vector<KeyStringSet> batchKeys;
+    std::vector<MultikeyPaths> batchMultikeyPaths;
+    keyGen.getKeysForBatch(allocator, objs, false, &batchKeys, &batchMultikeyPaths, &ids);
+    ASSERT_EQ(objs.size(), batchKeys.size());
+    ASSERT_EQ(objs.size(), batchMultikeyPaths.size());
+
+    for (size_t i = 0; i < objs.size(); ++i) {
+        KeyStringSet keys;
+        MultikeyPaths multikeyPaths;
+        keyGen.getKeys(allocator, objs[i], false, &keys, &multikeyPaths, ids[i]);
+        ASSERT(keysetsEqual(keys, batchKeys[i])) << i;
+        ASSERT(multikeyPaths == batchMultikeyPaths[i]) << i;
+    }
+
+    ASSERT_EQ(2U, batchKeys[1].size());
+    ASSERT(batchKeys[2].empty());
+    ASSERT_EQ(1U, batchKeys[3].size());
+}
+
 }  // namespace
@@ -186,6 +186,8 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
         result->numInserted += keys.size() + multikeyMetadataKeys.size();
     }
 
+    onKeysWritten(opCtx, keys, {});
+
     if (shouldMarkIndexAsMultikey(keys.size(), multikeyMetadataKeys, multikeyPaths)) {
         _indexCatalogEntry->setMultikey(opCtx, coll, multikeyPaths);
     }
@@ -234,12 +236,18 @@ Status AbstractIndexAccessMethod::removeKeys(OperationContext* opCtx,
         removeOneKey(opCtx, key, loc, options.dupsAllowed);
     }
 
+    onKeysWritten(opCtx, {}, keys);
+
     *numDeleted = keys.size();
     return Status::OK();
 }
 
 Status AbstractIndexAccessMethod::initializeAsEmpty(OperationContext* opCtx) {
-    return _newInterface->initAsEmpty(opCtx);
+    Status status = _newInterface->initAsEmpty(opCtx);
+    if (status.isOK()) {
+        onInitializedAsEmpty(opCtx);
+    }
+    return status;
 }
 
 RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
@@ -438,6 +446,8 @@ Status AbstractIndexAccessMethod::update(OperationContext* opCtx,
         _indexCatalogEntry->setMultikey(opCtx, coll, ticket.newMultikeyPaths);
     }
 
+    onKeysWritten(opCtx, ticket.added, ticket.removed);
+
     *numDeleted = ticket.removed.size();
     *numInserted = ticket.added.size();
 
@@ -452,13 +462,25 @@ class AbstractIndexAccessMethod::BulkBuilderImpl : public IndexAccessMethod::Bul
 public:
     BulkBuilderImpl(IndexCatalogEntry* indexCatalogEntry,
                     const IndexDescriptor* descriptor,
-                    size_t maxMemoryUsageBytes);
+                    size_t maxMemoryUsageBytes,
+                    std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget);
 
     Status insert(OperationContext* opCtx,
                   const BSONObj& obj,
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                        const BSONObj& obj,
+                        const RecordId& loc,
+                        const InsertDeleteOptions& options,
+                        GeneratedKeys* generatedKeys) const final;
+
+    Status addKeys(OperationContext* opCtx,
+                   const BSONObj& obj,
+                   const RecordId& loc,
+                   const GeneratedKeys& generatedKeys) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -475,7 +497,16 @@ public:
 
     void persistDataForShutdown() final;
 
+    void persistDataForCheckpoint() final;
+
 private:
+    void _recordSuppressedError(OperationContext* opCtx,
+                                const Status& status,
+                                const BSONObj& obj,
+                                const RecordId& loc);
+
+    void _addKeysIntoSorter(const KeyStringSet& keys, const MultikeyPaths& multikeyPaths);
+
     void _addMultikeyMetadataKeysIntoSorter();
 
     std::unique_ptr<Sorter> _sorter;
@@ -493,21 +524,29 @@ private:
     // These are inserted into the sorter after all normal data keys have been added, just
     // before the bulk build is committed.
     KeyStringSet _multikeyMetadataKeys;
+
+    // The multikey metadata keys already added to the sorter.
+    KeyStringSet _multikeyMetadataKeysInSorter;
 };
 
 std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initiateBulk(
-    size_t maxMemoryUsageBytes) {
-    return std::make_unique<BulkBuilderImpl>(_indexCatalogEntry, _descriptor, maxMemoryUsageBytes);
+    size_t maxMemoryUsageBytes, std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget) {
+    return std::make_unique<BulkBuilderImpl>(
+        _indexCatalogEntry, _descriptor, maxMemoryUsageBytes, std::move(sharedMemoryBudget));
 }
 
-AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* index,
-                                                            const IndexDescriptor* descriptor,
-                                                            size_t maxMemoryUsageBytes)
+AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(
+    IndexCatalogEntry* index,
+    const IndexDescriptor* descriptor,
+    size_t maxMemoryUsageBytes,
+    std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget)
     : _sorter(Sorter::make(
           SortOptions()
               .TempDir(storageGlobalParams.dbpath + "/_tmp")
               .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
+              .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+              .SharedMemoryBudget(std::move(sharedMemoryBudget))
+              .PrefetchMergedOutput(),
           BtreeExternalSortComparison(),
           std::pair<KeyString::Value::SorterDeserializeSettings,
                     mongo::NullValue::SorterDeserializeSettings>(
@@ -534,47 +573,104 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
             multikeyPaths.get(),
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+                _recordSuppressedError(opCtx, status, obj, loc);
+            });
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    _addKeysIntoSorter(*keys, *multikeyPaths);
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::generateKeys(
+    SharedBufferFragmentBuilder& pooledBufferBuilder,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const InsertDeleteOptions& options,
+    GeneratedKeys* generatedKeys) const {
+    try {
+        _indexCatalogEntry->accessMethod()->getKeys(
+            pooledBufferBuilder,
+            obj,
+            options.getKeysMode,
+            GetKeysContext::kAddingKeys,
+            &generatedKeys->keys,
+            &generatedKeys->multikeyMetadataKeys,
+            &generatedKeys->multikeyPaths,
+            loc,
+            [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+                // The skipped record can only be written by the thread that owns the operation,
+                // so leave that to addKeys().
+                if (!generatedKeys->suppressedError) {
+                    generatedKeys->suppressedError = std::move(status);
                 }
             });
     } catch (...) {
         return exceptionToStatus();
     }
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::addKeys(OperationContext* opCtx,
+                                                           const BSONObj& obj,
+                                                           const RecordId& loc,
+                                                           const GeneratedKeys& generatedKeys) {
+    try {
+        if (generatedKeys.suppressedError) {
+            _recordSuppressedError(opCtx, *generatedKeys.suppressedError, obj, loc);
+        }
+        _multikeyMetadataKeys.insert(generatedKeys.multikeyMetadataKeys.begin(),
+                                     generatedKeys.multikeyMetadataKeys.end());
+        _addKeysIntoSorter(generatedKeys.keys, generatedKeys.multikeyPaths);
+    } catch (...) {
+        return exceptionToStatus();
+    }
+    return Status::OK();
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_recordSuppressedError(OperationContext* opCtx,
+                                                                        const Status& status,
+                                                                        const BSONObj& obj,
+                                                                        const RecordId& loc) {
+    // If a key generation error was suppressed, record the document as "skipped" so the index
+    // builder can retry at a point when data is consistent.
+    auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+    if (interceptor && interceptor->getSkippedRecordTracker()) {
+        LOGV2_DEBUG(20684,
+                    1,
+                    "Recording suppressed key generation error to retry later: "
+                    "{error} on {loc}: {obj}",
+                    "error"_attr = status,
+                    "loc"_attr = loc,
+                    "obj"_attr = redact(obj));
+        interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+    }
+}
 
-    if (!multikeyPaths->empty()) {
+void AbstractIndexAccessMethod::BulkBuilderImpl::_addKeysIntoSorter(
+    const KeyStringSet& keys, const MultikeyPaths& multikeyPaths) {
+    if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
+            _indexMultikeyPaths = multikeyPaths;
         } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
+            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
                 _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
+                                              multikeyPaths[i].begin(),
+                                              multikeyPaths[i].end());
             }
         }
     }
 
-    for (const auto& keyString : *keys) {
+    for (const auto& keyString : keys) {
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
 
     _isMultiKey = _isMultiKey ||
         _indexCatalogEntry->accessMethod()->shouldMarkIndexAsMultikey(
-            keys->size(), _multikeyMetadataKeys, *multikeyPaths);
-
-    return Status::OK();
+            keys.size(), _multikeyMetadataKeys, multikeyPaths);
 }
 
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
@@ -605,11 +701,21 @@ void AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForShutdown() {
     _sorter->persistDataForShutdown();
 }
 
+void AbstractIndexAccessMethod::BulkBuilderImpl::persistDataForCheckpoint() {
+    _addMultikeyMetadataKeysIntoSorter();
+    _sorter->persistDataForCheckpoint();
+}
+
 void AbstractIndexAccessMethod::BulkBuilderImpl::_addMultikeyMetadataKeysIntoSorter() {
+    // A build that checkpoints its state adds the metadata keys found so far each time, and later
+    // documents find most of them again, so each key is only added once.
     for (const auto& keyString : _multikeyMetadataKeys) {
-        _sorter->add(keyString, mongo::NullValue());
-        ++_keysInserted;
+        if (_multikeyMetadataKeysInSorter.insert(keyString).second) {
+            _sorter->add(keyString, mongo::NullValue());
+            ++_keysInserted;
+        }
     }
+    _multikeyMetadataKeys.clear();
 }
 
 Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
@@ -646,6 +752,12 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
         // Get the next datum and add it to the builder.
         BulkBuilder::Sorter::Data data = it->next();
 
+        // An index build that reads the collection through an index scan can read a document
+        // more than once, so the sorter may return the same key for the same RecordId again.
+        if (data.first.compare(previousKey) == 0) {
+            continue;
+        }
+
         // Assert that keys are retrieved from the sorter in non-decreasing order, but only in
         // debug builds since this check can be expensive.
         int cmpData;
@@ -700,6 +812,7 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
         // If we're here either it's a dup and we're cool with it or the addKey went just fine.
         pm.hit();
         wunit.commit();
+        onBulkKeyCommitted(data.first);
     }
 
     pm.finished();
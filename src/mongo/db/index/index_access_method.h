@@ -215,6 +215,38 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * The keys generated for a single document by generateKeys(), to be added by addKeys().
+         */
+        struct GeneratedKeys {
+            KeyStringSet keys;
+            KeyStringSet multikeyMetadataKeys;
+            MultikeyPaths multikeyPaths;
+
+            // Set if key generation failed for the document with an error that was suppressed.
+            boost::optional<Status> suppressedError;
+        };
+
+        /**
+         * Generates the keys that insert() would add for 'obj', without modifying the
+         * BulkBuilder. May be called concurrently from multiple threads, each with its own
+         * 'pooledBufferBuilder', which allows the CPU-bound key generation of a collection scan to
+         * be spread over several threads.
+         */
+        virtual Status generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                    const BSONObj& obj,
+                                    const RecordId& loc,
+                                    const InsertDeleteOptions& options,
+                                    GeneratedKeys* generatedKeys) const = 0;
+
+        /**
+         * Adds the keys generated for 'obj' by generateKeys(), as insert() would have.
+         */
+        virtual Status addKeys(OperationContext* opCtx,
+                               const BSONObj& obj,
+                               const RecordId& loc,
+                               const GeneratedKeys& generatedKeys) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -239,6 +271,12 @@ public:
          * Persists on disk the keys that have been inserted using this BulkBuilder.
          */
         virtual void persistDataForShutdown() = 0;
+
+        /**
+         * Like persistDataForShutdown(), but for a build that carries on inserting keys, and whose
+         * sorter files are still removed once it ends.
+         */
+        virtual void persistDataForCheckpoint() = 0;
     };
 
     /**
@@ -250,8 +288,11 @@ public:
      *
      * maxMemoryUsageBytes: amount of memory consumed before the external sorter starts spilling to
      *                      disk
+     * sharedMemoryBudget: if set, the external sorter also spills to keep the sorters sharing the
+     *                     budget within it
      */
-    virtual std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes) = 0;
+    virtual std::unique_ptr<BulkBuilder> initiateBulk(
+        size_t maxMemoryUsageBytes, std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget) = 0;
 
     /**
      * Call this when you are ready to finish your bulk work.
@@ -524,7 +565,8 @@ public:
                             Collection* collection,
                             MultikeyPaths paths) final;
 
-    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes) final;
+    std::unique_ptr<BulkBuilder> initiateBulk(
+        size_t maxMemoryUsageBytes, std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget) final;
 
     Status commitBulk(OperationContext* opCtx,
                       BulkBuilder* bulk,
@@ -571,6 +613,17 @@ protected:
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const = 0;
 
+    /**
+     * Called once the index has been initialized as empty, for the keys that a write adds to and
+     * removes from the index, and for each key as a bulk build commits it. Index types that keep
+     * statistics about their keys override these, which do nothing by default.
+     */
+    virtual void onInitializedAsEmpty(OperationContext* opCtx) {}
+    virtual void onKeysWritten(OperationContext* opCtx,
+                               const KeyStringSet& added,
+                               const KeyStringSet& removed) {}
+    virtual void onBulkKeyCommitted(const KeyString::Value& key) {}
+
     IndexCatalogEntry* const _indexCatalogEntry;  // owned by IndexCatalog
     const IndexDescriptor* const _descriptor;
 
@@ -165,6 +165,44 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
     }
 }
 
+// Generates the keys of a compound index over a top-level and a nested field for a batch of
+// 'batchSize' documents, one document at a time or with a single call to getKeysForBatch().
+void BM_KeyGenCompound(benchmark::State& state, bool batched, size_t batchSize) {
+    std::vector<BSONObj> objs;
+    for (size_t i = 0; i < batchSize; ++i) {
+        objs.push_back(BSON("x" << 1 << kFieldName << static_cast<int32_t>(numGen()) << "b"
+                                << BSON("c" << ("str" + std::to_string(i)) << "d" << 2)));
+    }
+
+    BtreeKeyGenerator generator({kFieldName, "b.c"},
+                                {BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSON(kFieldName << 1 << "b.c" << 1)));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    std::vector<KeyStringSet> keys(batchSize);
+    std::vector<MultikeyPaths> multikeyPaths(batchSize);
+
+    for (auto _ : state) {
+        if (batched) {
+            generator.getKeysForBatch(allocator, objs, false, &keys, &multikeyPaths);
+        } else {
+            for (size_t i = 0; i < batchSize; ++i) {
+                generator.getKeys(allocator, objs[i], false, &keys[i], &multikeyPaths[i]);
+            }
+        }
+        benchmark::ClobberMemory();
+        for (size_t i = 0; i < batchSize; ++i) {
+            keys[i].clear();
+            multikeyPaths[i].clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
@@ -180,5 +218,8 @@ BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 10x10, 10);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 100x100, 100);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 1Kx1K, 1000);
 
+BENCHMARK_CAPTURE(BM_KeyGenCompound, Single, false, 1000);
+BENCHMARK_CAPTURE(BM_KeyGenCompound, Batch, true, 1000);
+
 }  // namespace
 }  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -44,7 +45,8 @@ WildcardAccessMethod::WildcardAccessMethod(IndexCatalogEntry* wildcardState,
               _descriptor->pathProjection(),
               _indexCatalogEntry->getCollator(),
               getSortedDataInterface()->getKeyStringVersion(),
-              getSortedDataInterface()->getOrdering()) {}
+              getSortedDataInterface()->getOrdering()),
+      _countPathKeys(internalQueryWildcardIndexPathKeyCounts.load()) {}
 
 bool WildcardAccessMethod::shouldMarkIndexAsMultikey(size_t numberOfKeys,
                                                      const KeyStringSet& multikeyMetadataKeys,
@@ -62,6 +64,61 @@ void WildcardAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBu
     _keyGen.generateKeys(pooledBufferBuilder, obj, keys, multikeyMetadataKeys, id);
 }
 
+void WildcardAccessMethod::onInitializedAsEmpty(OperationContext* opCtx) {
+    if (_countPathKeys) {
+        _pathKeyCounts.startFromEmptyIndex();
+    }
+}
+
+void WildcardAccessMethod::onKeysWritten(OperationContext* opCtx,
+                                         const KeyStringSet& added,
+                                         const KeyStringSet& removed) {
+    if (!_pathKeyCounts.isComplete()) {
+        return;
+    }
+
+    StringMap<long long> deltas;
+    for (const auto& key : added) {
+        if (auto path = _extractPath(key)) {
+            ++deltas[*path];
+        }
+    }
+    for (const auto& key : removed) {
+        if (auto path = _extractPath(key)) {
+            --deltas[*path];
+        }
+    }
+    if (deltas.empty()) {
+        return;
+    }
+
+    opCtx->recoveryUnit()->onCommit(
+        [pathKeyCounts = &_pathKeyCounts, deltas = std::move(deltas)](auto commitTime) {
+            pathKeyCounts->add(deltas);
+        });
+}
+
+void WildcardAccessMethod::onBulkKeyCommitted(const KeyString::Value& key) {
+    if (!_pathKeyCounts.isComplete()) {
+        return;
+    }
+
+    if (auto path = _extractPath(key)) {
+        _pathKeyCounts.add({{*path, 1}});
+    }
+}
+
+boost::optional<std::string> WildcardAccessMethod::_extractPath(
+    const KeyString::Value& key) const {
+    // Data keys start with their path, while multikey metadata keys start with the number 1.
+    const BSONObj keyObj = KeyString::toBson(key, getSortedDataInterface()->getOrdering());
+    const auto firstElem = keyObj.firstElement();
+    if (firstElem.type() != BSONType::String) {
+        return boost::none;
+    }
+    return firstElem.str();
+}
+
 FieldRef WildcardAccessMethod::extractMultikeyPathFromIndexKey(const IndexKeyEntry& entry) {
     invariant(entry.loc.isReserved());
     invariant(entry.loc.repr() ==
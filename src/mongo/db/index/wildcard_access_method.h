@@ -33,6 +33,7 @@
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/wildcard_path_key_counts.h"
 
 namespace mongo {
 
@@ -42,6 +43,9 @@ namespace mongo {
  *
  * $** indexes store a special metadata key for each path in the index that is multikey. This class
  * provides an interface to access the multikey metadata: see getMultikeyPaths().
+ *
+ * When internalQueryWildcardIndexPathKeyCounts is enabled, this class also counts the keys of
+ * each indexed path for the query planner: see getPathKeyCounts().
  */
 class WildcardAccessMethod final : public AbstractIndexAccessMethod {
 public:
@@ -77,6 +81,14 @@ public:
         return _keyGen.getWildcardProjection();
     }
 
+    /**
+     * Returns the number of keys of each indexed path, or nullptr if they are not counted. The
+     * counts are only complete for indexes created since the server started.
+     */
+    const WildcardPathKeyCounts* getPathKeyCounts() const {
+        return _countPathKeys ? &_pathKeyCounts : nullptr;
+    }
+
     /**
      * Returns the intersection of 'fieldSet' and the set of paths for which the $** has multikey
      * metadata keys.
@@ -101,10 +113,26 @@ private:
                    MultikeyPaths* multikeyPaths,
                    boost::optional<RecordId> id) const final;
 
+    void onInitializedAsEmpty(OperationContext* opCtx) final;
+
+    void onKeysWritten(OperationContext* opCtx,
+                       const KeyStringSet& added,
+                       const KeyStringSet& removed) final;
+
+    void onBulkKeyCommitted(const KeyString::Value& key) final;
+
+    /**
+     * Returns the path of a key of this index, or boost::none for a multikey metadata key.
+     */
+    boost::optional<std::string> _extractPath(const KeyString::Value& key) const;
+
     std::set<FieldRef> _getMultikeyPathSet(OperationContext* opCtx,
                                            const IndexBounds& indexBounds,
                                            MultikeyMetadataAccessStats* stats) const;
 
     const WildcardKeyGenerator _keyGen;
+
+    const bool _countPathKeys;
+    WildcardPathKeyCounts _pathKeyCounts;
 };
 }  // namespace mongo
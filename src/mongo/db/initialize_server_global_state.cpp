@@ -376,6 +376,11 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         lv2Config.fileOpenMode = serverGlobalParams.logAppend
             ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
             : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
+        lv2Config.fileAsyncWrites = gLogAsyncWrites;
+        lv2Config.fileAsyncBufferBytes = static_cast<size_t>(gLogAsyncBufferSizeMB) * 1024 * 1024;
+        lv2Config.fileAsyncOverflowPolicy = gLogAsyncDropOnOverflow
+            ? logv2::LogDomainGlobal::ConfigurationOptions::OverflowPolicy::kDrop
+            : logv2::LogDomainGlobal::ConfigurationOptions::OverflowPolicy::kBlock;
 
         if (serverGlobalParams.logAppend && exists) {
             writeServerRestartedAfterLogConfig = true;
@@ -33,11 +33,13 @@
 
 #include "mongo/db/logical_time_validator.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/base/init.h"
 #include "mongo/db/auth/action_set.h"
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/privilege.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/keys_collection_manager.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
@@ -68,6 +70,16 @@ MONGO_INITIALIZER(InitializeAdvanceClusterTimePrivilegeVector)(InitializerContex
 
 Milliseconds kRefreshIntervalIfErrored(200);
 
+Counter64 clusterTimesSigned;
+Counter64 clusterTimesValidated;
+Counter64 clusterTimeValidationsSkipped;
+ServerStatusMetricField<Counter64> displayClusterTimesSigned("clusterTime.signed",
+                                                             &clusterTimesSigned);
+ServerStatusMetricField<Counter64> displayClusterTimesValidated("clusterTime.validated",
+                                                                &clusterTimesValidated);
+ServerStatusMetricField<Counter64> displayClusterTimeValidationsSkipped(
+    "clusterTime.validationsSkipped", &clusterTimeValidationsSkipped);
+
 }  // unnamed namespace
 
 LogicalTimeValidator* LogicalTimeValidator::get(ServiceContext* service) {
@@ -102,6 +114,7 @@ SignedLogicalTime LogicalTimeValidator::_getProof(const KeysCollectionDocument&
     }
 
     auto signature = _timeProofService.getProof(newTime, key);
+    clusterTimesSigned.increment();
     SignedLogicalTime newSignedTime(newTime, std::move(signature), keyDoc.getKeyId());
 
     if (newTime > _lastSeenValidTime.getTime() || !_lastSeenValidTime.getProof()) {
@@ -158,7 +171,9 @@ SignedLogicalTime LogicalTimeValidator::signLogicalTime(OperationContext* opCtx,
 Status LogicalTimeValidator::validate(OperationContext* opCtx, const SignedLogicalTime& newTime) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        if (newTime.getTime() <= _lastSeenValidTime.getTime()) {
+        if (newTime.getTime() <= _lastSeenValidTime.getTime() ||
+            newTime.getTime() <= _lastValidatedTime) {
+            clusterTimeValidationsSkipped.increment();
             return Status::OK();
         }
     }
@@ -175,10 +190,17 @@ Status LogicalTimeValidator::validate(OperationContext* opCtx, const SignedLogic
     invariant(newProof);
 
     auto res = _timeProofService.checkProof(newTime.getTime(), newProof.get(), key);
+    clusterTimesValidated.increment();
     if (res != Status::OK()) {
         return res;
     }
 
+    // Every request that gossips this time, or an earlier one, can now skip the HMAC check.
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (newTime.getTime() > _lastValidatedTime) {
+        _lastValidatedTime = newTime.getTime();
+    }
+
     return Status::OK();
 }
 
@@ -214,6 +236,7 @@ void LogicalTimeValidator::resetKeyManagerCache() {
     _keyManager->clearCache();
     stdx::lock_guard<Latch> lk(_mutex);
     _lastSeenValidTime = SignedLogicalTime();
+    _lastValidatedTime = LogicalTime();
     _timeProofService.resetCache();
 }
 
@@ -225,6 +248,7 @@ void LogicalTimeValidator::stopKeyManager() {
 
         stdx::lock_guard<Latch> lk(_mutex);
         _lastSeenValidTime = SignedLogicalTime();
+        _lastValidatedTime = LogicalTime();
         _timeProofService.resetCache();
     } else {
         LOGV2(20718, "Stopping key manager: no key manager exists.");
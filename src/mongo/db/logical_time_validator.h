@@ -71,7 +71,9 @@ public:
     SignedLogicalTime signLogicalTime(OperationContext* opCtx, const LogicalTime& newTime);
 
     /**
-     * Returns true if the signature of newTime is valid.
+     * Returns true if the signature of newTime is valid. Times that are not greater than a time
+     * this validator has already signed or validated are accepted without checking their proof,
+     * since they cannot advance the clock.
      */
     Status validate(OperationContext* opCtx, const SignedLogicalTime& newTime);
 
@@ -122,8 +124,12 @@ private:
 
     SignedLogicalTime _getProof(const KeysCollectionDocument& keyDoc, LogicalTime newTime);
 
-    Mutex _mutex = MONGO_MAKE_LATCH("LogicalTimeValidator::_mutex");  // protects _lastSeenValidTime
+    // protects _lastSeenValidTime and _lastValidatedTime
+    Mutex _mutex = MONGO_MAKE_LATCH("LogicalTimeValidator::_mutex");
     SignedLogicalTime _lastSeenValidTime;
+    // The greatest time whose proof validate() has checked. Kept apart from _lastSeenValidTime so
+    // that proofs received from other nodes are never handed out by _getProof().
+    LogicalTime _lastValidatedTime;
     TimeProofService _timeProofService;
     std::shared_ptr<KeysCollectionManager> _keyManager;
 };
@@ -94,6 +94,10 @@ protected:
         _keyManager->refreshNow(operationContext());
     }
 
+    std::shared_ptr<KeysCollectionManager> keyManager() {
+        return _keyManager;
+    }
+
 private:
     std::unique_ptr<LogicalTimeValidator> _validator;
     std::shared_ptr<KeysCollectionManager> _keyManager;
@@ -140,6 +144,26 @@ TEST_F(LogicalTimeValidatorTest, ValidateErrorsOnInvalidTime) {
     ASSERT_EQ(ErrorCodes::TimeProofMismatch, status);
 }
 
+TEST_F(LogicalTimeValidatorTest, ValidateSkipsProofCheckUpToLastValidatedTime) {
+    validator()->enableKeyGenerator(operationContext(), true);
+    refreshKeyManager();
+
+    // Sign with a separate validator, as another node would, so that validator() has not itself
+    // signed the time it validates.
+    LogicalTimeValidator otherNode(keyManager());
+    auto validTime = otherNode.trySignLogicalTime(LogicalTime(Timestamp(30, 0)));
+    ASSERT_OK(validator()->validate(operationContext(), validTime));
+
+    // Times up to the validated one cannot advance the clock, so their proofs are not checked.
+    TimeProofService::TimeProof invalidProof = {{{1, 2, 3}}};
+    SignedLogicalTime earlierTime(
+        LogicalTime(Timestamp(25, 0)), invalidProof, validTime.getKeyId());
+    ASSERT_OK(validator()->validate(operationContext(), earlierTime));
+
+    SignedLogicalTime laterTime(LogicalTime(Timestamp(40, 0)), invalidProof, validTime.getKeyId());
+    ASSERT_EQ(ErrorCodes::TimeProofMismatch, validator()->validate(operationContext(), laterTime));
+}
+
 TEST_F(LogicalTimeValidatorTest, ValidateReturnsOkForValidSignatureWithImplicitRefresh) {
     validator()->enableKeyGenerator(operationContext(), true);
 
@@ -0,0 +1,213 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_matcher.h"
+
+#include <algorithm>
+#include <boost/optional.hpp>
+
+#include "mongo/db/matcher/match_details.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+namespace {
+
+bool sameElementPath(const ElementPath& lhs, const ElementPath& rhs) {
+    return lhs.leafArrayBehavior() == rhs.leafArrayBehavior() &&
+        lhs.nonLeafArrayBehavior() == rhs.nonLeafArrayBehavior() &&
+        lhs.fieldRef() == rhs.fieldRef();
+}
+
+}  // namespace
+
+std::unique_ptr<CompiledMatcher> CompiledMatcher::compile(const MatchExpression* expr) {
+    if (!expr || expr->matchType() != MatchExpression::AND) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledMatcher> matcher(new CompiledMatcher(expr));
+
+    // Group the path children of the $and by their first component, and within that by path,
+    // keeping the order in which each group first appears.
+    StringMap<size_t> prefixGroupByFirstPart;
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        const MatchExpression* child = expr->getChild(i);
+        auto pathExpr = dynamic_cast<const PathMatchExpression*>(child);
+        if (!pathExpr || pathExpr->path().empty()) {
+            matcher->_steps.push_back({child, 0});
+            continue;
+        }
+
+        const ElementPath* path = pathExpr->elementPath();
+        auto [groupIt, inserted] = prefixGroupByFirstPart.try_emplace(
+            path->fieldRef().getPart(0).toString(), matcher->_prefixGroups.size());
+        if (inserted) {
+            matcher->_prefixGroups.emplace_back();
+            matcher->_steps.push_back({nullptr, groupIt->second});
+        }
+
+        auto& pathGroups = matcher->_prefixGroups[groupIt->second].pathGroups;
+        auto pathGroupIt =
+            std::find_if(pathGroups.begin(), pathGroups.end(), [&](const PathGroup& pathGroup) {
+                return sameElementPath(*pathGroup.path, *path);
+            });
+        if (pathGroupIt == pathGroups.end()) {
+            pathGroups.push_back({path, {pathExpr}});
+        } else {
+            pathGroupIt->predicates.push_back(pathExpr);
+        }
+    }
+
+    bool sharesWork = false;
+    for (auto&& group : matcher->_prefixGroups) {
+        const FieldRef& firstPath = group.pathGroups.front().path->fieldRef();
+        size_t prefixLength = firstPath.numParts() - 1;
+        for (auto&& pathGroup : group.pathGroups) {
+            const FieldRef& path = pathGroup.path->fieldRef();
+            prefixLength = std::min({prefixLength,
+                                     static_cast<size_t>(path.numParts() - 1),
+                                     static_cast<size_t>(firstPath.commonPrefixSize(path))});
+            sharesWork = sharesWork || pathGroup.predicates.size() > 1;
+        }
+
+        if (group.pathGroups.size() > 1 && prefixLength > 0) {
+            group.prefixLength = prefixLength;
+            sharesWork = true;
+        }
+    }
+
+    if (!sharesWork) {
+        return nullptr;
+    }
+    return matcher;
+}
+
+size_t CompiledMatcher::numSharedPrefixes() const {
+    return std::count_if(_prefixGroups.begin(), _prefixGroups.end(), [](const PrefixGroup& group) {
+        return group.prefixLength > 0;
+    });
+}
+
+bool CompiledMatcher::matches(const BSONObj& doc, MatchDetails* details) const {
+    if (details && details->needRecord()) {
+        // The order in which the children are evaluated determines which of them reports the
+        // position of the matched array element, so defer to the tree to get the same answer.
+        return _root->matchesBSON(doc, details);
+    }
+
+    boost::optional<BSONMatchableDocument> matchableDoc;
+    for (auto&& step : _steps) {
+        bool matched;
+        if (step.expr) {
+            if (!matchableDoc) {
+                matchableDoc.emplace(doc);
+            }
+            matched = step.expr->matches(matchableDoc.get_ptr(), details);
+        } else {
+            matched = _matchesPrefixGroup(doc, _prefixGroups[step.prefixGroup], details);
+        }
+
+        if (!matched) {
+            if (details) {
+                details->resetOutput();
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+// static
+BSONElement CompiledMatcher::_resolvePrefix(const BSONObj& doc,
+                                            const FieldRef& path,
+                                            size_t prefixLength) {
+    BSONElement elt = doc.getField(path.getPart(0));
+    for (size_t i = 1; elt.type() == BSONType::Object && i < prefixLength; ++i) {
+        elt = elt.embeddedObject().getField(path.getPart(i));
+    }
+    return elt.type() == BSONType::Object ? elt : BSONElement();
+}
+
+bool CompiledMatcher::_matchesPrefixGroup(const BSONObj& doc,
+                                          const PrefixGroup& group,
+                                          MatchDetails* details) const {
+    // If an array or a missing field is found along the prefix, each path traverses it in its own
+    // way and so is resolved from the root of the document instead.
+    BSONElement prefixElt;
+    if (group.prefixLength > 0) {
+        prefixElt = _resolvePrefix(
+            doc, group.pathGroups.front().path->fieldRef(), group.prefixLength);
+    }
+
+    for (auto&& pathGroup : group.pathGroups) {
+        if (prefixElt.eoo()) {
+            _iterator.reset(pathGroup.path, doc);
+        } else {
+            _iterator.reset(pathGroup.path, group.prefixLength, prefixElt);
+        }
+        if (!_matchesPathGroup(pathGroup, details)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatcher::_matchesPathGroup(const PathGroup& group, MatchDetails* details) const {
+    if (group.predicates.size() == 1) {
+        while (_iterator.more()) {
+            if (group.predicates.front()->matchesSingleElement(_iterator.next().element(),
+                                                               details)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Traverse the path once and evaluate each predicate against the elements it produced.
+    _elements.clear();
+    while (_iterator.more()) {
+        _elements.push_back(_iterator.next());
+    }
+    for (auto&& predicate : group.predicates) {
+        if (std::none_of(_elements.begin(),
+                         _elements.end(),
+                         [&](const ElementIterator::Context& context) {
+                             return predicate->matchesSingleElement(context.element(), details);
+                         })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
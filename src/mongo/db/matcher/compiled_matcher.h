@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/path.h"
+
+namespace mongo {
+
+/**
+ * A matcher for a conjunction of predicates that is evaluated against BSON documents, which walks
+ * each shared path once rather than once per predicate.
+ *
+ * Evaluating an AndMatchExpression visits each child in turn, and every PathMatchExpression child
+ * resolves its own path from the root of the document. For a filter such as
+ * {'a.b.c': {$gt: 1}, 'a.b.c': {$lt: 9}, 'a.b.d': 5} this resolves 'a' and 'a.b' three times, and
+ * iterates 'a.b.c' (including any arrays on it) twice. A CompiledMatcher groups the path children
+ * of the top-level $and:
+ *
+ *  - Predicates on the same path, with the same array behavior, share one traversal of that path.
+ *    The elements it produces are evaluated against each of the predicates.
+ *  - Paths that share leading components are resolved from the element at their longest common
+ *    prefix, which is looked up once per document. This is only done when no array is found along
+ *    that prefix, since an array there would be traversed differently for each path. Otherwise
+ *    the paths are resolved from the root of the document as usual.
+ *
+ * All other children, and the whole expression when the caller asks for the position of a matched
+ * array element, are evaluated through the expression tree. The result is the same as
+ * 'expr->matchesBSON(doc, details)'.
+ *
+ * The expression must outlive the CompiledMatcher and must not be modified while it is in use.
+ * Matching reuses scratch space held by the matcher, so a CompiledMatcher must not be used by more
+ * than one thread at a time.
+ */
+class CompiledMatcher {
+public:
+    /**
+     * Returns a CompiledMatcher for 'expr', or nullptr if no two predicates of 'expr' share a path
+     * prefix and so there is nothing to gain over evaluating 'expr' directly.
+     */
+    static std::unique_ptr<CompiledMatcher> compile(const MatchExpression* expr);
+
+    bool matches(const BSONObj& doc, MatchDetails* details = nullptr) const;
+
+    /**
+     * Returns the number of groups of paths which are resolved from a shared, non-empty prefix.
+     * Exposed for testing.
+     */
+    size_t numSharedPrefixes() const;
+
+private:
+    // The predicates on one path, all with the same array traversal behavior.
+    struct PathGroup {
+        const ElementPath* path;
+        std::vector<const PathMatchExpression*> predicates;
+    };
+
+    // Paths which have the same first component. Each of them extends beyond their first
+    // 'prefixLength' components, which they have in common. 'prefixLength' is zero if the paths
+    // share only a first component that is itself the whole of one of the paths.
+    struct PrefixGroup {
+        size_t prefixLength = 0;
+        std::vector<PathGroup> pathGroups;
+    };
+
+    // One step of evaluation: either a prefix group, or a child evaluated through the tree.
+    struct Step {
+        const MatchExpression* expr = nullptr;
+        size_t prefixGroup = 0;
+    };
+
+    explicit CompiledMatcher(const MatchExpression* root) : _root(root) {}
+
+    /**
+     * Returns the element at the first 'prefixLength' components of 'path' in 'doc', or EOO if it
+     * is missing or if any element along it is not an object. 'prefixLength' must be positive.
+     */
+    static BSONElement _resolvePrefix(const BSONObj& doc,
+                                      const FieldRef& path,
+                                      size_t prefixLength);
+
+    bool _matchesPrefixGroup(const BSONObj& doc,
+                             const PrefixGroup& group,
+                             MatchDetails* details) const;
+
+    /**
+     * Evaluates the predicates of 'group' against the elements produced by '_iterator', which must
+     * have been reset to the group's path.
+     */
+    bool _matchesPathGroup(const PathGroup& group, MatchDetails* details) const;
+
+    const MatchExpression* _root;
+    std::vector<PrefixGroup> _prefixGroups;
+    std::vector<Step> _steps;
+
+    // Scratch space reused across documents.
+    mutable BSONElementIterator _iterator;
+    mutable std::vector<ElementIterator::Context> _elements;
+};
+
+}  // namespace mongo
@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_matcher.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parseAndOptimize(const BSONObj& query) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    StatusWithMatchExpression result = MatchExpressionParser::parse(query, expCtx);
+    ASSERT_OK(result.getStatus());
+    return MatchExpression::optimize(std::move(result.getValue()));
+}
+
+/**
+ * Checks that the compiled form of 'query' agrees with the expression tree on every document in
+ * 'docs'.
+ */
+void assertMatchesLikeTree(const BSONObj& query, const std::vector<BSONObj>& docs) {
+    auto expr = parseAndOptimize(query);
+    auto matcher = CompiledMatcher::compile(expr.get());
+    ASSERT(matcher) << query;
+    for (auto&& doc : docs) {
+        ASSERT_EQ(expr->matchesBSON(doc), matcher->matches(doc))
+            << "query: " << query << ", doc: " << doc;
+    }
+}
+
+const std::vector<BSONObj> kDocs = {
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: null}"),
+    fromjson("{a: {b: {c: 2, d: 5}}}"),
+    fromjson("{a: {b: {c: 10, d: 5}}}"),
+    fromjson("{a: {b: {c: 2}}}"),
+    fromjson("{a: {b: {c: [0, 2, 10], d: 5}}}"),
+    fromjson("{a: {b: {c: [], d: [4, 5]}}}"),
+    fromjson("{a: {b: [{c: 2, d: 5}]}}"),
+    fromjson("{a: {b: [{c: 0, d: 5}, {c: 2, d: 6}]}}"),
+    fromjson("{a: [{b: {c: 2, d: 5}}]}"),
+    fromjson("{a: [{b: {c: 2}}, {b: {d: 5}}]}"),
+    fromjson("{a: {b: 3}}"),
+    fromjson("{a: {b: null}}"),
+    fromjson("{a: {b: {c: null, d: 5}}}"),
+    fromjson("{a: {b: {'0': {c: 2}}, c: 2}}"),
+    fromjson("{a: {b: [[{c: 2}]], x: 1}}"),
+    fromjson("{a: {b: {c: 2, d: 5}, x: 1}, y: 'foo'}"),
+    fromjson("{a: {b: {c: 2, d: 5}}, a: {b: {c: 99}}}"),
+};
+
+TEST(CompiledMatcherTest, DoesNotCompileWithoutSharedPaths) {
+    auto expr = parseAndOptimize(fromjson("{a: 1, b: 1}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+
+    expr = parseAndOptimize(fromjson("{a: {$gt: 1}}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+
+    expr = parseAndOptimize(fromjson("{$or: [{a: 1}, {a: 2}]}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+
+    // The paths share a first component, but it is the whole of one of them.
+    expr = parseAndOptimize(fromjson("{a: 1, 'a.b': 1}"));
+    ASSERT_FALSE(CompiledMatcher::compile(expr.get()));
+}
+
+TEST(CompiledMatcherTest, SharesPrefixOfSiblingPaths) {
+    auto expr = parseAndOptimize(fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 5, x: 1}"));
+    auto matcher = CompiledMatcher::compile(expr.get());
+    ASSERT(matcher);
+    ASSERT_EQ(matcher->numSharedPrefixes(), 1U);
+
+    ASSERT(matcher->matches(fromjson("{a: {b: {c: 2, d: 5}}, x: 1}")));
+    ASSERT_FALSE(matcher->matches(fromjson("{a: {b: {c: 2, d: 5}}, x: 2}")));
+    ASSERT_FALSE(matcher->matches(fromjson("{a: {b: {c: 0, d: 5}}, x: 1}")));
+}
+
+TEST(CompiledMatcherTest, SharesTraversalOfSamePath) {
+    auto expr = parseAndOptimize(fromjson("{a: {$gt: 1, $lt: 9}}"));
+    auto matcher = CompiledMatcher::compile(expr.get());
+    ASSERT(matcher);
+    ASSERT_EQ(matcher->numSharedPrefixes(), 0U);
+
+    ASSERT(matcher->matches(fromjson("{a: 5}")));
+    ASSERT_FALSE(matcher->matches(fromjson("{a: 10}")));
+
+    // Each predicate may be satisfied by a different element of an array.
+    ASSERT(matcher->matches(fromjson("{a: [0, 10]}")));
+    ASSERT_FALSE(matcher->matches(fromjson("{a: [0, 1]}")));
+}
+
+TEST(CompiledMatcherTest, MatchesLikeTreeForComparisons) {
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 5}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$gt: 1, $lt: 5}, 'a.b.d': {$gte: 5}}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': 2, 'a.x': 1, y: 'foo'}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$in: [2, 10]}, 'a.b': {$exists: true}}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.0.c': 2, 'a.b.c': 2}"), kDocs);
+}
+
+TEST(CompiledMatcherTest, MatchesLikeTreeForNullAndMissing) {
+    assertMatchesLikeTree(fromjson("{'a.b.c': null, 'a.b.d': 5}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$exists: false}, 'a.b.d': {$exists: false}}"),
+                          kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$ne: 2}, 'a.b.d': {$ne: 6}}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$not: {$gt: 1}}, 'a.b.d': {$not: {$lt: 0}}}"),
+                          kDocs);
+}
+
+TEST(CompiledMatcherTest, MatchesLikeTreeForArrayOperators) {
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$size: 3}, 'a.b.d': 5}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$elemMatch: {$gt: 1}}, 'a.b.d': {$all: [5]}}"),
+                          kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b': {$elemMatch: {c: 2}}, 'a.b.d': 6}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': {$type: 'array'}, 'a.b.c.1': 2}"), kDocs);
+}
+
+TEST(CompiledMatcherTest, MatchesLikeTreeWithOtherChildren) {
+    assertMatchesLikeTree(
+        fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 5, $or: [{x: 1}, {'a.x': 1}, {y: 'foo'}]}"), kDocs);
+    assertMatchesLikeTree(fromjson("{'a.b.c': 2, 'a.b.d': 5, $nor: [{y: 'foo'}]}"), kDocs);
+}
+
+TEST(CompiledMatcherTest, DefersToTreeForElemMatchKey) {
+    auto expr = parseAndOptimize(fromjson("{'a.b.c': {$gt: 1}, 'a.b.d': 6}"));
+    auto matcher = CompiledMatcher::compile(expr.get());
+    ASSERT(matcher);
+
+    BSONObj doc = fromjson("{a: {b: [{c: 0, d: 5}, {c: 2, d: 6}]}}");
+    MatchDetails details;
+    details.requestElemMatchKey();
+    ASSERT(matcher->matches(doc, &details));
+    ASSERT(details.hasElemMatchKey());
+    ASSERT_EQ(details.elemMatchKey(), "1");
+}
+
+}  // namespace
+}  // namespace mongo
@@ -108,6 +108,10 @@ public:
         return *_query;
     }
 
+    const std::shared_ptr<const GeoExpression>& getSharedGeoExpression() const {
+        return _query;
+    }
+
     void acceptVisitor(MatchExpressionMutableVisitor* visitor) final {
         visitor->visit(this);
     }
@@ -368,6 +368,25 @@ bool ExistsMatchExpression::equivalent(const MatchExpression* other) const {
 
 // ----
 
+struct InMatchExpression::EqualityHashSet {
+    EqualityHashSet(const CollatorInterface* collator, const std::vector<BSONElement>& equalities)
+        : eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, collator),
+          set(eltCmp.makeBSONEltUnorderedSet()) {
+        set.reserve(equalities.size());
+        set.insert(equalities.begin(), equalities.end());
+    }
+
+    // The hasher and equality predicate of 'set' hold a pointer to 'eltCmp', so this struct must
+    // not be copied or moved.
+    EqualityHashSet(const EqualityHashSet&) = delete;
+    EqualityHashSet& operator=(const EqualityHashSet&) = delete;
+
+    const BSONElementComparator eltCmp;
+    BSONEltUnorderedSet set;
+};
+
+constexpr size_t InMatchExpression::kMinEqualitiesForHashSet;
+
 InMatchExpression::InMatchExpression(StringData path)
     : LeafMatchExpression(MATCH_IN, path),
       _eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, _collator) {}
@@ -381,6 +400,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_equalityHashSet = _equalityHashSet;
     next->_originalEqualityVector = _originalEqualityVector;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
@@ -391,6 +411,9 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_equalityHashSet) {
+        return _equalityHashSet->set.count(e) > 0;
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -488,6 +511,11 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     _collator = collator;
     _eltCmp = BSONElementComparator(BSONElementComparator::FieldNamesMode::kIgnore, _collator);
 
+    // We need to re-compute '_equalitySet', since our set comparator has changed.
+    _updateEqualitySet();
+}
+
+void InMatchExpression::_updateEqualitySet() {
     if (!std::is_sorted(_originalEqualityVector.begin(),
                         _originalEqualityVector.end(),
                         _eltCmp.makeLessThan())) {
@@ -495,13 +523,17 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
             _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
     }
 
-    // We need to re-compute '_equalitySet', since our set comparator has changed.
     _equalitySet.clear();
     _equalitySet.reserve(_originalEqualityVector.size());
     std::unique_copy(_originalEqualityVector.begin(),
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+
+    _equalityHashSet.reset();
+    if (_equalitySet.size() >= kMinEqualitiesForHashSet) {
+        _equalityHashSet = std::make_shared<const EqualityHashSet>(_collator, _equalitySet);
+    }
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -521,20 +553,7 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
     }
 
     _originalEqualityVector = std::move(equalities);
-
-    if (!std::is_sorted(_originalEqualityVector.begin(),
-                        _originalEqualityVector.end(),
-                        _eltCmp.makeLessThan())) {
-        std::sort(
-            _originalEqualityVector.begin(), _originalEqualityVector.end(), _eltCmp.makeLessThan());
-    }
-
-    _equalitySet.clear();
-    _equalitySet.reserve(_originalEqualityVector.size());
-    std::unique_copy(_originalEqualityVector.begin(),
-                     _originalEqualityVector.end(),
-                     std::back_inserter(_equalitySet),
-                     _eltCmp.makeEqualTo());
+    _updateEqualitySet();
 
     return Status::OK();
 }
@@ -133,6 +133,21 @@ public:
         return _collator;
     }
 
+    /**
+     * Identifies the right-hand side constant of this expression as an input parameter of the
+     * query. An execution plan which reads the constant from a parameter, rather than having it
+     * baked in, can be rebound to the constants of another query of the same shape.
+     */
+    using InputParamId = int32_t;
+
+    void setInputParamId(boost::optional<InputParamId> id) {
+        _inputParamId = id;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
 protected:
     /**
      * 'collator' must outlive the ComparisonMatchExpression and any clones made of it.
@@ -146,6 +161,8 @@ protected:
     // Collator used to compare elements. By default, simple binary comparison will be used.
     const CollatorInterface* _collator = nullptr;
 
+    boost::optional<InputParamId> _inputParamId;
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
@@ -198,6 +215,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return std::move(e);
     }
 
@@ -228,6 +246,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return std::move(e);
     }
 
@@ -258,6 +277,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return std::move(e);
     }
 
@@ -288,6 +308,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return std::move(e);
     }
 
@@ -318,6 +339,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return std::move(e);
     }
 
@@ -525,9 +547,25 @@ public:
         visitor->visit(this);
     }
 
+    /**
+     * Once an $in has at least this many distinct equalities, membership tests go through a hash
+     * set rather than a binary search of '_equalitySet'.
+     */
+    static constexpr size_t kMinEqualitiesForHashSet = 128;
+
 private:
+    // An immutable hash set of the equalities, along with the comparator its hasher and equality
+    // predicate refer to. Shared between an expression and its clones.
+    struct EqualityHashSet;
+
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Recomputes '_equalitySet' and '_equalityHashSet' from '_originalEqualityVector', sorting the
+     * latter first if needed. Must be called whenever the equalities or the comparator change.
+     */
+    void _updateEqualitySet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -551,10 +589,14 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // For lists of at least 'kMinEqualitiesForHashSet' equalities, such as an $in with thousands
+    // of values, the log(n) comparisons per lookup dominate matching cost, so we also build a hash
+    // set. It is built eagerly rather than on first use because a parsed expression may be shared
+    // by concurrent readers (for example as a partial index filter). Null otherwise.
+    std::shared_ptr<const EqualityHashSet> _equalityHashSet;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
@@ -1370,6 +1370,59 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeInMatchesNumericallyEquivalentValues) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 2 * static_cast<int>(InMatchExpression::kMinEqualitiesForHashSet); ++i) {
+        bab.append(2 * i);
+    }
+    BSONArray operand = bab.arr();
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+
+    InMatchExpression in("");
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 10)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 10LL)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 10.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << Decimal128("10"))["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 11)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 10.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "10")["a"]));
+
+    // Clones share the same lookup structure and must match identically.
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(BSON("a" << 10LL)["a"]));
+    ASSERT(!clone->matchesSingleElement(BSON("a" << 11)["a"]));
+}
+
+TEST(InMatchExpression, LargeInRespectsCollation) {
+    BSONArrayBuilder bab;
+    for (size_t i = 0; i < InMatchExpression::kMinEqualitiesForHashSet; ++i) {
+        bab.append(str::stream() << "VALUE" << i);
+    }
+    BSONArray operand = bab.arr();
+    std::vector<BSONElement> equalities;
+    operand.elems(equalities);
+
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("");
+    in.setCollator(&collator);
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    BSONObj lower = BSON("a"
+                         << "value7");
+    ASSERT(in.matchesSingleElement(lower["a"]));
+
+    // Switching to the simple collation must rebuild the lookup structure.
+    in.setCollator(nullptr);
+    ASSERT(!in.matchesSingleElement(lower["a"]));
+    BSONObj upper = BSON("a"
+                         << "VALUE7");
+    ASSERT(in.matchesSingleElement(upper["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -73,6 +73,10 @@ public:
         return _path;
     }
 
+    const ElementPath* elementPath() const {
+        return &_elementPath;
+    }
+
     void setPath(StringData path) {
         _path = path;
         _elementPath.init(_path);
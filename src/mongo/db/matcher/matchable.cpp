@@ -29,12 +29,16 @@
 
 #include "mongo/db/matcher/matchable.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/platform/basic.h"
 
 namespace mongo {
 
 BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
     _iteratorUsed = false;
+    if (auto threshold = internalQueryMatcherFieldIndexThreshold.load(); threshold > 0) {
+        _fieldIndex.emplace(_obj, threshold);
+    }
 }
 
 BSONMatchableDocument::~BSONMatchableDocument() {}
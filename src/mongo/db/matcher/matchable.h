@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
@@ -84,10 +87,14 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
-        if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+        BSONFieldIndex* fieldIndex = _fieldIndex ? _fieldIndex.get_ptr() : nullptr;
+        if (_iteratorUsed) {
+            auto iterator = new BSONElementIterator();
+            iterator->reset(path, _obj, fieldIndex);
+            return iterator;
+        }
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, fieldIndex);
         return &_iterator;
     }
 
@@ -103,6 +110,10 @@ private:
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    // Answers the lookups of top-level fields once enough of them have been made on '_obj'. Only
+    // present when enabled by the 'internalQueryMatcherFieldIndexThreshold' knob.
+    mutable boost::optional<BSONFieldIndex> _fieldIndex;
 };
 
 /**
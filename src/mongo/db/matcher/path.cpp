@@ -108,18 +108,22 @@ void BSONElementIterator::reset(const ElementPath* path,
 
     _subCursor.reset();
     _subCursorPath.reset();
+    _subdocumentPath.reset();
 }
 
-void BSONElementIterator::reset(const ElementPath* path, const BSONObj& objectToIterate) {
+void BSONElementIterator::reset(const ElementPath* path,
+                                const BSONObj& objectToIterate,
+                                BSONFieldIndex* fieldIndex) {
     _path = path;
     _traversalStartIndex = 0;
-    _traversalStart =
-        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _traversalStart = getFieldDottedOrArray(
+        objectToIterate, _path->fieldRef(), &_traversalStartIndex, 0, fieldIndex);
     _state = BEGIN;
     _next.reset();
 
     _subCursor.reset();
     _subCursorPath.reset();
+    _subdocumentPath.reset();
 }
 
 void BSONElementIterator::_setTraversalStart(size_t suffixIndex, BSONElement elementToIterate) {
@@ -176,7 +180,8 @@ bool BSONElementIterator::subCursorHasMore() {
         if (_subCursor->more()) {
             return true;
         }
-        _subCursor.reset();
+        // Every subcursor is a BSONElementIterator, so this one can be reused for the next.
+        _spareSubCursor.reset(static_cast<BSONElementIterator*>(_subCursor.release()));
 
         // If the subcursor doesn't have more, see if the current element is an array offset
         // match (see comment in BSONElementIterator::more() for an example).  If it is indeed
@@ -281,11 +286,16 @@ bool BSONElementIterator::more() {
             if (eltInArray.type() == Object) {
                 // The current array element is a subdocument.  See if the subdocument generates
                 // any elements matching the remaining subpath.
-                _subCursorPath.reset(new ElementPath());
-                _subCursorPath->init(_arrayIterationState.restOfPath);
-                _subCursorPath->setLeafArrayBehavior(_path->leafArrayBehavior());
+                if (!_subdocumentPath) {
+                    _subdocumentPath = std::make_unique<ElementPath>();
+                    _subdocumentPath->init(_arrayIterationState.restOfPath);
+                    _subdocumentPath->setLeafArrayBehavior(_path->leafArrayBehavior());
+                }
 
-                _subCursor.reset(new BSONElementIterator(_subCursorPath.get(), eltInArray.Obj()));
+                auto subCursor = _spareSubCursor ? std::move(_spareSubCursor)
+                                                 : std::make_unique<BSONElementIterator>();
+                subCursor->reset(_subdocumentPath.get(), eltInArray.Obj());
+                _subCursor = std::move(subCursor);
                 if (subCursorHasMore()) {
                     return true;
                 }
@@ -32,6 +32,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
 
@@ -201,7 +202,14 @@ public:
     virtual ~BSONElementIterator();
 
     void reset(const ElementPath* path, size_t suffixIndex, BSONElement elementToIterate);
-    void reset(const ElementPath* path, const BSONObj& objectToIterate);
+
+    /**
+     * Resets the iterator to iterate over 'objectToIterate'. If 'fieldIndex' is non-null, it must
+     * index the fields of 'objectToIterate', and is used to find the first component of 'path'.
+     */
+    void reset(const ElementPath* path,
+               const BSONObj& objectToIterate,
+               BSONFieldIndex* fieldIndex = nullptr);
 
     bool more();
     Context next();
@@ -259,5 +267,13 @@ private:
 
     std::unique_ptr<ElementIterator> _subCursor;
     std::unique_ptr<ElementPath> _subCursorPath;
+
+    // The remainder of '_path' below the array being traversed, which is shared by the subcursors
+    // over each subdocument in the array rather than being parsed again for each of them.
+    std::unique_ptr<ElementPath> _subdocumentPath;
+
+    // An exhausted subcursor kept for reuse, so that traversing an array of subdocuments does not
+    // allocate an iterator per element.
+    std::unique_ptr<BSONElementIterator> _spareSubCursor;
 };
 }  // namespace mongo
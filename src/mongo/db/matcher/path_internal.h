@@ -32,6 +32,7 @@
 #include <cstdint>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 
@@ -43,10 +44,14 @@ bool isAllDigits(StringData str);
  * Finds the element at 'path' in 'doc', starting at 'startIndex' in 'path'. If none is found, an
  * EOO element is returned. If an array is encountered along 'path', the traversal stops early, and
  * the array is returned. 'idxPath' is set to the furthest index reached in 'path'.
+ *
+ * If 'fieldIndex' is non-null, it must index the fields of 'doc', and is used to look up the first
+ * component of the path.
  */
 BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   const FieldRef& path,
                                   size_t* idxPath,
-                                  size_t startIndex = 0);
+                                  size_t startIndex = 0,
+                                  BSONFieldIndex* fieldIndex = nullptr);
 
 }  // namespace mongo
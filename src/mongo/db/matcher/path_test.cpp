@@ -129,6 +129,41 @@ TEST(Path, Nested1) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, NestedWithFieldIndex) {
+    ElementPath p;
+    p.init("a.b");
+
+    BSONObj doc = BSON("x" << 4 << "a" << BSON("b" << 5 << "c" << 6) << "b" << 7);
+    BSONFieldIndex fieldIndex(doc, 0);
+
+    BSONElementIterator cursor;
+    cursor.reset(&p, doc, &fieldIndex);
+
+    ASSERT(cursor.more());
+    BSONElementIterator::Context e = cursor.next();
+    ASSERT_EQUALS(5, e.element().numberInt());
+    ASSERT(!cursor.more());
+    ASSERT(fieldIndex.isBuilt());
+
+    // Paths whose first component is missing, or whose first component is an array, still behave
+    // as they do without the index.
+    ElementPath missing;
+    missing.init("y.b");
+    cursor.reset(&missing, doc, &fieldIndex);
+    ASSERT(cursor.more());
+    ASSERT(cursor.next().element().eoo());
+    ASSERT(!cursor.more());
+
+    BSONObj arrayDoc = BSON("x" << 4 << "a" << BSON_ARRAY(BSON("b" << 1) << BSON("b" << 2)));
+    BSONFieldIndex arrayFieldIndex(arrayDoc, 0);
+    cursor.reset(&p, arrayDoc, &arrayFieldIndex);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(1, cursor.next().element().numberInt());
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(2, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+}
+
 TEST(Path, NestedPartialMatchScalar) {
     ElementPath p;
     p.init("a.b");
@@ -418,6 +453,41 @@ TEST(Path, NonMatchingLongArrayOfSubdocumentsWithNestedArrays) {
     ASSERT(!cursor.more());
 }
 
+TEST(Path, LongArrayOfSubdocumentsReusesSubcursors) {
+    // Build the document {a: [{b: {c: 0}}, {b: [{c: 1}]}, {b: {c: 2}}, {b: [{c: 3}]}, ...]}, so
+    // that subcursors over both subdocuments and nested arrays are recycled.
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        BSONObj c = BSON("c" << i);
+        builder.append(i % 2 ? BSON("b" << BSON_ARRAY(c)) : BSON("b" << c));
+    }
+    BSONObj doc = BSON("a" << builder.arr());
+
+    ElementPath p;
+    p.init("a.b.c");
+    BSONElementIterator cursor(&p, doc);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(cursor.more());
+        BSONElementIterator::Context e = cursor.next();
+        ASSERT_EQUALS(i, e.element().numberInt());
+    }
+    ASSERT(!cursor.more());
+
+    // Resetting the cursor onto a different path must not reuse the previous subpath.
+    ElementPath other;
+    other.init("a.b");
+    cursor.reset(&other, doc);
+    int numObjects = 0;
+    int numArrays = 0;
+    while (cursor.more()) {
+        BSONElementIterator::Context e = cursor.next();
+        numObjects += e.element().type() == Object;
+        numArrays += e.element().type() == Array;
+    }
+    ASSERT_EQUALS(1000, numObjects);
+    ASSERT_EQUALS(500, numArrays);
+}
+
 // When multiple arrays are traversed implicitly in the same path,
 // ElementIterator::Context::arrayOffset() should always refer to the current offset of the
 // outermost array that is implicitly traversed.
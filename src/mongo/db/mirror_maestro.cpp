@@ -33,6 +33,7 @@
 
 #include "mongo/db/mirror_maestro.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <utility>
@@ -53,8 +54,10 @@
 #include "mongo/executor/connection_pool.h"
 #include "mongo/executor/network_interface_factory.h"
 #include "mongo/executor/remote_command_request.h"
+#include "mongo/executor/remote_command_response.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/synchronized_value.h"
 
@@ -72,6 +75,7 @@ constexpr auto kMirroredReadsSeenKey = "seen"_sd;
 constexpr auto kMirroredReadsSentKey = "sent"_sd;
 constexpr auto kMirroredReadsResolvedKey = "resolved"_sd;
 constexpr auto kMirroredReadsResolvedBreakdownKey = "resolvedBreakdown"_sd;
+constexpr auto kMirroredReadsThrottledKey = "throttled"_sd;
 
 MONGO_FAIL_POINT_DEFINE(mirrorMaestroExpectsResponse);
 
@@ -120,6 +124,34 @@ public:
         MirroredReadsParameters _params;
     };
 
+    /**
+     * Tracks, for each secondary, the share of its sampled reads that are actually mirrored when
+     * adaptive mirroring is enabled. The share is halved whenever a mirrored read fails or uses
+     * more than half of its maxTimeMS, and grows back linearly while the secondary keeps up.
+     */
+    class SecondaryHeadroom {
+    public:
+        static constexpr double kMinShare = 1.0 / 64;
+        static constexpr double kShareIncrement = 1.0 / 32;
+
+        /**
+         * Decide whether a read sampled for `host` should be sent to it.
+         */
+        bool shouldSend(const HostAndPort& host) const noexcept;
+
+        /**
+         * Adjust the share of `host` given the response to a mirrored read.
+         */
+        void onResponse(const HostAndPort& host,
+                        const executor::RemoteCommandResponse& response,
+                        Milliseconds maxTime) noexcept;
+
+    private:
+        mutable Mutex _mutex = MONGO_MAKE_LATCH("MirrorMaestroImpl::SecondaryHeadroom::_mutex");
+
+        stdx::unordered_map<std::string, double> _shares;
+    };
+
 private:
     /**
      * Attempt to mirror invocation to a subset of hosts based on params
@@ -158,6 +190,7 @@ private:
     AtomicWord<bool> _isInitialized;
     MirroredReadsServerParameter* _params = nullptr;
     MirroringSampler _sampler;
+    SecondaryHeadroom _headroom;
     std::shared_ptr<executor::TaskExecutor> _executor;
     repl::TopologyVersionObserver _topologyVersionObserver;
 };
@@ -180,6 +213,7 @@ public:
         BSONObjBuilder section;
         section.append(kMirroredReadsSeenKey, seen.loadRelaxed());
         section.append(kMirroredReadsSentKey, sent.loadRelaxed());
+        section.append(kMirroredReadsThrottledKey, throttled.loadRelaxed());
 
         if (MONGO_unlikely(mirrorMaestroExpectsResponse.shouldFail())) {
             // We only can see if the command resolved if we got a response
@@ -226,6 +260,7 @@ public:
 
     AtomicWord<CounterT> seen;
     AtomicWord<CounterT> sent;
+    AtomicWord<CounterT> throttled;
     AtomicWord<CounterT> resolved;
 } gMirroredReadsSection;
 
@@ -303,21 +338,48 @@ void MirrorMaestroImpl::tryMirror(std::shared_ptr<CommandInvocation> invocation)
     gMirroredReadsSection.seen.fetchAndAdd(1);
 
     auto params = _params->_data.get();
-    if (params.getSamplingRate() == 0) {
-        // Nothing to do if sampling rate is zero.
-        return;
-    }
-
     auto imr = _topologyVersionObserver.getCached();
-    auto samplingParams = MirroringSampler::SamplingParameters(params.getSamplingRate());
-    if (!_sampler.shouldSample(imr, samplingParams)) {
-        // If we wouldn't select a host, then nothing more to do
+    auto hosts = [&]() -> std::vector<HostAndPort> {
+        if (auto preFailoverHost = params.getPreFailoverHost()) {
+            // Ahead of a planned step down, warm up only the secondary expected to take over.
+            auto samplingParams =
+                MirroringSampler::SamplingParameters(params.getPreFailoverSamplingRate());
+            if (!imr ||
+                samplingParams.value >=
+                    static_cast<int>(samplingParams.max * samplingParams.ratio)) {
+                return {};
+            }
+
+            auto target = HostAndPort::parse(*preFailoverHost);
+            auto targets = _sampler.getRawMirroringTargets(imr);
+            if (!target.isOK() ||
+                std::find(targets.begin(), targets.end(), target.getValue()) == targets.end()) {
+                // The host is malformed or not currently an eligible secondary.
+                return {};
+            }
+            return {std::move(target.getValue())};
+        }
+
+        if (params.getSamplingRate() == 0) {
+            // Nothing to do if sampling rate is zero.
+            return {};
+        }
+
+        auto samplingParams = MirroringSampler::SamplingParameters(params.getSamplingRate());
+        if (!_sampler.shouldSample(imr, samplingParams)) {
+            // If we wouldn't select a host, then nothing more to do
+            return {};
+        }
+
+        auto targets = _sampler.getRawMirroringTargets(imr);
+        invariant(!targets.empty());
+        return targets;
+    }();
+
+    if (hosts.empty()) {
         return;
     }
 
-    auto hosts = _sampler.getRawMirroringTargets(imr);
-    invariant(!hosts.empty());
-
     auto clientExecutor = ClientOutOfLineExecutor::get(Client::getCurrent());
     auto clientExecutorHandle = clientExecutor->getHandle();
 
@@ -367,13 +429,27 @@ void MirrorMaestroImpl::_mirror(const std::vector<HostAndPort>& hosts,
         return bob.obj();
     }();
 
-    // Mirror to a normalized subset of eligible hosts (i.e., secondaries).
+    // Mirror to a normalized subset of eligible hosts (i.e., secondaries). A pre-failover request
+    // only ever has its single target host.
     const auto startIndex = rand() % hosts.size();
-    const auto mirroringFactor = std::ceil(params.getSamplingRate() * hosts.size());
+    const auto mirroringFactor = params.getPreFailoverHost()
+        ? 1
+        : std::ceil(params.getSamplingRate() * hosts.size());
+    const auto adaptive = params.getAdaptive();
+    const auto maxTime = Milliseconds(params.getMaxTimeMS());
 
     for (auto i = 0; i < mirroringFactor; i++) {
         auto& host = hosts[(startIndex + i) % hosts.size()];
-        auto mirrorResponseCallback = [host](auto& args) {
+        if (adaptive && !_headroom.shouldSend(host)) {
+            gMirroredReadsSection.throttled.fetchAndAdd(1);
+            continue;
+        }
+
+        auto mirrorResponseCallback = [this, host, adaptive, maxTime](auto& args) {
+            if (adaptive) {
+                _headroom.onResponse(host, args.response, maxTime);
+            }
+
             if (MONGO_likely(!mirrorMaestroExpectsResponse.shouldFail())) {
                 // If we don't expect responses, then there is nothing to do here
                 return;
@@ -393,7 +469,7 @@ void MirrorMaestroImpl::_mirror(const std::vector<HostAndPort>& hosts,
 
         auto newRequest = executor::RemoteCommandRequest(
             host, invocation->ns().db().toString(), payload, nullptr);
-        if (MONGO_likely(!mirrorMaestroExpectsResponse.shouldFail())) {
+        if (!adaptive && MONGO_likely(!mirrorMaestroExpectsResponse.shouldFail())) {
             // If we're not expecting a response, set to fire and forget
             newRequest.fireAndForgetMode = executor::RemoteCommandRequest::FireAndForgetMode::kOn;
         }
@@ -412,6 +488,41 @@ void MirrorMaestroImpl::_mirror(const std::vector<HostAndPort>& hosts,
     LOGV2_DEBUG(31456, 2, "Mirroring failed", "reason"_attr = e);
 }
 
+bool MirrorMaestroImpl::SecondaryHeadroom::shouldSend(const HostAndPort& host) const noexcept {
+    const auto share = [&] {
+        stdx::lock_guard<Mutex> lk(_mutex);
+        auto it = _shares.find(host.toString());
+        return it == _shares.end() ? 1.0 : it->second;
+    }();
+
+    return share >= 1.0 || rand() < static_cast<int>(RAND_MAX * share);
+}
+
+void MirrorMaestroImpl::SecondaryHeadroom::onResponse(
+    const HostAndPort& host,
+    const executor::RemoteCommandResponse& response,
+    Milliseconds maxTime) noexcept {
+    // A secondary with spare tickets and cache answers a single-batch read well within its
+    // maxTimeMS. Treat anything else as a sign that mirroring is eating into its headroom.
+    const bool keptUp = response.isOK() && getStatusFromCommandResult(response.data).isOK() &&
+        response.elapsedMillis && *response.elapsedMillis * 2 < maxTime;
+
+    stdx::lock_guard<Mutex> lk(_mutex);
+    auto& share = _shares.emplace(host.toString(), 1.0).first->second;
+    if (keptUp) {
+        share = std::min(1.0, share + kShareIncrement);
+        return;
+    }
+
+    share = std::max(kMinShare, share / 2);
+    LOGV2_DEBUG(5155044,
+                2,
+                "Reducing the share of reads mirrored to a secondary",
+                "host"_attr = host,
+                "share"_attr = share,
+                "response"_attr = response);
+}
+
 void MirrorMaestroImpl::init(ServiceContext* serviceContext) noexcept {
     LOGV2_DEBUG(31452, 2, "Initializing MirrorMaestro");
 
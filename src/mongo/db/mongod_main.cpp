@@ -61,6 +61,7 @@
 #include "mongo/db/catalog/health_log.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/change_stream_pre_images.h"
 #include "mongo/db/client.h"
 #include "mongo/db/client_metadata_propagation_egress_hook.h"
 #include "mongo/db/clientcursor.h"
@@ -106,6 +107,8 @@
 #include "mongo/db/op_observer_registry.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
+#include "mongo/db/periodic_runner_job_compact_collections.h"
+#include "mongo/db/phase_timeline.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongod.h"
@@ -301,6 +304,9 @@ MONGO_FAIL_POINT_DEFINE(shutdownAtStartup);
 ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
     Client::initThread("initandlisten");
 
+    auto& startupTimeline = PhaseTimeline::getStartup(serviceContext);
+    startupTimeline.start();
+
     initWireSpec();
 
     serviceContext->setFastClockSource(FastClockSourceFactory::create(Milliseconds(10)));
@@ -356,6 +362,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         }
         serviceContext->setTransportLayer(std::move(tl));
     }
+    startupTimeline.endPhase("setUpListener");
 
     FlowControl::set(serviceContext,
                      std::make_unique<FlowControl>(
@@ -363,6 +370,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
     initializeStorageEngine(serviceContext, StorageEngineInitFlags::kNone);
     StorageControl::startStorageControls(serviceContext);
+    startupTimeline.endPhase("initializeStorageEngine");
 
 #ifdef MONGO_CONFIG_WIREDTIGER_ENABLED
     if (EncryptionHooks::get(serviceContext)->restartRequired()) {
@@ -440,6 +448,8 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         ScriptEngine::setup();
     }
 
+    startupTimeline.endPhase("startupChecks");
+
     auto startupOpCtx = serviceContext->makeOperationContext(&cc());
 
     bool canCallFCVSetIfCleanStartup =
@@ -462,6 +472,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
             "error"_attr = error.toStatus().reason());
         exitCleanly(EXIT_NEED_DOWNGRADE);
     }
+    startupTimeline.endPhase("repairDatabasesAndCheckVersion");
 
     auto replProcess = repl::ReplicationProcess::get(serviceContext);
     invariant(replProcess);
@@ -560,6 +571,8 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
             "**          This mode should only be used to manually repair corrupted auth data");
     }
 
+    startupTimeline.endPhase("initializeAuthorization");
+
     WaitForMajorityService::get(serviceContext).setUp(serviceContext);
 
     // This function may take the global lock.
@@ -587,6 +600,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
                       "error"_attr = redact(ex));
     }
     readWriteConcernDefaultsMongodStartupChecks(startupOpCtx.get());
+    startupTimeline.endPhase("initializeSharding");
 
     auto storageEngine = serviceContext->getStorageEngine();
     invariant(storageEngine);
@@ -610,6 +624,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
                 str::stream() << "Cannot use queryableBackupMode in a replica set",
                 !replCoord->isReplEnabled());
         replCoord->startup(startupOpCtx.get());
+        startupTimeline.endPhase("recoverReplication");
     }
 
     if (!storageGlobalParams.readOnly) {
@@ -618,7 +633,11 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
             logStartup(startupOpCtx.get());
         }
 
+        change_stream_pre_images::createPreImagesCollectionIfNeeded(startupOpCtx.get());
+        startupTimeline.endPhase("writeStartupLog");
+
         startMongoDFTDC();
+        startupTimeline.endPhase("startFTDC");
 
         startFreeMonitoring(serviceContext);
 
@@ -659,8 +678,11 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
             ReplicaSetNodeProcessInterface::getReplicaSetNodeExecutor(serviceContext)->startup();
         }
+        startupTimeline.endPhase("initializeClusterRole");
 
+        // Replication startup runs replication recovery and restarts the unfinished index builds.
         replCoord->startup(startupOpCtx.get());
+        startupTimeline.endPhase("recoverReplication");
         if (getReplSetMemberInStandaloneMode(serviceContext)) {
             LOGV2_WARNING_OPTIONS(
                 20547,
@@ -689,13 +711,15 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
     // Start up a background task to periodically check for and kill expired transactions; and a
     // background task to periodically check for and decrease cache pressure by decreasing the
-    // target size setting for the storage engine's window of available snapshots.
+    // target size setting for the storage engine's window of available snapshots. Also start the
+    // background task which compacts collections with much space available for reuse, if enabled.
     //
     // Only do this on storage engines supporting snapshot reads, which hold resources we wish to
     // release periodically in order to avoid storage cache pressure build up.
     if (storageEngine->supportsReadConcernSnapshot()) {
         try {
             PeriodicThreadToAbortExpiredTransactions::get(serviceContext)->start();
+            PeriodicThreadToCompactCollections::get(serviceContext)->start();
         } catch (ExceptionFor<ErrorCodes::PeriodicJobIsStopped>&) {
             LOGV2_WARNING(4747501, "Not starting periodic jobs as shutdown is in progress");
             // Shutdown has already started before initialization is complete. Wait for the
@@ -719,6 +743,8 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
     initializeCommandHooks(serviceContext);
 
+    startupTimeline.endPhase("startBackgroundServices");
+
     // MessageServer::run will return when exit code closes its socket and we don't need the
     // operation context anymore
     startupOpCtx.reset();
@@ -752,6 +778,9 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         }
     }
 
+    startupTimeline.endPhase("startListener");
+    LOGV2(5155018, "Startup complete", "timeline"_attr = startupTimeline.toBSON());
+
     serviceContext->notifyStartupComplete();
 
 #ifndef _WIN32
@@ -1035,6 +1064,9 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     auto const client = Client::getCurrent();
     auto const serviceContext = client->getServiceContext();
 
+    auto& shutdownTimeline = PhaseTimeline::getShutdown(serviceContext);
+    shutdownTimeline.start();
+
     Milliseconds shutdownTimeout;
     if (shutdownArgs.quiesceTime) {
         shutdownTimeout = *shutdownArgs.quiesceTime;
@@ -1069,6 +1101,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
             Milliseconds::zero(),
             shutdownTimeout -
                 (opCtx->getServiceContext()->getPreciseClockSource()->now() - stepDownStartTime));
+        shutdownTimeline.endPhase("stepDown");
     }
 
     if (auto replCoord = repl::ReplicationCoordinator::get(serviceContext);
@@ -1091,6 +1124,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
                       "quiesceTime"_attr = shutdownTimeout);
         opCtx->sleepFor(shutdownTimeout);
         LOGV2_OPTIONS(4695103, {LogComponent::kReplication}, "Exiting quiesce mode for shutdown");
+        shutdownTimeline.endPhase("quiesceMode");
     }
 
     LOGV2_OPTIONS(4784901, {LogComponent::kCommand}, "Shutting down the MirrorMaestro");
@@ -1129,11 +1163,15 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         exec->shutdown();
         exec->join();
     }
+    shutdownTimeline.endPhase("stopAcceptingWork");
 
     if (auto storageEngine = serviceContext->getStorageEngine()) {
         if (storageEngine->supportsReadConcernSnapshot()) {
             LOGV2(4784908, "Shutting down the PeriodicThreadToAbortExpiredTransactions");
             PeriodicThreadToAbortExpiredTransactions::get(serviceContext)->stop();
+
+            LOGV2(5155040, "Shutting down the PeriodicThreadToCompactCollections");
+            PeriodicThreadToCompactCollections::get(serviceContext)->stop();
         }
 
         ServiceContext::UniqueOperationContext uniqueOpCtx;
@@ -1149,6 +1187,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         LOGV2_OPTIONS(
             4784909, {LogComponent::kReplication}, "Shutting down the ReplicationCoordinator");
         repl::ReplicationCoordinator::get(serviceContext)->shutdown(opCtx);
+        shutdownTimeline.endPhase("shutDownReplication");
 
         // Terminate the index consistency check.
         if (serverGlobalParams.clusterRole == ClusterRole::ConfigServer) {
@@ -1192,6 +1231,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
                       {LogComponent::kReplication},
                       "Acquiring the ReplicationStateTransitionLock for shutdown");
         rstl.waitForLockUntil(Date_t::max());
+        shutdownTimeline.endPhase("killOperations");
 
         // Release the rstl before waiting for the index build threads to join as index build
         // reacquires rstl in uninterruptible lock guard to finish their cleanup process.
@@ -1201,6 +1241,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         // Depends on setKillAllOperations() above to interrupt the index build operations.
         LOGV2_OPTIONS(4784915, {LogComponent::kIndex}, "Shutting down the IndexBuildsCoordinator");
         IndexBuildsCoordinator::get(serviceContext)->shutdown(opCtx);
+        shutdownTimeline.endPhase("shutDownIndexBuilds");
 
         // No new readers can come in after the releasing the RSTL, as previously before releasing
         // the RSTL, we made sure that all new operations will be immediately interrupted by setting
@@ -1218,6 +1259,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         // 2) By waiting for all index build to finish.
         LOGV2_OPTIONS(4784917, {LogComponent::kReplication}, "Attempting to mark clean shutdown");
         repl::ReplicationCoordinator::get(serviceContext)->markAsCleanShutdownIfPossible(opCtx);
+        shutdownTimeline.endPhase("markCleanShutdown");
     }
 
     LOGV2_OPTIONS(4784918, {LogComponent::kNetwork}, "Shutting down the ReplicaSetMonitor");
@@ -1276,6 +1318,8 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     }
 #endif
 
+    shutdownTimeline.endPhase("shutDownSharding");
+
     LOGV2(4784925, "Shutting down free monitoring");
     stopFreeMonitoring();
 
@@ -1288,6 +1332,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
 
     LOGV2(4784928, "Shutting down the TTL monitor");
     shutdownTTLMonitor(serviceContext);
+    shutdownTimeline.endPhase("shutDownMonitoring");
 
     // We should always be able to acquire the global lock at shutdown.
     //
@@ -1297,11 +1342,13 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     LOGV2(4784929, "Acquiring the global lock for shutdown");
     LockerImpl* globalLocker = new LockerImpl();
     globalLocker->lockGlobal(MODE_X);
+    shutdownTimeline.endPhase("acquireGlobalLock");
 
     // Global storage engine may not be started in all cases before we exit
     if (serviceContext->getStorageEngine()) {
         LOGV2(4784930, "Shutting down the storage engine");
         shutdownGlobalStorageEngineCleanly(serviceContext);
+        shutdownTimeline.endPhase("shutDownStorageEngine");
     }
 
     // We drop the scope cache because leak sanitizer can't see across the
@@ -1310,6 +1357,7 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     LOGV2_OPTIONS(4784931, {LogComponent::kDefault}, "Dropping the scope cache for shutdown");
     ScriptEngine::dropScopeCache();
 
+    LOGV2(5155019, "Shutdown complete", "timeline"_attr = shutdownTimeline.toBSON());
     LOGV2(20565, "Now exiting");
 
     audit::logShutdown(client);
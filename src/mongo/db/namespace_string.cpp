@@ -84,6 +84,8 @@ const NamespaceString NamespaceString::kRangeDeletionNamespace(NamespaceString::
                                                                "rangeDeletions");
 const NamespaceString NamespaceString::kConfigSettingsNamespace(NamespaceString::kConfigDb,
                                                                 "settings");
+const NamespaceString NamespaceString::kChangeStreamPreImagesNamespace(NamespaceString::kLocalDb,
+                                                                      "system.preimages");
 
 bool NamespaceString::isListCollectionsCursorNS() const {
     return coll() == listCollectionsCursorCol;
@@ -115,6 +117,8 @@ bool NamespaceString::isLegalClientSystemNS() const {
             return true;
         if (coll() == "system.healthlog")
             return true;
+        if (coll() == kChangeStreamPreImagesNamespace.coll())
+            return true;
     }
 
     if (coll() == "system.users")
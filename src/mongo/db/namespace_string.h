@@ -118,6 +118,9 @@ public:
     // Namespace for balancer settings and default read and write concerns.
     static const NamespaceString kConfigSettingsNamespace;
 
+    // Namespace for the pre-images of writes to collections which record them for change streams.
+    static const NamespaceString kChangeStreamPreImagesNamespace;
+
     /**
      * Constructs an empty NamespaceString.
      */
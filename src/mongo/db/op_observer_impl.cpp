@@ -37,6 +37,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/change_stream_pre_images.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
@@ -149,10 +150,35 @@ struct OpTimeBundle {
     Date_t wallClockTime;
 };
 
+bool storesPreImageForRetryableWrite(OperationContext* opCtx, const OplogUpdateEntryArgs& args) {
+    return args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage &&
+        opCtx->getTxnNumber();
+}
+
 /**
- * Write oplog entry(ies) for the update operation.
+ * Stores the pre-image of a write outside of a multi-document transaction in the pre-images
+ * collection, under the timestamp of the write's oplog entry on a primary or the timestamp the
+ * oplog applier gave the write on a secondary. Untimestamped writes have no change events, so
+ * their pre-images are not stored.
  */
-OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs& args) {
+void writePreImageToCollection(OperationContext* opCtx,
+                               const UUID& uuid,
+                               const repl::OpTime& writeOpTime,
+                               const BSONObj& preImage) {
+    auto ts = writeOpTime.isNull() ? opCtx->recoveryUnit()->getLastTimestampSet()
+                                   : boost::make_optional(writeOpTime.getTimestamp());
+    if (ts) {
+        change_stream_pre_images::writePreImage(opCtx, uuid, *ts, preImage);
+    }
+}
+
+/**
+ * Write oplog entry(ies) for the update operation. The pre-image of an update to a collection
+ * which records pre-images goes to a no-op oplog entry unless 'preImageInCollection' is true.
+ */
+OpTimeBundle replLogUpdate(OperationContext* opCtx,
+                           const OplogUpdateEntryArgs& args,
+                           bool preImageInCollection) {
     MutableOplogEntry oplogEntry;
     oplogEntry.setNss(args.nss);
     oplogEntry.setUuid(args.uuid);
@@ -161,10 +187,9 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs&
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, args.updateArgs.stmtId);
 
     OpTimeBundle opTimes;
-    const auto storePreImageForRetryableWrite =
-        (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage &&
-         opCtx->getTxnNumber());
-    if (storePreImageForRetryableWrite || args.updateArgs.preImageRecordingEnabledForCollection) {
+    const auto storePreImageForRetryableWrite = storesPreImageForRetryableWrite(opCtx, args);
+    if (storePreImageForRetryableWrite ||
+        (args.updateArgs.preImageRecordingEnabledForCollection && !preImageInCollection)) {
         MutableOplogEntry noopEntry = oplogEntry;
         invariant(args.updateArgs.preImageDoc);
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
@@ -535,7 +560,16 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
 
         txnParticipant.addTransactionOperation(opCtx, operation);
     } else {
-        opTime = replLogUpdate(opCtx, args);
+        // A pre-image which a retryable findAndModify stores in the oplog serves change streams
+        // too.
+        const bool preImageInCollection = args.updateArgs.preImageRecordingEnabledForCollection &&
+            !storesPreImageForRetryableWrite(opCtx, args) &&
+            change_stream_pre_images::preImagesCollectionExists(opCtx);
+        opTime = replLogUpdate(opCtx, args, preImageInCollection);
+        if (preImageInCollection) {
+            writePreImageToCollection(
+                opCtx, args.uuid, opTime.writeOpTime, *args.updateArgs.preImageDoc);
+        }
         SessionTxnRecord sessionTxnRecord;
         sessionTxnRecord.setLastWriteOpTime(opTime.writeOpTime);
         sessionTxnRecord.setLastWriteDate(opTime.wallClockTime);
@@ -604,7 +638,15 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
 
         txnParticipant.addTransactionOperation(opCtx, operation);
     } else {
-        opTime = replLogDelete(opCtx, nss, uuid, stmtId, fromMigrate, deletedDoc);
+        // Outside of a retryable write, a delete only keeps the deleted document when its
+        // collection records pre-images.
+        const bool preImageInCollection = deletedDoc && !opCtx->getTxnNumber() &&
+            change_stream_pre_images::preImagesCollectionExists(opCtx);
+        opTime = replLogDelete(
+            opCtx, nss, uuid, stmtId, fromMigrate, preImageInCollection ? boost::none : deletedDoc);
+        if (preImageInCollection) {
+            writePreImageToCollection(opCtx, *uuid, opTime.writeOpTime, *deletedDoc);
+        }
         SessionTxnRecord sessionTxnRecord;
         sessionTxnRecord.setLastWriteOpTime(opTime.writeOpTime);
         sessionTxnRecord.setLastWriteDate(opTime.wallClockTime);
@@ -435,6 +435,10 @@ std::unique_ptr<Locker> OperationContext::swapLockState(std::unique_ptr<Locker>
     return locker;
 }
 
+std::unique_ptr<Locker> OperationContext::releaseLockState() {
+    return std::move(_locker);
+}
+
 Date_t OperationContext::getExpirationDateForWaitForValue(Milliseconds waitFor) {
     return getServiceContext()->getPreciseClockSource()->now() + waitFor;
 }
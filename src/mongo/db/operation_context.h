@@ -139,6 +139,12 @@ public:
      */
     std::unique_ptr<Locker> swapLockState(std::unique_ptr<Locker> locker, WithLock);
 
+    /**
+     * Releases ownership of the locker to the caller. Only for use while the OperationContext is
+     * being destroyed, after it has been detached from its Client.
+     */
+    std::unique_ptr<Locker> releaseLockState();
+
     /**
      * Returns Status::OK() unless this operation is in a killed state.
      */
@@ -0,0 +1,334 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_trace.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_trace_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/net/socket_utils.h"
+#include "mongo/util/str.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+// Bounds the memory a traced operation which waits for many locks or sends many requests uses.
+constexpr size_t kMaxSpansPerTrace = 128;
+
+constexpr StringData kTraceParentVersion = "00"_sd;
+constexpr StringData kSampledFlags = "01"_sd;
+constexpr size_t kTraceIdHexLength = 32;
+constexpr size_t kSpanIdHexLength = 16;
+
+Counter64 tracesSampled;
+Counter64 tracesExported;
+Counter64 tracesDropped;
+Counter64 spansDropped;
+
+ServerStatusMetricField<Counter64> displayTracesSampled("operationTracing.sampled",
+                                                        &tracesSampled);
+ServerStatusMetricField<Counter64> displayTracesExported("operationTracing.exported",
+                                                         &tracesExported);
+ServerStatusMetricField<Counter64> displayTracesDropped("operationTracing.droppedTraces",
+                                                        &tracesDropped);
+ServerStatusMetricField<Counter64> displaySpansDropped("operationTracing.droppedSpans",
+                                                       &spansDropped);
+
+const auto getOperationTrace =
+    OperationContext::declareDecoration<std::unique_ptr<OperationTrace>>();
+
+PseudoRandom& threadRandom() {
+    thread_local PseudoRandom random(SecureRandom().nextInt64());
+    return random;
+}
+
+std::string randomHexId(size_t hexLength) {
+    std::string id;
+    while (id.size() < hexLength) {
+        // W3C Trace Context ids must not be all zeros.
+        uint64_t bits = 0;
+        while (!bits) {
+            bits = threadRandom().nextInt64();
+        }
+        id += toHexLower(&bits, sizeof(bits));
+    }
+    return id;
+}
+
+bool isValidHexId(StringData id, size_t hexLength) {
+    return id.size() == hexLength && std::all_of(id.begin(), id.end(), [](char c) {
+               return ('0' <= c && c <= '9') || ('a' <= c && c <= 'f');
+           }) && std::any_of(id.begin(), id.end(), [](char c) { return c != '0'; });
+}
+
+struct TraceParent {
+    std::string traceId;
+    std::string spanId;
+    bool sampled;
+};
+
+TraceParent parseTraceParent(const BSONElement& elem) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << OperationTrace::kMetadataFieldName << " must be a string",
+            elem.type() == String);
+
+    const auto value = elem.valueStringData();
+    const auto traceIdStart = kTraceParentVersion.size() + 1;
+    const auto spanIdStart = traceIdStart + kTraceIdHexLength + 1;
+    const auto flagsStart = spanIdStart + kSpanIdHexLength + 1;
+    const bool valid = value.size() == flagsStart + 2 &&
+        value.substr(0, kTraceParentVersion.size()) == kTraceParentVersion &&
+        value[traceIdStart - 1] == '-' && value[spanIdStart - 1] == '-' &&
+        value[flagsStart - 1] == '-' &&
+        isValidHexId(value.substr(traceIdStart, kTraceIdHexLength), kTraceIdHexLength) &&
+        isValidHexId(value.substr(spanIdStart, kSpanIdHexLength), kSpanIdHexLength) &&
+        isValidHex(value.substr(flagsStart, 2));
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "Invalid " << OperationTrace::kMetadataFieldName << ": " << value,
+            valid);
+
+    const auto flags = uassertStatusOK(fromHex(value.substr(flagsStart, 2)));
+    return {value.substr(traceIdStart, kTraceIdHexLength).toString(),
+            value.substr(spanIdStart, kSpanIdHexLength).toString(),
+            (flags & 0x01) != 0};
+}
+
+/**
+ * Writes finished traces to the log from a background thread, dropping them rather than letting
+ * the queue grow past operationTracingMaxQueuedTraces.
+ */
+class TraceExporter {
+public:
+    static TraceExporter& get() {
+        static auto& exporter = *new TraceExporter();
+        return exporter;
+    }
+
+    void push(BSONObj trace) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_queue.size() >= static_cast<size_t>(gOperationTracingMaxQueuedTraces.load())) {
+            tracesDropped.increment();
+            return;
+        }
+
+        if (!_started) {
+            // The exporter lives for the whole process, as the log does.
+            stdx::thread([this] { _run(); }).detach();
+            _started = true;
+        }
+
+        _queue.push_back(std::move(trace));
+        _cv.notify_one();
+    }
+
+private:
+    void _run() {
+        setThreadName("TraceExporter");
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        while (true) {
+            _cv.wait(lk, [&] { return !_queue.empty(); });
+            auto traces = std::exchange(_queue, {});
+            lk.unlock();
+
+            for (auto&& trace : traces) {
+                LOGV2(5155032, "Operation trace", "trace"_attr = trace);
+                tracesExported.increment();
+            }
+
+            lk.lock();
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("TraceExporter::_mutex");
+    stdx::condition_variable _cv;
+    std::deque<BSONObj> _queue;
+    bool _started = false;
+};
+
+}  // namespace
+
+OperationTrace::OperationTrace(std::string traceId, std::string parentSpanId)
+    : _traceId(std::move(traceId)),
+      _spanId(randomHexId(kSpanIdHexLength)),
+      _parentSpanId(std::move(parentSpanId)),
+      _startMicros(curTimeMicros64()) {}
+
+OperationTrace* OperationTrace::get(OperationContext* opCtx) {
+    return opCtx ? getOperationTrace(opCtx).get() : nullptr;
+}
+
+void OperationTrace::readFromMetadata(OperationContext* opCtx,
+                                      const BSONElement& metadataElem,
+                                      bool trustSampledFlag) {
+    auto& trace = getOperationTrace(opCtx);
+    if (trace) {
+        return;
+    }
+
+    boost::optional<TraceParent> parent;
+    if (metadataElem) {
+        parent = parseTraceParent(metadataElem);
+    }
+
+    bool sampled = parent && parent->sampled && trustSampledFlag;
+    if (!sampled) {
+        const auto sampleRate = gOperationTracingSampleRate.load();
+        sampled = sampleRate > 0 && threadRandom().nextCanonicalDouble() < sampleRate;
+    }
+    if (!sampled) {
+        return;
+    }
+
+    tracesSampled.increment();
+    if (parent) {
+        trace = std::make_unique<OperationTrace>(std::move(parent->traceId),
+                                                 std::move(parent->spanId));
+    } else {
+        trace = std::make_unique<OperationTrace>(randomHexId(kTraceIdHexLength), std::string());
+    }
+}
+
+void OperationTrace::writeToMetadata(OperationContext* opCtx, BSONObjBuilder* metadataBob) {
+    auto trace = get(opCtx);
+    if (!trace) {
+        return;
+    }
+
+    metadataBob->append(kMetadataFieldName,
+                        str::stream() << kTraceParentVersion << '-' << trace->_traceId << '-'
+                                      << trace->_spanId << '-' << kSampledFlags);
+}
+
+void OperationTrace::addSpan(OperationContext* opCtx,
+                             StringData name,
+                             long long startMicros,
+                             long long endMicros,
+                             BSONObj attributes) {
+    if (auto trace = get(opCtx)) {
+        trace->_addSpan(name, startMicros, endMicros, std::move(attributes));
+    }
+}
+
+void OperationTrace::finish(OperationContext* opCtx, StringData name, BSONObj attributes) {
+    auto& trace = getOperationTrace(opCtx);
+    if (!trace) {
+        return;
+    }
+
+    const long long endMicros = curTimeMicros64();
+
+    long long droppedSpans = 0;
+
+    BSONObjBuilder traceBob;
+    traceBob.append("traceId", trace->_traceId);
+    traceBob.append("host", getHostNameCachedAndPort());
+    {
+        BSONArrayBuilder spansBab(traceBob.subarrayStart("spans"));
+
+        BSONObjBuilder rootBob(spansBab.subobjStart());
+        rootBob.append("spanId", trace->_spanId);
+        if (!trace->_parentSpanId.empty()) {
+            rootBob.append("parentSpanId", trace->_parentSpanId);
+        }
+        rootBob.append("name", name);
+        rootBob.append("startTimeUnixMicros", trace->_startMicros);
+        rootBob.append("endTimeUnixMicros", endMicros);
+        rootBob.append("attributes", attributes);
+        rootBob.doneFast();
+
+        stdx::lock_guard<Latch> lk(trace->_mutex);
+        for (auto&& span : trace->_spans) {
+            BSONObjBuilder spanBob(spansBab.subobjStart());
+            spanBob.append("spanId", span.spanId);
+            spanBob.append("parentSpanId", trace->_spanId);
+            spanBob.append("name", span.name);
+            spanBob.append("startTimeUnixMicros", span.startMicros);
+            spanBob.append("endTimeUnixMicros", span.endMicros);
+            spanBob.append("attributes", span.attributes);
+        }
+        droppedSpans = trace->_droppedSpans;
+    }
+    if (droppedSpans) {
+        spansDropped.increment(droppedSpans);
+        traceBob.append("droppedSpans", droppedSpans);
+    }
+    trace.reset();
+
+    TraceExporter::get().push(traceBob.obj());
+}
+
+void OperationTrace::_addSpan(StringData name,
+                              long long startMicros,
+                              long long endMicros,
+                              BSONObj attributes) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_spans.size() >= kMaxSpansPerTrace) {
+        ++_droppedSpans;
+        return;
+    }
+    _spans.push_back({name.toString(),
+                      randomHexId(kSpanIdHexLength),
+                      startMicros,
+                      endMicros,
+                      attributes.getOwned()});
+}
+
+OperationTrace::Span::Span(OperationContext* opCtx, StringData name)
+    : _trace(OperationTrace::get(opCtx)), _name(name) {
+    if (_trace) {
+        _startMicros = curTimeMicros64();
+    }
+}
+
+OperationTrace::Span::~Span() {
+    if (_trace) {
+        _trace->_addSpan(_name, _startMicros, curTimeMicros64(), std::move(_attributes));
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The spans recorded for one sampled operation. The trace and span ids follow the W3C Trace
+ * Context format used by OpenTelemetry, so the spans a mongos and its shards record for the same
+ * operation can be joined by a collector. The context travels between nodes in the request
+ * metadata as:
+ *
+ * $traceparent: "00-<32 hex digit trace id>-<16 hex digit parent span id>-<2 hex digit flags>"
+ *
+ * Every span is a child of the operation's own span, which is the parent of the spans recorded
+ * by the nodes the operation sends requests to. The finished trace is handed to a background
+ * thread which writes it to the log, so recording a trace never waits on I/O.
+ */
+class OperationTrace {
+public:
+    static constexpr StringData kMetadataFieldName = "$traceparent"_sd;
+
+    /**
+     * Returns the trace of 'opCtx', or nullptr if the operation is not being traced.
+     */
+    static OperationTrace* get(OperationContext* opCtx);
+
+    /**
+     * Decides whether to trace the operation. If the request carried a trace context in
+     * 'metadataElem' the operation's span joins that trace. A sampled flag in the context is only
+     * honoured when 'trustSampledFlag' is set, which is for requests from other cluster members;
+     * anything else is sampled at the rate set by the operationTracingSampleRate parameter.
+     */
+    static void readFromMetadata(OperationContext* opCtx,
+                                 const BSONElement& metadataElem,
+                                 bool trustSampledFlag);
+
+    /**
+     * Appends the trace context of a traced operation to the metadata of a request it sends.
+     */
+    static void writeToMetadata(OperationContext* opCtx, BSONObjBuilder* metadataBob);
+
+    /**
+     * Records a span which has already ended, with times in microseconds since the epoch. Does
+     * nothing if the operation is not being traced.
+     */
+    static void addSpan(OperationContext* opCtx,
+                        StringData name,
+                        long long startMicros,
+                        long long endMicros,
+                        BSONObj attributes = BSONObj());
+
+    /**
+     * Ends the operation's own span and queues the trace for export.
+     */
+    static void finish(OperationContext* opCtx, StringData name, BSONObj attributes = BSONObj());
+
+    /**
+     * Records a span covering its own lifetime, if the operation is being traced.
+     */
+    class Span {
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    public:
+        Span(OperationContext* opCtx, StringData name);
+        ~Span();
+
+        void setAttributes(BSONObj attributes) {
+            _attributes = std::move(attributes);
+        }
+
+    private:
+        OperationTrace* const _trace;
+        const StringData _name;
+        long long _startMicros = 0;
+        BSONObj _attributes;
+    };
+
+    OperationTrace(std::string traceId, std::string parentSpanId);
+
+    const std::string& getTraceId() const {
+        return _traceId;
+    }
+
+    const std::string& getSpanId() const {
+        return _spanId;
+    }
+
+private:
+    struct SpanRecord {
+        std::string name;
+        std::string spanId;
+        long long startMicros;
+        long long endMicros;
+        BSONObj attributes;
+    };
+
+    void _addSpan(StringData name, long long startMicros, long long endMicros, BSONObj attributes);
+
+    const std::string _traceId;
+    const std::string _spanId;
+    const std::string _parentSpanId;
+    const long long _startMicros;
+
+    // Spans may be reported by callbacks of the operation's remote requests.
+    Mutex _mutex = MONGO_MAKE_LATCH("OperationTrace::_mutex");
+    std::vector<SpanRecord> _spans;
+    long long _droppedSpans = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_trace.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_trace_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const std::string kTraceId = "4bf92f3577b34da6a3ce929d0e0e4736";
+const std::string kParentSpanId = "00f067aa0ba902b7";
+
+class OperationTraceTest : public ServiceContextTest {
+public:
+    void tearDown() override {
+        gOperationTracingSampleRate.store(0.0);
+        ServiceContextTest::tearDown();
+    }
+
+    static BSONObj traceParent(StringData flags) {
+        return BSON(OperationTrace::kMetadataFieldName
+                    << ("00-" + kTraceId + "-" + kParentSpanId + "-" + flags));
+    }
+};
+
+TEST_F(OperationTraceTest, NotTracedWhenNotSampled) {
+    auto opCtx = makeOperationContext();
+    OperationTrace::readFromMetadata(opCtx.get(), BSONElement(), false);
+    ASSERT_FALSE(OperationTrace::get(opCtx.get()));
+
+    BSONObjBuilder metadataBob;
+    OperationTrace::writeToMetadata(opCtx.get(), &metadataBob);
+    ASSERT_BSONOBJ_EQ(BSONObj(), metadataBob.obj());
+}
+
+TEST_F(OperationTraceTest, JoinsTraceOfTrustedSampledRequest) {
+    auto opCtx = makeOperationContext();
+    auto metadata = traceParent("01");
+    OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), true);
+
+    auto trace = OperationTrace::get(opCtx.get());
+    ASSERT(trace);
+    ASSERT_EQ(kTraceId, trace->getTraceId());
+    ASSERT_NE(kParentSpanId, trace->getSpanId());
+
+    BSONObjBuilder metadataBob;
+    OperationTrace::writeToMetadata(opCtx.get(), &metadataBob);
+    ASSERT_BSONOBJ_EQ(BSON(OperationTrace::kMetadataFieldName
+                           << ("00-" + kTraceId + "-" + trace->getSpanId() + "-01")),
+                      metadataBob.obj());
+
+    OperationTrace::finish(opCtx.get(), "find"_sd);
+    ASSERT_FALSE(OperationTrace::get(opCtx.get()));
+}
+
+TEST_F(OperationTraceTest, IgnoresSampledFlagOfUntrustedRequest) {
+    auto opCtx = makeOperationContext();
+    auto metadata = traceParent("01");
+    OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), false);
+    ASSERT_FALSE(OperationTrace::get(opCtx.get()));
+}
+
+TEST_F(OperationTraceTest, IgnoresUnsampledRequest) {
+    auto opCtx = makeOperationContext();
+    auto metadata = traceParent("00");
+    OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), true);
+    ASSERT_FALSE(OperationTrace::get(opCtx.get()));
+}
+
+TEST_F(OperationTraceTest, SampledWithoutContextStartsNewTrace) {
+    gOperationTracingSampleRate.store(1.0);
+
+    auto opCtx = makeOperationContext();
+    OperationTrace::readFromMetadata(opCtx.get(), BSONElement(), false);
+    auto trace = OperationTrace::get(opCtx.get());
+    ASSERT(trace);
+    ASSERT_EQ(32U, trace->getTraceId().size());
+    ASSERT_EQ(16U, trace->getSpanId().size());
+
+    {
+        OperationTrace::Span span(opCtx.get(), "plan"_sd);
+    }
+    OperationTrace::finish(opCtx.get(), "find"_sd);
+}
+
+TEST_F(OperationTraceTest, SampledRequestKeepsClientTraceId) {
+    gOperationTracingSampleRate.store(1.0);
+
+    auto opCtx = makeOperationContext();
+    auto metadata = traceParent("00");
+    OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), false);
+    auto trace = OperationTrace::get(opCtx.get());
+    ASSERT(trace);
+    ASSERT_EQ(kTraceId, trace->getTraceId());
+}
+
+TEST_F(OperationTraceTest, RejectsMalformedTraceParent) {
+    auto opCtx = makeOperationContext();
+    for (auto&& value : {"01-" + kTraceId + "-" + kParentSpanId + "-01",
+                         "00-" + kTraceId + "-" + kParentSpanId,
+                         "00-" + std::string(32, '0') + "-" + kParentSpanId + "-01",
+                         "00-" + kTraceId + "-" + std::string(16, '0') + "-01",
+                         "00-" + kTraceId + "-00F067AA0BA902B7-01"}) {
+        auto metadata = BSON(OperationTrace::kMetadataFieldName << value);
+        ASSERT_THROWS_CODE(
+            OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), true),
+            DBException,
+            ErrorCodes::FailedToParse);
+    }
+
+    auto metadata = BSON(OperationTrace::kMetadataFieldName << 1);
+    ASSERT_THROWS_CODE(OperationTrace::readFromMetadata(opCtx.get(), metadata.firstElement(), true),
+                       DBException,
+                       ErrorCodes::TypeMismatch);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -30,7 +30,7 @@
 
 #include "mongo/db/ops/insert.h"
 
-#include <vector>
+#include <boost/container/small_vector.hpp>
 
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
@@ -47,8 +47,8 @@ namespace {
  * Validates the nesting depth of 'obj', returning a non-OK status if it exceeds the limit.
  */
 Status validateDepth(const BSONObj& obj) {
-    std::vector<BSONObjIterator> frames;
-    frames.reserve(16);
+    // Most documents are nested only a few levels deep, so keep the frames on the stack.
+    boost::container::small_vector<BSONObjIterator, 16> frames;
     frames.emplace_back(obj);
 
     while (!frames.empty()) {
@@ -81,19 +81,19 @@ StatusWith<BSONObj> fixDocumentForInsert(ServiceContext* service, const BSONObj&
                                                  << ". size in bytes: " << doc.objsize()
                                                  << ", max size: " << BSONObjMaxUserSize);
 
-    auto depthStatus = validateDepth(doc);
-    if (!depthStatus.isOK()) {
-        return depthStatus;
-    }
-
     bool firstElementIsId = false;
     bool hasTimestampToFix = false;
     bool hadId = false;
+    bool hasNestedElements = false;
     {
         BSONObjIterator i(doc);
         for (bool isFirstElement = true; i.more(); isFirstElement = false) {
             BSONElement e = i.next();
 
+            if (e.type() == Object || e.type() == Array) {
+                hasNestedElements = true;
+            }
+
             if (e.type() == bsonTimestamp && e.timestampValue() == 0) {
                 // we replace Timestamp(0,0) at the top level with a correct value
                 // in the fast pass, we just mark that we want to swap
@@ -139,6 +139,15 @@ StatusWith<BSONObj> fixDocumentForInsert(ServiceContext* service, const BSONObj&
         }
     }
 
+    // A document without embedded objects or arrays is only one level deep, so the walk over its
+    // elements above is all the validation it needs.
+    if (hasNestedElements) {
+        auto depthStatus = validateDepth(doc);
+        if (!depthStatus.isOK()) {
+            return depthStatus;
+        }
+    }
+
     if (firstElementIsId && !hasTimestampToFix)
         return StatusWith<BSONObj>(BSONObj());
 
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/rpc/op_msg.h"
+
+namespace mongo {
+namespace {
+
+// The arguments drivers attach to every retryable write; fromDBAndBody() adds "$db".
+void appendGenericArguments(BSONObjBuilder* builder) {
+    builder->append("ordered", true);
+    builder->append("lsid", makeLogicalSessionIdForTest().toBSON());
+    builder->append("txnNumber", 1LL);
+    builder->append("writeConcern", BSON("w" << 1));
+}
+
+OpMsgRequest makeInsertRequest() {
+    BSONObjBuilder builder;
+    builder.append("insert", "coll");
+    builder.append("documents", BSON_ARRAY(BSON("_id" << 1 << "x" << 1)));
+    appendGenericArguments(&builder);
+    return OpMsgRequest::fromDBAndBody("test", builder.obj());
+}
+
+OpMsgRequest makeUpdateRequest() {
+    BSONObjBuilder builder;
+    builder.append("update", "coll");
+    builder.append("updates",
+                   BSON_ARRAY(BSON("q" << BSON("_id" << 1) << "u"
+                                       << BSON("$inc" << BSON("x" << 1)) << "upsert" << true)));
+    appendGenericArguments(&builder);
+    return OpMsgRequest::fromDBAndBody("test", builder.obj());
+}
+
+OpMsgRequest makeDeleteRequest() {
+    BSONObjBuilder builder;
+    builder.append("delete", "coll");
+    builder.append("deletes", BSON_ARRAY(BSON("q" << BSON("_id" << 1) << "limit" << 1)));
+    appendGenericArguments(&builder);
+    return OpMsgRequest::fromDBAndBody("test", builder.obj());
+}
+
+void BM_ParseInsert(benchmark::State& state) {
+    const auto request = makeInsertRequest();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(InsertOp::parse(request));
+    }
+}
+
+void BM_ParseUpdate(benchmark::State& state) {
+    const auto request = makeUpdateRequest();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UpdateOp::parse(request));
+    }
+}
+
+void BM_ParseDelete(benchmark::State& state) {
+    const auto request = makeDeleteRequest();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DeleteOp::parse(request));
+    }
+}
+
+BENCHMARK(BM_ParseInsert);
+BENCHMARK(BM_ParseUpdate);
+BENCHMARK(BM_ParseDelete);
+
+}  // namespace
+}  // namespace mongo
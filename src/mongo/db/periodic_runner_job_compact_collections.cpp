@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/periodic_runner_job_compact_collections.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/background_compaction_gen.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/collection_compact.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+namespace {
+
+Counter64 backgroundCompactionPasses;
+Counter64 backgroundCompactionCollections;
+Counter64 backgroundCompactionBytesFreed;
+
+ServerStatusMetricField<Counter64> backgroundCompactionPassesDisplay(
+    "backgroundCompaction.passes", &backgroundCompactionPasses);
+ServerStatusMetricField<Counter64> backgroundCompactionCollectionsDisplay(
+    "backgroundCompaction.collectionsCompacted", &backgroundCompactionCollections);
+ServerStatusMetricField<Counter64> backgroundCompactionBytesFreedDisplay(
+    "backgroundCompaction.bytesFreed", &backgroundCompactionBytesFreed);
+
+struct CompactionCandidate {
+    NamespaceString nss;
+    int64_t storageSize;
+    int64_t freeStorageSize;
+};
+
+/**
+ * Returns the collections with enough space available for reuse to be worth compacting, the ones
+ * with the most such space first.
+ */
+std::vector<CompactionCandidate> getCompactionCandidates(OperationContext* opCtx) {
+    const auto minFreeRatio = gBackgroundCompactionMinFreeRatio.load();
+    const auto minFreeBytes = gBackgroundCompactionMinFreeBytes.load();
+
+    std::vector<CompactionCandidate> candidates;
+    const auto& catalog = CollectionCatalog::get(opCtx);
+    for (const auto& dbName : catalog.getAllDbNames()) {
+        // The oplog and the other collections of 'local' are left to their own mechanisms.
+        if (dbName == NamespaceString::kLocalDb) {
+            continue;
+        }
+
+        for (const auto& uuid : catalog.getAllCollectionUUIDsFromDb(dbName)) {
+            opCtx->checkForInterrupt();
+            try {
+                AutoGetCollection autoColl(opCtx, {dbName, uuid}, MODE_IS);
+                auto collection = autoColl.getCollection();
+                // Capped collections reuse their space themselves, and system collections may not
+                // be compacted.
+                if (!collection || collection->isCapped() || collection->ns().isSystem()) {
+                    continue;
+                }
+
+                auto recordStore = collection->getRecordStore();
+                if (!recordStore->compactSupported() || !recordStore->supportsOnlineCompaction()) {
+                    continue;
+                }
+
+                auto storageSize = recordStore->storageSize(opCtx);
+                auto freeStorageSize = recordStore->freeStorageSize(opCtx);
+                if (freeStorageSize < minFreeBytes ||
+                    freeStorageSize < minFreeRatio * storageSize) {
+                    continue;
+                }
+                candidates.push_back({collection->ns(), storageSize, freeStorageSize});
+            } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+                // The collection was dropped.
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.freeStorageSize > rhs.freeStorageSize;
+    });
+    return candidates;
+}
+
+void compactCollections(OperationContext* opCtx) {
+    auto candidates = getCompactionCandidates(opCtx);
+    backgroundCompactionPasses.increment();
+
+    const auto maxBytesPerPass = gBackgroundCompactionMaxBytesPerPass.load();
+    long long bytesCompacted = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto& candidate = candidates[i];
+        if (bytesCompacted > 0 && bytesCompacted + candidate.storageSize > maxBytesPerPass) {
+            LOGV2_DEBUG(5155035,
+                        1,
+                        "Background compaction budget reached, deferring the remaining collections",
+                        "remainingCollections"_attr = candidates.size() - i,
+                        "maxBytesPerPass"_attr = maxBytesPerPass);
+            break;
+        }
+        opCtx->checkForInterrupt();
+
+        Timer timer;
+        auto swBytesFreed = compactCollection(opCtx, candidate.nss);
+        if (!swBytesFreed.isOK()) {
+            LOGV2_WARNING(5155036,
+                          "Background compaction of collection failed",
+                          "namespace"_attr = candidate.nss,
+                          "error"_attr = swBytesFreed.getStatus());
+            continue;
+        }
+
+        bytesCompacted += candidate.storageSize;
+        backgroundCompactionCollections.increment();
+        if (swBytesFreed.getValue() > 0) {
+            backgroundCompactionBytesFreed.increment(swBytesFreed.getValue());
+        }
+        LOGV2(5155037,
+              "Background compaction of collection finished",
+              "namespace"_attr = candidate.nss,
+              "storageSize"_attr = candidate.storageSize,
+              "freeStorageSize"_attr = candidate.freeStorageSize,
+              "bytesFreed"_attr = swBytesFreed.getValue(),
+              "durationMillis"_attr = timer.millis());
+    }
+}
+
+}  // namespace
+
+auto PeriodicThreadToCompactCollections::get(ServiceContext* serviceContext)
+    -> PeriodicThreadToCompactCollections& {
+    auto& jobContainer = _serviceDecoration(serviceContext);
+    jobContainer._init(serviceContext);
+
+    return jobContainer;
+}
+
+auto PeriodicThreadToCompactCollections::operator*() const noexcept -> PeriodicJobAnchor& {
+    stdx::lock_guard lk(_mutex);
+    return *_anchor;
+}
+
+auto PeriodicThreadToCompactCollections::operator-> () const noexcept -> PeriodicJobAnchor* {
+    stdx::lock_guard lk(_mutex);
+    return _anchor.get();
+}
+
+void PeriodicThreadToCompactCollections::_init(ServiceContext* serviceContext) {
+    stdx::lock_guard lk(_mutex);
+    if (_anchor) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    PeriodicRunner::PeriodicJob job(
+        "compactCollections",
+        [lastPass = Date_t()](Client* client) mutable {
+            if (!gBackgroundCompactionEnabled.load()) {
+                return;
+            }
+
+            auto now = client->getServiceContext()->getFastClockSource()->now();
+            if (now - lastPass < Seconds(gBackgroundCompactionIntervalSecs.load())) {
+                return;
+            }
+            lastPass = now;
+
+            // The opCtx destructor handles unsetting itself from the Client. (The PeriodicRunner's
+            // Client must be reset before returning.)
+            auto opCtx = client->makeOperationContext();
+            try {
+                compactCollections(opCtx.get());
+            } catch (ExceptionForCat<ErrorCategory::CancelationError>& ex) {
+                LOGV2_DEBUG(5155038, 2, "Periodic job canceled", "reason"_attr = ex.reason());
+            } catch (const DBException& ex) {
+                LOGV2_WARNING(
+                    5155039, "Background compaction pass failed", "error"_attr = ex.toStatus());
+            }
+        },
+        Minutes(1));
+
+    _anchor = std::make_shared<PeriodicJobAnchor>(periodicRunner->makeJob(std::move(job)));
+}
+
+}  // namespace mongo
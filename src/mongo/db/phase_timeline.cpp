@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/phase_timeline.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getStartupTimeline = ServiceContext::declareDecoration<PhaseTimeline>();
+const auto getShutdownTimeline = ServiceContext::declareDecoration<PhaseTimeline>();
+
+class StartupTimelineSSS : public ServerStatusSection {
+public:
+    StartupTimelineSSS() : ServerStatusSection("startupTimeline") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        return PhaseTimeline::getStartup(opCtx->getServiceContext()).toBSON();
+    }
+} startupTimelineSSS;
+
+}  // namespace
+
+PhaseTimeline::PhaseTimeline() = default;
+
+PhaseTimeline::PhaseTimeline(TickSource* tickSource) : _phaseTimer(tickSource) {}
+
+PhaseTimeline& PhaseTimeline::getStartup(ServiceContext* service) {
+    return getStartupTimeline(service);
+}
+
+PhaseTimeline& PhaseTimeline::getShutdown(ServiceContext* service) {
+    return getShutdownTimeline(service);
+}
+
+void PhaseTimeline::start() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _phases.clear();
+    _phaseTimer.reset();
+}
+
+void PhaseTimeline::endPhase(StringData name) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _phases.emplace_back(name.toString(), duration_cast<Milliseconds>(_phaseTimer.elapsed()));
+    _phaseTimer.reset();
+}
+
+BSONObj PhaseTimeline::toBSON() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    BSONObjBuilder builder;
+    Milliseconds total{0};
+    {
+        BSONObjBuilder phasesBuilder(builder.subobjStart("phases"));
+        for (const auto& [name, duration] : _phases) {
+            phasesBuilder.append(name, durationCount<Milliseconds>(duration));
+            total += duration;
+        }
+    }
+    builder.append("totalMillis", durationCount<Milliseconds>(total));
+    return builder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+class ServiceContext;
+class TickSource;
+
+/**
+ * Breaks the time taken by a sequence of steps, such as the startup or the shutdown of mongod,
+ * into phases. Each phase lasts from the end of the previous one, or from the call to start(),
+ * until the call to endPhase() which names it, so that the phases add up to the whole sequence.
+ */
+class PhaseTimeline {
+    PhaseTimeline(const PhaseTimeline&) = delete;
+    PhaseTimeline& operator=(const PhaseTimeline&) = delete;
+
+public:
+    PhaseTimeline();
+    explicit PhaseTimeline(TickSource* tickSource);
+
+    /**
+     * The timelines of the startup and of the shutdown of the server.
+     */
+    static PhaseTimeline& getStartup(ServiceContext* service);
+    static PhaseTimeline& getShutdown(ServiceContext* service);
+
+    /**
+     * Forgets the phases recorded so far and starts timing the first phase.
+     */
+    void start();
+
+    /**
+     * Records the phase 'name', which lasted since the end of the previous phase.
+     */
+    void endPhase(StringData name);
+
+    /**
+     * Returns {phases: {<name>: <millis>, ...}, totalMillis: <millis>}, with the phases in the
+     * order they ended.
+     */
+    BSONObj toBSON() const;
+
+private:
+    // Protects the members below.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PhaseTimeline::_mutex");
+
+    Timer _phaseTimer;
+    std::vector<std::pair<std::string, Milliseconds>> _phases;
+};
+
+}  // namespace mongo
@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/phase_timeline.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/tick_source_mock.h"
+
+namespace mongo {
+namespace {
+
+TEST(PhaseTimelineTest, PhasesLastUntilTheyEnd) {
+    TickSourceMock<Milliseconds> tickSource;
+    PhaseTimeline timeline(&tickSource);
+    timeline.start();
+
+    tickSource.advance(Milliseconds(10));
+    timeline.endPhase("first");
+    tickSource.advance(Milliseconds(5));
+    timeline.endPhase("second");
+    timeline.endPhase("third");
+
+    ASSERT_BSONOBJ_EQ(BSON("phases" << BSON("first" << 10 << "second" << 5 << "third" << 0)
+                                    << "totalMillis" << 15),
+                      timeline.toBSON());
+}
+
+TEST(PhaseTimelineTest, StartForgetsPreviousPhases) {
+    TickSourceMock<Milliseconds> tickSource;
+    PhaseTimeline timeline(&tickSource);
+    timeline.start();
+    tickSource.advance(Milliseconds(10));
+    timeline.endPhase("first");
+
+    tickSource.advance(Milliseconds(7));
+    timeline.start();
+    tickSource.advance(Milliseconds(3));
+    timeline.endPhase("second");
+
+    ASSERT_BSONOBJ_EQ(BSON("phases" << BSON("second" << 3) << "totalMillis" << 3),
+                      timeline.toBSON());
+}
+
+}  // namespace
+}  // namespace mongo
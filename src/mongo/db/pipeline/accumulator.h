@@ -34,6 +34,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -301,6 +302,63 @@ private:
     int _maxMemUsageBytes;
 };
 
+/**
+ * Accumulates the values of 'output' for the 'n' documents which sort first ($topN) or last
+ * ($bottomN) by 'sortBy', using a bounded heap so that at most 'n' values are held per group:
+ *
+ *     {$topN: {n: <positive integer>, sortBy: {<path>: <1 or -1>, ...}, output: <expression>}}
+ *
+ * The result is an array in 'sortBy' order.
+ */
+class AccumulatorTopBottomN final : public AccumulatorState {
+public:
+    enum class Sense { kTop, kBottom };
+
+    AccumulatorTopBottomN(ExpressionContext* const expCtx,
+                          Sense sense,
+                          long long n,
+                          BSONObj sortPattern,
+                          boost::intrusive_ptr<Expression> output);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx,
+                                                         Sense sense,
+                                                         long long n,
+                                                         BSONObj sortPattern,
+                                                         boost::intrusive_ptr<Expression> output);
+
+private:
+    // A sort key, holding one value per field of '_sortPattern', and an output value.
+    using Entry = std::pair<Value, Value>;
+
+    /**
+     * Returns true if 'lhs' is to be kept in preference to 'rhs', i.e. if it sorts before 'rhs'
+     * for $topN, or after it for $bottomN.
+     */
+    bool isPreferred(const Entry& lhs, const Entry& rhs) const;
+
+    void insert(Entry entry);
+
+    const Sense _sense;
+    const long long _n;
+    const BSONObj _sortPattern;
+    std::vector<int> _sortDirections;
+
+    // Only used to serialize this accumulator.
+    const boost::intrusive_ptr<Expression> _output;
+
+    // A heap ordered by isPreferred(), so that the front is the entry which would be evicted first.
+    std::vector<Entry> _heap;
+};
+
 class AccumulatorAvg final : public AccumulatorState {
 public:
     explicit AccumulatorAvg(ExpressionContext* const expCtx);
@@ -370,4 +428,103 @@ private:
     MutableDocument _output;
 };
 
+/**
+ * Estimates the number of distinct values, compared under the collation of the expression context,
+ * with a HyperLogLog sketch of 2^14 one-byte registers. The standard error of the estimate is
+ * about 0.8%. Until a group has seen enough distinct values to need the registers, the hashes of
+ * its values are kept instead and the count is exact.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    static constexpr int kPrecision = 14;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+
+    // The registers take the place of the hashes once there are more hashes than fit in as much
+    // memory as the registers would use.
+    static constexpr size_t kMaxHashes = kNumRegisters / sizeof(uint64_t);
+
+    explicit AccumulatorApproxCountDistinct(ExpressionContext* const expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx);
+
+private:
+    void addHash(uint64_t hash);
+
+    /**
+     * Sorts '_hashes' and removes duplicates from it.
+     */
+    void compactHashes();
+
+    void convertToRegisters();
+
+    void updateMemUsage();
+
+    // While '_registers' is empty, the hashes of the values seen so far, possibly with duplicates.
+    std::vector<uint64_t> _hashes;
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * Estimates percentiles of the numeric values with a merging t-digest, which summarizes the values
+ * as weighted centroids that are kept small near the extremes, where percentiles need the most
+ * precision, and allowed to grow towards the median:
+ *
+ *     {$approxPercentile: {input: <expression>, p: [<number between 0 and 1>, ...]}}
+ *
+ * The result holds an estimate per entry of 'p', or is null if no numeric value was seen. Memory
+ * use is bounded by the compression factor, independent of the number of values.
+ */
+class AccumulatorApproxPercentile final : public AccumulatorState {
+public:
+    // Bounds the number of centroids, which is at most about twice this value.
+    static constexpr double kCompression = 100;
+
+    AccumulatorApproxPercentile(ExpressionContext* const expCtx, std::vector<double> percentiles);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    const char* getOpName() const final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* const expCtx,
+                                                         std::vector<double> percentiles);
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void add(Centroid centroid);
+
+    /**
+     * Merges '_unmerged' into '_centroids'.
+     */
+    void compress();
+
+    /**
+     * Returns the estimated value at quantile 'q' of a compressed digest.
+     */
+    double quantile(double q) const;
+
+    const std::vector<double> _percentiles;
+
+    // Sorted by mean.
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _unmerged;
+
+    double _totalWeight = 0;
+    double _min = std::numeric_limits<double>::infinity();
+    double _max = -std::numeric_limits<double>::infinity();
+};
+
 }  // namespace mongo
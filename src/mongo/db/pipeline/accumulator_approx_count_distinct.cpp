@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    approxCountDistinct,
+    genericParseSingleExpressionAccumulator<AccumulatorApproxCountDistinct>,
+    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo46);
+
+namespace {
+/**
+ * Value hashes are combined with boost::hash_combine, whose bits are too poorly distributed for
+ * HyperLogLog, so they are finalized with the 64-bit mixer of MurmurHash3.
+ */
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(ExpressionContext* const expCtx)
+    : AccumulatorState(expCtx) {
+    updateMemUsage();
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    ExpressionContext* const expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+const char* AccumulatorApproxCountDistinct::getOpName() const {
+    return "$approxCountDistinct";
+}
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        // Like $addToSet, ignore missing values.
+        if (!input.missing()) {
+            addHash(mixHash(getExpressionContext()->getValueComparator().hash(input)));
+            updateMemUsage();
+        }
+        return;
+    }
+
+    // The partial result of a sparse sketch is an array of its hashes, and that of a dense sketch
+    // is its registers.
+    if (input.getType() == BSONType::Array) {
+        for (auto&& hash : input.getArray()) {
+            addHash(static_cast<uint64_t>(hash.getLong()));
+        }
+    } else {
+        auto binData = input.getBinData();
+        uassert(5158005,
+                str::stream() << "Invalid partial result for " << getOpName() << ": expected "
+                              << kNumRegisters << " registers but found " << binData.length,
+                binData.length == static_cast<int>(kNumRegisters));
+        convertToRegisters();
+        auto registers = static_cast<const uint8_t*>(binData.data);
+        for (size_t i = 0; i < kNumRegisters; ++i) {
+            _registers[i] = std::max(_registers[i], registers[i]);
+        }
+    }
+    updateMemUsage();
+}
+
+void AccumulatorApproxCountDistinct::addHash(uint64_t hash) {
+    if (!_registers.empty()) {
+        // The first 'kPrecision' bits of the hash pick a register, which keeps the largest number
+        // of leading zeros seen in the remaining bits, plus one.
+        auto index = hash >> (64 - kPrecision);
+        auto remaining = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+        auto rank = static_cast<uint8_t>(countLeadingZeros64(remaining) + 1);
+        _registers[index] = std::max(_registers[index], rank);
+        return;
+    }
+
+    _hashes.push_back(hash);
+    if (_hashes.size() < kMaxHashes) {
+        return;
+    }
+    compactHashes();
+    if (_hashes.size() > kMaxHashes / 2) {
+        convertToRegisters();
+    }
+}
+
+void AccumulatorApproxCountDistinct::compactHashes() {
+    std::sort(_hashes.begin(), _hashes.end());
+    _hashes.erase(std::unique(_hashes.begin(), _hashes.end()), _hashes.end());
+}
+
+void AccumulatorApproxCountDistinct::convertToRegisters() {
+    if (!_registers.empty()) {
+        return;
+    }
+    _registers.resize(kNumRegisters);
+    for (auto hash : _hashes) {
+        addHash(hash);
+    }
+    std::vector<uint64_t>().swap(_hashes);
+}
+
+void AccumulatorApproxCountDistinct::updateMemUsage() {
+    _memUsageBytes =
+        sizeof(*this) + _hashes.capacity() * sizeof(uint64_t) + _registers.capacity();
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (_registers.empty()) {
+        compactHashes();
+        if (toBeMerged) {
+            std::vector<Value> hashes;
+            hashes.reserve(_hashes.size());
+            for (auto hash : _hashes) {
+                hashes.push_back(Value(static_cast<long long>(hash)));
+            }
+            return Value(std::move(hashes));
+        }
+        return Value::createIntOrLong(static_cast<long long>(_hashes.size()));
+    }
+
+    if (toBeMerged) {
+        return Value(BSONBinData(_registers.data(), kNumRegisters, BinDataGeneral));
+    }
+
+    const double m = kNumRegisters;
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (auto rank : _registers) {
+        sum += std::ldexp(1.0, -rank);
+        numZeroRegisters += rank == 0;
+    }
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+
+    // The raw estimate is biased for small cardinalities, where linear counting of the empty
+    // registers is more accurate. The hashes have 64 bits, so no correction is needed for large
+    // cardinalities.
+    if (estimate <= 2.5 * m && numZeroRegisters > 0) {
+        estimate = m * std::log(m / numZeroRegisters);
+    }
+    return Value::createIntOrLong(std::llround(estimate));
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    std::vector<uint64_t>().swap(_hashes);
+    std::vector<uint8_t>().swap(_registers);
+    updateMemUsage();
+}
+
+}  // namespace mongo
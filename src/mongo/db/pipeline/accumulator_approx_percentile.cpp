@@ -0,0 +1,276 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+namespace {
+const char kMinName[] = "min";
+const char kMaxName[] = "max";
+const char kCentroidsName[] = "centroids";
+
+// Values are buffered and merged into the centroids in batches, which amortizes the sort.
+constexpr size_t kMaxUnmerged = 5 * static_cast<size_t>(AccumulatorApproxPercentile::kCompression);
+
+/**
+ * The t-digest scale function k1, which maps a quantile to a scale on which every centroid may
+ * span at most one unit, so that centroids near the extremes stay small.
+ */
+double quantileToScale(double q) {
+    return AccumulatorApproxPercentile::kCompression / (2 * M_PI) * std::asin(2 * q - 1);
+}
+
+double scaleToQuantile(double k) {
+    if (k >= AccumulatorApproxPercentile::kCompression / 4) {
+        return 1;
+    }
+    return (std::sin(k * 2 * M_PI / AccumulatorApproxPercentile::kCompression) + 1) / 2;
+}
+
+AccumulationExpression parseApproxPercentile(ExpressionContext* const expCtx,
+                                             BSONElement elem,
+                                             VariablesParseState vps) {
+    uassert(5158000,
+            str::stream() << "$approxPercentile expects an object as an argument; found: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    BSONElement inputElem;
+    boost::optional<std::vector<double>> percentiles;
+    for (auto&& element : elem.embeddedObject()) {
+        auto name = element.fieldNameStringData();
+        if (name == "input") {
+            inputElem = element;
+        } else if (name == "p") {
+            uassert(5158001,
+                    str::stream() << "$approxPercentile 'p' must be a non-empty array of numbers "
+                                     "between 0 and 1; found: "
+                                  << element.toString(false),
+                    element.type() == BSONType::Array && !element.embeddedObject().isEmpty());
+            percentiles.emplace();
+            for (auto&& p : element.embeddedObject()) {
+                uassert(5158001,
+                        str::stream() << "$approxPercentile 'p' must be a non-empty array of "
+                                         "numbers between 0 and 1; found: "
+                                      << element.toString(false),
+                        p.isNumber() && p.numberDouble() >= 0 && p.numberDouble() <= 1);
+                percentiles->push_back(p.numberDouble());
+            }
+        } else {
+            uasserted(5158002,
+                      str::stream() << "$approxPercentile got an unexpected field: " << name);
+        }
+    }
+    uassert(5158003, "$approxPercentile missing required argument 'input'", inputElem);
+    uassert(5158004, "$approxPercentile missing required argument 'p'", percentiles);
+
+    auto initializer = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    auto argument = Expression::parseOperand(expCtx, inputElem, vps);
+    return {initializer, argument, [expCtx, percentiles = *percentiles]() {
+                return AccumulatorApproxPercentile::create(expCtx, percentiles);
+            }};
+}
+}  // namespace
+
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    approxPercentile,
+    parseApproxPercentile,
+    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo46);
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(ExpressionContext* const expCtx,
+                                                         std::vector<double> percentiles)
+    : AccumulatorState(expCtx), _percentiles(std::move(percentiles)) {
+    _memUsageBytes = sizeof(*this) + _percentiles.capacity() * sizeof(double);
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxPercentile::create(
+    ExpressionContext* const expCtx, std::vector<double> percentiles) {
+    return new AccumulatorApproxPercentile(expCtx, std::move(percentiles));
+}
+
+const char* AccumulatorApproxPercentile::getOpName() const {
+    return "$approxPercentile";
+}
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    if (!merging) {
+        // Like $avg, ignore non-numeric values.
+        if (input.numeric()) {
+            auto value = input.coerceToDouble();
+            if (!std::isnan(value)) {
+                add({value, 1});
+            }
+        }
+        return;
+    }
+
+    // The partial result is the centroids of a digest, along with its extremes.
+    invariant(input.getType() == BSONType::Object);
+    for (auto&& centroid : input[kCentroidsName].getArray()) {
+        add({centroid[0].getDouble(), centroid[1].getDouble()});
+    }
+    _min = std::min(_min, input[kMinName].getDouble());
+    _max = std::max(_max, input[kMaxName].getDouble());
+}
+
+void AccumulatorApproxPercentile::add(Centroid centroid) {
+    _min = std::min(_min, centroid.mean);
+    _max = std::max(_max, centroid.mean);
+    _totalWeight += centroid.weight;
+    _unmerged.push_back(centroid);
+    _memUsageBytes += sizeof(Centroid);
+    if (_unmerged.size() >= kMaxUnmerged) {
+        compress();
+    }
+}
+
+void AccumulatorApproxPercentile::compress() {
+    if (_unmerged.empty()) {
+        return;
+    }
+
+    _unmerged.insert(_unmerged.end(), _centroids.begin(), _centroids.end());
+    std::sort(_unmerged.begin(), _unmerged.end(), [](const Centroid& lhs, const Centroid& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    // Greedily merge neighbouring centroids for as long as the merged centroid spans at most one
+    // unit of the scale function.
+    _centroids.clear();
+    auto current = _unmerged.front();
+    double weightSoFar = 0;
+    double quantileLimit = scaleToQuantile(quantileToScale(0) + 1);
+    for (auto it = std::next(_unmerged.begin()); it != _unmerged.end(); ++it) {
+        if ((weightSoFar + current.weight + it->weight) / _totalWeight <= quantileLimit) {
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            quantileLimit = scaleToQuantile(quantileToScale(weightSoFar / _totalWeight) + 1);
+            current = *it;
+        }
+    }
+    _centroids.push_back(current);
+    _unmerged.clear();
+
+    _memUsageBytes = sizeof(*this) + _percentiles.capacity() * sizeof(double) +
+        (_centroids.capacity() + _unmerged.capacity()) * sizeof(Centroid);
+}
+
+double AccumulatorApproxPercentile::quantile(double q) const {
+    invariant(!_centroids.empty() && _unmerged.empty());
+
+    // Each centroid is taken to be centered on its share of the total weight, and values between
+    // centers are interpolated. The extremes are known exactly.
+    auto index = q * _totalWeight;
+    const auto& first = _centroids.front();
+    if (index < first.weight / 2) {
+        return _min + (first.mean - _min) * index / (first.weight / 2);
+    }
+
+    double weightSoFar = 0;
+    for (size_t i = 0; i + 1 < _centroids.size(); ++i) {
+        const auto& left = _centroids[i];
+        const auto& right = _centroids[i + 1];
+        auto leftCenter = weightSoFar + left.weight / 2;
+        auto rightCenter = weightSoFar + left.weight + right.weight / 2;
+        if (index <= rightCenter) {
+            return left.mean +
+                (right.mean - left.mean) * (index - leftCenter) / (rightCenter - leftCenter);
+        }
+        weightSoFar += left.weight;
+    }
+
+    const auto& last = _centroids.back();
+    auto lastCenter = _totalWeight - last.weight / 2;
+    if (index <= lastCenter) {
+        return last.mean;
+    }
+    return last.mean + (_max - last.mean) * (index - lastCenter) / (_totalWeight - lastCenter);
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) {
+    compress();
+
+    if (toBeMerged) {
+        std::vector<Value> centroids;
+        centroids.reserve(_centroids.size());
+        for (auto&& centroid : _centroids) {
+            centroids.push_back(
+                Value(std::vector<Value>{Value(centroid.mean), Value(centroid.weight)}));
+        }
+        return Value(
+            DOC(kMinName << _min << kMaxName << _max << kCentroidsName << std::move(centroids)));
+    }
+
+    if (_centroids.empty()) {
+        return Value(BSONNULL);
+    }
+    std::vector<Value> result;
+    result.reserve(_percentiles.size());
+    for (auto p : _percentiles) {
+        result.push_back(Value(std::min(std::max(quantile(p), _min), _max)));
+    }
+    return Value(std::move(result));
+}
+
+void AccumulatorApproxPercentile::reset() {
+    std::vector<Centroid>().swap(_centroids);
+    std::vector<Centroid>().swap(_unmerged);
+    _totalWeight = 0;
+    _min = std::numeric_limits<double>::infinity();
+    _max = -std::numeric_limits<double>::infinity();
+    _memUsageBytes = sizeof(*this) + _percentiles.capacity() * sizeof(double);
+}
+
+Document AccumulatorApproxPercentile::serialize(intrusive_ptr<Expression> initializer,
+                                                intrusive_ptr<Expression> argument,
+                                                bool explain) const {
+    return DOC(getOpName() << DOC("input" << argument->serialize(explain) << "p"
+                                          << Value(std::vector<Value>(_percentiles.begin(),
+                                                                      _percentiles.end()))));
+}
+
+}  // namespace mongo
@@ -109,15 +109,24 @@ void AccumulatorInternalJsReduce::processInternal(const Value& input, bool mergi
 
     _key = kField;
 
-    _memUsageBytes += vField.getApproximateSize();
+    const auto valueSize = vField.getApproximateSize();
+    _memUsageBytes += valueSize;
+    _unreducedBytes += valueSize;
     _values.push_back(std::move(vField));
-}
 
-Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
-    if (_values.size() < 1) {
-        return Value{};
+    // Combine the values of a key as they accumulate, so that a key with many emitted values
+    // doesn't hold all of them in memory until the group is complete. Reduce functions must
+    // already accept their own output among their input values, since a reduce of a large group
+    // is split into several calls and results from shards are reduced again.
+    const auto incrementalBytes = internalQueryIncrementalJsReduceBytes.load();
+    if (incrementalBytes > 0 && _unreducedBytes > incrementalBytes && _values.size() > 1) {
+        Value reduced = reduceValues();
+        _memUsageBytes = sizeof(*this) + reduced.getApproximateSize();
+        _values.push_back(std::move(reduced));
     }
+}
 
+Value AccumulatorInternalJsReduce::reduceValues() {
     const auto keySize = _key.getApproximateSize();
 
     Value result;
@@ -161,6 +170,18 @@ Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
         }
     }
 
+    _values.clear();
+    _unreducedBytes = 0;
+    return result;
+}
+
+Value AccumulatorInternalJsReduce::getValue(bool toBeMerged) {
+    if (_values.size() < 1) {
+        return Value{};
+    }
+
+    Value result = reduceValues();
+
     // If we're merging after this, wrap the value in the same format it was inserted in.
     if (toBeMerged) {
         MutableDocument output;
@@ -181,6 +202,7 @@ boost::intrusive_ptr<AccumulatorState> AccumulatorInternalJsReduce::create(
 void AccumulatorInternalJsReduce::reset() {
     _values.clear();
     _memUsageBytes = sizeof(*this);
+    _unreducedBytes = 0;
     _key = Value{};
 }
 
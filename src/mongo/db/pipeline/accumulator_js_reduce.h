@@ -71,9 +71,18 @@ public:
 private:
     static std::string parseReduceFunction(BSONElement func);
 
+    /**
+     * Calls the reduce function until the gathered values are reduced to exactly one, and returns
+     * it. Leaves '_values' empty.
+     */
+    Value reduceValues();
+
     std::string _funcSource;
     std::vector<Value> _values;
     Value _key;
+
+    // The approximate size of the values gathered since the last call to reduceValues().
+    long long _unreducedBytes = 0;
 };
 
 class AccumulatorJs final : public AccumulatorState {
@@ -38,7 +38,9 @@
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -174,6 +176,44 @@ TEST_F(MapReduceFixture, InternalJsReduceIdempotentOnlyWhenJSFunctionIsIdempoten
     ASSERT_EQUALS(expectedResult.getType(), result.getType());
 }
 
+TEST_F(MapReduceFixture, InternalJsReduceCombinesValuesAsTheyAccumulate) {
+    const auto oldIncrementalBytes = internalQueryIncrementalJsReduceBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryIncrementalJsReduceBytes.store(oldIncrementalBytes); });
+
+    std::string eval(
+        "function(key, values) {"
+        "    reduceCalls = (typeof reduceCalls === 'undefined' ? 0 : reduceCalls) + 1;"
+        "    return Array.sum(values);"
+        "};");
+    auto reduceCalls = [&] {
+        return getExpCtx()->getJsExecWithScope()->getScope()->getNumber("reduceCalls");
+    };
+
+    // With a threshold below the size of a single value, every value after the first is combined
+    // with the reduced value as it arrives, so memory use stays flat.
+    internalQueryIncrementalJsReduceBytes.store(1);
+    auto accum = AccumulatorInternalJsReduce::create(getExpCtx(), eval);
+    accum->process(Value(DOC("k" << 1 << "v" << 1)), false);
+    const auto memUsageAfterOne = accum->memUsageForSorter();
+    for (int i = 2; i <= 100; ++i) {
+        accum->process(Value(DOC("k" << 1 << "v" << i)), false);
+        ASSERT_LTE(accum->memUsageForSorter(), memUsageAfterOne + 64);
+    }
+    ASSERT_EQ(99, reduceCalls());
+    ASSERT_VALUE_EQ(Value(5050.0), accum->getValue(false));
+    ASSERT_EQ(100, reduceCalls());
+
+    // With incremental reduce disabled the group is reduced once, at the end.
+    internalQueryIncrementalJsReduceBytes.store(0);
+    accum = AccumulatorInternalJsReduce::create(getExpCtx(), eval);
+    for (int i = 1; i <= 100; ++i) {
+        accum->process(Value(DOC("k" << 1 << "v" << i)), false);
+    }
+    ASSERT_GT(accum->memUsageForSorter(), memUsageAfterOne + 64);
+    ASSERT_VALUE_EQ(Value(5050.0), accum->getValue(false));
+    ASSERT_EQ(101, reduceCalls());
+}
+
 TEST_F(MapReduceFixture, InternalJsReduceFailsWhenEvalContainsInvalidJavascript) {
     std::string eval("INVALID_JAVASCRIPT");
     // Multiple source documents.
@@ -368,6 +368,245 @@ TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+/* ------------------------- AccumulatorTopBottomN -------------------------- */
+
+/**
+ * Parses 'spec' as a $group accumulated field and returns the result of accumulating 'docs' with
+ * it, both on a single node and with each document accumulated on a separate shard.
+ */
+Value accumulateTopBottomN(ExpressionContext* const expCtx,
+                           const BSONObj& spec,
+                           const std::vector<Document>& docs) {
+    auto statement = AccumulationStatement::parseAccumulationStatement(
+        expCtx, spec.firstElement(), expCtx->variablesParseState);
+
+    auto accum = statement.makeAccumulator();
+    auto merger = statement.makeAccumulator();
+    for (auto&& doc : docs) {
+        auto input = statement.expr.argument->evaluate(doc, &expCtx->variables);
+        accum->process(input, false);
+
+        auto shard = statement.makeAccumulator();
+        shard->process(input, false);
+        merger->process(shard->getValue(true), true);
+    }
+
+    auto result = accum->getValue(false);
+    ASSERT_VALUE_EQ(result, merger->getValue(false));
+    return result;
+}
+
+TEST(Accumulators, TopNReturnsFirstValuesInSortOrder) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<Document> docs{Document{{"name", "a"_sd}, {"score", 3}},
+                               Document{{"name", "b"_sd}, {"score", 5}},
+                               Document{{"name", "c"_sd}, {"score", 1}},
+                               Document{{"name", "d"_sd}, {"score", 4}}};
+
+    auto result = accumulateTopBottomN(
+        &expCtx, fromjson("{top: {$topN: {n: 2, sortBy: {score: -1}, output: '$name'}}}"), docs);
+    ASSERT_VALUE_EQ(result, Value(std::vector<Value>{Value("b"_sd), Value("d"_sd)}));
+
+    // Asking for more values than there are documents returns all of them.
+    result = accumulateTopBottomN(
+        &expCtx, fromjson("{top: {$topN: {n: 10, sortBy: {score: 1}, output: '$name'}}}"), docs);
+    ASSERT_VALUE_EQ(result,
+                    Value(std::vector<Value>{
+                        Value("c"_sd), Value("a"_sd), Value("d"_sd), Value("b"_sd)}));
+}
+
+TEST(Accumulators, BottomNReturnsLastValuesInSortOrder) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<Document> docs{Document{{"name", "a"_sd}, {"x", 1}, {"y", 2}},
+                               Document{{"name", "b"_sd}, {"x", 2}, {"y", 1}},
+                               Document{{"name", "c"_sd}, {"x", 2}, {"y", 3}},
+                               Document{{"name", "d"_sd}},
+                               Document{{"name", "e"_sd}, {"x", 1}, {"y", 1}}};
+
+    // Documents missing a sort field sort as though it were null, first in ascending order.
+    auto result = accumulateTopBottomN(
+        &expCtx,
+        fromjson("{bottom: {$bottomN: {n: 3, sortBy: {x: 1, y: -1}, output: '$name'}}}"),
+        docs);
+    ASSERT_VALUE_EQ(result,
+                    Value(std::vector<Value>{Value("e"_sd), Value("c"_sd), Value("b"_sd)}));
+}
+
+TEST(Accumulators, TopNRespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    auto collator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kReverseString);
+    expCtx.setCollator(std::move(collator));
+    std::vector<Document> docs{Document{{"name", "ab"_sd}},
+                               Document{{"name", "ba"_sd}},
+                               Document{{"name", "ca"_sd}}};
+
+    auto result = accumulateTopBottomN(
+        &expCtx, fromjson("{top: {$topN: {n: 2, sortBy: {name: 1}, output: '$name'}}}"), docs);
+    ASSERT_VALUE_EQ(result, Value(std::vector<Value>{Value("ba"_sd), Value("ca"_sd)}));
+}
+
+TEST(Accumulators, TopNSerializesOriginalSpecification) {
+    auto expCtx = ExpressionContextForTest{};
+    auto spec = fromjson("{top: {$topN: {n: 2, sortBy: {score: -1}, output: '$name'}}}");
+    auto statement = AccumulationStatement::parseAccumulationStatement(
+        &expCtx, spec.firstElement(), expCtx.variablesParseState);
+
+    auto serialized = statement.makeAccumulator()->serialize(
+        statement.expr.initializer, statement.expr.argument, false);
+    ASSERT_DOCUMENT_EQ(serialized, Document(spec["top"].Obj()));
+}
+
+TEST(Accumulators, TopNRejectsInvalidArguments) {
+    auto expCtx = ExpressionContextForTest{};
+    auto parse = [&](const BSONObj& spec) {
+        AccumulationStatement::parseAccumulationStatement(
+            &expCtx, spec.firstElement(), expCtx.variablesParseState);
+    };
+
+    ASSERT_THROWS_CODE(parse(fromjson("{top: {$topN: 1}}")), AssertionException, 5156000);
+    ASSERT_THROWS_CODE(parse(fromjson("{top: {$topN: {n: 0, sortBy: {a: 1}, output: '$a'}}}")),
+                       AssertionException,
+                       5156001);
+    ASSERT_THROWS_CODE(parse(fromjson("{top: {$topN: {n: 1.5, sortBy: {a: 1}, output: '$a'}}}")),
+                       AssertionException,
+                       5156001);
+    ASSERT_THROWS_CODE(
+        parse(fromjson("{top: {$topN: {n: 1, sortBy: {a: 1}, output: '$a', x: 1}}}")),
+        AssertionException,
+        5156003);
+    ASSERT_THROWS_CODE(parse(fromjson("{top: {$topN: {n: 1, output: '$a'}}}")),
+                       AssertionException,
+                       5156005);
+    ASSERT_THROWS_CODE(parse(fromjson("{top: {$bottomN: {n: 1, sortBy: {a: 2}, output: '$a'}}}")),
+                       AssertionException,
+                       5156008);
+}
+
+TEST(Accumulators, ApproxCountDistinctIsExactForFewValues) {
+    auto expCtx = ExpressionContextForTest{};
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx,
+        {
+            // No documents evaluated.
+            {{}, Value(0)},
+            // Missing values are ignored, but null is counted.
+            {{Value(), Value(BSONNULL), Value(BSONNULL)}, Value(1)},
+            // Numbers which compare equal are counted once.
+            {{Value(1), Value(1.0), Value(1LL), Value("1"_sd), Value(2)}, Value(3)},
+        });
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    auto collator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx.setCollator(std::move(collator));
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctEstimatesLargeCardinalities) {
+    auto expCtx = ExpressionContextForTest{};
+    const int kNumDistinct = 100000;
+    const int kNumShards = 4;
+
+    auto accum = AccumulatorApproxCountDistinct::create(&expCtx);
+    std::vector<intrusive_ptr<AccumulatorState>> shards;
+    for (int i = 0; i < kNumShards; ++i) {
+        shards.push_back(AccumulatorApproxCountDistinct::create(&expCtx));
+    }
+    for (int i = 0; i < kNumDistinct; ++i) {
+        accum->process(Value(i), false);
+        accum->process(Value(i), false);
+        shards[i % kNumShards]->process(Value(i), false);
+    }
+
+    auto estimate = accum->getValue(false).coerceToLong();
+    ASSERT_LT(std::abs(estimate - kNumDistinct), kNumDistinct * 3 / 100);
+
+    // Merging the sketches of the shards gives the same estimate as a single sketch.
+    auto merger = AccumulatorApproxCountDistinct::create(&expCtx);
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+    ASSERT_EQ(merger->getValue(false).coerceToLong(), estimate);
+
+    // A sketch holds a fixed number of registers, however many values it has seen.
+    ASSERT_LT(static_cast<size_t>(accum->memUsageForSorter()),
+              2 * AccumulatorApproxCountDistinct::kNumRegisters);
+}
+
+TEST(Accumulators, ApproxPercentileEstimatesPercentiles) {
+    auto expCtx = ExpressionContextForTest{};
+    const int kNumValues = 100000;
+    const int kNumShards = 4;
+    std::vector<double> percentiles{0, 0.01, 0.5, 0.99, 1};
+
+    auto accum = AccumulatorApproxPercentile::create(&expCtx, percentiles);
+    std::vector<intrusive_ptr<AccumulatorState>> shards;
+    for (int i = 0; i < kNumShards; ++i) {
+        shards.push_back(AccumulatorApproxPercentile::create(&expCtx, percentiles));
+    }
+    // Insert the values 1 to 'kNumValues' in an order which is not sorted.
+    for (int i = 0; i < kNumValues; ++i) {
+        auto value = Value((i * 7919) % kNumValues + 1);
+        accum->process(value, false);
+        shards[i % kNumShards]->process(value, false);
+    }
+    accum->process(Value("not a number"_sd), false);
+
+    auto merger = AccumulatorApproxPercentile::create(&expCtx, percentiles);
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+
+    for (auto&& result : {accum->getValue(false), merger->getValue(false)}) {
+        ASSERT_EQ(result.getArrayLength(), percentiles.size());
+        ASSERT_EQ(result[0].getDouble(), 1);
+        ASSERT_EQ(result[4].getDouble(), kNumValues);
+        for (size_t i = 1; i + 1 < percentiles.size(); ++i) {
+            auto expected = percentiles[i] * kNumValues;
+            ASSERT_LT(std::abs(result[i].getDouble() - expected), kNumValues / 200);
+        }
+    }
+
+    // The digest is bounded by its compression rather than by the number of values.
+    ASSERT_LT(accum->memUsageForSorter(), 64 * 1024);
+}
+
+TEST(Accumulators, ApproxPercentileOfNoNumbersIsNull) {
+    auto expCtx = ExpressionContextForTest{};
+    auto accum = AccumulatorApproxPercentile::create(&expCtx, {0.5});
+    accum->process(Value("a"_sd), false);
+    accum->process(Value(BSONNULL), false);
+    ASSERT_VALUE_EQ(accum->getValue(false), Value(BSONNULL));
+
+    auto merger = AccumulatorApproxPercentile::create(&expCtx, {0.5});
+    merger->process(accum->getValue(true), true);
+    ASSERT_VALUE_EQ(merger->getValue(false), Value(BSONNULL));
+}
+
+TEST(Accumulators, ApproxPercentileRejectsInvalidArguments) {
+    auto expCtx = ExpressionContextForTest{};
+    auto parse = [&](const BSONObj& spec) {
+        AccumulationStatement::parseAccumulationStatement(
+            &expCtx, spec.firstElement(), expCtx.variablesParseState);
+    };
+
+    ASSERT_THROWS_CODE(
+        parse(fromjson("{p: {$approxPercentile: '$a'}}")), AssertionException, 5158000);
+    ASSERT_THROWS_CODE(parse(fromjson("{p: {$approxPercentile: {input: '$a', p: []}}}")),
+                       AssertionException,
+                       5158001);
+    ASSERT_THROWS_CODE(parse(fromjson("{p: {$approxPercentile: {input: '$a', p: [1.5]}}}")),
+                       AssertionException,
+                       5158001);
+    ASSERT_THROWS_CODE(parse(fromjson("{p: {$approxPercentile: {input: '$a'}}}")),
+                       AssertionException,
+                       5158004);
+}
+
 /* ------------------------- AccumulatorMergeObjects -------------------------- */
 
 TEST(AccumulatorMergeObjects, MergingZeroObjectsShouldReturnEmptyDocument) {
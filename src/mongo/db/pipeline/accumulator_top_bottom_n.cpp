@@ -0,0 +1,241 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include <algorithm>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+namespace {
+/**
+ * Parses {n: <positive integer>, sortBy: {<path>: <1 or -1>, ...}, output: <expression>}. The
+ * argument evaluated for each document is the array [[<sort key values>], <output>].
+ */
+template <AccumulatorTopBottomN::Sense sense>
+AccumulationExpression parseTopBottomN(ExpressionContext* const expCtx,
+                                       BSONElement elem,
+                                       VariablesParseState vps) {
+    const StringData opName = sense == AccumulatorTopBottomN::Sense::kTop ? "$topN"_sd
+                                                                          : "$bottomN"_sd;
+    uassert(5156000,
+            str::stream() << opName << " expects an object as an argument; found: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    boost::optional<long long> n;
+    boost::optional<BSONObj> sortPattern;
+    BSONElement outputElem;
+    for (auto&& element : elem.embeddedObject()) {
+        auto name = element.fieldNameStringData();
+        if (name == "n") {
+            auto parsedN = element.parseIntegerElementToLong();
+            uassert(5156001,
+                    str::stream() << opName << " 'n' must be a positive integer; found: "
+                                  << element.toString(false),
+                    parsedN.isOK() && parsedN.getValue() > 0);
+            n = parsedN.getValue();
+        } else if (name == "sortBy") {
+            uassert(5156002,
+                    str::stream() << opName << " 'sortBy' must be an object; found: "
+                                  << typeName(element.type()),
+                    element.type() == BSONType::Object);
+            sortPattern = element.embeddedObject().getOwned();
+        } else if (name == "output") {
+            outputElem = element;
+        } else {
+            uasserted(5156003, str::stream() << opName << " got an unexpected field: " << name);
+        }
+    }
+    uassert(5156004, str::stream() << opName << " missing required argument 'n'", n);
+    uassert(5156005, str::stream() << opName << " missing required argument 'sortBy'", sortPattern);
+    uassert(5156006, str::stream() << opName << " missing required argument 'output'", outputElem);
+    uassert(5156007,
+            str::stream() << opName << " 'sortBy' must specify at least one field",
+            !sortPattern->isEmpty());
+
+    std::vector<intrusive_ptr<Expression>> sortKeyExprs;
+    for (auto&& sortElem : *sortPattern) {
+        uassert(5156008,
+                str::stream() << opName << " 'sortBy' direction for '"
+                              << sortElem.fieldNameStringData() << "' must be 1 or -1",
+                sortElem.isNumber() &&
+                    (sortElem.numberDouble() == 1 || sortElem.numberDouble() == -1));
+        sortKeyExprs.push_back(
+            ExpressionFieldPath::parse(expCtx, std::string("$") + sortElem.fieldName(), vps));
+    }
+
+    auto output = Expression::parseOperand(expCtx, outputElem, vps);
+    std::vector<intrusive_ptr<Expression>> argumentExprs{
+        ExpressionArray::create(expCtx, std::move(sortKeyExprs)), output};
+
+    auto initializer = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    auto argument = ExpressionArray::create(expCtx, std::move(argumentExprs));
+    auto factory = [expCtx, n = *n, sortPattern = *sortPattern, output]() {
+        return AccumulatorTopBottomN::create(expCtx, sense, n, sortPattern, output);
+    };
+    return {initializer, argument, factory};
+}
+}  // namespace
+
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    topN,
+    parseTopBottomN<AccumulatorTopBottomN::Sense::kTop>,
+    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo46);
+REGISTER_ACCUMULATOR_WITH_MIN_VERSION(
+    bottomN,
+    parseTopBottomN<AccumulatorTopBottomN::Sense::kBottom>,
+    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo46);
+
+AccumulatorTopBottomN::AccumulatorTopBottomN(ExpressionContext* const expCtx,
+                                             Sense sense,
+                                             long long n,
+                                             BSONObj sortPattern,
+                                             intrusive_ptr<Expression> output)
+    : AccumulatorState(expCtx),
+      _sense(sense),
+      _n(n),
+      _sortPattern(std::move(sortPattern)),
+      _output(std::move(output)) {
+    for (auto&& sortElem : _sortPattern) {
+        _sortDirections.push_back(sortElem.numberInt());
+    }
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorTopBottomN::create(ExpressionContext* const expCtx,
+                                                              Sense sense,
+                                                              long long n,
+                                                              BSONObj sortPattern,
+                                                              intrusive_ptr<Expression> output) {
+    return new AccumulatorTopBottomN(expCtx, sense, n, std::move(sortPattern), std::move(output));
+}
+
+const char* AccumulatorTopBottomN::getOpName() const {
+    return _sense == Sense::kTop ? "$topN" : "$bottomN";
+}
+
+bool AccumulatorTopBottomN::isPreferred(const Entry& lhs, const Entry& rhs) const {
+    const auto& comparator = getExpressionContext()->getValueComparator();
+    const auto& lhsKey = lhs.first.getArray();
+    const auto& rhsKey = rhs.first.getArray();
+    for (size_t i = 0; i < _sortDirections.size(); ++i) {
+        int cmp = comparator.compare(lhsKey[i], rhsKey[i]) * _sortDirections[i];
+        if (cmp != 0) {
+            return _sense == Sense::kTop ? cmp < 0 : cmp > 0;
+        }
+    }
+    return false;
+}
+
+void AccumulatorTopBottomN::insert(Entry entry) {
+    auto heapOrder = [this](const Entry& lhs, const Entry& rhs) { return isPreferred(lhs, rhs); };
+
+    if (static_cast<long long>(_heap.size()) < _n) {
+        _memUsageBytes += entry.first.getApproximateSize() + entry.second.getApproximateSize();
+        _heap.push_back(std::move(entry));
+        std::push_heap(_heap.begin(), _heap.end(), heapOrder);
+        return;
+    }
+
+    // The front of the heap is the least preferred entry kept so far. Only replace it if the new
+    // entry is preferred over it.
+    if (!isPreferred(entry, _heap.front())) {
+        return;
+    }
+    std::pop_heap(_heap.begin(), _heap.end(), heapOrder);
+    auto& evicted = _heap.back();
+    _memUsageBytes -= evicted.first.getApproximateSize() + evicted.second.getApproximateSize();
+    _memUsageBytes += entry.first.getApproximateSize() + entry.second.getApproximateSize();
+    evicted = std::move(entry);
+    std::push_heap(_heap.begin(), _heap.end(), heapOrder);
+}
+
+void AccumulatorTopBottomN::processInternal(const Value& input, bool merging) {
+    // Each input is a [<sort key>, <output>] pair. When merging, the input is an array of them.
+    auto insertPair = [this](const Value& pair) {
+        invariant(pair.isArray() && pair.getArrayLength() == 2);
+        invariant(pair[0].isArray() && pair[0].getArrayLength() == _sortDirections.size());
+        insert({pair[0], pair[1]});
+    };
+
+    if (!merging) {
+        insertPair(input);
+        return;
+    }
+
+    invariant(input.isArray());
+    for (auto&& pair : input.getArray()) {
+        insertPair(pair);
+    }
+}
+
+Value AccumulatorTopBottomN::getValue(bool toBeMerged) {
+    std::vector<Entry> entries(_heap);
+    std::sort(entries.begin(), entries.end(), [this](const Entry& lhs, const Entry& rhs) {
+        return isPreferred(lhs, rhs);
+    });
+
+    // The entries are now most preferred first, which for $bottomN is the reverse of 'sortBy'.
+    if (_sense == Sense::kBottom) {
+        std::reverse(entries.begin(), entries.end());
+    }
+
+    std::vector<Value> result;
+    result.reserve(entries.size());
+    for (auto&& entry : entries) {
+        result.push_back(toBeMerged ? Value(std::vector<Value>{entry.first, entry.second})
+                                    : entry.second);
+    }
+    return Value(std::move(result));
+}
+
+void AccumulatorTopBottomN::reset() {
+    std::vector<Entry>().swap(_heap);
+    _memUsageBytes = sizeof(*this);
+}
+
+Document AccumulatorTopBottomN::serialize(intrusive_ptr<Expression> initializer,
+                                          intrusive_ptr<Expression> argument,
+                                          bool explain) const {
+    return DOC(getOpName() << DOC("n" << _n << "sortBy" << _sortPattern << "output"
+                                      << _output->serialize(explain)));
+}
+
+}  // namespace mongo
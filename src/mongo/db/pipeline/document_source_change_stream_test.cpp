@@ -37,6 +37,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/collection_mock.h"
+#include "mongo/db/change_stream_pre_images.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -2090,6 +2091,71 @@ TEST_F(ChangeStreamStageTest, TransformPreImageForDelete) {
                        ErrorCodes::ChangeStreamHistoryLost);
 }
 
+TEST_F(ChangeStreamStageTest, TransformPreImageForDeleteFromPreImagesCollection) {
+    const auto preImageObj = BSON("_id" << 1 << "x" << 2);
+    const auto documentKey = BSON("_id" << 1);
+
+    // The delete's oplog entry has no 'preImageOpTime', since its pre-image was stored in the
+    // pre-images collection under the delete's timestamp.
+    auto deleteEntry = makeOplogEntry(OpTypeEnum::kDelete,
+                                      nss,
+                                      documentKey,    // o
+                                      testUuid(),     // uuid
+                                      boost::none,    // fromMigrate
+                                      boost::none,    // o2
+                                      kDefaultOpTime  // opTime
+    );
+    auto makePreImage = [&](Timestamp ts, const UUID& nsUUID) {
+        return Document{{"_id", change_stream_pre_images::idForTimestamp(ts)},
+                        {change_stream_pre_images::kNsUUIDFieldName, nsUUID},
+                        {change_stream_pre_images::kTsFieldName, ts},
+                        {change_stream_pre_images::kExpireAtFieldName, Date_t()},
+                        {change_stream_pre_images::kPreImageFieldName, preImageObj}};
+    };
+    std::vector<Document> documentsForLookup = {
+        makePreImage(Timestamp(kDefaultTs.getSecs() - 1, 1), testUuid()),
+        makePreImage(kDefaultTs, testUuid())};
+
+    auto spec = BSON("$changeStream" << BSON("fullDocumentBeforeChange"
+                                             << "whenAvailable"));
+    Document expectedDeleteNoPreImage{
+        {DSChangeStream::kIdField, makeResumeToken(kDefaultTs, testUuid(), documentKey)},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kDeleteOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, documentKey},
+    };
+    Document expectedDeleteWithPreImage{
+        {DSChangeStream::kIdField, makeResumeToken(kDefaultTs, testUuid(), documentKey)},
+        {DSChangeStream::kOperationTypeField, DSChangeStream::kDeleteOpType},
+        {DSChangeStream::kClusterTimeField, kDefaultTs},
+        {DSChangeStream::kFullDocumentBeforeChangeField, preImageObj},
+        {DSChangeStream::kNamespaceField, D{{"db", nss.db()}, {"coll", nss.coll()}}},
+        {DSChangeStream::kDocumentKeyField, documentKey},
+    };
+    checkTransformation(
+        deleteEntry, expectedDeleteWithPreImage, {}, spec, boost::none, {}, documentsForLookup);
+
+    spec = BSON("$changeStream" << BSON("fullDocumentBeforeChange"
+                                        << "required"));
+    checkTransformation(
+        deleteEntry, expectedDeleteWithPreImage, {}, spec, boost::none, {}, documentsForLookup);
+
+    // A pre-image stored under the event's timestamp for another collection is not the event's.
+    documentsForLookup = {makePreImage(kDefaultTs, UUID::gen())};
+    spec = BSON("$changeStream" << BSON("fullDocumentBeforeChange"
+                                        << "whenAvailable"));
+    checkTransformation(
+        deleteEntry, expectedDeleteNoPreImage, {}, spec, boost::none, {}, documentsForLookup);
+
+    spec = BSON("$changeStream" << BSON("fullDocumentBeforeChange"
+                                        << "required"));
+    ASSERT_THROWS_CODE(checkTransformation(
+                           deleteEntry, boost::none, {}, spec, boost::none, {}, documentsForLookup),
+                       AssertionException,
+                       51770);
+}
+
 TEST_F(ChangeStreamStageTest, TransformPreImageForUpdate) {
     // Set the pre-image opTime to 1 second prior to the default event optime.
     repl::OpTime preImageOpTime{Timestamp(kDefaultTs.getSecs() - 1, 1), 1};
@@ -144,16 +144,22 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     }
 
     vector<vector<Value>> results(_facets.size());
+    // Facets which have already reached EOF are not asked for more results on later rounds.
+    vector<bool> pipelineEOF(_facets.size(), false);
     bool allPipelinesEOF = false;
     while (!allPipelinesEOF) {
         allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
         for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+            if (pipelineEOF[facetId]) {
+                continue;
+            }
+            const auto& lastStage = _facets[facetId].pipeline->getSources().back();
+            auto next = lastStage->getNext();
+            for (; next.isAdvanced(); next = lastStage->getNext()) {
                 results[facetId].emplace_back(next.releaseDocument());
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
+            pipelineEOF[facetId] = next.isEOF();
+            allPipelinesEOF = allPipelinesEOF && pipelineEOF[facetId];
         }
     }
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
@@ -57,6 +59,21 @@ void assertIsValidCollectionState(const boost::intrusive_ptr<ExpressionContext>&
         }
     }
 }
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number.
+ *
+ * Each user of the Sorter must implement this function to ensure that all temporary files that the
+ * Sorter instances produce are uniquely identified using a unique file name extension with separate
+ * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
+ * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookupFileCounter;
+    return "extsort-doc-graphlookup." +
+        std::to_string(documentSourceGraphLookupFileCounter.fetchAndAdd(1));
+}
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -112,11 +129,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -124,7 +139,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(_visited.empty() && _spilledVisited.empty());
 
     return output.freeze();
 }
@@ -135,7 +150,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -151,7 +166,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -165,13 +180,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -182,6 +195,66 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _spilledVisitedIds.clear();
+    _spilledVisited.clear();
+    _numSpilledVisited = 0;
+    _readingSpilledVisited = false;
+    if (_usedDisk) {
+        boost::filesystem::remove(_fileName);
+    }
+}
+
+void DocumentSourceGraphLookUp::spillVisited() {
+    invariant(_allowDiskUse);
+    _usedDisk = true;
+
+    // The spilled runs are read back one after another rather than merged, so the documents need
+    // not be written in '_id' order.
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
+    for (auto&& [id, doc] : _visited) {
+        writer.addAlreadySorted(id, doc);
+        _spilledVisitedIdsUsageBytes += id.getApproximateSize();
+        _spilledVisitedIds.insert(id);
+    }
+    _numSpilledVisited += _visited.size();
+    _visited.clear();
+    _visitedUsageBytes = _spilledVisitedIdsUsageBytes;
+
+    _spilledVisited.emplace_back(writer.done());
+    _nextSortedFileWriterOffset = writer.getFileEndOffset();
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    invariant(hasVisited());
+
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    auto& run = _spilledVisited.front();
+    if (!_readingSpilledVisited) {
+        run->openSource();
+        _readingSpilledVisited = true;
+    }
+    auto result = run->next().second;
+    --_numSpilledVisited;
+
+    if (!run->more()) {
+        run->closeSource();
+        _readingSpilledVisited = false;
+        _spilledVisited.pop_front();
+    }
+    if (_numSpilledVisited == 0) {
+        // Every spilled document has been returned, so the next search can start a new file.
+        invariant(_spilledVisited.empty());
+        boost::filesystem::remove(_fileName);
+        _nextSortedFileWriterOffset = 0;
+    }
+    return result;
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -241,12 +314,17 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+
+    // The '_id' values of spilled documents are only needed to de-duplicate during the search.
+    _spilledVisitedIds.clear();
+    _spilledVisitedIdsUsageBytes = 0;
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -393,7 +471,10 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if (_allowDiskUse && !_visited.empty() &&
+        (_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes) {
+        spillVisited();
+    }
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
@@ -467,6 +548,9 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
+      _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
       _cache(pExpCtx->getValueComparator()),
@@ -481,6 +565,16 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline = resolvedNamespace.pipeline;
     _fromPipeline.reserve(_fromPipeline.size() + 1);
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
+
+    if (_allowDiskUse) {
+        _fileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+}
+
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (_usedDisk) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
+    }
 }
 
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
@@ -616,3 +710,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
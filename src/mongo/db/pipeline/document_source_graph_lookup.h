@@ -29,11 +29,15 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -95,7 +99,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -119,6 +123,10 @@ public:
 
     void detachFromOperationContext() final;
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     void reattachToOperationContext(OperationContext* opCtx) final;
 
     static boost::intrusive_ptr<DocumentSourceGraphLookUp> create(
@@ -136,6 +144,8 @@ public:
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
 
+    ~DocumentSourceGraphLookUp();
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -201,10 +211,31 @@ private:
 
     /**
      * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'. If disk use
+     * is allowed, the documents in '_visited' are first spilled to disk to make room.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to '_fileName' and empties it, keeping their '_id' values
+     * in '_spilledVisitedIds' so that the search does not visit them again.
+     */
+    void spillVisited();
+
+    /**
+     * Returns true if there are documents visited by the last search which have not yet been
+     * returned by popVisited().
+     */
+    bool hasVisited() const {
+        return !_visited.empty() || _numSpilledVisited > 0;
+    }
+
+    /**
+     * Removes and returns one of the documents visited by the last search, reading back those
+     * spilled to disk once '_visited' is empty. Must only be called if hasVisited() is true.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,12 +261,26 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
 
+    // Used to spill visited documents to disk when '_visited' grows beyond '_maxMemoryUsageBytes'.
+    // Each spill appends a run to '_fileName', which is removed once all of the spilled documents
+    // have been returned. '_spilledVisitedIds' is compared using the simple collation, as
+    // '_visited' is, and its size is counted in '_visitedUsageBytes'.
+    const bool _allowDiskUse;
+    bool _usedDisk = false;
+    std::string _fileName;
+    std::streampos _nextSortedFileWriterOffset = 0;
+    ValueUnorderedSet _spilledVisitedIds;
+    size_t _spilledVisitedIdsUsageBytes = 0;
+    std::deque<std::unique_ptr<Sorter<Value, Document>::Iterator>> _spilledVisited;
+    size_t _numSpilledVisited = 0;
+    bool _readingSpilledVisited = false;
+
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
@@ -38,8 +38,11 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -613,5 +616,67 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsToDiskIfAllowed) {
+    const auto originalMaxMemoryBytes = internalDocumentSourceGraphLookupMaxMemoryBytes.load();
+    internalDocumentSourceGraphLookupMaxMemoryBytes.store(1000);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceGraphLookupMaxMemoryBytes.store(originalMaxMemoryBytes); });
+
+    const int numNodes = 20;
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    for (int i = 0; i < numNodes; ++i) {
+        fromContents.push_back(Document{{"_id", i}, {"to", i}, {"from", i + 1}});
+    }
+
+    NamespaceString fromNs("test", "graph_lookup");
+    auto makeGraphLookupStage = [&](const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+        expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+            {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+        expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(fromContents);
+        return DocumentSourceGraphLookUp::create(expCtx,
+                                                 fromNs,
+                                                 "results",
+                                                 "from",
+                                                 "to",
+                                                 ExpressionFieldPath::create(expCtx.get(), "_id"),
+                                                 boost::none,
+                                                 boost::none,
+                                                 boost::none,
+                                                 boost::none);
+    };
+
+    // Without disk use, the search cannot hold all of the visited documents.
+    {
+        auto expCtx = getExpCtx();
+        auto inputMock = DocumentSourceMock::createForTest(Document{{"_id", 0}}, expCtx);
+        auto graphLookupStage = makeGraphLookupStage(expCtx);
+        graphLookupStage->setSource(inputMock.get());
+        ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+    }
+
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    auto expCtx = getExpCtx();
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    auto inputMock = DocumentSourceMock::createForTest(Document{{"_id", 0}}, expCtx);
+    auto graphLookupStage = makeGraphLookupStage(expCtx);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+
+    auto results = next.releaseDocument()["results"];
+    ASSERT_EQ(results.getType(), BSONType::Array);
+    ASSERT_EQ(results.getArrayLength(), size_t(numNodes));
+    for (int i = 0; i < numNodes; ++i) {
+        ASSERT_TRUE(arrayContains(
+            expCtx, results.getArray(), Value(Document{{"_id", i}, {"to", i}, {"from", i + 1}})));
+    }
+
+    ASSERT_TRUE(graphLookupStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
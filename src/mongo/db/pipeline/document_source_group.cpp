@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -133,11 +134,24 @@ const char* DocumentSourceGroup::getSourceName() const {
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
     if (!_initialized) {
-        const auto initializationResult = initialize();
-        if (initializationResult.isPaused()) {
-            return initializationResult;
+        if (!_streaming && internalDocumentSourceGroupStreamSortedInput.load()) {
+            auto sortStage = dynamic_cast<DocumentSourceSort*>(pSource);
+            _streaming = sortStage && groupKeysLeadSortPattern(sortStage->getSortKeyPattern());
+        }
+
+        if (_streaming) {
+            auto streamedResult = getNextStreaming();
+            if (!streamedResult.isEOF()) {
+                return streamedResult;
+            }
+            invariant(_initialized);
+        } else {
+            const auto initializationResult = initialize();
+            if (initializationResult.isPaused()) {
+                return initializationResult;
+            }
+            invariant(initializationResult.isEOF());
         }
-        invariant(initializationResult.isEOF());
     }
 
     for (auto&& accum : _currentAccumulators) {
@@ -196,6 +210,70 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
     return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    for (auto input = pSource->getNext();; input = pSource->getNext()) {
+        if (input.isPaused()) {
+            return input;
+        }
+
+        if (input.isEOF()) {
+            readyGroups();
+            _initialized = true;
+            if (!_hasStreamedGroup) {
+                return input;
+            }
+            _hasStreamedGroup = false;
+            return makeDocument(_streamedId, _streamedAccumulators, pExpCtx->needsMerge);
+        }
+
+        auto rootDocument = input.releaseDocument();
+        Value id = computeId(rootDocument);
+        if (!isStreamableId(id)) {
+            addToGroups(rootDocument, id);
+            continue;
+        }
+
+        // The first document with a new key completes the group before it.
+        boost::optional<Document> completedGroup;
+        if (_hasStreamedGroup && !pExpCtx->getValueComparator().evaluate(_streamedId == id)) {
+            completedGroup = makeDocument(_streamedId, _streamedAccumulators, pExpCtx->needsMerge);
+            _hasStreamedGroup = false;
+        }
+
+        if (!_hasStreamedGroup) {
+            if (_streamedAccumulators.empty()) {
+                _streamedAccumulators.reserve(numAccumulators);
+                for (auto&& accumulatedField : _accumulatedFields) {
+                    _streamedAccumulators.push_back(accumulatedField.makeAccumulator());
+                }
+            }
+
+            Value expandedId = expandId(id);
+            Document idDoc =
+                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+            for (size_t i = 0; i < numAccumulators; ++i) {
+                _streamedAccumulators[i]->reset();
+                _streamedAccumulators[i]->startNewGroup(
+                    _accumulatedFields[i].expr.initializer->evaluate(idDoc, &pExpCtx->variables));
+            }
+            _streamedId = std::move(id);
+            _hasStreamedGroup = true;
+        }
+
+        for (size_t i = 0; i < numAccumulators; ++i) {
+            _streamedAccumulators[i]->process(
+                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+                _doingMerge);
+        }
+
+        if (completedGroup) {
+            return std::move(*completedGroup);
+        }
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     // Not spilled, and not streaming.
     if (_groups->empty())
@@ -213,6 +291,8 @@ void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _hasStreamedGroup = false;
+    _streamedAccumulators.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -477,122 +557,167 @@ private:
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
-
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
-        }
-
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
-        Value id = computeId(rootDocument);
+        addToGroups(rootDocument, computeId(rootDocument));
+    }
+
+    switch (input.getStatus()) {
+        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
+            MONGO_UNREACHABLE;  // We consumed all advances above.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
+            return input;  // Propagate pause.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
+            readyGroups();
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
+            // This must happen last so that, unless control gets here, we will re-enter
+            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
+            _initialized = true;
+            return input;
+        }
+    }
+    MONGO_UNREACHABLE;
+}
 
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
+void DocumentSourceGroup::addToGroups(const Document& rootDocument, const Value& id) {
+    const size_t numAccumulators = _accumulatedFields.size();
 
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
+    if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                "Exceeded memory limit for $group, but didn't allow external sort."
+                " Pass allowDiskUse:true to opt in.",
+                _allowDiskUse);
+        _sortedFiles.push_back(spill());
+        _memoryUsageBytes = 0;
+    }
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in '_groups' multiple times.
+    const size_t oldSize = _groups->size();
+    vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
+    const bool inserted = _groups->size() != oldSize;
+
+    if (inserted) {
+        _memoryUsageBytes += id.getApproximateSize();
+
+        // Initialize and add the accumulators
+        Value expandedId = expandId(id);
+        Document idDoc =
+            expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            auto accum = accumulatedField.makeAccumulator();
+            Value initializerValue =
+                accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+            accum->startNewGroup(initializerValue);
+            group.push_back(accum);
         }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(
+            _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
+            _doingMerge);
 
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        _memoryUsageBytes += group[i]->memUsageForSorter();
+    }
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inMongos &&        // can't spill to disk in mongos
-                !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                 // is a dup
+            !pExpCtx->inMongos &&        // can't spill to disk in mongos
+            !_allowDiskUse &&            // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {  // don't open too many FDs
 
-                _sortedFiles.push_back(spill());
-            }
+            _sortedFiles.push_back(spill());
         }
     }
+}
 
-    switch (input.getStatus()) {
-        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
-            MONGO_UNREACHABLE;  // We consumed all advances above.
+void DocumentSourceGroup::readyGroups() {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // Do any final steps necessary to prepare to output results.
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
         }
-        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
-            return input;  // Propagate pause.
+
+        // We won't be using groups again so free its memory.
+        _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+
+        _sorterIterator.reset(
+            Sorter<Value, Value>::Iterator::merge(_sortedFiles,
+                                                  _fileName,
+                                                  SortOptions(),
+                                                  SorterComparator(pExpCtx->getValueComparator())));
+        _ownsFileDeletion = false;
+
+        // prepare current to accumulate data
+        _currentAccumulators.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _currentAccumulators.push_back(accumulatedField.makeAccumulator());
         }
-        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
 
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    } else {
+        // start the group iterator
+        groupsIterator = _groups->begin();
+    }
+}
 
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles,
-                    _fileName,
-                    SortOptions(),
-                    SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
+bool DocumentSourceGroup::isStreamableId(const Value& id) const {
+    // A single group key which is missing has already been replaced with null.
+    if (_idExpressions.size() == 1) {
+        return id.getType() != BSONType::Array;
+    }
 
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
+    for (auto&& component : id.getArray()) {
+        if (component.missing() || component.getType() == BSONType::Array) {
+            return false;
+        }
+    }
+    return true;
+}
 
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
-            }
+bool DocumentSourceGroup::groupKeysLeadSortPattern(const SortPattern& sortPattern) const {
+    if (_idExpressions.size() > sortPattern.size()) {
+        return false;
+    }
 
-            // This must happen last so that, unless control gets here, we will re-enter
-            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
-            _initialized = true;
-            return input;
+    std::set<std::string> sortPaths;
+    for (size_t i = 0; i < _idExpressions.size(); ++i) {
+        if (!sortPattern[i].fieldPath ||
+            !pathIncludedInGroupKeys(sortPattern[i].fieldPath->fullPath())) {
+            return false;
         }
+        sortPaths.insert(sortPattern[i].fieldPath->fullPath());
     }
-    MONGO_UNREACHABLE;
+
+    // Each group key is a distinct sort path, so none of them can be anything but a field path.
+    return sortPaths.size() == _idExpressions.size();
+}
+
+void DocumentSourceGroup::setInputSortPattern(const SortPattern& sortPattern) {
+    _streaming = internalDocumentSourceGroupStreamSortedInput.load() &&
+        groupKeysLeadSortPattern(sortPattern);
 }
 
 bool DocumentSourceGroup::usedDisk() {
@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -161,6 +162,14 @@ public:
      */
     bool usedDisk() final;
 
+    /**
+     * Tells this stage that its input arrives ordered by 'sortPattern'. When the group keys are the
+     * leading fields of the sort, documents with equal keys arrive together and each group is
+     * returned as soon as the input moves on to the next key. A preceding $sort stage is detected
+     * without this; it is for a $sort pushed down into the query layer.
+     */
+    void setInputSortPattern(const SortPattern& sortPattern);
+
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final;
     bool canRunInParallelBeforeWriteStage(
         const std::set<std::string>& nameOfShardKeyFieldsUponEntryToStage) const final;
@@ -195,6 +204,14 @@ private:
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
+    /**
+     * Returns the next group of sorted input, or EOF once the input is exhausted and initialize()
+     * has finished. Documents whose group key cannot be relied on to be adjacent to the other
+     * documents of its group are added to '_groups' instead, to be returned with getNextStandard()
+     * or getNextSpilled() after everything streamed.
+     */
+    GetNextResult getNextStreaming();
+
     /**
      * Before returning anything, this source must prepare itself. In a streaming $group,
      * initialize() requests the first document from the previous source, and uses it to prepare the
@@ -207,6 +224,29 @@ private:
      */
     GetNextResult initialize();
 
+    /**
+     * Adds 'rootDocument' to the group for 'id' in '_groups', first spilling '_groups' to disk if
+     * they have outgrown the memory limit.
+     */
+    void addToGroups(const Document& rootDocument, const Value& id);
+
+    /**
+     * Prepares to return the groups in '_groups' and on disk, once the input is exhausted.
+     */
+    void readyGroups();
+
+    /**
+     * Returns true if the documents of a group keyed by 'id' are adjacent in input sorted by the
+     * group keys. Arrays sort by their smallest or largest element rather than as a whole, and a
+     * sort does not tell apart a missing field and null, while a compound group key does.
+     */
+    bool isStreamableId(const Value& id) const;
+
+    /**
+     * Returns true if the group keys are the leading fields of 'sortPattern', in any order.
+     */
+    bool groupKeysLeadSortPattern(const SortPattern& sortPattern) const;
+
     /**
      * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
      * does not exhaust the previous stage before returning, and thus does not maintain as large a
@@ -266,6 +306,15 @@ private:
     const bool _allowDiskUse;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // Set when the input is sorted by the group keys, in which case getNextStreaming() returns the
+    // groups whose keys are streamable before the others are returned.
+    bool _streaming = false;
+
+    // The key and accumulators of the group getNextStreaming() is filling, if '_hasStreamedGroup'.
+    bool _hasStreamedGroup = false;
+    Value _streamedId;
+    Accumulators _streamedAccumulators;
 };
 
 }  // namespace mongo
@@ -206,6 +206,109 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
         group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldStreamGroupsOfSortedInputRegardlessOfMemoryLimit) {
+    auto expCtx = getExpCtx();
+    const size_t maxMemoryUsageBytes = 1000;
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    auto&& parser = AccumulationStatement::getParser("$push", boost::none);
+    auto accumulatorArg = BSON(""
+                               << "$largeStr");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement pushStatement{"spaceHog", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, maxMemoryUsageBytes);
+    group->setInputSortPattern(SortPattern(BSON("_id" << 1), expCtx));
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                           Document{{"_id", 0}, {"largeStr", largeStr}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"_id", 1}, {"largeStr", largeStr}},
+                                           Document{{"_id", 2}, {"largeStr", largeStr}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    // The first group is complete once the pause has been passed on.
+    ASSERT_TRUE(group->getNext().isPaused());
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(),
+                       (Document{{"_id", 0}, {"spaceHog", vector<Value>(2, Value(largeStr))}}));
+
+    for (int id = 1; id <= 2; ++id) {
+        result = group->getNext();
+        ASSERT_TRUE(result.isAdvanced());
+        ASSERT_DOCUMENT_EQ(
+            result.releaseDocument(),
+            (Document{{"_id", id}, {"spaceHog", vector<Value>(1, Value(largeStr))}}));
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReturnArrayGroupKeysAfterStreamedGroups) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    auto&& parser = AccumulationStatement::getParser("$sum", boost::none);
+    auto accumulatorArg = BSON("" << 1);
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement countStatement{"count", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {countStatement});
+    group->setInputSortPattern(SortPattern(BSON("a" << 1), expCtx));
+
+    // An array sorts by its smallest element, so equal arrays need not be adjacent.
+    const Value array(vector<Value>{Value(1), Value(2)});
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", array}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", array}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 2}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", array}, {"count", 2}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotStreamWhenGroupKeysDoNotLeadTheSort) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(expCtx, groupByExpression, {});
+    group->setInputSortPattern(SortPattern(BSON("b" << 1 << "a" << 1), expCtx));
+
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", 1}, {"b", 1}}, Document{{"a", 2}, {"b", 2}}, Document{{"a", 1}, {"b", 3}}},
+        expCtx);
+    group->setSource(mock.get());
+
+    // Documents with 'a' of 1 are not adjacent, but still form a single group.
+    size_t numGroups = 0;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        ++numGroups;
+    }
+    ASSERT_EQ(numGroups, 2UL);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
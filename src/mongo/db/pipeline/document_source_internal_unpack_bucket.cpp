@@ -0,0 +1,275 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include <functional>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kTimeFieldName;
+constexpr StringData DocumentSourceInternalUnpackBucket::kMetaFieldName;
+
+namespace {
+
+constexpr StringData kBucketControlMinFieldName = "control.min."_sd;
+constexpr StringData kBucketControlMaxFieldName = "control.max."_sd;
+constexpr StringData kBucketDataFieldName = "data"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+
+}  // namespace
+
+void BucketUnpacker::reset(BSONObj bucket) {
+    _bucket = std::move(bucket);
+    _metaValue = _bucket[kBucketMetaFieldName];
+    _columns.clear();
+    _timeColumn = 0;
+
+    auto data = _bucket[kBucketDataFieldName];
+    uassert(5160004,
+            str::stream() << "time-series bucket must have a 'data' object: " << _bucket["_id"],
+            data.type() == BSONType::Object);
+
+    bool foundTimeColumn = false;
+    for (auto&& column : data.embeddedObject()) {
+        uassert(5160005,
+                str::stream() << "time-series bucket column must be an object: "
+                              << column.fieldNameStringData(),
+                column.type() == BSONType::Object);
+        if (column.fieldNameStringData() == _timeField) {
+            _timeColumn = _columns.size();
+            foundTimeColumn = true;
+        }
+        BSONObjIterator it(column.embeddedObject());
+        auto next = it.more() ? it.next() : BSONElement();
+        _columns.push_back({column.fieldNameStringData(), std::move(it), next});
+    }
+    if (!foundTimeColumn) {
+        // A bucket without a time column holds no measurements.
+        _columns.clear();
+    }
+}
+
+Document BucketUnpacker::getNext() {
+    invariant(hasNext());
+
+    const auto position = _columns[_timeColumn].next.fieldNameStringData();
+    uassert(5160006,
+            str::stream() << "time-series measurement field '" << _timeField
+                          << "' must be a Date: " << _columns[_timeColumn].next,
+            _columns[_timeColumn].next.type() == BSONType::Date);
+
+    MutableDocument measurement;
+    for (auto&& column : _columns) {
+        if (column.next.eoo() || column.next.fieldNameStringData() != position) {
+            continue;
+        }
+        measurement.addField(column.fieldName, Value(column.next));
+        column.next = column.it.more() ? column.it.next() : BSONElement();
+    }
+    if (_metaField && !_metaValue.eoo()) {
+        measurement.addField(*_metaField, Value(_metaValue));
+    }
+    return measurement.freeze();
+}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << "$_internalUnpackBucket must take a nested object but found: "
+                          << elem,
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> timeField;
+    boost::optional<std::string> metaField;
+    for (auto&& spec : elem.embeddedObject()) {
+        const auto fieldName = spec.fieldNameStringData();
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << "unrecognized option to $_internalUnpackBucket: " << fieldName,
+                fieldName == kTimeFieldName || fieldName == kMetaFieldName);
+        uassert(ErrorCodes::TypeMismatch,
+                str::stream() << "$_internalUnpackBucket '" << fieldName
+                              << "' must be a string but found: " << spec,
+                spec.type() == BSONType::String);
+
+        // The fields are stored as top-level fields of the measurements.
+        const auto field = spec.str();
+        FieldPath::uassertValidFieldName(field);
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << "$_internalUnpackBucket '" << fieldName
+                              << "' must not be a dotted path: " << field,
+                field.find('.') == std::string::npos);
+        (fieldName == kTimeFieldName ? timeField : metaField) = field;
+    }
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "$_internalUnpackBucket requires a '" << kTimeFieldName << "'",
+            timeField);
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "$_internalUnpackBucket '" << kTimeFieldName << "' and '"
+                          << kMetaFieldName << "' must differ",
+            !metaField || *metaField != *timeField);
+
+    return new DocumentSourceInternalUnpackBucket(
+        expCtx, std::move(*timeField), std::move(metaField));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField)
+    : DocumentSource(kStageName, expCtx),
+      _timeField(std::move(timeField)),
+      _metaField(std::move(metaField)),
+      _bucketUnpacker(_timeField, _metaField) {}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (!_bucketUnpacker.hasNext()) {
+        auto nextResult = pSource->getNext();
+        if (!nextResult.isAdvanced()) {
+            return nextResult;
+        }
+        _bucketUnpacker.reset(nextResult.releaseDocument().toBson());
+    }
+    return _bucketUnpacker.getNext();
+}
+
+DocumentSource::GetModPathsReturn DocumentSourceInternalUnpackBucket::getModifiedPaths() const {
+    if (!_metaField) {
+        return {GetModPathsReturn::Type::kAllPaths, std::set<std::string>{}, {}};
+    }
+
+    // Every measurement of a bucket takes the meta field from the bucket's 'meta' field, so a
+    // predicate on the meta field can be applied to the bucket instead.
+    return {GetModPathsReturn::Type::kAllExcept,
+            std::set<std::string>{},
+            {{*_metaField, kBucketMetaFieldName.toString()}}};
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec.addField(kTimeFieldName, Value(_timeField));
+    if (_metaField) {
+        spec.addField(kMetaFieldName, Value(*_metaField));
+    }
+    return Value(Document{{getSourceName(), spec.freezeToValue()}});
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createBucketLevelTimePredicate(
+    const BSONObj& filter) const {
+    const auto minField = kBucketControlMinFieldName + _timeField;
+    const auto maxField = kBucketControlMaxFieldName + _timeField;
+
+    BSONArrayBuilder predicates;
+    auto addTimePredicates = [&](const BSONElement& timeFilter) {
+        if (timeFilter.type() == BSONType::Date) {
+            predicates.append(BSON(minField << BSON("$lte" << timeFilter)));
+            predicates.append(BSON(maxField << BSON("$gte" << timeFilter)));
+            return;
+        }
+        if (timeFilter.type() != BSONType::Object) {
+            return;
+        }
+
+        // Every time in a bucket lies between its minimum and maximum, and is a Date. So the
+        // bucket holds a time greater than a Date only if its maximum is, and so on.
+        for (auto&& op : timeFilter.embeddedObject()) {
+            if (op.type() != BSONType::Date) {
+                continue;
+            }
+            const auto opName = op.fieldNameStringData();
+            if (opName == "$gt"_sd || opName == "$gte"_sd) {
+                predicates.append(BSON(maxField << BSON(opName << op)));
+            } else if (opName == "$lt"_sd || opName == "$lte"_sd) {
+                predicates.append(BSON(minField << BSON(opName << op)));
+            } else if (opName == "$eq"_sd) {
+                predicates.append(BSON(minField << BSON("$lte" << op)));
+                predicates.append(BSON(maxField << BSON("$gte" << op)));
+            }
+        }
+    };
+
+    std::function<void(const BSONObj&)> addConjunctPredicates = [&](const BSONObj& conjuncts) {
+        for (auto&& elem : conjuncts) {
+            if (elem.fieldNameStringData() == _timeField) {
+                addTimePredicates(elem);
+            } else if (elem.fieldNameStringData() == "$and"_sd &&
+                       elem.type() == BSONType::Array) {
+                for (auto&& child : elem.embeddedObject()) {
+                    if (child.type() == BSONType::Object) {
+                        addConjunctPredicates(child.embeddedObject());
+                    }
+                }
+            }
+        }
+    };
+    addConjunctPredicates(filter);
+
+    auto predicateArray = predicates.arr();
+    return predicateArray.isEmpty() ? BSONObj() : BSON("$and" << predicateArray);
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextMatch = std::next(itr) == container->end()
+        ? nullptr
+        : dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (_pushedDownTimePredicate || !nextMatch || nextMatch->isTextQuery()) {
+        return std::next(itr);
+    }
+
+    auto bucketPredicate = createBucketLevelTimePredicate(nextMatch->getQuery());
+    if (bucketPredicate.isEmpty()) {
+        return std::next(itr);
+    }
+
+    // The original $match stays after this stage to filter the measurements of the buckets which
+    // may hold a match.
+    _pushedDownTimePredicate = true;
+    container->insert(itr, DocumentSourceMatch::create(std::move(bucketPredicate), pExpCtx));
+
+    // The inserted $match may combine with a $match already before it.
+    auto insertedMatch = std::prev(itr);
+    return insertedMatch == container->begin() ? insertedMatch : std::prev(insertedMatch);
+}
+
+}  // namespace mongo
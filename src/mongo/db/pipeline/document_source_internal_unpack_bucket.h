@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * Unpacks the measurements held by one bucket document of a time-series collection. A bucket holds
+ * the measurements of one series over a window of time, storing each field of the measurements as a
+ * column keyed by the position of the measurement within the bucket:
+ *
+ *   {_id: <bucket id>,
+ *    control: {version: 1, min: {<field>: <min value>, ...}, max: {<field>: <max value>, ...}},
+ *    meta: <value shared by all measurements in the bucket>,
+ *    data: {<field>: {"0": <value>, "1": <value>, ...}, ...}}
+ *
+ * Every measurement has a Date in the time field column, and the other columns omit the positions
+ * of measurements without the field. Columns list positions in the same order as the time column.
+ */
+class BucketUnpacker {
+public:
+    BucketUnpacker(std::string timeField, boost::optional<std::string> metaField)
+        : _timeField(std::move(timeField)), _metaField(std::move(metaField)) {}
+
+    /**
+     * Starts unpacking 'bucket', which must be owned.
+     */
+    void reset(BSONObj bucket);
+
+    bool hasNext() const {
+        return _timeColumn < _columns.size() && !_columns[_timeColumn].next.eoo();
+    }
+
+    /**
+     * Returns the next measurement of the bucket. Must only be called if hasNext() is true.
+     */
+    Document getNext();
+
+private:
+    struct Column {
+        StringData fieldName;
+        BSONObjIterator it;
+        BSONElement next;
+    };
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    BSONObj _bucket;
+    BSONElement _metaValue;
+
+    // The columns of the bucket in the order of its 'data' object, of which '_timeColumn' is the
+    // column of the time field.
+    std::vector<Column> _columns;
+    size_t _timeColumn = 0;
+};
+
+/**
+ * Unpacks the bucket documents of a time-series collection into the measurements they hold. See
+ * BucketUnpacker for the format of a bucket.
+ *
+ * Predicates of a following $match on the meta field are moved before this stage as predicates on
+ * the 'meta' field of the buckets. Predicates comparing the time field to a Date are answered
+ * first over the range of times in 'control' by a $match inserted before this stage, so that
+ * buckets holding no matching measurements are not unpacked.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       std::string timeField,
+                                       boost::optional<std::string> metaField);
+
+    const char* getSourceName() const override {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kNone,
+                                     HostTypeRequirement::kNone,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kAllowed,
+                                     LookupRequirement::kAllowed,
+                                     UnionRequirement::kAllowed);
+
+        constraints.canSwapWithMatch = true;
+        return constraints;
+    }
+
+    GetModPathsReturn getModifiedPaths() const final;
+
+    Value serialize(
+        boost::optional<ExplainOptions::Verbosity> explain = boost::none) const override;
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() override {
+        return boost::none;
+    }
+
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) override;
+
+    /**
+     * Returns a filter over bucket documents which admits every bucket holding a measurement that
+     * may match 'filter', derived from the predicates of 'filter' comparing the time field to a
+     * Date. Returns an empty object if 'filter' has no such predicates.
+     */
+    BSONObj createBucketLevelTimePredicate(const BSONObj& filter) const;
+
+private:
+    GetNextResult doGetNext() override;
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    BucketUnpacker _bucketUnpacker;
+
+    // Set once a $match over the time range of the buckets has been inserted before this stage, so
+    // that optimizing the pipeline again does not insert another.
+    bool _pushedDownTimePredicate = false;
+};
+
+}  // namespace mongo
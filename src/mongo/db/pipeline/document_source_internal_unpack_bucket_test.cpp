@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using DocumentSourceInternalUnpackBucketTest = AggregationContextFixture;
+
+const Date_t kTime0 = Date_t::fromMillisSinceEpoch(1000);
+const Date_t kTime1 = Date_t::fromMillisSinceEpoch(2000);
+const Date_t kTime2 = Date_t::fromMillisSinceEpoch(3000);
+
+BSONObj makeBucket(BSONObj meta, Date_t minTime, Date_t maxTime, BSONObj data) {
+    return BSON("_id" << OID::gen() << "control"
+                      << BSON("version" << 1 << "min" << BSON("t" << minTime) << "max"
+                                        << BSON("t" << maxTime))
+                      << "meta" << meta << "data" << data);
+}
+
+boost::intrusive_ptr<DocumentSource> makeUnpackStage(
+    const BSONObj& spec, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    return DocumentSourceInternalUnpackBucket::createFromBson(
+        BSON("$_internalUnpackBucket" << spec).firstElement(), expCtx);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, UnpacksMeasurementsOfEachBucket) {
+    auto unpack = makeUnpackStage(BSON("timeField"
+                                       << "t"
+                                       << "metaField"
+                                       << "m"),
+                                  getExpCtx());
+    auto bucket0 = makeBucket(BSON("a" << 1),
+                              kTime0,
+                              kTime1,
+                              BSON("_id" << BSON("0" << 10 << "1" << 11) << "t"
+                                         << BSON("0" << kTime0 << "1" << kTime1) << "x"
+                                         << BSON("1" << 5)));
+    auto bucket1 = makeBucket(BSON("a" << 2),
+                              kTime2,
+                              kTime2,
+                              BSON("_id" << BSON("0" << 12) << "t" << BSON("0" << kTime2)));
+    auto mock =
+        DocumentSourceMock::createForTest({Document(bucket0), Document(bucket1)}, getExpCtx());
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(BSON("_id" << 10 << "t" << kTime0 << "m" << BSON("a" << 1))));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        Document(BSON("_id" << 11 << "t" << kTime1 << "x" << 5 << "m" << BSON("a" << 1))));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(BSON("_id" << 12 << "t" << kTime2 << "m" << BSON("a" << 2))));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, RejectsInvalidSpecs) {
+    ASSERT_THROWS_CODE(makeUnpackStage(BSON("metaField"
+                                            << "m"),
+                                       getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(makeUnpackStage(BSON("timeField"
+                                            << "a.t"),
+                                       getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(makeUnpackStage(BSON("timeField" << 1), getExpCtx()),
+                       AssertionException,
+                       ErrorCodes::TypeMismatch);
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, PushesMetaAndTimePredicatesToBuckets) {
+    auto unpack = makeUnpackStage(BSON("timeField"
+                                       << "t"
+                                       << "metaField"
+                                       << "m"),
+                                  getExpCtx());
+    auto match = DocumentSourceMatch::create(
+        BSON("m.a" << 1 << "t" << BSON("$gte" << kTime2) << "x" << 5), getExpCtx());
+    auto pipeline = Pipeline::create({unpack, match}, getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto& sources = pipeline->getSources();
+    ASSERT_EQ(3u, sources.size());
+    auto bucketMatch = dynamic_cast<DocumentSourceMatch*>(sources.front().get());
+    ASSERT(bucketMatch);
+    ASSERT_EQ(std::next(sources.begin())->get(), unpack.get());
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(sources.back().get()));
+
+    // Buckets are filtered by their meta value and by whether their time range reaches the bound.
+    auto data = BSON("t" << BSON("0" << kTime0));
+    ASSERT_TRUE(bucketMatch->getMatchExpression()->matchesBSON(
+        makeBucket(BSON("a" << 1), kTime0, kTime2, data)));
+    ASSERT_FALSE(bucketMatch->getMatchExpression()->matchesBSON(
+        makeBucket(BSON("a" << 2), kTime0, kTime2, data)));
+    ASSERT_FALSE(bucketMatch->getMatchExpression()->matchesBSON(
+        makeBucket(BSON("a" << 1), kTime0, kTime1, data)));
+
+    // Optimizing the pipeline again must not push the time predicate down a second time.
+    pipeline->optimizePipeline();
+    ASSERT_EQ(3u, pipeline->getSources().size());
+}
+
+TEST_F(DocumentSourceInternalUnpackBucketTest, DoesNotPushDownPredicatesOnMeasurementFields) {
+    auto unpack = makeUnpackStage(BSON("timeField"
+                                       << "t"
+                                       << "metaField"
+                                       << "m"),
+                                  getExpCtx());
+    auto match = DocumentSourceMatch::create(BSON("x" << 5 << "t" << 1), getExpCtx());
+    auto pipeline = Pipeline::create({unpack, match}, getExpCtx());
+    pipeline->optimizePipeline();
+
+    ASSERT_EQ(2u, pipeline->getSources().size());
+    ASSERT_EQ(pipeline->getSources().front().get(), unpack.get());
+}
+
+}  // namespace
+}  // namespace mongo
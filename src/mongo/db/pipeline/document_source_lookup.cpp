@@ -31,11 +31,13 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/init.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document_path_support.h"
@@ -253,6 +255,109 @@ void lookupPipeValidator(const Pipeline& pipeline) {
                 src->constraints().isAllowedInLookupPipeline());
     });
 }
+
+/**
+ * Invokes 'callback' on each value that an equality predicate on 'path' compares against: the value
+ * at the end of the path and, if that value is an array, each of its elements. As in the query
+ * language, arrays found along the path are traversed one level deep.
+ */
+template <typename Callback>
+void visitJoinKeysAtPath(const Value& value,
+                         const FieldPath& path,
+                         size_t pathIndex,
+                         const Callback& callback) {
+    if (pathIndex == path.getPathLength()) {
+        if (value.missing()) {
+            return;
+        }
+        callback(value);
+        if (value.isArray()) {
+            for (auto&& elem : value.getArray()) {
+                callback(elem);
+            }
+        }
+        return;
+    }
+
+    auto visitField = [&](const Value& container) {
+        if (container.getType() == BSONType::Object) {
+            visitJoinKeysAtPath(container.getDocument()[path.getFieldName(pathIndex)],
+                                path,
+                                pathIndex + 1,
+                                callback);
+        }
+    };
+
+    if (value.isArray()) {
+        for (auto&& elem : value.getArray()) {
+            visitField(elem);
+        }
+    } else {
+        visitField(value);
+    }
+}
+
+/**
+ * Returns the values of 'localFieldPath' in 'input' if the foreign documents they join to can be
+ * found by comparing each value for equality with the keys produced by visitJoinKeysAtPath().
+ * Returns boost::none otherwise: null and missing values also match foreign documents which are
+ * missing the foreign field, and regular expressions are matched by type rather than by value.
+ */
+boost::optional<std::vector<Value>> getEqualityJoinValues(const Document& input,
+                                                          const FieldPath& localFieldPath) {
+    std::vector<Value> localValues;
+    bool hasUnhashableValue = false;
+    document_path_support::visitAllValuesAtPath(
+        input, localFieldPath, [&](const Value& localValue) {
+            switch (localValue.getType()) {
+                case BSONType::jstNULL:
+                case BSONType::Undefined:
+                case BSONType::RegEx:
+                    hasUnhashableValue = true;
+                    break;
+                default:
+                    localValues.push_back(localValue);
+            }
+        });
+
+    if (localValues.empty() || hasUnhashableValue) {
+        return boost::none;
+    }
+    return localValues;
+}
+
+/**
+ * Returns true if 'foreignFieldPath' contains a numeric component. Equality predicates on such
+ * paths may refer to array positions, which visitJoinKeysAtPath() does not follow.
+ */
+bool hasNumericPathComponent(const FieldPath& foreignFieldPath) {
+    for (size_t i = 0; i < foreignFieldPath.getPathLength(); ++i) {
+        if (FieldRef::isNumericPathComponentLenient(foreignFieldPath.getFieldName(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Appends 'result' to the foreign documents joined to a single local document, whose total size
+ * so far is 'totalSize', enforcing 'internalLookupStageIntermediateDocumentMaxSizeBytes'.
+ */
+void appendLookupResult(const NamespaceString& fromNs,
+                        Document result,
+                        std::vector<Value>* results,
+                        long long* totalSize) {
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    long long safeSum = 0;
+    bool hasOverflowed = overflow::add(*totalSize, result.getApproximateSize(), &safeSum);
+    uassert(4568,
+            str::stream() << "Total size of documents in " << fromNs.coll()
+                          << " matching pipeline's $lookup stage exceeds " << maxBytes << " bytes",
+
+            !hasOverflowed && *totalSize <= maxBytes);
+    *totalSize = safeSum;
+    results->emplace_back(std::move(result));
+}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
@@ -260,7 +365,14 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
-    auto nextInput = pSource->getNext();
+    if (!_batchedOutputs.empty()) {
+        auto output = std::move(_batchedOutputs.front());
+        _batchedOutputs.pop_front();
+        return output;
+    }
+
+    auto nextInput = _pendingInput ? std::move(*_pendingInput) : pSource->getNext();
+    _pendingInput.reset();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
@@ -271,36 +383,191 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    std::vector<Value> results;
+    long long objsize = 0;
+
+    boost::optional<std::vector<Value>> localValues;
     if (!wasConstructedWithPipelineSyntax()) {
-        auto matchStage =
-            makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
-        // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
-        _resolvedPipeline.back() = matchStage;
+        if (_hashJoinState == HashJoinState::kUntried) {
+            _hashJoinState =
+                buildHashJoinTable(inputDoc) ? HashJoinState::kBuilt : HashJoinState::kAbandoned;
+        }
+        if (!hasNumericPathComponent(*_foreignField)) {
+            localValues = getEqualityJoinValues(inputDoc, *_localField);
+        }
     }
 
-    auto pipeline = buildPipeline(inputDoc);
+    if (localValues && _hashJoinState == HashJoinState::kBuilt) {
+        for (auto&& result : probeHashJoinTable(*localValues)) {
+            appendLookupResult(_fromNs, std::move(result), &results, &objsize);
+        }
+    } else if (localValues && internalLookupStageBatchSize.load() > 1) {
+        return lookUpBatch(std::move(inputDoc), std::move(*localValues));
+    } else {
+        if (!wasConstructedWithPipelineSyntax()) {
+            auto matchStage = makeMatchStageFromInput(
+                inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+            // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
+            _resolvedPipeline.back() = matchStage;
+        }
 
-    std::vector<Value> results;
-    long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+        auto pipeline = buildPipeline(inputDoc);
+        while (auto result = pipeline->getNext()) {
+            appendLookupResult(_fromNs, std::move(*result), &results, &objsize);
+        }
+        _usedDisk = _usedDisk || pipeline->usedDisk();
+    }
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+bool DocumentSourceLookUp::buildHashJoinTable(const Document& inputDoc) {
+    invariant(!wasConstructedWithPipelineSyntax());
+
+    const auto maxForeignBytes = internalLookupStageHashJoinMaxForeignSizeBytes.load();
+    if (maxForeignBytes <= 0) {
+        return false;
+    }
+
+    if (hasNumericPathComponent(*_foreignField)) {
+        return false;
+    }
+
+    // Read the whole foreign collection, through any view pipeline, using an empty $match in
+    // place of the per-document join predicate.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(inputDoc);
 
+    _hashJoinTable.emplace(
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>());
+    long long foreignBytes = 0;
     while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
+        foreignBytes += result->getApproximateSize();
+        if (foreignBytes > maxForeignBytes) {
+            _usedDisk = _usedDisk || pipeline->usedDisk();
+            _hashJoinTable.reset();
+            _hashJoinDocs.clear();
+            return false;
+        }
 
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+        const auto docIndex = _hashJoinDocs.size();
+        visitJoinKeysAtPath(Value(*result), *_foreignField, 0, [&](const Value& key) {
+            (*_hashJoinTable)[key].push_back(docIndex);
+        });
+        _hashJoinDocs.push_back(std::move(*result));
     }
     _usedDisk = _usedDisk || pipeline->usedDisk();
+    return true;
+}
 
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+std::vector<Document> DocumentSourceLookUp::probeHashJoinTable(
+    const std::vector<Value>& localValues) const {
+    invariant(_hashJoinTable);
+
+    std::vector<size_t> matchingIndexes;
+    for (auto&& localValue : localValues) {
+        if (auto it = _hashJoinTable->find(localValue); it != _hashJoinTable->end()) {
+            matchingIndexes.insert(matchingIndexes.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // A foreign document may match several local values, but is returned only once.
+    std::sort(matchingIndexes.begin(), matchingIndexes.end());
+    matchingIndexes.erase(std::unique(matchingIndexes.begin(), matchingIndexes.end()),
+                          matchingIndexes.end());
+
+    std::vector<Document> matches;
+    matches.reserve(matchingIndexes.size());
+    for (auto docIndex : matchingIndexes) {
+        matches.push_back(_hashJoinDocs[docIndex]);
+    }
+    return matches;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::lookUpBatch(Document inputDoc,
+                                                                std::vector<Value> localValues) {
+    // Maps each local value in the batch to the positions in 'batch' of the documents containing
+    // it, so that the foreign documents can be handed back to every local document they join.
+    std::vector<Document> batch;
+    auto batchIndexesByValue =
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    auto addToBatch = [&](Document doc, const std::vector<Value>& values) {
+        for (auto&& value : values) {
+            auto& batchIndexes = batchIndexesByValue[value];
+            if (batchIndexes.empty() || batchIndexes.back() != batch.size()) {
+                batchIndexes.push_back(batch.size());
+            }
+        }
+        batch.push_back(std::move(doc));
+    };
+
+    // Stop the batch at the first pause, EOF or local document which must be joined by its own
+    // query, holding onto it until the documents already in the batch have been returned.
+    addToBatch(std::move(inputDoc), localValues);
+    const auto maxBatchSize = static_cast<size_t>(internalLookupStageBatchSize.load());
+    while (batch.size() < maxBatchSize) {
+        auto nextInput = pSource->getNext();
+        boost::optional<std::vector<Value>> nextLocalValues;
+        if (nextInput.isAdvanced()) {
+            nextLocalValues = getEqualityJoinValues(nextInput.getDocument(), *_localField);
+        }
+        if (!nextLocalValues) {
+            _pendingInput = std::move(nextInput);
+            break;
+        }
+        addToBatch(nextInput.releaseDocument(), *nextLocalValues);
+    }
+
+    // { <foreignFieldName> : { "$in" : [<value>, <value>, ...] } }
+    BSONObjBuilder match;
+    {
+        BSONObjBuilder query(match.subobjStart("$match"));
+        BSONObjBuilder inObj(query.subobjStart(_foreignField->fullPath()));
+        BSONArrayBuilder inValues(inObj.subarrayStart("$in"));
+        for (auto&& entry : batchIndexesByValue) {
+            inValues << entry.first;
+        }
+    }
+    // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
+    _resolvedPipeline.back() = match.obj();
+
+    std::vector<std::vector<Value>> results(batch.size());
+    std::vector<long long> resultSizes(batch.size(), 0);
+    std::vector<size_t> lastResultJoined(batch.size(), 0);
+
+    auto pipeline = buildPipeline(batch.front());
+    size_t resultNum = 0;
+    while (auto result = pipeline->getNext()) {
+        // A foreign document may match several values of the same local document, but is joined
+        // to it only once.
+        ++resultNum;
+        visitJoinKeysAtPath(Value(*result), *_foreignField, 0, [&](const Value& key) {
+            auto it = batchIndexesByValue.find(key);
+            if (it == batchIndexesByValue.end()) {
+                return;
+            }
+            for (auto batchIndex : it->second) {
+                if (lastResultJoined[batchIndex] != resultNum) {
+                    lastResultJoined[batchIndex] = resultNum;
+                    appendLookupResult(
+                        _fromNs, *result, &results[batchIndex], &resultSizes[batchIndex]);
+                }
+            }
+        });
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        MutableDocument output(std::move(batch[i]));
+        output.setNestedField(_as, Value(std::move(results[i])));
+        _batchedOutputs.push_back(output.freeze());
+    }
+
+    auto output = std::move(_batchedOutputs.front());
+    _batchedOutputs.pop_front();
+    return output;
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
@@ -498,6 +765,13 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _batchedOutputs.clear();
+    _pendingInput.reset();
+    if (_hashJoinState == HashJoinState::kBuilt) {
+        _hashJoinState = HashJoinState::kAbandoned;
+        _hashJoinTable.reset();
+        _hashJoinDocs.clear();
+    }
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -242,6 +243,27 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Reads the entire foreign collection into '_hashJoinTable', keyed by the values of
+     * '_foreignField'. Returns false, leaving the table empty, if the foreign documents exceed
+     * 'internalLookupStageHashJoinMaxForeignSizeBytes' or the join cannot be answered by hashing.
+     */
+    bool buildHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Returns the foreign documents from '_hashJoinTable' matching any of 'localValues', in the
+     * order in which they were read from the foreign collection.
+     */
+    std::vector<Document> probeHashJoinTable(const std::vector<Value>& localValues) const;
+
+    /**
+     * Joins 'inputDoc', whose '_localField' values are 'localValues', together with up to
+     * 'internalLookupStageBatchSize' - 1 subsequent local documents using a single $in query
+     * against the foreign collection. Returns the first joined document and buffers the rest in
+     * '_batchedOutputs'.
+     */
+    GetNextResult lookUpBatch(Document inputDoc, std::vector<Value> localValues);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -308,6 +330,19 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // For use when $lookup is specified with localField/foreignField syntax and the foreign
+    // collection is small enough to be held in memory. Maps each value of '_foreignField' to the
+    // indexes in '_hashJoinDocs' of the foreign documents containing it.
+    enum class HashJoinState { kUntried, kBuilt, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kUntried;
+    std::vector<Document> _hashJoinDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
+    // Joined documents waiting to be returned after a batched lookup, and the result pulled from
+    // our source which ended the batch, if it has not been consumed yet.
+    std::deque<Document> _batchedOutputs;
+    boost::optional<GetNextResult> _pendingInput;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
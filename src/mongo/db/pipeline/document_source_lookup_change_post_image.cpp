@@ -31,7 +31,12 @@
 
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
+#include <algorithm>
+
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -49,22 +54,143 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
             val.getType() == expectedType);
     return val;
 }
+
+bool isUpdateEvent(const Document& event) {
+    auto opTypeVal = assertFieldHasType(
+        event, DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+    return opTypeVal.getString() == DocumentSourceChangeStream::kUpdateOpType;
+}
+
+boost::optional<BSONObj> readConcernForLookup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                              Timestamp clusterTime) {
+    return expCtx->inMongos ? boost::optional<BSONObj>(BSON("level"
+                                                            << "majority"
+                                                            << "afterClusterTime" << clusterTime))
+                            : boost::none;
+}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
-    auto input = pSource->getNext();
-    if (!input.isAdvanced()) {
-        return input;
+    if (_buffer.empty()) {
+        if (_pendingError) {
+            auto status = std::move(*_pendingError);
+            _pendingError.reset();
+            uassertStatusOK(status);
+        }
+        if (_pendingResult) {
+            auto result = std::move(*_pendingResult);
+            _pendingResult.reset();
+            return result;
+        }
+
+        auto input = pSource->getNext();
+        if (!input.isAdvanced()) {
+            return input;
+        }
+        if (!isUpdateEvent(input.getDocument())) {
+            return input;
+        }
+
+        // A local lookup costs no more alone than as part of a batch.
+        if (!pExpCtx->inMongos || internalChangeStreamPostImageLookupBatchSize.load() <= 1) {
+            MutableDocument output(input.releaseDocument());
+            output[kFullDocumentFieldName] = lookupPostImage(output.peek());
+            return output.freeze();
+        }
+
+        _buffer.push_back(input.releaseDocument());
+        readAhead();
+        lookUpBufferedPostImages();
     }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
+
+    auto next = std::move(_buffer.front());
+    _buffer.pop_front();
+    return next;
+}
+
+void DocumentSourceLookupChangePostImage::readAhead() {
+    // Make the merge of the shards' results return EOF rather than wait for further events, which
+    // would delay those already read.
+    auto& awaitData = awaitDataState(pExpCtx->opCtx);
+    const auto waitForInsertsDeadline = awaitData.waitForInsertsDeadline;
+    awaitData.waitForInsertsDeadline = Date_t();
+    ON_BLOCK_EXIT([&] { awaitData.waitForInsertsDeadline = waitForInsertsDeadline; });
+
+    const size_t batchSize = internalChangeStreamPostImageLookupBatchSize.load();
+    try {
+        while (_buffer.size() < batchSize) {
+            auto input = pSource->getNext();
+            if (!input.isAdvanced()) {
+                _pendingResult = std::move(input);
+                return;
+            }
+            _buffer.push_back(input.releaseDocument());
+        }
+    } catch (const DBException& ex) {
+        // Such as the exception which closes the stream after an invalidate event, which must
+        // follow the events before it.
+        _pendingError = ex.toStatus();
     }
+}
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+void DocumentSourceLookupChangePostImage::lookUpBufferedPostImages() {
+    struct Lookup {
+        NamespaceString nss;
+        UUID uuid;
+        Timestamp clusterTime;
+        std::vector<size_t> positions;
+        std::vector<Document> documentKeys;
+    };
+    std::vector<Lookup> lookups;
+
+    for (size_t i = 0; i < _buffer.size(); ++i) {
+        const auto& event = _buffer[i];
+        if (!isUpdateEvent(event)) {
+            continue;
+        }
+
+        auto nss = assertValidNamespace(event);
+        auto documentKey =
+            assertFieldHasType(
+                event, DocumentSourceChangeStream::kDocumentKeyField, BSONType::Object)
+                .getDocument();
+        auto resumeToken =
+            ResumeToken::parse(event[DocumentSourceChangeStream::kIdField].getDocument());
+        invariant(resumeToken.getData().uuid);
+        const auto& uuid = *resumeToken.getData().uuid;
+
+        auto lookup = std::find_if(lookups.begin(), lookups.end(), [&](const Lookup& lookup) {
+            return lookup.nss == nss && lookup.uuid == uuid;
+        });
+        if (lookup == lookups.end()) {
+            lookups.push_back({nss, uuid, Timestamp(), {}, {}});
+            lookup = std::prev(lookups.end());
+        }
+
+        // Reading after the latest of the events reads after each of them.
+        lookup->clusterTime = std::max(lookup->clusterTime, resumeToken.getData().clusterTime);
+        lookup->positions.push_back(i);
+        lookup->documentKeys.push_back(std::move(documentKey));
+    }
+
+    for (auto&& lookup : lookups) {
+        auto postImages = pExpCtx->mongoProcessInterface->lookupDocuments(
+            pExpCtx,
+            lookup.nss,
+            lookup.uuid,
+            lookup.documentKeys,
+            readConcernForLookup(pExpCtx, lookup.clusterTime),
+            pExpCtx->inMongos);
+        invariant(postImages.size() == lookup.positions.size());
+
+        for (size_t i = 0; i < postImages.size(); ++i) {
+            auto& event = _buffer[lookup.positions[i]];
+            MutableDocument output(std::move(event));
+            output[kFullDocumentFieldName] =
+                postImages[i] ? Value(*postImages[i]) : Value(BSONNULL);
+            event = output.freeze();
+        }
+    }
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
@@ -101,12 +227,7 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
     auto resumeToken =
         ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
 
-    const auto readConcern = pExpCtx->inMongos
-        ? boost::optional<BSONObj>(BSON("level"
-                                        << "majority"
-                                        << "afterClusterTime" << resumeToken.getData().clusterTime))
-        : boost::none;
-
+    const auto readConcern = readConcernForLookup(pExpCtx, resumeToken.getData().clusterTime);
 
     // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
     // reads.
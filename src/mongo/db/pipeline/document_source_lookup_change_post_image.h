@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -37,6 +39,10 @@ namespace mongo {
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
  * "documentKey" field of the input to look up the new version of the document.
+ *
+ * On mongos, where each lookup is a query routed to the shards, the stage reads ahead the events
+ * which have already arrived, up to 'internalChangeStreamPostImageLookupBatchSize' of them, and
+ * looks up the post-images of all of the update events among them together.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -105,6 +111,15 @@ public:
         return kStageName.rawData();
     }
 
+    /**
+     * Returns true if the stage holds events which it has read but not yet returned. The resume
+     * token after a batch of results must then be that of the last event returned rather than one
+     * derived from the input.
+     */
+    bool hasBufferedEvents() const {
+        return !_buffer.empty() || _pendingResult || _pendingError;
+    }
+
 private:
     DocumentSourceLookupChangePostImage(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : DocumentSource(kStageName, expCtx) {}
@@ -114,6 +129,19 @@ private:
      */
     GetNextResult doGetNext() final;
 
+    /**
+     * Reads the events which follow the update event at the front of '_buffer' into it, without
+     * waiting for events which have not arrived yet. A pause, EOF or error which ends the batch is
+     * kept to be returned once the buffered events have been.
+     */
+    void readAhead();
+
+    /**
+     * Looks up the post-images of the update events in '_buffer', with one lookup for each
+     * collection among them.
+     */
+    void lookUpBufferedPostImages();
+
     /**
      * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
      * Returns Value(BSONNULL) if the document couldn't be found.
@@ -126,6 +154,13 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // Events which have been read ahead, their post-images already looked up.
+    std::deque<Document> _buffer;
+
+    // The result or error which ended the last read ahead, returned once '_buffer' is empty.
+    boost::optional<GetNextResult> _pendingResult;
+    boost::optional<Status> _pendingError;
 };
 
 }  // namespace mongo
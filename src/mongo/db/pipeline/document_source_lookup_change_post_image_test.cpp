@@ -39,12 +39,14 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
 
 namespace mongo {
 namespace {
@@ -334,5 +336,107 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+/**
+ * A mock MongoProcessInterface which answers batched lookups by _id and counts them.
+ */
+class CountingLookupDocumentsProcessInterface final : public StubMongoProcessInterface {
+public:
+    CountingLookupDocumentsProcessInterface(std::vector<Document> documents)
+        : _documents(std::move(documents)) {}
+
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead) final {
+        ++numLookups;
+        std::vector<boost::optional<Document>> results;
+        for (auto&& documentKey : documentKeys) {
+            auto it = std::find_if(_documents.begin(), _documents.end(), [&](const Document& doc) {
+                return ValueComparator().evaluate(doc["_id"] == documentKey["_id"]);
+            });
+            results.push_back(it == _documents.end() ? boost::none
+                                                     : boost::optional<Document>(*it));
+        }
+        return results;
+    }
+
+    int numLookups = 0;
+
+private:
+    std::vector<Document> _documents;
+};
+
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldBatchLookupsOfEventsAlreadyReadInMongos) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    auto nsDoc = Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}};
+    auto makeUpdate = [&](int id) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", "update"_sd},
+                        {"ns", nsDoc}};
+    };
+    auto insert = Document{{"_id", makeResumeToken(5)},
+                           {"documentKey", Document{{"_id", 5}}},
+                           {"operationType", "insert"_sd},
+                           {"ns", nsDoc},
+                           {"fullDocument", Document{{"_id", 5}}}};
+
+    // The events before the pause are looked up together and those after it separately.
+    deque<DocumentSource::GetNextResult> mockLocalContents{
+        makeUpdate(0),
+        Document(insert),
+        makeUpdate(1),
+        DocumentSource::GetNextResult::makePauseExecution(),
+        makeUpdate(2)};
+    auto mockLocalSource = DocumentSourceMock::createForTest(std::move(mockLocalContents), expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // The document with _id 1 has since been deleted.
+    getExpCtx()->mongoProcessInterface = std::make_unique<CountingLookupDocumentsProcessInterface>(
+        std::vector<Document>{Document{{"_id", 0}, {"x", 0}}, Document{{"_id", 2}, {"x", 2}}});
+    auto& processInterface =
+        static_cast<CountingLookupDocumentsProcessInterface&>(*expCtx->mongoProcessInterface);
+
+    auto withFullDocument = [](Document event, Value fullDocument) {
+        MutableDocument output(std::move(event));
+        output["fullDocument"] = std::move(fullDocument);
+        return output.freeze();
+    };
+
+    auto next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       withFullDocument(makeUpdate(0), Value(Document{{"_id", 0}, {"x", 0}})));
+    ASSERT_EQ(processInterface.numLookups, 1);
+    ASSERT_TRUE(lookupChangeStage->hasBufferedEvents());
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), insert);
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), withFullDocument(makeUpdate(1), Value(BSONNULL)));
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+    ASSERT_FALSE(lookupChangeStage->hasBufferedEvents());
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       withFullDocument(makeUpdate(2), Value(Document{{"_id", 2}, {"x", 2}})));
+    ASSERT_EQ(processInterface.numLookups, 2);
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+    ASSERT_FALSE(lookupChangeStage->hasBufferedEvents());
+}
+
 }  // namespace
 }  // namespace mongo
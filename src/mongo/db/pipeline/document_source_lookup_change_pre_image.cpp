@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_lookup_change_pre_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/change_stream_pre_images.h"
 #include "mongo/db/repl/local_oplog_info.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/util/intrusive_counter.h"
@@ -72,13 +73,21 @@ DocumentSource::GetNextResult DocumentSourceLookupChangePreImage::doGetNext() {
     // 'required', we throw an exception. Otherwise, we pass along the document unmodified.
     auto preImageOpTimeVal = input.getDocument()[kFullDocumentBeforeChangeFieldName];
     if (preImageOpTimeVal.missing()) {
+        auto preImageDoc = lookupPreImageInCollection(input.getDocument());
         uassert(51770,
                 str::stream()
                     << "Change stream was configured to require a pre-image for all update, delete "
-                       "and replace events, but no pre-image optime was recorded for event: "
+                       "and replace events, but no pre-image was recorded for event: "
                     << input.getDocument().toString(),
-                _fullDocumentBeforeChangeMode != FullDocumentBeforeChangeModeEnum::kRequired);
-        return input;
+                preImageDoc ||
+                    _fullDocumentBeforeChangeMode != FullDocumentBeforeChangeModeEnum::kRequired);
+        if (!preImageDoc) {
+            return input;
+        }
+
+        MutableDocument outputDoc(input.releaseDocument());
+        outputDoc[kFullDocumentBeforeChangeFieldName] = Value(*preImageDoc);
+        return outputDoc.freeze();
     }
 
     // Look up the pre-image using the optime. This may return boost::none if it was not found.
@@ -133,4 +142,35 @@ boost::optional<Document> DocumentSourceLookupChangePreImage::lookupPreImage(
     return Document{opLogEntry.getObject().getOwned()};
 }
 
+boost::optional<Document> DocumentSourceLookupChangePreImage::lookupPreImageInCollection(
+    const Document& inputDoc) const {
+    // The pre-images collection does not exist on nodes which record pre-images in the oplog.
+    auto preImagesInfo = pExpCtx->mongoProcessInterface->getCollectionOptions(
+        pExpCtx->opCtx, NamespaceString::kChangeStreamPreImagesNamespace);
+    if (preImagesInfo.isEmpty()) {
+        return boost::none;
+    }
+    auto preImagesUUID = invariantStatusOK(UUID::parse(preImagesInfo["uuid"]));
+
+    auto resumeToken = ResumeToken::parse(
+        inputDoc[DocumentSourceChangeStream::kIdField].getDocument()).getData();
+    invariant(resumeToken.uuid);
+
+    auto lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
+        pExpCtx,
+        NamespaceString::kChangeStreamPreImagesNamespace,
+        preImagesUUID,
+        Document{{"_id", change_stream_pre_images::idForTimestamp(resumeToken.clusterTime)}},
+        boost::none);
+
+    // A pre-image stored under the same timestamp belongs to this event if it is of the same
+    // collection.
+    if (!lookedUpDoc ||
+        (*lookedUpDoc)[change_stream_pre_images::kNsUUIDFieldName].getUuid() !=
+            *resumeToken.uuid) {
+        return boost::none;
+    }
+    return (*lookedUpDoc)[change_stream_pre_images::kPreImageFieldName].getDocument().getOwned();
+}
+
 }  // namespace mongo
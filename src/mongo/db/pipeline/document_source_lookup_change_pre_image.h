@@ -39,7 +39,9 @@ namespace mongo {
  *
  * After a document that should have its pre-image included is transformed from the oplog,
  * its "fullDocumentBeforeChange" field shall be the optime of the noop oplog entry containing the
- * pre-image. This stage replaces that field with the actual pre-image document.
+ * pre-image. This stage replaces that field with the actual pre-image document. When the field is
+ * missing, the pre-image may instead be stored in the pre-images collection under the event's
+ * collection UUID and cluster time, from which this stage looks it up.
  */
 class DocumentSourceLookupChangePreImage final : public DocumentSource {
 public:
@@ -122,6 +124,12 @@ private:
     boost::optional<Document> lookupPreImage(const Document& inputDoc,
                                              const repl::OpTime& opTime) const;
 
+    /**
+     * Looks up and returns the pre-image of the event 'inputDoc' in the pre-images collection, or
+     * boost::none if no pre-image was stored for it there.
+     */
+    boost::optional<Document> lookupPreImageInCollection(const Document& inputDoc) const;
+
     // Determines whether pre-images are strictly required or may be included only when available.
     FullDocumentBeforeChangeModeEnum _fullDocumentBeforeChangeMode =
         FullDocumentBeforeChangeModeEnum::kOff;
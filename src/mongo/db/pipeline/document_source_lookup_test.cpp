@@ -48,6 +48,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -508,12 +509,18 @@ public:
 
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        ++_numCursorsAttached;
         return pipeline;
     }
 
+    int numCursorsAttached() const {
+        return _numCursorsAttached;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numCursorsAttached = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -624,6 +631,179 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, HashJoinReadsForeignCollectionOnce) {
+    const auto originalMaxForeignBytes = internalLookupStageHashJoinMaxForeignSizeBytes.load();
+    internalLookupStageHashJoinMaxForeignSizeBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT(
+        [&] { internalLookupStageHashJoinMaxForeignSizeBytes.store(originalMaxForeignBytes); });
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{fromjson("{_id: 0, x: 1}")},
+        Document{fromjson("{_id: 1, x: [1, 2]}")},
+        Document{fromjson("{_id: 2, x: 3}")},
+        Document{fromjson("{_id: 3}")}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'y', foreignField: 'x', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{fromjson("{y: 1}")},
+                                                              Document{fromjson("{y: [2, 3]}")},
+                                                              Document{fromjson("{y: 5}")},
+                                                              Document{fromjson("{z: 0}")}},
+                                                             expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{y: 1, foreignDocs: [{_id: 0, x: 1}, {_id: 1, x: [1, "
+                                         "2]}]}")});
+
+    // A foreign document matching several local values is only returned once.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{y: [2, 3], foreignDocs: [{_id: 1, x: [1, 2]}, {_id: 2, "
+                                         "x: 3}]}")});
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document{fromjson("{y: 5, foreignDocs: []}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 1);
+
+    // A missing local value matches foreign documents missing 'x', so it is answered by querying
+    // the foreign collection.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{z: 0, foreignDocs: [{_id: 3}]}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 2);
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinFallsBackWhenForeignCollectionIsTooLarge) {
+    const auto originalMaxForeignBytes = internalLookupStageHashJoinMaxForeignSizeBytes.load();
+    internalLookupStageHashJoinMaxForeignSizeBytes.store(1);
+    ON_BLOCK_EXIT(
+        [&] { internalLookupStageHashJoinMaxForeignSizeBytes.store(originalMaxForeignBytes); });
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}},
+                                                             Document{{"_id", 1}}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'foreignId', "
+                               "foreignField: '_id', as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"foreignId", 0}}, Document{{"foreignId", 1}}}, expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 0}, {"foreignDocs", vector<Value>{Value(Document{{"_id", 0}})}}}));
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"foreignId", 1}, {"foreignDocs", vector<Value>{Value(Document{{"_id", 1}})}}}));
+
+    // The abandoned build reads the foreign collection once, then each local document queries it.
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 3);
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookupQueriesForeignCollectionOncePerBatch) {
+    const auto originalBatchSize = internalLookupStageBatchSize.load();
+    internalLookupStageBatchSize.store(10);
+    ON_BLOCK_EXIT([&] { internalLookupStageBatchSize.store(originalBatchSize); });
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{fromjson("{_id: 0, x: 1}")},
+        Document{fromjson("{_id: 1, x: [1, 2]}")},
+        Document{fromjson("{_id: 2, x: 3}")},
+        Document{fromjson("{_id: 3}")}};
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookupSpec = fromjson("{$lookup: {from: 'foreign', localField: 'y', foreignField: 'x', "
+                               "as: 'foreignDocs'}}");
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    // The missing local value ends the first batch, and the pause ends the second.
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document{fromjson("{y: 1}")},
+                                           Document{fromjson("{y: [1, 2]}")},
+                                           Document{fromjson("{y: 4}")},
+                                           Document{fromjson("{z: 0}")},
+                                           Document{fromjson("{y: 2}")},
+                                           DocumentSource::GetNextResult::makePauseExecution()},
+                                          expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{y: 1, foreignDocs: [{_id: 0, x: 1}, {_id: 1, x: [1, "
+                                         "2]}]}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 1);
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{y: [1, 2], foreignDocs: [{_id: 0, x: 1}, {_id: 1, x: "
+                                         "[1, 2]}]}")});
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document{fromjson("{y: 4, foreignDocs: []}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 1);
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{z: 0, foreignDocs: [{_id: 3}]}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 2);
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document{fromjson("{y: 2, foreignDocs: [{_id: 1, x: [1, 2]}]}")});
+    ASSERT_EQ(mongoInterface->numCursorsAttached(), 3);
+
+    ASSERT_TRUE(lookup->getNext().isPaused());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -0,0 +1,221 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_pipeline_result_cache.h"
+
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/clock_source.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_DOCUMENT_SOURCE(_internalPipelineResultCache,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourcePipelineResultCache::createFromBson);
+
+namespace {
+constexpr StringData kPipelineName = "pipeline"_sd;
+constexpr StringData kWriteVersionName = "writeVersion"_sd;
+
+BSONObj collationSpec(const intrusive_ptr<ExpressionContext>& expCtx) {
+    return expCtx->getCollator() ? expCtx->getCollator()->getSpec().toBSON() : BSONObj();
+}
+}  // namespace
+
+BSONObj DocumentSourcePipelineResultCache::makeSpec(const std::vector<BSONObj>& pipeline) {
+    return BSON(kStageName << BSON(kPipelineName << pipeline));
+}
+
+intrusive_ptr<DocumentSourcePipelineResultCache> DocumentSourcePipelineResultCache::create(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    std::vector<BSONObj> pipeline,
+    boost::optional<uint64_t> writeVersion) {
+    return new DocumentSourcePipelineResultCache(expCtx, std::move(pipeline), writeVersion);
+}
+
+intrusive_ptr<DocumentSource> DocumentSourcePipelineResultCache::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(5159000,
+            str::stream() << kStageName << " must be specified as an object",
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::vector<BSONObj>> pipeline;
+    for (auto&& field : elem.embeddedObject()) {
+        const auto fieldName = field.fieldNameStringData();
+        if (fieldName == kPipelineName) {
+            uassert(5159002,
+                    str::stream() << kStageName << " '" << kPipelineName << "' must be an array",
+                    field.type() == BSONType::Array);
+            pipeline.emplace();
+            for (auto&& stage : field.Obj()) {
+                uassert(5159003,
+                        str::stream() << kStageName << " '" << kPipelineName
+                                      << "' must only contain objects",
+                        stage.type() == BSONType::Object);
+                pipeline->push_back(stage.Obj().getOwned());
+            }
+        } else {
+            uasserted(5159004,
+                      str::stream() << "unrecognized option to " << kStageName << ": "
+                                    << fieldName);
+        }
+    }
+    uassert(5159005,
+            str::stream() << kStageName << " requires '" << kPipelineName << "'",
+            pipeline);
+
+    // The cached results are only a function of the collection, so the pipeline may not read from
+    // other namespaces or require privileges beyond those of the aggregation.
+    LiteParsedPipeline liteParsedPipeline(expCtx->ns, *pipeline);
+    uassert(5159006,
+            str::stream() << kStageName << " pipeline may not involve other namespaces, change "
+                          << "streams or stages that require additional privileges",
+            liteParsedPipeline.getInvolvedNamespaces().empty() &&
+                !liteParsedPipeline.hasChangeStream() &&
+                liteParsedPipeline.requiredPrivileges(false, false).empty());
+
+    return new DocumentSourcePipelineResultCache(expCtx, std::move(*pipeline), boost::none);
+}
+
+DocumentSourcePipelineResultCache::DocumentSourcePipelineResultCache(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    std::vector<BSONObj> pipeline,
+    boost::optional<uint64_t> writeVersion)
+    : DocumentSource(kStageName, expCtx),
+      _rawPipeline(std::move(pipeline)),
+      _writeVersion(writeVersion),
+      _cacheKey(PipelineResultCache::makeKey(
+          expCtx->ns, expCtx->uuid, _rawPipeline, collationSpec(expCtx), _writeVersion)) {}
+
+Value DocumentSourcePipelineResultCache::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    // The write version is only reported for explain, since it cannot be parsed back.
+    BSONObjBuilder bob;
+    bob.append(kPipelineName, _rawPipeline);
+    if (explain && _writeVersion) {
+        bob.append(kWriteVersionName, static_cast<long long>(*_writeVersion));
+    }
+    return Value(DOC(getSourceName() << bob.obj()));
+}
+
+void DocumentSourcePipelineResultCache::initialize() {
+    _initialized = true;
+
+    auto& cache = PipelineResultCache::get(pExpCtx->opCtx->getServiceContext());
+    const auto now = pExpCtx->opCtx->getServiceContext()->getFastClockSource()->now();
+    const auto maxStaleness = _writeVersion
+        ? Milliseconds::max()
+        : Milliseconds(internalQueryViewResultCacheMaxStalenessMS.load());
+    _cachedEntry = cache.lookup(_cacheKey, now, maxStaleness);
+    if (_cachedEntry) {
+        return;
+    }
+
+    _newEntry = std::make_shared<PipelineResultCache::Entry>();
+    _newEntry->computedAt = now;
+    _pipeline = Pipeline::makePipeline(_rawPipeline, pExpCtx->copyForSubPipeline(pExpCtx->ns));
+}
+
+DocumentSource::GetNextResult DocumentSourcePipelineResultCache::doGetNext() {
+    if (!_initialized) {
+        initialize();
+    }
+
+    if (_cachedEntry) {
+        if (_nextResult == _cachedEntry->results.size()) {
+            return GetNextResult::makeEOF();
+        }
+        return Document(_cachedEntry->results[_nextResult++]);
+    }
+
+    if (!_pipeline) {
+        return GetNextResult::makeEOF();
+    }
+
+    auto next = _pipeline->getNext();
+    if (!next) {
+        if (_newEntry) {
+            PipelineResultCache::get(pExpCtx->opCtx->getServiceContext())
+                .insert(_cacheKey,
+                        std::move(_newEntry),
+                        static_cast<size_t>(internalQueryPipelineResultCacheMaxSizeBytes.load()));
+        }
+        _usedDisk = _usedDisk || _pipeline->usedDisk();
+        _pipeline->dispose(pExpCtx->opCtx);
+        _pipeline.reset();
+        return GetNextResult::makeEOF();
+    }
+
+    if (_newEntry) {
+        _newEntry->sizeBytes += next->getApproximateSize();
+        if (_newEntry->sizeBytes >
+            static_cast<size_t>(internalQueryPipelineResultCacheMaxSizeBytes.load())) {
+            // The results could never be cached, so stop buffering them.
+            _newEntry.reset();
+        } else {
+            _newEntry->results.push_back(next->getOwned());
+        }
+    }
+    return std::move(*next);
+}
+
+bool DocumentSourcePipelineResultCache::usedDisk() {
+    return _usedDisk || (_pipeline && _pipeline->usedDisk());
+}
+
+void DocumentSourcePipelineResultCache::doDispose() {
+    if (_pipeline) {
+        _usedDisk = _usedDisk || _pipeline->usedDisk();
+        _pipeline->dispose(pExpCtx->opCtx);
+        _pipeline.reset();
+    }
+    _newEntry.reset();
+    _cachedEntry.reset();
+}
+
+void DocumentSourcePipelineResultCache::detachFromOperationContext() {
+    if (_pipeline) {
+        _pipeline->detachFromOperationContext();
+    }
+}
+
+void DocumentSourcePipelineResultCache::reattachToOperationContext(OperationContext* opCtx) {
+    if (_pipeline) {
+        _pipeline->reattachToOperationContext(opCtx);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/pipeline_result_cache.h"
+
+namespace mongo {
+
+/**
+ * An internal stage which produces the results of a pipeline run against the aggregation's
+ * collection, serving them from the PipelineResultCache when it holds a usable entry. Otherwise the
+ * pipeline is executed and its results are added to the cache once they have been returned in
+ * full.
+ *
+ * An entry is usable if it is keyed on the same collection write version as the stage, when the
+ * stage has one, or otherwise if it is no older than 'internalQueryViewResultCacheMaxStalenessMS'.
+ * The former is used to cache a deterministic prefix of an aggregation, and the latter to cache
+ * the pipeline of a view on behalf of readers which tolerate stale results.
+ */
+class DocumentSourcePipelineResultCache final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalPipelineResultCache"_sd;
+
+    /**
+     * Returns the specification of a $_internalPipelineResultCache stage which produces the
+     * results of 'pipeline', allowing them to be stale.
+     */
+    static BSONObj makeSpec(const std::vector<BSONObj>& pipeline);
+
+    /**
+     * Creates a stage which produces the results of 'pipeline'. If 'writeVersion' is set, only
+     * results computed at that write version of the collection are served from the cache. The
+     * caller must have observed 'writeVersion' before opening the storage snapshot which the
+     * pipeline will read from.
+     */
+    static boost::intrusive_ptr<DocumentSourcePipelineResultCache> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        std::vector<BSONObj> pipeline,
+        boost::optional<uint64_t> writeVersion);
+
+    /**
+     * Parses a stage from 'elem'. Stages parsed this way allow stale results, since a write version
+     * from a user could not be trusted to match the collection contents.
+     */
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kLocalOnly,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed,
+                                     LookupRequirement::kNotAllowed,
+                                     UnionRequirement::kNotAllowed);
+
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+    bool usedDisk() final;
+
+private:
+    DocumentSourcePipelineResultCache(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                      std::vector<BSONObj> pipeline,
+                                      boost::optional<uint64_t> writeVersion);
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Either finds a usable cache entry or begins executing the pipeline.
+     */
+    void initialize();
+
+    const std::vector<BSONObj> _rawPipeline;
+    const boost::optional<uint64_t> _writeVersion;
+    const std::string _cacheKey;
+
+    bool _initialized = false;
+    bool _usedDisk = false;
+
+    // Set when the results are being served from the cache.
+    std::shared_ptr<const PipelineResultCache::Entry> _cachedEntry;
+    size_t _nextResult = 0;
+
+    // Set when the results are being computed by running the pipeline. The results are buffered in
+    // '_newEntry' until the pipeline is exhausted, unless they grow too large to cache.
+    std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    std::shared_ptr<PipelineResultCache::Entry> _newEntry;
+};
+
+}  // namespace mongo
@@ -0,0 +1,672 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+
+#include <cmath>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/overflow_arithmetic.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::list;
+
+REGISTER_MULTI_STAGE_ALIAS(setWindowFields,
+                           LiteParsedDocumentSourceDefault::parse,
+                           DocumentSourceSetWindowFields::createFromBson);
+
+REGISTER_DOCUMENT_SOURCE(_internalSetWindowFields,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalSetWindowFields::createFromBson);
+
+namespace {
+constexpr StringData kPartitionByName = "partitionBy"_sd;
+constexpr StringData kSortByName = "sortBy"_sd;
+constexpr StringData kOutputName = "output"_sd;
+constexpr StringData kWindowName = "window"_sd;
+constexpr StringData kDocumentsName = "documents"_sd;
+constexpr StringData kRangeName = "range"_sd;
+constexpr StringData kUnitName = "unit"_sd;
+constexpr StringData kUnboundedName = "unbounded"_sd;
+constexpr StringData kCurrentName = "current"_sd;
+
+/**
+ * Returns the length in milliseconds of the 'range' window unit 'unit'.
+ */
+long long parseUnit(BSONElement unit) {
+    static const StringMap<long long> kUnitMillis = {{"millisecond", 1},
+                                                     {"second", 1000},
+                                                     {"minute", 60 * 1000},
+                                                     {"hour", 60 * 60 * 1000},
+                                                     {"day", 24 * 60 * 60 * 1000},
+                                                     {"week", 7 * 24 * 60 * 60 * 1000}};
+    auto it = unit.type() == BSONType::String ? kUnitMillis.find(unit.valueStringData())
+                                              : kUnitMillis.end();
+    uassert(5157013,
+            str::stream() << "Window 'unit' must be one of 'millisecond', 'second', 'minute', "
+                             "'hour', 'day' or 'week'; found: "
+                          << unit.toString(false),
+            it != kUnitMillis.end());
+    return it->second;
+}
+
+/**
+ * Parses one end of a window, where "unbounded" is returned as boost::none and "current" as 0.
+ */
+boost::optional<Value> parseBound(BSONElement bound, WindowBounds::Type type, bool integral) {
+    if (bound.type() == BSONType::String && bound.valueStringData() == kUnboundedName) {
+        return boost::none;
+    } else if (bound.type() == BSONType::String && bound.valueStringData() == kCurrentName) {
+        return Value(0);
+    }
+
+    Value value(bound);
+    bool valid = value.numeric() &&
+        (integral ? value.integral64Bit() : std::isfinite(value.coerceToDouble()));
+    uassert(5157014,
+            str::stream() << "Window bounds must be 'unbounded', 'current', or "
+                          << (integral ? "an integer" : "a finite number")
+                          << (type == WindowBounds::Type::kDocuments ? " for a 'documents' window"
+                                                                     : "")
+                          << "; found: " << bound.toString(false),
+            valid);
+    return integral ? Value(value.coerceToLong()) : value;
+}
+
+WindowBounds parseWindowBounds(BSONElement elem, const BSONObj& sortBy) {
+    uassert(5157008,
+            str::stream() << "'" << kWindowName << "' must be an object; found: "
+                          << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    BSONElement documents;
+    BSONElement range;
+    BSONElement unit;
+    for (auto&& field : elem.embeddedObject()) {
+        auto name = field.fieldNameStringData();
+        if (name == kDocumentsName) {
+            documents = field;
+        } else if (name == kRangeName) {
+            range = field;
+        } else if (name == kUnitName) {
+            unit = field;
+        } else {
+            uasserted(5157008,
+                      str::stream() << "'" << kWindowName << "' got an unexpected field: " << name);
+        }
+    }
+    uassert(5157009,
+            str::stream() << "'" << kWindowName << "' must specify exactly one of '"
+                          << kDocumentsName << "' or '" << kRangeName << "'",
+            bool(documents) != bool(range));
+
+    WindowBounds bounds;
+    bounds.type = documents ? WindowBounds::Type::kDocuments : WindowBounds::Type::kRange;
+    auto boundsElem = documents ? documents : range;
+    if (bounds.type == WindowBounds::Type::kDocuments) {
+        uassert(5157012,
+                str::stream() << "'" << kUnitName << "' requires a '" << kRangeName << "' window",
+                !unit);
+    } else {
+        uassert(5157011,
+                str::stream() << "A '" << kRangeName << "' window requires '" << kSortByName
+                              << "' to have exactly one field",
+                sortBy.nFields() == 1);
+        if (unit) {
+            bounds.unit = unit.str();
+            bounds.unitMillis = parseUnit(unit);
+        }
+    }
+
+    uassert(5157010,
+            str::stream() << "Window bounds must be an array of two elements; found: "
+                          << boundsElem.toString(false),
+            boundsElem.type() == BSONType::Array && boundsElem.embeddedObject().nFields() == 2);
+    bool integral = bounds.type == WindowBounds::Type::kDocuments || bounds.unit;
+    bounds.lower = parseBound(boundsElem.embeddedObject()[0], bounds.type, integral);
+    bounds.upper = parseBound(boundsElem.embeddedObject()[1], bounds.type, integral);
+    uassert(5157015,
+            str::stream() << "The lower bound of a window must not be greater than its upper "
+                             "bound; found: "
+                          << boundsElem.toString(false),
+            !bounds.lower || !bounds.upper ||
+                Value::compare(*bounds.lower, *bounds.upper, nullptr) <= 0);
+    return bounds;
+}
+
+DocumentSourceInternalSetWindowFields::OutputField parseOutputField(
+    const intrusive_ptr<ExpressionContext>& expCtx, BSONElement elem, const BSONObj& sortBy) {
+    uassert(5157005,
+            str::stream() << "The specification of output field '" << elem.fieldNameStringData()
+                          << "' must be an object; found: " << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    DocumentSourceInternalSetWindowFields::OutputField field{FieldPath(elem.fieldName())};
+    for (auto&& arg : elem.embeddedObject()) {
+        auto name = arg.fieldNameStringData();
+        if (name == kWindowName) {
+            field.bounds = parseWindowBounds(arg, sortBy);
+            continue;
+        }
+        uassert(5157006,
+                str::stream() << "Output field '" << field.path.fullPath()
+                              << "' can only specify one window function",
+                field.opName.empty());
+        uassert(5157007,
+                str::stream() << "Unrecognized window function, " << name,
+                WindowFunctionState::create(expCtx.get(), name));
+        field.opName = name.toString();
+        field.input = Expression::parseOperand(expCtx.get(), arg, expCtx->variablesParseState);
+    }
+    uassert(5157006,
+            str::stream() << "Output field '" << field.path.fullPath()
+                          << "' must specify a window function",
+            !field.opName.empty());
+    return field;
+}
+
+/**
+ * Adds two numbers, widening the result to a double if a sum of integers would overflow.
+ */
+Value addNumbers(const Value& lhs, const Value& rhs) {
+    switch (Value::getWidestNumeric(lhs.getType(), rhs.getType())) {
+        case NumberDecimal:
+            return Value(lhs.coerceToDecimal().add(rhs.coerceToDecimal()));
+        case NumberDouble:
+            return Value(lhs.coerceToDouble() + rhs.coerceToDouble());
+        default: {
+            long long sum;
+            if (overflow::add(lhs.coerceToLong(), rhs.coerceToLong(), &sum)) {
+                return Value(lhs.coerceToDouble() + rhs.coerceToDouble());
+            }
+            return Value(sum);
+        }
+    }
+}
+}  // namespace
+
+list<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(5157000,
+            str::stream() << "Argument to " << kStageName
+                          << " stage must be an object, but found type: " << typeName(elem.type())
+                          << ".",
+            elem.type() == BSONType::Object);
+
+    auto internalSpec =
+        BSON(DocumentSourceInternalSetWindowFields::kStageName << elem.embeddedObject());
+    auto windowFields = DocumentSourceInternalSetWindowFields::createFromBson(
+        internalSpec.firstElement(), pExpCtx);
+    const auto& internalStage =
+        static_cast<const DocumentSourceInternalSetWindowFields&>(*windowFields);
+
+    // Sort on the partition first, so that each partition is contiguous, and then on 'sortBy'
+    // within each partition.
+    BSONObjBuilder sortPattern;
+    const auto& partitionBy = internalStage.getPartitionBy();
+    if (partitionBy) {
+        sortPattern.append(partitionBy->fullPath(), 1);
+    }
+    for (auto&& sortElem : internalStage.getSortBy()) {
+        if (!partitionBy || sortElem.fieldNameStringData() != partitionBy->fullPath()) {
+            sortPattern.append(sortElem);
+        }
+    }
+
+    auto sortSpec = sortPattern.obj();
+    if (sortSpec.isEmpty()) {
+        return {windowFields};
+    }
+    auto sortStage = DocumentSourceSort::createFromBson(
+        BSON(DocumentSourceSort::kStageName << sortSpec).firstElement(), pExpCtx);
+    return {sortStage, windowFields};
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(5157000,
+            str::stream() << "Argument to " << kStageName
+                          << " stage must be an object, but found type: " << typeName(elem.type())
+                          << ".",
+            elem.type() == BSONType::Object);
+
+    boost::optional<FieldPath> partitionBy;
+    BSONObj sortBy;
+    BSONElement output;
+    for (auto&& arg : elem.embeddedObject()) {
+        auto name = arg.fieldNameStringData();
+        if (name == kPartitionByName) {
+            uassert(5157002,
+                    str::stream() << "'" << kPartitionByName
+                                  << "' must be a field path such as '$a'; found: "
+                                  << arg.toString(false),
+                    arg.type() == BSONType::String && arg.valueStringData().startsWith("$") &&
+                        !arg.valueStringData().startsWith("$$"));
+            partitionBy = FieldPath(arg.valueStringData().substr(1).toString());
+        } else if (name == kSortByName) {
+            uassert(5157003,
+                    str::stream() << "'" << kSortByName
+                                  << "' must be an object; found: " << typeName(arg.type()),
+                    arg.type() == BSONType::Object);
+            for (auto&& sortElem : arg.embeddedObject()) {
+                uassert(5157003,
+                        str::stream() << "'" << kSortByName << "' direction for '"
+                                      << sortElem.fieldNameStringData() << "' must be 1 or -1",
+                        sortElem.isNumber() &&
+                            (sortElem.numberDouble() == 1 || sortElem.numberDouble() == -1));
+            }
+            sortBy = arg.embeddedObject().getOwned();
+        } else if (name == kOutputName) {
+            uassert(5157004,
+                    str::stream() << "'" << kOutputName
+                                  << "' must be an object; found: " << typeName(arg.type()),
+                    arg.type() == BSONType::Object);
+            output = arg;
+        } else {
+            uasserted(5157001,
+                      str::stream() << kStageName << " got an unexpected field: " << name);
+        }
+    }
+    uassert(5157004,
+            str::stream() << kStageName << " must specify at least one '" << kOutputName
+                          << "' field",
+            output && !output.embeddedObject().isEmpty());
+
+    std::vector<OutputField> outputFields;
+    for (auto&& fieldElem : output.embeddedObject()) {
+        outputFields.push_back(parseOutputField(pExpCtx, fieldElem, sortBy));
+    }
+    return create(pExpCtx, std::move(partitionBy), std::move(sortBy), std::move(outputFields));
+}
+
+intrusive_ptr<DocumentSourceInternalSetWindowFields> DocumentSourceInternalSetWindowFields::create(
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    boost::optional<FieldPath> partitionBy,
+    BSONObj sortBy,
+    std::vector<OutputField> outputFields) {
+    return new DocumentSourceInternalSetWindowFields(
+        pExpCtx, std::move(partitionBy), std::move(sortBy), std::move(outputFields));
+}
+
+DocumentSourceInternalSetWindowFields::DocumentSourceInternalSetWindowFields(
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    boost::optional<FieldPath> partitionBy,
+    BSONObj sortBy,
+    std::vector<OutputField> outputFields)
+    : DocumentSource(kStageName, pExpCtx),
+      _partitionBy(std::move(partitionBy)),
+      _sortBy(sortBy.getOwned()),
+      _outputFields(std::move(outputFields)),
+      _maxMemoryUsageBytes(internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load()) {
+    if (_partitionBy) {
+        _partitionByExpr = ExpressionFieldPath::create(pExpCtx.get(), _partitionBy->fullPath());
+    }
+    if (!_sortBy.isEmpty()) {
+        _sortDirection = _sortBy.firstElement().numberInt();
+    }
+
+    for (auto&& field : _outputFields) {
+        Window window;
+        window.function = WindowFunctionState::create(pExpCtx.get(), field.opName);
+        invariant(window.function);
+
+        if (field.bounds.type == WindowBounds::Type::kRange) {
+            _needsSortKeys = true;
+            // When sorting in descending order, the window slides towards smaller values.
+            window.hasTrailingBound = _sortDirection > 0 ? bool(field.bounds.lower)
+                                                         : bool(field.bounds.upper);
+        } else {
+            window.hasTrailingBound = bool(field.bounds.lower);
+        }
+        _windows.push_back(std::move(window));
+    }
+    if (_needsSortKeys) {
+        _sortKeyExpr =
+            ExpressionFieldPath::create(pExpCtx.get(), _sortBy.firstElement().fieldName());
+    }
+}
+
+DepsTracker::State DocumentSourceInternalSetWindowFields::getDependencies(
+    DepsTracker* deps) const {
+    if (_partitionByExpr) {
+        _partitionByExpr->addDependencies(deps);
+    }
+    for (auto&& sortElem : _sortBy) {
+        deps->fields.insert(sortElem.fieldName());
+    }
+    for (auto&& field : _outputFields) {
+        field.input->addDependencies(deps);
+    }
+    return DepsTracker::State::SEE_NEXT;
+}
+
+DocumentSource::GetModPathsReturn DocumentSourceInternalSetWindowFields::getModifiedPaths() const {
+    std::set<std::string> modifiedPaths;
+    for (auto&& field : _outputFields) {
+        modifiedPaths.insert(field.path.fullPath());
+    }
+    return {GetModPathsReturn::Type::kFiniteSet, std::move(modifiedPaths), {}};
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::optimize() {
+    for (auto&& field : _outputFields) {
+        field.input = field.input->optimize();
+    }
+    return this;
+}
+
+Value DocumentSourceInternalSetWindowFields::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    auto serializeBound = [](const boost::optional<Value>& bound) {
+        return bound ? *bound : Value(kUnboundedName);
+    };
+
+    MutableDocument output;
+    for (auto&& field : _outputFields) {
+        MutableDocument window;
+        window.addField(field.bounds.type == WindowBounds::Type::kDocuments ? kDocumentsName
+                                                                            : kRangeName,
+                        Value(std::vector<Value>{serializeBound(field.bounds.lower),
+                                                 serializeBound(field.bounds.upper)}));
+        if (field.bounds.unit) {
+            window.addField(kUnitName, Value(*field.bounds.unit));
+        }
+        auto input = field.input->serialize(static_cast<bool>(explain));
+        output.addField(field.path.fullPath(),
+                        Value(DOC(field.opName << input << kWindowName << window.freeze())));
+    }
+
+    MutableDocument spec;
+    if (_partitionBy) {
+        spec.addField(kPartitionByName, Value("$" + _partitionBy->fullPath()));
+    }
+    if (!_sortBy.isEmpty()) {
+        spec.addField(kSortByName, Value(_sortBy));
+    }
+    spec.addField(kOutputName, output.freezeToValue());
+    return Value(DOC(getSourceName() << spec.freeze()));
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext() {
+    while (true) {
+        if (_nextIndex < bufferEnd() && isReady(_nextIndex)) {
+            return outputNextDocument();
+        }
+
+        if (_partitionExhausted) {
+            if (!_nextPartitionDoc) {
+                return GetNextResult::makeEOF();
+            }
+            startNextPartition();
+            continue;
+        }
+
+        auto next = pSource->getNext();
+        if (next.isPaused()) {
+            return next;
+        } else if (next.isEOF()) {
+            _partitionExhausted = true;
+            continue;
+        }
+
+        auto doc = next.releaseDocument();
+        if (_partitionByExpr) {
+            auto key = _partitionByExpr->evaluate(doc, &pExpCtx->variables);
+            uassert(5157016,
+                    str::stream() << "'" << kPartitionByName << "' field '"
+                                  << _partitionBy->fullPath()
+                                  << "' must not be an array; found: " << key.toString(),
+                    !key.isArray());
+            // $sort does not distinguish missing values from null, so neither can partitions.
+            if (key.missing()) {
+                key = Value(BSONNULL);
+            }
+
+            if (_partitionKey &&
+                pExpCtx->getValueComparator().evaluate(key != *_partitionKey)) {
+                _partitionExhausted = true;
+                _partitionKey = std::move(key);
+                _nextPartitionDoc = std::move(doc);
+                continue;
+            }
+            _partitionKey = std::move(key);
+        }
+        bufferDocument(std::move(doc));
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::bufferDocument(Document doc) {
+    Value sortKey;
+    if (_needsSortKeys) {
+        sortKey = _sortKeyExpr->evaluate(doc, &pExpCtx->variables);
+        for (auto&& field : _outputFields) {
+            if (field.bounds.type != WindowBounds::Type::kRange) {
+                continue;
+            }
+            uassert(5157017,
+                    str::stream() << "A '" << kRangeName << "' window "
+                                  << (field.bounds.unit ? "with a 'unit' requires '"
+                                                        : "without a 'unit' requires '")
+                                  << kSortByName << "' values to be "
+                                  << (field.bounds.unit ? "dates" : "numbers")
+                                  << "; found: " << sortKey.toString(),
+                    field.bounds.unit ? sortKey.getType() == BSONType::Date : sortKey.numeric());
+        }
+    }
+
+    auto memUsageBytes = doc.getApproximateSize() + sortKey.getApproximateSize();
+    _memoryUsageBytes += memUsageBytes;
+    _buffer.push_back({std::move(doc), std::move(sortKey), memUsageBytes});
+    checkMemoryUsage();
+}
+
+bool DocumentSourceInternalSetWindowFields::isReady(long long index) const {
+    if (_partitionExhausted) {
+        return true;
+    }
+
+    // The input is sorted, so once some document is past the end of a window, every document of
+    // the window has been read.
+    auto lastIndex = bufferEnd() - 1;
+    const auto& last = getBuffered(lastIndex);
+    for (auto&& field : _outputFields) {
+        if (!isAfterWindow(field, lastIndex, last.sortKey, index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Document DocumentSourceInternalSetWindowFields::outputNextDocument() {
+    auto index = _nextIndex++;
+    MutableDocument output(getBuffered(index).doc);
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        const auto& field = _outputFields[i];
+        auto& window = _windows[i];
+
+        if (window.hasTrailingBound) {
+            while (window.begin < window.end &&
+                   isBeforeWindow(field, window.begin, window.contents.front().sortKey, index)) {
+                auto& oldest = window.contents.front();
+                window.function->remove(oldest.input);
+                _memoryUsageBytes -= oldest.memUsageBytes;
+                window.contents.pop_front();
+                ++window.begin;
+            }
+
+            // An empty window may need to skip over documents that it never contained.
+            while (window.begin == window.end && window.end < bufferEnd() &&
+                   isBeforeWindow(field, window.end, getBuffered(window.end).sortKey, index)) {
+                ++window.begin;
+                ++window.end;
+            }
+        }
+
+        while (window.end < bufferEnd() &&
+               !isAfterWindow(field, window.end, getBuffered(window.end).sortKey, index)) {
+            const auto& buffered = getBuffered(window.end);
+            auto input = field.input->evaluate(buffered.doc, &pExpCtx->variables);
+            window.function->add(input);
+            if (window.hasTrailingBound) {
+                auto memUsageBytes =
+                    input.getApproximateSize() + buffered.sortKey.getApproximateSize();
+                _memoryUsageBytes += memUsageBytes;
+                window.contents.push_back({std::move(input), buffered.sortKey, memUsageBytes});
+            }
+            ++window.end;
+        }
+
+        output.setNestedField(field.path, window.function->getValue());
+    }
+
+    trimBuffer();
+    checkMemoryUsage();
+    return output.freeze();
+}
+
+bool DocumentSourceInternalSetWindowFields::isBeforeWindow(const OutputField& field,
+                                                           long long index,
+                                                           const Value& sortKey,
+                                                           long long current) const {
+    const auto& bounds = field.bounds;
+    if (bounds.type == WindowBounds::Type::kDocuments) {
+        return bounds.lower && index < current + bounds.lower->coerceToLong();
+    }
+
+    const auto& comparator = pExpCtx->getValueComparator();
+    if (_sortDirection > 0) {
+        return bounds.lower &&
+            comparator.evaluate(sortKey < offsetSortKey(field, current, *bounds.lower));
+    }
+    return bounds.upper &&
+        comparator.evaluate(sortKey > offsetSortKey(field, current, *bounds.upper));
+}
+
+bool DocumentSourceInternalSetWindowFields::isAfterWindow(const OutputField& field,
+                                                          long long index,
+                                                          const Value& sortKey,
+                                                          long long current) const {
+    const auto& bounds = field.bounds;
+    if (bounds.type == WindowBounds::Type::kDocuments) {
+        return bounds.upper && index > current + bounds.upper->coerceToLong();
+    }
+
+    const auto& comparator = pExpCtx->getValueComparator();
+    if (_sortDirection > 0) {
+        return bounds.upper &&
+            comparator.evaluate(sortKey > offsetSortKey(field, current, *bounds.upper));
+    }
+    return bounds.lower &&
+        comparator.evaluate(sortKey < offsetSortKey(field, current, *bounds.lower));
+}
+
+Value DocumentSourceInternalSetWindowFields::offsetSortKey(const OutputField& field,
+                                                           long long current,
+                                                           const Value& offset) const {
+    const auto& sortKey = getBuffered(current).sortKey;
+    if (sortKey.getType() != BSONType::Date) {
+        return addNumbers(sortKey, offset);
+    }
+
+    long long offsetMillis;
+    long long millis;
+    uassert(5157019,
+            str::stream() << "Date overflow computing the '" << kRangeName << "' window of "
+                          << sortKey.toString(),
+            !overflow::mul(offset.coerceToLong(), field.bounds.unitMillis, &offsetMillis) &&
+                !overflow::add(
+                    sortKey.getDate().toMillisSinceEpoch(), offsetMillis, &millis));
+    return Value(Date_t::fromMillisSinceEpoch(millis));
+}
+
+void DocumentSourceInternalSetWindowFields::trimBuffer() {
+    auto keepFrom = _nextIndex;
+    for (auto&& window : _windows) {
+        keepFrom = std::min(keepFrom, window.end);
+    }
+    while (_bufferBegin < keepFrom) {
+        _memoryUsageBytes -= _buffer.front().memUsageBytes;
+        _buffer.pop_front();
+        ++_bufferBegin;
+    }
+}
+
+void DocumentSourceInternalSetWindowFields::startNextPartition() {
+    invariant(_nextIndex == bufferEnd());
+    _buffer.clear();
+    _bufferBegin = 0;
+    _nextIndex = 0;
+    _memoryUsageBytes = 0;
+    for (auto&& window : _windows) {
+        window.function->reset();
+        window.contents.clear();
+        window.begin = 0;
+        window.end = 0;
+    }
+
+    _partitionExhausted = false;
+    auto doc = std::move(*_nextPartitionDoc);
+    _nextPartitionDoc = boost::none;
+    bufferDocument(std::move(doc));
+}
+
+void DocumentSourceInternalSetWindowFields::checkMemoryUsage() {
+    auto memUsageBytes = _memoryUsageBytes;
+    for (auto&& window : _windows) {
+        memUsageBytes += window.function->getApproximateSize();
+    }
+    uassert(5157018,
+            str::stream() << "Exceeded memory limit for "
+                          << DocumentSourceSetWindowFields::kStageName << ", used "
+                          << memUsageBytes << " bytes but the limit is " << _maxMemoryUsageBytes
+                          << " bytes. Bounding the windows limits the number of documents held "
+                             "in memory.",
+            memUsageBytes <= _maxMemoryUsageBytes);
+}
+
+void DocumentSourceInternalSetWindowFields::doDispose() {
+    _buffer.clear();
+    for (auto&& window : _windows) {
+        window.function->reset();
+        window.contents.clear();
+    }
+    _nextPartitionDoc = boost::none;
+    _memoryUsageBytes = 0;
+}
+
+}  // namespace mongo
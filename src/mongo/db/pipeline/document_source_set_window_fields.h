@@ -0,0 +1,294 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/window_function.h"
+
+namespace mongo {
+
+/**
+ * The $setWindowFields stage is an alias for a $sort on its 'partitionBy' and 'sortBy' fields
+ * followed by a $_internalSetWindowFields stage, which computes the window functions in a single
+ * streaming pass over the sorted documents.
+ */
+class DocumentSourceSetWindowFields final {
+public:
+    static constexpr StringData kStageName = "$setWindowFields"_sd;
+
+    /**
+     * Returns a $sort stage, unless there is nothing to sort by, followed by a
+     * $_internalSetWindowFields stage.
+     */
+    static std::list<boost::intrusive_ptr<DocumentSource>> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    // It is illegal to construct a DocumentSourceSetWindowFields directly, use createFromBson()
+    // instead.
+    DocumentSourceSetWindowFields() = default;
+};
+
+/**
+ * The bounds of a window, relative to the current document. For a 'documents' window the bounds
+ * are offsets in the sorted order of the partition. For a 'range' window they are offsets from
+ * the value of the single 'sortBy' field, in 'unit's if that value is a date.
+ */
+struct WindowBounds {
+    enum class Type {
+        kDocuments,
+        kRange,
+    };
+
+    Type type = Type::kDocuments;
+
+    // A missing bound means that the window extends to that end of the partition.
+    boost::optional<Value> lower;
+    boost::optional<Value> upper;
+
+    // Only set for 'range' windows over dates.
+    boost::optional<std::string> unit;
+    long long unitMillis = 1;
+};
+
+/**
+ * Streams over documents sorted by partition, adding to each document the output of window
+ * functions over a window of its neighbours. Only the documents that can still be in some window
+ * are buffered, so a window with bounded offsets holds a bounded number of documents no matter how
+ * large its partition is. Each window function is updated incrementally as the window slides.
+ */
+class DocumentSourceInternalSetWindowFields final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalSetWindowFields"_sd;
+
+    /**
+     * A single entry of the 'output' specification.
+     */
+    struct OutputField {
+        FieldPath path;
+        std::string opName;
+        boost::intrusive_ptr<Expression> input;
+        WindowBounds bounds;
+    };
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    static boost::intrusive_ptr<DocumentSourceInternalSetWindowFields> create(
+        const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+        boost::optional<FieldPath> partitionBy,
+        BSONObj sortBy,
+        std::vector<OutputField> outputFields);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed,
+                UnionRequirement::kAllowed};
+    }
+
+    /**
+     * A partition may span several shards, so the windows must be computed on the merger.
+     */
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        // {shardsStage, mergingStage, sortPattern}
+        return DistributedPlanLogic{nullptr, this, boost::none};
+    }
+
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+
+    GetModPathsReturn getModifiedPaths() const final;
+
+    boost::intrusive_ptr<DocumentSource> optimize() final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    const boost::optional<FieldPath>& getPartitionBy() const {
+        return _partitionBy;
+    }
+
+    const BSONObj& getSortBy() const {
+        return _sortBy;
+    }
+
+private:
+    /**
+     * A document of the current partition, along with its 'sortBy' value if some window is a
+     * 'range' window.
+     */
+    struct BufferedDocument {
+        Document doc;
+        Value sortKey;
+        size_t memUsageBytes;
+    };
+
+    /**
+     * The input value and sort key of a document that has been added to a window.
+     */
+    struct WindowValue {
+        Value input;
+        Value sortKey;
+        size_t memUsageBytes;
+    };
+
+    /**
+     * The window of an output field, as the half-open range [begin, end) of partition indexes of
+     * the documents that have been added to it.
+     */
+    struct Window {
+        std::unique_ptr<WindowFunctionState> function;
+
+        // Whether documents can leave the window as it slides. If not, nothing is ever removed
+        // from 'function' and 'contents' stays empty.
+        bool hasTrailingBound = false;
+
+        // The documents in the window, oldest first.
+        std::deque<WindowValue> contents;
+
+        long long begin = 0;
+        long long end = 0;
+    };
+
+    DocumentSourceInternalSetWindowFields(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+                                          boost::optional<FieldPath> partitionBy,
+                                          BSONObj sortBy,
+                                          std::vector<OutputField> outputFields);
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Adds 'doc' to the end of the current partition.
+     */
+    void bufferDocument(Document doc);
+
+    /**
+     * Returns whether the document at 'index' in the partition can be output, which is once every
+     * document that may be in one of its windows has been read.
+     */
+    bool isReady(long long index) const;
+
+    /**
+     * Slides the window of each output field to the document at '_nextIndex' and returns that
+     * document with the results added.
+     */
+    Document outputNextDocument();
+
+    /**
+     * Returns whether the document at 'index', whose sort key is 'sortKey', sorts before the
+     * window of 'field' for the document at 'current'.
+     */
+    bool isBeforeWindow(const OutputField& field,
+                        long long index,
+                        const Value& sortKey,
+                        long long current) const;
+
+    /**
+     * Returns whether the document at 'index', whose sort key is 'sortKey', sorts after the window
+     * of 'field' for the document at 'current'.
+     */
+    bool isAfterWindow(const OutputField& field,
+                       long long index,
+                       const Value& sortKey,
+                       long long current) const;
+
+    /**
+     * Returns the sort key of the document at 'current' offset by 'offset', in the units of
+     * 'field'.
+     */
+    Value offsetSortKey(const OutputField& field, long long current, const Value& offset) const;
+
+    const BufferedDocument& getBuffered(long long index) const {
+        return _buffer[index - _bufferBegin];
+    }
+
+    long long bufferEnd() const {
+        return _bufferBegin + static_cast<long long>(_buffer.size());
+    }
+
+    /**
+     * Drops the documents that have been output and are not needed by any window anymore.
+     */
+    void trimBuffer();
+
+    /**
+     * Starts a new partition, beginning with '_nextPartitionDoc'.
+     */
+    void startNextPartition();
+
+    void checkMemoryUsage();
+
+    const boost::optional<FieldPath> _partitionBy;
+    boost::intrusive_ptr<Expression> _partitionByExpr;
+    const BSONObj _sortBy;
+    boost::intrusive_ptr<Expression> _sortKeyExpr;
+    int _sortDirection = 1;
+    std::vector<OutputField> _outputFields;
+
+    // True if some output field uses a 'range' window, so the sort key of each document is needed.
+    bool _needsSortKeys = false;
+
+    std::vector<Window> _windows;
+
+    // The documents of the current partition that may still be output or added to a window, the
+    // first of which is at partition index '_bufferBegin'.
+    std::deque<BufferedDocument> _buffer;
+    long long _bufferBegin = 0;
+
+    // The partition index of the next document to output.
+    long long _nextIndex = 0;
+
+    boost::optional<Value> _partitionKey;
+
+    // Set once every document of the current partition has been read. '_nextPartitionDoc' is the
+    // first document of the next partition, if there is one.
+    bool _partitionExhausted = false;
+    boost::optional<Document> _nextPartitionDoc;
+
+    size_t _memoryUsageBytes = 0;
+    size_t _maxMemoryUsageBytes;
+};
+
+}  // namespace mongo
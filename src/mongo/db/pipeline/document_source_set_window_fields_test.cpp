@@ -0,0 +1,261 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <deque>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+using boost::intrusive_ptr;
+using std::vector;
+
+class SetWindowFieldsTest : public AggregationContextFixture {
+public:
+    /**
+     * Runs a $_internalSetWindowFields stage with specification 'spec' over 'inputs', which must
+     * already be sorted, and returns its output.
+     */
+    vector<Document> runWindowFields(const char* spec,
+                                     std::deque<DocumentSource::GetNextResult> inputs) {
+        auto specObj = BSON(DocumentSourceInternalSetWindowFields::kStageName << fromjson(spec));
+        auto stage = DocumentSourceInternalSetWindowFields::createFromBson(specObj.firstElement(),
+                                                                           getExpCtx());
+        auto source = DocumentSourceMock::createForTest(std::move(inputs), getExpCtx());
+        stage->setSource(source.get());
+
+        vector<Document> results;
+        for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
+            results.push_back(next.releaseDocument());
+        }
+        ASSERT_TRUE(stage->getNext().isEOF());
+        return results;
+    }
+
+    void assertParseFails(const char* spec, int code) {
+        auto specObj = BSON(DocumentSourceSetWindowFields::kStageName << fromjson(spec));
+        ASSERT_THROWS_CODE(
+            DocumentSourceSetWindowFields::createFromBson(specObj.firstElement(), getExpCtx()),
+            AssertionException,
+            code);
+    }
+};
+
+TEST_F(SetWindowFieldsTest, RunningSumRestartsForEachPartition) {
+    auto results = runWindowFields(
+        "{partitionBy: '$p', sortBy: {t: 1}, output: {total: {$sum: '$x', window: {documents: "
+        "['unbounded', 'current']}}}}",
+        {Document{{"p", 1}, {"t", 1}, {"x", 1}},
+         Document{{"p", 1}, {"t", 2}, {"x", 2}},
+         Document{{"p", 1}, {"t", 3}, {"x", 3}},
+         Document{{"p", 2}, {"t", 1}, {"x", 10}},
+         Document{{"p", 2}, {"t", 2}, {"x", 20}}});
+
+    ASSERT_EQ(results.size(), 5UL);
+    vector<int> expectedTotals{1, 3, 6, 10, 30};
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i]["total"], Value(expectedTotals[i]));
+    }
+    ASSERT_VALUE_EQ(results[3]["p"], Value(2));
+}
+
+TEST_F(SetWindowFieldsTest, SlidingDocumentWindowsIncludeFollowingDocuments) {
+    auto results = runWindowFields(
+        "{sortBy: {t: 1}, output: {"
+        "  sum: {$sum: '$x', window: {documents: [-1, 1]}},"
+        "  min: {$min: '$x', window: {documents: [-1, 1]}},"
+        "  max: {$max: '$x', window: {documents: [-1, 1]}},"
+        "  next: {$sum: '$x', window: {documents: [1, 1]}}}}",
+        {Document{{"t", 1}, {"x", 5}},
+         Document{{"t", 2}, {"x", 3}},
+         Document{{"t", 3}, {"x", 4}},
+         Document{{"t", 4}, {"x", 1}},
+         Document{{"t", 5}, {"x", 2}}});
+
+    ASSERT_EQ(results.size(), 5UL);
+    vector<int> expectedSums{8, 12, 8, 7, 3};
+    vector<int> expectedMins{3, 3, 1, 1, 1};
+    vector<int> expectedMaxes{5, 5, 4, 4, 2};
+    vector<int> expectedNext{3, 4, 1, 2, 0};
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i]["sum"], Value(expectedSums[i]));
+        ASSERT_VALUE_EQ(results[i]["min"], Value(expectedMins[i]));
+        ASSERT_VALUE_EQ(results[i]["max"], Value(expectedMaxes[i]));
+        ASSERT_VALUE_EQ(results[i]["next"], Value(expectedNext[i]));
+    }
+}
+
+TEST_F(SetWindowFieldsTest, RangeWindowOverDatesUsesUnit) {
+    auto minutes = [](long long n) { return Date_t::fromMillisSinceEpoch(n * 60 * 1000); };
+    auto results = runWindowFields(
+        "{sortBy: {t: 1}, output: {avg: {$avg: '$price', window: {range: [-5, 'current'], unit: "
+        "'minute'}}}}",
+        {Document{{"t", minutes(0)}, {"price", 10}},
+         Document{{"t", minutes(2)}, {"price", 20}},
+         Document{{"t", minutes(6)}, {"price", 30}},
+         Document{{"t", minutes(11)}, {"price", 40}}});
+
+    ASSERT_EQ(results.size(), 4UL);
+    vector<double> expectedAverages{10, 15, 25, 35};
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i]["avg"], Value(expectedAverages[i]));
+    }
+}
+
+TEST_F(SetWindowFieldsTest, RangeWindowOverDescendingSort) {
+    // With a descending sort, the documents within 2 less than the current one come after it.
+    auto results = runWindowFields(
+        "{sortBy: {t: -1}, output: {sum: {$sum: '$x', window: {range: [-2, 0]}}}}",
+        {Document{{"t", 10}, {"x", 1}},
+         Document{{"t", 9}, {"x", 2}},
+         Document{{"t", 7}, {"x", 3}},
+         Document{{"t", 4}, {"x", 4}}});
+
+    ASSERT_EQ(results.size(), 4UL);
+    vector<int> expectedSums{3, 5, 3, 4};
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_VALUE_EQ(results[i]["sum"], Value(expectedSums[i]));
+    }
+}
+
+TEST_F(SetWindowFieldsTest, SumOfDoublesIsUnaffectedByValuesThatLeftTheWindow) {
+    auto results = runWindowFields(
+        "{sortBy: {t: 1}, output: {sum: {$sum: '$x', window: {documents: [0, 1]}}}}",
+        {Document{{"t", 1}, {"x", std::numeric_limits<double>::infinity()}},
+         Document{{"t", 2}, {"x", 1.5}},
+         Document{{"t", 3}, {"x", 2}}});
+
+    ASSERT_EQ(results.size(), 3UL);
+    ASSERT_VALUE_EQ(results[0]["sum"], Value(std::numeric_limits<double>::infinity()));
+    ASSERT_VALUE_EQ(results[1]["sum"], Value(3.5));
+    ASSERT_VALUE_EQ(results[2]["sum"], Value(2));
+}
+
+TEST_F(SetWindowFieldsTest, DesugarsToSortAndInternalStage) {
+    auto spec = fromjson(
+        "{$setWindowFields: {partitionBy: '$p', sortBy: {t: -1}, output: {total: {$sum: '$x', "
+        "window: {documents: ['unbounded', 0]}}}}}");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT_EQ(stages.size(), 2UL);
+
+    auto sortStage = dynamic_cast<DocumentSourceSort*>(stages.front().get());
+    ASSERT(sortStage);
+    ASSERT_DOCUMENT_EQ(sortStage->getSortKeyPattern().serialize(
+                           SortPattern::SortKeySerialization::kForPipelineSerialization),
+                       Document(fromjson("{p: 1, t: -1}")));
+
+    auto windowStage = dynamic_cast<DocumentSourceInternalSetWindowFields*>(stages.back().get());
+    ASSERT(windowStage);
+    vector<Value> serialized;
+    windowStage->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1UL);
+    ASSERT_VALUE_EQ(
+        serialized[0],
+        Value(fromjson("{$_internalSetWindowFields: {partitionBy: '$p', sortBy: {t: -1}, output: "
+                       "{total: {$sum: '$x', window: {documents: ['unbounded', 0]}}}}}")));
+
+    // The serialized stage parses back to the same stage.
+    auto reparsed = DocumentSourceInternalSetWindowFields::createFromBson(
+        serialized[0].getDocument().toBson().firstElement(), getExpCtx());
+    vector<Value> reserialized;
+    reparsed->serializeToArray(reserialized);
+    ASSERT_VALUE_EQ(reserialized[0], serialized[0]);
+}
+
+TEST_F(SetWindowFieldsTest, NoSortIsAddedWithoutPartitionOrSortBy) {
+    auto spec = fromjson("{$setWindowFields: {output: {total: {$sum: '$x'}}}}");
+    auto stages = DocumentSourceSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    ASSERT_EQ(stages.size(), 1UL);
+    ASSERT(dynamic_cast<DocumentSourceInternalSetWindowFields*>(stages.front().get()));
+}
+
+TEST_F(SetWindowFieldsTest, RejectsInvalidSpecifications) {
+    assertParseFails("{partitionBy: 'p', output: {a: {$sum: '$x'}}}", 5157002);
+    assertParseFails("{sortBy: {t: 1}}", 5157004);
+    assertParseFails("{output: {a: {$sum: '$x', $max: '$x'}}}", 5157006);
+    assertParseFails("{output: {a: {$push: '$x'}}}", 5157007);
+    assertParseFails("{output: {a: {$sum: '$x', window: {range: [-1, 0]}}}}", 5157011);
+    assertParseFails("{output: {a: {$sum: '$x', window: {documents: [-1.5, 0]}}}}", 5157014);
+    assertParseFails("{output: {a: {$sum: '$x', window: {documents: [1, -1]}}}}", 5157015);
+    assertParseFails(
+        "{sortBy: {t: 1}, output: {a: {$sum: '$x', window: {range: [-1, 0], unit: 'year'}}}}",
+        5157013);
+}
+
+TEST_F(SetWindowFieldsTest, FailsWhenAnUnboundedWindowExceedsTheMemoryLimit) {
+    auto originalMaxMemoryBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(10 * 1024);
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(originalMaxMemoryBytes);
+    });
+
+    std::deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.emplace_back(Document{{"t", i}, {"x", i}});
+    }
+    ASSERT_THROWS_CODE(
+        runWindowFields("{sortBy: {t: 1}, output: {total: {$sum: '$x'}}}", std::move(inputs)),
+        AssertionException,
+        5157018);
+
+    // A bounded window over the same documents stays within the limit.
+    inputs.clear();
+    for (int i = 0; i < 1000; ++i) {
+        inputs.emplace_back(Document{{"t", i}, {"x", i}});
+    }
+    auto results = runWindowFields(
+        "{sortBy: {t: 1}, output: {total: {$sum: '$x', window: {documents: [-1, 0]}}}}",
+        std::move(inputs));
+    ASSERT_EQ(results.size(), 1000UL);
+    ASSERT_VALUE_EQ(results[999]["total"], Value(1997));
+}
+
+TEST_F(SetWindowFieldsTest, FailsOnArrayPartitionKey) {
+    ASSERT_THROWS_CODE(runWindowFields("{partitionBy: '$p', output: {total: {$sum: '$x'}}}",
+                                       {Document{{"p", vector<Value>{Value(1), Value(2)}}}}),
+                       AssertionException,
+                       5157016);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -34,11 +34,13 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/scripting/engine.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -274,5 +276,49 @@ TEST_F(MapReduceFixture, ExpressionInternalJsErrorsIfProducesTooManyDocumentsFor
     ASSERT_THROWS_CODE(
         expr->evaluate(Document{BSON("val" << 1)}, getVariables()), AssertionException, 31292);
 }
+
+TEST_F(MapReduceFixture, JsExecutionReusesThreadScopeAcrossOperations) {
+    // The fixture's expression context holds an operation on the test client, so run these
+    // operations on another client.
+    auto client = getServiceContext()->makeClient("jsExecutionScopeReuse");
+    AlternativeClientRegion acr(client);
+
+    auto getExec = [](OperationContext* opCtx, StringData database) {
+        return JsExecution::get(opCtx, BSONObj(), database, false, boost::none);
+    };
+    ScriptingFunction func;
+    {
+        auto opCtx = cc().makeOperationContext();
+        auto exec = getExec(opCtx.get(), "test");
+        exec->getScope()->setNumber("reuseMarker", 1);
+        func = exec->createFunction("function() { return reuseMarker; }");
+    }
+
+    // An operation on the same database gets the same scope back, with its compiled functions.
+    {
+        auto opCtx = cc().makeOperationContext();
+        auto exec = getExec(opCtx.get(), "test");
+        ASSERT_EQ(NumberDouble, exec->getScope()->type("reuseMarker"));
+        ASSERT_EQ(func, exec->createFunction("function() { return reuseMarker; }"));
+        ASSERT_VALUE_EQ(Value(1.0), exec->callFunction(func, BSONObj(), BSONObj()));
+    }
+
+    // An operation on another database gets a new scope.
+    {
+        auto opCtx = cc().makeOperationContext();
+        auto exec = getExec(opCtx.get(), "other");
+        ASSERT_EQ(Undefined, exec->getScope()->type("reuseMarker"));
+    }
+
+    // As does every operation when reuse is disabled.
+    internalQueryJavaScriptReuseThreadScopes.store(false);
+    ON_BLOCK_EXIT([] { internalQueryJavaScriptReuseThreadScopes.store(true); });
+    for (int i = 0; i < 2; ++i) {
+        auto opCtx = cc().makeOperationContext();
+        auto exec = getExec(opCtx.get(), "other");
+        ASSERT_EQ(Undefined, exec->getScope()->type("reuseMarker"));
+        exec->getScope()->setNumber("reuseMarker", 1);
+    }
+}
 }  // namespace
 }  // namespace mongo
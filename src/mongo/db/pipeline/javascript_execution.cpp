@@ -34,12 +34,38 @@
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+/**
+ * Builds the key under which a thread keeps the scope of an operation for reuse. A scope may only
+ * be reused by an operation on the same database, with the same scope variables, stored procedure
+ * and heap limit settings, and the same authenticated users, since globals set by one user's
+ * functions must not be visible to another's.
+ */
+std::string makeScopePoolKey(OperationContext* opCtx,
+                             const BSONObj& scopeVars,
+                             StringData database,
+                             bool loadStoredProcedures,
+                             boost::optional<int> jsHeapLimitMB) {
+    StringBuilder sb;
+
+    // Using a NUL byte, which isn't valid in database or user names, to separate the parts.
+    sb << database << '\0' << loadStoredProcedures << '\0' << jsHeapLimitMB.value_or(-1) << '\0';
+    if (auto as = AuthorizationSession::get(opCtx->getClient())) {
+        for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+            sb << nameIter->getUnambiguousName() << '\0';
+        }
+    }
+    sb << StringData(scopeVars.objdata(), scopeVars.objsize());
+
+    return sb.str();
+}
 }  // namespace
 
 JsExecution* JsExecution::get(OperationContext* opCtx,
@@ -49,7 +75,21 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        if (!internalQueryJavaScriptReuseThreadScopes.load()) {
+            exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        } else {
+            // Reuse the scope of this thread's previous operation, and the functions compiled in
+            // it, if it was kept under the same key.
+            auto poolKey =
+                makeScopePoolKey(opCtx, scope, database, loadStoredProcedures, jsHeapLimitMB);
+            auto engine = getGlobalScriptEngine();
+            auto pooled = engine->tryAcquireScopeForCurrentThread(poolKey);
+            if (!pooled) {
+                pooled.reset(engine->newScopeForCurrentThread(jsHeapLimitMB));
+            }
+            exec = std::make_unique<JsExecution>(opCtx, scope, std::move(pooled));
+            exec->_poolKey = std::move(poolKey);
+        }
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -63,6 +103,17 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
     return exec.get();
 }
 
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+
+    // A scope with 'emit' injected holds a pointer to this operation's emit state, and a scope may
+    // only be run by the thread which created it.
+    auto engine = getGlobalScriptEngine();
+    if (engine && _poolKey && !_emitCreated && _threadId == stdx::this_thread::get_id()) {
+        engine->releaseScopeForCurrentThread(std::move(*_poolKey), std::move(_scope));
+    }
+}
+
 Value JsExecution::callFunction(ScriptingFunction func,
                                 const BSONObj& params,
                                 const BSONObj& thisObj) {
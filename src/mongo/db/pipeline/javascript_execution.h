@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -64,16 +65,28 @@ public:
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
                 boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
+        : JsExecution(opCtx,
+                      scopeVars,
+                      std::unique_ptr<Scope>(
+                          getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB))) {}
+
+    /**
+     * Construct with 'scope', a thread-local scope which is not registered with any operation, and
+     * initialize it with the given scope variables.
+     */
+    JsExecution(OperationContext* opCtx, const BSONObj& scopeVars, std::unique_ptr<Scope> scope)
+        : _scope(std::move(scope)) {
         _scopeVars = scopeVars.getOwned();
         _scope->init(&_scopeVars);
         _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
         _scope->registerOperation(opCtx);
     }
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    /**
+     * Hands the scope back to the thread for reuse if it was obtained through get(), or destroys
+     * it otherwise.
+     */
+    ~JsExecution();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -122,6 +135,11 @@ private:
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
 
+    // Identifies the scopes this instance's scope may be shared with, and the thread it runs on,
+    // when it is to be kept for reuse by the thread's next operation.
+    boost::optional<std::string> _poolKey;
+    stdx::thread::id _threadId = stdx::this_thread::get_id();
+
     Value doCallFunction(ScriptingFunction func,
                          const BSONObj& params,
                          const BSONObj& thisObj,
@@ -71,6 +71,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -555,6 +556,12 @@ PipelineD::buildInnerQueryExecutorGeneric(Collection* collection,
                                                 Pipeline::kAllowedMatcherFeatures,
                                                 &shouldProduceEmptyDocs));
 
+    // A $sort pushed down into the query layer still orders the input of a $group that followed
+    // it, unless the $group was replaced by a DISTINCT_SCAN.
+    if (sortStage && groupStage && pipeline->peekFront() == groupStage.get()) {
+        groupStage->setInputSortPattern(sortStage->getSortKeyPattern());
+    }
+
     const auto cursorType = shouldProduceEmptyDocs
         ? DocumentSourceCursor::CursorType::kEmptyDocuments
         : DocumentSourceCursor::CursorType::kRegular;
@@ -691,6 +698,13 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         // projection at the front of the pipeline, it will be removed and handled by the PlanStage
         // layer. If a projection cannot be pushed down, an empty BSONObj will be returned.
         projObj = buildProjectionForPushdown(deps, pipeline);
+
+        // A $group which only reads indexed fields can be computed from the keys of a whole index
+        // scan instead of from the documents, even when no predicate or sort selects the index.
+        if (!projObj.isEmpty() && dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront()) &&
+            internalQueryPlannerGenerateCoveredWholeIndexScansForGroup.load()) {
+            plannerOpts |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+        }
     }
 
     if (rewrittenGroupStage) {
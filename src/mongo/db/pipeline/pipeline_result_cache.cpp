@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/pipeline_result_cache.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getPipelineResultCache = ServiceContext::declareDecoration<PipelineResultCache>();
+
+Counter64 pipelineResultCacheHits;
+Counter64 pipelineResultCacheMisses;
+Counter64 pipelineResultCacheStalenessMillis;
+
+ServerStatusMetricField<Counter64> pipelineResultCacheHitsMetric(
+    "query.pipelineResultCache.hits", &pipelineResultCacheHits);
+ServerStatusMetricField<Counter64> pipelineResultCacheMissesMetric(
+    "query.pipelineResultCache.misses", &pipelineResultCacheMisses);
+ServerStatusMetricField<Counter64> pipelineResultCacheStalenessMillisMetric(
+    "query.pipelineResultCache.stalenessMillis", &pipelineResultCacheStalenessMillis);
+
+}  // namespace
+
+PipelineResultCache& PipelineResultCache::get(ServiceContext* service) {
+    return getPipelineResultCache(service);
+}
+
+std::string PipelineResultCache::makeKey(const NamespaceString& nss,
+                                         const boost::optional<UUID>& uuid,
+                                         const std::vector<BSONObj>& pipeline,
+                                         const BSONObj& collation,
+                                         boost::optional<uint64_t> writeVersion) {
+    BSONObjBuilder bob;
+    bob.append("ns", nss.ns());
+    if (uuid) {
+        uuid->appendToBuilder(&bob, "uuid");
+    }
+    bob.append("pipeline", pipeline);
+    bob.append("collation", collation);
+    if (writeVersion) {
+        bob.append("writeVersion", static_cast<long long>(*writeVersion));
+    }
+    auto key = bob.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+std::shared_ptr<const PipelineResultCache::Entry> PipelineResultCache::lookup(
+    StringData key, Date_t now, Milliseconds maxStaleness) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto indexIt = _index.find(key);
+    if (indexIt == _index.end()) {
+        pipelineResultCacheMisses.increment();
+        return nullptr;
+    }
+
+    auto listIt = indexIt->second;
+    const auto staleness = now - listIt->second->computedAt;
+    if (staleness > maxStaleness) {
+        _erase(lk, listIt);
+        pipelineResultCacheMisses.increment();
+        return nullptr;
+    }
+
+    // Move the entry to the front of the list to mark it as most recently used.
+    _entries.splice(_entries.begin(), _entries, listIt);
+    pipelineResultCacheHits.increment();
+    pipelineResultCacheStalenessMillis.increment(
+        durationCount<Milliseconds>(std::max(staleness, Milliseconds(0))));
+    return listIt->second;
+}
+
+void PipelineResultCache::insert(StringData key,
+                                 std::shared_ptr<const Entry> entry,
+                                 size_t maxSizeBytes) {
+    invariant(entry);
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (auto indexIt = _index.find(key); indexIt != _index.end()) {
+        _erase(lk, indexIt->second);
+    }
+    if (entry->sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    _sizeBytes += entry->sizeBytes;
+    _entries.emplace_front(key.toString(), std::move(entry));
+    _index[key] = _entries.begin();
+
+    while (_sizeBytes > maxSizeBytes) {
+        _erase(lk, std::prev(_entries.end()));
+    }
+}
+
+void PipelineResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _index.clear();
+    _entries.clear();
+    _sizeBytes = 0;
+}
+
+size_t PipelineResultCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+size_t PipelineResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void PipelineResultCache::_erase(WithLock, EntryList::iterator it) {
+    _sizeBytes -= it->second->sizeBytes;
+    _index.erase(it->first);
+    _entries.erase(it);
+}
+
+}  // namespace mongo
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * A process-wide cache of the fully materialized results of pipelines run against a collection.
+ * Each entry records the time at which it was computed, and is only served to readers that are
+ * willing to tolerate at least that much staleness. Readers which cannot tolerate any staleness
+ * include the collection's write version in the key instead, so that a write to the collection
+ * makes existing entries unreachable. The cache is bounded by the approximate size of the documents
+ * it holds, evicting the least recently used entries first.
+ *
+ * This class is thread-safe.
+ */
+class PipelineResultCache {
+public:
+    struct Entry {
+        std::vector<Document> results;
+        Date_t computedAt;
+        size_t sizeBytes = 0;
+    };
+
+    static PipelineResultCache& get(ServiceContext* service);
+
+    /**
+     * Builds the cache key identifying the results of running 'pipeline' against the collection
+     * with namespace 'nss' and the given 'uuid' under 'collation'. Recreating the collection
+     * changes its UUID, so entries computed against a dropped collection are never served. If
+     * 'writeVersion' is set, the key only matches results computed at that collection version.
+     */
+    static std::string makeKey(const NamespaceString& nss,
+                               const boost::optional<UUID>& uuid,
+                               const std::vector<BSONObj>& pipeline,
+                               const BSONObj& collation,
+                               boost::optional<uint64_t> writeVersion = boost::none);
+
+    /**
+     * Returns the entry for 'key' if one exists which was computed no more than 'maxStaleness'
+     * before 'now'. An entry that is too stale is removed from the cache.
+     */
+    std::shared_ptr<const Entry> lookup(StringData key, Date_t now, Milliseconds maxStaleness);
+
+    /**
+     * Adds 'entry' under 'key', replacing any existing entry, and then evicts the least recently
+     * used entries until the cache holds no more than 'maxSizeBytes'. An entry that could never
+     * fit is not cached.
+     */
+    void insert(StringData key, std::shared_ptr<const Entry> entry, size_t maxSizeBytes);
+
+    void clear();
+
+    size_t size() const;
+
+    size_t getSizeBytes() const;
+
+private:
+    using KeyAndEntry = std::pair<std::string, std::shared_ptr<const Entry>>;
+    using EntryList = std::list<KeyAndEntry>;
+
+    void _erase(WithLock, EntryList::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PipelineResultCache::_mutex");
+
+    // Entries in most recently used order, with an index from key into the list.
+    EntryList _entries;
+    StringMap<EntryList::iterator> _index;
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace mongo
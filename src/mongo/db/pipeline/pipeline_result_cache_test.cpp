@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/pipeline_result_cache.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_pipeline_result_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kTestNss("test.coll");
+
+std::shared_ptr<const PipelineResultCache::Entry> makeEntry(std::vector<Document> results,
+                                                            Date_t computedAt) {
+    auto entry = std::make_shared<PipelineResultCache::Entry>();
+    for (auto&& doc : results) {
+        entry->sizeBytes += doc.getApproximateSize();
+    }
+    entry->results = std::move(results);
+    entry->computedAt = computedAt;
+    return entry;
+}
+
+TEST(PipelineResultCacheTest, KeyDistinguishesCollectionPipelineAndCollation) {
+    const std::vector<BSONObj> pipeline{BSON("$match" << BSON("a" << 1))};
+    const auto uuid = UUID::gen();
+    const auto key = PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj());
+
+    ASSERT_EQ(key, PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj()));
+    ASSERT_NE(key, PipelineResultCache::makeKey(kTestNss, UUID::gen(), pipeline, BSONObj()));
+    ASSERT_NE(key,
+              PipelineResultCache::makeKey(NamespaceString("test.other"), uuid, pipeline, {}));
+    ASSERT_NE(key, PipelineResultCache::makeKey(kTestNss, uuid, {}, BSONObj()));
+    ASSERT_NE(key,
+              PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSON("locale"
+                                                                          << "fr")));
+}
+
+TEST(PipelineResultCacheTest, LookupReturnsEntryWithinStalenessBound) {
+    PipelineResultCache cache;
+    const auto computedAt = Date_t::fromMillisSinceEpoch(1000);
+    cache.insert("key", makeEntry({Document{{"a", 1}}}, computedAt), 1024 * 1024);
+
+    auto entry = cache.lookup("key", computedAt + Milliseconds(50), Milliseconds(100));
+    ASSERT(entry);
+    ASSERT_EQ(entry->results.size(), 1U);
+    ASSERT_DOCUMENT_EQ(entry->results[0], (Document{{"a", 1}}));
+
+    ASSERT_FALSE(cache.lookup("otherKey", computedAt, Milliseconds(100)));
+}
+
+TEST(PipelineResultCacheTest, LookupDropsStaleEntry) {
+    PipelineResultCache cache;
+    const auto computedAt = Date_t::fromMillisSinceEpoch(1000);
+    cache.insert("key", makeEntry({Document{{"a", 1}}}, computedAt), 1024 * 1024);
+    ASSERT_EQ(cache.size(), 1U);
+
+    ASSERT_FALSE(cache.lookup("key", computedAt + Milliseconds(101), Milliseconds(100)));
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_EQ(cache.getSizeBytes(), 0U);
+}
+
+TEST(PipelineResultCacheTest, InsertEvictsLeastRecentlyUsedEntries) {
+    PipelineResultCache cache;
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    auto entry = makeEntry({Document{{"a", 1}}}, now);
+    const size_t maxSizeBytes = 2 * entry->sizeBytes;
+
+    cache.insert("first", entry, maxSizeBytes);
+    cache.insert("second", makeEntry({Document{{"a", 2}}}, now), maxSizeBytes);
+
+    // Using 'first' makes 'second' the least recently used entry.
+    ASSERT(cache.lookup("first", now, Milliseconds(100)));
+    cache.insert("third", makeEntry({Document{{"a", 3}}}, now), maxSizeBytes);
+
+    ASSERT_EQ(cache.size(), 2U);
+    ASSERT_LTE(cache.getSizeBytes(), maxSizeBytes);
+    ASSERT(cache.lookup("first", now, Milliseconds(100)));
+    ASSERT_FALSE(cache.lookup("second", now, Milliseconds(100)));
+    ASSERT(cache.lookup("third", now, Milliseconds(100)));
+}
+
+TEST(PipelineResultCacheTest, InsertSkipsEntryLargerThanCache) {
+    PipelineResultCache cache;
+    const auto now = Date_t::fromMillisSinceEpoch(1000);
+    auto entry = makeEntry({Document{{"a", 1}}}, now);
+
+    cache.insert("key", entry, entry->sizeBytes - 1);
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_EQ(cache.getSizeBytes(), 0U);
+}
+
+TEST(PipelineResultCacheTest, InsertReplacesExistingEntry) {
+    PipelineResultCache cache;
+    auto older = makeEntry({Document{{"a", 1}}}, Date_t::fromMillisSinceEpoch(1000));
+    auto newer = makeEntry({Document{{"a", 2}}}, Date_t::fromMillisSinceEpoch(2000));
+
+    cache.insert("key", older, 1024 * 1024);
+    cache.insert("key", newer, 1024 * 1024);
+    ASSERT_EQ(cache.size(), 1U);
+    ASSERT_EQ(cache.getSizeBytes(), newer->sizeBytes);
+    ASSERT_TRUE(cache.lookup("key", Date_t::fromMillisSinceEpoch(2000), Milliseconds(0)) ==
+                newer);
+}
+
+TEST(PipelineResultCacheTest, KeyDistinguishesWriteVersions) {
+    const std::vector<BSONObj> pipeline{BSON("$match" << BSON("a" << 1))};
+    const auto uuid = UUID::gen();
+    const auto key = PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj(), 1);
+
+    ASSERT_EQ(key, PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj(), 1));
+    ASSERT_NE(key, PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj(), 2));
+    ASSERT_NE(key, PipelineResultCache::makeKey(kTestNss, uuid, pipeline, BSONObj()));
+}
+
+using DocumentSourcePipelineResultCacheTest = AggregationContextFixture;
+
+TEST_F(DocumentSourcePipelineResultCacheTest, SerializesOriginalSpecification) {
+    auto spec = DocumentSourcePipelineResultCache::makeSpec({BSON("$match" << BSON("a" << 1))});
+    auto stage =
+        DocumentSourcePipelineResultCache::createFromBson(spec.firstElement(), getExpCtx());
+
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1U);
+    ASSERT_VALUE_EQ(serialized[0], Value(spec));
+}
+
+TEST_F(DocumentSourcePipelineResultCacheTest, ReportsWriteVersionOnlyForExplain) {
+    const std::vector<BSONObj> pipeline{BSON("$match" << BSON("a" << 1))};
+    auto stage = DocumentSourcePipelineResultCache::create(getExpCtx(), pipeline, 7);
+
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_VALUE_EQ(serialized[0], Value(DocumentSourcePipelineResultCache::makeSpec(pipeline)));
+
+    serialized.clear();
+    stage->serializeToArray(serialized, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_VALUE_EQ(serialized[0],
+                    Value(BSON("$_internalPipelineResultCache"
+                               << BSON("pipeline" << pipeline << "writeVersion" << 7LL))));
+}
+
+TEST_F(DocumentSourcePipelineResultCacheTest, RejectsPipelineInvolvingOtherNamespaces) {
+    auto spec = DocumentSourcePipelineResultCache::makeSpec({BSON(
+        "$lookup" << BSON("from"
+                          << "other"
+                          << "localField"
+                          << "a"
+                          << "foreignField"
+                          << "b"
+                          << "as"
+                          << "c"))});
+    ASSERT_THROWS_CODE(
+        DocumentSourcePipelineResultCache::createFromBson(spec.firstElement(), getExpCtx()),
+        AssertionException,
+        5159006);
+}
+
+TEST_F(DocumentSourcePipelineResultCacheTest, RejectsInvalidSpecifications) {
+    auto parse = [&](BSONObj spec) {
+        return DocumentSourcePipelineResultCache::createFromBson(spec.firstElement(), getExpCtx());
+    };
+    ASSERT_THROWS_CODE(
+        parse(BSON("$_internalPipelineResultCache" << 1)), AssertionException, 5159000);
+    ASSERT_THROWS_CODE(parse(BSON("$_internalPipelineResultCache" << BSON("pipeline" << 1))),
+                       AssertionException,
+                       5159002);
+    ASSERT_THROWS_CODE(
+        parse(BSON("$_internalPipelineResultCache" << BSON("pipeline" << BSON_ARRAY(1)))),
+        AssertionException,
+        5159003);
+    ASSERT_THROWS_CODE(parse(BSON("$_internalPipelineResultCache"
+                                  << BSON("pipeline" << BSONArray() << "writeVersion" << 1))),
+                       AssertionException,
+                       5159004);
+    ASSERT_THROWS_CODE(
+        parse(BSON("$_internalPipelineResultCache" << BSONObj())), AssertionException, 5159005);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -40,4 +40,20 @@ std::shared_ptr<MongoProcessInterface> MongoProcessInterface::create(OperationCo
     return w(opCtx);
 }
 
+std::vector<boost::optional<Document>> MongoProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    std::vector<boost::optional<Document>> results;
+    results.reserve(documentKeys.size());
+    for (auto&& documentKey : documentKeys) {
+        results.push_back(lookupSingleDocument(
+            expCtx, nss, collectionUUID, documentKey, readConcern, allowSpeculativeMajorityRead));
+    }
+    return results;
+}
+
 }  // namespace mongo
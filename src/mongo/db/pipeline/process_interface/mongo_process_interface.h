@@ -358,6 +358,19 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) = 0;
 
+    /**
+     * Looks up the document with each of 'documentKeys' as lookupSingleDocument() does, returning
+     * the results in the same order. The default implementation performs one lookup per key;
+     * implementations for which each lookup is a remote request may combine them.
+     */
+    virtual std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false);
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -36,6 +36,7 @@
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
@@ -100,6 +101,100 @@ bool supportsUniqueKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
         CollatorInterface::collatorsMatch(collation.get(), expCtx->getCollator());
 }
 
+/**
+ * Sends a find for 'filterObj' on the collection 'nss' with UUID 'collectionUUID' to every shard
+ * which may own a matching document, and returns the cursors it opened. If 'batchSize' is set, it
+ * is the batch size of the find.
+ */
+std::vector<RemoteCursor> lookUpOnShards(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                         const NamespaceString& nss,
+                                         UUID collectionUUID,
+                                         const BSONObj& filterObj,
+                                         const boost::optional<BSONObj>& readConcern,
+                                         bool allowSpeculativeMajorityRead,
+                                         boost::optional<long long> batchSize) {
+    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
+
+    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
+    BSONObjBuilder cmdBuilder;
+    bool findCmdIsByUuid(foreignExpCtx->uuid);
+    if (findCmdIsByUuid) {
+        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
+    } else {
+        cmdBuilder.append("find", nss.coll());
+    }
+    cmdBuilder.append("filter", filterObj);
+    if (batchSize) {
+        cmdBuilder.append("batchSize", *batchSize);
+    }
+    if (readConcern) {
+        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
+    }
+    if (allowSpeculativeMajorityRead) {
+        cmdBuilder.append("allowSpeculativeMajorityRead", true);
+    }
+
+    auto findCmd = cmdBuilder.obj();
+    auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
+    return sharded_agg_helpers::shardVersionRetry(
+        expCtx->opCtx,
+        catalogCache,
+        foreignExpCtx->ns,
+        str::stream() << "Looking up document matching " << redact(filterObj),
+        [&]() -> std::vector<RemoteCursor> {
+            // Verify that the collection exists, with the correct UUID.
+            auto routingInfo = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
+
+            // Finalize the 'find' command object based on the routing table information.
+            if (findCmdIsByUuid && routingInfo.cm()) {
+                // Find by UUID and shard versioning do not work together (SERVER-31946).  In
+                // the sharded case we've already checked the UUID, so find by namespace is
+                // safe.  In the unlikely case that the collection has been deleted and a new
+                // collection with the same name created through a different mongos or the
+                // collection had its shard key refined, the shard version will be detected as
+                // stale, as shard versions contain an 'epoch' field unique to the collection.
+                findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
+                findCmdIsByUuid = false;
+            }
+
+            // Build the versioned requests to be dispatched to the shards. Typically, only a
+            // single shard will be targeted here; however, in certain cases where only the _id
+            // is present, we may need to scatter-gather the query to all shards in order to
+            // find the document.
+            auto requests = getVersionedRequestsForTargetedShards(expCtx->opCtx,
+                                                                  nss,
+                                                                  routingInfo,
+                                                                  findCmd,
+                                                                  filterObj,
+                                                                  CollationSpec::kSimpleSpec);
+
+            // Dispatch the requests. The 'establishCursors' method conveniently prepares the
+            // result into a vector of cursor responses for us.
+            return establishCursors(
+                expCtx->opCtx,
+                Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                nss,
+                ReadPreferenceSetting::get(expCtx->opCtx),
+                std::move(requests),
+                false);
+        });
+}
+
+/**
+ * Returns true if each field of 'documentKey', which may be a dotted path, has the same value in
+ * 'doc'.
+ */
+bool matchesDocumentKey(const Document& doc, const Document& documentKey) {
+    for (auto it = documentKey.fieldIterator(); it.more();) {
+        auto field = it.next();
+        if (ValueComparator::kInstance.evaluate(doc.getNestedField(FieldPath(field.first)) !=
+                                                field.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 std::unique_ptr<Pipeline, PipelineDeleter> MongosProcessInterface::attachCursorSourceToPipeline(
@@ -120,70 +215,14 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     const Document& filter,
     boost::optional<BSONObj> readConcern,
     bool allowSpeculativeMajorityRead) {
-    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
-
-    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
-    auto filterObj = filter.toBson();
-    BSONObjBuilder cmdBuilder;
-    bool findCmdIsByUuid(foreignExpCtx->uuid);
-    if (findCmdIsByUuid) {
-        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
-    } else {
-        cmdBuilder.append("find", nss.coll());
-    }
-    cmdBuilder.append("filter", filterObj);
-    if (readConcern) {
-        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
-    }
-    if (allowSpeculativeMajorityRead) {
-        cmdBuilder.append("allowSpeculativeMajorityRead", true);
-    }
-
     try {
-        auto findCmd = cmdBuilder.obj();
-        auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
-        auto shardResults = sharded_agg_helpers::shardVersionRetry(
-            expCtx->opCtx,
-            catalogCache,
-            foreignExpCtx->ns,
-            str::stream() << "Looking up document matching " << redact(filter.toBson()),
-            [&]() -> std::vector<RemoteCursor> {
-                // Verify that the collection exists, with the correct UUID.
-                auto routingInfo = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
-
-                // Finalize the 'find' command object based on the routing table information.
-                if (findCmdIsByUuid && routingInfo.cm()) {
-                    // Find by UUID and shard versioning do not work together (SERVER-31946).  In
-                    // the sharded case we've already checked the UUID, so find by namespace is
-                    // safe.  In the unlikely case that the collection has been deleted and a new
-                    // collection with the same name created through a different mongos or the
-                    // collection had its shard key refined, the shard version will be detected as
-                    // stale, as shard versions contain an 'epoch' field unique to the collection.
-                    findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
-                    findCmdIsByUuid = false;
-                }
-
-                // Build the versioned requests to be dispatched to the shards. Typically, only a
-                // single shard will be targeted here; however, in certain cases where only the _id
-                // is present, we may need to scatter-gather the query to all shards in order to
-                // find the document.
-                auto requests = getVersionedRequestsForTargetedShards(expCtx->opCtx,
-                                                                      nss,
-                                                                      routingInfo,
-                                                                      findCmd,
-                                                                      filterObj,
-                                                                      CollationSpec::kSimpleSpec);
-
-                // Dispatch the requests. The 'establishCursors' method conveniently prepares the
-                // result into a vector of cursor responses for us.
-                return establishCursors(
-                    expCtx->opCtx,
-                    Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                    nss,
-                    ReadPreferenceSetting::get(expCtx->opCtx),
-                    std::move(requests),
-                    false);
-            });
+        auto shardResults = lookUpOnShards(expCtx,
+                                           nss,
+                                           collectionUUID,
+                                           filter.toBson(),
+                                           readConcern,
+                                           allowSpeculativeMajorityRead,
+                                           boost::none);
 
         // Iterate all shard results and build a single composite batch. We also enforce the
         // requirement that only a single document should have been returned from across the
@@ -214,6 +253,95 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     }
 }
 
+std::vector<boost::optional<Document>> MongosProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    if (documentKeys.size() <= 1) {
+        return MongoProcessInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+
+    // Find all of the documents with a single query, which is sent to each shard which may own
+    // any of them. Keys of only an _id become an $in, which the shards answer from the _id index.
+    BSONArrayBuilder ids;
+    BSONArrayBuilder keys;
+    bool idOnly = true;
+    for (auto&& documentKey : documentKeys) {
+        auto keyObj = documentKey.toBson();
+        idOnly = idOnly && keyObj.nFields() == 1 && keyObj.hasField("_id");
+        if (idOnly) {
+            ids.append(keyObj["_id"]);
+        }
+        keys.append(keyObj);
+    }
+    auto filterObj =
+        idOnly ? BSON("_id" << BSON("$in" << ids.arr())) : BSON("$or" << keys.arr());
+
+    std::vector<Document> found;
+    bool complete = true;
+    try {
+        auto shardResults = lookUpOnShards(expCtx,
+                                           nss,
+                                           collectionUUID,
+                                           filterObj,
+                                           readConcern,
+                                           allowSpeculativeMajorityRead,
+                                           static_cast<long long>(documentKeys.size()));
+        for (auto&& shardResult : shardResults) {
+            auto& shardCursor = shardResult.getCursorResponse();
+            for (auto&& obj : shardCursor.getBatch()) {
+                found.emplace_back(obj);
+            }
+            if (shardCursor.getCursorId() != 0) {
+                // The documents did not fit in one batch. Look up those which were not returned
+                // one at a time instead.
+                complete = false;
+                killRemoteCursor(
+                    expCtx->opCtx,
+                    Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor().get(),
+                    std::move(shardResult),
+                    nss);
+            }
+        }
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        // As for a single lookup, the collection may have been deleted and re-created.
+        return std::vector<boost::optional<Document>>(documentKeys.size());
+    }
+
+    std::vector<boost::optional<Document>> results;
+    results.reserve(documentKeys.size());
+    for (auto&& documentKey : documentKeys) {
+        boost::optional<Document> result;
+        for (auto&& doc : found) {
+            if (!matchesDocumentKey(doc, documentKey)) {
+                continue;
+            }
+            uassert(ErrorCodes::ChangeStreamFatalError,
+                    str::stream() << "found more than one document matching "
+                                  << documentKey.toString() << " [" << result->toString() << ", "
+                                  << doc.toString() << "]",
+                    !result);
+            result = doc;
+        }
+
+        // Documents left out of a shard's first batch are looked up one at a time.
+        if (!result && !complete) {
+            result = lookupSingleDocument(expCtx,
+                                          nss,
+                                          collectionUUID,
+                                          documentKey,
+                                          readConcern,
+                                          allowSpeculativeMajorityRead);
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
 BSONObj MongosProcessInterface::_reportCurrentOpForClient(
     OperationContext* opCtx,
     Client* client,
@@ -32,6 +32,8 @@
 
 #include "sharded_agg_helpers.h"
 
+#include <limits>
+
 #include "mongo/db/curop.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -674,6 +676,64 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, *routingInfo.cm());
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx, const Pipeline* mergePipeline, const std::set<ShardId>& shardIds) {
+    const auto maxConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    if (internalQueryDisableExchange.load() || maxConsumers < 2 || shardIds.size() < 2) {
+        return boost::none;
+    }
+
+    // The consumers are chosen by hashing the raw group key, so keys which only compare equal
+    // under a non-simple collation could be merged by different consumers.
+    const auto& expCtx = mergePipeline->getContext();
+    if (expCtx->getCollator() || expCtx->tailableMode != TailableModeEnum::kNormal) {
+        return boost::none;
+    }
+
+    const auto& sources = mergePipeline->getSources();
+    if (sources.empty()) {
+        return boost::none;
+    }
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage || !groupStage->doingMerge()) {
+        return boost::none;
+    }
+
+    // The partial results produced by the shards carry the group key in their _id field. Split the
+    // range of its hash evenly between the consumers, starting from a random targeted shard so that
+    // concurrent aggregations spread the merging work over the cluster.
+    const std::vector<ShardId> candidates(shardIds.begin(), shardIds.end());
+    const size_t numConsumers = std::min(static_cast<size_t>(maxConsumers), candidates.size());
+    const size_t firstConsumer = opCtx->getClient()->getPrng().nextInt32(candidates.size());
+    const uint64_t rangeSize = std::numeric_limits<uint64_t>::max() / numConsumers;
+    const auto minHash = static_cast<uint64_t>(std::numeric_limits<long long>::min());
+
+    std::vector<BSONObj> boundaries{BSON("_id" << MINKEY)};
+    std::vector<int> consumerIds;
+    std::vector<ShardId> consumerShards;
+    for (size_t idx = 0; idx < numConsumers; ++idx) {
+        if (idx > 0) {
+            const auto splitPoint = static_cast<long long>(minHash + idx * rangeSize);
+            boundaries.emplace_back(BSON("_id" << splitPoint));
+        }
+        consumerIds.emplace_back(idx);
+        consumerShards.emplace_back(candidates[(firstConsumer + idx) % candidates.size()]);
+    }
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    // Every group is complete once a consumer has merged its partition, so only the $group itself
+    // needs to run on the consumers.
+    return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards), size_t{1}};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -764,7 +824,8 @@ BSONObj createCommandForTargetedShards(const boost::intrusive_ptr<ExpressionCont
 DispatchShardPipelineResults dispatchShardPipeline(
     Document serializedCommand,
     bool hasChangeStream,
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+    bool allowGroupExchange) {
     auto expCtx = pipeline->getContext();
 
     // The process is as follows:
@@ -824,6 +885,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec && allowGroupExchange && !splitPipelines->shardCursorsSortSpec) {
+            exchangeSpec = checkIfEligibleForGroupExchange(
+                opCtx, splitPipelines->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -67,6 +67,12 @@ struct ShardedExchangePolicy {
 
     // Shards that will run the consumer part of the exchange.
     std::vector<ShardId> consumerShards;
+
+    // If set, only this many stages from the front of the merging pipeline are run by the
+    // consumers, each over its own partition of the documents. The remaining stages run on the
+    // merging host over the union of the consumers' results. Otherwise the consumers run the entire
+    // merging pipeline.
+    boost::optional<size_t> numConsumerStages;
 };
 
 struct DispatchShardPipelineResults {
@@ -105,6 +111,15 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline begins with the merging half of a $group, returns an exchange policy
+ * which hash-partitions the partial group results on the group key so that several of the
+ * targeted shards can each merge a disjoint subset of the groups. This is only attempted when the
+ * 'internalQueryGroupMergeExchangeConsumers' knob is set.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx, const Pipeline* mergePipeline, const std::set<ShardId>& shardIds);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
@@ -120,11 +135,16 @@ SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline)
  * Targets shards for the pipeline and returns a struct with the remote cursors or results, and
  * the pipeline that will need to be executed to merge the results from the remotes. If a stale
  * shard version is encountered, refreshes the routing table and tries again.
+ *
+ * If 'allowGroupExchange' is true, the caller is able to dispatch the consumers of an exchange and
+ * the pipeline may be set up to merge partial $group results across several shards; see
+ * checkIfEligibleForGroupExchange().
  */
 DispatchShardPipelineResults dispatchShardPipeline(
     Document serializedCommand,
     bool hasChangeStream,
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+    bool allowGroupExchange = false);
 
 BSONObj createPassthroughCommandForShard(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/window_function.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/pipeline/expression_context.h"
+
+namespace mongo {
+
+std::unique_ptr<WindowFunctionState> WindowFunctionState::create(ExpressionContext* const expCtx,
+                                                                 StringData opName) {
+    if (opName == "$sum"_sd) {
+        return std::make_unique<WindowFunctionSum>();
+    } else if (opName == "$avg"_sd) {
+        return std::make_unique<WindowFunctionAvg>();
+    } else if (opName == "$min"_sd) {
+        return std::make_unique<WindowFunctionMinMax>(expCtx, WindowFunctionMinMax::Sense::kMin);
+    } else if (opName == "$max"_sd) {
+        return std::make_unique<WindowFunctionMinMax>(expCtx, WindowFunctionMinMax::Sense::kMax);
+    }
+    return nullptr;
+}
+
+void WindowFunctionSum::update(const Value& value, int sign) {
+    switch (value.getType()) {
+        case NumberInt:
+            _numInts += sign;
+            _nonDecimalTotal.addLong(sign * static_cast<long long>(value.getInt()));
+            break;
+        case NumberLong: {
+            _numLongs += sign;
+            auto x = value.getLong();
+            if (sign < 0 && x == std::numeric_limits<long long>::min()) {
+                // Negating the smallest long would overflow, but its magnitude is exactly a double.
+                _nonDecimalTotal.addDouble(-static_cast<double>(x));
+            } else {
+                _nonDecimalTotal.addLong(sign * x);
+            }
+            break;
+        }
+        case NumberDouble: {
+            _numDoubles += sign;
+            auto x = value.getDouble();
+            if (std::isnan(x)) {
+                _numNaNs += sign;
+            } else if (std::isinf(x)) {
+                (x > 0 ? _numPositiveInfinities : _numNegativeInfinities) += sign;
+            } else {
+                _nonDecimalTotal.addDouble(sign * x);
+            }
+            break;
+        }
+        case NumberDecimal: {
+            _numDecimals += sign;
+            auto x = value.getDecimal();
+            if (x.isNaN()) {
+                _numNaNs += sign;
+            } else if (x.isInfinite()) {
+                (x.isNegative() ? _numNegativeInfinities : _numPositiveInfinities) += sign;
+            } else {
+                _decimalTotal = sign > 0 ? _decimalTotal.add(x) : _decimalTotal.subtract(x);
+            }
+            break;
+        }
+        default:
+            // Like the $sum accumulator, ignore non-numeric values.
+            break;
+    }
+}
+
+Value WindowFunctionSum::getValue() const {
+    if (_numNaNs > 0 || (_numPositiveInfinities > 0 && _numNegativeInfinities > 0)) {
+        return _numDecimals > 0 ? Value(Decimal128::kPositiveNaN)
+                                : Value(std::numeric_limits<double>::quiet_NaN());
+    } else if (_numPositiveInfinities > 0 || _numNegativeInfinities > 0) {
+        bool negative = _numNegativeInfinities > 0;
+        if (_numDecimals > 0) {
+            return Value(negative ? Decimal128::kNegativeInfinity : Decimal128::kPositiveInfinity);
+        }
+        return Value(negative ? -std::numeric_limits<double>::infinity()
+                              : std::numeric_limits<double>::infinity());
+    }
+
+    if (_numDecimals > 0) {
+        return Value(_decimalTotal.add(_nonDecimalTotal.getDecimal()));
+    } else if (_numDoubles > 0 || !_nonDecimalTotal.fitsLong()) {
+        return Value(_nonDecimalTotal.getDouble());
+    } else if (_numLongs > 0) {
+        return Value(_nonDecimalTotal.getLong());
+    }
+    return Value::createIntOrLong(_nonDecimalTotal.getLong());
+}
+
+void WindowFunctionSum::reset() {
+    _numInts = _numLongs = _numDoubles = _numDecimals = 0;
+    _numNaNs = _numPositiveInfinities = _numNegativeInfinities = 0;
+    _nonDecimalTotal = {};
+    _decimalTotal = {};
+}
+
+Value WindowFunctionAvg::getValue() const {
+    auto count = getCount();
+    if (count == 0) {
+        return Value(BSONNULL);
+    }
+
+    auto sum = WindowFunctionSum::getValue();
+    if (sum.getType() == NumberDecimal) {
+        return Value(sum.getDecimal().divide(Decimal128(static_cast<int64_t>(count))));
+    }
+    return Value(sum.coerceToDouble() / static_cast<double>(count));
+}
+
+WindowFunctionMinMax::WindowFunctionMinMax(ExpressionContext* const expCtx, Sense sense)
+    : _expCtx(expCtx), _sense(sense) {}
+
+void WindowFunctionMinMax::add(const Value& value) {
+    auto index = _numAdded++;
+    if (value.nullish()) {
+        return;
+    }
+
+    // Older candidates that are no better than 'value' can never be the result again, since
+    // 'value' stays in the window for at least as long as they do.
+    const auto& comparator = _expCtx->getValueComparator();
+    while (!_candidates.empty() &&
+           comparator.compare(value, _candidates.back().second) * static_cast<int>(_sense) <= 0) {
+        _memUsageBytes -= _candidates.back().second.getApproximateSize();
+        _candidates.pop_back();
+    }
+    _memUsageBytes += value.getApproximateSize();
+    _candidates.emplace_back(index, value);
+}
+
+void WindowFunctionMinMax::remove(const Value& value) {
+    if (!_candidates.empty() && _candidates.front().first == _numRemoved) {
+        _memUsageBytes -= _candidates.front().second.getApproximateSize();
+        _candidates.pop_front();
+    }
+    ++_numRemoved;
+}
+
+Value WindowFunctionMinMax::getValue() const {
+    return _candidates.empty() ? Value(BSONNULL) : _candidates.front().second;
+}
+
+void WindowFunctionMinMax::reset() {
+    _candidates.clear();
+    _numAdded = 0;
+    _numRemoved = 0;
+    _memUsageBytes = sizeof(*this);
+}
+
+}  // namespace mongo
@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <utility>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/platform/decimal128.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+
+class ExpressionContext;
+
+/**
+ * The running state of a window function, such as $sum in $setWindowFields, over a sliding window
+ * of values. Values enter the window through add() and leave it through remove() in the order
+ * they were added, so implementations can maintain their result incrementally instead of
+ * rescanning the window for every document.
+ */
+class WindowFunctionState {
+public:
+    /**
+     * Returns the state of the window function named 'opName', for example "$sum", or nullptr if
+     * there is no window function with that name.
+     */
+    static std::unique_ptr<WindowFunctionState> create(ExpressionContext* const expCtx,
+                                                       StringData opName);
+
+    virtual ~WindowFunctionState() = default;
+
+    /**
+     * Adds 'value' as the newest value in the window.
+     */
+    virtual void add(const Value& value) = 0;
+
+    /**
+     * Removes the oldest value in the window. 'value' must be the value that was passed to the
+     * matching call to add().
+     */
+    virtual void remove(const Value& value) = 0;
+
+    /**
+     * Returns the result of the window function over the values currently in the window.
+     */
+    virtual Value getValue() const = 0;
+
+    /**
+     * Empties the window.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Returns the approximate number of bytes of memory held by this state.
+     */
+    virtual size_t getApproximateSize() const = 0;
+};
+
+/**
+ * $sum over a window. Each numeric type is counted separately so that the result has the type of
+ * the widest value still in the window. Non-finite values are counted rather than summed, since
+ * they could not be subtracted out again.
+ */
+class WindowFunctionSum : public WindowFunctionState {
+public:
+    void add(const Value& value) final {
+        update(value, 1);
+    }
+
+    void remove(const Value& value) final {
+        update(value, -1);
+    }
+
+    Value getValue() const override;
+
+    void reset() final;
+
+    size_t getApproximateSize() const final {
+        return sizeof(*this);
+    }
+
+protected:
+    /**
+     * Returns the number of numeric values in the window.
+     */
+    long long getCount() const {
+        return _numInts + _numLongs + _numDoubles + _numDecimals;
+    }
+
+private:
+    void update(const Value& value, int sign);
+
+    long long _numInts = 0;
+    long long _numLongs = 0;
+    long long _numDoubles = 0;
+    long long _numDecimals = 0;
+
+    long long _numNaNs = 0;
+    long long _numPositiveInfinities = 0;
+    long long _numNegativeInfinities = 0;
+
+    DoubleDoubleSummation _nonDecimalTotal;
+    Decimal128 _decimalTotal;
+};
+
+/**
+ * $avg over a window, which returns null if the window holds no numeric values.
+ */
+class WindowFunctionAvg final : public WindowFunctionSum {
+public:
+    Value getValue() const final;
+};
+
+/**
+ * $min or $max over a window, maintained with a monotonic deque: a value is only kept while no
+ * newer value in the window is at least as small (for $min) or large (for $max). The front of the
+ * deque is the result, and each value is pushed and popped at most once. Like the $min and $max
+ * accumulators, nullish values are ignored.
+ */
+class WindowFunctionMinMax final : public WindowFunctionState {
+public:
+    enum class Sense : int {
+        kMin = 1,
+        kMax = -1,
+    };
+
+    WindowFunctionMinMax(ExpressionContext* const expCtx, Sense sense);
+
+    void add(const Value& value) final;
+
+    void remove(const Value& value) final;
+
+    Value getValue() const final;
+
+    void reset() final;
+
+    size_t getApproximateSize() const final {
+        return _memUsageBytes;
+    }
+
+private:
+    ExpressionContext* const _expCtx;
+    const Sense _sense;
+
+    // Candidate results, along with the order in which they were added to the window.
+    std::deque<std::pair<long long, Value>> _candidates;
+    long long _numAdded = 0;
+    long long _numRemoved = 0;
+
+    size_t _memUsageBytes = sizeof(*this);
+};
+
+}  // namespace mongo
@@ -36,12 +36,14 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_array.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/indexability.h"
 #include "mongo/db/query/projection_parser.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 
 namespace mongo {
@@ -169,6 +171,30 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
     return std::move(cq);
 }
 
+namespace {
+/**
+ * Assigns input parameter ids to the comparison predicates in 'expr' whose constants can be
+ * rebound without changing the semantics of the predicate, that is numbers and strings. Other
+ * constants, like null, arrays or objects, are subject to special matching rules and are left
+ * inlined. Returns the next unused parameter id.
+ */
+ComparisonMatchExpressionBase::InputParamId parameterizeMatchExpression(
+    MatchExpression* expr, ComparisonMatchExpressionBase::InputParamId nextParamId) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<ComparisonMatchExpression*>(expr);
+        const auto& rhs = comparison->getData();
+        if (rhs.isNumber() || rhs.type() == BSONType::String) {
+            comparison->setInputParamId(nextParamId++);
+        }
+    }
+
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        nextParamId = parameterizeMatchExpression(expr->getChild(i), nextParamId);
+    }
+    return nextParamId;
+}
+}  // namespace
+
 Status CanonicalQuery::init(OperationContext* opCtx,
                             boost::intrusive_ptr<ExpressionContext> expCtx,
                             std::unique_ptr<QueryRequest> qr,
@@ -182,6 +208,10 @@ Status CanonicalQuery::init(OperationContext* opCtx,
 
     // Normalize and validate tree.
     _root = MatchExpression::normalize(std::move(root));
+    // Only the slot-based engine can take advantage of the input parameters.
+    if (internalQueryEnableSlotBasedExecutionEngine.load()) {
+        parameterizeMatchExpression(_root.get(), 0);
+    }
     auto validStatus = isValid(_root.get(), *_qr);
     if (!validStatus.isOK()) {
         return validStatus.getStatus();
@@ -30,11 +30,14 @@
 #include "mongo/db/query/canonical_query.h"
 
 #include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -227,6 +230,33 @@ TEST(CanonicalQueryTest, NormalizeQuerySort) {
     testNormalizeQuery("{a: {$elemMatch: {c: 1, b:1}}}", "{a: {$elemMatch: {b: 1, c:1}}}");
 }
 
+TEST(CanonicalQueryTest, ParameterizesScalarComparisonsForSlotBasedEngine) {
+    const auto oldSbeEnabled = internalQueryEnableSlotBasedExecutionEngine.load();
+    internalQueryEnableSlotBasedExecutionEngine.store(true);
+    ON_BLOCK_EXIT([&] { internalQueryEnableSlotBasedExecutionEngine.store(oldSbeEnabled); });
+
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1, b: {$gt: 'x'}, c: null}"));
+    ASSERT_EQ(cq->root()->numChildren(), 3U);
+
+    std::set<ComparisonMatchExpressionBase::InputParamId> paramIds;
+    for (size_t i = 0; i < cq->root()->numChildren(); ++i) {
+        auto comparison = static_cast<ComparisonMatchExpression*>(cq->root()->getChild(i));
+        if (comparison->path() == "c") {
+            // Null is subject to special matching rules and is never parameterized.
+            ASSERT_FALSE(comparison->getInputParamId());
+        } else {
+            ASSERT_TRUE(comparison->getInputParamId());
+            paramIds.insert(*comparison->getInputParamId());
+
+            // The input parameter survives cloning, which is how the planner builds filters.
+            auto clone = comparison->shallowClone();
+            ASSERT_TRUE(static_cast<ComparisonMatchExpression*>(clone.get())->getInputParamId() ==
+                        comparison->getInputParamId());
+        }
+    }
+    ASSERT_EQ(paramIds.size(), 2U);
+}
+
 TEST(CanonicalQueryTest, NormalizeQueryTree) {
     // Single-child $or elimination.
     testNormalizeQuery("{$or: [{b: 1}]}", "{b: 1}");
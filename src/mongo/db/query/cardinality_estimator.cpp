@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace cardinality_estimation {
+
+namespace {
+
+/**
+ * Returns the index scan of 'solution' if it is the only leaf of the solution.
+ */
+const IndexScanNode* singleIndexScan(const QuerySolution& solution) {
+    const QuerySolutionNode* node = solution.root.get();
+    while (node->children.size() == 1) {
+        node = node->children.front();
+    }
+    if (!node->children.empty() || node->getType() != STAGE_IXSCAN) {
+        return nullptr;
+    }
+    return static_cast<const IndexScanNode*>(node);
+}
+
+}  // namespace
+
+boost::optional<double> estimateIndexScanKeys(const IndexScanNode* node,
+                                              const CollectionStatistics& statistics) {
+    const auto& index = node->index;
+    if (index.type != IndexType::INDEX_BTREE || index.collator || index.sparse ||
+        index.filterExpr || node->bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    double fraction = 1.0;
+    long long numDocuments = 0;
+    double keysPerDocument = 1.0;
+    size_t fieldNo = 0;
+    for (auto&& elt : index.keyPattern) {
+        const auto& oil = node->bounds.fields[fieldNo++];
+        const auto* histogram = statistics.getHistogram(elt.fieldNameStringData());
+        if (!histogram) {
+            if (oil.isMinToMax()) {
+                continue;
+            }
+            return boost::none;
+        }
+
+        // Only one field of an index key may be an array, so the keys of the index are about as
+        // many as those of the field with the most keys per document.
+        fraction *= histogram->estimateFraction(oil);
+        numDocuments = std::max(numDocuments, histogram->numDocuments());
+        keysPerDocument = std::max(keysPerDocument, histogram->keysPerDocument());
+    }
+    if (numDocuments == 0) {
+        return boost::none;
+    }
+    return fraction * numDocuments * keysPerDocument;
+}
+
+void pruneSolutionsByEstimatedKeys(const CollectionStatistics& statistics,
+                                   std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (solutions->size() < 2) {
+        return;
+    }
+
+    size_t best = 0;
+    double bestNumKeys = std::numeric_limits<double>::infinity();
+    double nextBestNumKeys = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        // A covered solution could be worth more than the keys it saves.
+        const auto& solution = *(*solutions)[i];
+        if (!solution.root->fetched()) {
+            return;
+        }
+
+        const IndexScanNode* scan = singleIndexScan(solution);
+        if (!scan) {
+            return;
+        }
+
+        auto numKeys = estimateIndexScanKeys(scan, statistics);
+        if (!numKeys) {
+            return;
+        }
+        if (*numKeys < bestNumKeys) {
+            best = i;
+            nextBestNumKeys = bestNumKeys;
+            bestNumKeys = *numKeys;
+        } else {
+            nextBestNumKeys = std::min(nextBestNumKeys, *numKeys);
+        }
+    }
+
+    // Leave plans whose estimates are close for the trial period to decide between.
+    if (nextBestNumKeys == 0 ||
+        bestNumKeys * internalQueryPlannerCollectionStatisticsPruningRatio.load() >
+            nextBestNumKeys) {
+        return;
+    }
+
+    LOGV2_DEBUG(5155015,
+                5,
+                "Planner: keeping only the index scan estimated to read the fewest keys",
+                "numSolutions"_attr = solutions->size(),
+                "estimatedKeys"_attr = bestNumKeys,
+                "nextBestEstimatedKeys"_attr = nextBestNumKeys);
+    auto bestSolution = std::move((*solutions)[best]);
+    solutions->clear();
+    solutions->push_back(std::move(bestSolution));
+}
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+class CollectionStatistics;
+
+namespace cardinality_estimation {
+
+/**
+ * Returns the estimated number of keys that 'node' reads, or boost::none if 'statistics' holds no
+ * histogram for a field the scan has bounds on, or the keys of the index do not match the
+ * histograms: indexes with a collation, sparse and partial indexes, and indexes other than btrees.
+ * Fields are assumed to be independent of each other.
+ */
+boost::optional<double> estimateIndexScanKeys(const IndexScanNode* node,
+                                              const CollectionStatistics& statistics);
+
+/**
+ * If every solution fetches from a single index scan whose keys can be estimated, and one of the
+ * scans is estimated to read internalQueryPlannerCollectionStatisticsPruningRatio times fewer keys
+ * than any other, drops the other solutions.
+ */
+void pruneSolutionsByEstimatedKeys(const CollectionStatistics& statistics,
+                                   std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
@@ -79,6 +79,9 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.direction = (csn->direction == 1) ? CollectionScanParams::FORWARD
                                                      : CollectionScanParams::BACKWARD;
             params.shouldWaitForOplogVisibility = csn->shouldWaitForOplogVisibility;
+            // Only change streams track the latest oplog timestamp of a tailable scan, and many
+            // of them commonly tail the oplog at once.
+            params.shouldUseOplogTailCache = csn->tailable && csn->shouldTrackLatestOplogTimestamp;
             params.minTs = csn->minTs;
             params.maxTs = csn->maxTs;
             params.requestResumeToken = csn->requestResumeToken;
@@ -109,6 +112,8 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.direction = ixn->direction;
             params.addKeyMetadata = ixn->addKeyMetadata;
             params.shouldDedup = ixn->shouldDedup;
+            params.s2KeyFilter = ixn->s2KeyFilter;
+            params.s2KeyFilterPosition = ixn->s2KeyFilterPosition;
             return std::make_unique<IndexScan>(
                 expCtx, _collection, std::move(params), _ws, ixn->filter.get());
         }
@@ -128,7 +133,8 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                 snDefault->limit,
                 internalQueryMaxBlockingSortMemoryUsageBytes.load(),
                 snDefault->addSortKeyMetadata,
-                std::move(childStage));
+                std::move(childStage),
+                snDefault->sortedPrefixLength);
         }
         case STAGE_SORT_SIMPLE: {
             auto snSimple = static_cast<const SortNodeSimple*>(root);
@@ -140,7 +146,8 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                 snSimple->limit,
                 internalQueryMaxBlockingSortMemoryUsageBytes.load(),
                 snSimple->addSortKeyMetadata,
-                std::move(childStage));
+                std::move(childStage),
+                snSimple->sortedPrefixLength);
         }
         case STAGE_SORT_KEY_GENERATOR: {
             const SortKeyGeneratorNode* keyGenNode = static_cast<const SortKeyGeneratorNode*>(root);
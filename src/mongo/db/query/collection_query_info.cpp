@@ -192,6 +192,24 @@ void CollectionQueryInfo::clearQueryCache(const Collection* coll) {
     }
 }
 
+std::shared_ptr<const CollectionStatistics> CollectionQueryInfo::getCollectionStatistics() const {
+    stdx::lock_guard<Latch> lk(_collectionStatisticsMutex);
+    return _collectionStatistics;
+}
+
+void CollectionQueryInfo::setFieldHistogram(const Collection* coll,
+                                            StringData path,
+                                            FieldHistogram histogram) {
+    {
+        stdx::lock_guard<Latch> lk(_collectionStatisticsMutex);
+        auto statistics =
+            _collectionStatistics ? *_collectionStatistics : CollectionStatistics();
+        _collectionStatistics = std::make_shared<const CollectionStatistics>(
+            statistics.withHistogram(path, std::move(histogram)));
+    }
+    clearQueryCache(coll);
+}
+
 PlanCache* CollectionQueryInfo::getPlanCache() const {
     return _planCache.get();
 }
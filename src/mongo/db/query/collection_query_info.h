@@ -29,10 +29,14 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -90,6 +94,18 @@ public:
                        Collection* coll,
                        const PlanSummaryStats& summaryStats);
 
+    /**
+     * Returns the histograms that the 'analyze' command built for the collection, or nullptr if
+     * it never ran on it.
+     */
+    std::shared_ptr<const CollectionStatistics> getCollectionStatistics() const;
+
+    /**
+     * Replaces the histogram of 'path', keeping those of other fields, and clears the plan cache
+     * so that the cached plans are chosen again with the new histogram.
+     */
+    void setFieldHistogram(const Collection* coll, StringData path, FieldHistogram histogram);
+
 private:
     void computeIndexKeys(OperationContext* opCtx, Collection* coll);
     void updatePlanCacheIndexEntries(OperationContext* opCtx, Collection* coll);
@@ -106,6 +122,12 @@ private:
 
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
+
+    // Guards '_collectionStatistics', which the 'analyze' command replaces while holding only an
+    // intent lock on the collection.
+    mutable Mutex _collectionStatisticsMutex =
+        MONGO_MAKE_LATCH("CollectionQueryInfo::_collectionStatisticsMutex");
+    std::shared_ptr<const CollectionStatistics> _collectionStatistics;
 };
 
 }  // namespace mongo
@@ -0,0 +1,211 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collection_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/query/index_bounds.h"
+
+namespace mongo {
+
+namespace {
+
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, false);
+}
+
+/**
+ * Returns the fraction of the open range ('lower', 'upper') which 'interval' covers, assuming the
+ * keys are spread evenly over it. Only numbers can be interpolated, so a range of other values is
+ * assumed to be half covered.
+ */
+double overlapFraction(const BSONElement& lower,
+                       const BSONElement& upper,
+                       const Interval& interval) {
+    if (!lower.isNumber() || !upper.isNumber() || !interval.start.isNumber() ||
+        !interval.end.isNumber()) {
+        return 0.5;
+    }
+
+    const double lo = std::max(lower.numberDouble(), interval.start.numberDouble());
+    const double hi = std::min(upper.numberDouble(), interval.end.numberDouble());
+    const double width = upper.numberDouble() - lower.numberDouble();
+    if (std::isnan(lo) || std::isnan(hi) || !std::isfinite(width) || width <= 0) {
+        return 0.5;
+    }
+    return std::max(0.0, std::min(1.0, (hi - lo) / width));
+}
+
+double estimateInterval(const std::vector<FieldHistogram::Bucket>& buckets, Interval interval) {
+    // Descending indexes have their intervals reversed.
+    if (compareValues(interval.start, interval.end) > 0) {
+        interval.reverse();
+    }
+
+    auto afterStart = [&](const BSONElement& value) {
+        int cmp = compareValues(interval.start, value);
+        return cmp < 0 || (cmp == 0 && interval.startInclusive);
+    };
+    auto beforeEnd = [&](const BSONElement& value) {
+        int cmp = compareValues(value, interval.end);
+        return cmp < 0 || (cmp == 0 && interval.endInclusive);
+    };
+
+    double count = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const auto& bucket = buckets[i];
+        const BSONElement upper = bucket.upperBound.firstElement();
+        if (afterStart(upper) && beforeEnd(upper)) {
+            count += bucket.equalCount;
+        }
+        if (i == 0 || bucket.rangeCount == 0) {
+            continue;
+        }
+
+        // The keys of the bucket other than its upper bound lie strictly between the two bounds.
+        const BSONElement lower = buckets[i - 1].upperBound.firstElement();
+        if (compareValues(interval.end, lower) <= 0 || compareValues(interval.start, upper) >= 0) {
+            continue;
+        }
+        if (compareValues(interval.start, lower) <= 0 && compareValues(interval.end, upper) >= 0) {
+            count += bucket.rangeCount;
+        } else if (interval.isPoint()) {
+            count += bucket.rangeCount / std::max(1.0, bucket.rangeDistinct);
+        } else {
+            count += bucket.rangeCount * overlapFraction(lower, upper, interval);
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+FieldHistogram FieldHistogram::make(std::vector<BSONObj> keys,
+                                    long long numSampledDocuments,
+                                    long long numDocuments,
+                                    size_t numBuckets) {
+    FieldHistogram histogram;
+    histogram._numDocuments = numDocuments;
+    histogram._numSampledDocuments = numSampledDocuments;
+    histogram._numSampledKeys = keys.size();
+    if (keys.empty()) {
+        return histogram;
+    }
+
+    const auto& comparator = SimpleBSONObjComparator::kInstance;
+    std::sort(keys.begin(), keys.end(), comparator.makeLessThan());
+
+    // The index of the first key of each run of equal keys, and the length of the run.
+    std::vector<std::pair<size_t, double>> runs;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (runs.empty() || comparator.evaluate(keys[runs.back().first] != keys[i])) {
+            runs.emplace_back(i, 1);
+        } else {
+            runs.back().second++;
+        }
+    }
+    const double numSingletons =
+        std::count_if(runs.begin(), runs.end(), [](const auto& run) { return run.second == 1; });
+
+    // The Guaranteed-Error Estimator scales up the values seen once in the sample, since those
+    // stand for the values that the sample missed.
+    const double numSampledDistinct = runs.size();
+    histogram._numDistinctValues = numSampledDistinct;
+    if (numSampledDocuments < numDocuments) {
+        histogram._numDistinctValues =
+            std::sqrt(numDocuments / double(numSampledDocuments)) * numSingletons +
+            (numSampledDistinct - numSingletons);
+    }
+    const double distinctScale = histogram._numDistinctValues / numSampledDistinct;
+
+    const double depth = keys.size() / double(std::max<size_t>(numBuckets, 1));
+    histogram._buckets.push_back({keys[runs.front().first].getOwned(), runs.front().second, 0, 0});
+    double rangeCount = 0;
+    double rangeDistinct = 0;
+    for (size_t r = 1; r < runs.size(); ++r) {
+        const auto& [first, count] = runs[r];
+        if (r + 1 < runs.size() && rangeCount + count < depth) {
+            rangeCount += count;
+            rangeDistinct += 1;
+            continue;
+        }
+        histogram._buckets.push_back(
+            {keys[first].getOwned(), count, rangeCount, rangeDistinct * distinctScale});
+        rangeCount = 0;
+        rangeDistinct = 0;
+    }
+    return histogram;
+}
+
+double FieldHistogram::estimateFraction(const OrderedIntervalList& oil) const {
+    if (_numSampledKeys == 0) {
+        return 0;
+    }
+
+    double count = 0;
+    for (const auto& interval : oil.intervals) {
+        count += estimateInterval(_buckets, interval);
+    }
+    return std::min(1.0, count / _numSampledKeys);
+}
+
+void FieldHistogram::appendToBuilder(BSONObjBuilder* builder) const {
+    builder->appendNumber("numDocuments", _numDocuments);
+    builder->appendNumber("numSampledDocuments", _numSampledDocuments);
+    builder->appendNumber("numSampledKeys", _numSampledKeys);
+    builder->append("numDistinctValues", _numDistinctValues);
+
+    BSONArrayBuilder bucketsBuilder(builder->subarrayStart("buckets"));
+    for (const auto& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound.firstElement(), "upperBound");
+        bucketBuilder.append("equalCount", bucket.equalCount);
+        bucketBuilder.append("rangeCount", bucket.rangeCount);
+        bucketBuilder.append("rangeDistinct", bucket.rangeDistinct);
+    }
+}
+
+const FieldHistogram* CollectionStatistics::getHistogram(StringData path) const {
+    auto it = _histograms.find(path);
+    return it == _histograms.end() ? nullptr : &it->second;
+}
+
+CollectionStatistics CollectionStatistics::withHistogram(StringData path,
+                                                         FieldHistogram histogram) const {
+    CollectionStatistics statistics = *this;
+    statistics._histograms[path.toString()] = std::move(histogram);
+    return statistics;
+}
+
+}  // namespace mongo
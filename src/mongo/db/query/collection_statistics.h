@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+struct OrderedIntervalList;
+
+/**
+ * An equi-depth histogram of the index keys that a sample of a collection's documents generates
+ * for one field, along with an estimate of the number of distinct values of the field.
+ *
+ * Values are ordered as the index orders them, without a collation, so estimates only apply to
+ * indexes that have none.
+ */
+class FieldHistogram {
+public:
+    /**
+     * A bucket holds the keys greater than the upper bound of the previous bucket and at most its
+     * own upper bound. The first bucket holds only the smallest key.
+     */
+    struct Bucket {
+        // Single-field object holding the largest key of the bucket.
+        BSONObj upperBound;
+
+        // The number of sampled keys equal to the upper bound.
+        double equalCount = 0;
+
+        // The number of sampled keys between the previous upper bound and this one, and the
+        // estimated number of distinct values among them.
+        double rangeCount = 0;
+        double rangeDistinct = 0;
+    };
+
+    FieldHistogram() = default;
+
+    /**
+     * Builds a histogram of about 'numBuckets' buckets from 'keys', the single-field keys that
+     * 'numSampledDocuments' documents out of 'numDocuments' generate. When every document was
+     * sampled, the number of distinct values is exact.
+     */
+    static FieldHistogram make(std::vector<BSONObj> keys,
+                               long long numSampledDocuments,
+                               long long numDocuments,
+                               size_t numBuckets);
+
+    /**
+     * Returns the fraction of the field's keys which lie within the intervals of 'oil'.
+     */
+    double estimateFraction(const OrderedIntervalList& oil) const;
+
+    /**
+     * The average number of keys that a document generates for the field.
+     */
+    double keysPerDocument() const {
+        return _numSampledDocuments ? _numSampledKeys / double(_numSampledDocuments) : 1.0;
+    }
+
+    long long numDocuments() const {
+        return _numDocuments;
+    }
+
+    long long numSampledDocuments() const {
+        return _numSampledDocuments;
+    }
+
+    long long numSampledKeys() const {
+        return _numSampledKeys;
+    }
+
+    double numDistinctValues() const {
+        return _numDistinctValues;
+    }
+
+    const std::vector<Bucket>& buckets() const {
+        return _buckets;
+    }
+
+    void appendToBuilder(BSONObjBuilder* builder) const;
+
+private:
+    std::vector<Bucket> _buckets;
+
+    long long _numDocuments = 0;
+    long long _numSampledDocuments = 0;
+    long long _numSampledKeys = 0;
+    double _numDistinctValues = 0;
+};
+
+/**
+ * The field histograms the 'analyze' command built for a collection. Instances are not modified
+ * once published: analyzing a field publishes a copy holding its new histogram instead.
+ */
+class CollectionStatistics {
+public:
+    /**
+     * Returns the histogram for the dotted 'path', or nullptr if it was never analyzed.
+     */
+    const FieldHistogram* getHistogram(StringData path) const;
+
+    /**
+     * Returns a copy of these statistics in which 'path' has 'histogram'.
+     */
+    CollectionStatistics withHistogram(StringData path, FieldHistogram histogram) const;
+
+    const StringMap<FieldHistogram>& histograms() const {
+        return _histograms;
+    }
+
+private:
+    StringMap<FieldHistogram> _histograms;
+};
+
+}  // namespace mongo
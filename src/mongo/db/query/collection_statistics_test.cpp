@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collection_statistics.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+FieldHistogram makeHistogram(const std::vector<int>& values,
+                             long long numDocuments,
+                             size_t numBuckets) {
+    std::vector<BSONObj> keys;
+    for (int value : values) {
+        keys.push_back(BSON("" << value));
+    }
+    return FieldHistogram::make(std::move(keys), values.size(), numDocuments, numBuckets);
+}
+
+OrderedIntervalList makeOil(BSONObj bounds, bool startInclusive, bool endInclusive) {
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(Interval(bounds, startInclusive, endInclusive));
+    return oil;
+}
+
+std::vector<int> range(int start, int end) {
+    std::vector<int> values;
+    for (int i = start; i < end; ++i) {
+        values.push_back(i);
+    }
+    return values;
+}
+
+TEST(FieldHistogramTest, UniformValuesAreEstimatedByInterpolation) {
+    auto histogram = makeHistogram(range(0, 1000), 1000, 10);
+    ASSERT_EQ(1000, histogram.numSampledKeys());
+    ASSERT_LTE(histogram.buckets().size(), 11U);
+
+    auto point = makeOil(BSON("" << 500 << "" << 500), true, true);
+    ASSERT_APPROX_EQUAL(0.001, histogram.estimateFraction(point), 0.001);
+    ASSERT_APPROX_EQUAL(
+        0.1, histogram.estimateFraction(makeOil(BSON("" << 0 << "" << 100), true, false)), 0.01);
+    ASSERT_APPROX_EQUAL(
+        0.5, histogram.estimateFraction(makeOil(BSON("" << 500 << "" << 2000), true, true)), 0.01);
+    ASSERT_EQ(1.0,
+              histogram.estimateFraction(makeOil(BSON("" << MINKEY << "" << MAXKEY), true, true)));
+    ASSERT_EQ(0.0,
+              histogram.estimateFraction(makeOil(BSON("" << "a" << "" << "z"), true, true)));
+}
+
+TEST(FieldHistogramTest, DescendingIntervalsAreEstimatedLikeAscendingOnes) {
+    auto histogram = makeHistogram(range(0, 1000), 1000, 10);
+    ASSERT_EQ(histogram.estimateFraction(makeOil(BSON("" << 0 << "" << 100), true, false)),
+              histogram.estimateFraction(makeOil(BSON("" << 100 << "" << 0), false, true)));
+}
+
+TEST(FieldHistogramTest, FrequentValueIsEstimatedFromItsOwnCount) {
+    std::vector<int> values(900, 1);
+    auto others = range(2, 102);
+    values.insert(values.end(), others.begin(), others.end());
+    auto histogram = makeHistogram(values, 1000, 10);
+
+    ASSERT_APPROX_EQUAL(
+        0.9, histogram.estimateFraction(makeOil(BSON("" << 1 << "" << 1), true, true)), 0.001);
+    ASSERT_APPROX_EQUAL(
+        0.001, histogram.estimateFraction(makeOil(BSON("" << 50 << "" << 50), true, true)), 0.001);
+}
+
+TEST(FieldHistogramTest, DistinctValuesAreExactWhenEveryDocumentIsSampled) {
+    std::vector<int> values = range(0, 100);
+    values.insert(values.end(), values.begin(), values.end());
+    ASSERT_EQ(100, makeHistogram(values, 200, 10).numDistinctValues());
+}
+
+TEST(FieldHistogramTest, DistinctValuesSeenOnceAreScaledUpWhenSampled) {
+    // Each of the 100 values seen once in a sample of 1% of the documents stands for 10 values.
+    ASSERT_APPROX_EQUAL(1000, makeHistogram(range(0, 100), 10000, 10).numDistinctValues(), 0.001);
+
+    // Values seen several times are likely to be all there is.
+    std::vector<int> values = range(0, 100);
+    values.insert(values.end(), values.begin(), values.end());
+    ASSERT_EQ(100, makeHistogram(values, 20000, 10).numDistinctValues());
+}
+
+TEST(FieldHistogramTest, EmptySampleEstimatesNothing) {
+    auto histogram = makeHistogram({}, 0, 10);
+    ASSERT_EQ(0.0,
+              histogram.estimateFraction(makeOil(BSON("" << MINKEY << "" << MAXKEY), true, true)));
+    ASSERT_EQ(1.0, histogram.keysPerDocument());
+}
+
+TEST(CollectionStatisticsTest, WithHistogramKeepsOtherFields) {
+    CollectionStatistics statistics;
+    ASSERT_EQ(nullptr, statistics.getHistogram("a"));
+
+    auto withA = statistics.withHistogram("a", makeHistogram(range(0, 10), 10, 2));
+    auto withAB = withA.withHistogram("b.c", makeHistogram(range(0, 20), 20, 2));
+    ASSERT_EQ(nullptr, statistics.getHistogram("a"));
+    ASSERT_EQ(nullptr, withA.getHistogram("b.c"));
+    ASSERT_EQ(10, withAB.getHistogram("a")->numSampledKeys());
+    ASSERT_EQ(20, withAB.getHistogram("b.c")->numSampledKeys());
+
+    auto refreshed = withAB.withHistogram("a", makeHistogram(range(0, 30), 30, 2));
+    ASSERT_EQ(30, refreshed.getHistogram("a")->numSampledKeys());
+    ASSERT_EQ(20, refreshed.getHistogram("b.c")->numSampledKeys());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -92,7 +92,9 @@ public:
     }
 
     void setPostBatchResumeToken(BSONObj token) {
-        _postBatchResumeToken = token.getOwned();
+        // This is called for every document in the batch. Most executors produce no resume token,
+        // and making an owned copy of the unowned empty object would allocate each time.
+        _postBatchResumeToken = token.isEmpty() ? BSONObj() : token.getOwned();
     }
 
     void setPartialResultsReturned(bool partialResults) {
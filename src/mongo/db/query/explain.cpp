@@ -480,6 +480,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         }
     } else if (STAGE_IDHACK == stats.stageType) {
         IDHackStats* spec = static_cast<IDHackStats*>(stats.specific.get());
+        bob->append("indexName", spec->indexName);
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("docsExamined", spec->docsExamined);
@@ -513,6 +514,9 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("seeks", spec->seeks);
             bob->appendNumber("dupsTested", spec->dupsTested);
             bob->appendNumber("dupsDropped", spec->dupsDropped);
+            if (spec->filtersS2Keys) {
+                bob->appendNumber("s2KeysFiltered", spec->s2KeysFiltered);
+            }
         }
     } else if (STAGE_OR == stats.stageType) {
         OrStats* spec = static_cast<OrStats*>(stats.specific.get());
@@ -552,6 +556,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendIntOrLL("limitAmount", spec->limit);
         }
 
+        if (spec->sortedPrefixLength > 0) {
+            bob->appendIntOrLL("sortedPrefixLength", spec->sortedPrefixLength);
+        }
+
         bob->append("type", stats.stageType == STAGE_SORT_SIMPLE ? "simple" : "default");
 
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
@@ -1082,6 +1090,7 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     // Append whether or not the entry is active.
     out->append("isActive", entry.isActive);
     out->append("works", static_cast<long long>(entry.works));
+    out->append("estimatedSizeBytes", static_cast<long long>(entry.estimatedEntrySizeBytes()));
 
     BSONObjBuilder cachedPlanBob(out->subobjStart("cachedPlan"));
     Explain::statsToBSON(*(entry.decision->getStats<PlanStageStats>()[0]),
@@ -63,12 +63,14 @@
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/indexability.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor.h"
@@ -152,6 +154,53 @@ bool isIdHackEligibleQuery(Collection* collection, const CanonicalQuery& query)
         !query.getQueryRequest().isTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns a unique index on 'collection' from which 'query' can be answered with a single lookup,
+ * as an IDHACK plan answers an equality on _id, or nullptr if there is none. The query must be a
+ * simple equality on the only field of a unique btree index that is neither sparse, partial nor
+ * hidden, and whose collation matches the query's.
+ */
+const IndexDescriptor* findUniqueIndexForIdHack(OperationContext* opCtx,
+                                                Collection* collection,
+                                                const CanonicalQuery& query) {
+    const auto& qr = query.getQueryRequest();
+    if (!internalQueryUseIdHackForUniqueIndexes.load() || qr.showRecordId() ||
+        !qr.getHint().isEmpty() || !qr.getMin().isEmpty() || !qr.getMax().isEmpty() ||
+        qr.getSkip() || qr.isTailable() || qr.returnKey()) {
+        return nullptr;
+    }
+
+    const BSONObj& filter = qr.getFilter();
+    if (filter.nFields() != 1) {
+        return nullptr;
+    }
+    BSONElement elt = filter.firstElement();
+    if (elt.type() == Object ? elt.Obj().firstElementFieldName()[0] == '$'
+                             : !Indexability::isExactBoundsGenerating(elt)) {
+        return nullptr;
+    }
+
+    auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (it->more()) {
+        const IndexCatalogEntry* entry = it->next();
+        const IndexDescriptor* desc = entry->descriptor();
+        if (!desc->unique() || desc->isSparse() || desc->isPartial() || desc->hidden() ||
+            desc->getAccessMethodName() != IndexNames::BTREE || desc->keyPattern().nFields() != 1 ||
+            desc->keyPattern().firstElementFieldNameStringData() != elt.fieldNameStringData() ||
+            !CollatorInterface::collatorsMatch(query.getCollator(), entry->getCollator())) {
+            continue;
+        }
+
+        // With a non-simple collation the lookup generates its key from the wrapped equality as if
+        // it were a document, which would not find a value under a dotted path.
+        if (entry->getCollator() && elt.fieldNameStringData().find('.') != std::string::npos) {
+            continue;
+        }
+        return desc;
+    }
+    return nullptr;
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -195,10 +244,12 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx,
     const bool isMultikey = ice.isMultikey();
 
     const WildcardProjection* wildcardProjection = nullptr;
+    const WildcardPathKeyCounts* wildcardPathKeyCounts = nullptr;
     std::set<FieldRef> multikeyPathSet;
     if (desc->getIndexType() == IndexType::INDEX_WILDCARD) {
-        wildcardProjection =
-            static_cast<const WildcardAccessMethod*>(accessMethod)->getWildcardProjection();
+        auto wildcardAccessMethod = static_cast<const WildcardAccessMethod*>(accessMethod);
+        wildcardProjection = wildcardAccessMethod->getWildcardProjection();
+        wildcardPathKeyCounts = wildcardAccessMethod->getPathKeyCounts();
         if (isMultikey) {
             MultikeyMetadataAccessStats mkAccessStats;
 
@@ -225,23 +276,25 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx,
         }
     }
 
-    return {desc->keyPattern(),
-            desc->getIndexType(),
-            isMultikey,
-            // The fixed-size vector of multikey paths stored in the index catalog.
-            ice.getMultikeyPaths(opCtx),
-            // The set of multikey paths from special metadata keys stored in the index itself.
-            // Indexes that have these metadata keys do not store a fixed-size vector of multikey
-            // metadata in the index catalog. Depending on the index type, an index uses one of
-            // these mechanisms (or neither), but not both.
-            multikeyPathSet,
-            desc->isSparse(),
-            desc->unique(),
-            IndexEntry::Identifier{desc->indexName()},
-            ice.getFilterExpression(),
-            desc->infoObj(),
-            ice.getCollator(),
-            wildcardProjection};
+    IndexEntry entry{desc->keyPattern(),
+                     desc->getIndexType(),
+                     isMultikey,
+                     // The fixed-size vector of multikey paths stored in the index catalog.
+                     ice.getMultikeyPaths(opCtx),
+                     // The set of multikey paths from special metadata keys stored in the index
+                     // itself. Indexes that have these metadata keys do not store a fixed-size
+                     // vector of multikey metadata in the index catalog. Depending on the index
+                     // type, an index uses one of these mechanisms (or neither), but not both.
+                     multikeyPathSet,
+                     desc->isSparse(),
+                     desc->unique(),
+                     IndexEntry::Identifier{desc->indexName()},
+                     ice.getFilterExpression(),
+                     desc->infoObj(),
+                     ice.getCollator(),
+                     wildcardProjection};
+    entry.wildcardPathKeyCounts = wildcardPathKeyCounts;
+    return entry;
 }
 
 /**
@@ -328,6 +381,11 @@ void fillOutPlannerParams(OperationContext* opCtx,
             opCtx, collection, canonicalQuery->getQueryRequest().isTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
     }
+
+    if (internalQueryPlannerUseCollectionStatistics.load()) {
+        plannerParams->collectionStatistics =
+            CollectionQueryInfo::get(collection).getCollectionStatistics();
+    }
 }
 
 bool shouldWaitForOplogVisibility(OperationContext* opCtx,
@@ -548,8 +606,11 @@ public:
 
         const IndexDescriptor* idIndexDesc = _collection->getIndexCatalog()->findIdIndex(_opCtx);
 
-        // If we have an _id index we can use an idhack plan.
-        if (idIndexDesc && isIdHackEligibleQuery(_collection, *_cq)) {
+        // If we have an _id index we can use an idhack plan. A clustered collection has no _id
+        // index but can look up the record by _id itself, which has no index key to return.
+        const bool canUseClusteredIdHack =
+            _collection->isClustered() && !_cq->getQueryRequest().returnKey();
+        if ((idIndexDesc || canUseClusteredIdHack) && isIdHackEligibleQuery(_collection, *_cq)) {
             LOGV2_DEBUG(
                 20922, 2, "Using idhack", "canonicalQuery"_attr = redact(_cq->toStringShort()));
             // If an IDHACK plan is not supported, we will use the normal plan generation process
@@ -560,6 +621,18 @@ public:
             }
         }
 
+        // Likewise, an equality on the only field of a unique index needs a single index lookup.
+        if (auto uniqueIndexDesc = findUniqueIndexForIdHack(_opCtx, _collection, *_cq)) {
+            LOGV2_DEBUG(5155006,
+                        2,
+                        "Using idhack on a unique index",
+                        "index"_attr = uniqueIndexDesc->indexName(),
+                        "canonicalQuery"_attr = redact(_cq->toStringShort()));
+            if (auto result = buildIdHackPlan(uniqueIndexDesc, &plannerParams)) {
+                return std::move(result);
+            }
+        }
+
         // Tailable: If the query requests tailable the collection must be capped.
         if (_cq->getQueryRequest().isTailable() && !_collection->isCapped()) {
             return Status(ErrorCodes::BadValue,
@@ -684,7 +757,7 @@ protected:
     /**
      * If supported, constructs a special PlanStage tree for fast-path document retrievals via the
      * _id index. Otherwise, nullptr should be returned and  this helper will fall back to the
-     * normal plan generation.
+     * normal plan generation. A null 'descriptor' asks for a lookup on a clustered collection.
      */
     virtual std::unique_ptr<ResultType> buildIdHackPlan(const IndexDescriptor* descriptor,
                                                         QueryPlannerParams* plannerParams) = 0;
@@ -759,8 +832,16 @@ protected:
     std::unique_ptr<ClassicPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
         auto result = makeResult();
-        std::unique_ptr<PlanStage> stage =
-            std::make_unique<IDHackStage>(_cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        std::unique_ptr<PlanStage> stage;
+        if (descriptor) {
+            stage = std::make_unique<IDHackStage>(
+                _cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        } else {
+            stage = std::make_unique<ClusteredIDHackStage>(_cq->getExpCtxRaw(),
+                                                           _cq->getQueryObj()["_id"].wrap(),
+                                                           _ws,
+                                                           _collection);
+        }
 
         // Might have to filter out orphaned docs.
         if (plannerParams->options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
@@ -904,6 +985,12 @@ protected:
 
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
+        // A unique index lookup is only an optimization, so fall back to normal planning for it,
+        // as for the _id lookup on a clustered collection.
+        if (!descriptor || !descriptor->isIdIndex()) {
+            return nullptr;
+        }
+
         uassert(4822862,
                 "IDHack plan is not supprted by SBE yet",
                 !(_cq->metadataDeps()[DocumentMetadataFields::kSortKey] ||
@@ -918,7 +1005,13 @@ protected:
         const QueryPlannerParams& plannerParams,
         size_t decisionWorks) final {
         auto result = makeResult();
-        result->emplace(buildExecutableTree(*solution, true), std::move(solution));
+        // Bound the trial run of the cached plan by the number of reads it is allowed to take
+        // before it gets replanned, so that a plan which falls behind its cached cost is abandoned
+        // as soon as that happens rather than at the end of a full trial period.
+        const auto maxTrialRunReads =
+            sbe::CachedSolutionPlanner::getMaxReadsBeforeReplan(decisionWorks);
+        result->emplace(buildExecutableTree(*solution, true, maxTrialRunReads),
+                        std::move(solution));
         result->setDecisionWorks(decisionWorks);
         return result;
     }
@@ -947,9 +1040,16 @@ protected:
 
 private:
     std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData> buildExecutableTree(
-        const QuerySolution& solution, bool needsTrialRunProgressTracker) const {
-        return stage_builder::buildSlotBasedExecutableTree(
-            _opCtx, _collection, *_cq, solution, _yieldPolicy, needsTrialRunProgressTracker);
+        const QuerySolution& solution,
+        bool needsTrialRunProgressTracker,
+        boost::optional<size_t> maxTrialRunReads = boost::none) const {
+        return stage_builder::buildSlotBasedExecutableTree(_opCtx,
+                                                           _collection,
+                                                           *_cq,
+                                                           solution,
+                                                           _yieldPolicy,
+                                                           needsTrialRunProgressTracker,
+                                                           maxTrialRunReads);
     }
 };
 
@@ -1087,6 +1187,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutor(
     std::unique_ptr<CanonicalQuery> canonicalQuery,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
+    OperationTrace::Span planSpan(opCtx, "plan"_sd);
     return internalQueryEnableSlotBasedExecutionEngine.load()
         ? getSlotBasedExecutor(
               opCtx, collection, std::move(canonicalQuery), yieldPolicy, plannerOptions)
@@ -1194,6 +1295,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     boost::optional<ExplainOptions::Verbosity> verbosity) {
     auto expCtx = parsedDelete->expCtx();
     OperationContext* opCtx = expCtx->opCtx;
+    OperationTrace::Span planSpan(opCtx, "plan"_sd);
     const DeleteRequest* request = parsedDelete->getRequest();
 
     const NamespaceString& nss(request->getNsString());
@@ -1264,16 +1366,26 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
             const bool hasCollectionDefaultCollation = request->getCollation().isEmpty() ||
                 CollatorInterface::collatorsMatch(collator.get(), collection->getDefaultCollator());
 
-            if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
-                request->getProj().isEmpty() && hasCollectionDefaultCollation) {
+            if ((descriptor || collection->isClustered()) &&
+                CanonicalQuery::isSimpleIdQuery(unparsedQuery) && request->getProj().isEmpty() &&
+                hasCollectionDefaultCollation) {
                 LOGV2_DEBUG(20928,
                             2,
                             "Using idhack: {query}",
                             "Using idhack",
                             "query"_attr = redact(unparsedQuery));
 
-                auto idHackStage = std::make_unique<IDHackStage>(
-                    expCtx.get(), unparsedQuery["_id"].wrap(), ws.get(), collection, descriptor);
+                std::unique_ptr<PlanStage> idHackStage;
+                if (descriptor) {
+                    idHackStage = std::make_unique<IDHackStage>(expCtx.get(),
+                                                                unparsedQuery["_id"].wrap(),
+                                                                ws.get(),
+                                                                collection,
+                                                                descriptor);
+                } else {
+                    idHackStage = std::make_unique<ClusteredIDHackStage>(
+                        expCtx.get(), unparsedQuery["_id"].wrap(), ws.get(), collection);
+                }
                 std::unique_ptr<DeleteStage> root =
                     std::make_unique<DeleteStage>(expCtx.get(),
                                                   std::move(deleteStageParams),
@@ -1357,6 +1469,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
     boost::optional<ExplainOptions::Verbosity> verbosity) {
     auto expCtx = parsedUpdate->expCtx();
     OperationContext* opCtx = expCtx->opCtx;
+    OperationTrace::Span planSpan(opCtx, "plan"_sd);
 
     const UpdateRequest* request = parsedUpdate->getRequest();
     UpdateDriver* driver = parsedUpdate->getDriver();
@@ -1432,8 +1545,9 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
             const bool hasCollectionDefaultCollation = CollatorInterface::collatorsMatch(
                 expCtx->getCollator(), collection->getDefaultCollator());
 
-            if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
-                request->getProj().isEmpty() && hasCollectionDefaultCollation) {
+            if ((descriptor || collection->isClustered()) &&
+                CanonicalQuery::isSimpleIdQuery(unparsedQuery) && request->getProj().isEmpty() &&
+                hasCollectionDefaultCollation) {
                 LOGV2_DEBUG(20930,
                             2,
                             "Using idhack: {query}",
@@ -1660,6 +1774,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCoun
     bool explain,
     const NamespaceString& nss) {
     OperationContext* opCtx = expCtx->opCtx;
+    OperationTrace::Span planSpan(opCtx, "plan"_sd);
     std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
 
     auto qr = std::make_unique<QueryRequest>(nss);
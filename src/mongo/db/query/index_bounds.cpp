@@ -587,10 +587,10 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
     out->keySuffix.resize(_curInterval.size());
     out->suffixInclusive.resize(_curInterval.size());
 
-    // It's useful later to go from a field number to the value for that field.  Store these.
-    // TODO: on optimization pass, populate the vector as-needed and keep the vector around as a
-    // member variable
-    vector<BSONElement> keyValues;
+    // It's useful later to go from a field number to the value for that field.  Store these in a
+    // member so that checking each key doesn't allocate.
+    vector<BSONElement>& keyValues = _keyValues;
+    keyValues.clear();
     BSONObjIterator keyIt(key);
     while (keyIt.more()) {
         keyValues.push_back(keyIt.next());
@@ -649,6 +649,7 @@ IndexBoundsChecker::KeyState IndexBoundsChecker::checkKey(const BSONObj& key, In
         Location where = findIntervalForField(keyValues[firstNonContainedField],
                                               _bounds->fields[firstNonContainedField],
                                               _expectedDirection[firstNonContainedField],
+                                              _curInterval[firstNonContainedField],
                                               &newIntervalForField);
 
         if (WITHIN == where) {
@@ -738,10 +739,56 @@ IndexBoundsChecker::Location IndexBoundsChecker::findIntervalForField(
     // Key not in any inteval: [AHEAD, ..., AHEAD, BEHIND, ...]
 
     // Find left-most BEHIND/WITHIN interval.
-    vector<Interval>::const_iterator i = std::lower_bound(oil.intervals.begin(),
-                                                          oil.intervals.end(),
-                                                          std::make_pair(elt, expectedDirection),
-                                                          isKeyAheadOfInterval);
+    return findIntervalInRange(
+        elt, oil, expectedDirection, oil.intervals.begin(), oil.intervals.end(), newIntervalIndex);
+}
+
+// static
+IndexBoundsChecker::Location IndexBoundsChecker::findIntervalForField(
+    const BSONElement& elt,
+    const OrderedIntervalList& oil,
+    const int expectedDirection,
+    size_t startIndex,
+    size_t* newIntervalIndex) {
+    const auto key = std::make_pair(elt, expectedDirection);
+    const size_t numIntervals = oil.intervals.size();
+    if (startIndex >= numIntervals || !isKeyAheadOfInterval(oil.intervals[startIndex], key)) {
+        return findIntervalForField(elt, oil, expectedDirection, newIntervalIndex);
+    }
+
+    // The key is ahead of the interval at 'startIndex'. Consecutive keys of a scan usually land
+    // in one of the next few intervals, so gallop forward with doubling steps until we reach an
+    // interval the key is not ahead of, then binary search between the last two probes. This
+    // keeps the cost of walking a list of n point intervals (e.g. from a large $in) roughly
+    // linear in n, rather than O(n log n).
+    size_t lo = startIndex;
+    size_t step = 1;
+    size_t hi = lo + step;
+    while (hi < numIntervals && isKeyAheadOfInterval(oil.intervals[hi], key)) {
+        lo = hi;
+        step *= 2;
+        hi = lo + step;
+    }
+    hi = std::min(hi, numIntervals);
+
+    return findIntervalInRange(elt,
+                               oil,
+                               expectedDirection,
+                               oil.intervals.begin() + lo + 1,
+                               oil.intervals.begin() + hi,
+                               newIntervalIndex);
+}
+
+// static
+IndexBoundsChecker::Location IndexBoundsChecker::findIntervalInRange(
+    const BSONElement& elt,
+    const OrderedIntervalList& oil,
+    const int expectedDirection,
+    std::vector<Interval>::const_iterator first,
+    std::vector<Interval>::const_iterator last,
+    size_t* newIntervalIndex) {
+    vector<Interval>::const_iterator i =
+        std::lower_bound(first, last, std::make_pair(elt, expectedDirection), isKeyAheadOfInterval);
 
     // Key ahead of all intervals.
     if (i == oil.intervals.end()) {
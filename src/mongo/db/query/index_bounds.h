@@ -261,15 +261,37 @@ public:
      * If 'elt' cannot be advanced to any interval, return AHEAD.
      *
      * Exposed for testing only.
+     */
+    static Location findIntervalForField(const BSONElement& elt,
+                                         const OrderedIntervalList& oil,
+                                         const int expectedDirection,
+                                         size_t* newIntervalIndex);
+
+    /**
+     * Same as above, but uses the hint that 'elt' is likely only slightly ahead of the interval at
+     * 'startIndex': if it is ahead of that interval, the search gallops forward from there instead
+     * of bisecting the whole list. Otherwise falls back to searching the whole list.
      *
-     * TODO(efficiency): Start search from a given index.
+     * Exposed for testing only.
      */
     static Location findIntervalForField(const BSONElement& elt,
                                          const OrderedIntervalList& oil,
                                          const int expectedDirection,
+                                         size_t startIndex,
                                          size_t* newIntervalIndex);
 
 private:
+    /**
+     * Binary searches the intervals in [first, last) of 'oil' for 'elt'. The key must be ahead of
+     * every interval before 'first' and must not be ahead of the interval at 'last', if any.
+     */
+    static Location findIntervalInRange(const BSONElement& elt,
+                                        const OrderedIntervalList& oil,
+                                        const int expectedDirection,
+                                        std::vector<Interval>::const_iterator first,
+                                        std::vector<Interval>::const_iterator last,
+                                        size_t* newIntervalIndex);
+
     /**
      * Find the first field in the key that isn't within the interval we think it is.  Returns
      * false if every field is in the interval we think it is.  Returns true and populates out
@@ -299,6 +321,9 @@ private:
 
     // Direction of scan * direction of indexing.
     std::vector<int> _expectedDirection;
+
+    // Scratch space for the elements of the key being checked, reused across calls to checkKey().
+    std::vector<BSONElement> _keyValues;
 };
 
 }  // namespace mongo
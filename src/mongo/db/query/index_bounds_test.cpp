@@ -1072,4 +1072,64 @@ TEST(IndexBoundsCheckerTest, FindIntervalForField) {
     testFindIntervalForField(0, pointsObj, -1, IndexBoundsChecker::AHEAD, 0U);
 }
 
+TEST(IndexBoundsCheckerTest, FindIntervalForFieldFromStartIndexMatchesFullSearch) {
+    // Point intervals on the even numbers [0, 2 * numPoints), as generated by a large $in.
+    const int numPoints = 100;
+    OrderedIntervalList oil("foo");
+    for (int j = 0; j < numPoints; ++j) {
+        oil.intervals.push_back(Interval(BSON("" << 2 * j << "" << 2 * j), true, true));
+    }
+
+    for (int key = -1; key <= 2 * numPoints; ++key) {
+        BSONObj keyObj = BSON("" << key);
+        BSONElement keyElt = keyObj.firstElement();
+
+        size_t expectedIndex = 0;
+        IndexBoundsChecker::Location expected =
+            IndexBoundsChecker::findIntervalForField(keyElt, oil, 1, &expectedIndex);
+
+        for (size_t start = 0; start <= oil.intervals.size(); ++start) {
+            size_t index = 0;
+            IndexBoundsChecker::Location location =
+                IndexBoundsChecker::findIntervalForField(keyElt, oil, 1, start, &index);
+            ASSERT_EQUALS(toString(expected), toString(location))
+                << "key=" << key << "; start=" << start;
+            if (IndexBoundsChecker::AHEAD != expected) {
+                ASSERT_EQUALS(expectedIndex, index) << "key=" << key << "; start=" << start;
+            }
+        }
+    }
+}
+
+TEST(IndexBoundsCheckerTest, CheckKeyWalksManyPointIntervals) {
+    OrderedIntervalList oil("foo");
+    const int numPoints = 1000;
+    for (int j = 0; j < numPoints; ++j) {
+        oil.intervals.push_back(Interval(BSON("" << 3 * j << "" << 3 * j), true, true));
+    }
+    IndexBounds bounds;
+    bounds.fields.push_back(oil);
+    BSONObj idx = BSON("foo" << 1);
+    ASSERT(bounds.isValidFor(idx, 1));
+    IndexBoundsChecker it(&bounds, idx, 1);
+
+    IndexSeekPoint seekPoint;
+    ASSERT(it.getStartSeekPoint(&seekPoint));
+
+    // Walk every key up to the last point. Only multiples of three are within the bounds; the
+    // others must ask to advance to the next point.
+    for (int key = 0; key <= 3 * (numPoints - 1); ++key) {
+        IndexBoundsChecker::KeyState state = it.checkKey(BSON("" << key), &seekPoint);
+        if (key % 3 == 0) {
+            ASSERT_EQUALS(state, IndexBoundsChecker::VALID) << "key=" << key;
+        } else {
+            ASSERT_EQUALS(state, IndexBoundsChecker::MUST_ADVANCE) << "key=" << key;
+            ASSERT_EQUALS(seekPoint.prefixLen, 0);
+            ASSERT_EQUALS(seekPoint.keySuffix[0]->numberInt(), (key / 3 + 1) * 3);
+        }
+    }
+    ASSERT_EQUALS(it.checkKey(BSON("" << 3 * numPoints - 2), &seekPoint),
+                  IndexBoundsChecker::DONE);
+}
+
 }  // namespace
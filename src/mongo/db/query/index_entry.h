@@ -42,6 +42,7 @@
 namespace mongo {
 class CollatorInterface;
 class MatchExpression;
+class WildcardPathKeyCounts;
 class WildcardProjection;
 
 /**
@@ -248,6 +249,10 @@ struct IndexEntry : CoreIndexInfo {
 
     // Geo indices have extra parameters.  We need those available to plan correctly.
     BSONObj infoObj;
+
+    // For $** indexes which keep them, the number of keys for each indexed path. Owned by the
+    // index access method, like 'wildcardProjection'.
+    const WildcardPathKeyCounts* wildcardPathKeyCounts = nullptr;
 };
 
 std::ostream& operator<<(std::ostream& stream, const IndexEntry::Identifier& ident);
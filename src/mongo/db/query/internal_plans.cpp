@@ -181,8 +181,14 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> InternalPlanner::updateWith
     auto expCtx = make_intrusive<ExpressionContext>(
         opCtx, std::unique_ptr<CollatorInterface>(nullptr), collection->ns());
 
-    auto idHackStage =
-        std::make_unique<IDHackStage>(expCtx.get(), key, ws.get(), collection, descriptor);
+    std::unique_ptr<PlanStage> idHackStage;
+    if (descriptor) {
+        idHackStage =
+            std::make_unique<IDHackStage>(expCtx.get(), key, ws.get(), collection, descriptor);
+    } else {
+        idHackStage =
+            std::make_unique<ClusteredIDHackStage>(expCtx.get(), key, ws.get(), collection);
+    }
 
     const bool isUpsert = params.request->isUpsert();
     auto root = (isUpsert ? std::make_unique<UpsertStage>(
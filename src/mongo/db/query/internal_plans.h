@@ -114,7 +114,8 @@ public:
         Direction direction = FORWARD);
 
     /**
-     * Returns an IDHACK => UPDATE plan.
+     * Returns an IDHACK => UPDATE plan. A null 'descriptor' looks 'key' up in a clustered
+     * collection.
      */
     static std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> updateWithIdHack(
         OperationContext* opCtx,
@@ -170,6 +170,22 @@ public:
         return Status::OK();
     }
 
+    /**
+     * Removes the least recently used entry from the kv-store and passes its ownership to the
+     * caller. Returns nullptr if the kv-store is empty.
+     */
+    std::unique_ptr<V> removeLeastRecentlyUsed() {
+        if (_kvList.empty()) {
+            return std::unique_ptr<V>();
+        }
+
+        V* evictedEntry = _kvList.back().second;
+        _kvMap.erase(_kvList.back().first);
+        _kvList.pop_back();
+        _currentSize--;
+        return std::unique_ptr<V>(evictedEntry);
+    }
+
     /**
      * Deletes all entries in the kv-store.
      */
@@ -36,6 +36,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <array>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -63,6 +64,44 @@ namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
 
+/**
+ * Lookup and eviction counters of the plan cache partitions with a given index, summed over the
+ * plan caches of all collections.
+ */
+struct PartitionCounters {
+    Counter64 hits;
+    Counter64 misses;
+    Counter64 evictions;
+};
+std::array<PartitionCounters, PlanCache::kMaxNumPartitions> partitionCounters;
+
+/**
+ * Reports the plan cache counters as 'metrics.query.planCache' in serverStatus, both in total and
+ * broken down per partition.
+ */
+class PlanCachePartitionMetrics final : public ServerStatusMetric {
+public:
+    PlanCachePartitionMetrics() : ServerStatusMetric("query.planCache") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const final {
+        long long hits = 0, misses = 0, evictions = 0;
+        BSONObjBuilder sub(b.subobjStart(_leafName));
+        BSONArrayBuilder partitions(sub.subarrayStart("partitions"));
+        for (auto&& counters : partitionCounters) {
+            partitions.append(BSON("hits" << counters.hits.get() << "misses"
+                                          << counters.misses.get() << "evictions"
+                                          << counters.evictions.get()));
+            hits += counters.hits.get();
+            misses += counters.misses.get();
+            evictions += counters.evictions.get();
+        }
+        partitions.doneFast();
+        sub.append("hits", hits);
+        sub.append("misses", misses);
+        sub.append("evictions", evictions);
+    }
+} planCachePartitionMetrics;
+
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
 const char kEncodeDiscriminatorsEnd = '>';
@@ -425,10 +464,20 @@ std::string SolutionCacheData::toString() const {
 
 PlanCache::PlanCache() : PlanCache(internalQueryCacheSize.load()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size) {
+    const auto numPartitions = std::clamp<size_t>(size / kMinPartitionSize, 1, kMaxNumPartitions);
+    const auto partitionSize = (size + numPartitions - 1) / numPartitions;
+    for (size_t i = 0; i < numPartitions; ++i) {
+        _partitions.push_back(std::make_unique<Partition>(partitionSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
+size_t PlanCache::partitionIndex(const PlanCacheKey& key) const {
+    return PlanCacheKeyHasher{}(key) % _partitions.size();
+}
+
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
 
     PlanCache::GetResult res = get(key);
@@ -592,7 +641,9 @@ Status PlanCache::set(const CanonicalQuery& query,
 
         why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    const auto partitionIdx = partitionIndex(key);
+    auto& partition = *_partitions[partitionIdx];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     bool isNewEntryActive = false;
     uint32_t queryHash;
     uint32_t planCacheKey;
@@ -603,7 +654,7 @@ Status PlanCache::set(const CanonicalQuery& query,
         queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
     } else {
         PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
+        Status cacheStatus = partition.cache.get(key, &oldEntry);
         invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
         if (oldEntry) {
             queryHash = oldEntry->queryHash;
@@ -630,9 +681,10 @@ Status PlanCache::set(const CanonicalQuery& query,
     auto newEntry(PlanCacheEntry::create(
         solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, newEntry.release());
 
     if (nullptr != evictedEntry.get()) {
+        partitionCounters[partitionIdx].evictions.increment();
         LOGV2_DEBUG(20942,
                     1,
                     "{namespace}: plan cache maximum size exceeded - removed least recently used "
@@ -642,6 +694,23 @@ Status PlanCache::set(const CanonicalQuery& query,
                     "evictedEntry"_attr = redact(evictedEntry->toString()));
     }
 
+    // The byte budget is shared by the plan caches of all collections, but it is enforced by the
+    // inserting cache, which evicts its own least recently used entries until the total is back
+    // under the budget. The entry which has just been added is never evicted.
+    const auto maxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    while (maxSizeBytes > 0 &&
+           PlanCacheEntry::planCacheTotalSizeEstimateBytes.get() > maxSizeBytes &&
+           partition.cache.size() > 1) {
+        evictedEntry = partition.cache.removeLeastRecentlyUsed();
+        partitionCounters[partitionIdx].evictions.increment();
+        LOGV2_DEBUG(5150900,
+                    1,
+                    "Plan cache maximum size in bytes exceeded - removed least recently used entry",
+                    "namespace"_attr = query.nss(),
+                    "maxSizeBytes"_attr = maxSizeBytes,
+                    "evictedEntry"_attr = redact(evictedEntry->toString()));
+    }
+
     return Status::OK();
 }
 
@@ -652,9 +721,10 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
         return;
@@ -669,28 +739,40 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    const auto partitionIdx = partitionIndex(key);
+    auto& partition = *_partitions[partitionIdx];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         invariant(cacheStatus == ErrorCodes::NoSuchKey);
+        partitionCounters[partitionIdx].misses.increment();
         return {CacheEntryState::kNotPresent, nullptr};
     }
     invariant(entry);
 
+    // Only an active entry can be used for planning, so an inactive one is counted as a miss.
+    auto& counter = entry->isActive ? partitionCounters[partitionIdx].hits
+                                    : partitionCounters[partitionIdx].misses;
+    counter.increment();
+
     auto state =
         entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
     return {state, std::make_unique<CachedSolution>(key, *entry)};
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    const auto key = computeKey(canonicalQuery);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -704,9 +786,10 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto& partition = *_partitions[partitionIndex(key)];
+    stdx::lock_guard<Latch> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -716,20 +799,26 @@ StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQ
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
 
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            auto entry = cacheEntry.second;
+            entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
+        }
     }
 
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -740,13 +829,15 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
 
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
-        if (filterFunc(serializedEntry)) {
-            results.push_back(serializedEntry);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> cacheLock(partition->mutex);
+        for (auto&& cacheEntry : partition->cache) {
+            const auto entry = cacheEntry.second;
+            auto serializedEntry = serializationFunc(*entry);
+            if (filterFunc(serializedEntry)) {
+                results.push_back(serializedEntry);
+            }
         }
     }
 
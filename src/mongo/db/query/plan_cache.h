@@ -375,6 +375,13 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    /**
+     * Returns the approximate deep size of this entry in bytes.
+     */
+    uint64_t estimatedEntrySizeBytes() const {
+        return _entireObjectSize;
+    }
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -452,6 +459,13 @@ public:
      */
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
+    // The cache is split into independently locked partitions by the hash of the cache key, so
+    // that concurrent lookups of different query shapes do not contend on a single mutex. Small
+    // caches use fewer partitions so that each partition is still large enough for its LRU policy
+    // to be meaningful.
+    static constexpr size_t kMaxNumPartitions = 16;
+    static constexpr size_t kMinPartitionSize = 256;
+
     /**
      * If omitted, namespace set to empty string.
      */
@@ -582,10 +596,24 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    /**
+     * An independently locked and evicted part of the cache.
+     */
+    struct Partition {
+        explicit Partition(size_t size) : cache(size) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Protects 'cache'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+    };
+
+    /**
+     * Returns the index of the partition which holds the entry for 'key'.
+     */
+    size_t partitionIndex(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
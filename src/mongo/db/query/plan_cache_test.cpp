@@ -572,6 +572,28 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheHoldsEntriesForAllShapes) {
+    // Large enough for the cache to be split into the maximum number of partitions.
+    PlanCache planCache(PlanCache::kMaxNumPartitions * PlanCache::kMinPartitionSize);
+    QueryTestServiceContext serviceContext;
+
+    const std::vector<std::string> fields{"a", "b", "c", "d", "e", "f", "g", "h"};
+    for (auto&& field : fields) {
+        unique_ptr<CanonicalQuery> cq(canonicalize(BSON(field << 1)));
+        addCacheEntryForShape(*cq.get(), &planCache);
+    }
+    ASSERT_EQ(planCache.size(), fields.size());
+    ASSERT_EQ(planCache.getAllEntries().size(), fields.size());
+
+    for (auto&& field : fields) {
+        unique_ptr<CanonicalQuery> cq(canonicalize(BSON(field << 1)));
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -2358,6 +2380,29 @@ TEST(PlanCacheTest, PlanCacheSizeWithCRUDOperations) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PlanCacheEvictsEntriesOverByteBudget) {
+    // Use a cache small enough to have a single partition.
+    PlanCache planCache(PlanCache::kMinPartitionSize);
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get(), qs.get()};
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1, c: 1}"));
+    ASSERT_OK(planCache.set(*cqA, solns, createDecision(2U), Date_t{}));
+    ASSERT_EQ(planCache.size(), 1U);
+
+    // Set the byte budget so that it is already exhausted by the existing plan cache entries.
+    const auto oldMaxSizeBytes = internalQueryCacheMaxSizeBytes.load();
+    internalQueryCacheMaxSizeBytes.store(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get());
+    ON_BLOCK_EXIT([&] { internalQueryCacheMaxSizeBytes.store(oldMaxSizeBytes); });
+
+    // Adding another entry goes over the budget, so the least recently used entry is evicted.
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1, c: 1}"));
+    ASSERT_OK(planCache.set(*cqB, solns, createDecision(2U), Date_t{}));
+    ASSERT_EQ(planCache.size(), 1U);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_NE(planCache.get(*cqB).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
 TEST(PlanCacheTest, PlanCacheSizeWithEviction) {
     const size_t kCacheSize = 5;
     PlanCache planCache(kCacheSize);
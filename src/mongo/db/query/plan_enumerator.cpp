@@ -260,7 +260,8 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
       _indices(params.indices),
       _ixisect(params.intersect),
       _orLimit(params.maxSolutionsPerOr),
-      _intersectLimit(params.maxIntersectPerAnd) {}
+      _intersectLimit(params.maxIntersectPerAnd),
+      _skipScanIndices(params.skipScanIndices) {}
 
 PlanEnumerator::~PlanEnumerator() {
     typedef stdx::unordered_map<MemoID, NodeAssignment*> MemoMap;
@@ -987,6 +988,35 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    // An index which no predicate can use the leading field of may still be skip-scanned. The
+    // bounds on the leading field are left to cover all values, and the index scan seeks from one
+    // value of the leading field directly to the bounds of the trailing fields under the next.
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        if (idxToFirst.find(it->first) != idxToFirst.end() ||
+            _skipScanIndices.find(it->first) == _skipScanIndices.end()) {
+            continue;
+        }
+
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+
+        // Only non-multikey indexes are skip-scanned, so all preds can be assigned.
+        invariant(!thisIndex.multikey);
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+        for (auto pred : it->second) {
+            assignPredicate(outsidePreds, pred, getPosition(thisIndex, pred), &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (!indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
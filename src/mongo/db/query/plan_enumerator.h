@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <set>
 #include <vector>
 
 #include "mongo/base/status.h"
@@ -65,6 +66,10 @@ struct PlanEnumeratorParams {
     // all-pairs approach, we could wind up creating a lot of enumeration possibilities for
     // certain inputs.
     size_t maxIntersectPerAnd;
+
+    // Positions in 'indices' of the indexes which may be assigned predicates over their trailing
+    // fields alone. The resulting scans skip from one value of the leading field to the next.
+    std::set<size_t> skipScanIndices;
 };
 
 /**
@@ -556,6 +561,9 @@ private:
 
     // How many things do we want from each AND?
     size_t _intersectLimit;
+
+    // Indices we may use without a predicate over their leading field.
+    std::set<size_t> _skipScanIndices;
 };
 
 }  // namespace mongo
@@ -40,9 +40,12 @@
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/s2_common.h"
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/query/expression_index_knobs_gen.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
@@ -135,6 +138,31 @@ std::vector<bool> canProvideSortWithMergeSort(
     return shouldReverseScan;
 }
 
+/**
+ * If 'expr' is a geo predicate whose bounds over the 'keyElt' field of 'index' are a covering of
+ * its region in a version 3 2dsphere index, makes 'isn' skip the keys whose cells the region does
+ * not intersect.
+ */
+void setS2KeyFilter(const MatchExpression* expr,
+                    const BSONElement& keyElt,
+                    const IndexEntry& index,
+                    size_t pos,
+                    IndexScanNode* isn) {
+    if (MatchExpression::GEO != expr->matchType() || "2dsphere" != keyElt.valueStringDataSafe() ||
+        !gInternalQueryS2GeoFilterIndexKeys.load()) {
+        return;
+    }
+
+    S2IndexingParams params;
+    ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &params);
+    if (params.indexVersion < S2_INDEX_VERSION_3) {
+        return;
+    }
+
+    isn->s2KeyFilter = static_cast<const GeoMatchExpression*>(expr)->getSharedGeoExpression();
+    isn->s2KeyFilterPosition = pos;
+}
+
 }  // namespace
 
 namespace mongo {
@@ -335,6 +363,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeLeafNode(
         verify(!keyElt.eoo());
 
         IndexBoundsBuilder::translate(expr, keyElt, index, &isn->bounds.fields[pos], tightnessOut);
+        setS2KeyFilter(expr, keyElt, index, pos, isn.get());
 
         return std::move(isn);
     }
@@ -493,6 +522,12 @@ void QueryPlannerAccess::mergeWithLeafNode(MatchExpression* expr, ScanBuildingSt
             return;
         }
 
+        // Keys which only the other branches of an $or can match must not be filtered out by the
+        // region of this one.
+        if (MatchExpression::OR == mergeType) {
+            scan->s2KeyFilter.reset();
+        }
+
         boundsToFillOut = &scan->bounds;
     }
 
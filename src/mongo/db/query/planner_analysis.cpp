@@ -40,6 +40,7 @@
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/logv2/log.h"
@@ -714,6 +715,21 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
 
     // If we're here, we need to add a sort stage.
 
+    // The child may still provide the order of some leading fields of the sort pattern, in which
+    // case the sort stage only has to sort each run of results sharing those fields.
+    size_t sortedPrefixLength = 0;
+    if (internalQueryPlannerEnableSortWithinIndexPrefix.load()) {
+        size_t numFields = sortObj.nFields();
+        BSONObjBuilder prefixBob;
+        BSONObjIterator it(sortObj);
+        for (size_t i = 1; i < numFields; ++i) {
+            prefixBob.append(it.next());
+            if (providedSorts.contains(prefixBob.asTempObj())) {
+                sortedPrefixLength = i;
+            }
+        }
+    }
+
     if (!solnRoot->fetched()) {
         const bool sortIsCovered =
             std::all_of(sortObj.begin(), sortObj.end(), [solnRoot](BSONElement e) {
@@ -738,6 +754,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNode = std::make_unique<SortNodeDefault>();
     }
     sortNode->pattern = sortObj;
+    sortNode->sortedPrefixLength = sortedPrefixLength;
     sortNode->children.push_back(solnRoot);
     sortNode->addSortKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kSortKey];
     solnRoot = sortNode.release();
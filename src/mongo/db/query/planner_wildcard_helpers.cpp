@@ -33,12 +33,14 @@
 
 #include "mongo/db/query/planner_wildcard_helpers.h"
 
+#include <limits>
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/projection_executor_utils.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/query/index_bounds.h"
+#include "mongo/db/query/wildcard_path_key_counts.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -411,6 +413,7 @@ void expandWildcardIndexEntry(const IndexEntry& wildcardIndex,
                          wildcardIndex.infoObj,
                          wildcardIndex.collator,
                          wildcardIndex.wildcardProjection);
+        entry.wildcardPathKeyCounts = wildcardIndex.wildcardPathKeyCounts;
 
         invariant("$_path"_sd != fieldName);
         out->push_back(std::move(entry));
@@ -526,5 +529,80 @@ bool isWildcardObjectSubpathScan(const IndexScanNode* node) {
     return boundsOverlapObjectTypeBracket(node->bounds.fields.back());
 }
 
+boost::optional<long long> estimateWildcardIndexScanKeys(const IndexScanNode* node) {
+    if (!node->index.wildcardPathKeyCounts || isWildcardObjectSubpathScan(node)) {
+        return boost::none;
+    }
+
+    // Without subpath bounds, the bounds on '$_path' are a point interval for each of the paths
+    // that the scan reads.
+    long long numKeys = 0;
+    for (const auto& interval : node->bounds.fields.front().intervals) {
+        if (!interval.isPoint() || interval.start.type() != BSONType::String) {
+            return boost::none;
+        }
+        auto pathKeys = node->index.wildcardPathKeyCounts->get(interval.start.valueStringData());
+        if (!pathKeys) {
+            return boost::none;
+        }
+        numKeys += *pathKeys;
+    }
+    return numKeys;
+}
+
+void pruneWildcardSolutionsByPathKeyCount(std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (solutions->size() < 2) {
+        return;
+    }
+
+    // Returns the index scan of 'solution' if it is the only leaf of the solution.
+    auto singleIndexScan = [](const QuerySolution& solution) -> const IndexScanNode* {
+        const QuerySolutionNode* node = solution.root.get();
+        while (node->children.size() == 1) {
+            node = node->children.front();
+        }
+        if (!node->children.empty() || node->getType() != STAGE_IXSCAN) {
+            return nullptr;
+        }
+        return static_cast<const IndexScanNode*>(node);
+    };
+
+    const std::string* catalogName = nullptr;
+    size_t best = 0;
+    long long bestNumKeys = std::numeric_limits<long long>::max();
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        // A covered solution could be worth more than the keys it saves.
+        const auto& solution = *(*solutions)[i];
+        if (!solution.root->fetched()) {
+            return;
+        }
+
+        const IndexScanNode* scan = singleIndexScan(solution);
+        if (!scan || scan->index.type != IndexType::INDEX_WILDCARD ||
+            (catalogName && *catalogName != scan->index.identifier.catalogName)) {
+            return;
+        }
+        catalogName = &scan->index.identifier.catalogName;
+
+        auto numKeys = estimateWildcardIndexScanKeys(scan);
+        if (!numKeys) {
+            return;
+        }
+        if (*numKeys < bestNumKeys) {
+            best = i;
+            bestNumKeys = *numKeys;
+        }
+    }
+
+    LOGV2_DEBUG(5155013,
+                5,
+                "Planner: keeping only the $** index scan over the paths with the fewest keys",
+                "numSolutions"_attr = solutions->size(),
+                "numKeys"_attr = bestNumKeys);
+    auto bestSolution = std::move((*solutions)[best]);
+    solutions->clear();
+    solutions->push_back(std::move(bestSolution));
+}
+
 }  // namespace wildcard_planning
 }  // namespace mongo
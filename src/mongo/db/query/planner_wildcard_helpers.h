@@ -89,5 +89,18 @@ bool isWildcardObjectSubpathScan(const IndexScanNode* node);
  */
 bool requiresSubpathBounds(const OrderedIntervalList& intervals);
 
+/**
+ * Returns the number of keys of the paths that 'node', a finalized $** index scan, reads, or
+ * boost::none if its index does not count its keys per path or the scan also reads subpaths.
+ */
+boost::optional<long long> estimateWildcardIndexScanKeys(const IndexScanNode* node);
+
+/**
+ * If every solution in 'solutions' fetches its results from a single scan over different paths of
+ * the same $** index, and that index counts its keys per path, keeps only the solution whose scan
+ * reads the fewest keys so that the query does not need to be multi-planned.
+ */
+void pruneWildcardSolutionsByPathKeyCount(std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
 }  // namespace wildcard_planning
 }  // namespace mongo
@@ -45,13 +45,17 @@
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/cardinality_estimator.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/planner_wildcard_helpers.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
@@ -97,12 +101,60 @@ Status tagOrChildAccordingToCache(PlanCacheIndexTree* compositeCacheData,
 
     return Status::OK();
 }
+
+/**
+ * Returns true if 'index' may be scanned for predicates over its trailing fields alone, skipping
+ * from one value of its leading field to the next. Each skip costs a seek, so unless the index was
+ * hinted and would be scanned anyway, the histograms of the collection must show that the leading
+ * field has at most internalQueryPlannerMaxDistinctValuesForSkipScan distinct values.
+ */
+bool canSkipScan(const IndexEntry& index, const QueryPlannerParams& params, bool isHinted) {
+    const long long maxDistinctValues = internalQueryPlannerMaxDistinctValuesForSkipScan.load();
+    if (maxDistinctValues <= 0) {
+        return false;
+    }
+
+    // Predicates over multikey fields cannot always be assigned together, sparse and partial
+    // indexes do not hold every document, and the histograms do not apply to indexes with a
+    // collation.
+    if (index.type != IndexType::INDEX_BTREE || index.multikey || index.sparse ||
+        index.filterExpr || index.collator || index.keyPattern.nFields() < 2) {
+        return false;
+    }
+
+    if (isHinted) {
+        return true;
+    }
+
+    if (!params.collectionStatistics) {
+        return false;
+    }
+    const auto* histogram = params.collectionStatistics->getHistogram(
+        index.keyPattern.firstElementFieldNameStringData());
+    return histogram && histogram->numDistinctValues() <= maxDistinctValues;
+}
+
+/**
+ * Returns true if the query has a predicate over any field of 'index' other than the leading one.
+ */
+bool hasPredicateOverTrailingField(const IndexEntry& index,
+                                   const stdx::unordered_set<std::string>& fields) {
+    BSONObjIterator it(index.keyPattern);
+    it.next();
+    while (it.more()) {
+        if (fields.count(it.next().fieldName())) {
+            return true;
+        }
+    }
+    return false;
+}
 }  // namespace
 
 using std::numeric_limits;
 using std::unique_ptr;
 
 namespace dps = ::mongo::dotted_path_support;
+namespace wcp = ::mongo::wildcard_planning;
 
 // Copied verbatim from db/index.h
 static bool isIdIndex(const BSONObj& pattern) {
@@ -702,6 +754,15 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
 
     if (!hintedIndexEntry) {
         relevantIndices = QueryPlannerIXSelect::findRelevantIndices(fields, fullIndexList);
+
+        // An index the query does not use the leading field of is also relevant if it can be
+        // skip-scanned for the predicates over its other fields.
+        for (auto&& entry : fullIndexList) {
+            if (!fields.count(entry.keyPattern.firstElementFieldName()) &&
+                hasPredicateOverTrailingField(entry, fields) && canSkipScan(entry, params, false)) {
+                relevantIndices.push_back(entry);
+            }
+        }
     } else {
         relevantIndices = fullIndexList;
 
@@ -871,6 +932,11 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         enumParams.intersect = params.options & QueryPlannerParams::INDEX_INTERSECTION;
         enumParams.root = query.root();
         enumParams.indices = &relevantIndices;
+        for (size_t i = 0; i < relevantIndices.size(); ++i) {
+            if (canSkipScan(relevantIndices[i], params, hintedIndexEntry.has_value())) {
+                enumParams.skipScanIndices.insert(i);
+            }
+        }
 
         PlanEnumerator isp(enumParams);
         isp.init().transitional_ignore();
@@ -1068,6 +1134,19 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // Rather than multi-planning the scans of several paths of one $** index, use the path with
+    // the fewest keys when the index counts them. Sorted queries may prefer a path for its order.
+    if (!out.empty() && query.getQueryRequest().getSort().isEmpty()) {
+        wcp::pruneWildcardSolutionsByPathKeyCount(&out);
+    }
+
+    // Similarly, when the histograms of the collection show that one index scan reads far fewer
+    // keys than the others, there is no need to race them.
+    if (!out.empty() && params.collectionStatistics &&
+        query.getQueryRequest().getSort().isEmpty()) {
+        cardinality_estimation::pruneSolutionsByEstimatedKeys(*params.collectionStatistics, &out);
+    }
+
     // If a projection exists, there may be an index that allows for a covered plan, even if none
     // were considered earlier.
     const auto projection = query.getProj();
@@ -31,13 +31,32 @@
 
 #include "mongo/db/matcher/expression_always_boolean.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
 
+/**
+ * Returns statistics with a histogram of 1000 documents for each of 'a', whose values are distinct,
+ * and 'b', where 900 documents have the value 1.
+ */
+std::shared_ptr<const CollectionStatistics> makeStatisticsOfAAndB() {
+    std::vector<BSONObj> aKeys;
+    std::vector<BSONObj> bKeys;
+    for (int i = 0; i < 1000; ++i) {
+        aKeys.push_back(BSON("" << i));
+        bKeys.push_back(BSON("" << (i < 900 ? 1 : i)));
+    }
+    return std::make_shared<const CollectionStatistics>(
+        CollectionStatistics()
+            .withHistogram("a", FieldHistogram::make(std::move(aKeys), 1000, 1000, 10))
+            .withHistogram("b", FieldHistogram::make(std::move(bKeys), 1000, 1000, 10)));
+}
 
 TEST_F(QueryPlannerTest, PlannerUsesCoveredIxscanForCountWhenIndexSatisfiesQuery) {
     params.options = QueryPlannerParams::IS_COUNT;
@@ -1308,6 +1327,46 @@ TEST_F(QueryPlannerTest, MustFetchWhenNotAllSortKeysAreCoveredByIndex) {
         "{pattern: {a: 1, b: 1}}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SortRecordsPrefixProvidedByIndex) {
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(fromjson("{a: 1, b: 1}"));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: {$gt: 0}}, sort: {a: 1, b: 1, c: -1}, limit: 50}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1, b: 1, c: -1}, limit: 50, type: 'simple', sortedPrefixLength: 2, "
+        "node: {fetch: {node: {ixscan: {pattern: {a: 1, b: 1}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SortRecordsNoPrefixWhenIndexDoesNotProvideLeadingField) {
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(fromjson("{a: 1, b: 1}"));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: {$gt: 0}}, sort: {b: 1, a: 1, c: 1}, limit: 50}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {pattern: {b: 1, a: 1, c: 1}, limit: 50, type: 'simple', sortedPrefixLength: 0, "
+        "node: {fetch: {node: {ixscan: {pattern: {a: 1, b: 1}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SortRecordsNoPrefixWhenSortWithinIndexPrefixIsDisabled) {
+    internalQueryPlannerEnableSortWithinIndexPrefix.store(false);
+    ON_BLOCK_EXIT([] { internalQueryPlannerEnableSortWithinIndexPrefix.store(true); });
+    params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
+    addIndex(fromjson("{a: 1}"));
+
+    runQueryAsCommand(fromjson("{find: 'testns', filter: {a: {$gt: 0}}, sort: {a: 1, b: -1}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{sort: {pattern: {a: 1, b: -1}, limit: 0, type: 'simple', sortedPrefixLength: 0, "
+        "node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, NoFetchStageWhenProjectionUsesExpressionWithCoveredDependency) {
     params.options &= ~QueryPlannerParams::INCLUDE_COLLSCAN;
     addIndex(fromjson("{a: 1, b: 1}"));
@@ -1426,5 +1485,90 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, IndexScanEstimatedToReadFarFewerKeysIsTheOnlySolution) {
+    params.collectionStatistics = makeStatisticsOfAAndB();
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    runQuery(fromjson("{a: 5, b: 1}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 1}, node: {ixscan: {pattern: {a: 1}, "
+        "bounds: {a: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, IndexScansWithCloseKeyEstimatesAreAllSolutions) {
+    params.collectionStatistics = makeStatisticsOfAAndB();
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    // About 200 keys of 'a' against 900 keys of 'b'.
+    runQuery(fromjson("{a: {$lt: 200}, b: 1}"));
+    assertNumSolutions(2U);
+}
+
+TEST_F(QueryPlannerTest, IndexScanOverFieldWithoutHistogramIsNotEstimated) {
+    params.collectionStatistics = makeStatisticsOfAAndB();
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("c" << 1));
+
+    runQuery(fromjson("{a: 5, c: 1}"));
+    assertNumSolutions(2U);
+}
+
+TEST_F(QueryPlannerTest, SortedQueryIsNotPrunedByKeyEstimates) {
+    params.collectionStatistics = makeStatisticsOfAAndB();
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    runQuerySortProj(fromjson("{a: 5, b: 1}"), BSON("b" << 1), BSONObj());
+    assertNumSolutions(2U);
+}
+
+TEST_F(QueryPlannerTest, CompoundIndexIsSkipScannedWhenLeadingFieldHasFewDistinctValues) {
+    internalQueryPlannerMaxDistinctValuesForSkipScan.store(10);
+    ON_BLOCK_EXIT([] { internalQueryPlannerMaxDistinctValuesForSkipScan.store(0); });
+
+    std::vector<BSONObj> cKeys;
+    for (int i = 0; i < 1000; ++i) {
+        cKeys.push_back(BSON("" << i % 4));
+    }
+    params.collectionStatistics = std::make_shared<const CollectionStatistics>(
+        CollectionStatistics().withHistogram(
+            "c", FieldHistogram::make(std::move(cKeys), 1000, 1000, 10)));
+    addIndex(BSON("c" << 1 << "b" << 1));
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {c: 1, b: 1}, "
+        "bounds: {c: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CompoundIndexIsNotSkipScannedWhenLeadingFieldHasManyDistinctValues) {
+    internalQueryPlannerMaxDistinctValuesForSkipScan.store(10);
+    ON_BLOCK_EXIT([] { internalQueryPlannerMaxDistinctValuesForSkipScan.store(0); });
+
+    params.collectionStatistics = makeStatisticsOfAAndB();
+    addIndex(BSON("a" << 1 << "c" << 1));
+
+    runQuery(fromjson("{c: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, HintedCompoundIndexIsSkipScannedWithoutStatistics) {
+    internalQueryPlannerMaxDistinctValuesForSkipScan.store(10);
+    ON_BLOCK_EXIT([] { internalQueryPlannerMaxDistinctValuesForSkipScan.store(0); });
+
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQueryHint(fromjson("{b: {$gt: 5}}"), BSON("a" << 1 << "b" << 1));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,Infinity,false,true]]}}}}}");
+}
+
 }  // namespace
 }  // namespace mongo
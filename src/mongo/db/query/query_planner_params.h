@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "mongo/db/jsobj.h"
@@ -37,6 +38,8 @@
 
 namespace mongo {
 
+class CollectionStatistics;
+
 struct QueryPlannerParams {
     QueryPlannerParams()
         : options(DEFAULT),
@@ -117,6 +120,10 @@ struct QueryPlannerParams {
     // plans via the MultiPlanStage, and the set of possible plans is very large for certain
     // index+query combinations.
     size_t maxIndexedSolutions;
+
+    // The histograms of the collection, if the planner should estimate the keys that its index
+    // scans read.
+    std::shared_ptr<const CollectionStatistics> collectionStatistics;
 };
 
 }  // namespace mongo
@@ -637,7 +637,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
         BSONObj sortObj = el.Obj();
-        invariant(bsonObjFieldsAreInSet(sortObj, {"pattern", "limit", "type", "node"}));
+        invariant(bsonObjFieldsAreInSet(
+            sortObj, {"pattern", "limit", "type", "sortedPrefixLength", "node"}));
 
         BSONElement patternEl = sortObj["pattern"];
         if (patternEl.eoo() || !patternEl.isABSONObj()) {
@@ -672,6 +673,14 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement prefixEl = sortObj["sortedPrefixLength"];
+        if (prefixEl) {
+            if (!prefixEl.isNumber() ||
+                static_cast<size_t>(prefixEl.numberInt()) != sn->sortedPrefixLength) {
+                return false;
+            }
+        }
+
         BSONElement child = sortObj["node"];
         if (child.eoo() || !child.isABSONObj()) {
             return false;
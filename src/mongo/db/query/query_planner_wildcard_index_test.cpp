@@ -33,6 +33,7 @@
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
+#include "mongo/db/query/wildcard_path_key_counts.h"
 #include "mongo/unittest/death_test.h"
 
 namespace mongo {
@@ -87,7 +88,17 @@ protected:
                                   _proj.get_ptr()});
     }
 
+    /**
+     * Makes the last $** index added count its keys per path, with the given counts.
+     */
+    void setPathKeyCounts(const StringMap<long long>& counts) {
+        _pathKeyCounts.startFromEmptyIndex();
+        _pathKeyCounts.add(counts);
+        params.indices.back().wildcardPathKeyCounts = &_pathKeyCounts;
+    }
+
     boost::optional<WildcardProjection> _proj;
+    WildcardPathKeyCounts _pathKeyCounts;
 };
 
 //
@@ -546,6 +557,55 @@ TEST_F(QueryPlannerWildcardTest, AndEqualityWithTwoPredicatesIndexesOnePath) {
         "bounds: {'$_path': [['a','a',true,true]], a: [[5,5,true,true]]}}}}}");
 }
 
+TEST_F(QueryPlannerWildcardTest, AndEqualityWithTwoPredicatesUsesPathWithFewestKeys) {
+    addWildcardIndex(BSON("$**" << 1));
+    setPathKeyCounts({{"a", 100}, {"b", 3}});
+    runQuery(fromjson("{a: 5, b: 10}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {a: {$eq: 5}}, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': 1, b: 1},"
+        "bounds: {'$_path': [['b','b',true,true]], b: [[10,10,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, PathWithoutKeysIsPreferredOverCountedPaths) {
+    addWildcardIndex(BSON("$**" << 1));
+    setPathKeyCounts({{"a", 100}, {"b", 3}});
+    runQuery(fromjson("{a: 5, b: 10, c: {$gt: 1}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {$and: [{a: {$eq: 5}}, {b: {$eq: 10}}]}, node: "
+        "{ixscan: {filter: null, pattern: {'$_path': 1, c: 1},"
+        "bounds: {'$_path': [['c','c',true,true]], c: [[1,Infinity,false,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerWildcardTest, IncompletePathKeyCountsDoNotPruneSolutions) {
+    addWildcardIndex(BSON("$**" << 1));
+    params.indices.back().wildcardPathKeyCounts = &_pathKeyCounts;
+    runQuery(fromjson("{a: 5, b: 10}"));
+
+    assertNumSolutions(2U);
+}
+
+TEST_F(QueryPlannerWildcardTest, PathKeyCountsDoNotPruneSortedQueries) {
+    addWildcardIndex(BSON("$**" << 1));
+    setPathKeyCounts({{"a", 100}, {"b", 3}});
+    runQuerySortProj(fromjson("{a: 5, b: 10}"), fromjson("{c: 1}"), BSONObj());
+
+    assertNumSolutions(2U);
+}
+
+TEST_F(QueryPlannerWildcardTest, PathKeyCountsDoNotPruneSolutionsOverOtherIndexes) {
+    addWildcardIndex(BSON("$**" << 1));
+    setPathKeyCounts({{"a", 100}, {"b", 3}});
+    addIndex(BSON("a" << 1));
+    runQuery(fromjson("{a: 5, b: 10}"));
+
+    assertNumSolutions(3U);
+}
+
 TEST_F(QueryPlannerWildcardTest, OrEqualityWithTwoPredicatesUsesTwoPaths) {
     addWildcardIndex(BSON("$**" << 1));
     runQuery(fromjson("{$or: [{a: 5}, {b: 10}]}"));
@@ -899,6 +899,8 @@ QuerySolutionNode* IndexScanNode::clone() const {
     copy->addKeyMetadata = this->addKeyMetadata;
     copy->bounds = this->bounds;
     copy->queryCollator = this->queryCollator;
+    copy->s2KeyFilter = this->s2KeyFilter;
+    copy->s2KeyFilterPosition = this->s2KeyFilterPosition;
 
     return copy;
 }
@@ -1052,6 +1054,10 @@ void SortNode::appendToString(str::stream* ss, int indent) const {
     *ss << "pattern = " << pattern.toString() << '\n';
     addIndent(ss, indent + 1);
     *ss << "limit = " << limit << '\n';
+    if (sortedPrefixLength > 0) {
+        addIndent(ss, indent + 1);
+        *ss << "sortedPrefixLength = " << sortedPrefixLength << '\n';
+    }
     addCommon(ss, indent);
     addIndent(ss, indent + 1);
     *ss << "Child:" << '\n';
@@ -1062,6 +1068,7 @@ void SortNode::cloneSortData(SortNode* copy) const {
     cloneBaseData(copy);
     copy->pattern = this->pattern;
     copy->limit = this->limit;
+    copy->sortedPrefixLength = this->sortedPrefixLength;
     copy->addSortKeyMetadata = this->addSortKeyMetadata;
 }
 
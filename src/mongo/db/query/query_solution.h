@@ -563,6 +563,8 @@ struct FetchNode : public QuerySolutionNode {
     QuerySolutionNode* clone() const;
 };
 
+class GeoExpression;
+
 struct IndexScanNode : public QuerySolutionNodeWithSortSet {
     IndexScanNode(IndexEntry index);
     virtual ~IndexScanNode() {}
@@ -606,6 +608,13 @@ struct IndexScanNode : public QuerySolutionNodeWithSortSet {
 
     const CollatorInterface* queryCollator;
 
+    // When set, the $geoWithin or $geoIntersects predicate which generated the bounds over the
+    // version 3 2dsphere field at 's2KeyFilterPosition' of the key pattern. The scan skips keys
+    // whose S2 cell does not intersect the predicate's region, since no matching document can be
+    // found through them.
+    std::shared_ptr<const GeoExpression> s2KeyFilter;
+    size_t s2KeyFilterPosition = 0;
+
     // The set of paths in the index key pattern which have at least one multikey path component, or
     // empty if the index either is not multikey or does not have path-level multikeyness metadata.
     //
@@ -820,6 +829,10 @@ struct SortNode : public QuerySolutionNodeWithSortSet {
     // Sum of both limit and skip count in the parsed query.
     size_t limit;
 
+    // The number of leading fields of 'pattern' by which the child's output is already ordered. If
+    // non-zero, only runs of results which share these fields need to be sorted.
+    size_t sortedPrefixLength = 0;
+
     bool addSortKeyMetadata = false;
 
 protected:
@@ -34,6 +34,7 @@
 
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
@@ -65,15 +66,19 @@ plan_ranker::CandidatePlan CachedSolutionPlanner::plan(
         return replan(false);
     }
 
+    // The trial run of the cached plan is bounded by 'maxReadsBeforeReplan' physical reads, so it
+    // stops as soon as the plan falls that far behind the cost it was cached with, instead of
+    // running to the end of a full multi-planning trial period.
     auto stats{candidate.root->getStats()};
     auto numReads{calculateNumberOfReads(stats.get())};
+    const auto maxReadsBeforeReplan{getMaxReadsBeforeReplan(_decisionReads)};
     // If the cached plan hit EOF quickly enough, or still as efficient as before, then no need to
     // replan. Finalize the cached plan and return it.
-    if (stats->common.isEOF || numReads <= _decisionReads) {
+    if (stats->common.isEOF || numReads < maxReadsBeforeReplan) {
         return finalizeExecutionPlan(std::move(stats), std::move(candidate));
     }
 
-    // If we're here, the trial period took more than 'maxReadsBeforeReplan' physical reads. This
+    // If we're here, the trial period took 'maxReadsBeforeReplan' physical reads or more. This
     // plan may not be efficient any longer, so we replan from scratch.
     LOGV2_DEBUG(
         2058001,
@@ -88,6 +93,11 @@ plan_ranker::CandidatePlan CachedSolutionPlanner::plan(
     return replan(true);
 }
 
+size_t CachedSolutionPlanner::getMaxReadsBeforeReplan(size_t decisionReads) {
+    return std::max<size_t>(
+        static_cast<size_t>(internalQueryCacheEvictionRatio.load() * decisionReads), 1);
+}
+
 plan_ranker::CandidatePlan CachedSolutionPlanner::finalizeExecutionPlan(
     std::unique_ptr<PlanStageStats> stats, plan_ranker::CandidatePlan candidate) const {
     // If the winning stage has exited early, clear the results queue and reopen the plan stage
@@ -57,6 +57,13 @@ public:
         std::vector<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>> roots)
         final;
 
+    /**
+     * Returns the number of physical reads a cached plan, which was originally cached with
+     * 'decisionReads' reads, may perform during its trial run before it is considered inefficient
+     * and the query is replanned.
+     */
+    static size_t getMaxReadsBeforeReplan(size_t decisionReads);
+
 private:
     /**
      * Finalizes the winning plan before passing it to the caller as a result of the planning.
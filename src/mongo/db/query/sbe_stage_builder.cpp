@@ -35,15 +35,18 @@
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/exec/sbe/stages/makeobj.h"
+#include "mongo/db/exec/sbe/stages/merge_join.h"
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/sort.h"
 #include "mongo/db/exec/sbe/stages/text_match.h"
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -54,6 +57,38 @@
 #include "mongo/db/query/sbe_stage_builder_projection.h"
 
 namespace mongo::stage_builder {
+namespace {
+void bindInputParams(const MatchExpression* expr, PlanStageData* data) {
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpression*>(expr);
+        if (auto paramId = comparison->getInputParamId()) {
+            if (auto it = data->inputParamToSlotMap.find(*paramId);
+                it != data->inputParamToSlotMap.end()) {
+                auto& accessor = data->inputParamAccessors[*paramId];
+                if (!accessor) {
+                    accessor = std::make_unique<sbe::value::OwnedValueAccessor>();
+                    data->ctx.pushCorrelated(it->second, accessor.get());
+                }
+
+                const auto& rhs = comparison->getData();
+                auto [tagView, valView] = sbe::bson::convertFrom(
+                    true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+                auto [tag, val] = sbe::value::copyValue(tagView, valView);
+                accessor->reset(true, tag, val);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < expr->numChildren(); ++i) {
+        bindInputParams(expr->getChild(i), data);
+    }
+}
+}  // namespace
+
+void bindInputParams(const CanonicalQuery& cq, PlanStageData* data) {
+    bindInputParams(cq.root(), data);
+}
+
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildCollScan(
     const QuerySolutionNode* root) {
     auto csn = static_cast<const CollectionScanNode*>(root);
@@ -63,7 +98,8 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildCollScan(
                          csn,
                          &_slotIdGenerator,
                          _yieldPolicy,
-                         _data.trialRunProgressTracker.get());
+                         _data.trialRunProgressTracker.get(),
+                         &_data.inputParamToSlotMap);
     _data.resultSlot = resultSlot;
     _data.recordIdSlot = recordIdSlot;
     _data.oplogTsSlot = oplogTsSlot;
@@ -86,6 +122,19 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildIndexScan(
     return std::move(stage);
 }
 
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildCountScan(
+    const QuerySolutionNode* root) {
+    auto csn = static_cast<const CountScanNode*>(root);
+    auto [slot, stage] = generateCountScan(_opCtx,
+                                           _collection,
+                                           csn,
+                                           &_slotIdGenerator,
+                                           _yieldPolicy,
+                                           _data.trialRunProgressTracker.get());
+    _data.recordIdSlot = slot;
+    return std::move(stage);
+}
+
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::makeLoopJoinForFetch(
     std::unique_ptr<sbe::PlanStage> inputStage, sbe::value::SlotId recordIdKeySlot) {
     _data.resultSlot = _slotIdGenerator.generate();
@@ -122,8 +171,11 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildFetch(const QuerySol
     auto stage = makeLoopJoinForFetch(std::move(inputStage), *_data.recordIdSlot);
 
     if (fn->filter) {
-        stage = generateFilter(
-            fn->filter.get(), std::move(stage), &_slotIdGenerator, *_data.resultSlot);
+        stage = generateFilter(fn->filter.get(),
+                               std::move(stage),
+                               &_slotIdGenerator,
+                               *_data.resultSlot,
+                               &_data.inputParamToSlotMap);
     }
 
     return stage;
@@ -240,7 +292,10 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildSort(const QuerySolu
                                       std::move(values),
                                       sn->limit ? sn->limit
                                                 : std::numeric_limits<std::size_t>::max(),
-                                      _data.trialRunProgressTracker.get());
+                                      _cq.getExpCtx()->allowDiskUse,
+                                      _cq.getExpCtx()->tempDir,
+                                      _data.trialRunProgressTracker.get(),
+                                      sn->sortedPrefixLength);
 }
 
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildSortKeyGeneraror(
@@ -315,8 +370,11 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildOr(const QuerySoluti
                                              sbe::makeSV(*_data.resultSlot, *_data.recordIdSlot));
 
     if (orn->dedup) {
-        stage = sbe::makeS<sbe::HashAggStage>(
-            std::move(stage), sbe::makeSV(*_data.recordIdSlot), sbe::makeEM());
+        stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                              sbe::makeSV(*_data.recordIdSlot),
+                                              sbe::makeEM(),
+                                              _cq.getExpCtx()->allowDiskUse,
+                                              _cq.getExpCtx()->tempDir);
     }
 
     if (orn->filter) {
@@ -395,8 +453,11 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildText(const QuerySolu
     // TODO: If text score metadata is requested, then we should sum over the text scores inside the
     // index keys for a given document. This will require expression evaluation to be able to
     // extract the score directly from the key string.
-    auto hashAggStage = sbe::makeS<sbe::HashAggStage>(
-        std::move(unionStage), sbe::makeSV(*_data.recordIdSlot), sbe::makeEM());
+    auto hashAggStage = sbe::makeS<sbe::HashAggStage>(std::move(unionStage),
+                                                      sbe::makeSV(*_data.recordIdSlot),
+                                                      sbe::makeEM(),
+                                                      _cq.getExpCtx()->allowDiskUse,
+                                                      _cq.getExpCtx()->tempDir);
 
     auto nljStage = makeLoopJoinForFetch(std::move(hashAggStage), *_data.recordIdSlot);
 
@@ -413,6 +474,96 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildText(const QuerySolu
 
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildIntersection(
+    const QuerySolutionNode* root, bool sorted) {
+    invariant(root->children.size() >= 2);
+
+    // Join the children pairwise from left to right. The accumulated intersection is always the
+    // outer side of the join, so for a hash intersection the last child is the one being streamed,
+    // just like in the classic AND_HASH stage.
+    _data.resultSlot = boost::none;
+    auto stage = build(root->children[0]);
+    invariant(_data.recordIdSlot);
+    auto recordIdSlot = *_data.recordIdSlot;
+    auto resultSlot = _data.resultSlot;
+
+    for (size_t idx = 1; idx < root->children.size(); ++idx) {
+        _data.resultSlot = boost::none;
+        auto childStage = build(root->children[idx]);
+        invariant(_data.recordIdSlot);
+
+        // Any fetched child can provide the document, the other sides only contribute RecordIds.
+        auto outerProjects = resultSlot ? sbe::makeSV(*resultSlot) : sbe::makeSV();
+        auto innerProjects = _data.resultSlot && !resultSlot ? sbe::makeSV(*_data.resultSlot)
+                                                             : sbe::makeSV();
+        if (!resultSlot) {
+            resultSlot = _data.resultSlot;
+        }
+
+        if (sorted) {
+            stage = sbe::makeS<sbe::MergeJoinStage>(std::move(stage),
+                                                    std::move(childStage),
+                                                    sbe::makeSV(recordIdSlot),
+                                                    std::move(outerProjects),
+                                                    sbe::makeSV(*_data.recordIdSlot),
+                                                    std::move(innerProjects));
+        } else {
+            stage = sbe::makeS<sbe::HashJoinStage>(std::move(stage),
+                                                   std::move(childStage),
+                                                   sbe::makeSV(recordIdSlot),
+                                                   std::move(outerProjects),
+                                                   sbe::makeSV(*_data.recordIdSlot),
+                                                   std::move(innerProjects));
+        }
+        recordIdSlot = *_data.recordIdSlot;
+    }
+
+    _data.recordIdSlot = recordIdSlot;
+    _data.resultSlot = resultSlot;
+    return stage;
+}
+
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildAndHash(
+    const QuerySolutionNode* root) {
+    auto andHashNode = static_cast<const AndHashNode*>(root);
+    auto stage = buildIntersection(root, false /* sorted */);
+
+    if (andHashNode->filter) {
+        uassert(5150505, "Result slot is not defined", _data.resultSlot);
+        stage = generateFilter(
+            andHashNode->filter.get(), std::move(stage), &_slotIdGenerator, *_data.resultSlot);
+    }
+
+    return stage;
+}
+
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildAndSorted(
+    const QuerySolutionNode* root) {
+    auto andSortedNode = static_cast<const AndSortedNode*>(root);
+
+    // The merge join relies on each child producing unique RecordIds in ascending order. An index
+    // scan which has to deduplicate its output (e.g. over a multikey index) does so via a hash
+    // aggregation which does not preserve the order, in which case we fall back to the hash
+    // intersection.
+    auto isSortedByRecordId = [](const QuerySolutionNode* child) {
+        if (child->getType() == STAGE_FETCH) {
+            child = child->children[0];
+        }
+        return child->getType() == STAGE_IXSCAN &&
+            !static_cast<const IndexScanNode*>(child)->shouldDedup;
+    };
+    auto sorted = std::all_of(root->children.begin(), root->children.end(), isSortedByRecordId);
+    auto stage = buildIntersection(root, sorted);
+
+    if (andSortedNode->filter) {
+        uassert(5150506, "Result slot is not defined", _data.resultSlot);
+        stage = generateFilter(
+            andSortedNode->filter.get(), std::move(stage), &_slotIdGenerator, *_data.resultSlot);
+    }
+
+    return stage;
+}
+
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolutionNode* root) {
     static const stdx::unordered_map<StageType,
                                      std::function<std::unique_ptr<sbe::PlanStage>(
@@ -420,6 +571,7 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolution
         kStageBuilders = {
             {STAGE_COLLSCAN, std::mem_fn(&SlotBasedStageBuilder::buildCollScan)},
             {STAGE_IXSCAN, std::mem_fn(&SlotBasedStageBuilder::buildIndexScan)},
+            {STAGE_COUNT_SCAN, std::mem_fn(&SlotBasedStageBuilder::buildCountScan)},
             {STAGE_FETCH, std::mem_fn(&SlotBasedStageBuilder::buildFetch)},
             {STAGE_LIMIT, std::mem_fn(&SlotBasedStageBuilder::buildLimit)},
             {STAGE_SKIP, std::mem_fn(&SlotBasedStageBuilder::buildSkip)},
@@ -429,7 +581,9 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolution
             {STAGE_PROJECTION_SIMPLE, std::mem_fn(&SlotBasedStageBuilder::buildProjectionSimple)},
             {STAGE_PROJECTION_DEFAULT, std::mem_fn(&SlotBasedStageBuilder::buildProjectionDefault)},
             {STAGE_OR, &SlotBasedStageBuilder::buildOr},
-            {STAGE_TEXT, &SlotBasedStageBuilder::buildText}};
+            {STAGE_TEXT, &SlotBasedStageBuilder::buildText},
+            {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHash},
+            {STAGE_AND_SORTED, &SlotBasedStageBuilder::buildAndSorted}};
 
     uassert(4822884,
             str::stream() << "Can't build exec tree for node: " << root->toString(),
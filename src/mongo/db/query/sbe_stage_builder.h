@@ -35,6 +35,7 @@
 #include "mongo/db/exec/trial_period_utils.h"
 #include "mongo/db/exec/trial_run_progress_tracker.h"
 #include "mongo/db/query/plan_yield_policy_sbe.h"
+#include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/stage_builder.h"
 
 namespace mongo::stage_builder {
@@ -67,8 +68,23 @@ struct PlanStageData {
     bool shouldTrackResumeToken{false};
     // Used during the trial run of the runtime planner to track progress of the work done so far.
     std::unique_ptr<TrialRunProgressTracker> trialRunProgressTracker;
+    // Maps the input parameters of the query onto the slots the plan reads their values from, and
+    // holds the values currently bound to these slots. See 'bindInputParams()'.
+    InputParamToSlotMap inputParamToSlotMap;
+    stdx::unordered_map<ComparisonMatchExpressionBase::InputParamId,
+                        std::unique_ptr<sbe::value::OwnedValueAccessor>>
+        inputParamAccessors;
 };
 
+/**
+ * Binds the constants of the parameterized predicates of 'cq' to the input parameter slots of a
+ * plan built for a query of the same shape, described by 'data'. The slots are registered with the
+ * compile context of 'data' when bound for the first time, so this must be called before the plan
+ * is prepared. A plan built for one query can be rebound to the constants of another query this
+ * way, as long as both queries have the same shape.
+ */
+void bindInputParams(const CanonicalQuery& cq, PlanStageData* data);
+
 /**
  * A stage builder which builds an executable tree using slot-based PlanStages.
  */
@@ -79,11 +95,14 @@ public:
                           const CanonicalQuery& cq,
                           const QuerySolution& solution,
                           PlanYieldPolicySBE* yieldPolicy,
-                          bool needsTrialRunProgressTracker)
+                          bool needsTrialRunProgressTracker,
+                          boost::optional<size_t> maxTrialRunReads = boost::none)
         : StageBuilder(opCtx, collection, cq, solution), _yieldPolicy(yieldPolicy) {
         if (needsTrialRunProgressTracker) {
             const auto maxNumResults{trial_period::getTrialPeriodNumToReturn(_cq)};
-            const auto maxNumReads{trial_period::getTrialPeriodMaxWorks(_opCtx, _collection)};
+            const auto maxNumReads{maxTrialRunReads
+                                       ? *maxTrialRunReads
+                                       : trial_period::getTrialPeriodMaxWorks(_opCtx, _collection)};
             _data.trialRunProgressTracker =
                 std::make_unique<TrialRunProgressTracker>(maxNumResults, maxNumReads);
         }
@@ -98,6 +117,7 @@ public:
 private:
     std::unique_ptr<sbe::PlanStage> buildCollScan(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildIndexScan(const QuerySolutionNode* root);
+    std::unique_ptr<sbe::PlanStage> buildCountScan(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildFetch(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildLimit(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildSkip(const QuerySolutionNode* root);
@@ -107,6 +127,15 @@ private:
     std::unique_ptr<sbe::PlanStage> buildProjectionDefault(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildOr(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildText(const QuerySolutionNode* root);
+    std::unique_ptr<sbe::PlanStage> buildAndHash(const QuerySolutionNode* root);
+    std::unique_ptr<sbe::PlanStage> buildAndSorted(const QuerySolutionNode* root);
+
+    /**
+     * Builds an intersection of the children of an AND_HASH or AND_SORTED node on their RecordId
+     * slots. If 'sorted' is true, the children are joined by merging their RecordId-ordered
+     * streams, otherwise all but the last child are loaded into hash tables.
+     */
+    std::unique_ptr<sbe::PlanStage> buildIntersection(const QuerySolutionNode* root, bool sorted);
 
     std::unique_ptr<sbe::PlanStage> makeLoopJoinForFetch(std::unique_ptr<sbe::PlanStage> inputStage,
                                                          sbe::value::SlotId recordIdKeySlot);
@@ -41,6 +41,7 @@
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/storage/oplog_hack.h"
@@ -255,6 +256,58 @@ generateOptimizedOplogScan(OperationContext* opCtx,
             std::move(stage)};
 }
 
+/**
+ * Generates a parallel collection scan sub-tree. The collection is split into key ranges by the
+ * 'ParallelScanStage' and the ranges are consumed by 'dop' producers feeding an exchange. The
+ * filter, if any, is evaluated on the producer side so that it runs in parallel as well. The order
+ * of the returned documents is not defined.
+ */
+std::tuple<sbe::value::SlotId,
+           sbe::value::SlotId,
+           boost::optional<sbe::value::SlotId>,
+           std::unique_ptr<sbe::PlanStage>>
+generateParallelCollScan(const Collection* collection,
+                         const CollectionScanNode* csn,
+                         sbe::value::SlotIdGenerator* slotIdGenerator,
+                         size_t dop) {
+    auto resultSlot = slotIdGenerator->generate();
+    auto recordIdSlot = slotIdGenerator->generate();
+
+    // The producers run on their own threads and operation contexts, hence no yield policy is
+    // passed down to the scan.
+    NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
+    std::unique_ptr<sbe::PlanStage> stage = sbe::makeS<sbe::ParallelScanStage>(
+        nss, resultSlot, recordIdSlot, std::vector<std::string>{}, sbe::makeSV(), nullptr);
+
+    if (csn->filter) {
+        invariant(!csn->stopApplyingFilterAfterFirstMatch);
+
+        stage = generateFilter(csn->filter.get(), std::move(stage), slotIdGenerator, resultSlot);
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              dop,
+                                              sbe::makeSV(resultSlot, recordIdSlot),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr,
+                                              nullptr);
+
+    return {resultSlot, recordIdSlot, boost::none, std::move(stage)};
+}
+
+/**
+ * Returns true if the collection scan described by 'csn' can be executed as a parallel scan. Only
+ * plain forward scans which are not subject to a trial run qualify: resumable and oplog scans
+ * depend on the scan order, and the trial run progress tracker is not thread-safe.
+ */
+bool canUseParallelCollScan(const Collection* collection,
+                            const CollectionScanNode* csn,
+                            TrialRunProgressTracker* tracker) {
+    return csn->direction == CollectionScanParams::FORWARD && !csn->resumeAfterRecordId &&
+        !csn->shouldTrackLatestOplogTimestamp && !csn->requestResumeToken &&
+        !collection->ns().isOplog() && !tracker;
+}
+
 /**
  * Generates a generic collecion scan sub-tree. If a resume token has been provided, the scan will
  * start from a RecordId contained within this token, otherwise from the beginning of the
@@ -268,7 +321,8 @@ generateGenericCollScan(const Collection* collection,
                         const CollectionScanNode* csn,
                         sbe::value::SlotIdGenerator* slotIdGenerator,
                         PlanYieldPolicy* yieldPolicy,
-                        TrialRunProgressTracker* tracker) {
+                        TrialRunProgressTracker* tracker,
+                        InputParamToSlotMap* inputParamToSlotMap) {
     const auto forward = csn->direction == CollectionScanParams::FORWARD;
 
     auto resultSlot = slotIdGenerator->generate();
@@ -289,6 +343,20 @@ generateGenericCollScan(const Collection* collection,
         return {};
     }();
 
+    // Have the scan project out the top-level fields read by the filter, so that each document is
+    // walked once to extract all of them, rather than once for every predicate on the document.
+    TopLevelFieldSlotMap filterFieldSlots;
+    if (csn->filter) {
+        for (auto&& field : getTopLevelFilterFields(csn->filter.get())) {
+            if (std::find(fields.begin(), fields.end(), field) == fields.end()) {
+                auto slot = slotIdGenerator->generate();
+                filterFieldSlots.emplace(field, slot);
+                fields.push_back(field);
+                slots.push_back(slot);
+            }
+        }
+    }
+
     NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
     auto stage = sbe::makeS<sbe::ScanStage>(nss,
                                             resultSlot,
@@ -329,7 +397,12 @@ generateGenericCollScan(const Collection* collection,
         // 'generateOptimizedOplogScan()'.
         invariant(!csn->stopApplyingFilterAfterFirstMatch);
 
-        stage = generateFilter(csn->filter.get(), std::move(stage), slotIdGenerator, resultSlot);
+        stage = generateFilter(csn->filter.get(),
+                               std::move(stage),
+                               slotIdGenerator,
+                               resultSlot,
+                               inputParamToSlotMap,
+                               &filterFieldSlots);
     }
 
     return {resultSlot, recordIdSlot, tsSlot, std::move(stage)};
@@ -345,7 +418,8 @@ generateCollScan(OperationContext* opCtx,
                  const CollectionScanNode* csn,
                  sbe::value::SlotIdGenerator* slotIdGenerator,
                  PlanYieldPolicy* yieldPolicy,
-                 TrialRunProgressTracker* tracker) {
+                 TrialRunProgressTracker* tracker,
+                 InputParamToSlotMap* inputParamToSlotMap) {
     uassert(4822889, "Tailable collection scans are not supported in SBE", !csn->tailable);
 
     auto [resultSlot, recordIdSlot, oplogTsSlot, stage] = [&]() {
@@ -353,7 +427,12 @@ generateCollScan(OperationContext* opCtx,
             return generateOptimizedOplogScan(
                 opCtx, collection, csn, slotIdGenerator, yieldPolicy, tracker);
         } else {
-            return generateGenericCollScan(collection, csn, slotIdGenerator, yieldPolicy, tracker);
+            if (auto dop = internalQueryDefaultDOP.load();
+                dop > 1 && canUseParallelCollScan(collection, csn, tracker)) {
+                return generateParallelCollScan(collection, csn, slotIdGenerator, dop);
+            }
+            return generateGenericCollScan(
+                collection, csn, slotIdGenerator, yieldPolicy, tracker, inputParamToSlotMap);
         }
     }();
 
@@ -33,6 +33,7 @@
 #include "mongo/db/exec/sbe/values/id_generators.h"
 #include "mongo/db/exec/trial_run_progress_tracker.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_stage_builder_filter.h"
 
 namespace mongo::stage_builder {
 /**
@@ -45,6 +46,9 @@ namespace mongo::stage_builder {
  *     were requested to track this data.
  *   * A generated PlanStage sub-tree.
  *
+ * If 'inputParamToSlotMap' is provided, the filter of a serial scan reads the constants of
+ * parameterized predicates from the slots registered in the map.
+ *
  * In cases of an error, throws.
  */
 std::tuple<sbe::value::SlotId,
@@ -56,5 +60,6 @@ generateCollScan(OperationContext* opCtx,
                  const CollectionScanNode* csn,
                  sbe::value::SlotIdGenerator* slotIdGenerator,
                  PlanYieldPolicy* yieldPolicy,
-                 TrialRunProgressTracker* tracker);
+                 TrialRunProgressTracker* tracker,
+                 InputParamToSlotMap* inputParamToSlotMap = nullptr);
 }  // namespace mongo::stage_builder
@@ -91,8 +91,14 @@ using MakePredicateEExprFn =
 struct MatchExpressionVisitorContext {
     MatchExpressionVisitorContext(sbe::value::SlotIdGenerator* slotIdGenerator,
                                   std::unique_ptr<sbe::PlanStage> inputStage,
-                                  sbe::value::SlotId inputVar)
-        : slotIdGenerator{slotIdGenerator}, inputStage{std::move(inputStage)}, inputVar{inputVar} {}
+                                  sbe::value::SlotId inputVar,
+                                  InputParamToSlotMap* inputParamToSlotMap,
+                                  const TopLevelFieldSlotMap* topLevelFieldSlots)
+        : slotIdGenerator{slotIdGenerator},
+          inputStage{std::move(inputStage)},
+          inputVar{inputVar},
+          inputParamToSlotMap{inputParamToSlotMap},
+          topLevelFieldSlots{topLevelFieldSlots} {}
 
     std::unique_ptr<sbe::PlanStage> done() {
         if (!predicateVars.empty()) {
@@ -109,6 +115,8 @@ struct MatchExpressionVisitorContext {
     std::stack<sbe::value::SlotId> predicateVars;
     std::stack<std::pair<const MatchExpression*, size_t>> nestedLogicalExprs;
     sbe::value::SlotId inputVar;
+    InputParamToSlotMap* inputParamToSlotMap;
+    const TopLevelFieldSlotMap* topLevelFieldSlots;
 };
 
 /**
@@ -192,22 +200,33 @@ std::unique_ptr<sbe::PlanStage> generateTraverseHelper(MatchExpressionVisitorCon
 
     // The global traversal result.
     const auto& traversePredicateVar = context->predicateVars.top();
-    // The field we will be traversing at the current nested level.
-    auto fieldVar{context->slotIdGenerator->generate()};
     // The result coming from the 'in' branch of the traverse plan stage.
     auto elemPredicateVar{context->slotIdGenerator->generate()};
 
-    // Generate the projection stage to read a sub-field at the current nested level and bind it
-    // to 'fieldVar'.
-    inputStage = sbe::makeProjectStage(
-        std::move(inputStage),
-        fieldVar,
-        sbe::makeE<sbe::EFunction>(
-            "getField"sv,
-            sbe::makeEs(sbe::makeE<sbe::EVariable>(inputVar), sbe::makeE<sbe::EConstant>([&]() {
-                            auto fieldName = path.getFieldName(level);
-                            return std::string_view{fieldName.rawData(), fieldName.size()};
-                        }()))));
+    // The field we will be traversing at the current nested level. If the field is a top-level
+    // field of the input document which has already been projected into a slot, traverse that
+    // slot directly. Otherwise, generate the projection stage to read a sub-field at the current
+    // nested level and bind it to 'fieldVar'.
+    auto fieldName = path.getFieldName(level);
+    auto fieldVar = [&]() {
+        if (level == 0 && inputVar == context->inputVar && context->topLevelFieldSlots) {
+            if (auto it = context->topLevelFieldSlots->find(fieldName.toString());
+                it != context->topLevelFieldSlots->end()) {
+                return it->second;
+            }
+        }
+
+        auto fieldVar{context->slotIdGenerator->generate()};
+        inputStage = sbe::makeProjectStage(
+            std::move(inputStage),
+            fieldVar,
+            sbe::makeE<sbe::EFunction>(
+                "getField"sv,
+                sbe::makeEs(sbe::makeE<sbe::EVariable>(inputVar),
+                            sbe::makeE<sbe::EConstant>(
+                                std::string_view{fieldName.rawData(), fieldName.size()}))));
+        return fieldVar;
+    }();
 
     std::unique_ptr<sbe::PlanStage> innerBranch;
     if (level == path.getPathLength() - 1u) {
@@ -282,7 +301,24 @@ void generateTraverse(MatchExpressionVisitorContext* context,
 void generateTraverseForComparisonPredicate(MatchExpressionVisitorContext* context,
                                             const ComparisonMatchExpression* expr,
                                             sbe::EPrimBinary::Op binaryOp) {
-    auto makeEExprFn = [expr, binaryOp](sbe::value::SlotId inputSlot) {
+    // If the constant is an input parameter, read it from the slot bound to the parameter.
+    boost::optional<sbe::value::SlotId> paramSlot;
+    if (auto paramId = expr->getInputParamId(); paramId && context->inputParamToSlotMap) {
+        auto [it, inserted] =
+            context->inputParamToSlotMap->emplace(*paramId, sbe::value::SlotId{});
+        if (inserted) {
+            it->second = context->slotIdGenerator->generate();
+        }
+        paramSlot = it->second;
+    }
+
+    auto makeEExprFn = [expr, binaryOp, paramSlot](sbe::value::SlotId inputSlot) {
+        if (paramSlot) {
+            return sbe::makeE<sbe::EPrimBinary>(binaryOp,
+                                                sbe::makeE<sbe::EVariable>(inputSlot),
+                                                sbe::makeE<sbe::EVariable>(*paramSlot));
+        }
+
         const auto& rhs = expr->getData();
         auto [tagView, valView] = sbe::bson::convertFrom(
             true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
@@ -708,14 +744,17 @@ private:
 std::unique_ptr<sbe::PlanStage> generateFilter(const MatchExpression* root,
                                                std::unique_ptr<sbe::PlanStage> stage,
                                                sbe::value::SlotIdGenerator* slotIdGenerator,
-                                               sbe::value::SlotId inputVar) {
+                                               sbe::value::SlotId inputVar,
+                                               InputParamToSlotMap* inputParamToSlotMap,
+                                               const TopLevelFieldSlotMap* topLevelFieldSlots) {
     // The planner adds an $and expression without the operands if the query was empty. We can bail
     // out early without generating the filter plan stage if this is the case.
     if (root->matchType() == MatchExpression::AND && root->numChildren() == 0) {
         return stage;
     }
 
-    MatchExpressionVisitorContext context{slotIdGenerator, std::move(stage), inputVar};
+    MatchExpressionVisitorContext context{
+        slotIdGenerator, std::move(stage), inputVar, inputParamToSlotMap, topLevelFieldSlots};
     MatchExpressionPreVisitor preVisitor{&context};
     MatchExpressionInVisitor inVisitor{&context};
     MatchExpressionPostVisitor postVisitor{&context};
@@ -723,4 +762,30 @@ std::unique_ptr<sbe::PlanStage> generateFilter(const MatchExpression* root,
     tree_walker::walk<true, MatchExpression>(root, &walker);
     return context.done();
 }
+
+std::set<std::string> getTopLevelFilterFields(const MatchExpression* root) {
+    std::set<std::string> fields;
+    std::function<void(const MatchExpression*)> collect = [&](const MatchExpression* expr) {
+        switch (expr->matchType()) {
+            case MatchExpression::AND:
+            case MatchExpression::OR:
+            case MatchExpression::NOR:
+            case MatchExpression::NOT:
+                for (size_t i = 0; i < expr->numChildren(); ++i) {
+                    collect(expr->getChild(i));
+                }
+                return;
+            default:
+                // The children of any other expression, such as $elemMatch, are evaluated against
+                // nested values rather than the input document, so only the expression's own
+                // path is of interest.
+                if (auto pathExpr = dynamic_cast<const PathMatchExpression*>(expr);
+                    pathExpr && !pathExpr->path().empty()) {
+                    fields.insert(FieldPath{pathExpr->path()}.getFieldName(0).toString());
+                }
+        }
+    };
+    collect(root);
+    return fields;
+}
 }  // namespace mongo::stage_builder
@@ -29,19 +29,51 @@
 
 #pragma once
 
+#include <set>
+
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/id_generators.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo::stage_builder {
+/**
+ * Maps the input parameters of a query onto the slots from which the generated plan reads their
+ * values.
+ */
+using InputParamToSlotMap =
+    stdx::unordered_map<ComparisonMatchExpressionBase::InputParamId, sbe::value::SlotId>;
+
+/**
+ * Maps top-level field names of the input document onto slots which already hold the values of
+ * those fields, e.g. because they were projected out by the scan producing the document.
+ */
+using TopLevelFieldSlotMap = stdx::unordered_map<std::string, sbe::value::SlotId>;
+
 /**
  * Generates an SBE plan stage sub-tree implementing a filter expression represented by the 'root'
  * expression. The 'stage' parameter defines an input stage to the generate SBE plan stage sub-tree.
  * The 'inputVar' defines a variable to read the input document from.
+ *
+ * If 'inputParamToSlotMap' is provided, the constants of parameterized predicates are read from
+ * slots, which are registered in the map, instead of being inlined into the plan.
+ *
+ * If 'topLevelFieldSlots' is provided, top-level fields of the input document found in the map are
+ * read from the mapped slots instead of being looked up in 'inputVar'.
+ */
+std::unique_ptr<sbe::PlanStage> generateFilter(
+    const MatchExpression* root,
+    std::unique_ptr<sbe::PlanStage> stage,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    sbe::value::SlotId inputVar,
+    InputParamToSlotMap* inputParamToSlotMap = nullptr,
+    const TopLevelFieldSlotMap* topLevelFieldSlots = nullptr);
+
+/**
+ * Returns the distinct top-level fields of the input document that a filter generated for 'root'
+ * by 'generateFilter()' reads.
  */
-std::unique_ptr<sbe::PlanStage> generateFilter(const MatchExpression* root,
-                                               std::unique_ptr<sbe::PlanStage> stage,
-                                               sbe::value::SlotIdGenerator* slotIdGenerator,
-                                               sbe::value::SlotId inputVar);
+std::set<std::string> getTopLevelFilterFields(const MatchExpression* root);
 
 }  // namespace mongo::stage_builder
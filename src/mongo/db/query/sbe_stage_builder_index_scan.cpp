@@ -662,7 +662,57 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
     }();
 
     if (ixn->shouldDedup) {
-        stage = sbe::makeS<sbe::HashAggStage>(std::move(stage), sbe::makeSV(slot), sbe::makeEM());
+        stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                              sbe::makeSV(slot),
+                                              sbe::makeEM(),
+                                              false /* allowDiskUse */,
+                                              "" /* tempDir */);
+    }
+
+    return {slot, std::move(stage)};
+}
+
+std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateCountScan(
+    OperationContext* opCtx,
+    const Collection* collection,
+    const CountScanNode* csn,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    TrialRunProgressTracker* tracker) {
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, csn->index.identifier.catalogName);
+    auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+    auto version = accessMethod->getSortedDataInterface()->getKeyStringVersion();
+    auto ordering = accessMethod->getSortedDataInterface()->getOrdering();
+
+    // A count scan is always a forward scan over a single interval. The bounds are encoded directly
+    // as KeyString seek keys, so the index keys are compared in their KeyString form and are never
+    // rehydrated into BSON. As with the regular index scan, the high key uses the opposite rule
+    // from a normal seek.
+    auto lowKey =
+        std::make_unique<KeyString::Value>(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+            csn->startKey, version, ordering, true /* forward */, csn->startKeyInclusive));
+    auto highKey =
+        std::make_unique<KeyString::Value>(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+            csn->endKey, version, ordering, true /* forward */, !csn->endKeyInclusive));
+
+    auto [slot, stage] = generateSingleIntervalIndexScan(collection,
+                                                         csn->index.identifier.catalogName,
+                                                         true /* forward */,
+                                                         std::move(lowKey),
+                                                         std::move(highKey),
+                                                         boost::none,
+                                                         slotIdGenerator,
+                                                         yieldPolicy,
+                                                         tracker);
+
+    // Each document must be counted once, even if it has multiple keys within the interval.
+    if (csn->index.multikey) {
+        stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                              sbe::makeSV(slot),
+                                              sbe::makeEM(),
+                                              false /* allowDiskUse */,
+                                              "" /* tempDir */);
     }
 
     return {slot, std::move(stage)};
@@ -47,6 +47,19 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
     PlanYieldPolicy* yieldPolicy,
     TrialRunProgressTracker* tracker);
 
+/**
+ * Generates an SBE plan stage sub-tree implementing a count scan. The sub-tree produces a RecordId
+ * for each document with a key between the start and end keys of 'csn', deduplicated if the index
+ * is multikey.
+ */
+std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateCountScan(
+    OperationContext* opCtx,
+    const Collection* collection,
+    const CountScanNode* csn,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    TrialRunProgressTracker* tracker);
+
 /**
  * Constructs the most simple version of an index scan from the single interval index bounds. The
  * generated subtree will have the following form:
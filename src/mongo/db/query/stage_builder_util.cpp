@@ -58,7 +58,8 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const CanonicalQuery& cq,
                              const QuerySolution& solution,
                              PlanYieldPolicy* yieldPolicy,
-                             bool needsTrialRunProgressTracker) {
+                             bool needsTrialRunProgressTracker,
+                             boost::optional<size_t> maxTrialRunReads) {
     // Only QuerySolutions derived from queries parsed with context, or QuerySolutions derived from
     // queries that disallow extensions, can be properly executed. If the query does not have
     // $text/$where context (and $text/$where are allowed), then no attempt should be made to
@@ -69,10 +70,16 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
     auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(yieldPolicy);
     invariant(sbeYieldPolicy);
 
-    auto builder = std::make_unique<SlotBasedStageBuilder>(
-        opCtx, collection, cq, solution, sbeYieldPolicy, needsTrialRunProgressTracker);
+    auto builder = std::make_unique<SlotBasedStageBuilder>(opCtx,
+                                                           collection,
+                                                           cq,
+                                                           solution,
+                                                           sbeYieldPolicy,
+                                                           needsTrialRunProgressTracker,
+                                                           maxTrialRunReads);
     auto root = builder->build(solution.root.get());
     auto data = builder->getPlanStageData();
+    bindInputParams(cq, &data);
     return {std::move(root), std::move(data)};
 }
 }  // namespace mongo::stage_builder
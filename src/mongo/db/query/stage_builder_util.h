@@ -43,6 +43,10 @@ namespace mongo::stage_builder {
  *
  * The 'PlanStageType' type parameter defines a specific type of PlanStage the executable tree
  * will consist of.
+ *
+ * For the slot-based tree, 'maxTrialRunReads' overrides the number of physical reads after which
+ * the trial run of the plan is stopped. By default the limit of a multi-planning trial period is
+ * used.
  */
 std::unique_ptr<PlanStage> buildClassicExecutableTree(OperationContext* opCtx,
                                                       const Collection* collection,
@@ -56,6 +60,7 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
                              const CanonicalQuery& cq,
                              const QuerySolution& solution,
                              PlanYieldPolicy* yieldPolicy,
-                             bool needsTrialRunProgressTracker);
+                             bool needsTrialRunProgressTracker,
+                             boost::optional<size_t> maxTrialRunReads = boost::none);
 
 }  // namespace mongo::stage_builder
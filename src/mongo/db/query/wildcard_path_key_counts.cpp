@@ -0,0 +1,60 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/wildcard_path_key_counts.h"
+
+namespace mongo {
+
+void WildcardPathKeyCounts::startFromEmptyIndex() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _counts.clear();
+    _complete.store(true);
+}
+
+void WildcardPathKeyCounts::add(const StringMap<long long>& deltas) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& [path, delta] : deltas) {
+        auto& count = _counts[path];
+        count = std::max(count + delta, 0LL);
+    }
+}
+
+boost::optional<long long> WildcardPathKeyCounts::get(StringData path) const {
+    if (!isComplete()) {
+        return boost::none;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _counts.find(path);
+    return it == _counts.end() ? 0LL : it->second;
+}
+
+}  // namespace mongo
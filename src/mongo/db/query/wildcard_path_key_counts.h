@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * The number of keys a $** index holds for each of the paths it indexes. The counts are kept in
+ * memory and adjusted as writes to the index commit, so they are only known for indexes which
+ * were empty at some point while this process has been running: see startFromEmptyIndex().
+ *
+ * Keys removed without having been counted, for instance when a document is deleted twice by an
+ * index build draining its side writes, make the counts approximate. They are meant for choosing
+ * between the paths of a query, not for answering it.
+ */
+class WildcardPathKeyCounts {
+public:
+    /**
+     * Records that the index is empty. Every key written to it from then on must be counted.
+     */
+    void startFromEmptyIndex();
+
+    /**
+     * Returns whether the counts cover every key in the index.
+     */
+    bool isComplete() const {
+        return _complete.load();
+    }
+
+    /**
+     * Adds each of the 'deltas' to the count of its path.
+     */
+    void add(const StringMap<long long>& deltas);
+
+    /**
+     * Returns the number of keys for 'path', or boost::none if the counts are not complete.
+     */
+    boost::optional<long long> get(StringData path) const;
+
+private:
+    AtomicWord<bool> _complete{false};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WildcardPathKeyCounts::_mutex");
+    StringMap<long long> _counts;
+};
+
+}  // namespace mongo
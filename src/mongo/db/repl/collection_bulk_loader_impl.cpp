@@ -132,14 +132,14 @@ Status CollectionBulkLoaderImpl::_insertDocumentsForUncappedCollection(
                 };
 
                 while (insertIter != end && bytesInBlock < collectionBulkLoaderBatchSizeInBytes) {
-                    const auto& doc = *insertIter++;
-                    bytesInBlock += doc.objsize();
-                    // This version of insert will not update any indexes.
-                    const auto status = _autoColl->getCollection()->insertDocumentForBulkLoader(
-                        _opCtx.get(), doc, onRecordInserted);
-                    if (!status.isOK()) {
-                        return status;
-                    }
+                    bytesInBlock += insertIter++->objsize();
+                }
+
+                // This version of insert will not update any indexes.
+                const auto status = _autoColl->getCollection()->insertDocumentsForBulkLoader(
+                    _opCtx.get(), iter, insertIter, onRecordInserted);
+                if (!status.isOK()) {
+                    return status;
                 }
 
                 wunit.commit();
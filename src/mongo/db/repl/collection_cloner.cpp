@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/index_build_entry_helpers.h"
 #include "mongo/db/index_builds_coordinator.h"
@@ -39,9 +40,13 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
 
 namespace mongo {
 namespace repl {
@@ -101,6 +106,15 @@ CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
 
     // Find out whether the sync source supports resumable queries.
     _resumeSupported = (getClient()->getMaxWireVersion() >= WireVersion::RESUMABLE_INITIAL_SYNC);
+
+    _createClientFn = [this] {
+        auto client = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+        uassertStatusOK(client->connect(getSource(), StringData()));
+        uassertStatusOK(replAuthenticate(client.get())
+                            .withContext(str::stream()
+                                         << "Failed to authenticate to " << getSource()));
+        return client;
+    };
 }
 
 BaseCloner::ClonerStages CollectionCloner::getStages() {
@@ -215,7 +229,14 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
+    if (!_partitionsComputed) {
+        computeQueryPartitions();
+    }
+    if (_partitions.empty()) {
+        runQuery();
+    } else {
+        runPartitionedQuery();
+    }
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -350,18 +371,19 @@ void CollectionCloner::runQuery() {
     }
 }
 
-void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
-    {
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        if (!getSharedData()->getInitialSyncStatus(lk).isOK()) {
-            static constexpr char message[] =
-                "Collection cloning cancelled due to initial sync failure";
-            LOGV2(21136, message, "error"_attr = getSharedData()->getInitialSyncStatus(lk));
-            uasserted(ErrorCodes::CallbackCanceled,
-                      str::stream()
-                          << message << ": " << getSharedData()->getInitialSyncStatus(lk));
-        }
+void CollectionCloner::checkInitialSyncStatus() {
+    stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+    if (!getSharedData()->getInitialSyncStatus(lk).isOK()) {
+        static constexpr char message[] =
+            "Collection cloning cancelled due to initial sync failure";
+        LOGV2(21136, message, "error"_attr = getSharedData()->getInitialSyncStatus(lk));
+        uasserted(ErrorCodes::CallbackCanceled,
+                  str::stream() << message << ": " << getSharedData()->getInitialSyncStatus(lk));
     }
+}
+
+void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+    checkInitialSyncStatus();
 
     // If this is 'true', it means that something happened to our remote cursor for a reason other
     // than the collection being dropped, all while we were running a non-resumable (4.2) clone.
@@ -401,6 +423,10 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
         _resumeToken = iter.getPostBatchResumeToken();
     }
 
+    hangAfterHandlingBatchIfRequested();
+}
+
+void CollectionCloner::hangAfterHandlingBatchIfRequested() {
     initialSyncHangCollectionClonerAfterHandlingBatchResponse.executeIf(
         [&](const BSONObj&) {
             while (MONGO_unlikely(
@@ -422,6 +448,189 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
         });
 }
 
+Query CollectionCloner::makePartitionQuery(const BSONObj& lowerBound,
+                                           const BSONObj& upperBound,
+                                           const BSONObj& lastId) {
+    Query query;
+    query.hint(BSON("_id" << 1));
+    const auto& min = lastId.isEmpty() ? lowerBound : lastId;
+    if (!min.isEmpty()) {
+        query.minKey(min);
+    }
+    if (!upperBound.isEmpty()) {
+        query.maxKey(upperBound);
+    }
+    return query;
+}
+
+void CollectionCloner::computeQueryPartitions() {
+    _partitionsComputed = true;
+
+    long long documentToCopy;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        documentToCopy = _stats.documentToCopy;
+    }
+
+    // Partition queries are resumed from the last _id they received rather than with a resume
+    // token, and walk the _id index, so they need a sync source with resumable queries and an _id
+    // index with the simple collation. Capped collections must be inserted in natural order.
+    if (collectionClonerPartitions <= 1 || !_resumeSupported || _collectionOptions.capped ||
+        _idIndexSpec.isEmpty() || !_collectionOptions.collation.isEmpty() ||
+        documentToCopy < collectionClonerPartitionMinDocuments) {
+        return;
+    }
+
+    // splitVector only returns split points once the collection holds more than
+    // 'maxChunkSizeBytes', and then picks a split point every 'maxChunkObjects' keys at most.
+    BSONObj collStats;
+    if (!getClient()->runCommand(
+            _sourceNss.db().toString(), BSON("collStats" << _sourceNss.coll()), collStats)) {
+        LOGV2_DEBUG(5152401,
+                    1,
+                    "Cloning collection with a single query because collStats failed",
+                    "namespace"_attr = _sourceNss,
+                    "error"_attr = getStatusFromCommandResult(collStats));
+        return;
+    }
+    const auto dataSize = collStats["size"].safeNumberLong();
+    const auto maxChunkObjects =
+        std::max(documentToCopy / collectionClonerPartitions, static_cast<long long>(1));
+
+    BSONObj splitResult;
+    if (dataSize <= 0 ||
+        !getClient()->runCommand(_sourceNss.db().toString(),
+                                 BSON("splitVector" << _sourceNss.ns() << "keyPattern"
+                                                    << BSON("_id" << 1) << "maxChunkSizeBytes"
+                                                    << dataSize << "maxChunkObjects"
+                                                    << maxChunkObjects << "maxSplitPoints"
+                                                    << collectionClonerPartitions - 1),
+                                 splitResult)) {
+        LOGV2_DEBUG(5152402,
+                    1,
+                    "Cloning collection with a single query because splitVector failed",
+                    "namespace"_attr = _sourceNss,
+                    "error"_attr = getStatusFromCommandResult(splitResult));
+        return;
+    }
+
+    auto splitKeys = splitResult["splitKeys"];
+    if (splitKeys.type() != Array || splitKeys.Obj().isEmpty()) {
+        return;
+    }
+
+    BSONObj lowerBound;
+    for (auto&& splitKey : splitKeys.Obj()) {
+        auto upperBound = splitKey.Obj().getOwned();
+        _partitions.push_back({lowerBound, upperBound});
+        lowerBound = upperBound;
+    }
+    _partitions.push_back({lowerBound, BSONObj()});
+
+    LOGV2(5152400,
+          "Cloning collection in concurrent _id ranges",
+          "namespace"_attr = _sourceNss,
+          "documentsToCopy"_attr = documentToCopy,
+          "numPartitions"_attr = _partitions.size());
+}
+
+void CollectionCloner::runPartitionedQuery() {
+    _partitionQueryFailed.store(false);
+
+    std::vector<Status> statuses(_partitions.size(), Status::OK());
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < _partitions.size(); ++i) {
+        if (_partitions[i].done) {
+            continue;
+        }
+        threads.emplace_back([this, i, &statuses] {
+            setThreadName(str::stream() << "CollectionClonerPartition-" << i);
+            try {
+                runPartitionQuery(&_partitions[i]);
+            } catch (...) {
+                statuses[i] = exceptionToStatus();
+                _partitionQueryFailed.store(true);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // A dropped collection takes precedence so that the cloner exits cleanly. Otherwise report
+    // the error which made the other partition queries stop.
+    boost::optional<Status> firstError;
+    for (auto&& status : statuses) {
+        if (status == ErrorCodes::NamespaceNotFound) {
+            uassertStatusOK(status);
+        }
+        if (!status.isOK() &&
+            (!firstError ||
+             (*firstError == ErrorCodes::CallbackCanceled &&
+              status != ErrorCodes::CallbackCanceled))) {
+            firstError = status;
+        }
+    }
+    if (firstError) {
+        uassertStatusOK(*firstError);
+    }
+}
+
+void CollectionCloner::runPartitionQuery(QueryPartition* partition) {
+    auto client = _createClientFn();
+    client->query(
+        [this, partition](DBClientCursorBatchIterator& iter) {
+            handleNextPartitionBatch(partition, iter);
+        },
+        _sourceDbAndUuid,
+        makePartitionQuery(partition->lowerBound, partition->upperBound, partition->lastId),
+        nullptr /* fieldsToReturn */,
+        QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
+            (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+        _collectionClonerBatchSize,
+        ReadConcernArgs::kImplicitDefault);
+    partition->done = true;
+}
+
+void CollectionCloner::handleNextPartitionBatch(QueryPartition* partition,
+                                                DBClientCursorBatchIterator& iter) {
+    checkInitialSyncStatus();
+    uassert(ErrorCodes::CallbackCanceled,
+            "Partition query stopped because another partition query failed",
+            !_partitionQueryFailed.load());
+
+    bool scheduleInsert;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.receivedBatches++;
+        // Documents are only left in the buffer while an insert is scheduled, which will also
+        // insert the documents of this batch.
+        const bool insertScheduled = !_documentsToInsert.empty();
+        while (iter.moreInCurrentBatch()) {
+            auto doc = iter.nextSafe();
+            auto id = doc["_id"].wrap();
+            // A resumed partition query starts with the last document received before.
+            if (SimpleBSONObjComparator::kInstance.evaluate(id == partition->lastId)) {
+                continue;
+            }
+            _documentsToInsert.emplace_back(std::move(doc));
+            partition->lastId = std::move(id);
+        }
+        scheduleInsert = !insertScheduled && !_documentsToInsert.empty();
+    }
+
+    if (scheduleInsert) {
+        auto&& scheduleResult = _scheduleDbWorkFn(
+            [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
+        if (!scheduleResult.isOK()) {
+            uassertStatusOK(scheduleResult.getStatus().withContext(
+                str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'"));
+        }
+    }
+
+    hangAfterHandlingBatchIfRequested();
+}
+
 void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::CallbackArgs& cbd) {
     uassertStatusOK(cbd.status);
 
@@ -117,6 +117,28 @@ public:
         _scheduleDbWorkFn = std::move(scheduleDbWorkFn);
     }
 
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
+    /**
+     * Overrides how the connections used to clone a partitioned collection are created.
+     *
+     * For testing only.
+     */
+    void setCreateClientFn_forTest(CreateClientFn createClientFn) {
+        _createClientFn = std::move(createClientFn);
+    }
+
+    /**
+     * Returns the query which fetches the documents of the _id range [lowerBound, upperBound) in
+     * _id order, starting at 'lastId' if it is not empty. Empty bounds are unbounded. The bounds
+     * and 'lastId' are objects whose only field is the _id value; they are applied as index
+     * bounds rather than as a filter so that ranges spanning several BSON types are not subject
+     * to type bracketing.
+     */
+    static Query makePartitionQuery(const BSONObj& lowerBound,
+                                    const BSONObj& upperBound,
+                                    const BSONObj& lastId);
+
 protected:
     ClonerStages getStages() final;
 
@@ -227,6 +249,51 @@ private:
      */
     void abortNonResumableClone(const Status& status);
 
+    /**
+     * A range of _id values cloned over its own connection when a large collection is cloned in
+     * parallel. 'lastId' is the _id of the last document received, so that a retried query stage
+     * only fetches the rest of the range.
+     */
+    struct QueryPartition {
+        BSONObj lowerBound;
+        BSONObj upperBound;
+        BSONObj lastId;
+        bool done = false;
+    };
+
+    /**
+     * Splits the collection into _id ranges if it is large enough and 'collectionClonerPartitions'
+     * allows it. Leaves '_partitions' empty if the collection should be cloned with one query.
+     */
+    void computeQueryPartitions();
+
+    /**
+     * Queries every unfinished partition concurrently, each over a new connection, and throws
+     * the first error encountered once all of the queries have stopped.
+     */
+    void runPartitionedQuery();
+
+    /**
+     * Queries the documents of a single partition which have not been received yet.
+     */
+    void runPartitionQuery(QueryPartition* partition);
+
+    /**
+     * Same as handleNextBatch(), but for a batch of a partition query.
+     */
+    void handleNextPartitionBatch(QueryPartition* partition, DBClientCursorBatchIterator& iter);
+
+    /**
+     * Throws if initial sync has failed, so that running queries stop.
+     */
+    void checkInitialSyncStatus();
+
+    /**
+     * Blocks while the initialSyncHangCollectionClonerAfterHandlingBatchResponse fail point is
+     * enabled for this collection.
+     */
+    void hangAfterHandlingBatchIfRequested();
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -277,6 +344,20 @@ private:
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
     bool _lostNonResumableCursor = false;  // (X)
+
+    // Whether computeQueryPartitions() has run. It only runs once, so that a retried query stage
+    // resumes the partitions chosen by the first attempt.
+    bool _partitionsComputed = false;  // (X)
+
+    // The _id ranges to clone concurrently. Empty if the collection is cloned with one query.
+    // While runPartitionedQuery() runs, each partition is only accessed by its own query thread.
+    std::vector<QueryPartition> _partitions;  // (X)
+
+    // Set when a partition query fails, so that the other partition queries stop early.
+    AtomicWord<bool> _partitionQueryFailed{false};  // (S)
+
+    // Creates and authenticates the connections used by partition queries.
+    CreateClientFn _createClientFn;  // (R)
 };
 
 }  // namespace repl
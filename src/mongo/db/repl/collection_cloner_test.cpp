@@ -1148,5 +1148,31 @@ TEST_F(CollectionClonerTestNonResumable, NonResumableCursorErrorThenSuccessEqual
     clonerThread.join();
 }
 
+TEST(CollectionClonerPartitionQueryTest, BoundsApplyAsIndexBoundsOnTheIdIndex) {
+    auto query = CollectionCloner::makePartitionQuery(BSON("_id" << 10), BSON("_id" << 20), {});
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1), query.obj["$hint"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 10), query.obj["$min"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 20), query.obj["$max"].Obj());
+
+    // An unbounded side of the first and last partitions is omitted.
+    query = CollectionCloner::makePartitionQuery({}, BSON("_id" << 20), {});
+    ASSERT_FALSE(query.obj.hasField("$min"));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 20), query.obj["$max"].Obj());
+    query = CollectionCloner::makePartitionQuery(BSON("_id" << 10), {}, {});
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 10), query.obj["$min"].Obj());
+    ASSERT_FALSE(query.obj.hasField("$max"));
+}
+
+TEST(CollectionClonerPartitionQueryTest, ResumedPartitionStartsAtLastReceivedId) {
+    auto query = CollectionCloner::makePartitionQuery(
+        BSON("_id" << 10), BSON("_id" << 20), BSON("_id" << 15));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 15), query.obj["$min"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 20), query.obj["$max"].Obj());
+
+    query = CollectionCloner::makePartitionQuery({}, {}, BSON("_id" << 15));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 15), query.obj["$min"].Obj());
+    ASSERT_FALSE(query.obj.hasField("$max"));
+}
+
 }  // namespace repl
 }  // namespace mongo
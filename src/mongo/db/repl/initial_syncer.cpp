@@ -51,6 +51,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/all_database_cloner.h"
 #include "mongo/db/repl/initial_sync_state.h"
+#include "mongo/db/repl/initial_syncer_factory.h"
 #include "mongo/db/repl/member_state.h"
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_fetcher.h"
@@ -190,6 +191,25 @@ void pauseAtInitialSyncFuzzerSyncronizationPoints(std::string msg) {
     }
 }
 
+ServiceContext::ConstructorActionRegisterer logicalInitialSyncerRegisterer{
+    "LogicalInitialSyncerRegisterer", [](ServiceContext* service) {
+        InitialSyncerFactory::get(service)->registerInitialSyncer(
+            InitialSyncer::kInitialSyncMethod.toString(),
+            [](InitialSyncerOptions opts,
+               std::unique_ptr<DataReplicatorExternalState> dataReplicatorExternalState,
+               ThreadPool* writerPool,
+               StorageInterface* storage,
+               ReplicationProcess* replicationProcess,
+               const InitialSyncerInterface::OnCompletionFn& onCompletion) {
+                return std::make_shared<InitialSyncer>(std::move(opts),
+                                                       std::move(dataReplicatorExternalState),
+                                                       writerPool,
+                                                       storage,
+                                                       replicationProcess,
+                                                       onCompletion);
+            });
+    }};
+
 }  // namespace
 
 InitialSyncer::InitialSyncer(
@@ -320,6 +340,10 @@ Status InitialSyncer::shutdown() {
     return Status::OK();
 }
 
+std::string InitialSyncer::getInitialSyncMethod() const {
+    return kInitialSyncMethod.toString();
+}
+
 void InitialSyncer::cancelCurrentAttempt() {
     stdx::lock_guard lk(_mutex);
     if (_isActive_inlock()) {
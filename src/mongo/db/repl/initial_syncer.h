@@ -44,6 +44,7 @@
 #include "mongo/db/repl/callback_completion_guard.h"
 #include "mongo/db/repl/data_replicator_external_state.h"
 #include "mongo/db/repl/initial_sync_shared_data.h"
+#include "mongo/db/repl/initial_syncer_interface.h"
 #include "mongo/db/repl/multiapplier.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/oplog_buffer.h"
@@ -76,50 +77,6 @@ struct MemberState;
 class ReplicationProcess;
 class StorageInterface;
 
-struct InitialSyncerOptions {
-    /** Function to return optime of last operation applied on this node */
-    using GetMyLastOptimeFn = std::function<OpTime()>;
-
-    /** Function to update optime of last operation applied on this node */
-    using SetMyLastOptimeFn = std::function<void(
-        const OpTimeAndWallTime&, ReplicationCoordinator::DataConsistency consistency)>;
-
-    /** Function to reset all optimes on this node (e.g. applied & durable). */
-    using ResetOptimesFn = std::function<void()>;
-
-    /** Function to sets this node into a specific follower mode. */
-    using SetFollowerModeFn = std::function<bool(const MemberState&)>;
-
-    // Retry values
-    Milliseconds syncSourceRetryWait{1000};
-    Milliseconds initialSyncRetryWait{1000};
-
-    // InitialSyncer waits this long before retrying getApplierBatchCallback() if there are
-    // currently no operations available to apply or if the 'rsSyncApplyStop' failpoint is active.
-    // This default value is based on the duration in OplogBatcher::run().
-    Milliseconds getApplierBatchCallbackRetryWait{1000};
-
-    // Replication settings
-    NamespaceString localOplogNS = NamespaceString::kRsOplogNamespace;
-    NamespaceString remoteOplogNS = NamespaceString::kRsOplogNamespace;
-
-    GetMyLastOptimeFn getMyLastOptime;
-    SetMyLastOptimeFn setMyLastOptime;
-    ResetOptimesFn resetOptimes;
-
-    SyncSourceSelector* syncSourceSelector = nullptr;
-
-    // The oplog fetcher will restart the oplog tailing query this many times on non-cancellation
-    // failures.
-    std::uint32_t oplogFetcherMaxFetcherRestarts = 0;
-
-    std::string toString() const {
-        return str::stream() << "InitialSyncerOptions -- "
-                             << " localOplogNs: " << localOplogNS.toString()
-                             << " remoteOplogNS: " << remoteOplogNS.toString();
-    }
-};
-
 /**
  * The initial syncer provides services to keep collection in sync by replicating
  * changes via an oplog source to the local system storage.
@@ -131,15 +88,16 @@ struct InitialSyncerOptions {
  * Entry Points:
  *      -- startup: Start initial sync.
  */
-class InitialSyncer {
+class InitialSyncer : public InitialSyncerInterface {
     InitialSyncer(const InitialSyncer&) = delete;
     InitialSyncer& operator=(const InitialSyncer&) = delete;
 
 public:
     /**
-     * Callback function to report last applied optime of initial sync.
+     * Initial sync method implemented by this class, which copies data logically by cloning
+     * every document and rebuilding every index.
      */
-    typedef std::function<void(const StatusWith<OpTimeAndWallTime>& lastApplied)> OnCompletionFn;
+    static constexpr StringData kInitialSyncMethod = "logical"_sd;
 
     /**
      * Callback completion guard for initial syncer.
@@ -234,17 +192,17 @@ public:
     /**
      * Starts initial sync process, with the provided number of attempts
      */
-    Status startup(OperationContext* opCtx, std::uint32_t maxAttempts) noexcept;
+    Status startup(OperationContext* opCtx, std::uint32_t maxAttempts) noexcept final;
 
     /**
      * Shuts down replication if "start" has been called, and blocks until shutdown has completed.
      */
-    Status shutdown();
+    Status shutdown() final;
 
     /**
      * Block until inactive.
      */
-    void join();
+    void join() final;
 
     /**
      * Returns internal state in a loggable format.
@@ -255,12 +213,14 @@ public:
      * Returns stats about the progress of initial sync. If initial sync is not in progress it
      * returns an empty BSON object.
      */
-    BSONObj getInitialSyncProgress() const;
+    BSONObj getInitialSyncProgress() const final;
 
     /**
      * Cancels the current initial sync attempt if the initial syncer is active.
      */
-    void cancelCurrentAttempt();
+    void cancelCurrentAttempt() final;
+
+    std::string getInitialSyncMethod() const final;
 
     /**
      *
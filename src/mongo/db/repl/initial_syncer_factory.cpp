@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/initial_syncer_factory.h"
+
+#include "mongo/db/service_context.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const auto getInitialSyncerFactory = ServiceContext::declareDecoration<InitialSyncerFactory>();
+
+}  // namespace
+
+InitialSyncerFactory* InitialSyncerFactory::get(ServiceContext* service) {
+    return &getInitialSyncerFactory(service);
+}
+
+void InitialSyncerFactory::registerInitialSyncer(
+    const std::string& initialSyncMethod, CreateInitialSyncerFunction createInitialSyncerFunction) {
+    invariant(createInitialSyncerFunction);
+    const bool inserted = _createInitialSyncerFunctions
+                              .emplace(initialSyncMethod, std::move(createInitialSyncerFunction))
+                              .second;
+    invariant(inserted, str::stream() << "Initial sync method " << initialSyncMethod
+                                      << " registered more than once");
+}
+
+bool InitialSyncerFactory::hasInitialSyncer(StringData initialSyncMethod) const {
+    return _createInitialSyncerFunctions.find(initialSyncMethod) !=
+        _createInitialSyncerFunctions.end();
+}
+
+StatusWith<std::shared_ptr<InitialSyncerInterface>> InitialSyncerFactory::createInitialSyncer(
+    StringData initialSyncMethod,
+    InitialSyncerOptions opts,
+    std::unique_ptr<DataReplicatorExternalState> dataReplicatorExternalState,
+    ThreadPool* writerPool,
+    StorageInterface* storage,
+    ReplicationProcess* replicationProcess,
+    const InitialSyncerInterface::OnCompletionFn& onCompletion) const {
+    auto it = _createInitialSyncerFunctions.find(initialSyncMethod);
+    if (it == _createInitialSyncerFunctions.end()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "Initial sync method '" << initialSyncMethod
+                                    << "' is not available in this build");
+    }
+    return it->second(std::move(opts),
+                      std::move(dataReplicatorExternalState),
+                      writerPool,
+                      storage,
+                      replicationProcess,
+                      onCompletion);
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/initial_syncer.h"
+#include "mongo/db/repl/initial_syncer_factory.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+class InitialSyncerMock final : public InitialSyncerInterface {
+public:
+    Status startup(OperationContext* opCtx, std::uint32_t maxAttempts) noexcept final {
+        return Status::OK();
+    }
+
+    Status shutdown() final {
+        return Status::OK();
+    }
+
+    void join() final {}
+
+    BSONObj getInitialSyncProgress() const final {
+        return BSONObj();
+    }
+
+    void cancelCurrentAttempt() final {}
+
+    std::string getInitialSyncMethod() const final {
+        return "mock";
+    }
+};
+
+using InitialSyncerFactoryTest = ServiceContextTest;
+
+StatusWith<std::shared_ptr<InitialSyncerInterface>> createInitialSyncer(
+    InitialSyncerFactory* factory, StringData initialSyncMethod) {
+    return factory->createInitialSyncer(initialSyncMethod,
+                                        InitialSyncerOptions(),
+                                        nullptr /* dataReplicatorExternalState */,
+                                        nullptr /* writerPool */,
+                                        nullptr /* storage */,
+                                        nullptr /* replicationProcess */,
+                                        [](const StatusWith<OpTimeAndWallTime>&) {});
+}
+
+TEST_F(InitialSyncerFactoryTest, LogicalInitialSyncIsRegisteredWithTheServiceContext) {
+    auto factory = InitialSyncerFactory::get(getServiceContext());
+    ASSERT_TRUE(factory->hasInitialSyncer(InitialSyncer::kInitialSyncMethod));
+    ASSERT_FALSE(factory->hasInitialSyncer("mock"));
+}
+
+TEST_F(InitialSyncerFactoryTest, CreateInitialSyncerFailsForUnavailableMethod) {
+    auto factory = InitialSyncerFactory::get(getServiceContext());
+    ASSERT_EQ(ErrorCodes::InvalidOptions, createInitialSyncer(factory, "mock").getStatus());
+}
+
+TEST_F(InitialSyncerFactoryTest, CreateInitialSyncerUsesTheRegisteredMethod) {
+    auto factory = InitialSyncerFactory::get(getServiceContext());
+    int numCreated = 0;
+    factory->registerInitialSyncer(
+        "mock",
+        [&](InitialSyncerOptions opts,
+            std::unique_ptr<DataReplicatorExternalState> dataReplicatorExternalState,
+            ThreadPool* writerPool,
+            StorageInterface* storage,
+            ReplicationProcess* replicationProcess,
+            const InitialSyncerInterface::OnCompletionFn& onCompletion) {
+            ++numCreated;
+            return std::make_shared<InitialSyncerMock>();
+        });
+    ASSERT_TRUE(factory->hasInitialSyncer("mock"));
+
+    auto initialSyncer = uassertStatusOK(createInitialSyncer(factory, "mock"));
+    ASSERT_EQ(1, numCreated);
+    ASSERT_EQ("mock", initialSyncer->getInitialSyncMethod());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/sync_source_selector.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+class OperationContext;
+
+namespace repl {
+
+struct MemberState;
+
+struct InitialSyncerOptions {
+    /** Function to return optime of last operation applied on this node */
+    using GetMyLastOptimeFn = std::function<OpTime()>;
+
+    /** Function to update optime of last operation applied on this node */
+    using SetMyLastOptimeFn = std::function<void(
+        const OpTimeAndWallTime&, ReplicationCoordinator::DataConsistency consistency)>;
+
+    /** Function to reset all optimes on this node (e.g. applied & durable). */
+    using ResetOptimesFn = std::function<void()>;
+
+    /** Function to sets this node into a specific follower mode. */
+    using SetFollowerModeFn = std::function<bool(const MemberState&)>;
+
+    // Retry values
+    Milliseconds syncSourceRetryWait{1000};
+    Milliseconds initialSyncRetryWait{1000};
+
+    // InitialSyncer waits this long before retrying getApplierBatchCallback() if there are
+    // currently no operations available to apply or if the 'rsSyncApplyStop' failpoint is active.
+    // This default value is based on the duration in OplogBatcher::run().
+    Milliseconds getApplierBatchCallbackRetryWait{1000};
+
+    // Replication settings
+    NamespaceString localOplogNS = NamespaceString::kRsOplogNamespace;
+    NamespaceString remoteOplogNS = NamespaceString::kRsOplogNamespace;
+
+    GetMyLastOptimeFn getMyLastOptime;
+    SetMyLastOptimeFn setMyLastOptime;
+    ResetOptimesFn resetOptimes;
+
+    SyncSourceSelector* syncSourceSelector = nullptr;
+
+    // The oplog fetcher will restart the oplog tailing query this many times on non-cancellation
+    // failures.
+    std::uint32_t oplogFetcherMaxFetcherRestarts = 0;
+
+    std::string toString() const {
+        return str::stream() << "InitialSyncerOptions -- "
+                             << " localOplogNs: " << localOplogNS.toString()
+                             << " remoteOplogNS: " << remoteOplogNS.toString();
+    }
+};
+
+/**
+ * An initial syncer brings a node with no data up to date with its sync source. Each initial sync
+ * method, selected with the 'initialSyncMethod' server parameter, provides its own implementation
+ * and registers it with the InitialSyncerFactory.
+ */
+class InitialSyncerInterface {
+    InitialSyncerInterface(const InitialSyncerInterface&) = delete;
+    InitialSyncerInterface& operator=(const InitialSyncerInterface&) = delete;
+
+public:
+    /**
+     * Callback function to report last applied optime of initial sync.
+     */
+    typedef std::function<void(const StatusWith<OpTimeAndWallTime>& lastApplied)> OnCompletionFn;
+
+    InitialSyncerInterface() = default;
+    virtual ~InitialSyncerInterface() = default;
+
+    /**
+     * Starts initial sync process, with the provided number of attempts
+     */
+    virtual Status startup(OperationContext* opCtx, std::uint32_t maxAttempts) noexcept = 0;
+
+    /**
+     * Shuts down replication if "start" has been called, and blocks until shutdown has completed.
+     */
+    virtual Status shutdown() = 0;
+
+    /**
+     * Block until inactive.
+     */
+    virtual void join() = 0;
+
+    /**
+     * Returns stats about the progress of initial sync. If initial sync is not in progress it
+     * returns an empty BSON object.
+     */
+    virtual BSONObj getInitialSyncProgress() const = 0;
+
+    /**
+     * Cancels the current initial sync attempt if the initial syncer is active.
+     */
+    virtual void cancelCurrentAttempt() = 0;
+
+    /**
+     * Returns the name of the initial sync method this initial syncer implements.
+     */
+    virtual std::string getInitialSyncMethod() const = 0;
+};
+
+}  // namespace repl
+}  // namespace mongo
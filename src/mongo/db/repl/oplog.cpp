@@ -35,6 +35,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <set>
@@ -343,18 +344,33 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
 
     WriteUnitOfWork wuow(opCtx);
 
+    // Fetch the optimes of the statements which don't have one yet all at once.
+    const auto numMissingOpTimes =
+        std::count_if(begin, end, [](const auto& insert) { return insert.oplogSlot.isNull(); });
+    std::vector<OplogSlot> missingOpTimes;
+    if (numMissingOpTimes > 0) {
+        missingOpTimes = oplogInfo->getNextOpTimes(opCtx, numMissingOpTimes);
+    }
+    auto nextMissingOpTime = missingOpTimes.begin();
+
+    // Serialize all the oplog entries into one buffer instead of allocating each separately. Its
+    // initial size fits the documents plus a generous allowance for the remaining fields.
+    size_t bytesEstimate = 0;
+    for (auto it = begin; it != end; ++it) {
+        bytesEstimate += it->doc.objsize() + 256;
+    }
+    BufBuilder oplogEntriesBuffer(bytesEstimate);
+    std::vector<int> oplogEntryOffsets(count);
+
     std::vector<OpTime> opTimes(count);
     std::vector<Timestamp> timestamps(count);
-    std::vector<BSONObj> bsonOplogEntries(count);
-    std::vector<Record> records(count);
     for (size_t i = 0; i < count; i++) {
         // Make a copy from the template for each insert oplog entry.
         MutableOplogEntry oplogEntry = *oplogEntryTemplate;
         // Make a mutable copy.
         auto insertStatementOplogSlot = begin[i].oplogSlot;
-        // Fetch optime now, if not already fetched.
         if (insertStatementOplogSlot.isNull()) {
-            insertStatementOplogSlot = oplogInfo->getNextOpTimes(opCtx, 1U)[0];
+            insertStatementOplogSlot = *nextMissingOpTime++;
         }
         oplogEntry.setObject(begin[i].doc);
         oplogEntry.setOpTime(insertStatementOplogSlot);
@@ -366,11 +382,19 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
 
         opTimes[i] = insertStatementOplogSlot;
         timestamps[i] = insertStatementOplogSlot.getTimestamp();
-        bsonOplogEntries[i] = oplogEntry.toBSON();
+        oplogEntryOffsets[i] = oplogEntriesBuffer.len();
+        BSONObjBuilder oplogEntryBuilder(oplogEntriesBuffer);
+        oplogEntry.serialize(&oplogEntryBuilder);
+        oplogEntryBuilder.doneFast();
+    }
+
+    // The buffer may have moved while it grew, so the records only point into it once it is full.
+    std::vector<Record> records(count);
+    for (size_t i = 0; i < count; i++) {
+        BSONObj oplogEntry(oplogEntriesBuffer.buf() + oplogEntryOffsets[i]);
         // The storage engine will assign the RecordId based on the "ts" field of the oplog entry,
         // see oploghack::extractKey.
-        records[i] = Record{
-            RecordId(), RecordData(bsonOplogEntries[i].objdata(), bsonOplogEntries[i].objsize())};
+        records[i] = Record{RecordId(), RecordData(oplogEntry.objdata(), oplogEntry.objsize())};
     }
 
     sleepBetweenInsertOpTimeGenerationAndLogOp.execute([&](const BSONObj& data) {
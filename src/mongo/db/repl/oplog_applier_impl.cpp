@@ -31,6 +31,9 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -419,6 +422,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             ? new ApplyBatchFinalizerForJournal(_replCoord)
             : new ApplyBatchFinalizer(_replCoord)};
 
+    boost::optional<LookAheadBatch> lookAhead;
     while (true) {  // Exits on message from OplogBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -442,8 +446,17 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         _replCoord->finishRecoveryIfEligible(&opCtx);
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
-        // ready in time, we'll loop again so we can do the above checks periodically.
-        OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+        // ready in time, we'll loop again so we can do the above checks periodically. The batch may
+        // already have been taken while the previous batch was being applied.
+        boost::optional<PreparedWriterVectors> prepared;
+        OplogBatch ops(0);
+        if (lookAhead) {
+            ops = std::move(lookAhead->batch);
+            prepared = std::move(lookAhead->prepared);
+            lookAhead.reset();
+        } else {
+            ops = _oplogBatcher->getNextBatch(Seconds(1));
+        }
         if (ops.empty()) {
             if (ops.mustShutdown()) {
                 // Shut down and exit oplog application loop.
@@ -485,7 +498,8 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
         // last op that was applied, which should be the last optime in the batch.
-        auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
+        auto swLastOpTimeAppliedInBatch = _applyOplogBatchWithLookAhead(
+            &opCtx, ops.releaseBatch(), std::move(prepared), &lookAhead);
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
             // appliedThrough as if this were an unclean shutdown. This ensures the stable timestamp
@@ -599,6 +613,21 @@ void scheduleWritesToOplog(OperationContext* opCtx,
 
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       std::vector<OplogEntry> ops) {
+    return _applyOplogBatchWithLookAhead(opCtx, std::move(ops), boost::none, nullptr);
+}
+
+namespace {
+bool containsOnlyCrudOps(const std::vector<OplogEntry>& ops) {
+    return std::all_of(
+        ops.begin(), ops.end(), [](const OplogEntry& op) { return op.isCrudOpType(); });
+}
+}  // namespace
+
+StatusWith<OpTime> OplogApplierImpl::_applyOplogBatchWithLookAhead(
+    OperationContext* opCtx,
+    std::vector<OplogEntry> ops,
+    boost::optional<PreparedWriterVectors> prepared,
+    boost::optional<LookAheadBatch>* lookAhead) {
     invariant(!ops.empty());
 
     LOGV2_DEBUG(21230,
@@ -646,9 +675,14 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         //   and create a pseudo oplog.
         std::vector<std::vector<OplogEntry>> derivedOps;
 
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        std::vector<std::vector<const OplogEntry*>> writerVectors;
+        if (prepared) {
+            writerVectors = std::move(prepared->writerVectors);
+            derivedOps = std::move(prepared->derivedOps);
+        } else {
+            writerVectors.resize(_writerPool->getStats().numThreads);
+            fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        }
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
@@ -697,6 +731,29 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     });
             }
 
+            // While the writers apply this batch, take the next batch from the batcher and group
+            // its operations for the writers. This is only safe when neither batch contains
+            // commands, since commands can change the collection properties and the oplog
+            // contents that filling the writer vectors depends on.
+            if (lookAhead && replPrepareNextBatchWhileApplying.load() &&
+                containsOnlyCrudOps(ops)) {
+                auto nextBatch = _oplogBatcher->getNextBatch(Seconds(0));
+                if (!nextBatch.empty() || nextBatch.mustShutdown() ||
+                    nextBatch.termWhenExhausted()) {
+                    lookAhead->emplace(std::move(nextBatch));
+                }
+                if (*lookAhead && !(*lookAhead)->batch.empty() &&
+                    containsOnlyCrudOps((*lookAhead)->batch.getBatch())) {
+                    (*lookAhead)->prepared.emplace();
+                    auto& nextPrepared = *(*lookAhead)->prepared;
+                    nextPrepared.writerVectors.resize(_writerPool->getStats().numThreads);
+                    fillWriterVectors(opCtx,
+                                      (*lookAhead)->batch.getMutableBatch(),
+                                      &nextPrepared.writerVectors,
+                                      &nextPrepared.derivedOps);
+                }
+            }
+
             _writerPool->waitForIdle();
 
             // If any of the statuses is not ok, return error.
@@ -885,14 +942,62 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // Hash the operations into several buckets per writer and then hand out whole buckets by size,
+    // so that a hot document or capped collection does not also hold up every other operation
+    // which happens to hash to its writer.
+    const size_t bucketsPerWriter = replWriterBucketsPerThread.load();
+    std::vector<std::vector<const OplogEntry*>> buckets;
+    auto targets = writerVectors;
+    if (bucketsPerWriter > 1) {
+        buckets.resize(writerVectors->size() * bucketsPerWriter);
+        targets = &buckets;
+    }
+
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(opCtx, ops, targets, derivedOps, &sessionUpdateTracker);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        _deriveOpsAndFillWriterVectors(opCtx, &derivedOps->back(), targets, derivedOps, nullptr);
+    }
+
+    if (targets != writerVectors) {
+        balanceWriterVectors(&buckets, writerVectors);
+    }
+}
+
+void balanceWriterVectors(std::vector<std::vector<const OplogEntry*>>* buckets,
+                          std::vector<std::vector<const OplogEntry*>>* writerVectors) {
+    invariant(!writerVectors->empty());
+
+    std::vector<size_t> bySize(buckets->size());
+    std::iota(bySize.begin(), bySize.end(), 0);
+    std::stable_sort(bySize.begin(), bySize.end(), [&](size_t lhs, size_t rhs) {
+        return (*buckets)[lhs].size() > (*buckets)[rhs].size();
+    });
+
+    std::vector<size_t> writerSizes(writerVectors->size());
+    for (size_t i = 0; i < writerVectors->size(); ++i) {
+        writerSizes[i] = (*writerVectors)[i].size();
+    }
+
+    for (auto bucketIndex : bySize) {
+        auto& bucket = (*buckets)[bucketIndex];
+        if (bucket.empty()) {
+            // The buckets are sorted by size, so all of the remaining ones are empty too.
+            break;
+        }
+
+        const size_t writerIndex =
+            std::min_element(writerSizes.begin(), writerSizes.end()) - writerSizes.begin();
+        auto& writer = (*writerVectors)[writerIndex];
+        if (writer.empty()) {
+            writer = std::move(bucket);
+        } else {
+            writer.insert(writer.end(), bucket.begin(), bucket.end());
+        }
+        writerSizes[writerIndex] = writer.size();
     }
 }
 
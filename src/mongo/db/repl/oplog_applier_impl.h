@@ -98,6 +98,39 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Writer vectors and derived operations which were prepared for a batch before it was applied.
+     * The writer vectors point into the batch and into 'derivedOps', whose buffers are preserved
+     * when they are moved.
+     */
+    struct PreparedWriterVectors {
+        std::vector<std::vector<const OplogEntry*>> writerVectors;
+        std::vector<std::vector<OplogEntry>> derivedOps;
+    };
+
+    /**
+     * The batch following the one being applied, taken from the OplogBatcher while the writer
+     * threads were busy with the current batch.
+     */
+    struct LookAheadBatch {
+        explicit LookAheadBatch(OplogBatch batch) : batch(std::move(batch)) {}
+
+        OplogBatch batch;
+        boost::optional<PreparedWriterVectors> prepared;
+    };
+
+    /**
+     * Same as _applyOplogBatch(), but uses 'prepared' instead of filling the writer vectors when it
+     * is set. If 'lookAhead' is not null, takes the next batch from the OplogBatcher while this
+     * batch is being applied and, when neither batch contains commands, fills the writer vectors
+     * of the next batch as well.
+     */
+    StatusWith<OpTime> _applyOplogBatchWithLookAhead(
+        OperationContext* opCtx,
+        std::vector<OplogEntry> ops,
+        boost::optional<PreparedWriterVectors> prepared,
+        boost::optional<LookAheadBatch>* lookAhead);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -139,6 +172,14 @@ protected:
                                             WorkerMultikeyPathInfo* workerMultikeyPathInfo);
 };
 
+/**
+ * Moves the contents of 'buckets' into 'writerVectors' so that every bucket is assigned to exactly
+ * one writer, visiting the buckets from largest to smallest and always choosing the writer with
+ * the fewest operations so far. Operations within a bucket keep their relative order.
+ */
+void balanceWriterVectors(std::vector<std::vector<const OplogEntry*>>* buckets,
+                          std::vector<std::vector<const OplogEntry*>>* writerVectors);
+
 /**
  * Applies either a single oplog entry or a set of grouped insert operations.
  */
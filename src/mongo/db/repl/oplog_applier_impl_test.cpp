@@ -3801,6 +3801,42 @@ TEST_F(IdempotencyTestTxns, CommitPreparedTransactionIgnoresNamespaceNotFoundErr
     // operation has no effect.
     ASSERT_FALSE(docExists(_opCtx.get(), nss, doc));
 }
+
+TEST(OplogApplierImplBalanceTest, BalanceWriterVectorsSpreadsBucketsAcrossWriters) {
+    NamespaceString nss("test.t");
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 8; ++i) {
+        ops.push_back(
+            makeInsertDocumentOplogEntry({Timestamp(Seconds(1), i), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    // One hot bucket and several small ones which would all share the hot bucket's writer if
+    // buckets were assigned to writers by index.
+    std::vector<std::vector<const OplogEntry*>> buckets(6);
+    for (int i = 0; i < 4; ++i) {
+        buckets[0].push_back(&ops[i]);
+    }
+    buckets[2].push_back(&ops[4]);
+    buckets[2].push_back(&ops[5]);
+    buckets[4].push_back(&ops[6]);
+    buckets[4].push_back(&ops[7]);
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(2);
+    balanceWriterVectors(&buckets, &writerVectors);
+
+    ASSERT_EQUALS(4U, writerVectors[0].size());
+    ASSERT_EQUALS(4U, writerVectors[1].size());
+
+    // The hot bucket stays together and in order on a single writer.
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQUALS(&ops[i], writerVectors[0][i]);
+    }
+    ASSERT_EQUALS(&ops[4], writerVectors[1][0]);
+    ASSERT_EQUALS(&ops[5], writerVectors[1][1]);
+    ASSERT_EQUALS(&ops[6], writerVectors[1][2]);
+    ASSERT_EQUALS(&ops[7], writerVectors[1][3]);
+}
+
 }  // namespace
 }  // namespace repl
 }  // namespace mongo
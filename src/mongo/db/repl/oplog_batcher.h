@@ -63,6 +63,9 @@ public:
     const std::vector<OplogEntry>& getBatch() const {
         return _batch;
     }
+    std::vector<OplogEntry>* getMutableBatch() {
+        return &_batch;
+    }
 
     void emplace_back(OplogEntry oplog) {
         invariant(!_mustShutdown);
@@ -195,6 +195,20 @@ public:
         size.decrement(std::size_t(value.objsize()));
     }
 
+    /**
+     * Batch variants of increment() and decrement() for buffers that account for a whole batch
+     * of operations at once.
+     */
+    void increment(std::size_t batchCount, std::size_t batchSize) {
+        count.increment(batchCount);
+        size.increment(batchSize);
+    }
+
+    void decrement(std::size_t batchCount, std::size_t batchSize) {
+        count.decrement(batchCount);
+        size.decrement(batchSize);
+    }
+
     // Number of operations in this OplogBuffer.
     Counter64 count;
 
@@ -31,6 +31,8 @@
 
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 
+#include <boost/optional.hpp>
+
 namespace mongo {
 namespace repl {
 
@@ -47,8 +49,7 @@ size_t getDocumentSize(const BSONObj& o) {
 }  // namespace
 
 OplogBufferBlockingQueue::OplogBufferBlockingQueue() : OplogBufferBlockingQueue(nullptr) {}
-OplogBufferBlockingQueue::OplogBufferBlockingQueue(Counters* counters)
-    : _counters(counters), _queue(kOplogBufferSize, &getDocumentSize) {}
+OplogBufferBlockingQueue::OplogBufferBlockingQueue(Counters* counters) : _counters(counters) {}
 
 void OplogBufferBlockingQueue::startup(OperationContext*) {
     // Update server status metric to reflect the current oplog buffer's max size.
@@ -65,22 +66,46 @@ void OplogBufferBlockingQueue::push(OperationContext*,
                                     Batch::const_iterator begin,
                                     Batch::const_iterator end) {
     invariant(!_drainMode);
-    _queue.pushAllBlocking(begin, end);
+    if (begin == end) {
+        return;
+    }
+
+    // Build the batch outside the lock so that the consumer is only blocked for the O(1) append.
+    PushedBatch batch;
+    batch.docs.assign(begin, end);
+    for (const auto& doc : batch.docs) {
+        batch.size += getDocumentSize(doc);
+    }
+    const auto batchCount = batch.docs.size();
+    const auto batchSize = batch.size;
+
+    {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _waitForSpace_inlock(lk, batchSize);
+        _batches.push_back(std::move(batch));
+        _size += batchSize;
+        _count += batchCount;
+    }
     _notEmptyCv.notify_one();
 
     if (_counters) {
-        for (auto i = begin; i != end; ++i) {
-            _counters->increment(*i);
-        }
+        _counters->increment(batchCount, batchSize);
     }
 }
 
 void OplogBufferBlockingQueue::waitForSpace(OperationContext*, std::size_t size) {
-    _queue.waitForSpace(size);
+    stdx::unique_lock<Latch> lk(_mutex);
+    _waitForSpace_inlock(lk, size);
+}
+
+void OplogBufferBlockingQueue::_waitForSpace_inlock(stdx::unique_lock<Latch>& lk,
+                                                    std::size_t size) {
+    _notFullCv.wait(lk, [&] { return _size + size <= kOplogBufferSize; });
 }
 
 bool OplogBufferBlockingQueue::isEmpty() const {
-    return _queue.empty();
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _count == 0;
 }
 
 std::size_t OplogBufferBlockingQueue::getMaxSize() const {
@@ -88,55 +113,90 @@ std::size_t OplogBufferBlockingQueue::getMaxSize() const {
 }
 
 std::size_t OplogBufferBlockingQueue::getSize() const {
-    return _queue.size();
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _size;
 }
 
 std::size_t OplogBufferBlockingQueue::getCount() const {
-    return _queue.count();
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _count;
 }
 
 void OplogBufferBlockingQueue::clear(OperationContext*) {
-    _queue.clear();
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _batches.clear();
+        _frontBatchPos = 0;
+        _size = 0;
+        _count = 0;
+        _notFullCv.notify_one();
+    }
     if (_counters) {
         _counters->clear();
     }
 }
 
 bool OplogBufferBlockingQueue::tryPop(OperationContext*, Value* value) {
-    if (!_queue.tryPop(*value)) {
-        return false;
+    boost::optional<PushedBatch> consumedBatch;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_count == 0) {
+            return false;
+        }
+        auto& front = _batches.front();
+        *value = std::move(front.docs[_frontBatchPos]);
+        --_count;
+        if (++_frontBatchPos < front.docs.size()) {
+            return true;
+        }
+
+        // The batch is fully consumed, so release its memory. The documents are destroyed
+        // outside the lock.
+        consumedBatch = std::move(front);
+        _batches.pop_front();
+        _frontBatchPos = 0;
+        _size -= consumedBatch->size;
+        _notFullCv.notify_one();
     }
     if (_counters) {
-        _counters->decrement(*value);
+        _counters->decrement(consumedBatch->docs.size(), consumedBatch->size);
     }
     return true;
 }
 
 bool OplogBufferBlockingQueue::waitForData(Seconds waitDuration) {
-    Value ignored;
-    stdx::unique_lock<Latch> lk(_notEmptyMutex);
+    stdx::unique_lock<Latch> lk(_mutex);
     _notEmptyCv.wait_for(
-        lk, waitDuration.toSystemDuration(), [&] { return _drainMode || _queue.peek(ignored); });
-    return _queue.peek(ignored);
+        lk, waitDuration.toSystemDuration(), [&] { return _drainMode || _count > 0; });
+    return _count > 0;
 }
 
 bool OplogBufferBlockingQueue::peek(OperationContext*, Value* value) {
-    return _queue.peek(*value);
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_count == 0) {
+        return false;
+    }
+    *value = _batches.front().docs[_frontBatchPos];
+    return true;
 }
 
 boost::optional<OplogBuffer::Value> OplogBufferBlockingQueue::lastObjectPushed(
     OperationContext*) const {
-    return _queue.lastObjectPushed();
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_count == 0) {
+        return boost::none;
+    }
+    return _batches.back().docs.back();
 }
 
 void OplogBufferBlockingQueue::enterDrainMode() {
-    stdx::lock_guard<Latch> lk(_notEmptyMutex);
+    stdx::lock_guard<Latch> lk(_mutex);
     _drainMode = true;
     _notEmptyCv.notify_one();
 }
 
 void OplogBufferBlockingQueue::exitDrainMode() {
-    stdx::lock_guard<Latch> lk(_notEmptyMutex);
+    stdx::lock_guard<Latch> lk(_mutex);
     _drainMode = false;
 }
 
@@ -29,14 +29,28 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
+
 #include "mongo/db/repl/oplog_buffer.h"
-#include "mongo/util/queue.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
 
 namespace mongo {
 namespace repl {
 
 /**
- * Oplog buffer backed by in memory blocking queue of BSONObj.
+ * Oplog buffer backed by an in memory queue of batches of BSONObj.
+ *
+ * Each push() enqueues the whole range as a single batch, so the producer and the consumer each
+ * take the lock once per operation in O(1) time regardless of the size of the batch. The
+ * documents are not copied; they keep sharing ownership of the buffer they were fetched into.
+ *
+ * Memory is accounted per batch: the size of a batch is charged when it is pushed and released
+ * only once its last document has been popped. The count is exact for getCount(), but the
+ * server status counters, if any, are also updated once per batch.
+ *
+ * This class only works with a single producer and a single consumer.
  */
 class OplogBufferBlockingQueue final : public OplogBuffer {
 public:
@@ -65,11 +79,30 @@ public:
     void exitDrainMode() final;
 
 private:
-    Mutex _notEmptyMutex = MONGO_MAKE_LATCH("OplogBufferBlockingQueue::mutex");
+    /**
+     * A range of documents pushed by a single call to push(), along with their total size.
+     */
+    struct PushedBatch {
+        std::vector<Value> docs;
+        std::size_t size = 0;
+    };
+
+    void _waitForSpace_inlock(stdx::unique_lock<Latch>& lk, std::size_t size);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogBufferBlockingQueue::mutex");
     stdx::condition_variable _notEmptyCv;
+    stdx::condition_variable _notFullCv;
     bool _drainMode = false;
     Counters* const _counters;
-    BlockingQueue<BSONObj> _queue;
+
+    // Batches in the order they were pushed. The next document to pop is
+    // '_batches.front().docs[_frontBatchPos]'.
+    std::deque<PushedBatch> _batches;
+    std::size_t _frontBatchPos = 0;
+
+    // Total size of all batches not yet fully consumed, and number of documents not yet popped.
+    std::size_t _size = 0;
+    std::size_t _count = 0;
 };
 
 }  // namespace repl
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <boost/optional/optional_io.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+OperationContext* const kOpCtx = nullptr;  // Not dereferenced.
+
+TEST(OplogBufferBlockingQueueTest, PopsDocumentsAcrossBatchesInOrder) {
+    OplogBufferBlockingQueue buffer;
+    buffer.startup(kOpCtx);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(kOpCtx));
+
+    OplogBuffer::Batch first = {BSON("x" << 1), BSON("x" << 2)};
+    OplogBuffer::Batch second = {BSON("x" << 3)};
+    buffer.push(kOpCtx, first.cbegin(), first.cend());
+    buffer.push(kOpCtx, second.cbegin(), second.cend());
+    ASSERT_EQUALS(3U, buffer.getCount());
+    ASSERT_BSONOBJ_EQ(second[0], *buffer.lastObjectPushed(kOpCtx));
+
+    OplogBuffer::Value value;
+    for (int expected = 1; expected <= 3; ++expected) {
+        ASSERT_TRUE(buffer.peek(kOpCtx, &value));
+        ASSERT_BSONOBJ_EQ(BSON("x" << expected), value);
+        ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+        ASSERT_BSONOBJ_EQ(BSON("x" << expected), value);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_FALSE(buffer.peek(kOpCtx, &value));
+    ASSERT_FALSE(buffer.tryPop(kOpCtx, &value));
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(kOpCtx));
+    buffer.shutdown(kOpCtx);
+}
+
+TEST(OplogBufferBlockingQueueTest, ChargesMemoryPerBatch) {
+    OplogBuffer::Counters counters;
+    OplogBufferBlockingQueue buffer(&counters);
+    buffer.startup(kOpCtx);
+
+    OplogBuffer::Batch batch = {BSON("x" << 1), BSON("x" << 2)};
+    const std::size_t batchSize = batch[0].objsize() + batch[1].objsize();
+    buffer.push(kOpCtx, batch.cbegin(), batch.cend());
+    ASSERT_EQUALS(batchSize, buffer.getSize());
+    ASSERT_EQUALS(2U, counters.count.get());
+    ASSERT_EQUALS(batchSize, counters.size.get());
+
+    // The batch's memory stays charged until its last document is popped.
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+    ASSERT_EQUALS(1U, buffer.getCount());
+    ASSERT_EQUALS(batchSize, buffer.getSize());
+    ASSERT_EQUALS(batchSize, counters.size.get());
+
+    ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0U, counters.count.get());
+    ASSERT_EQUALS(0U, counters.size.get());
+}
+
+TEST(OplogBufferBlockingQueueTest, ClearDiscardsPartiallyConsumedBatch) {
+    OplogBuffer::Counters counters;
+    OplogBufferBlockingQueue buffer(&counters);
+    buffer.startup(kOpCtx);
+
+    OplogBuffer::Batch batch = {BSON("x" << 1), BSON("x" << 2), BSON("x" << 3)};
+    buffer.push(kOpCtx, batch.cbegin(), batch.cend());
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(kOpCtx, &value));
+
+    buffer.clear(kOpCtx);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0U, counters.count.get());
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+
+    buffer.push(kOpCtx, batch.cbegin(), batch.cend());
+    ASSERT_TRUE(buffer.waitForData(Seconds(0)));
+    ASSERT_TRUE(buffer.peek(kOpCtx, &value));
+    ASSERT_BSONOBJ_EQ(batch[0], value);
+}
+
+}  // namespace
@@ -68,6 +68,13 @@ public:
     virtual std::unique_ptr<TransactionHistoryIteratorBase> makeTransactionHistoryIterator(
         const OpTime& startingOpTime, bool permitYield = false) const = 0;
 
+    /**
+     * Returns the optime of the oldest operation in the oplog with a timestamp greater than or
+     * equal to 'ts', or NoMatchingDocument if there is no such operation. Lets callers probe for
+     * individual operations without iterating the whole oplog. Valid only for remote oplogs.
+     */
+    virtual StatusWith<OpTime> findOpTimeAtOrAfter(const Timestamp& ts) const = 0;
+
     /**
      * The host and port of the server.
      */
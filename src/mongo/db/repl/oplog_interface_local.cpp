@@ -104,6 +104,11 @@ std::unique_ptr<TransactionHistoryIteratorBase> OplogInterfaceLocal::makeTransac
     return std::make_unique<TransactionHistoryIterator>(startingOpTime, permitYield);
 }
 
+StatusWith<OpTime> OplogInterfaceLocal::findOpTimeAtOrAfter(const Timestamp&) const {
+    // Should never probe the local oplog.
+    MONGO_UNREACHABLE;
+}
+
 HostAndPort OplogInterfaceLocal::hostAndPort() const {
     return {getHostNameCached(), serverGlobalParams.port};
 }
@@ -31,6 +31,7 @@
 
 #include "mongo/db/repl/oplog_interface_mock.h"
 #include "mongo/db/transaction_history_iterator.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace repl {
@@ -136,6 +137,18 @@ std::unique_ptr<TransactionHistoryIteratorBase> OplogInterfaceMock::makeTransact
     return std::make_unique<TransactionHistoryIteratorMock>(startOpTime, makeIterator());
 }
 
+StatusWith<OpTime> OplogInterfaceMock::findOpTimeAtOrAfter(const Timestamp& ts) const {
+    // Operations are stored in reverse natural order, so search from the oldest one.
+    for (auto it = _operations.rbegin(); it != _operations.rend(); ++it) {
+        auto opTime = fassert(5152900, OpTime::parseFromOplogEntry(it->first));
+        if (opTime.getTimestamp() >= ts) {
+            return opTime;
+        }
+    }
+    return Status(ErrorCodes::NoMatchingDocument,
+                  str::stream() << "no operation at or after " << ts.toString());
+}
+
 HostAndPort OplogInterfaceMock::hostAndPort() const {
     // Returns a default-constructed HostAndPort, which has an empty hostname and an invalid port.
     return {};
@@ -55,6 +55,7 @@ public:
     std::unique_ptr<OplogInterface::Iterator> makeIterator() const override;
     std::unique_ptr<TransactionHistoryIteratorBase> makeTransactionHistoryIterator(
         const OpTime& startOpTime, bool permitYield = false) const override;
+    StatusWith<OpTime> findOpTimeAtOrAfter(const Timestamp& ts) const override;
     HostAndPort hostAndPort() const override;
 
 private:
@@ -100,6 +100,25 @@ OplogInterfaceRemote::makeTransactionHistoryIterator(const OpTime&, bool permitY
     MONGO_UNREACHABLE;
 }
 
+StatusWith<OpTime> OplogInterfaceRemote::findOpTimeAtOrAfter(const Timestamp& ts) const {
+    // A forward scan with a lower bound on 'ts' lets the sync source seek directly to the
+    // operation instead of scanning its oplog.
+    const Query query = Query(BSON("ts" << BSON("$gte" << ts))).hint(BSON("$natural" << 1));
+    const BSONObj fields = BSON("ts" << 1 << "t" << 1);
+    try {
+        auto obj = _getConnection()->findOne(
+            _collectionName, query, &fields, 0, ReadConcernArgs::kImplicitDefault);
+        if (obj.isEmpty()) {
+            return Status(ErrorCodes::NoMatchingDocument,
+                          str::stream() << "no operation at or after " << ts.toString()
+                                        << " in remote oplog");
+        }
+        return OpTime::parseFromOplogEntry(obj);
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+}
+
 HostAndPort OplogInterfaceRemote::hostAndPort() const {
     return _hostAndPort;
 }
@@ -65,6 +65,7 @@
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/repl/check_quorum_for_config_change.h"
 #include "mongo/db/repl/data_replicator_external_state_initial_sync.h"
+#include "mongo/db/repl/initial_syncer_factory.h"
 #include "mongo/db/repl/is_master_response.h"
 #include "mongo/db/repl/isself.h"
 #include "mongo/db/repl/last_vote.h"
@@ -717,7 +718,7 @@ void ReplicationCoordinatorImpl::_finishLoadLocalConfig(
 }
 
 void ReplicationCoordinatorImpl::_stopDataReplication(OperationContext* opCtx) {
-    std::shared_ptr<InitialSyncer> initialSyncerCopy;
+    std::shared_ptr<InitialSyncerInterface> initialSyncerCopy;
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _initialSyncer.swap(initialSyncerCopy);
@@ -814,7 +815,7 @@ void ReplicationCoordinatorImpl::_startDataReplication(OperationContext* opCtx,
         _externalState->startSteadyStateReplication(opCtxHolder.get(), this);
     };
 
-    std::shared_ptr<InitialSyncer> initialSyncerCopy;
+    std::shared_ptr<InitialSyncerInterface> initialSyncerCopy;
     try {
         {
             // Must take the lock to set _initialSyncer, but not call it.
@@ -823,14 +824,16 @@ void ReplicationCoordinatorImpl::_startDataReplication(OperationContext* opCtx,
                 LOGV2(21326, "Initial Sync not starting because replication is shutting down");
                 return;
             }
-            initialSyncerCopy = std::make_shared<InitialSyncer>(
-                createInitialSyncerOptions(this, _externalState.get()),
-                std::make_unique<DataReplicatorExternalStateInitialSync>(this,
-                                                                         _externalState.get()),
-                _externalState->getDbWorkThreadPool(),
-                _storage,
-                _replicationProcess,
-                onCompletion);
+            initialSyncerCopy = uassertStatusOK(
+                InitialSyncerFactory::get(opCtx->getServiceContext())
+                    ->createInitialSyncer(initialSyncMethod,
+                                          createInitialSyncerOptions(this, _externalState.get()),
+                                          std::make_unique<DataReplicatorExternalStateInitialSync>(
+                                              this, _externalState.get()),
+                                          _externalState->getDbWorkThreadPool(),
+                                          _storage,
+                                          _replicationProcess,
+                                          onCompletion));
             _initialSyncer = initialSyncerCopy;
         }
         // InitialSyncer::startup() must be called outside lock because it uses features (eg.
@@ -893,6 +896,12 @@ void ReplicationCoordinatorImpl::startup(OperationContext* opCtx) {
     invariant(_settings.usingReplSets());
     invariant(!ReplSettings::shouldRecoverFromOplogAsStandalone());
 
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "Initial sync method '" << initialSyncMethod
+                          << "' given for parameter 'initialSyncMethod' is not available",
+            InitialSyncerFactory::get(opCtx->getServiceContext())
+                ->hasInitialSyncer(initialSyncMethod));
+
     _storage->initializeStorageControlsForReplication(opCtx->getServiceContext());
 
     {
@@ -958,7 +967,7 @@ void ReplicationCoordinatorImpl::shutdown(OperationContext* opCtx) {
     LOGV2(21328, "Shutting down replication subsystems");
 
     // Used to shut down outside of the lock.
-    std::shared_ptr<InitialSyncer> initialSyncerCopy;
+    std::shared_ptr<InitialSyncerInterface> initialSyncerCopy;
     {
         stdx::unique_lock<Latch> lk(_mutex);
         fassert(28533, !_inShutdown);
@@ -2981,7 +2990,7 @@ Status ReplicationCoordinatorImpl::processReplSetGetStatus(
 
     BSONObj initialSyncProgress;
     if (responseStyle == ReplSetGetStatusResponseStyle::kInitialSync) {
-        std::shared_ptr<InitialSyncer> initialSyncerCopy;
+        std::shared_ptr<InitialSyncerInterface> initialSyncerCopy;
         {
             stdx::lock_guard<Latch> lk(_mutex);
             initialSyncerCopy = _initialSyncer;
@@ -3142,7 +3151,7 @@ Status ReplicationCoordinatorImpl::processReplSetSyncFrom(OperationContext* opCt
                                                           const HostAndPort& target,
                                                           BSONObjBuilder* resultObj) {
     Status result(ErrorCodes::InternalError, "didn't set status in prepareSyncFromResponse");
-    std::shared_ptr<InitialSyncer> initialSyncerCopy;
+    std::shared_ptr<InitialSyncerInterface> initialSyncerCopy;
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _topCoord->prepareSyncFromResponse(target, resultObj, &result);
@@ -4562,10 +4571,33 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
+    // Waiters are visited in opTime order, and a write concern that is not satisfied at some
+    // opTime is not satisfied at any later opTime either. Remember the write concerns found to be
+    // unsatisfied, so that each distinct write concern is only checked against the topology once
+    // per wakeup rather than once per waiter.
+    std::vector<const WriteConcernOptions*> unsatisfiedWriteConcerns;
     _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        [&](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            const auto& writeConcern = waiter->writeConcern.get();
+            const bool knownUnsatisfied = std::any_of(
+                unsatisfiedWriteConcerns.begin(),
+                unsatisfiedWriteConcerns.end(),
+                [&](const WriteConcernOptions* unsatisfied) {
+                    return unsatisfied->syncMode == writeConcern.syncMode &&
+                        unsatisfied->wMode == writeConcern.wMode &&
+                        unsatisfied->wNumNodes == writeConcern.wNumNodes &&
+                        unsatisfied->checkCondition == writeConcern.checkCondition;
+                });
+            if (knownUnsatisfied) {
+                return false;
+            }
+            if (_doneWaitingForReplication_inlock(opTime, writeConcern)) {
+                return true;
+            }
+            // The waiter stays in the list, so the pointer remains valid for this wakeup.
+            unsatisfiedWriteConcerns.push_back(&writeConcern);
+            return false;
         },
         opTime);
 }
@@ -1108,6 +1108,63 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesEachWaiterWhoseWriteConcernIsSatisfiedAmongManyWaiters) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 1);
+    OpTimeWithTermOne time2(100, 2);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    // Waiters with the same 'w' but different timeouts must be woken independently of the
+    // other write concerns waiting at earlier optimes.
+    WriteConcernOptions twoNodes;
+    twoNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    twoNodes.wNumNodes = 2;
+    WriteConcernOptions twoNodesWithTimeout = twoNodes;
+    twoNodesWithTimeout.wTimeout = 60 * 1000;
+    WriteConcernOptions threeNodes = twoNodes;
+    threeNodes.wNumNodes = 3;
+
+    ReplicationAwaiter twoNodesAtTime1(getReplCoord(), getServiceContext());
+    twoNodesAtTime1.setOpTime(time1);
+    twoNodesAtTime1.setWriteConcern(twoNodes);
+    ReplicationAwaiter threeNodesAtTime1(getReplCoord(), getServiceContext());
+    threeNodesAtTime1.setOpTime(time1);
+    threeNodesAtTime1.setWriteConcern(threeNodes);
+    ReplicationAwaiter twoNodesAtTime2(getReplCoord(), getServiceContext());
+    twoNodesAtTime2.setOpTime(time2);
+    twoNodesAtTime2.setWriteConcern(twoNodesWithTimeout);
+    twoNodesAtTime1.start();
+    threeNodesAtTime1.start();
+    twoNodesAtTime2.start();
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time1));
+    ASSERT_OK(twoNodesAtTime1.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(threeNodesAtTime1.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(twoNodesAtTime2.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
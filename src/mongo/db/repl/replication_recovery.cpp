@@ -44,6 +44,7 @@
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/transaction_oplog_application.h"
@@ -64,10 +65,15 @@ const auto kRecoveryBatchLogLevel = logv2::LogSeverity::Debug(2);
 const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
 
 /**
- * Tracks and logs operations applied during recovery.
+ * Tracks and logs operations applied during recovery. Progress towards 'endPoint' is logged every
+ * replRecoveryProgressIntervalSecs seconds so that a long replay is visible at the default log
+ * level.
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(Timestamp startPoint, Timestamp endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -101,7 +107,28 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>&) final {
+        const auto intervalSecs = replRecoveryProgressIntervalSecs.load();
+        if (!lastOpTimeApplied.isOK() || intervalSecs == 0 ||
+            _sinceLastProgress.seconds() < intervalSecs) {
+            return;
+        }
+        _sinceLastProgress.reset();
+
+        // Timestamps are a good enough proxy for how much of the oplog is left to replay.
+        const auto& appliedThrough = lastOpTimeApplied.getValue().getTimestamp();
+        const double total = _endPoint.getSecs() - _startPoint.getSecs();
+        const double done = appliedThrough.getSecs() - _startPoint.getSecs();
+        LOGV2(5155020,
+              "Oplog application for recovery in progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "appliedThrough"_attr = appliedThrough,
+              "endPoint"_attr = _endPoint,
+              "percentComplete"_attr = total > 0 ? static_cast<int>(100 * done / total) : 100,
+              "durationMillis"_attr = _sinceStart.millis());
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -110,10 +137,15 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _sinceStart.millis());
     }
 
 private:
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
+    Timer _sinceStart;
+    Timer _sinceLastProgress;
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
 };
@@ -591,9 +623,13 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
-    auto writerPool = makeReplWriterPool();
+    // Nothing else is applying the oplog or serving clients while we recover, so the writer pool
+    // may be sized independently of steady state application.
+    auto writerPool = makeReplWriterPool(replRecoveryWriterThreadCount > 0
+                                             ? replRecoveryWriterThreadCount
+                                             : replWriterThreadCount);
     OplogApplierImpl oplogApplier(nullptr,
                                   &oplogBuffer,
                                   &stats,
@@ -605,7 +641,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OplogApplier::BatchLimits batchLimits;
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
+    batchLimits.ops = std::size_t(replRecoveryBatchLimitOperations.load());
 
     OpTime applyThroughOpTime;
     std::vector<OplogEntry> batch;
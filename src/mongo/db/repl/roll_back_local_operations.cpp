@@ -33,6 +33,9 @@
 
 #include "mongo/db/repl/roll_back_local_operations.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -205,5 +208,139 @@ StatusWith<RollBackLocalOperations::RollbackCommonPoint> syncRollBackLocalOperat
                                 << ", theirTime: " << theirTime.toString() << "}");
 }
 
+StatusWith<RollBackLocalOperations::RollbackCommonPoint> syncRollBackLocalOperationsByProbing(
+    const OplogInterface& localOplog,
+    const OplogInterface& remoteOplog,
+    std::size_t windowSize,
+    const RollBackLocalOperations::RollbackOperationFn& rollbackOperation) {
+    invariant(windowSize > 0);
+
+    // Local operations older than the oldest remote operation can never be found on the remote,
+    // so they must not take part in the binary search.
+    auto remoteOldest = remoteOplog.findOpTimeAtOrAfter(Timestamp());
+    if (!remoteOldest.isOK()) {
+        return Status(ErrorCodes::InvalidSyncSource, remoteOldest.getStatus().reason())
+            .withContext("remote oplog empty or unreadable");
+    }
+    const auto remoteOldestTimestamp = remoteOldest.getValue().getTimestamp();
+
+    // Every local operation newer than the common point is absent from the remote oplog and every
+    // operation at or before it, down to the oldest remote operation, is present. That makes
+    // this predicate monotonic over the local oplog, which the binary search relies on.
+    auto isOnRemote = [&](const OplogInterface::Iterator::Value& localOplogValue) {
+        const auto localOpTime = getOpTime(localOplogValue);
+        auto remoteOpTime = remoteOplog.findOpTimeAtOrAfter(localOpTime.getTimestamp());
+        if (remoteOpTime.getStatus() == ErrorCodes::NoMatchingDocument) {
+            return StatusWith<bool>(false);
+        }
+        if (!remoteOpTime.isOK()) {
+            return StatusWith<bool>(remoteOpTime.getStatus());
+        }
+        return StatusWith<bool>(remoteOpTime.getValue() == localOpTime);
+    };
+
+    auto localIterator = localOplog.makeIterator();
+    uassert(ErrorCodes::BadValue, "invalid local oplog iterator", localIterator);
+
+    // The local operation immediately after the current window, in natural order.
+    BSONObj opAfterWindow;
+    unsigned long long scanned = 0;
+    std::vector<OplogInterface::Iterator::Value> window;
+    window.reserve(windowSize);
+    while (true) {
+        // Fill the window in reverse natural order.
+        window.clear();
+        bool reachedLocalOplogStart = false;
+        while (window.size() < windowSize) {
+            auto result = localIterator->next();
+            if (!result.isOK()) {
+                reachedLocalOplogStart = true;
+                break;
+            }
+            window.emplace_back(result.getValue().first.getOwned(), result.getValue().second);
+        }
+        if (window.empty()) {
+            if (scanned == 0) {
+                return Status(ErrorCodes::OplogStartMissing, "no oplog during rollback");
+            }
+            return Status(ErrorCodes::NoMatchingDocument,
+                          str::stream() << "reached beginning of local oplog: {"
+                                        << "scanned: " << scanned << "}");
+        }
+
+        const auto searchableEnd = std::partition_point(
+            window.begin(), window.end(), [&](const OplogInterface::Iterator::Value& value) {
+                return getTimestamp(value) >= remoteOldestTimestamp;
+            });
+        const std::size_t searchable = std::distance(window.begin(), searchableEnd);
+
+        // Find the position of the common point in the window, or 'searchable' if it is not in
+        // the window.
+        std::size_t commonPointPos = searchable;
+        if (searchable > 0) {
+            auto oldestOnRemote = isOnRemote(window[searchable - 1]);
+            if (!oldestOnRemote.isOK()) {
+                return oldestOnRemote.getStatus();
+            }
+            if (oldestOnRemote.getValue()) {
+                std::size_t low = 0;
+                std::size_t high = searchable - 1;
+                while (low < high) {
+                    const auto mid = low + (high - low) / 2;
+                    auto midOnRemote = isOnRemote(window[mid]);
+                    if (!midOnRemote.isOK()) {
+                        return midOnRemote.getStatus();
+                    }
+                    if (midOnRemote.getValue()) {
+                        high = mid;
+                    } else {
+                        low = mid + 1;
+                    }
+                }
+                commonPointPos = low;
+            }
+        }
+
+        for (std::size_t i = 0; i < commonPointPos; ++i) {
+            scanned++;
+            LOGV2_DEBUG(5152901,
+                        2,
+                        "Local oplog entry to roll back: {oplogEntry}",
+                        "Local oplog entry to roll back",
+                        "oplogEntry"_attr = redact(window[i].first));
+            auto status = rollbackOperation(window[i].first);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+
+        if (commonPointPos < searchable) {
+            LOGV2_DEBUG(5152902,
+                        1,
+                        "Found rollback common point by probing the remote oplog",
+                        "scanned"_attr = scanned);
+            const auto& commonPoint = window[commonPointPos];
+            const auto& nextOplogBSON = commonPointPos > 0
+                ? window[commonPointPos - 1].first
+                : (opAfterWindow.isEmpty() ? commonPoint.first : opAfterWindow);
+            return RollBackLocalOperations::RollbackCommonPoint(
+                commonPoint.first, commonPoint.second, nextOplogBSON);
+        }
+
+        if (searchable < window.size()) {
+            return Status(ErrorCodes::NoMatchingDocument,
+                          str::stream() << "reached beginning of remote oplog: {"
+                                        << "them: " << remoteOplog.toString() << ", theirTime: "
+                                        << remoteOldestTimestamp.toString() << "}");
+        }
+        if (reachedLocalOplogStart) {
+            return Status(ErrorCodes::NoMatchingDocument,
+                          str::stream() << "reached beginning of local oplog: {"
+                                        << "scanned: " << scanned << "}");
+        }
+        opAfterWindow = window.back().first;
+    }
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 #include "mongo/base/status.h"
@@ -132,5 +133,21 @@ StatusWith<RollBackLocalOperations::RollbackCommonPoint> syncRollBackLocalOperat
     const OplogInterface& remoteOplog,
     const RollBackLocalOperations::RollbackOperationFn& rollbackOperation);
 
+/**
+ * Same as syncRollBackLocalOperations(), but finds the common point by probing the remote oplog
+ * for individual local operations instead of iterating the remote oplog.
+ *
+ * The local oplog is read backwards in windows of 'windowSize' operations. One probe of the
+ * oldest operation in a window tells whether the common point lies in that window; if it does,
+ * it is located with a binary search of the window. This issues O(N / windowSize + log
+ * windowSize) point lookups against the sync source, where N is the number of local operations
+ * to roll back, regardless of how far the remote oplog has advanced past the common point.
+ */
+StatusWith<RollBackLocalOperations::RollbackCommonPoint> syncRollBackLocalOperationsByProbing(
+    const OplogInterface& localOplog,
+    const OplogInterface& remoteOplog,
+    std::size_t windowSize,
+    const RollBackLocalOperations::RollbackOperationFn& rollbackOperation);
+
 }  // namespace repl
 }  // namespace mongo
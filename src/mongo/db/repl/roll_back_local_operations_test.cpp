@@ -78,6 +78,9 @@ TEST(RollBackLocalOperationsTest, InvalidLocalOplogIterator) {
             const OpTime& startingOpTime, bool permitYield = false) const override {
             MONGO_UNREACHABLE;
         };
+        StatusWith<OpTime> findOpTimeAtOrAfter(const Timestamp&) const override {
+            MONGO_UNREACHABLE;
+        }
         HostAndPort hostAndPort() const override {
             return {};
         }
@@ -314,6 +317,113 @@ TEST(SyncRollBackLocalOperationsTest, DifferentTimestampEndOfRemoteOplog) {
     ASSERT_STRING_CONTAINS(result.getStatus().reason(), "reached beginning of remote oplog");
 }
 
+TEST(SyncRollBackLocalOperationsByProbingTest, RemoteOplogMissing) {
+    auto result = syncRollBackLocalOperationsByProbing(OplogInterfaceMock({makeOpAndRecordId(1)}),
+                                                       OplogInterfaceMock(),
+                                                       2U,
+                                                       [](const BSONObj&) { return Status::OK(); });
+    ASSERT_EQUALS(ErrorCodes::InvalidSyncSource, result.getStatus().code());
+}
+
+TEST(SyncRollBackLocalOperationsByProbingTest, OplogStartMissing) {
+    auto result = syncRollBackLocalOperationsByProbing(OplogInterfaceMock(),
+                                                       OplogInterfaceMock({makeOpAndRecordId(1)}),
+                                                       2U,
+                                                       [](const BSONObj&) { return Status::OK(); });
+    ASSERT_EQUALS(ErrorCodes::OplogStartMissing, result.getStatus().code());
+}
+
+TEST(SyncRollBackLocalOperationsByProbingTest, FindsCommonPointAcrossWindows) {
+    // The local oplog diverged from the remote after 'commonOperation', while the remote went on
+    // to write many more operations.
+    auto commonOperation = makeOpAndRecordId(3);
+    OplogInterfaceMock::Operations localOperations;
+    for (long long seconds = 10; seconds > 3; --seconds) {
+        localOperations.push_back(makeOpAndRecordId(seconds, 1LL));
+    }
+    auto firstOpAfterCommonPoint = localOperations.back();
+    localOperations.push_back(commonOperation);
+    localOperations.push_back(makeOpAndRecordId(2));
+    localOperations.push_back(makeOpAndRecordId(1));
+
+    OplogInterfaceMock::Operations remoteOperations;
+    for (long long seconds = 50; seconds > 3; --seconds) {
+        remoteOperations.push_back(makeOpAndRecordId(seconds, 2LL));
+    }
+    remoteOperations.push_back(commonOperation);
+    remoteOperations.push_back(makeOpAndRecordId(2));
+
+    auto i = localOperations.cbegin();
+    auto result = syncRollBackLocalOperationsByProbing(OplogInterfaceMock(localOperations),
+                                                       OplogInterfaceMock(remoteOperations),
+                                                       3U,
+                                                       [&](const BSONObj& operation) {
+                                                           ASSERT_BSONOBJ_EQ(i->first, operation);
+                                                           i++;
+                                                           return Status::OK();
+                                                       });
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQUALS(OpTime::parseFromOplogEntry(commonOperation.first),
+                  result.getValue().getOpTime());
+    ASSERT_EQUALS(commonOperation.second, result.getValue().getRecordId());
+    ASSERT_BSONOBJ_EQ(commonOperation.first, i->first);
+    ASSERT_EQUALS(result.getValue().getFirstOpWallClockTimeAfterCommonPoint(),
+                  uassertStatusOK(OplogEntry::parse(firstOpAfterCommonPoint.first))
+                      .getWallClockTime());
+}
+
+TEST(SyncRollBackLocalOperationsByProbingTest, SameTimestampDifferentTermIsRolledBack) {
+    auto commonOperation = makeOpAndRecordId(1);
+    auto localOperation = makeOpAndRecordId(2, 1LL);
+    auto remoteOperation = makeOpAndRecordId(2, 2LL);
+    bool called = false;
+    auto result = syncRollBackLocalOperationsByProbing(
+        OplogInterfaceMock({localOperation, commonOperation}),
+        OplogInterfaceMock({remoteOperation, commonOperation}),
+        10U,
+        [&](const BSONObj& operation) {
+            ASSERT_BSONOBJ_EQ(localOperation.first, operation);
+            called = true;
+            return Status::OK();
+        });
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQUALS(OpTime::parseFromOplogEntry(commonOperation.first),
+                  result.getValue().getOpTime());
+    ASSERT_TRUE(called);
+}
+
+TEST(SyncRollBackLocalOperationsByProbingTest, EndOfRemoteOplog) {
+    auto commonOperation = makeOpAndRecordId(1);
+    auto localOperation = makeOpAndRecordId(2);
+    auto remoteOperation = makeOpAndRecordId(3);
+    auto result = syncRollBackLocalOperationsByProbing(
+        OplogInterfaceMock({localOperation, commonOperation}),
+        OplogInterfaceMock({remoteOperation}),
+        10U,
+        [&](const BSONObj& operation) {
+            FAIL("Should not reach here");
+            return Status::OK();
+        });
+    ASSERT_EQUALS(ErrorCodes::NoMatchingDocument, result.getStatus().code());
+    ASSERT_STRING_CONTAINS(result.getStatus().reason(), "reached beginning of remote oplog");
+}
+
+TEST(SyncRollBackLocalOperationsByProbingTest, EndOfLocalOplog) {
+    auto localOperation = makeOpAndRecordId(3);
+    auto remoteOperation = makeOpAndRecordId(2);
+    bool called = false;
+    auto result = syncRollBackLocalOperationsByProbing(OplogInterfaceMock({localOperation}),
+                                                       OplogInterfaceMock({remoteOperation}),
+                                                       1U,
+                                                       [&](const BSONObj& operation) {
+                                                           called = true;
+                                                           return Status::OK();
+                                                       });
+    ASSERT_EQUALS(ErrorCodes::NoMatchingDocument, result.getStatus().code());
+    ASSERT_STRING_CONTAINS(result.getStatus().reason(), "reached beginning of local oplog");
+    ASSERT_TRUE(called);
+}
+
 class DBClientConnectionForTest : public DBClientConnection {
 public:
     DBClientConnectionForTest(int numInitFailures) : _initFailuresLeft(numInitFailures) {}
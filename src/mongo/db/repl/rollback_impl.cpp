@@ -50,6 +50,7 @@
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/roll_back_local_operations.h"
 #include "mongo/db/repl/storage_interface.h"
@@ -991,8 +992,11 @@ StatusWith<RollBackLocalOperations::RollbackCommonPoint> RollbackImpl::_findComm
     // each oplog entry up until the common point. We only need the Timestamp of the common point
     // for the oplog truncate after point. Along the way, we save some information about the
     // rollback ops.
-    auto commonPointSW =
-        syncRollBackLocalOperations(*_localOplog, *_remoteOplog, onLocalOplogEntryFn);
+    const auto windowSize = rollbackCommonPointSearchWindowSize.load();
+    auto commonPointSW = windowSize > 0
+        ? syncRollBackLocalOperationsByProbing(
+              *_localOplog, *_remoteOplog, windowSize, onLocalOplogEntryFn)
+        : syncRollBackLocalOperations(*_localOplog, *_remoteOplog, onLocalOplogEntryFn);
     if (!commonPointSW.isOK()) {
         return commonPointSW.getStatus();
     }
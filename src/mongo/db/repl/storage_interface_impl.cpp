@@ -57,6 +57,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/delete.h"
+#include "mongo/db/exec/oplog_tail_cache.h"
 #include "mongo/db/exec/update_stage.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/jsobj.h"
@@ -1244,6 +1245,9 @@ Timestamp StorageInterfaceImpl::recoverToStableTimestamp(OperationContext* opCtx
     auto swStableTimestamp = serviceContext->getStorageEngine()->recoverToStableTimestamp(opCtx);
     fassert(31049, swStableTimestamp);
 
+    // Oplog entries after the stable timestamp are gone.
+    OplogTailCache::get(serviceContext).clear();
+
     StorageControl::startStorageControls(serviceContext);
 
     return swStableTimestamp.getValue();
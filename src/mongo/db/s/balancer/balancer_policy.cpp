@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
@@ -58,6 +59,21 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+// When balancing by load, the fraction of the optimal number of chunks per shard by which a shard's
+// number of chunks may exceed the optimum before a rebalancing migration is initiated, and the
+// minimum value of that threshold.
+const double kLoadBalancingImbalanceTolerance = 0.2;
+const size_t kLoadBalancingMinImbalanceThreshold = 2;
+
+// A chunk is moved to even out load only if the donor's operation rate is at least this many times
+// the recipient's and exceeds it by at least this many operations per second.
+const double kLoadImbalanceRatio = 1.5;
+const double kMinLoadImbalanceOpsPerSecond = 100;
+
+// Shards with a larger fraction of their storage engine cache in use are not sent chunks to even
+// out load, as the additional working set would push them into cache eviction.
+const double kMaxLoadReceiverCacheUsedRatio = 0.9;
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -360,7 +376,8 @@ MigrateInfo chooseRandomMigration(const ShardStatisticsVector& shardStats,
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo) {
+                                            bool forceJumbo,
+                                            bool balanceByLoad) {
     vector<MigrateInfo> migrations;
 
     if (MONGO_unlikely(balancerShouldReturnRandomMigrations.shouldFail()) &&
@@ -528,15 +545,38 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
         const size_t idealNumberOfChunksPerShardForTag =
             (size_t)std::roundf(totalNumberOfChunksWithTag / (float)totalNumberOfShardsWithTag);
 
+        // When balancing by load, tolerate a larger deviation from the optimal number of chunks,
+        // which leaves room for the migrations that even out the load
+        const size_t imbalanceThreshold = balanceByLoad
+            ? std::max(kLoadBalancingMinImbalanceThreshold,
+                       (size_t)(idealNumberOfChunksPerShardForTag *
+                                kLoadBalancingImbalanceTolerance))
+            : kDefaultImbalanceThreshold;
+
+        const auto tagForceJumbo = forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                              : MoveChunkRequest::ForceJumbo::kDoNotForce;
+
         while (_singleZoneBalance(shardStats,
                                   distribution,
                                   tag,
                                   idealNumberOfChunksPerShardForTag,
+                                  imbalanceThreshold,
                                   &migrations,
                                   usedShards,
-                                  forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
-                                             : MoveChunkRequest::ForceJumbo::kDoNotForce))
+                                  tagForceJumbo))
             ;
+
+        // 4) if requested, balance the load within the tag
+        if (balanceByLoad) {
+            _singleZoneLoadBalance(shardStats,
+                                   distribution,
+                                   tag,
+                                   idealNumberOfChunksPerShardForTag,
+                                   imbalanceThreshold,
+                                   &migrations,
+                                   usedShards,
+                                   tagForceJumbo);
+        }
     }
 
     return migrations;
@@ -562,6 +602,7 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                                         const DistributionStatus& distribution,
                                         const string& tag,
                                         size_t idealNumberOfChunksPerShardForTag,
+                                        size_t imbalanceThreshold,
                                         vector<MigrateInfo>* migrations,
                                         set<ShardId>* usedShards,
                                         MoveChunkRequest::ForceJumbo forceJumbo) {
@@ -608,10 +649,10 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
         "toShardId"_attr = to,
         "toShardChunkCount"_attr = min,
         "idealNumberOfChunksPerShardForTag"_attr = idealNumberOfChunksPerShardForTag,
-        "chunkCountImbalanceThreshold"_attr = kDefaultImbalanceThreshold);
+        "chunkCountImbalanceThreshold"_attr = imbalanceThreshold);
 
     // Check whether it is necessary to balance within this zone
-    if (imbalance < kDefaultImbalanceThreshold)
+    if (imbalance < imbalanceThreshold)
         return false;
 
     const vector<ChunkType>& chunks = distribution.getChunks(from);
@@ -648,6 +689,80 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            const string& tag,
+                                            size_t idealNumberOfChunksPerShardForTag,
+                                            size_t imbalanceThreshold,
+                                            vector<MigrateInfo>* migrations,
+                                            set<ShardId>* usedShards,
+                                            MoveChunkRequest::ForceJumbo forceJumbo) {
+    const ClusterStatistics::ShardStatistics* from = nullptr;
+    const ClusterStatistics::ShardStatistics* to = nullptr;
+
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (!tag.empty() && !stat.shardTags.count(tag))
+            continue;
+
+        if (distribution.numberOfChunksInShardWithTag(stat.shardId, tag) > 0 &&
+            (!from || stat.opsPerSecond > from->opsPerSecond)) {
+            from = &stat;
+        }
+
+        if (isShardSuitableReceiver(stat, tag).isOK() &&
+            stat.cacheUsedRatio < kMaxLoadReceiverCacheUsedRatio &&
+            (!to || stat.opsPerSecond < to->opsPerSecond)) {
+            to = &stat;
+        }
+    }
+
+    if (!from || !to || from == to)
+        return false;
+
+    // Check whether the load is sufficiently uneven to be worth a migration
+    if (from->opsPerSecond < to->opsPerSecond * kLoadImbalanceRatio ||
+        from->opsPerSecond - to->opsPerSecond < kMinLoadImbalanceOpsPerSecond)
+        return false;
+
+    // Do not move a chunk if it would take either shard's chunk count further than the threshold
+    // from the optimum, so that chunk count balancing does not move chunks the other way
+    const size_t fromChunks = distribution.numberOfChunksInShardWithTag(from->shardId, tag);
+    const size_t toChunks = distribution.numberOfChunksInShardWithTag(to->shardId, tag);
+    if (toChunks + 1 >= idealNumberOfChunksPerShardForTag + imbalanceThreshold ||
+        fromChunks + imbalanceThreshold <= idealNumberOfChunksPerShardForTag)
+        return false;
+
+    LOGV2_DEBUG(5155042,
+                1,
+                "collection: {namespace}, zone: {zone}, donor: {fromShardId} ops/s "
+                "{fromShardOpsPerSecond}, receiver: {toShardId} ops/s {toShardOpsPerSecond}",
+                "Balancing load within zone",
+                "namespace"_attr = distribution.nss().ns(),
+                "zone"_attr = tag,
+                "fromShardId"_attr = from->shardId,
+                "fromShardOpsPerSecond"_attr = from->opsPerSecond,
+                "toShardId"_attr = to->shardId,
+                "toShardOpsPerSecond"_attr = to->opsPerSecond);
+
+    for (const auto& chunk : distribution.getChunks(from->shardId)) {
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        if (chunk.getJumbo())
+            continue;
+
+        migrations->emplace_back(to->shardId, chunk, forceJumbo, MigrateInfo::loadImbalance);
+        invariant(usedShards->insert(from->shardId).second);
+        invariant(usedShards->insert(to->shardId).second);
+        return true;
+    }
+
+    return false;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
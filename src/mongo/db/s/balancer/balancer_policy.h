@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, loadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -193,6 +193,10 @@ public:
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
      * moving chunks to shards, which are under this number.
      *
+     * If balanceByLoad is true, the shards' chunk counts are allowed to deviate further from the
+     * optimum and, within that tolerance, chunks are also moved from the shard with the highest
+     * operation rate to the one with the lowest rate in each zone.
+     *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
      * shard.
@@ -200,7 +204,8 @@ public:
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo);
+                                            bool forceJumbo,
+                                            bool balanceByLoad = false);
 
     /**
      * Using the specified distribution information, returns a suggested better location for the
@@ -236,7 +241,8 @@ private:
      *
      * The 'idealNumberOfChunksPerShardForTag' indicates what is the ideal number of chunks which
      * each shard must have and is used to determine the imbalance and also to prevent chunks from
-     * moving when not necessary.
+     * moving when not necessary. A shard only gives up chunks once it has at least
+     * 'imbalanceThreshold' chunks more than the ideal.
      *
      * Returns true if a migration was suggested, false otherwise. This method is intented to be
      * called multiple times until all posible migrations for a zone have been selected.
@@ -245,9 +251,29 @@ private:
                                    const DistributionStatus& distribution,
                                    const std::string& tag,
                                    size_t idealNumberOfChunksPerShardForTag,
+                                   size_t imbalanceThreshold,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the shard with the
+     * highest operation rate to the shard with the lowest one, if their rates differ sufficiently.
+     * The migration is only suggested if it leaves both shards' chunk counts within
+     * 'imbalanceThreshold' of 'idealNumberOfChunksPerShardForTag', so that chunk count balancing
+     * does not move the chunk back. Takes into account and updates the shards, which have already
+     * been used for migrations.
+     *
+     * Returns true if a migration was suggested, false otherwise.
+     */
+    static bool _singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       const std::string& tag,
+                                       size_t idealNumberOfChunksPerShardForTag,
+                                       size_t imbalanceThreshold,
+                                       std::vector<MigrateInfo>* migrations,
+                                       std::set<ShardId>* usedShards,
+                                       MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
 }  // namespace mongo
@@ -843,5 +843,80 @@ TEST(DistributionStatus, ChunkTagsSelectorWithMinMaxKeys) {
     }
 }
 
+ShardStatistics makeLoadedShard(const ShardId& shardId,
+                                double opsPerSecond,
+                                double cacheUsedRatio = 0) {
+    ShardStatistics stat(shardId, kNoMaxSize, 10, false, emptyTagSet, emptyShardVersion);
+    stat.opsPerSecond = opsPerSecond;
+    stat.cacheUsedRatio = cacheUsedRatio;
+    return stat;
+}
+
+std::vector<MigrateInfo> balanceChunksByLoad(const ShardStatisticsVector& shardStats,
+                                             const DistributionStatus& distribution) {
+    std::set<ShardId> usedShards;
+    return BalancerPolicy::balance(shardStats, distribution, &usedShards, false, true);
+}
+
+TEST(BalancerPolicy, BalanceByLoadMovesChunkFromBusiestToIdlestShard) {
+    auto cluster = generateCluster({{makeLoadedShard(kShardId0, 2000), 10},
+                                    {makeLoadedShard(kShardId1, 100), 10},
+                                    {makeLoadedShard(kShardId2, 500), 10}});
+
+    const auto migrations(
+        balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second)));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_EQ(MigrateInfo::loadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, BalanceByLoadDoesNotMoveWhenLoadIsEven) {
+    auto cluster = generateCluster(
+        {{makeLoadedShard(kShardId0, 1000), 10}, {makeLoadedShard(kShardId1, 900), 10}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadNotUsedWhenDisabled) {
+    auto cluster = generateCluster(
+        {{makeLoadedShard(kShardId0, 2000), 10}, {makeLoadedShard(kShardId1, 100), 10}});
+
+    ASSERT(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false)
+            .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadKeepsChunkCountsWithinThreshold) {
+    // The idle shard already has as many chunks above the optimum as tolerated.
+    auto cluster = generateCluster(
+        {{makeLoadedShard(kShardId0, 2000), 9}, {makeLoadedShard(kShardId1, 100), 11}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadToleratesLargerChunkCountImbalance) {
+    // Without balancing by load, the one chunk imbalance would be corrected.
+    auto cluster = generateCluster(
+        {{makeLoadedShard(kShardId0, 100), 11}, {makeLoadedShard(kShardId1, 100), 9}});
+
+    ASSERT(balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second))
+               .empty());
+}
+
+TEST(BalancerPolicy, BalanceByLoadSkipsReceiverUnderCachePressure) {
+    auto cluster = generateCluster({{makeLoadedShard(kShardId0, 2000), 10},
+                                    {makeLoadedShard(kShardId1, 100, 0.95), 10},
+                                    {makeLoadedShard(kShardId2, 500), 10}});
+
+    const auto migrations(
+        balanceChunksByLoad(cluster.first, DistributionStatus(kNamespace, cluster.second)));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -73,6 +73,8 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    builder.append("opsPerSecond", opsPerSecond);
+    builder.append("cacheUsedRatio", cacheUsedRatio);
     return builder.obj();
 }
 
@@ -93,6 +93,14 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Rate of CRUD operations (inserts, queries, updates, deletes and getMores) on this shard's
+        // primary since the previous statistics refresh. Zero if it is not known yet.
+        double opsPerSecond{0};
+
+        // Fraction of the storage engine cache in use on this shard's primary. Zero if the storage
+        // engine does not report it.
+        double cacheUsedRatio{0};
     };
 
     virtual ~ClusterStatistics();
@@ -49,16 +49,25 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpCountersField[] = "opcounters";
+const char kWiredTigerField[] = "wiredTiger";
+const char kCacheField[] = "cache";
+const char kCacheBytesInUseField[] = "bytes currently in the cache";
+const char kCacheBytesMaxField[] = "maximum bytes configured";
+
+// Operation counters reported by serverStatus, which count towards a shard's load
+const char* const kCrudOpCounterFields[] = {"insert", "query", "update", "delete", "getmore"};
+
+// Minimum time between two samples of a shard's operation counters for a new rate to be computed
+const Milliseconds kMinOpCountSampleInterval{1000};
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Returns the serverStatus response or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -79,8 +88,16 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
 
+/**
+ * Obtains the version of the running MongoD service from its serverStatus response.
+ *
+ * Returns the MongoD version in strig format or an error. Known error codes are:
+ *  NoSuchKey if the version could not be retrieved
+ */
+StatusWith<std::string> extractMongoDVersion(const BSONObj& serverStatus) {
     std::string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -90,6 +107,41 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     return version;
 }
 
+/**
+ * Returns the cumulative number of CRUD operations reported in a serverStatus response.
+ */
+long long extractCrudOpCount(const BSONObj& serverStatus) {
+    const auto opCounters = serverStatus[kOpCountersField];
+    if (opCounters.type() != Object) {
+        return 0;
+    }
+
+    long long opCount = 0;
+    for (const auto fieldName : kCrudOpCounterFields) {
+        opCount += opCounters.Obj()[fieldName].safeNumberLong();
+    }
+
+    return opCount;
+}
+
+/**
+ * Returns the fraction of the WiredTiger cache in use reported in a serverStatus response, or zero
+ * if it does not report it.
+ */
+double extractCacheUsedRatio(const BSONObj& serverStatus) {
+    const auto cache = serverStatus[kWiredTigerField][kCacheField];
+    if (cache.type() != Object) {
+        return 0;
+    }
+
+    const double bytesMax = cache.Obj()[kCacheBytesMaxField].numberDouble();
+    if (bytesMax <= 0) {
+        return 0;
+    }
+
+    return cache.Obj()[kCacheBytesInUseField].numberDouble() / bytesMax;
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -135,7 +187,10 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
 
         std::string mongoDVersion;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
+        auto serverStatusStatus = retrieveShardServerStatus(opCtx, shard.getName());
+        auto mongoDVersionStatus = serverStatusStatus.isOK()
+            ? extractMongoDVersion(serverStatusStatus.getValue())
+            : StatusWith<std::string>(serverStatusStatus.getStatus());
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
@@ -160,9 +215,50 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+
+        // Like the version, the load is only an input for balancing by load, so a shard which
+        // cannot report it is treated as idle rather than failing the round
+        if (serverStatusStatus.isOK()) {
+            const auto& serverStatus = serverStatusStatus.getValue();
+            stats.back().opsPerSecond =
+                _updateOpsPerSecond(shard.getName(), extractCrudOpCount(serverStatus));
+            stats.back().cacheUsedRatio = extractCacheUsedRatio(serverStatus);
+        }
     }
 
     return stats;
 }
 
+double ClusterStatisticsImpl::_updateOpsPerSecond(const ShardId& shardId, long long opCount) {
+    const auto now = Date_t::now();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _opCountSamples.find(shardId);
+    if (it == _opCountSamples.end()) {
+        _opCountSamples.emplace(shardId, OpCountSample{opCount, now, 0});
+        return 0;
+    }
+
+    auto& sample = it->second;
+
+    // The counters start over from zero whenever the shard's primary restarts
+    if (opCount < sample.opCount) {
+        sample = OpCountSample{opCount, now, 0};
+        return 0;
+    }
+
+    // Refreshes in quick succession would produce noisy rates, so keep reporting the previous rate
+    // until enough time has passed
+    const auto elapsed = now - sample.sampledAt;
+    if (elapsed < kMinOpCountSampleInterval) {
+        return sample.opsPerSecond;
+    }
+
+    sample.opsPerSecond =
+        (opCount - sample.opCount) * 1000.0 / durationCount<Milliseconds>(elapsed);
+    sample.opCount = opCount;
+    sample.sampledAt = now;
+    return sample.opsPerSecond;
+}
+
 }  // namespace mongo
@@ -29,15 +29,20 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 /**
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
- * fetch the statistics and does not perform any caching. If any of the shards fails to report
- * statistics fails the entire refresh.
+ * fetch the statistics and does not perform any caching, except for the operation counters needed
+ * to turn them into rates. If any of the shards fails to report statistics fails the entire
+ * refresh.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -47,8 +52,30 @@ public:
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
 private:
+    /**
+     * The cumulative number of CRUD operations last reported by a shard and the rate derived from
+     * it.
+     */
+    struct OpCountSample {
+        long long opCount{0};
+        Date_t sampledAt;
+        double opsPerSecond{0};
+    };
+
+    /**
+     * Records the cumulative operation count reported by the specified shard and returns its
+     * operation rate since the previous sample.
+     */
+    double _updateOpsPerSecond(const ShardId& shardId, long long opCount);
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects _opCountSamples.
+    Mutex _mutex = MONGO_MAKE_LATCH("ClusterStatisticsImpl::_mutex");
+
+    // The latest operation count sample of each shard.
+    std::map<ShardId, OpCountSample> _opCountSamples;
 };
 
 }  // namespace mongo
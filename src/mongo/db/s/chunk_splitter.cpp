@@ -33,6 +33,9 @@
 
 #include "mongo/db/s/chunk_splitter.h"
 
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/dbclient_cursor.h"
 #include "mongo/client/query.h"
 #include "mongo/db/client.h"
@@ -49,6 +52,7 @@
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/chunk_manager.h"
+#include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/config_server_client.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -193,6 +197,54 @@ BSONObj findExtremeKeyForShard(OperationContext* opCtx,
     return shardKeyPattern.extractShardKeyFromDoc(end);
 }
 
+/**
+ * The minimum number of sampled shard keys inside a chunk needed to pick its split point from them.
+ */
+const size_t kMinSampledKeysForSplit = 16;
+
+/**
+ * Returns whether the chunk tracked by 'writesTracker' receives writes fast enough to be split at
+ * its sampled shard keys, which is the case once it has received at least a chunk's worth of writes
+ * at an average rate of at least a chunk's worth per hour.
+ */
+bool isWriteHotChunk(ChunkWritesTracker* writesTracker, uint64_t maxChunkSizeBytes) {
+    const uint64_t totalBytesWritten = writesTracker->getTotalBytesWritten();
+    if (totalBytesWritten < maxChunkSizeBytes) {
+        return false;
+    }
+
+    const auto secondsTracked = std::max<long long>(
+        durationCount<Seconds>(Date_t::now() - writesTracker->getTrackingStartTime()), 1);
+    return totalBytesWritten / secondsTracked >=
+        maxChunkSizeBytes / durationCount<Seconds>(Hours(1));
+}
+
+/**
+ * Returns the median of the shard keys sampled from the writes to the chunk [min, max), so that
+ * the writes are split evenly between the two resulting chunks. Returns an empty document if too
+ * few of the sampled keys fall strictly inside the chunk.
+ */
+BSONObj findSplitPointFromSampledKeys(const BSONObj& min,
+                                      const BSONObj& max,
+                                      std::vector<BSONObj> sampledKeys) {
+    sampledKeys.erase(std::remove_if(sampledKeys.begin(),
+                                     sampledKeys.end(),
+                                     [&](const BSONObj& key) {
+                                         return key.woCompare(min) <= 0 || key.woCompare(max) >= 0;
+                                     }),
+                      sampledKeys.end());
+    if (sampledKeys.size() < kMinSampledKeysForSplit) {
+        return BSONObj();
+    }
+
+    auto median = sampledKeys.begin() + sampledKeys.size() / 2;
+    std::nth_element(sampledKeys.begin(),
+                     median,
+                     sampledKeys.end(),
+                     SimpleBSONObjComparator::kInstance.makeLessThan());
+    return *median;
+}
+
 /**
  * Checks if autobalance is enabled on the current sharded collection.
  */
@@ -326,15 +378,39 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                     "maxChunkSizeBytes"_attr = maxChunkSizeBytes);
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = splitVector(opCtx.get(),
-                                       nss,
-                                       shardKeyPattern.toBSON(),
-                                       chunk.getMin(),
-                                       chunk.getMax(),
-                                       false,
-                                       boost::none,
-                                       boost::none,
-                                       maxChunkSizeBytes);
+
+        // A chunk receiving writes at a high rate is split at the median of the shard keys sampled
+        // from those writes, which spreads the write load over both halves and does not need to
+        // scan the shard key index. Other chunks are split based on their size on disk.
+        std::vector<BSONObj> splitPoints;
+        const auto writesTracker = chunk.getWritesTracker();
+        if (chunk.getMin().woCompare(min) == 0 && chunk.getMax().woCompare(max) == 0 &&
+            isWriteHotChunk(writesTracker.get(), maxChunkSizeBytes)) {
+            auto splitPoint =
+                findSplitPointFromSampledKeys(min, max, writesTracker->getSampledKeys());
+            if (!splitPoint.isEmpty()) {
+                LOGV2_DEBUG(5155041,
+                            1,
+                            "Splitting write-hot chunk {chunk} at sampled split point "
+                            "{splitPoint}",
+                            "Splitting write-hot chunk at sampled split point",
+                            "chunk"_attr = redact(chunk.toString()),
+                            "splitPoint"_attr = redact(splitPoint));
+                splitPoints.push_back(std::move(splitPoint));
+            }
+        }
+
+        if (splitPoints.empty()) {
+            splitPoints = splitVector(opCtx.get(),
+                                      nss,
+                                      shardKeyPattern.toBSON(),
+                                      chunk.getMin(),
+                                      chunk.getMax(),
+                                      false,
+                                      boost::none,
+                                      boost::none,
+                                      maxChunkSizeBytes);
+        }
 
         if (splitPoints.empty()) {
             LOGV2_DEBUG(21907,
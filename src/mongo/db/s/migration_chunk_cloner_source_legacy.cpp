@@ -661,6 +661,11 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
+    // Fetch the whole batch through a single record store cursor rather than looking up every
+    // document separately. The record ids are visited in ascending order, so consecutive seeks
+    // mostly land on the same or adjacent storage pages.
+    auto cursor = collection->getCursor(opCtx);
+
     stdx::unique_lock<Latch> lk(_mutex);
     auto iter = _cloneLocs.begin();
 
@@ -675,17 +680,18 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
 
         lk.unlock();
 
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
+        if (auto record = cursor->seekExact(nextRecordId)) {
+            const auto doc = record->data.toBson();
+
             // Use the builder size instead of accumulating the document sizes directly so
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
+                (arrBuilder->len() + doc.objsize() + 1024) > BSONObjMaxUserSize) {
 
                 break;
             }
 
-            arrBuilder->append(doc.value());
+            arrBuilder->append(doc);
             ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
         }
 
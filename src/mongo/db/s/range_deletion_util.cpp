@@ -38,6 +38,7 @@
 
 #include <boost/optional.hpp>
 
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
@@ -117,6 +118,11 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
  * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
  * be called under the collection lock.
  *
+ * If 'resumeKey' holds the shard key of a document deleted by a previous batch, the index scan
+ * starts from that key rather than from the beginning of the range, so that it does not have to
+ * step again over the index entries of all the documents which were already deleted. It is
+ * updated with the shard key of the last document deleted by this batch.
+ *
  * Returns the number of documents deleted, 0 if done with the range, or bad status if deleting
  * the range failed.
  */
@@ -124,7 +130,8 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                 Collection* collection,
                                 BSONObj const& keyPattern,
                                 ChunkRange const& range,
-                                int numDocsToRemovePerBatch) {
+                                int numDocsToRemovePerBatch,
+                                boost::optional<BSONObj>* resumeKey) {
     invariant(collection != nullptr);
 
     auto const& nss = collection->ns();
@@ -148,7 +155,11 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         return Helpers::toKeyFormat(indexKeyPattern.extendRangeBound(key, false));
     };
 
-    const auto min = extend(range.getMin());
+    // The index keys of a hashed shard key cannot be derived from the deleted documents without
+    // hashing them, so those ranges are always scanned from their lower bound.
+    const bool canResume = !KeyPattern::isHashedKeyPattern(keyPattern);
+
+    const auto min = extend(canResume && *resumeKey ? **resumeKey : range.getMin());
     const auto max = extend(range.getMax());
 
     LOGV2_DEBUG(23766,
@@ -197,6 +208,7 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
     }
 
     int numDeleted = 0;
+    BSONObj lastDeletedObj;
     do {
         BSONObj deletedObj;
 
@@ -230,9 +242,18 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 
         invariant(PlanExecutor::ADVANCED == state);
         ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        lastDeletedObj = std::move(deletedObj);
 
     } while (++numDeleted < numDocsToRemovePerBatch);
 
+    // Every document of the range which sorts before the last one deleted is gone, so the next
+    // batch can start from its shard key. The start bound is inclusive, which covers any remaining
+    // documents with the same shard key.
+    if (canResume && !lastDeletedObj.isEmpty()) {
+        *resumeKey = dotted_path_support::extractElementsBasedOnTemplate(
+            lastDeletedObj, keyPattern, true /* useNullIfMissing */);
+    }
+
     return numDeleted;
 }
 
@@ -297,6 +318,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto resumeKey = std::make_shared<boost::optional<BSONObj>>();
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    if (migrationId) {
@@ -313,8 +336,12 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                            "deletion task. No need to delete documents.",
                            !collectionUuidHasChanged(nss, collection, collectionUuid));
 
-                   auto numDeleted = uassertStatusOK(deleteNextBatch(
-                       opCtx, collection, keyPattern, range, numDocsToRemovePerBatch));
+                   auto numDeleted = uassertStatusOK(deleteNextBatch(opCtx,
+                                                                     collection,
+                                                                     keyPattern,
+                                                                     range,
+                                                                     numDocsToRemovePerBatch,
+                                                                     resumeKey.get()));
 
                    LOGV2_DEBUG(
                        23769,
@@ -186,6 +186,36 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest,
+       RemoveDocumentsInRangeLeavesDocumentsOutsideRangeWhenSeveralBatchesAreRequired) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToRemovePerBatch = 3;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    // Insert documents in range as well as on both sides of it.
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = -5; i < 15; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 10);
+    ASSERT_EQUALS(dbclient.count(kNss, BSON(kShardKey << BSON("$gte" << 0 << "$lt" << 10))), 0);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
@@ -182,14 +182,14 @@ void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
     const auto& shardKeyPattern = chunkManager.getShardKeyPattern();
     BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(document);
 
-    // Use the shard key to locate the chunk into which the document was updated, and increment the
-    // number of bytes tracked for the chunk.
+    // Use the shard key to locate the chunk into which the document was updated, and record the
+    // write in the chunk's tracker, which also samples the shard key to later choose split points.
     //
     // Note that we can assume the simple collation, because shard keys do not support non-simple
     // collations.
     auto chunk = chunkManager.findIntersectingChunkWithSimpleCollation(shardKey);
     auto chunkWritesTracker = chunk.getWritesTracker();
-    chunkWritesTracker->addBytesWritten(dataWritten);
+    chunkWritesTracker->addWrite(shardKey, dataWritten);
     // Don't trigger chunk splits from inserts happening due to migration since
     // we don't necessarily own that chunk yet
     if (!fromMigrate) {
@@ -197,6 +197,8 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
                     {
                         stdx::lock_guard<Latch> lg(_mutex);
                         _decision = consensus.decision();
+                        _decisionIsFinal = _decision->getDecision() == CommitDecision::kAbort &&
+                            consensus.participantAborted();
                     }
 
                     if (_decision->getDecision() == CommitDecision::kCommit) {
@@ -253,6 +255,14 @@ TransactionCoordinator::TransactionCoordinator(OperationContext* operationContex
                     MONGO_UNREACHABLE;
             };
 
+            // If this node fails over before the decision is majority committed, the coordinator
+            // recovered from the participant list sends prepare again and reaches the same
+            // decision, so the participants may already be told to abort.
+            if (_decisionIsFinal) {
+                return ExecutorFuture<void>(
+                    Grid::get(_serviceContext)->getExecutorPool()->getFixedExecutor());
+            }
+
             return waitForMajorityWithHangFailpoint(_serviceContext,
                                                     hangBeforeWaitingForDecisionWriteConcern,
                                                     "hangBeforeWaitingForDecisionWriteConcern",
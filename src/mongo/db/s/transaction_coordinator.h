@@ -187,6 +187,10 @@ private:
     // hasn't yet persisted it
     boost::optional<txn::CoordinatorCommitDecision> _decision;
 
+    // Set when `_decision` is to abort because a participant has aborted the transaction, in which
+    // case no coordinator can decide otherwise and the decision needs no durability to be sent
+    bool _decisionIsFinal{false};
+
     // Set when the coordinator has durably persisted `_decision` to the `config.coordinators`
     // collection
     bool _decisionDurable{false};
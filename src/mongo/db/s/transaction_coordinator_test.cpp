@@ -875,6 +875,34 @@ TEST_F(TransactionCoordinatorTest, RunCommitProducesAbortDecisionOnCommitAndAbor
         coordinator.onCompletion().get(), AssertionException, ErrorCodes::NoSuchTransaction);
 }
 
+TEST_F(TransactionCoordinatorTest,
+       RunCommitSendsAbortVotedByParticipantWithoutWaitingForDecisionWriteConcern) {
+    TransactionCoordinator coordinator(
+        operationContext(),
+        _lsid,
+        _txnNumber,
+        std::make_unique<txn::AsyncWorkScheduler>(getServiceContext()),
+        Date_t::max());
+
+    // The coordinator would not get past this failpoint until it is turned off.
+    FailPointEnableBlock fp("hangBeforeWaitingForDecisionWriteConcern",
+                            BSON("useUninterruptibleSleep" << 1));
+
+    coordinator.runCommit(operationContext(), kTwoShardIdList);
+    auto commitDecisionFuture = coordinator.getDecision();
+
+    onCommands({[&](const executor::RemoteCommandRequest& request) { return kPrepareOk; },
+                [&](const executor::RemoteCommandRequest& request) { return kNoSuchTransaction; }});
+
+    assertAbortSentAndRespondWithSuccess();
+    assertAbortSentAndRespondWithSuccess();
+
+    ASSERT_THROWS_CODE(
+        commitDecisionFuture.get(), AssertionException, ErrorCodes::NoSuchTransaction);
+    ASSERT_THROWS_CODE(
+        coordinator.onCompletion().get(), AssertionException, ErrorCodes::NoSuchTransaction);
+}
+
 TEST_F(TransactionCoordinatorTest, RunCommitProducesAbortDecisionOnSingleAbortResponseOnly) {
     TransactionCoordinator coordinator(
         operationContext(),
@@ -210,6 +210,11 @@ void PrepareVoteConsensus::registerVote(const PrepareResponse& vote) {
 
         if (!_abortStatus)
             _abortStatus.emplace(*vote.abortReason);
+
+        // ShardNotFound is also counted as a vote to abort, but the shard may yet be found.
+        if (vote.vote == PrepareVote::kAbort &&
+            ErrorCodes::isVoteAbortError(vote.abortReason->code()))
+            _participantAborted = true;
     }
 }
 
@@ -72,12 +72,23 @@ public:
      */
     CoordinatorCommitDecision decision() const;
 
+    /**
+     * Returns true if a participant voted to abort because it no longer has the transaction, as
+     * opposed to having been cancelled or not found. Such a participant also votes to abort when a
+     * coordinator recovering from failover sends it prepare again, so an abort decision reached
+     * with its vote cannot change.
+     */
+    bool participantAborted() const {
+        return _participantAborted;
+    }
+
 private:
     int _numShards;
 
     int _numCommitVotes{0};
     int _numAbortVotes{0};
     int _numNoVotes{0};
+    bool _participantAborted{false};
 
     Timestamp _maxPrepareTimestamp;
 
@@ -58,6 +58,7 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/logical_time_validator.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/query/find.h"
@@ -96,6 +97,7 @@
 #include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 #include <fmt/format.h>
 
@@ -904,8 +906,10 @@ void execCommandDatabase(OperationContext* opCtx,
     BSONObjBuilder extraFieldsBuilder;
     auto startOperationTime = getClientOperationTime(opCtx);
 
+    const auto parseStartMicros = curTimeMicros64();
     std::shared_ptr<CommandInvocation> invocation = command->parse(opCtx, request);
     CommandInvocation::set(opCtx, invocation);
+    const auto parseEndMicros = curTimeMicros64();
 
     OperationSessionInfoFromClient sessionOptions;
 
@@ -929,6 +933,7 @@ void execCommandDatabase(OperationContext* opCtx,
 
         rpc::readRequestMetadata(opCtx, request.body, command->requiresAuth());
         rpc::TrackingMetadata::get(opCtx).initWithOperName(command->getName());
+        OperationTrace::addSpan(opCtx, "parse"_sd, parseStartMicros, parseEndMicros);
 
         auto const replCoord = repl::ReplicationCoordinator::get(opCtx);
         sessionOptions = initializeOperationSessionInfo(
@@ -980,6 +985,14 @@ void execCommandDatabase(OperationContext* opCtx,
                 helpField = element;
             } else if (fieldName == "comment") {
                 opCtx->setComment(element.wrap());
+            } else if (fieldName == "admissionPriority") {
+                const auto priority = element.str();
+                uassert(ErrorCodes::BadValue,
+                        str::stream() << "admissionPriority must be 'low' or 'normal', not: "
+                                      << element,
+                        priority == "low" || priority == "normal");
+                opCtx->lockState()->setAdmissionPriority(
+                    priority == "low" ? AdmissionPriority::kLow : AdmissionPriority::kNormal);
             } else if (fieldName == QueryRequest::queryOptionMaxTimeMS) {
                 uasserted(ErrorCodes::InvalidOptions,
                           "no such command option $maxTimeMs; use maxTimeMS instead");
@@ -1748,6 +1761,15 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
     const bool shouldSample = currentOp.completeAndLogOperation(
         opCtx, MONGO_LOGV2_DEFAULT_COMPONENT, dbresponse.response.size(), slowMsOverride, forceLog);
 
+    if (OperationTrace::get(opCtx)) {
+        const auto command = currentOp.getCommand();
+        OperationTrace::finish(
+            opCtx,
+            command ? StringData(command->getName()) : StringData(networkOpToString(op)),
+            BSON("ns" << currentOp.getNS() << "responseLength"
+                      << static_cast<int>(dbresponse.response.size())));
+    }
+
     Top::get(opCtx->getServiceContext())
         .incrementGlobalLatencyStats(
             opCtx,
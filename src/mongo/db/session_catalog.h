@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -42,6 +43,7 @@
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -91,13 +93,12 @@ public:
     SessionToKill checkOutSessionForKill(OperationContext* opCtx, KillToken killToken);
 
     /**
-     * Iterates through the SessionCatalog under the SessionCatalog mutex and applies 'workerFn' to
-     * each Session which matches the specified 'matcher'.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session which matches the
+     * specified 'matcher'. The catalog is visited one partition at a time, under that partition's
+     * mutex, so sessions in the other partitions can be checked out while the scan is running.
      *
-     * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
+     * NOTE: Since this method runs with a session catalog mutex, the work done by 'workerFn' is
      * not allowed to block, perform I/O or acquire any lock manager locks.
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
      */
     using ScanSessionsCallbackFn = std::function<void(ObservableSession&)>;
     void scanSession(const LogicalSessionId& lsid, const ScanSessionsCallbackFn& workerFn);
@@ -129,23 +130,45 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the session's partition to
+        // protect the state transitions.
         stdx::condition_variable availableCondVar;
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    /**
+     * A subset of the sessions, selected by the hash of their ids. Every retryable write and
+     * transaction statement checks a session out and back in, so only the partition of that
+     * session is locked while doing it.
+     */
+    struct Partition {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::Partition::mutex");
+
+        // Owns the Session objects for the sessions of this partition.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    static constexpr size_t kNumPartitions = 16;
+
     /**
      * Blocking method, which checks-out the session set on 'opCtx'.
      */
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The returned
-     * pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Returns the partition which owns the session with id 'lsid'.
+     */
+    Partition& _getPartition(const LogicalSessionId& lsid);
+
+    /**
+     * Creates or returns the session runtime info for 'lsid' from the sessions map of its
+     * partition. The returned pointer is guaranteed to be linked on the map for as long as the
+     * partition mutex is held.
      */
     SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock,
-                                                       OperationContext* opCtx,
+                                                       Partition& partition,
                                                        const LogicalSessionId& lsid);
 
     /**
@@ -153,12 +176,9 @@ private:
      */
     void _releaseSession(SessionRuntimeInfo* sri, boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    // Owns the Session objects for all current Sessions. No two partition mutexes are ever held
+    // at the same time.
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
 };
 
 /**
@@ -242,8 +262,8 @@ using SessionToKill = SessionCatalog::SessionToKill;
 /**
  * This type represents access to a session inside of a scanSessions loop.
  * If you have one of these, you're in a scanSessions callback context, and so
- * have locked the whole catalog and, if the observed session is bound to an operation context,
- * you hold that operation context's client's mutex, as well.
+ * have locked the catalog partition of the session and, if the observed session is bound to an
+ * operation context, you hold that operation context's client's mutex, as well.
  */
 class ObservableSession {
 public:
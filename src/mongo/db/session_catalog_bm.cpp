@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/session_catalog.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 64;
+
+class SessionCatalogBenchmark : public benchmark::Fixture {
+public:
+    /**
+     * Makes one Client per thread with an OperationContext bound to a session of its own, as a
+     * client issuing retryable writes would have.
+     */
+    void makeClientsWithSessions(int k) {
+        clients.reserve(k);
+        for (int i = 0; i < k; ++i) {
+            auto client = getGlobalServiceContext()->makeClient(str::stream()
+                                                                << "test client for thread " << i);
+            auto opCtx = client->makeOperationContext();
+            opCtx->setLogicalSessionId(makeLogicalSessionIdForTest());
+            clients.emplace_back(std::move(client), std::move(opCtx));
+        }
+    }
+
+protected:
+    std::vector<std::pair<ServiceContext::UniqueClient, ServiceContext::UniqueOperationContext>>
+        clients;
+};
+
+BENCHMARK_DEFINE_F(SessionCatalogBenchmark, BM_CheckOutSession)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        makeClientsWithSessions(state.threads);
+    }
+
+    for (auto keepRunning : state) {
+        OperationContextSession ocs(clients[state.thread_index].second.get());
+    }
+
+    if (state.thread_index == 0) {
+        SessionCatalog::get(getGlobalServiceContext())->reset_forTest();
+        clients.clear();
+    }
+}
+
+BENCHMARK_REGISTER_F(SessionCatalogBenchmark, BM_CheckOutSession)->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
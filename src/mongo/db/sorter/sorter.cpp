@@ -49,6 +49,7 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <deque>
 #include <snappy.h>
 #include <vector>
 
@@ -59,8 +60,11 @@
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -184,7 +188,16 @@ public:
                 boost::filesystem::file_size(_fileName) != 0);
     }
 
+    void setReadAheadBytes(size_t bytes) {
+        _readAheadBytes = bytes;
+    }
+
     void openSource() {
+        if (_readAheadBytes) {
+            // The stream only uses a buffer set before the file is opened.
+            _readAheadBuffer.reset(new char[_readAheadBytes]);
+            _file.rdbuf()->pubsetbuf(_readAheadBuffer.get(), _readAheadBytes);
+        }
         _file.open(_fileName.c_str(), std::ios::in | std::ios::binary);
         uassert(16814,
                 str::stream() << "error opening file \"" << _fileName
@@ -354,6 +367,13 @@ private:
     std::string _fileName;            // File containing the sorted data range.
     std::streampos _fileStartOffset;  // File offset at which the sorted data range starts.
     std::streampos _fileEndOffset;    // File offset at which the sorted data range ends.
+
+    // If set, the file is read through a buffer of this size instead of the stream's default, so
+    // that each read from disk covers several blocks.
+    size_t _readAheadBytes = 0;
+    std::unique_ptr<char[]> _readAheadBuffer;
+
+    // Declared after its buffer, which it may use until it is destroyed.
     std::ifstream _file;
 
     // Checksum value that is updated with each read of a data object from disk. We can compare
@@ -367,6 +387,11 @@ private:
     const uint32_t _originalChecksum;
 };
 
+// Bounds on the read-ahead of each range merged by a MergeIterator. All of the ranges together
+// read ahead a quarter of the sorter's memory limit, so merging fewer ranges means larger reads.
+const size_t kMinMergeReadAheadBytes = 32 * 1024;
+const size_t kMaxMergeReadAheadBytes = 4 * 1024 * 1024;
+
 /**
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
@@ -387,7 +412,14 @@ public:
           _first(true),
           _greater(comp),
           _itersSourceFileName(itersSourceFileName) {
+        // Reading every range in small pieces makes merging many ranges bound by the number of
+        // reads the disk can serve rather than by its throughput.
+        const size_t readAheadBytes =
+            std::clamp(opts.maxMemoryUsageBytes / 4 / std::max(iters.size(), size_t(1)),
+                       kMinMergeReadAheadBytes,
+                       kMaxMergeReadAheadBytes);
         for (size_t i = 0; i < iters.size(); i++) {
+            iters[i]->setReadAheadBytes(readAheadBytes);
             iters[i]->openSource();
             if (iters[i]->more()) {
                 _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
@@ -516,6 +548,116 @@ private:
     std::string _itersSourceFileName;
 };
 
+/**
+ * Returns the output of another iterator, which runs on a separate thread a few batches ahead of
+ * this one. This lets the work of producing sorted data, such as reading, decompressing and merging
+ * spilled ranges, overlap with the work of the consumer, such as bulk loading an index.
+ */
+template <typename Key, typename Value>
+class PrefetchIterator : public SortIteratorInterface<Key, Value> {
+public:
+    typedef SortIteratorInterface<Key, Value> Input;
+    typedef std::pair<Key, Value> Data;
+
+    explicit PrefetchIterator(std::unique_ptr<Input> source)
+        : _source(std::move(source)), _thread([this] { _produce(); }) {}
+
+    ~PrefetchIterator() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _stopped = true;
+        }
+        _cond.notify_all();
+        _thread.join();
+    }
+
+    void openSource() {}
+    void closeSource() {}
+
+    bool more() {
+        if (_position < _batch.size()) {
+            return true;
+        }
+
+        _batch.clear();
+        _position = 0;
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cond.wait(lk, [&] { return !_ready.empty() || _finished; });
+        if (_ready.empty()) {
+            uassertStatusOK(_status);
+            return false;
+        }
+        _batch = std::move(_ready.front());
+        _ready.pop_front();
+        _cond.notify_all();
+        return true;
+    }
+
+    Data next() {
+        verify(more());
+        return std::move(_batch[_position++]);
+    }
+
+private:
+    // Bounds the data buffered ahead of the consumer to kMaxReadyBatches batches of roughly
+    // kBatchBytes each.
+    static constexpr size_t kBatchBytes = 1024 * 1024;
+    static constexpr size_t kMaxReadyBatches = 4;
+
+    void _produce() {
+        try {
+            while (true) {
+                std::vector<Data> batch;
+                size_t batchBytes = 0;
+                while (batchBytes < kBatchBytes && _source->more()) {
+                    Data data = _source->next();
+                    batchBytes += data.first.memUsageForSorter() + data.second.memUsageForSorter();
+                    batch.emplace_back(data.first.getOwned(), data.second.getOwned());
+                }
+
+                stdx::unique_lock<Latch> lk(_mutex);
+                if (batch.empty()) {
+                    _finished = true;
+                    _cond.notify_all();
+                    return;
+                }
+                _cond.wait(lk, [&] { return _ready.size() < kMaxReadyBatches || _stopped; });
+                if (_stopped) {
+                    return;
+                }
+                _ready.push_back(std::move(batch));
+                _cond.notify_all();
+            }
+        } catch (...) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _status = exceptionToStatus();
+            _finished = true;
+            _cond.notify_all();
+        }
+    }
+
+    // Only used by the producer thread, until it finishes.
+    const std::unique_ptr<Input> _source;
+
+    // Only used by the consumer.
+    std::vector<Data> _batch;
+    size_t _position = 0;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("PrefetchIterator::_mutex");
+    stdx::condition_variable _cond;
+
+    // The batches produced and not yet consumed, plus the producer's final state. Guarded by
+    // '_mutex'.
+    std::deque<std::vector<Data>> _ready;
+    bool _finished = false;
+    bool _stopped = false;
+    Status _status = Status::OK();
+
+    // Must be the last member, since the producer thread uses the others.
+    stdx::thread _thread;
+};
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -537,6 +679,7 @@ public:
     }
 
     ~NoLimitSorter() {
+        _releaseSharedMemory();
         if (!_done && !this->_shouldKeepFilesOnDestruction) {
             // If done() was never called to return a MergeIterator, then this Sorter still owns
             // file deletion.
@@ -549,10 +692,15 @@ public:
 
         _data.emplace_back(key.getOwned(), val.getOwned());
 
-        _memUsed += key.memUsageForSorter();
-        _memUsed += val.memUsageForSorter();
+        const size_t memUsage = key.memUsageForSorter() + val.memUsageForSorter();
+        _memUsed += memUsage;
+        if (_opts.sharedMemoryBudget) {
+            _opts.sharedMemoryBudget->add(memUsage);
+            _sharedMemUsed += memUsage;
+        }
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _opts.maxMemoryUsageBytes ||
+            (_opts.sharedMemoryBudget && _opts.sharedMemoryBudget->shouldSpill(_memUsed)))
             spill();
     }
 
@@ -561,12 +709,18 @@ public:
 
         if (this->_iters.empty()) {
             sort();
+            // The data now belongs to the iterator, which is only used once all of the sorters
+            // sharing the budget are done.
+            _releaseSharedMemory();
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
         Iterator* mergeIt = Iterator::merge(this->_iters, this->_fileName, _opts, _comp);
         _done = true;
+        if (_opts.prefetchMergedOutput) {
+            return new PrefetchIterator<Key, Value>(std::unique_ptr<Iterator>(mergeIt));
+        }
         return mergeIt;
     }
 
@@ -621,15 +775,25 @@ private:
 
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
 
+        _releaseSharedMemory();
         _memUsed = 0;
     }
 
+    void _releaseSharedMemory() {
+        if (_opts.sharedMemoryBudget) {
+            _opts.sharedMemoryBudget->subtract(_sharedMemUsed);
+        }
+        _sharedMemUsed = 0;
+    }
+
     const Comparator _comp;
     const Settings _settings;
     SortOptions _opts;
     std::streampos _nextSortedFileWriterOffset = 0;
     bool _done = false;
     size_t _memUsed;
+    // The part of '_memUsed' which is accounted for in the shared memory budget, if any.
+    size_t _sharedMemUsed = 0;
     std::deque<Data> _data;  // Data that has not been spilled.
 };
 
@@ -959,6 +1123,11 @@ void Sorter<Key, Value>::persistDataForShutdown() {
     _shouldKeepFilesOnDestruction = true;
 }
 
+template <typename Key, typename Value>
+void Sorter<Key, Value>::persistDataForCheckpoint() {
+    spill();
+}
+
 //
 // SortedFileWriter
 //
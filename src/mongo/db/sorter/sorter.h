@@ -31,6 +31,7 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#include <algorithm>
 #include <deque>
 #include <fstream>
 #include <memory>
@@ -39,6 +40,7 @@
 #include <vector>
 
 #include "mongo/bson/util/builder.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/bufreader.h"
 
 /**
@@ -89,6 +91,55 @@
 
 namespace mongo {
 
+/**
+ * A memory budget shared by sorters which are filled at the same time, such as the sorters of the
+ * indexes built together by one index build. A sorter using the budget only has to spill once all
+ * of the sorters together exceed the budget and it holds more than its fair share, so that sorters
+ * which receive little data leave their memory to the others.
+ */
+class SorterMemoryBudget {
+public:
+    SorterMemoryBudget(size_t maxMemoryUsageBytes, size_t numSorters)
+        : _maxMemoryUsageBytes(maxMemoryUsageBytes),
+          _fairShareBytes(maxMemoryUsageBytes / std::max(numSorters, size_t(1))) {}
+
+    size_t maxMemoryUsageBytes() const {
+        return _maxMemoryUsageBytes;
+    }
+
+    size_t fairShareBytes() const {
+        return _fairShareBytes;
+    }
+
+    /**
+     * Returns the memory used by all of the sorters sharing this budget.
+     */
+    size_t memoryUsageBytes() const {
+        return _memUsed.load();
+    }
+
+    void add(size_t bytes) {
+        _memUsed.fetchAndAdd(bytes);
+    }
+
+    void subtract(size_t bytes) {
+        _memUsed.fetchAndSubtract(bytes);
+    }
+
+    /**
+     * Returns whether a sorter which holds 'sorterMemUsed' bytes should spill to stay within the
+     * budget. When the budget is exceeded, at least one sorter holds more than its fair share.
+     */
+    bool shouldSpill(size_t sorterMemUsed) const {
+        return sorterMemUsed > _fairShareBytes && memoryUsageBytes() > _maxMemoryUsageBytes;
+    }
+
+private:
+    const size_t _maxMemoryUsageBytes;
+    const size_t _fairShareBytes;
+    AtomicWord<size_t> _memUsed{0};
+};
+
 /**
  * Runtime options that control the Sorter's behavior
  */
@@ -107,6 +158,14 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
+    // If set, the sorter also spills when the sorters sharing this budget exceed it. Only sorters
+    // without a limit use the shared budget.
+    std::shared_ptr<SorterMemoryBudget> sharedMemoryBudget;
+
+    // If true and the sorter spilled, its spilled ranges are merged on a separate thread, ahead of
+    // the consumer of the output. Only sorters without a limit prefetch.
+    bool prefetchMergedOutput = false;
+
     SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
@@ -130,6 +189,16 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& SharedMemoryBudget(std::shared_ptr<SorterMemoryBudget> newSharedMemoryBudget) {
+        sharedMemoryBudget = std::move(newSharedMemoryBudget);
+        return *this;
+    }
+
+    SortOptions& PrefetchMergedOutput(bool newPrefetchMergedOutput = true) {
+        prefetchMergedOutput = newPrefetchMergedOutput;
+        return *this;
+    }
 };
 
 /**
@@ -188,6 +257,10 @@ public:
     virtual void openSource() = 0;
     virtual void closeSource() = 0;
 
+    // Sets how many bytes an iterator over a file reads at once, ahead of the data it returns.
+    // Takes effect on the next call to openSource().
+    virtual void setReadAheadBytes(size_t bytes) {}
+
     virtual SorterRangeInfo getRangeInfo() const {
         invariant(false, "Only FileIterator has ranges");
         MONGO_UNREACHABLE;
@@ -256,6 +329,12 @@ public:
 
     void persistDataForShutdown();
 
+    /**
+     * Spills the data added so far to disk so that getState() describes all of it. Unlike
+     * persistDataForShutdown(), the files are still removed when this Sorter is destroyed.
+     */
+    void persistDataForCheckpoint();
+
 protected:
     Sorter() {}  // can only be constructed as a base
 
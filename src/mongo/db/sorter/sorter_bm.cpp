@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+#include <numeric>
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+
+std::string nextFileName() {
+    static AtomicWord<unsigned> sorterBmFileCounter;
+    return "extsort-sorter-bm." + std::to_string(sorterBmFileCounter.fetchAndAdd(1));
+}
+
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace {
+
+class IntWrapper {
+public:
+    IntWrapper(int i = 0) : _i(i) {}
+    operator const int&() const {
+        return _i;
+    }
+
+    struct SorterDeserializeSettings {};
+    void serializeForSorter(BufBuilder& buf) const {
+        buf.appendNum(_i);
+    }
+    static IntWrapper deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&) {
+        return buf.read<LittleEndian<int>>().value;
+    }
+    int memUsageForSorter() const {
+        return sizeof(IntWrapper);
+    }
+    IntWrapper getOwned() const {
+        return *this;
+    }
+
+private:
+    int _i;
+};
+
+using IWPair = std::pair<IntWrapper, IntWrapper>;
+using IWSorter = Sorter<IntWrapper, IntWrapper>;
+
+struct IWComparator {
+    int operator()(const IWPair& lhs, const IWPair& rhs) const {
+        return static_cast<int>(lhs.first) - static_cast<int>(rhs.first);
+    }
+};
+
+/**
+ * Sorts state.range(0) shuffled integers with a memory limit that makes the sorter spill about 100
+ * ranges, so that most of the time goes into writing, reading and merging spilled data. The output
+ * is merged on a separate thread when state.range(1) is set.
+ */
+void BM_SortSpilled(benchmark::State& state) {
+    const int numItems = state.range(0);
+    const bool prefetch = state.range(1);
+
+    std::vector<int> items(numItems);
+    std::iota(items.begin(), items.end(), 0);
+    PseudoRandom random(1);
+    std::shuffle(items.begin(), items.end(), random.urbg());
+
+    const auto tempDir = boost::filesystem::temp_directory_path() /
+        boost::filesystem::unique_path("sorter_bm-%%%%-%%%%");
+    boost::filesystem::create_directories(tempDir);
+    const SortOptions opts = SortOptions()
+                                 .TempDir(tempDir.string())
+                                 .ExtSortAllowed()
+                                 .MaxMemoryUsageBytes(numItems * sizeof(IWPair) / 100)
+                                 .PrefetchMergedOutput(prefetch);
+
+    for (auto _ : state) {
+        std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator()));
+        for (int item : items) {
+            sorter->add(item, -item);
+        }
+        std::unique_ptr<IWSorter::Iterator> iter(sorter->done());
+        while (iter->more()) {
+            benchmark::DoNotOptimize(iter->next());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+
+    boost::filesystem::remove_all(tempDir);
+}
+
+BENCHMARK(BM_SortSpilled)->Args({1 << 20, 0})->Args({1 << 20, 1})->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
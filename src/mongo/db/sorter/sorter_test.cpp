@@ -614,6 +614,87 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+class SharedMemoryBudget : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterTests");
+        const size_t pairSize = 2 * IntWrapper().memUsageForSorter();
+        const size_t maxMemoryUsageBytes = 10 * pairSize;
+        auto budget = std::make_shared<SorterMemoryBudget>(maxMemoryUsageBytes, 2);
+        ASSERT_EQ(5 * pairSize, budget->fairShareBytes());
+
+        const SortOptions opts = SortOptions()
+                                     .TempDir(tempDir.path())
+                                     .ExtSortAllowed()
+                                     .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+                                     .SharedMemoryBudget(budget);
+        std::shared_ptr<IWSorter> large(IWSorter::make(opts, IWComparator(ASC)));
+        std::shared_ptr<IWSorter> small(IWSorter::make(opts, IWComparator(ASC)));
+
+        // The large sorter may use the memory the small sorter leaves unused.
+        for (int i = 0; i < 9; i++) {
+            large->add(i, -i);
+        }
+        small->add(0, 0);
+        ASSERT_EQ(maxMemoryUsageBytes, budget->memoryUsageBytes());
+        ASSERT_EQ(0U, large->getState().ranges.size());
+
+        // Exceeding the budget does not make a sorter within its fair share spill...
+        small->add(1, -1);
+        ASSERT_EQ(0U, small->getState().ranges.size());
+        ASSERT_EQ(0U, large->getState().ranges.size());
+
+        // ...but makes the sorter holding more than its fair share spill on its next insert.
+        large->add(9, -9);
+        ASSERT_EQ(1U, large->getState().ranges.size());
+        ASSERT_EQ(2 * pairSize, budget->memoryUsageBytes());
+
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(large->done()),
+                                    make_shared<IntIterator>(0, 10));
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(small->done()),
+                                    make_shared<IntIterator>(0, 2));
+        ASSERT_EQ(0U, budget->memoryUsageBytes());
+    }
+};
+class PrefetchMergedOutput : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterTests");
+        const SortOptions opts = SortOptions()
+                                     .TempDir(tempDir.path())
+                                     .ExtSortAllowed()
+                                     .MaxMemoryUsageBytes(MEM_LIMIT)
+                                     .PrefetchMergedOutput();
+        {
+            std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+            addData(sorter.get());
+            ASSERT_GT(sorter->getState().ranges.size(), 1U);
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                        make_shared<IntIterator>(0, NUM_ITEMS));
+        }
+        {
+            // Destroying the iterator before consuming all of its output stops the merge.
+            std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+            addData(sorter.get());
+            std::unique_ptr<IWIterator> iter(sorter->done());
+            ASSERT(iter->more());
+            ASSERT_EQ(0, iter->next().first);
+        }
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+
+private:
+    void addData(IWSorter* sorter) {
+        for (int i = NUM_ITEMS - 1; i >= 0; i--)
+            sorter->add(i, -i);
+    }
+
+    enum Constants {
+        NUM_ITEMS = 500 * 1000,
+        MEM_LIMIT = 64 * 1024,
+    };
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -630,6 +711,8 @@ public:
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
         add<SorterTests::Dupes>();
+        add<SorterTests::SharedMemoryBudget>();
+        add<SorterTests::PrefetchMergedOutput>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
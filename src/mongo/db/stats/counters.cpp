@@ -244,16 +244,29 @@ Status AuthCounter::incAuthenticateSuccessful(const std::string& mechanism) try
                           << " which is not enabled"};
 }
 
+Status AuthCounter::incAuthenticationTime(const std::string& mechanism,
+                                          Microseconds elapsed) try {
+    _mechanisms.at(mechanism).authenticationMicros.fetchAndAddRelaxed(
+        durationCount<Microseconds>(elapsed));
+    return Status::OK();
+} catch (const std::out_of_range&) {
+    return {ErrorCodes::BadValue,
+            str::stream() << "Spent time authenticating with mechanism " << mechanism
+                          << " which is unknown or not enabled"};
+}
+
 /**
  * authentication: {
  *   "mechanisms": {
  *     "SCRAM-SHA-256": {
  *       "speculativeAuthenticate": { received: ###, successful: ### },
  *       "authenticate": { received: ###, successful: ### },
+ *       "totalAuthenticationMicros": ###,
  *     },
  *     "MONGODB-X509": {
  *       "speculativeAuthenticate": { received: ###, successful: ### },
  *       "authenticate": { received: ###, successful: ### },
+ *       "totalAuthenticationMicros": ###,
  *     },
  *   },
  * }
@@ -284,6 +297,7 @@ void AuthCounter::append(BSONObjBuilder* b) {
             authBuilder.done();
         }
 
+        mechBuilder.append("totalAuthenticationMicros", it.second.authenticationMicros.load());
         mechBuilder.done();
     }
 
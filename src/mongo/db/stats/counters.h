@@ -37,6 +37,7 @@
 #include "mongo/platform/basic.h"
 #include "mongo/rpc/message.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/with_alignment.h"
@@ -226,6 +227,12 @@ public:
     Status incAuthenticateReceived(const std::string& mechanism);
     Status incAuthenticateSuccessful(const std::string& mechanism);
 
+    /**
+     * Adds time the server spent verifying a client's credentials with 'mechanism', excluding the
+     * delay imposed on failed attempts.
+     */
+    Status incAuthenticationTime(const std::string& mechanism, Microseconds elapsed);
+
     void append(BSONObjBuilder*);
 
     void initializeMechanismMap(const std::vector<std::string>&);
@@ -240,6 +247,7 @@ private:
             AtomicWord<long long> received;
             AtomicWord<long long> successful;
         } authenticate;
+        AtomicWord<long long> authenticationMicros;
     };
     using MechanismMap = std::map<std::string, MechanismData>;
 
@@ -33,6 +33,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/util/latency_histogram.h"
 
 namespace mongo {
 namespace {
@@ -60,5 +61,23 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends every named LatencyHistogram, such as those for ticket and write concern waits.
+ */
+class LatencyHistogramsServerStatusSection final : public ServerStatusSection {
+public:
+    LatencyHistogramsServerStatusSection() : ServerStatusSection("latencyHistograms") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder builder;
+        LatencyHistogram::appendAll(&builder);
+        return builder.obj();
+    }
+} latencyHistogramsServerStatusSection;
 }  // namespace
 }  // namespace mongo
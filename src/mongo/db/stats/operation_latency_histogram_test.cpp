@@ -64,6 +64,24 @@ TEST(OperationLatencyHistogram, EnsureIncrementsStored) {
     ASSERT_EQUALS(out["transactions"]["ops"].Long(), kMaxBuckets);
 }
 
+TEST(OperationLatencyHistogram, AddMergesCountsAndLatencies) {
+    OperationLatencyHistogram first, second, expected;
+    for (int i = 0; i < kMaxBuckets; i++) {
+        first.increment(kLowerBounds[i], Command::ReadWriteType::kRead);
+        second.increment(kLowerBounds[i] + 1, Command::ReadWriteType::kRead);
+        second.increment(kLowerBounds[i], Command::ReadWriteType::kTransaction);
+        expected.increment(kLowerBounds[i], Command::ReadWriteType::kRead);
+        expected.increment(kLowerBounds[i] + 1, Command::ReadWriteType::kRead);
+        expected.increment(kLowerBounds[i], Command::ReadWriteType::kTransaction);
+    }
+    first.add(second);
+
+    BSONObjBuilder outBuilder, expectedBuilder;
+    first.append(true, false, &outBuilder);
+    expected.append(true, false, &expectedBuilder);
+    ASSERT_BSONOBJ_EQ(outBuilder.done(), expectedBuilder.done());
+}
+
 TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
     OperationLatencyHistogram hist;
     // Increment at the boundary, boundary+1, and boundary-1.
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_stats_store.h"
+
+#include <absl/hash/hash.h>
+#include <tuple>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+absl::string_view toStringView(StringData str) {
+    return absl::string_view(str.rawData(), str.size());
+}
+
+/**
+ * Bucket 'i' of the latency histogram counts executions that took at least 2^i microseconds.
+ * Bucket 0 also holds executions that took less than a microsecond.
+ */
+int latencyBucket(Microseconds latency) {
+    const long long micros = durationCount<Microseconds>(latency);
+    if (micros <= 1) {
+        return 0;
+    }
+    return std::min(63 - countLeadingZeros64(micros), QueryStatsStore::kNumLatencyBuckets - 1);
+}
+
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* service) {
+    return getQueryStatsStore(service);
+}
+
+size_t QueryStatsStore::KeyHasher::operator()(const KeyView& key) const {
+    return absl::Hash<std::tuple<absl::string_view, uint32_t, absl::string_view>>{}(
+        std::make_tuple(toStringView(key.ns), key.queryHash, toStringView(key.command)));
+}
+
+void QueryStatsStore::record(StringData ns,
+                             uint32_t queryHash,
+                             StringData command,
+                             const Metrics& metrics) {
+    const int maxShapes = internalQueryStatsMaxShapes.load();
+    if (maxShapes == 0) {
+        return;
+    }
+
+    const KeyView key{ns, queryHash, command};
+    // The map consumes the low bits of the hash, so pick the partition from the high ones.
+    auto& partition = _partitions[(KeyHasher{}(key) >> 48) % kNumPartitions];
+
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.entries.find(key);
+    if (it == partition.entries.end()) {
+        if (_numShapes.load() >= maxShapes) {
+            _dropped.fetchAndAdd(1);
+            return;
+        }
+        _numShapes.fetchAndAdd(1);
+        it = partition.entries.emplace(Key{ns.toString(), queryHash, command}, Entry{}).first;
+    }
+
+    auto& entry = it->second;
+    entry.count++;
+    entry.totalLatency += metrics.latency;
+    entry.maxLatency = std::max(entry.maxLatency, metrics.latency);
+    entry.latencyBuckets[latencyBucket(metrics.latency)]++;
+    entry.docsExamined += metrics.docsExamined;
+    entry.keysExamined += metrics.keysExamined;
+    entry.nreturned += metrics.nreturned;
+    entry.bytesReturned += metrics.bytesReturned;
+}
+
+std::vector<BSONObj> QueryStatsStore::getStats() const {
+    std::vector<BSONObj> stats;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        for (const auto& [key, entry] : partition.entries) {
+            BSONObjBuilder bob;
+            bob.append("ns", key.ns);
+            bob.append("queryHash", unsignedIntToFixedLengthHex(key.queryHash));
+            bob.append("command", key.command);
+            bob.append("count", entry.count);
+            bob.append("totalLatencyMicros", durationCount<Microseconds>(entry.totalLatency));
+            bob.append("maxLatencyMicros", durationCount<Microseconds>(entry.maxLatency));
+            {
+                BSONArrayBuilder histogram(bob.subarrayStart("latencyHistogram"));
+                for (int i = 0; i < kNumLatencyBuckets; ++i) {
+                    if (entry.latencyBuckets[i] == 0) {
+                        continue;
+                    }
+                    histogram.append(BSON("micros" << (1LL << i) << "count"
+                                                   << entry.latencyBuckets[i]));
+                }
+            }
+            bob.append("docsExamined", entry.docsExamined);
+            bob.append("keysExamined", entry.keysExamined);
+            bob.append("nreturned", entry.nreturned);
+            bob.append("bytesReturned", entry.bytesReturned);
+            stats.push_back(bob.obj());
+        }
+    }
+    return stats;
+}
+
+void QueryStatsStore::clear() {
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        _numShapes.subtractAndFetch(partition.entries.size());
+        partition.entries.clear();
+    }
+    _dropped.store(0);
+}
+
+}  // namespace mongo
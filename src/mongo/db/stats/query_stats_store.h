@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/container/node_hash_map.h>
+#include <array>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Aggregates execution statistics per query shape, where a shape is the namespace, the query
+ * hash of the plan cache key and the command that ran it. The store is bounded by the
+ * 'internalQueryStatsMaxShapes' knob and is cheap enough to leave enabled: recording touches a
+ * single partition, chosen by the shape's hash, under a short critical section.
+ */
+class QueryStatsStore {
+public:
+    static constexpr int kNumLatencyBuckets = 32;
+
+    static QueryStatsStore& get(ServiceContext* service);
+
+    /**
+     * The statistics of a single execution of a query shape.
+     */
+    struct Metrics {
+        Microseconds latency{0};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+    };
+
+    /**
+     * Adds one execution of the query shape identified by 'ns', 'queryHash' and 'command'.
+     * 'command' must refer to storage that outlives the store, such as a command's name.
+     */
+    void record(StringData ns, uint32_t queryHash, StringData command, const Metrics& metrics);
+
+    /**
+     * Returns one document per recorded query shape.
+     */
+    std::vector<BSONObj> getStats() const;
+
+    /**
+     * Number of executions that were not recorded because the store was full.
+     */
+    long long getDroppedCount() const {
+        return _dropped.load();
+    }
+
+    void clear();
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Key {
+        std::string ns;
+        uint32_t queryHash;
+        StringData command;
+    };
+
+    // Allows looking entries up without building a Key, which would copy the namespace.
+    struct KeyView {
+        StringData ns;
+        uint32_t queryHash;
+        StringData command;
+    };
+
+    struct KeyHasher {
+        using is_transparent = void;
+        size_t operator()(const KeyView& key) const;
+        size_t operator()(const Key& key) const {
+            return (*this)(KeyView{key.ns, key.queryHash, key.command});
+        }
+    };
+
+    struct KeyEq {
+        using is_transparent = void;
+        static KeyView view(const Key& key) {
+            return {key.ns, key.queryHash, key.command};
+        }
+        static const KeyView& view(const KeyView& key) {
+            return key;
+        }
+        template <typename L, typename R>
+        bool operator()(const L& lhs, const R& rhs) const {
+            const KeyView& l = view(lhs);
+            const KeyView& r = view(rhs);
+            return l.queryHash == r.queryHash && l.ns == r.ns && l.command == r.command;
+        }
+    };
+
+    struct Entry {
+        long long count = 0;
+        Microseconds totalLatency{0};
+        Microseconds maxLatency{0};
+        std::array<long long, kNumLatencyBuckets> latencyBuckets{};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+    };
+
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryStatsStore::Partition::mutex");
+        // Uses absl directly as the stdx wrapper does not support heterogeneous lookup.
+        absl::node_hash_map<Key, Entry, KeyHasher, KeyEq> entries;
+    };
+
+    std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
+
+    // Total number of shapes across all partitions, checked against the configured bound.
+    AtomicWord<int> _numShapes{0};
+
+    AtomicWord<long long> _dropped{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/stats/query_stats_store.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+QueryStatsStore::Metrics makeMetrics(Microseconds latency, long long docsExamined) {
+    QueryStatsStore::Metrics metrics;
+    metrics.latency = latency;
+    metrics.docsExamined = docsExamined;
+    metrics.keysExamined = docsExamined / 2;
+    metrics.nreturned = 1;
+    metrics.bytesReturned = 100;
+    return metrics;
+}
+
+TEST(QueryStatsStoreTest, AggregatesExecutionsOfTheSameShape) {
+    QueryStatsStore store;
+    store.record("test.coll", 0x1234, "find", makeMetrics(Microseconds(3), 10));
+    store.record("test.coll", 0x1234, "find", makeMetrics(Microseconds(300), 20));
+
+    auto stats = store.getStats();
+    ASSERT_EQ(stats.size(), 1U);
+    ASSERT_BSONOBJ_EQ(stats[0],
+                      BSON("ns"
+                           << "test.coll"
+                           << "queryHash"
+                           << "00001234"
+                           << "command"
+                           << "find"
+                           << "count" << 2LL << "totalLatencyMicros" << 303LL
+                           << "maxLatencyMicros" << 300LL << "latencyHistogram"
+                           << BSON_ARRAY(BSON("micros" << 2LL << "count" << 1LL)
+                                         << BSON("micros" << 256LL << "count" << 1LL))
+                           << "docsExamined" << 30LL << "keysExamined" << 15LL << "nreturned"
+                           << 2LL << "bytesReturned" << 200LL));
+}
+
+TEST(QueryStatsStoreTest, SeparatesShapesByNamespaceHashAndCommand) {
+    QueryStatsStore store;
+    store.record("test.coll", 1, "find", makeMetrics(Microseconds(1), 1));
+    store.record("test.other", 1, "find", makeMetrics(Microseconds(1), 1));
+    store.record("test.coll", 2, "find", makeMetrics(Microseconds(1), 1));
+    store.record("test.coll", 1, "aggregate", makeMetrics(Microseconds(1), 1));
+    ASSERT_EQ(store.getStats().size(), 4U);
+
+    store.clear();
+    ASSERT_EQ(store.getStats().size(), 0U);
+}
+
+TEST(QueryStatsStoreTest, DropsNewShapesOnceFull) {
+    const auto originalMaxShapes = internalQueryStatsMaxShapes.load();
+    ON_BLOCK_EXIT([&] { internalQueryStatsMaxShapes.store(originalMaxShapes); });
+    internalQueryStatsMaxShapes.store(2);
+
+    QueryStatsStore store;
+    store.record("test.coll", 1, "find", makeMetrics(Microseconds(1), 1));
+    store.record("test.coll", 2, "find", makeMetrics(Microseconds(1), 1));
+    store.record("test.coll", 3, "find", makeMetrics(Microseconds(1), 1));
+    ASSERT_EQ(store.getStats().size(), 2U);
+    ASSERT_EQ(store.getDroppedCount(), 1);
+
+    // Shapes that are already tracked keep being recorded.
+    store.record("test.coll", 1, "find", makeMetrics(Microseconds(1), 1));
+    ASSERT_EQ(store.getDroppedCount(), 1);
+
+    internalQueryStatsMaxShapes.store(0);
+    store.record("test.coll", 1, "find", makeMetrics(Microseconds(1), 1));
+    long long total = 0;
+    for (auto&& entry : store.getStats()) {
+        total += entry["count"].numberLong();
+    }
+    ASSERT_EQ(total, 3);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -47,6 +47,10 @@ namespace {
 
 const auto getTop = ServiceContext::declareDecoration<Top>();
 
+// Hands out global histogram shards to threads in turn, so that concurrently running threads
+// mostly record into different shards.
+AtomicWord<unsigned> nextGlobalHistogramShard{0};
+
 }  // namespace
 
 Top::UsageData::UsageData(const UsageData& older, const UsageData& newer) {
@@ -64,7 +68,40 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       insert(older.insert, newer.insert),
       update(older.update, newer.update),
       remove(older.remove, newer.remove),
-      commands(older.commands, newer.commands) {}
+      commands(older.commands, newer.commands),
+      storage(older.storage, newer.storage) {}
+
+Top::StorageData::StorageData(const StorageData& older, const StorageData& newer)
+    : count(newer.count - older.count) {
+    for (const auto& [sectionName, newerSection] : newer.sections) {
+        auto olderSection = older.sections.find(sectionName);
+        for (const auto& [statName, newerValue] : newerSection) {
+            long long olderValue = 0;
+            if (olderSection != older.sections.end()) {
+                auto olderStat = olderSection->second.find(statName);
+                if (olderStat != olderSection->second.end()) {
+                    olderValue = olderStat->second;
+                }
+            }
+            sections[sectionName][statName] = newerValue - olderValue;
+        }
+    }
+}
+
+void Top::StorageData::inc(const BSONObj& operationStats) {
+    count++;
+    for (auto&& section : operationStats) {
+        if (section.type() != Object) {
+            continue;
+        }
+        auto& sectionTotals = sections[section.fieldName()];
+        for (auto&& stat : section.Obj()) {
+            if (stat.isNumber()) {
+                sectionTotals[stat.fieldName()] += stat.safeNumberLong();
+            }
+        }
+    }
+}
 
 // static
 Top& Top::get(ServiceContext* service) {
@@ -82,12 +119,34 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& shard = _getUsageShard(hashedNs.hash());
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = shard.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
+void Top::recordStorageStats(StringData ns, const BSONObj& operationStats) {
+    if (ns.empty() || ns[0] == '?')
+        return;
+
+    auto hashedNs = UsageMap::hasher().hashed_key(ns);
+    auto& shard = _getUsageShard(hashedNs.hash());
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
+
+    shard.usage[hashedNs].storage.inc(operationStats);
+}
+
+Top::UsageShard& Top::_getUsageShard(std::size_t nsHash) {
+    // The maps consume the low bits of the hash, so pick the shard from the high ones.
+    return _usageShards[(nsHash >> 48) % kNumUsageShards];
+}
+
+Top::GlobalHistogramShard& Top::_getGlobalHistogramShard() {
+    thread_local const unsigned shard = nextGlobalHistogramShard.fetchAndAdd(1);
+    return _globalHistogramShards[shard % kNumGlobalHistogramShards];
+}
+
 void Top::_record(OperationContext* opCtx,
                   CollectionData& c,
                   LogicalOp logicalOp,
@@ -134,18 +193,24 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
+    auto& shard = _getUsageShard(hashedNs.hash());
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
+    shard.usage.erase(hashedNs);
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out.clear();
+    for (const auto& shard : _usageShards) {
+        stdx::lock_guard<SimpleMutex> lk(shard.lock);
+        out.insert(shard.usage.begin(), shard.usage.end());
+    }
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    UsageMap usage;
+    cloneMap(usage);
+    _appendToUsageMap(b, usage);
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -175,6 +240,10 @@ void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
         _appendStatsEntry(b, "remove", coll.remove);
         _appendStatsEntry(b, "commands", coll.commands);
 
+        if (coll.storage.count) {
+            _appendStorageEntry(b, coll.storage);
+        }
+
         bb.done();
     }
 }
@@ -186,13 +255,26 @@ void Top::_appendStatsEntry(BSONObjBuilder& b, const char* statsName, const Usag
     bb.done();
 }
 
+void Top::_appendStorageEntry(BSONObjBuilder& b, const StorageData& storage) const {
+    BSONObjBuilder bb(b.subobjStart("storage"));
+    bb.appendNumber("count", storage.count);
+    for (const auto& [sectionName, section] : storage.sections) {
+        BSONObjBuilder sectionBuilder(bb.subobjStart(sectionName));
+        for (const auto& [statName, value] : section) {
+            sectionBuilder.appendNumber(statName, value);
+        }
+    }
+    bb.done();
+}
+
 void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& shard = _getUsageShard(hashedNs.hash());
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+    shard.usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -203,20 +285,26 @@ void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    auto& shard = _getGlobalHistogramShard();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    _incrementHistogram(opCtx, latency, &shard.histogram, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
+    OperationLatencyHistogram globalHistogramStats;
+    for (auto& shard : _globalHistogramShards) {
+        stdx::lock_guard<SimpleMutex> guard(shard.lock);
+        globalHistogramStats.add(shard.histogram);
+    }
+    globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    auto& shard = _getGlobalHistogramShard();
+    stdx::lock_guard<SimpleMutex> guard(shard.lock);
+    shard.histogram.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
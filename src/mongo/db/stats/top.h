@@ -34,12 +34,15 @@
  */
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <map>
+#include <string>
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -66,6 +69,19 @@ public:
         }
     };
 
+    /**
+     * Storage engine statistics summed over the operations that reported them, kept by section
+     * and statistic name as they appear in the operation's storage statistics document.
+     */
+    struct StorageData {
+        StorageData() = default;
+        StorageData(const StorageData& older, const StorageData& newer);
+        long long count = 0;
+        std::map<std::string, std::map<std::string, long long>> sections;
+
+        void inc(const BSONObj& operationStats);
+    };
+
     struct CollectionData {
         /**
          * constructs a diff
@@ -84,6 +100,8 @@ public:
         UsageData update;
         UsageData remove;
         UsageData commands;
+
+        StorageData storage;
         OperationLatencyHistogram opLatencyHistogram;
     };
 
@@ -104,6 +122,12 @@ public:
                 bool command,
                 Command::ReadWriteType readWriteType);
 
+    /**
+     * Adds an operation's storage statistics, as produced by StorageStats::toBSON(), to the totals
+     * for its collection.
+     */
+    void recordStorageStats(StringData ns, const BSONObj& operationStats);
+
     void append(BSONObjBuilder& b);
 
     void cloneMap(UsageMap& out) const;
@@ -141,6 +165,8 @@ private:
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
 
+    void _appendStorageEntry(BSONObjBuilder& b, const StorageData& storage) const;
+
     void _record(OperationContext* opCtx,
                  CollectionData& c,
                  LogicalOp logicalOp,
@@ -153,9 +179,31 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    // Collections are spread over shards by the hash of their namespace, so that operations on
+    // different collections do not serialize on one mutex.
+    static constexpr size_t kNumUsageShards = 16;
+
+    struct UsageShard {
+        mutable SimpleMutex lock;
+        UsageMap usage;
+    };
+
+    UsageShard& _getUsageShard(std::size_t nsHash);
+
+    // Every user operation updates the global histograms, so each thread records into one of
+    // several copies, which are only merged when the global latency statistics are read.
+    static constexpr size_t kNumGlobalHistogramShards = 16;
+
+    struct GlobalHistogramShard {
+        SimpleMutex lock;
+        OperationLatencyHistogram histogram;
+    };
+
+    GlobalHistogramShard& _getGlobalHistogramShard();
+
+    std::array<CacheAligned<UsageShard>, kNumUsageShards> _usageShards;
+    std::array<CacheAligned<GlobalHistogramShard>, kNumGlobalHistogramShards>
+        _globalHistogramShards;
 };
 
 }  // namespace mongo
@@ -40,4 +40,33 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped(NamespaceString("test.coll"));
 }
 
+TEST(TopTest, RecordStorageStatsSumsBySection) {
+    Top top;
+    top.recordStorageStats("test.coll",
+                           BSON("data" << BSON("bytesRead" << 100 << "timeReadingMicros" << 5)
+                                       << "timeWaitingMicros" << BSON("cache" << 7)));
+    top.recordStorageStats("test.coll", BSON("data" << BSON("bytesRead" << 50)));
+    top.recordStorageStats("test.other", BSON("data" << BSON("bytesRead" << 1)));
+
+    BSONObjBuilder builder;
+    top.append(builder);
+    auto storage = builder.obj()["test.coll"]["storage"].Obj();
+    ASSERT_BSONOBJ_EQ(storage,
+                      BSON("count" << 2 << "data"
+                                   << BSON("bytesRead" << 150 << "timeReadingMicros" << 5)
+                                   << "timeWaitingMicros" << BSON("cache" << 7)));
+}
+
+TEST(TopTest, StorageStatsDiff) {
+    Top::StorageData older;
+    older.inc(BSON("data" << BSON("bytesRead" << 10)));
+    Top::StorageData newer = older;
+    newer.inc(BSON("data" << BSON("bytesRead" << 30) << "timeWaitingMicros" << BSON("cache" << 2)));
+
+    Top::StorageData diff(older, newer);
+    ASSERT_EQ(diff.count, 1);
+    ASSERT_EQ(diff.sections["data"]["bytesRead"], 30);
+    ASSERT_EQ(diff.sections["timeWaitingMicros"]["cache"], 2);
+}
+
 }  // namespace
@@ -157,6 +157,14 @@ public:
      */
     bool trySwapMaster(StringStore& newMaster, uint64_t version);
 
+    /**
+     * Returns the number of bytes of data currently committed to the master.
+     */
+    size_t getDataSize() const {
+        stdx::lock_guard<Latch> lock(_masterLock);
+        return _master.dataSize();
+    }
+
 private:
     std::shared_ptr<void> _catalogInfo;
     int _cachePressureForTest = 0;
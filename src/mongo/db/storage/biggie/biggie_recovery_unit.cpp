@@ -34,7 +34,9 @@
 #include <mutex>
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/storage/biggie/biggie_parameters_gen.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace biggie {
@@ -65,6 +67,16 @@ void RecoveryUnit::doCommitUnitOfWork() {
                 throw WriteConflictException();
             }
 
+            // Biggie keeps everything in memory, so bound its growth. Commits that do not grow
+            // the data are always allowed so that space can be reclaimed once at the limit.
+            const auto maxDataSize = gBiggieMaxDataSizeBytes.load();
+            const auto dataSize = _workingCopy.dataSize();
+            uassert(ErrorCodes::ExceededMemoryLimit,
+                    str::stream() << "Committing would grow the biggie data size to " << dataSize
+                                  << " bytes, beyond biggieMaxDataSizeBytes of " << maxDataSize,
+                    maxDataSize == 0 || dataSize <= static_cast<size_t>(maxDataSize) ||
+                        dataSize <= masterInfo.second.dataSize());
+
             if (_KVEngine->trySwapMaster(_workingCopy, masterInfo.first)) {
                 // Merged successfully
                 break;
@@ -29,13 +29,17 @@
 
 #include "mongo/platform/basic.h"
 
+#include <functional>
 #include <memory>
 
 #include "mongo/base/init.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/biggie/biggie_kv_engine.h"
+#include "mongo/db/storage/biggie/biggie_parameters_gen.h"
 #include "mongo/db/storage/biggie/biggie_recovery_unit.h"
 #include "mongo/db/storage/recovery_unit_test_harness.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace biggie {
@@ -72,6 +76,43 @@ MONGO_INITIALIZER(RegisterRecoveryUnitHarnessFactory)(InitializerContext* const)
     return Status::OK();
 }
 
+TEST(BiggieRecoveryUnitTest, CommitBeyondMaxDataSizeFails) {
+    KVEngine engine;
+    const auto originalMaxDataSize = gBiggieMaxDataSizeBytes.swap(16);
+    ON_BLOCK_EXIT([&] { gBiggieMaxDataSizeBytes.store(originalMaxDataSize); });
+
+    auto write = [&](std::function<void(StringStore*)> change) {
+        RecoveryUnit ru(&engine);
+        ru.beginUnitOfWork(nullptr);
+        change(ru.getHead());
+        ru.makeDirty();
+        try {
+            ru.commitUnitOfWork();
+        } catch (const DBException&) {
+            ru.abortUnitOfWork();
+            throw;
+        }
+    };
+
+    // Fits within the limit.
+    write([](StringStore* store) { store->insert({"a", std::string(10, 'x')}); });
+    ASSERT_EQ(engine.getDataSize(), 10U);
+
+    // Would grow the data past the limit, so nothing is committed.
+    ASSERT_THROWS_CODE(
+        write([](StringStore* store) { store->insert({"b", std::string(10, 'x')}); }),
+        DBException,
+        ErrorCodes::ExceededMemoryLimit);
+    ASSERT_EQ(engine.getDataSize(), 10U);
+
+    // Once over the limit, shrinking commits are still allowed.
+    gBiggieMaxDataSizeBytes.store(5);
+    write([](StringStore* store) { store->update({"a", std::string(8, 'x')}); });
+    ASSERT_EQ(engine.getDataSize(), 8U);
+    write([](StringStore* store) { store->erase("a"); });
+    ASSERT_EQ(engine.getDataSize(), 0U);
+}
+
 }  // namespace
 }  // namespace biggie
 }  // namespace mongo
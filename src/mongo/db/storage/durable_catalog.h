@@ -177,6 +177,11 @@ public:
      */
     virtual void setRecordPreImages(OperationContext* opCtx, RecordId catalogId, bool val) = 0;
 
+    /**
+     * Updates whether updates and deletes of the documents in this collection are forbidden.
+     */
+    virtual void setAppendOnly(OperationContext* opCtx, RecordId catalogId, bool val) = 0;
+
     /**
      * Updates the validator for this collection.
      *
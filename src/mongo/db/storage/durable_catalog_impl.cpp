@@ -447,9 +447,14 @@ std::string DurableCatalogImpl::getFilesystemPathForDb(const std::string& dbName
     }
 }
 
-std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss, const char* kind) {
+std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss,
+                                                const char* kind,
+                                                bool coldStorage) {
     // If this changes to not put _rand at the end, _hasEntryCollidingWithRand will need fixing.
     StringBuilder buf;
+    if (coldStorage) {
+        buf << kColdStorageDirectory << '/';
+    }
     if (_directoryPerDb) {
         buf << escapeDbName(nss.db()) << '/';
     }
@@ -530,7 +535,7 @@ StatusWith<DurableCatalog::Entry> DurableCatalogImpl::_addEntry(OperationContext
                                                                 KVPrefix prefix) {
     invariant(opCtx->lockState()->isDbLockedForMode(nss.db(), MODE_IX));
 
-    const string ident = _newUniqueIdent(nss, "collection");
+    const string ident = _newUniqueIdent(nss, "collection", options.coldStorage);
 
     BSONObj obj;
     {
@@ -625,7 +630,7 @@ void DurableCatalogImpl::putMetaData(OperationContext* opCtx,
                 continue;
             }
             // missing, create new
-            newIdentMap.append(name, _newUniqueIdent(nss, "index"));
+            newIdentMap.append(name, _newUniqueIdent(nss, "index", md.options.coldStorage));
         }
         b.append("idxIdent", newIdentMap.obj());
 
@@ -958,6 +963,12 @@ void DurableCatalogImpl::setRecordPreImages(OperationContext* opCtx, RecordId ca
     putMetaData(opCtx, catalogId, md);
 }
 
+void DurableCatalogImpl::setAppendOnly(OperationContext* opCtx, RecordId catalogId, bool val) {
+    BSONCollectionCatalogEntry::MetaData md = getMetaData(opCtx, catalogId);
+    md.options.appendOnly = val;
+    putMetaData(opCtx, catalogId, md);
+}
+
 void DurableCatalogImpl::updateValidator(OperationContext* opCtx,
                                          RecordId catalogId,
                                          const BSONObj& validator,
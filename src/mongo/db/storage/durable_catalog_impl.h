@@ -52,6 +52,10 @@ class DurableCatalogImpl : public DurableCatalog {
 public:
     class FeatureTracker;
 
+    // The subdirectory of the dbpath holding the idents of collections created with the
+    // 'coldStorage' option.
+    static constexpr StringData kColdStorageDirectory = "cold"_sd;
+
     /**
      * The RecordStore must be thread-safe, in particular with concurrent calls to
      * RecordStore::find, updateRecord, insertRecord, deleteRecord and dataFor. The
@@ -137,6 +141,8 @@ public:
 
     void setRecordPreImages(OperationContext* opCtx, RecordId catalogId, bool val) override;
 
+    void setAppendOnly(OperationContext* opCtx, RecordId catalogId, bool val) override;
+
     void updateValidator(OperationContext* opCtx,
                          RecordId catalogId,
                          const BSONObj& validator,
@@ -216,8 +222,9 @@ private:
      * Generates a new unique identifier for a new "thing".
      * @param nss - the containing namespace
      * @param kind - what this "thing" is, likely collection or index
+     * @param coldStorage - whether to place the ident under the cold storage directory
      */
-    std::string _newUniqueIdent(NamespaceString nss, const char* kind);
+    std::string _newUniqueIdent(NamespaceString nss, const char* kind, bool coldStorage = false);
 
     // Helpers only used by constructor and init(). Don't call from elsewhere.
     static std::string _newRand();
@@ -43,6 +43,8 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/flow_control_parameters_gen.h"
+#include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/fail_point.h"
@@ -137,6 +139,7 @@ FlowControl::FlowControl(repl::ReplicationCoordinator* replCoord)
 
 FlowControl::FlowControl(ServiceContext* service, repl::ReplicationCoordinator* replCoord)
     : ServerStatusSection("flowControl"),
+      _service(service),
       _replCoord(replCoord),
       _lastTimeSustainerAdvanced(Date_t::now()) {
     // Initialize _lastTargetTicketsPermitted to maximum tickets to make sure flow control doesn't
@@ -213,6 +216,7 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
+    bob.append("dirtyCachePercent", _lastDirtyCacheRatio.load() * 100);
 
     return bob.obj();
 }
@@ -318,6 +322,46 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, kMaxTickets);
 }
 
+bool FlowControl::_lagPredictedToReachThreshold(std::uint64_t prevLagMillis,
+                                               std::uint64_t lagMillis,
+                                               std::uint64_t thresholdLagMillis) {
+    const auto predictionPeriods = gFlowControlLagPredictionPeriods.load();
+    if (predictionPeriods == 0 || lagMillis <= prevLagMillis) {
+        return false;
+    }
+
+    const auto growthMillis = lagMillis - prevLagMillis;
+    return lagMillis + growthMillis * predictionPeriods >= thresholdLagMillis;
+}
+
+int FlowControl::_limitTicketsForCachePressure(int tickets,
+                                               std::int64_t locksUsedLastPeriod,
+                                               boost::optional<double> dirtyCacheRatio) {
+    const auto threshold = gFlowControlDirtyCacheThreshold.load();
+    if (threshold == 0.0 || !dirtyCacheRatio || *dirtyCacheRatio < threshold) {
+        return tickets;
+    }
+
+    // Writes are dirtying the cache faster than eviction can clean it. Back off gradually from what
+    // was actually used rather than waiting for the resulting stalls to show up as majority lag.
+    return std::min(tickets,
+                    multiplyWithOverflowCheck(std::max(locksUsedLastPeriod, std::int64_t{0}),
+                                              gFlowControlFudgeFactor.load(),
+                                              kMaxTickets));
+}
+
+boost::optional<double> FlowControl::_getDirtyCacheRatio() const {
+    if (!_service) {
+        return boost::none;
+    }
+
+    auto storageEngine = _service->getStorageEngine();
+    if (!storageEngine) {
+        return boost::none;
+    }
+    return storageEngine->getEngine()->getDirtyCacheRatio();
+}
+
 int FlowControl::getNumTickets(Date_t now) {
     // Flow control can be disabled until a certain deadline is passed.
     const Date_t disabledUntil = _disableUntil.load();
@@ -356,6 +400,8 @@ int FlowControl::getNumTickets(Date_t now) {
     // monotonically increasing. Recordings that satisfy the following check result in a negative
     // value for lag, so ignore them.
     const bool ignoreWallTimes = lastCommitted.wallTime > myLastApplied.wallTime;
+    const auto lagMillis =
+        ignoreWallTimes ? 0 : getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime);
 
     // _approximateOpsBetween will return -1 if the input timestamps are in the same "bucket".
     // This is an indication that there are very few ops between the two timestamps.
@@ -363,17 +409,24 @@ int FlowControl::getNumTickets(Date_t now) {
     // Don't let the no-op writer on idle systems fool the sophisticated "is the replica set
     // lagged" classifier.
     const bool isHealthy = !ignoreWallTimes &&
-        (getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime) < thresholdLagMillis ||
+        (lagMillis < thresholdLagMillis ||
          _approximateOpsBetween(lastCommitted.opTime.getTimestamp(),
                                 myLastApplied.opTime.getTimestamp()) == -1);
 
     if (isHealthy) {
-        // The add/multiply technique is used to ensure ticket allocation can ramp up quickly,
-        // particularly if there were very few tickets to begin with.
-        ret = multiplyWithOverflowCheck(_lastTargetTicketsPermitted.load() +
-                                            gFlowControlTicketAdderConstant.load(),
-                                        gFlowControlTicketMultiplierConstant.load(),
-                                        kMaxTickets);
+        if (_lagPredictedToReachThreshold(_lastLagMillis, lagMillis, thresholdLagMillis)) {
+            // The lag is still acceptable but growing quickly enough to cross the threshold soon.
+            // Holding steady here is what keeps the primary from oscillating between full speed and
+            // heavy throttling.
+            ret = _lastTargetTicketsPermitted.load();
+        } else {
+            // The add/multiply technique is used to ensure ticket allocation can ramp up quickly,
+            // particularly if there were very few tickets to begin with.
+            ret = multiplyWithOverflowCheck(_lastTargetTicketsPermitted.load() +
+                                                gFlowControlTicketAdderConstant.load(),
+                                            gFlowControlTicketMultiplierConstant.load(),
+                                            kMaxTickets);
+        }
         _lastTimeSustainerAdvanced = Date_t::now();
         if (_isLagged.load()) {
             _isLagged.store(false);
@@ -383,13 +436,12 @@ int FlowControl::getNumTickets(Date_t now) {
     } else if (!ignoreWallTimes && sustainerAdvanced(_prevMemberData, _currMemberData)) {
         // Expected case where flow control has meaningful data from the last period to make a new
         // calculation.
-        ret =
-            _calculateNewTicketsForLag(_prevMemberData,
-                                       _currMemberData,
-                                       locksUsedLastPeriod,
-                                       locksPerOp,
-                                       getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
-                                       thresholdLagMillis);
+        ret = _calculateNewTicketsForLag(_prevMemberData,
+                                         _currMemberData,
+                                         locksUsedLastPeriod,
+                                         locksPerOp,
+                                         lagMillis,
+                                         thresholdLagMillis);
         if (!_isLagged.load()) {
             _isLagged.store(true);
             _isLaggedCount.fetchAndAddRelaxed(1);
@@ -405,6 +457,10 @@ int FlowControl::getNumTickets(Date_t now) {
         // variables here.
     }
 
+    const auto dirtyCacheRatio = _getDirtyCacheRatio();
+    _lastDirtyCacheRatio.store(dirtyCacheRatio.value_or(0.0));
+    ret = _limitTicketsForCachePressure(ret, locksUsedLastPeriod, dirtyCacheRatio);
+
     ret = std::max(ret, gFlowControlMinTicketsPerSecond.load());
 
     LOGV2_DEBUG(22220,
@@ -423,6 +479,9 @@ int FlowControl::getNumTickets(Date_t now) {
                 "totalDurationOfLaggedPeriods"_attr = _isLaggedTimeMicros.load());
 
     _lastTargetTicketsPermitted.store(ret);
+    if (!ignoreWallTimes) {
+        _lastLagMillis = lagMillis;
+    }
 
     _trimSamples(
         std::min(lastCommitted.opTime.getTimestamp(), getMedianAppliedTimestamp(_prevMemberData)));
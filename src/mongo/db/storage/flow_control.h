@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <deque>
 
 #include "mongo/db/commands/server_status.h"
@@ -129,6 +130,22 @@ public:
                                    std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
+    /**
+     * Returns true if the commit point lag, extrapolated from its growth since the previous period,
+     * reaches `thresholdLagMillis` within `flowControlLagPredictionPeriods` periods.
+     */
+    static bool _lagPredictedToReachThreshold(std::uint64_t prevLagMillis,
+                                              std::uint64_t lagMillis,
+                                              std::uint64_t thresholdLagMillis);
+
+    /**
+     * When the dirty cache ratio is at or above `flowControlDirtyCacheThreshold`, caps `tickets` at
+     * the fudged number of tickets used in the last period. Otherwise returns `tickets`.
+     */
+    static int _limitTicketsForCachePressure(int tickets,
+                                             std::int64_t locksUsedLastPeriod,
+                                             boost::optional<double> dirtyCacheRatio);
+
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
     // observations of the corresponding counter at (roughly) <timestamp>.
     typedef std::tuple<std::uint64_t, std::uint64_t, std::int64_t> Sample;
@@ -137,6 +154,10 @@ public:
     }
 
 private:
+    boost::optional<double> _getDirtyCacheRatio() const;
+
+    // Null when constructed for testing, in which case the storage engine cache is not consulted.
+    ServiceContext* const _service = nullptr;
     repl::ReplicationCoordinator* _replCoord;
 
     // These values are updated with each flow control computation and are also surfaced in server
@@ -144,6 +165,7 @@ private:
     AtomicWord<int> _lastTargetTicketsPermitted{kMaxTickets};
     AtomicWord<double> _lastLocksPerOp{0.0};
     AtomicWord<int> _lastSustainerAppliedCount{0};
+    AtomicWord<double> _lastDirtyCacheRatio{0.0};
     AtomicWord<bool> _isLagged{false};
     AtomicWord<int> _isLaggedCount{0};
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
@@ -164,6 +186,8 @@ private:
 
     Date_t _lastTimeSustainerAdvanced;
 
+    std::uint64_t _lastLagMillis = 0;
+
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
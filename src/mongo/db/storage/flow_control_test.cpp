@@ -40,6 +40,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -249,6 +250,42 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, PredictingLag) {
+    const auto originalPeriods = gFlowControlLagPredictionPeriods.load();
+    ON_BLOCK_EXIT([&] { gFlowControlLagPredictionPeriods.store(originalPeriods); });
+    gFlowControlLagPredictionPeriods.store(3);
+
+    const std::uint64_t thresholdLag = 5000;
+    // Shrinking or steady lag is never predicted to reach the threshold.
+    ASSERT_FALSE(FlowControl::_lagPredictedToReachThreshold(4000, 3000, thresholdLag));
+    ASSERT_FALSE(FlowControl::_lagPredictedToReachThreshold(4000, 4000, thresholdLag));
+    // Growing by 500ms a period from 3000ms only reaches 4500ms after three more periods.
+    ASSERT_FALSE(FlowControl::_lagPredictedToReachThreshold(2500, 3000, thresholdLag));
+    // Growing by 1000ms a period from 3000ms reaches 6000ms.
+    ASSERT_TRUE(FlowControl::_lagPredictedToReachThreshold(2000, 3000, thresholdLag));
+
+    gFlowControlLagPredictionPeriods.store(0);
+    ASSERT_FALSE(FlowControl::_lagPredictedToReachThreshold(2000, 3000, thresholdLag));
+}
+
+TEST_F(FlowControlTest, LimitingTicketsForCachePressure) {
+    const auto originalThreshold = gFlowControlDirtyCacheThreshold.load();
+    ON_BLOCK_EXIT([&] { gFlowControlDirtyCacheThreshold.store(originalThreshold); });
+    gFlowControlDirtyCacheThreshold.store(0.15);
+    gFlowControlFudgeFactor.store(0.95);
+
+    // Without a reading, or below the threshold, the tickets are left alone.
+    ASSERT_EQ(5000, FlowControl::_limitTicketsForCachePressure(5000, 1000, boost::none));
+    ASSERT_EQ(5000, FlowControl::_limitTicketsForCachePressure(5000, 1000, 0.1));
+
+    // Above the threshold, tickets are capped at 95% of those used in the last period.
+    ASSERT_EQ(950, FlowControl::_limitTicketsForCachePressure(5000, 1000, 0.2));
+    ASSERT_EQ(500, FlowControl::_limitTicketsForCachePressure(500, 1000, 0.2));
+
+    gFlowControlDirtyCacheThreshold.store(0.0);
+    ASSERT_EQ(5000, FlowControl::_limitTicketsForCachePressure(5000, 1000, 0.2));
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
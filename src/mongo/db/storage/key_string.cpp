@@ -2546,9 +2546,24 @@ int compare(const char* leftBuf, const char* rightBuf, size_t leftSize, size_t r
     else if (MONGO_unlikely(rightSize == 0))
         return 1;
 
-    int min = std::min(leftSize, rightSize);
-
-    int cmp = memcmp(leftBuf, rightBuf, min);
+    size_t min = std::min(leftSize, rightSize);
+
+    // Most keys which differ do so within their leading bytes, e.g. in the type or the high order
+    // bytes of the first value. Decide those with a single big-endian word comparison instead of a
+    // call to memcmp, and leave long common prefixes, as found in compound keys, to memcmp which is
+    // vectorized.
+    int cmp;
+    if (min >= sizeof(uint64_t)) {
+        const auto leftWord = ConstDataView(leftBuf).read<BigEndian<uint64_t>>();
+        const auto rightWord = ConstDataView(rightBuf).read<BigEndian<uint64_t>>();
+        if (leftWord != rightWord) {
+            return leftWord < rightWord ? -1 : 1;
+        }
+        cmp = memcmp(
+            leftBuf + sizeof(uint64_t), rightBuf + sizeof(uint64_t), min - sizeof(uint64_t));
+    } else {
+        cmp = memcmp(leftBuf, rightBuf, min);
+    }
 
     if (cmp) {
         if (cmp < 0)
@@ -338,6 +338,11 @@ public:
         return _ksSize;
     }
 
+    // Returns the KeyString version this Value was encoded with.
+    Version getVersion() const {
+        return _version;
+    }
+
     // Returns whether the size of the stored KeyString is 0.
     bool isEmpty() const {
         return _ksSize == 0;
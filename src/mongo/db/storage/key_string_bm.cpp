@@ -65,6 +65,7 @@ enum BsonValueType {
     STRING,
     ARRAY,
     DECIMAL,
+    COMPOUND_STRING,
 };
 
 BSONObj generateBson(BsonValueType bsonValueType) {
@@ -92,6 +93,18 @@ BSONObj generateBson(BsonValueType bsonValueType) {
                                          Decimal128::kRoundTo34Digits,
                                          Decimal128::kRoundTiesToAway)
                                   .quantize(Decimal128("0.01", Decimal128::kRoundTiesToAway)));
+        case COMPOUND_STRING: {
+            // Keys of a compound index on five string fields, where adjacent keys mostly share
+            // their leading fields.
+            std::uniform_int_distribution<int> smallDist(0, 3);
+            BSONObjBuilder bob;
+            bob.append("", "tenant-" + std::to_string(smallDist(gen)));
+            bob.append("", "region-" + std::to_string(smallDist(gen)));
+            bob.append("", "category-" + std::to_string(smallDist(gen)));
+            bob.append("", std::string(expDist(gen) * kStrLenMultiplier, 'x'));
+            bob.append("", std::to_string(gen()));
+            return bob.obj();
+        }
     }
     MONGO_UNREACHABLE;
 }
@@ -175,6 +188,28 @@ void BM_KeyStringValueAssign(benchmark::State& state, BsonValueType bsonType) {
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+void BM_KeyStringCompare(benchmark::State& state, BsonValueType bsonType) {
+    // The KeyString version does not matter for this test.
+    const auto version = KeyString::Version::V1;
+    const BsonsAndKeyStrings bsonsAndKeyStrings = generateBsonsAndKeyStrings(bsonType, version);
+
+    // Pre-construct the values.
+    std::vector<KeyString::Value> values;
+    for (size_t i = 0; i < kSampleSize; i++) {
+        KeyString::HeapBuilder builder(version, bsonsAndKeyStrings.bsons[i], ALL_ASCENDING);
+        values.emplace_back(builder.release());
+    }
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (size_t i = 1; i < kSampleSize; i++) {
+            benchmark::DoNotOptimize(values[i - 1].compare(values[i]));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bsonsAndKeyStrings.keystringSize);
+    state.SetItemsProcessed(state.iterations() * (kSampleSize - 1));
+}
+
 void BM_KeyStringHeapBuilderRelease(benchmark::State& state, BsonValueType bsonType) {
     // The KeyString version does not matter for this test.
     const auto version = KeyString::Version::V1;
@@ -213,6 +248,13 @@ BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, String, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Array, ARRAY);
 
+BENCHMARK_CAPTURE(BM_KeyStringCompare, Int, INT);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, Double, DOUBLE);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, Decimal, DECIMAL);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, String, STRING);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, Array, ARRAY);
+BENCHMARK_CAPTURE(BM_KeyStringCompare, CompoundString, COMPOUND_STRING);
+
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringHeapBuilderRelease, Decimal, DECIMAL);
@@ -234,6 +276,7 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_CompoundString, KeyString::Version::V1, COMPOUND_STRING);
 
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
@@ -583,6 +583,24 @@ TEST_F(KeyStringBuilderTest, KeyStringValue) {
     ASSERT(data2.compare(dataCopy) == 0);
 }
 
+TEST_F(KeyStringBuilderTest, CompareOrdersBuffersByFirstDifferingByte) {
+    // Cover differences before, at and after the word boundary used by the comparison fast path,
+    // as well as buffers where one is a prefix of the other.
+    const size_t kMaxSize = 2 * sizeof(uint64_t) + 1;
+    for (size_t size = 1; size <= kMaxSize; ++size) {
+        std::vector<char> left(size, '\x7f');
+        for (size_t pos = 0; pos < size; ++pos) {
+            std::vector<char> right = left;
+            right[pos] = '\x80';
+            ASSERT_LT(KeyString::compare(left.data(), right.data(), size, size), 0);
+            ASSERT_GT(KeyString::compare(right.data(), left.data(), size, size), 0);
+        }
+        ASSERT_EQ(KeyString::compare(left.data(), left.data(), size, size), 0);
+        ASSERT_LT(KeyString::compare(left.data(), left.data(), size - 1, size), 0);
+        ASSERT_GT(KeyString::compare(left.data(), left.data(), size, size - 1), 0);
+    }
+}
+
 #define COMPARE_KS_BSON(ks, bson, order)                             \
     do {                                                             \
         const BSONObj _converted = toBsonAndCheckKeySize(ks, order); \
@@ -41,6 +41,7 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/devnull/devnull_kv_engine.h"
+#include "mongo/db/storage/durable_catalog_impl.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine_impl.h"
 #include "mongo/unittest/death_test.h"
@@ -163,6 +164,28 @@ private:
     RecordId _catalogId;
 };
 
+TEST_F(DurableCatalogTest, ColdStorageCollectionIdentsLiveInColdStorageDirectory) {
+    auto opCtx = newOperationContext();
+    const NamespaceString nss("unittests.durable_catalog_cold");
+
+    WriteUnitOfWork wuow(opCtx.get());
+    CollectionOptions options;
+    options.uuid = UUID::gen();
+    options.coldStorage = true;
+    auto swColl = getCatalog()->createCollection(
+        opCtx.get(), nss, options, true /* allocateDefaultSpace */);
+    ASSERT_OK(swColl.getStatus());
+
+    const auto ident = getCatalog()->getEntry(swColl.getValue().first).ident;
+    const auto coldPrefix = DurableCatalogImpl::kColdStorageDirectory.toString() + "/";
+    ASSERT(StringData(ident).startsWith(coldPrefix));
+
+    // Idents of collections without the option stay directly under the dbpath.
+    ASSERT_FALSE(StringData(getCatalog()->getEntry(getCatalogId()).ident)
+                     .startsWith(DurableCatalogImpl::kColdStorageDirectory));
+    wuow.commit();
+}
+
 TEST_F(DurableCatalogTest, MultikeyPathsForBtreeIndexInitializedToVectorOfEmptySets) {
     std::string indexName = createIndex(BSON("a" << 1 << "b" << 1));
     auto opCtx = newOperationContext();
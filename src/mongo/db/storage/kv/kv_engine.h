@@ -416,6 +416,22 @@ public:
         return false;
     }
 
+    /**
+     * Returns the size in bytes of the engine's cache, or boost::none if it doesn't keep
+     * uncommitted writes in a bounded cache.
+     */
+    virtual boost::optional<std::int64_t> getCacheSizeBytes() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns the fraction of the engine's cache occupied by dirty data, or boost::none if the
+     * engine doesn't track it.
+     */
+    virtual boost::optional<double> getDirtyCacheRatio() const {
+        return boost::none;
+    }
+
     /**
      * Methods to access the storage engine's timestamps.
      */
@@ -241,10 +241,25 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if this record store stores records under the RecordIds which the caller sets
+     * in the Records passed to insertRecords(), rather than choosing RecordIds itself.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Called when a new waiter for inserts into this capped record store is registered with its
+     * CappedCallback, so that a storage engine delaying the visibility of new records can stop
+     * delaying them.
+     */
+    virtual void onCappedWaiterAdded() {}
+
     /**
      * @param extraInfo - optional more debug info
      * @param level - optional, level of debug info to put in (higher is more)
@@ -337,6 +352,19 @@ public:
                                 const char* data,
                                 int len) = 0;
 
+    /**
+     * Same as updateRecord(), but with 'damages' describing the regions in which 'data' differs
+     * from the current version of the record. A record store may use them to modify the record in
+     * place rather than write all of it again. By default they are ignored.
+     */
+    virtual Status updateRecordWithDamages(OperationContext* opCtx,
+                                           const RecordId& recordId,
+                                           const char* data,
+                                           int len,
+                                           const mutablebson::ResizingDamageVector& damages) {
+        return updateRecord(opCtx, recordId, data, len);
+    }
+
     /**
      * @return Returns 'false' if this record store does not implement
      * 'updatewithDamages'. If this method returns false, 'updateWithDamages' must not be
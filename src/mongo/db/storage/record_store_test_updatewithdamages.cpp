@@ -290,5 +290,49 @@ TEST(RecordStoreTestHarness, UpdateWithNoDamages) {
     }
 }
 
+// Update a record with resizing damages describing where the new version differs.
+TEST(RecordStoreTestHarness, UpdateRecordWithResizingDamages) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    // Large enough for record stores to consider modifying the record rather than rewriting it.
+    const string data = string(1000, 'a') + string(10, 'b') + string(1000, 'c');
+    RecordId loc;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        loc = res.getValue();
+        uow.commit();
+    }
+
+    // Grow the middle of the record, and change one byte near its end.
+    string modifiedData = string(1000, 'a') + string(20, 'd') + string(1000, 'c');
+    modifiedData[2000] = 'e';
+    mutablebson::ResizingDamageVector damages(2);
+    damages[0].offset = 1000;
+    damages[0].sourceSize = 20;
+    damages[0].targetSize = 10;
+    damages[1].offset = 2000;
+    damages[1].sourceSize = 1;
+    damages[1].targetSize = 1;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->updateRecordWithDamages(
+            opCtx.get(), loc, modifiedData.c_str(), modifiedData.size() + 1, damages));
+        uow.commit();
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        RecordData record = rs->dataFor(opCtx.get(), loc);
+        ASSERT_EQUALS(static_cast<int>(modifiedData.size() + 1), record.size());
+        ASSERT_EQUALS(modifiedData, record.data());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
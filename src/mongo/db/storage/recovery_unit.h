@@ -326,6 +326,14 @@ public:
         return {};
     }
 
+    /**
+     * Returns the timestamp most recently set with setTimestamp() in the current transaction, if
+     * any.
+     */
+    virtual boost::optional<Timestamp> getLastTimestampSet() const {
+        return boost::none;
+    }
+
     /**
      * Returns the durable timestamp.
      */
@@ -45,10 +45,12 @@
 #include "mongo/db/storage/durable_catalog_feature_tracker.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/db/unclean_shutdown.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/scopeguard.h"
@@ -190,7 +192,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
         }
     }
 
-    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    std::vector<DurableCatalog::Entry> entriesToInit;
+    entriesToInit.reserve(catalogEntries.size());
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -229,19 +232,16 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
-
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
                   "Orphaned collection found: {namespace}",
                   "Orphaned collection found",
                   "namespace"_attr = entry.nss);
         }
+        entriesToInit.push_back(std::move(entry));
     }
 
-    KVPrefix::setLargestPrefix(maxSeenPrefix);
+    KVPrefix::setLargestPrefix(_initCollections(opCtx, entriesToInit));
     opCtx->recoveryUnit()->abandonSnapshot();
 
     // Unset the unclean shutdown flag to avoid executing special behavior if this method is called
@@ -249,6 +249,57 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
     startingAfterUncleanShutdown(getGlobalServiceContext()) = false;
 }
 
+KVPrefix StorageEngineImpl::_initCollections(OperationContext* opCtx,
+                                             const std::vector<DurableCatalog::Entry>& entries) {
+    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    auto initCollection = [&](OperationContext* initOpCtx, const DurableCatalog::Entry& entry) {
+        _initCollection(initOpCtx, entry.catalogId, entry.nss, _options.forRepair);
+        return _catalog->getMetaData(initOpCtx, entry.catalogId).getMaxPrefix();
+    };
+
+    const auto numWorkers =
+        std::min(static_cast<size_t>(gStorageEngineCatalogLoadConcurrency), entries.size());
+    if (numWorkers <= 1) {
+        for (const auto& entry : entries) {
+            maxSeenPrefix = std::max(maxSeenPrefix, initCollection(opCtx, entry));
+        }
+        return maxSeenPrefix;
+    }
+
+    // Opening a record store reads its metadata and sizes from the storage engine, which adds up to
+    // minutes of startup time for catalogs with many collections. The workers don't take any locks
+    // on behalf of 'opCtx', which already holds whatever the caller needs.
+    auto mutex = MONGO_MAKE_LATCH("StorageEngineImpl::_initCollections::mutex");
+    Status status = Status::OK();
+    AtomicWord<size_t> nextEntry{0};
+    std::vector<stdx::thread> workers;
+    for (size_t i = 0; i < numWorkers; ++i) {
+        workers.emplace_back([&] {
+            OperationContextNoop workerOpCtx(_engine->newRecoveryUnit());
+            for (auto next = nextEntry.fetchAndAdd(1); next < entries.size();
+                 next = nextEntry.fetchAndAdd(1)) {
+                try {
+                    auto prefix = initCollection(&workerOpCtx, entries[next]);
+                    stdx::lock_guard<Latch> lk(mutex);
+                    maxSeenPrefix = std::max(maxSeenPrefix, prefix);
+                } catch (const DBException& ex) {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (status.isOK()) {
+                        status = ex.toStatus();
+                    }
+                    nextEntry.store(entries.size());
+                }
+            }
+            workerOpCtx.recoveryUnit()->abandonSnapshot();
+        });
+    }
+    for (auto&& worker : workers) {
+        worker.join();
+    }
+    uassertStatusOK(status);
+    return maxSeenPrefix;
+}
+
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
@@ -270,7 +321,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
-    auto uuid = _catalog->getCollectionOptions(opCtx, catalogId).uuid.get();
+    auto uuid = *md.options.uuid;
 
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, uuid, std::move(rs));
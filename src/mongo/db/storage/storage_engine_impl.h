@@ -350,6 +350,13 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
+    /**
+     * Initializes the collections of 'entries' on up to 'storageEngineCatalogLoadConcurrency'
+     * threads and returns the largest KVPrefix they use.
+     */
+    KVPrefix _initCollections(OperationContext* opCtx,
+                              const std::vector<DurableCatalog::Entry>& entries);
+
     void _initCollection(OperationContext* opCtx,
                          RecordId catalogId,
                          const NamespaceString& nss,
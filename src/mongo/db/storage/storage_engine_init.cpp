@@ -36,8 +36,10 @@
 #include <map>
 #include <memory>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/control/storage_control.h"
@@ -303,6 +305,10 @@ void appendStorageEngineList(ServiceContext* service, BSONObjBuilder* result) {
 
 namespace {
 
+// The LockerImpl of the client's previous operation, kept so that the next operation can reuse it
+// instead of allocating and initializing a new one.
+const auto getSpareLocker = Client::declareDecoration<std::unique_ptr<LockerImpl>>();
+
 class StorageClientObserver final : public ServiceContext::ClientObserver {
 public:
     void onCreateClient(Client* client) override{};
@@ -320,11 +326,23 @@ public:
         if (!storageEngine) {
             return;
         }
-        opCtx->setLockState(std::make_unique<LockerImpl>());
+        if (auto& spareLocker = getSpareLocker(opCtx->getClient())) {
+            spareLocker->resetForReuse();
+            opCtx->setLockState(std::move(spareLocker));
+        } else {
+            opCtx->setLockState(std::make_unique<LockerImpl>());
+        }
         opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(storageEngine->newRecoveryUnit()),
                                WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
     }
-    void onDestroyOperationContext(OperationContext* opCtx) {}
+    void onDestroyOperationContext(OperationContext* opCtx) {
+        // Only keep lockers of our own type, not ones that tests or other components swapped in.
+        if (!dynamic_cast<LockerImpl*>(opCtx->lockState())) {
+            return;
+        }
+        auto& spareLocker = getSpareLocker(opCtx->getClient());
+        spareLocker.reset(checked_cast<LockerImpl*>(opCtx->releaseLockState().release()));
+    }
 };
 
 ServiceContext::ConstructorActionRegisterer registerStorageClientObserverConstructor{
@@ -40,16 +40,19 @@ class WiredTigerGlobalOptions {
 public:
     WiredTigerGlobalOptions()
         : cacheSizeGB(0),
+          compressedCacheSizeGB(0),
           checkpointDelaySecs(0),
           statisticsLogDelaySecs(0),
           directoryForIndexes(false),
           maxCacheOverflowFileSizeGBDeprecated(0),
           useCollectionPrefixCompression(false),
-          useIndexPrefixCompression(false){};
+          useIndexPrefixCompression(false),
+          indexPrefixCompressionMin(4){};
 
     Status store(const optionenvironment::Environment& params);
 
     double cacheSizeGB;
+    double compressedCacheSizeGB;
     size_t checkpointDelaySecs;
     size_t statisticsLogDelaySecs;
     std::string journalCompressor;
@@ -61,6 +64,7 @@ public:
     std::string indexBlockCompressor;
     bool useCollectionPrefixCompression;
     bool useIndexPrefixCompression;
+    int indexPrefixCompressionMin;
     std::string collectionConfig;
     std::string indexConfig;
 
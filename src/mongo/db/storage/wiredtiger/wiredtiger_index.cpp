@@ -48,6 +48,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -174,6 +175,8 @@ StatusWith<std::string> WiredTigerIndex::generateCreateString(
     ss << "checksum=on,";
     if (wiredTigerGlobalOptions.useIndexPrefixCompression) {
         ss << "prefix_compression=true,";
+        ss << "prefix_compression_min=" << wiredTigerGlobalOptions.indexPrefixCompressionMin
+           << ",";
     }
 
     ss << "block_compressor=" << wiredTigerGlobalOptions.indexBlockCompressor << ",";
@@ -1369,7 +1372,14 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
                                              const IndexDescriptor* desc,
                                              KVPrefix prefix,
                                              bool isReadOnly)
-    : WiredTigerIndex(ctx, uri, desc, prefix, isReadOnly), _partial(desc->isPartial()) {}
+    : WiredTigerIndex(ctx, uri, desc, prefix, isReadOnly), _partial(desc->isPartial()) {
+    // Only the timestamp safe format searches the index for duplicates on insert.
+    if (gWiredTigerUniqueIndexKeyFilterBitsPerKey > 0 && !isReadOnly && !prefix.isPrefixed() &&
+        isTimestampSafeUniqueIdx()) {
+        _keyFilter = std::make_unique<WiredTigerUniqueIndexKeyFilter>(
+            uri, gWiredTigerUniqueIndexKeyFilterBitsPerKey);
+    }
+}
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
     OperationContext* opCtx, bool forward) const {
@@ -1378,9 +1388,24 @@ std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
 
 SortedDataBuilderInterface* WiredTigerIndexUnique::getBulkBuilder(OperationContext* opCtx,
                                                                   bool dupsAllowed) {
+    // The bulk builder writes keys straight into the table, so the key filter cannot see them.
+    if (_keyFilter) {
+        _keyFilter->disable();
+    }
     return new UniqueBulkBuilder(this, opCtx, dupsAllowed, _prefix);
 }
 
+bool WiredTigerIndexUnique::appendCustomStats(OperationContext* opCtx,
+                                              BSONObjBuilder* output,
+                                              double scale) const {
+    WiredTigerIndex::appendCustomStats(opCtx, output, scale);
+    if (_keyFilter) {
+        BSONObjBuilder keyFilter(output->subobjStart("keyFilter"));
+        _keyFilter->appendStats(&keyFilter);
+    }
+    return true;
+}
+
 bool WiredTigerIndexUnique::isTimestampSafeUniqueIdx() const {
     if (_dataFormatVersion == kDataFormatV1KeyStringV0IndexVersionV1 ||
         _dataFormatVersion == kDataFormatV2KeyStringV1IndexVersionV2) {
@@ -1433,6 +1458,16 @@ bool WiredTigerIndexUnique::_keyExists(OperationContext* opCtx,
     return std::memcmp(buffer, item.data, std::min(size, item.size)) == 0;
 }
 
+bool WiredTigerIndexUnique::_keyMayExist(OperationContext* opCtx,
+                                         const char* buffer,
+                                         size_t size) {
+    if (!_keyFilter) {
+        return true;
+    }
+    _keyFilter->startLoading(WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->conn());
+    return _keyFilter->testAndAdd(buffer, size);
+}
+
 bool WiredTigerIndexUnique::isDup(OperationContext* opCtx,
                                   WT_CURSOR* c,
                                   const KeyString::Value& prefixKey) {
@@ -1568,12 +1603,16 @@ Status WiredTigerIndexUnique::_insertTimestampSafe(OperationContext* opCtx,
 
     int ret;
 
+    // A prefix key is KeyString of index key. It is the component of the index entry that should
+    // be unique.
+    auto sizeWithoutRecordId =
+        KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize());
+
+    // The key filter must see every key, including those inserted where duplicates are allowed.
+    const bool keyMayExist = _keyMayExist(opCtx, keyString.getBuffer(), sizeWithoutRecordId);
+
     // Pre-checks before inserting on a primary.
     if (!dupsAllowed) {
-        // A prefix key is KeyString of index key. It is the component of the index entry that
-        // should be unique.
-        auto sizeWithoutRecordId =
-            KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize());
         WiredTigerItem prefixKeyItem(keyString.getBuffer(), sizeWithoutRecordId);
 
         // First phase inserts the prefix key to prohibit concurrent insertions of same key
@@ -1601,8 +1640,9 @@ Status WiredTigerIndexUnique::_insertTimestampSafe(OperationContext* opCtx,
         ret = WT_OP_CHECK(c->remove(c));
         invariantWTOK(ret);
 
-        // Second phase looks up for existence of key to avoid insertion of duplicate key
-        if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
+        // Second phase looks up for existence of key to avoid insertion of duplicate key. A
+        // concurrent insert of the same key that the key filter missed conflicts in the first.
+        if (keyMayExist && _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
             auto key = KeyString::toBson(
                 keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
             auto entry = _desc->getEntry();
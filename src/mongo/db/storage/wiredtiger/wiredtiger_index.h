@@ -38,6 +38,7 @@
 #include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
 
 namespace mongo {
 
@@ -208,6 +209,10 @@ public:
 
     bool isDup(OperationContext* opCtx, WT_CURSOR* c, const KeyString::Value& keyString) override;
 
+    bool appendCustomStats(OperationContext* opCtx,
+                           BSONObjBuilder* output,
+                           double scale) const override;
+
     Status _insert(OperationContext* opCtx,
                    WT_CURSOR* c,
                    const KeyString::Value& keyString,
@@ -244,7 +249,15 @@ private:
      */
     bool _keyExists(OperationContext* opCtx, WT_CURSOR* c, const char* buffer, size_t size);
 
+    /**
+     * Records in the key filter, if there is one, that the index holds the prefix key in 'buffer'.
+     * Returns false only if the index definitely did not hold it before.
+     */
+    bool _keyMayExist(OperationContext* opCtx, const char* buffer, size_t size);
+
     bool _partial;
+
+    std::unique_ptr<WiredTigerUniqueIndexKeyFilter> _keyFilter;
 };
 
 class WiredTigerIndexStandard : public WiredTigerIndex {
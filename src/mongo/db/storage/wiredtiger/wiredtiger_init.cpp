@@ -88,15 +88,24 @@ public:
         }
 #endif
 
-        size_t cacheMB = WiredTigerUtil::getCacheSizeMB(wiredTigerGlobalOptions.cacheSizeGB);
+        size_t cacheMB = WiredTigerUtil::getCacheSizeMB(
+            wiredTigerGlobalOptions.cacheSizeGB, wiredTigerGlobalOptions.compressedCacheSizeGB);
         const double memoryThresholdPercentage = 0.8;
         ProcessInfo p;
         if (p.supported()) {
+            const double compressedCacheMB = 1024 * wiredTigerGlobalOptions.compressedCacheSizeGB;
             if (cacheMB > memoryThresholdPercentage * p.getMemSizeMB()) {
                 LOGV2_OPTIONS(22300,
                               {logv2::LogTag::kStartupWarnings},
                               "The configured WiredTiger cache size is more than 80% of available "
                               "RAM. See http://dochub.mongodb.org/core/faq-memory-diagnostics-wt");
+            } else if (cacheMB + compressedCacheMB > memoryThresholdPercentage * p.getMemSizeMB()) {
+                LOGV2_OPTIONS(5151900,
+                              {logv2::LogTag::kStartupWarnings},
+                              "The configured WiredTiger cache and compressed cache sizes together "
+                              "are more than 80% of available RAM",
+                              "cacheSizeMB"_attr = cacheMB,
+                              "compressedCacheSizeMB"_attr = compressedCacheMB);
             }
         }
         const bool ephemeral = false;
@@ -86,6 +86,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
@@ -482,8 +483,113 @@ private:
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+
+// The ticket pool sizes last set through the server parameters. Adaptive concurrency control
+// never grows a pool beyond its configured size.
+AtomicWord<int> configuredWriteTransactions{128};
+AtomicWord<int> configuredReadTransactions{128};
+
+// Number of times adaptive concurrency control has shrunk or grown a ticket pool.
+AtomicWord<long long> ticketPoolDecreases{0};
+AtomicWord<long long> ticketPoolIncreases{0};
+
+/**
+ * Returns the size a ticket pool of 'current' tickets should have next. The pool is halved when
+ * application threads had to do eviction since the last adjustment, and otherwise grows by a
+ * sixteenth of 'configured', always staying between 'minimum' and 'configured'.
+ */
+int adaptiveTicketPoolSize(int current, int configured, int minimum, bool evictionPressure) {
+    minimum = std::min(minimum, configured);
+    const int next = evictionPressure ? current / 2 : current + std::max(1, configured / 16);
+    return std::max(minimum, std::min(configured, next));
+}
+
+void adjustTicketPool(TicketHolder* holder, int configured, bool evictionPressure) {
+    const int current = holder->outof();
+    const int next = gWiredTigerAdaptiveConcurrentTransactions.load()
+        ? adaptiveTicketPoolSize(current,
+                                 configured,
+                                 gWiredTigerAdaptiveConcurrentTransactionsMinimum.load(),
+                                 evictionPressure)
+        : configured;
+    if (next == current) {
+        return;
+    }
+
+    // Shrinking waits for tickets to be returned, which only delays the next adjustment.
+    if (holder->resize(next).isOK()) {
+        (next < current ? ticketPoolDecreases : ticketPoolIncreases).fetchAndAdd(1);
+    }
+}
 }  // namespace
 
+/**
+ * Periodically resizes the transaction ticket pools according to WiredTiger cache pressure, or
+ * restores their configured sizes when adaptive concurrency control is disabled.
+ */
+class WiredTigerKVEngine::WiredTigerTicketAdjuster : public BackgroundJob {
+public:
+    explicit WiredTigerTicketAdjuster(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTTicketAdjuster";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(5155004, 1, "starting {name} thread", "name"_attr = name());
+
+        WiredTigerSession session(_conn);
+        boost::optional<int64_t> lastAppEvictions;
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::seconds(1));
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            // Application threads only evict pages once the eviction workers can't keep the
+            // cache below its trigger, which is when extra concurrency makes things worse.
+            auto appEvictions = WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                                                   "statistics:",
+                                                                   "statistics=(fast)",
+                                                                   WT_STAT_CONN_CACHE_EVICTION_APP);
+            if (!appEvictions.isOK()) {
+                continue;
+            }
+            const bool evictionPressure =
+                lastAppEvictions && appEvictions.getValue() > *lastAppEvictions;
+            lastAppEvictions = appEvictions.getValue();
+
+            adjustTicketPool(
+                &openWriteTransaction, configuredWriteTransactions.load(), evictionPressure);
+            adjustTicketPool(
+                &openReadTransaction, configuredReadTransactions.load(), evictionPressure);
+        }
+        LOGV2_DEBUG(5155005, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    WT_CONNECTION* _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketAdjuster::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+};
+
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
     : ServerParameter(name, spt), _data(&openWriteTransaction) {}
 
@@ -502,7 +608,11 @@ Status OpenWriteTransactionParam::setFromString(const std::string& str) {
     if (num <= 0) {
         return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
     }
-    return _data->resize(num);
+    Status resized = _data->resize(num);
+    if (resized.isOK()) {
+        configuredWriteTransactions.store(num);
+    }
+    return resized;
 }
 
 OpenReadTransactionParam::OpenReadTransactionParam(StringData name, ServerParameterType spt)
@@ -523,7 +633,11 @@ Status OpenReadTransactionParam::setFromString(const std::string& str) {
     if (num <= 0) {
         return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
     }
-    return _data->resize(num);
+    Status resized = _data->resize(num);
+    if (resized.isOK()) {
+        configuredReadTransactions.store(num);
+    }
+    return resized;
 }
 
 StringData WiredTigerKVEngine::kTableUriPrefix = "table:"_sd;
@@ -543,6 +657,7 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
       _canonicalName(canonicalName),
       _path(path),
       _sizeStorerSyncTracker(cs, 100000, Seconds(60)),
+      _cacheSizeBytes(static_cast<std::int64_t>(cacheSizeMB) * 1024 * 1024),
       _durable(durable),
       _ephemeral(ephemeral),
       _inRepairMode(repair),
@@ -766,6 +881,9 @@ void WiredTigerKVEngine::startAsyncThreads() {
             _checkpointThread->go();
         }
     }
+
+    _ticketAdjuster = std::make_unique<WiredTigerTicketAdjuster>(_conn);
+    _ticketAdjuster->go();
 }
 
 void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
@@ -784,6 +902,13 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("totalTickets", openReadTransaction.outof());
         bbb.done();
     }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("adaptive"));
+        bbb.append("enabled", gWiredTigerAdaptiveConcurrentTransactions.load());
+        bbb.append("decreases", ticketPoolDecreases.load());
+        bbb.append("increases", ticketPoolIncreases.load());
+        bbb.done();
+    }
     bb.done();
 }
 
@@ -876,6 +1001,9 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_ticketAdjuster) {
+        _ticketAdjuster->shutdown();
+    }
     if (_checkpointThread) {
         LOGV2(22322, "Shutting down checkpoint thread");
         _checkpointThread->shutdown();
@@ -1622,6 +1750,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
     params.tracksSizeAdjustments = true;
+    params.isClustered = options.clustered;
 
     params.cappedMaxSize = -1;
     if (options.capped) {
@@ -2363,6 +2492,20 @@ bool WiredTigerKVEngine::supportsReadConcernMajority() const {
     return _keepDataHistory;
 }
 
+boost::optional<double> WiredTigerKVEngine::getDirtyCacheRatio() const {
+    if (_cacheSizeBytes <= 0) {
+        return boost::none;
+    }
+
+    WiredTigerSession session(_conn);
+    auto dirtyBytes = WiredTigerUtil::getStatisticsValue(
+        session.getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!dirtyBytes.isOK()) {
+        return boost::none;
+    }
+    return static_cast<double>(dirtyBytes.getValue()) / _cacheSizeBytes;
+}
+
 bool WiredTigerKVEngine::supportsOplogStones() const {
     return true;
 }
@@ -273,6 +273,12 @@ public:
 
     bool supportsOplogStones() const final override;
 
+    boost::optional<std::int64_t> getCacheSizeBytes() const override {
+        return _cacheSizeBytes;
+    }
+
+    boost::optional<double> getDirtyCacheRatio() const override;
+
     bool supportsReadConcernMajority() const final;
 
     // wiredtiger specific
@@ -365,6 +371,7 @@ public:
 private:
     class WiredTigerSessionSweeper;
     class WiredTigerCheckpointThread;
+    class WiredTigerTicketAdjuster;
 
     /**
      * Opens a connection on the WiredTiger database 'path' with the configuration 'wtOpenConfig'.
@@ -440,6 +447,8 @@ private:
     std::string _sizeStorerUri;
     mutable ElapsedTracker _sizeStorerSyncTracker;
 
+    const std::int64_t _cacheSizeBytes;
+
     bool _durable;
     bool _ephemeral;  // whether we are using the in-memory mode of the WT engine
     const bool _inRepairMode;
@@ -454,6 +463,7 @@ private:
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerTicketAdjuster> _ticketAdjuster;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -108,6 +108,13 @@ void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
     }
 }
 
+void WiredTigerOplogManager::wakeUpForCappedWaiters() {
+    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    if (_triggerOplogVisibilityUpdate) {
+        _oplogVisibilityThreadCV.notify_one();
+    }
+}
+
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     const WiredTigerRecordStore* oplogRecordStore, OperationContext* opCtx) {
     invariant(opCtx->lockState()->isNoop() || !opCtx->lockState()->inAWriteUnitOfWork());
@@ -139,6 +146,9 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     ++_opsWaitingForOplogVisibilityUpdate;
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
+    if (_triggerOplogVisibilityUpdate) {
+        _oplogVisibilityThreadCV.notify_one();
+    }
 
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
@@ -198,13 +208,10 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
                     oplogRecordStore->haveCappedWaiters();
             };
 
-            // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
-            while (now < deadline &&
-                   !_oplogVisibilityThreadCV.wait_until(
-                       lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
-                now += Milliseconds(1);
-            }
+            // Callers waiting for visibility, new capped waiters on the oplog and shutdown all
+            // signal the condition variable, so the delay is preempted as soon as one occurs.
+            _oplogVisibilityThreadCV.wait_until(
+                lk, deadline.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate);
         }
 
         while (!_shuttingDown && MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
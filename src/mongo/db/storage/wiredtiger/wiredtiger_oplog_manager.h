@@ -79,6 +79,12 @@ public:
      */
     void triggerOplogVisibilityUpdate();
 
+    /**
+     * Cuts short any delay of a scheduled oplog visibility update, because a capped waiter on the
+     * oplog is now waiting for new entries to become visible.
+     */
+    void wakeUpForCappedWaiters();
+
     /**
      * Waits for all committed writes at this time to become visible (that is, until no holes exist
      * in the oplog up to the time we start waiting.)
@@ -112,7 +118,8 @@ private:
 
     stdx::thread _oplogVisibilityThread;
 
-    // Signaled to trigger the oplog visibility thread to run.
+    // Signaled to trigger the oplog visibility thread to run, and whenever the conditions for
+    // cutting short the batching delay of a scheduled update may have changed.
     mutable stdx::condition_variable _oplogVisibilityThreadCV;
 
     // Signaled when oplog visibility has been updated.
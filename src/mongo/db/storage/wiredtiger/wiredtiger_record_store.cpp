@@ -57,6 +57,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -260,11 +261,19 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 }
 
 bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
+    if (_stones.empty()) {
+        return false;
+    }
+
     int64_t totalBytes = 0;
     for (auto&& stone : _stones) {
         totalBytes += stone.bytes;
     }
+    return _isExcessStone_inlock(_stones.front(), totalBytes);
+}
 
+bool WiredTigerRecordStore::OplogStones::_isExcessStone_inlock(const Stone& stone,
+                                                               int64_t totalBytes) const {
     // check that oplog stones is at capacity
     if (totalBytes <= _rs->cappedMaxSize()) {
         return false;
@@ -279,27 +288,69 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
     }
 
     auto nowWall = Date_t::now();
-    auto lastStoneWall = _stones.front().wallTime;
+    auto lastStoneWall = stone.wallTime;
 
     auto currRetentionMS = durationCount<Milliseconds>(nowWall - lastStoneWall);
     double currRetentionHours = currRetentionMS / kNumMSInHour;
     return currRetentionHours >= minRetentionHours;
 }
 
-boost::optional<WiredTigerRecordStore::OplogStones::Stone>
-WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
+void WiredTigerRecordStore::OplogStones::getOplogStonesStats(BSONObjBuilder& builder) const {
+    builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
+    builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+    if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
+        builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
+    }
+
+    // Report how far truncation is behind: the stones, and the bytes they hold, which are in
+    // excess of the configured oplog size and retention and still waiting to be truncated.
     stdx::lock_guard<Latch> lk(_mutex);
+    int64_t totalBytes = 0;
+    for (auto&& stone : _stones) {
+        totalBytes += stone.bytes;
+    }
 
-    if (!hasExcessStones_inlock()) {
-        return {};
+    long long excessStones = 0;
+    long long excessBytes = 0;
+    for (auto&& stone : _stones) {
+        if (!_isExcessStone_inlock(stone, totalBytes)) {
+            break;
+        }
+        excessStones++;
+        excessBytes += stone.bytes;
+        totalBytes -= stone.bytes;
+    }
+    builder.append("excessStones", excessStones);
+    builder.append("excessBytes", excessBytes);
+}
+
+std::vector<WiredTigerRecordStore::OplogStones::Stone>
+WiredTigerRecordStore::OplogStones::peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo,
+                                                             size_t maxStones) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    int64_t totalBytes = 0;
+    for (auto&& stone : _stones) {
+        totalBytes += stone.bytes;
     }
 
-    return _stones.front();
+    std::vector<Stone> stones;
+    for (auto&& stone : _stones) {
+        invariant(stone.lastRecord.isValid());
+        if (stones.size() >= maxStones || !_isExcessStone_inlock(stone, totalBytes) ||
+            static_cast<std::uint64_t>(stone.lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
+            break;
+        }
+        stones.push_back(stone);
+        totalBytes -= stone.bytes;
+    }
+    return stones;
 }
 
-void WiredTigerRecordStore::OplogStones::popOldestStone() {
+void WiredTigerRecordStore::OplogStones::popOldestStones(size_t numStones) {
     stdx::lock_guard<Latch> lk(_mutex);
-    _stones.pop_front();
+    invariant(numStones <= _stones.size());
+    _stones.erase(_stones.begin(), _stones.begin() + numStones);
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -810,6 +861,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                     getGlobalReplSettings().usingReplSets() ||
                         repl::ReplSettings::shouldRecoverFromOplogAsStandalone())),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isClustered(params.isClustered),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -912,8 +964,8 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
                            "ident"_attr = _ident);
         sizeRecoveryState(getGlobalServiceContext())
             .markCollectionAsAlwaysNeedsSizeAdjustment(_ident);
-        _sizeInfo->dataSize.store(0);
-        _sizeInfo->numRecords.store(0);
+        _sizeInfo->setDataSize(0);
+        _sizeInfo->setNumRecords(0);
     }
 
     if (_sizeStorer)
@@ -950,11 +1002,11 @@ bool WiredTigerRecordStore::inShutdown() const {
 }
 
 long long WiredTigerRecordStore::dataSize(OperationContext* opCtx) const {
-    return _sizeInfo->dataSize.load();
+    return _sizeInfo->getDataSize();
 }
 
 long long WiredTigerRecordStore::numRecords(OperationContext* opCtx) const {
-    return _sizeInfo->numRecords.load();
+    return _sizeInfo->getNumRecords();
 }
 
 bool WiredTigerRecordStore::isCapped() const {
@@ -1068,10 +1120,10 @@ bool WiredTigerRecordStore::cappedAndNeedDelete() const {
     if (!_isCapped)
         return false;
 
-    if (_sizeInfo->dataSize.load() >= _cappedMaxSize)
+    if (_sizeInfo->getDataSize() >= _cappedMaxSize)
         return true;
 
-    if ((_cappedMaxDocs != -1) && (_sizeInfo->numRecords.load() > _cappedMaxDocs))
+    if ((_cappedMaxDocs != -1) && (_sizeInfo->getNumRecords() > _cappedMaxDocs))
         return true;
 
     return false;
@@ -1121,7 +1173,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
         if (!lock.try_lock()) {
             // Someone else is deleting old records. Apply back-pressure if too far behind,
             // otherwise continue.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < _cappedMaxSizeSlack)
+            if ((_sizeInfo->getDataSize() - _cappedMaxSize) < _cappedMaxSizeSlack)
                 return 0;
 
             // Don't wait forever: we're in a transaction, we could block eviction.
@@ -1136,7 +1188,7 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded(OperationContext* opCtx,
 
             // If we already waited, let someone else do cleanup unless we are significantly
             // over the limit.
-            if ((_sizeInfo->dataSize.load() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
+            if ((_sizeInfo->getDataSize() - _cappedMaxSize) < (2 * _cappedMaxSizeSlack))
                 return 0;
         }
     }
@@ -1189,10 +1241,18 @@ int64_t WiredTigerRecordStore::_cappedDeleteAsNeeded_inlock(OperationContext* op
 
     WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
 
-    int64_t dataSize = _sizeInfo->dataSize.load();
-    int64_t numRecords = _sizeInfo->numRecords.load();
+    int64_t dataSize = _sizeInfo->getDataSize();
+    int64_t numRecords = _sizeInfo->getNumRecords();
+
+    // Without a maximum number of documents, delete down to below the maximum size so that the
+    // next inserts have room and don't each need a side transaction to delete a record or two.
+    int64_t sizeTarget = _cappedMaxSize;
+    if (_cappedMaxDocs == -1) {
+        sizeTarget -= static_cast<int64_t>(_cappedMaxSize *
+                                           gWiredTigerCappedDeleteBatchFraction.load());
+    }
 
-    int64_t sizeOverCap = (dataSize > _cappedMaxSize) ? dataSize - _cappedMaxSize : 0;
+    int64_t sizeOverCap = (dataSize > _cappedMaxSize) ? dataSize - sizeTarget : 0;
     int64_t sizeSaved = 0;
     int64_t docsOverCap = 0, docsRemoved = 0;
     if (_cappedMaxDocs != -1 && numRecords > _cappedMaxDocs)
@@ -1362,12 +1422,19 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     Timer timer;
-    while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
-        invariant(stone->lastRecord.isValid());
-
-        if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
-            // Do not truncate oplogs needed for replication recovery.
-            return;
+    // When truncation has fallen behind, remove all of the excess stones up to the batch size with
+    // a single range truncate, rather than paying for a separate truncate and transaction per
+    // stone. Stones needed for replication recovery are never returned.
+    const auto maxStonesPerBatch = static_cast<size_t>(gOplogTruncationMaxStonesPerBatch.load());
+    for (auto stones = _oplogStones->peekOldestStonesIfNeeded(mayTruncateUpTo, maxStonesPerBatch);
+         !stones.empty();
+         stones = _oplogStones->peekOldestStonesIfNeeded(mayTruncateUpTo, maxStonesPerBatch)) {
+        // Merge the stones into a single one spanning the whole range to truncate.
+        auto stone = stones.front();
+        for (size_t i = 1; i < stones.size(); ++i) {
+            stone.records += stones[i].records;
+            stone.bytes += stones[i].bytes;
+            stone.lastRecord = stones[i].lastRecord;
         }
 
         LOGV2_DEBUG(
@@ -1376,9 +1443,10 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             "Truncating the oplog between {oplogStones_firstRecord} and {stone_lastRecord} to "
             "remove approximately {stone_records} records totaling to {stone_bytes} bytes",
             "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
-            "stone_lastRecord"_attr = stone->lastRecord,
-            "stone_records"_attr = stone->records,
-            "stone_bytes"_attr = stone->bytes);
+            "stone_lastRecord"_attr = stone.lastRecord,
+            "stone_records"_attr = stone.records,
+            "stone_bytes"_attr = stone.bytes,
+            "numStones"_attr = stones.size());
 
         WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
         WT_SESSION* session = ru->getSession()->getSession();
@@ -1393,28 +1461,28 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
             invariantWTOK(ret);
             RecordId firstRecord = getKey(cursor);
-            if (firstRecord < _oplogStones->firstRecord || firstRecord > stone->lastRecord) {
+            if (firstRecord < _oplogStones->firstRecord || firstRecord > stone.lastRecord) {
                 LOGV2_WARNING(22407,
                               "First oplog record {firstRecord} is not in truncation range "
                               "({oplogStones_firstRecord}, {stone_lastRecord})",
                               "firstRecord"_attr = firstRecord,
                               "oplogStones_firstRecord"_attr = _oplogStones->firstRecord,
-                              "stone_lastRecord"_attr = stone->lastRecord);
+                              "stone_lastRecord"_attr = stone.lastRecord);
             }
 
-            setKey(cursor, stone->lastRecord);
+            setKey(cursor, stone.lastRecord);
             invariantWTOK(session->truncate(session, nullptr, nullptr, cursor, nullptr));
-            _changeNumRecords(opCtx, -stone->records);
-            _increaseDataSize(opCtx, -stone->bytes);
+            _changeNumRecords(opCtx, -stone.records);
+            _increaseDataSize(opCtx, -stone.bytes);
 
             wuow.commit();
 
-            // Remove the stone after a successful truncation.
-            _oplogStones->popOldestStone();
+            // Remove the stones after a successful truncation.
+            _oplogStones->popOldestStones(stones.size());
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
-            _oplogStones->firstRecord = stone->lastRecord;
-            _cappedFirstRecord = stone->lastRecord;
+            _oplogStones->firstRecord = stone.lastRecord;
+            _cappedFirstRecord = stone.lastRecord;
         } catch (const WriteConflictException&) {
             LOGV2_DEBUG(
                 22400, 1, "Caught WriteConflictException while truncating oplog entries, retrying");
@@ -1425,8 +1493,8 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
                 1,
                 "Finished truncating the oplog, it now contains approximately "
                 "{sizeInfo_numRecords_load} records totaling to {sizeInfo_dataSize_load} bytes",
-                "sizeInfo_numRecords_load"_attr = _sizeInfo->numRecords.load(),
-                "sizeInfo_dataSize_load"_attr = _sizeInfo->dataSize.load());
+                "sizeInfo_numRecords_load"_attr = _sizeInfo->getNumRecords(),
+                "sizeInfo_dataSize_load"_attr = _sizeInfo->getDataSize());
     auto elapsedMicros = timer.micros();
     auto elapsedMillis = elapsedMicros / 1000;
     _totalTimeTruncating.fetchAndAdd(elapsedMicros);
@@ -1475,6 +1543,13 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
+        } else if (_isClustered) {
+            // The caller keys each record, in no particular order.
+            invariant(record.id.isNormal());
+            if (record.id > highestIdRecord.id) {
+                highestIdRecord = record;
+            }
+            continue;
         } else {
             record.id = _nextId(opCtx);
         }
@@ -1482,6 +1557,8 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         highestIdRecord = record;
     }
 
+    // Batches commonly share one timestamp, so only timestamp the transaction when it changes.
+    Timestamp lastTs;
     for (size_t i = 0; i < nRecords; i++) {
         auto& record = records[i];
         Timestamp ts;
@@ -1497,9 +1574,10 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         } else {
             ts = timestamps[i];
         }
-        if (!ts.isNull()) {
+        if (!ts.isNull() && ts != lastTs) {
             LOGV2_DEBUG(22403, 4, "inserting record with timestamp {ts}", "ts"_attr = ts);
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
+            lastTs = ts;
         }
         setKey(c, record.id);
         WiredTigerItem value(record.data.data(), record.data.size());
@@ -1534,6 +1612,12 @@ bool WiredTigerRecordStore::haveCappedWaiters() {
     return _cappedCallback && _cappedCallback->haveCappedWaiters();
 }
 
+void WiredTigerRecordStore::onCappedWaiterAdded() {
+    if (_isOplog) {
+        _kvEngine->getOplogManager()->wakeUpForCappedWaiters();
+    }
+}
+
 void WiredTigerRecordStore::notifyCappedWaitersIfNeeded() {
     stdx::lock_guard<Latch> cappedCallbackLock(_cappedCallbackMutex);
     // This wakes up cursors blocking for awaitData.
@@ -1594,6 +1678,23 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
                                            const RecordId& id,
                                            const char* data,
                                            int len) {
+    return _updateRecord(opCtx, id, data, len, nullptr);
+}
+
+Status WiredTigerRecordStore::updateRecordWithDamages(
+    OperationContext* opCtx,
+    const RecordId& id,
+    const char* data,
+    int len,
+    const mutablebson::ResizingDamageVector& damages) {
+    return _updateRecord(opCtx, id, data, len, &damages);
+}
+
+Status WiredTigerRecordStore::_updateRecord(OperationContext* opCtx,
+                                            const RecordId& id,
+                                            const char* data,
+                                            int len,
+                                            const mutablebson::ResizingDamageVector* damages) {
     dassert(opCtx->lockState()->isWriteLocked());
     invariant(opCtx->lockState()->inAWriteUnitOfWork() || opCtx->lockState()->isNoop());
 
@@ -1627,7 +1728,36 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     const int kMaxDiffBytes = len / 10;
 
     bool skip_update = false;
-    if (!_isLogged && len > kMinLengthForDiff && len <= old_length + kMaxDiffBytes) {
+    if (damages && !_isLogged && len > kMinLengthForDiff) {
+        // The caller already knows where the record changed, so there is no need to search the
+        // old and new values for the differences. As above, only modify when the change is small.
+        size_t damageBytes = 0;
+        for (auto&& damage : *damages) {
+            damageBytes += damage.sourceSize;
+        }
+        if (damages->size() <= static_cast<size_t>(kMaxEntries) &&
+            damageBytes <= static_cast<size_t>(kMaxDiffBytes)) {
+            std::vector<WT_MODIFY> entries(damages->size());
+            for (size_t i = 0; i < damages->size(); ++i) {
+                const auto& damage = (*damages)[i];
+                entries[i].data.data = data + damage.offset;
+                entries[i].data.size = damage.sourceSize;
+                entries[i].offset = damage.offset;
+                entries[i].size = damage.targetSize;
+            }
+            invariantWTOK(WT_OP_CHECK(entries.empty()
+                                          ? c->reserve(c)
+                                          : c->modify(c, entries.data(), entries.size())));
+            WT_ITEM new_value;
+            dassert(entries.empty() ||
+                    (c->get_value(c, &new_value) == 0 && new_value.size == value.size &&
+                     memcmp(data, new_value.data, len) == 0));
+            skip_update = true;
+        }
+    }
+
+    if (!skip_update && !_isLogged && len > kMinLengthForDiff &&
+        len <= old_length + kMaxDiffBytes) {
         int nentries = kMaxEntries;
         std::vector<WT_MODIFY> entries(nentries);
 
@@ -1883,8 +2013,8 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     // We're correcting the size as of now, future writes should be tracked.
     sizeRecoveryState(getGlobalServiceContext()).markCollectionAsAlwaysNeedsSizeAdjustment(_ident);
 
-    _sizeInfo->numRecords.store(numRecords);
-    _sizeInfo->dataSize.store(dataSize);
+    _sizeInfo->setNumRecords(numRecords);
+    _sizeInfo->setDataSize(dataSize);
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
@@ -1938,7 +2068,7 @@ public:
                     3,
                     "WiredTigerRecordStore: rolling back NumRecordsChange {diff}",
                     "diff"_attr = -_diff);
-        _rs->_sizeInfo->numRecords.fetchAndAdd(-_diff);
+        _rs->_sizeInfo->addNumRecords(-_diff);
     }
 
 private:
@@ -1956,8 +2086,7 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     }
 
     opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
-    if (_sizeInfo->numRecords.fetchAndAdd(diff) < 0)
-        _sizeInfo->numRecords.store(std::max(diff, int64_t(0)));
+    _sizeInfo->addNumRecords(diff);
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -1985,8 +2114,7 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
     if (opCtx)
         opCtx->recoveryUnit()->registerChange(std::make_unique<DataSizeChange>(this, amount));
 
-    if (_sizeInfo->dataSize.fetchAndAdd(amount) < 0)
-        _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
+    _sizeInfo->addDataSize(amount);
 
     if (_sizeStorer)
         _sizeStorer->store(_uri, _sizeInfo);
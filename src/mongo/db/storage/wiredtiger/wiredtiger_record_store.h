@@ -114,6 +114,7 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        bool isClustered = false;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -133,6 +134,10 @@ public:
 
     virtual bool isCapped() const;
 
+    bool isClustered() const final {
+        return _isClustered;
+    }
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = nullptr,
                                 int infoLevel = 0) const;
@@ -154,6 +159,12 @@ public:
                                 const char* data,
                                 int len);
 
+    Status updateRecordWithDamages(OperationContext* opCtx,
+                                   const RecordId& recordId,
+                                   const char* data,
+                                   int len,
+                                   const mutablebson::ResizingDamageVector& damages) final;
+
     virtual bool updateWithDamagesSupported() const;
 
     virtual StatusWith<RecordData> updateWithDamages(OperationContext* opCtx,
@@ -264,6 +275,8 @@ public:
 
     bool haveCappedWaiters();
 
+    void onCappedWaiterAdded() final;
+
     void notifyCappedWaitersIfNeeded();
 
     class OplogStones;
@@ -291,6 +304,15 @@ private:
                           const Timestamp* timestamps,
                           size_t nRecords);
 
+    /**
+     * Implements updateRecord() and updateRecordWithDamages(). 'damages' may be null.
+     */
+    Status _updateRecord(OperationContext* opCtx,
+                         const RecordId& id,
+                         const char* data,
+                         int len,
+                         const mutablebson::ResizingDamageVector* damages);
+
     RecordId _nextId(OperationContext* opCtx);
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
@@ -356,6 +378,8 @@ private:
     const bool _isLogged;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if records are keyed by the RecordIds set by the caller of insertRecords().
+    const bool _isClustered;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
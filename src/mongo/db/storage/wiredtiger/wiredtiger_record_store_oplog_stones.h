@@ -65,17 +65,16 @@ public:
 
     void awaitHasExcessStonesOrDead();
 
-    void getOplogStonesStats(BSONObjBuilder& builder) const {
-        builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
-        if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
-            builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
-        }
-    }
+    void getOplogStonesStats(BSONObjBuilder& builder) const;
 
-    boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
+    /**
+     * Returns up to 'maxStones' of the oldest stones, oldest first, which are in excess of the
+     * configured oplog size and retention and which end before 'mayTruncateUpTo'.
+     */
+    std::vector<OplogStones::Stone> peekOldestStonesIfNeeded(Timestamp mayTruncateUpTo,
+                                                             size_t maxStones) const;
 
-    void popOldestStone();
+    void popOldestStones(size_t numStones);
 
     void createNewStoneIfNeeded(OperationContext* opCtx, RecordId lastRecord, Date_t wallTime);
 
@@ -129,6 +128,9 @@ private:
 
     void _pokeReclaimThreadIfNeeded();
 
+    // Returns whether 'stone' can be reclaimed when the stones from it onwards total 'totalBytes'.
+    bool _isExcessStone_inlock(const Stone& stone, int64_t totalBytes) const;
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
     WiredTigerRecordStore* _rs;
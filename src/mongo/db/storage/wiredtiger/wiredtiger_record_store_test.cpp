@@ -43,6 +43,7 @@
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -260,6 +261,38 @@ TEST(WiredTigerRecordStoreTest, CappedCursorRollover) {
     ASSERT(!cursor->next());
 }
 
+TEST(WiredTigerRecordStoreTest, CappedDeleteBatch) {
+    gWiredTigerCappedDeleteBatchFraction.store(0.5);
+    ON_BLOCK_EXIT([] { gWiredTigerCappedDeleteBatchFraction.store(0); });
+
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore("a.b", 10000, -1));
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    const std::string data(100, 'a');
+    auto insert = [&] {
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(rs->insertRecord(opCtx.get(), data.c_str(), data.size(), Timestamp()));
+        uow.commit();
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        insert();
+    }
+    ASSERT_EQ(100, rs->numRecords(opCtx.get()));
+
+    // Going over the maximum size deletes down to half of it.
+    insert();
+    ASSERT_EQ(50, rs->numRecords(opCtx.get()));
+    ASSERT_EQ(5000, rs->dataSize(opCtx.get()));
+
+    // The next inserts have room without deleting anything.
+    for (int i = 0; i < 50; ++i) {
+        insert();
+    }
+    ASSERT_EQ(100, rs->numRecords(opCtx.get()));
+}
+
 RecordId _oplogOrderInsertOplog(OperationContext* opCtx,
                                 const unique_ptr<RecordStore>& rs,
                                 int inc) {
@@ -790,6 +823,13 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
         ASSERT_EQ(4U, oplogStones->numStones());
         ASSERT_EQ(1, oplogStones->currentRecords());
         ASSERT_EQ(50, oplogStones->currentBytes());
+
+        // The stones holding 110, 120 and 130 bytes are waiting to be truncated.
+        BSONObjBuilder builder;
+        oplogStones->getOplogStonesStats(builder);
+        auto stats = builder.obj();
+        ASSERT_EQ(3, stats["excessStones"].numberLong());
+        ASSERT_EQ(360, stats["excessBytes"].numberLong());
     }
 
     // Truncate multiple stones if necessary.
@@ -803,6 +843,10 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
         ASSERT_EQ(1U, oplogStones->numStones());
         ASSERT_EQ(1, oplogStones->currentRecords());
         ASSERT_EQ(50, oplogStones->currentBytes());
+
+        BSONObjBuilder builder;
+        oplogStones->getOplogStonesStats(builder);
+        ASSERT_EQ(0, builder.obj()["excessStones"].numberLong());
     }
 
     // No-op if dataSize <= cappedMaxSize.
@@ -42,6 +42,8 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/hex.h"
+#include "mongo/util/latency_histogram.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -56,6 +58,9 @@ logv2::LogSeverity kSlowTransactionSeverity = logv2::LogSeverity::Debug(1);
 
 MONGO_FAIL_POINT_DEFINE(doUntimestampedWritesForIdempotencyTests);
 
+// Time spent in WT_SESSION::commit_transaction, which includes any log flush the commit waits for.
+LatencyHistogram commitHistogram("wiredTigerCommit");
+
 }  // namespace
 
 AtomicWord<std::int64_t> snapshotTooOldErrorCount{0};
@@ -373,7 +378,9 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
             invariant(_isTimestamped);
         }
 
+        Timer commitTimer;
         wtRet = s->commit_transaction(s, conf.str().c_str());
+        commitHistogram.record(Microseconds(commitTimer.micros()));
         LOGV2_DEBUG(22412,
                     3,
                     "WT commit_transaction for snapshot id {getSnapshotId_toNumber}",
@@ -736,6 +743,10 @@ Timestamp WiredTigerRecoveryUnit::getCommitTimestamp() const {
     return _commitTimestamp;
 }
 
+boost::optional<Timestamp> WiredTigerRecoveryUnit::getLastTimestampSet() const {
+    return _lastTimestampSet;
+}
+
 void WiredTigerRecoveryUnit::setDurableTimestamp(Timestamp timestamp) {
     invariant(
         _durableTimestamp.isNull(),
@@ -129,6 +129,8 @@ public:
 
     Timestamp getCommitTimestamp() const override;
 
+    boost::optional<Timestamp> getLastTimestampSet() const override;
+
     void setDurableTimestamp(Timestamp timestamp) override;
 
     Timestamp getDurableTimestamp() const override;
@@ -90,6 +90,13 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
+    WiredTigerUtil::appendCompressedCacheStats(s, &bob);
+
+    {
+        BSONObjBuilder subsection(bob.subobjStart("session cache"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendStats(&subsection);
+    }
+
     {
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
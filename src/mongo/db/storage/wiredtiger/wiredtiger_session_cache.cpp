@@ -45,7 +45,10 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -115,13 +118,19 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri,
                                               uint64_t id,
                                               const char* config) {
     // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        if (i->_id == id) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            return c;
+    if (auto it = _cursorIndex.find(id); it != _cursorIndex.end()) {
+        auto& tableCursors = it->second;
+        invariant(!tableCursors.empty());
+        auto i = tableCursors.back();
+        tableCursors.pop_back();
+        if (tableCursors.empty()) {
+            _cursorIndex.erase(it);
         }
+
+        WT_CURSOR* c = i->_cursor;
+        _cursors.erase(i);
+        _cursorsOut++;
+        return c;
     }
 
     WT_CURSOR* cursor = nullptr;
@@ -146,17 +155,36 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
 
     // Cursors are pushed to the front of the list and removed from the back
     _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
+    _cursorIndex[id].push_back(_cursors.begin());
 
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
 
     while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
+        // The oldest cursor in the cache is also the oldest cursor of its table.
+        auto it = _cursorIndex.find(_cursors.back()._id);
+        invariant(it != _cursorIndex.end() && it->second.front() == std::prev(_cursors.end()));
+        it->second.erase(it->second.begin());
+        if (it->second.empty()) {
+            _cursorIndex.erase(it);
+        }
+
         cursor = _cursors.back()._cursor;
         _cursors.pop_back();
         invariantWTOK(cursor->close(cursor));
     }
 }
 
+void WiredTigerSession::_rebuildCursorIndex() {
+    _cursorIndex.clear();
+    // Walk from the least to the most recently used cursor, so that each table's cursors end up
+    // in the same order as when they were released.
+    for (auto i = _cursors.end(); i != _cursors.begin();) {
+        --i;
+        _cursorIndex[i->_id].push_back(i);
+    }
+}
+
 void WiredTigerSession::closeCursor(WT_CURSOR* cursor) {
     invariant(_session);
     invariant(cursor);
@@ -177,6 +205,24 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
         } else
             ++i;
     }
+    _rebuildCursorIndex();
+}
+
+void WiredTigerSession::closeAllCursorsExceptMostRecent(size_t numTablesToRetain) {
+    invariant(_session);
+
+    stdx::unordered_set<uint64_t> retainedTables;
+    for (auto i = _cursors.begin(); i != _cursors.end();) {
+        if (retainedTables.size() < numTablesToRetain && retainedTables.insert(i->_id).second) {
+            ++i;
+            continue;
+        }
+        if (WT_CURSOR* cursor = i->_cursor) {
+            invariantWTOK(cursor->close(cursor));
+        }
+        i = _cursors.erase(i);
+    }
+    _rebuildCursorIndex();
 }
 
 void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
@@ -184,6 +230,9 @@ void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
 
     _cursorEpoch = _cache->getCursorEpoch();
     auto toDrop = engine->filterCursorsWithQueuedDrops(&_cursors);
+    if (!toDrop.empty()) {
+        _rebuildCursorIndex();
+    }
 
     for (auto i = toDrop.begin(); i != toDrop.end(); i++) {
         WT_CURSOR* cursor = i->_cursor;
@@ -208,14 +257,34 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _prepareCommitOrAbortCounter(0) {
+    _initShards();
+}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
     : _engine(nullptr),
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _prepareCommitOrAbortCounter(0) {
+    _initShards();
+}
+
+void WiredTigerSessionCache::_initShards() {
+    const auto numShards =
+        std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxNumShards);
+    for (size_t i = 0; i < numShards; ++i) {
+        _shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+WiredTigerSessionCache::Shard& WiredTigerSessionCache::_getShardForCurrentThread() {
+    // Threads are assigned to shards round-robin the first time they use a session cache, which
+    // spreads them more evenly than hashing their thread ids.
+    static AtomicWord<unsigned> nextThreadIdx{0};
+    thread_local const unsigned threadIdx = nextThreadIdx.fetchAndAdd(1);
+    return *_shards[threadIdx % _shards.size()];
+}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -328,6 +397,9 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         token = journalListener->getToken(opCtx);
     }
 
+    _journalFlushWaiters.fetchAndAdd(1);
+    ON_BLOCK_EXIT([this] { _journalFlushWaiters.fetchAndSubtract(1); });
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -337,6 +409,15 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // With other threads waiting for durability too, more writers are likely to commit shortly.
+    // Delaying the flush lets them read the current _lastSyncTime and return once it is done,
+    // rather than each paying for another flush. A lone waiter never pays for the delay.
+    if (auto delayMicros = gWiredTigerJournalGroupCommitDelayMicros.load();
+        delayMicros > 0 && _journalFlushWaiters.load() > 1) {
+        sleepmicros(delayMicros);
+    }
+
     _lastSyncTime.store(current + 1);
 
     // Nobody has synched yet, so we have to sync ourselves.
@@ -380,9 +461,11 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        for (auto&& session : shard->sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -390,15 +473,29 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        for (auto&& session : shard->sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        count += shard->sessions.size();
+    }
+    return count;
+}
+
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) {
+    builder->append("shards", static_cast<long long>(_shards.size()));
+    builder->append("idle sessions", static_cast<long long>(getIdleSessionsCount()));
+    builder->append("hits", _sessionHits.loadRelaxed());
+    builder->append("misses", _sessionMisses.loadRelaxed());
+    builder->append("steals", _sessionSteals.loadRelaxed());
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -408,14 +505,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (auto&& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        auto& sessions = shard->sessions;
+        for (auto it = sessions.begin(); it != sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = sessions.erase(it);
                 delete (session);
             } else {
                 ++it;
@@ -429,9 +527,19 @@ void WiredTigerSessionCache::closeAll() {
     SessionCache swap;
 
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        // Hold the locks of all of the shards while bumping the epoch, so that no session of the
+        // old epoch can be released into any shard afterwards.
+        std::vector<stdx::unique_lock<Latch>> locks;
+        locks.reserve(_shards.size());
+        for (auto&& shard : _shards) {
+            locks.emplace_back(shard->mutex);
+        }
+
         _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+        for (auto&& shard : _shards) {
+            swap.insert(swap.end(), shard->sessions.begin(), shard->sessions.end());
+            shard->sessions.clear();
+        }
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -448,20 +556,40 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
-            return UniqueWiredTigerSession(cachedSession);
+    // Get the most recently used session so that if we discard sessions, we're discarding older
+    // ones.
+    auto takeSession = [](Shard& shard) -> WiredTigerSession* {
+        stdx::lock_guard<Latch> lock(shard.mutex);
+        if (shard.sessions.empty()) {
+            return nullptr;
+        }
+        WiredTigerSession* cachedSession = shard.sessions.back();
+        shard.sessions.pop_back();
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return cachedSession;
+    };
+
+    auto& ownShard = _getShardForCurrentThread();
+    if (auto session = takeSession(ownShard)) {
+        _sessionHits.fetchAndAddRelaxed(1);
+        return UniqueWiredTigerSession(session);
+    }
+
+    // Our own shard is empty, so steal an idle session from another shard before paying for the
+    // creation of a new one.
+    for (auto&& shard : _shards) {
+        if (shard.get() == &ownShard) {
+            continue;
+        }
+        if (auto session = takeSession(*shard)) {
+            _sessionSteals.fetchAndAddRelaxed(1);
+            return UniqueWiredTigerSession(session);
         }
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionMisses.fetchAndAddRelaxed(1);
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -494,9 +622,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 
         // Release resources in the session we're about to cache.
         // If we are using hybrid caching, then close cursors now and let them
-        // be cached at the WiredTiger level.
+        // be cached at the WiredTiger level, except for the cursors on the hottest tables which
+        // the session keeps so that the next operation using it does not need to reopen them.
         if (gWiredTigerCursorCacheSize.load() < 0) {
-            session->closeAllCursors("");
+            session->closeAllCursorsExceptMostRecent(
+                gWiredTigerSessionRetainedCursorTables.load());
         }
         invariantWTOK(ss->reset(ss));
     }
@@ -516,10 +646,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _getShardForCurrentThread();
+        stdx::lock_guard<Latch> lock(shard.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -31,13 +31,16 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -135,6 +138,12 @@ public:
      */
     void closeAllCursors(const std::string& uri);
 
+    /**
+     * Closes all cached cursors except for the most recently used cursor of each of the
+     * 'numTablesToRetain' most recently used tables.
+     */
+    void closeAllCursorsExceptMostRecent(size_t numTablesToRetain);
+
     int cursorsOut() const {
         return _cursorsOut;
     }
@@ -180,6 +189,15 @@ private:
     // The cursor cache is a list of pairs that contain an ID and cursor
     typedef std::list<WiredTigerCachedCursor> CursorCache;
 
+    // Indexes the cursor cache by table ID. The cursors of each table are ordered from least to
+    // most recently used.
+    typedef stdx::unordered_map<uint64_t, std::vector<CursorCache::iterator>> CursorCacheIndex;
+
+    /**
+     * Rebuilds '_cursorIndex' after cursors were removed from '_cursors' in bulk.
+     */
+    void _rebuildCursorIndex();
+
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
         return _epoch;
@@ -195,6 +213,7 @@ private:
     WiredTigerSessionCache* _cache;  // not owned
     WT_SESSION* _session;            // owned
     CursorCache _cursors;            // owned
+    CursorCacheIndex _cursorIndex;
     uint64_t _cursorGen;
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
@@ -204,9 +223,15 @@ private:
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  The pool is split into shards, one per available core up to kMaxNumShards, each with its own
+ *  lock. Every thread releases sessions to and takes sessions from its own shard, and only steals
+ *  from the other shards when its own shard is empty.
  */
 class WiredTigerSessionCache {
 public:
+    static constexpr size_t kMaxNumShards = 64;
+
     WiredTigerSessionCache(WiredTigerKVEngine* engine);
     WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs);
     ~WiredTigerSessionCache();
@@ -257,6 +282,11 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Appends the number of shards and the session hit, miss and steal counters to 'builder'.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
@@ -373,11 +403,24 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
 
-    // Bumped when all open sessions need to be closed
+    struct Shard {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::Shard::mutex");
+        SessionCache sessions;
+    };
+
+    // Idle sessions, sharded to spread contention across cores. Always non-empty.
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    // Sessions taken from the current thread's shard, stolen from another shard, and created
+    // because all of the shards were empty.
+    AtomicWord<long long> _sessionHits{0};
+    AtomicWord<long long> _sessionSteals{0};
+    AtomicWord<long long> _sessionMisses{0};
+
+    // Bumped when all open sessions need to be closed. Only modified while holding the locks of
+    // all of the shards.
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
 
     // Bumped when all open cursors need to be closed
@@ -387,6 +430,10 @@ private:
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
+    // Number of threads in waitUntilDurable waiting for a journal flush, used to decide whether
+    // delaying the flush could let it cover more writes
+    AtomicWord<unsigned> _journalFlushWaiters{0};
+
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
@@ -412,6 +459,13 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    void _initShards();
+
+    /**
+     * Returns the shard the calling thread takes sessions from and releases sessions to.
+     */
+    Shard& _getShardForCurrentThread();
 };
 
 /**
@@ -33,8 +33,10 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -113,4 +115,57 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, RetainsCursorsOfMostRecentlyUsedTables) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    UniqueWiredTigerSession session = harnessHelper.getSessionCache()->getSession();
+    WT_SESSION* wtSession = session->getSession();
+
+    const std::string coldUri = "table:cold";
+    const std::string hotUri = "table:hot";
+    ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, coldUri.c_str(), nullptr)));
+    ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, hotUri.c_str(), nullptr)));
+    const auto coldId = WiredTigerSession::genTableId();
+    const auto hotId = WiredTigerSession::genTableId();
+
+    WT_CURSOR* coldCursor = session->getCachedCursor(coldUri, coldId, nullptr);
+    WT_CURSOR* hotCursor = session->getCachedCursor(hotUri, hotId, nullptr);
+    session->releaseCursor(coldId, coldCursor);
+    session->releaseCursor(hotId, hotCursor);
+    ASSERT_EQUALS(session->cachedCursors(), 2);
+
+    session->closeAllCursorsExceptMostRecent(1);
+    ASSERT_EQUALS(session->cachedCursors(), 1);
+
+    // The cursor of the most recently used table is still cached and gets handed out again.
+    ASSERT_EQUALS(session->getCachedCursor(hotUri, hotId, nullptr), hotCursor);
+    ASSERT_EQUALS(session->cachedCursors(), 0);
+    session->releaseCursor(hotId, hotCursor);
+
+    session->closeAllCursorsExceptMostRecent(0);
+    ASSERT_EQUALS(session->cachedCursors(), 0);
+}
+
+TEST(WiredTigerSessionCacheTest, ReusesSessionsReleasedByOtherThreads) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release a session into the shard of another thread.
+    stdx::thread([&] { UniqueWiredTigerSession session = sessionCache->getSession(); }).join();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    // This thread must find the idle session, either in its own shard or by stealing it, rather
+    // than opening a new one.
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(stats["misses"].numberLong(), 1);
+    ASSERT_EQUALS(stats["hits"].numberLong() + stats["steals"].numberLong(), 1);
+}
+
 }  // namespace mongo
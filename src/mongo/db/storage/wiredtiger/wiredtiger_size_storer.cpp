@@ -47,6 +47,64 @@
 
 namespace mongo {
 
+namespace {
+// Each thread is assigned a stripe in round-robin order the first time it updates a SizeInfo.
+AtomicWord<unsigned> nextStripe{0};
+}  // namespace
+
+WiredTigerSizeStorer::SizeInfo::Stripe&
+WiredTigerSizeStorer::SizeInfo::_stripeForCurrentThread() {
+    static thread_local const size_t stripe = nextStripe.fetchAndAdd(1) % kNumStripes;
+    return _stripes[stripe];
+}
+
+long long WiredTigerSizeStorer::SizeInfo::getNumRecords() const {
+    long long total = 0;
+    for (auto&& stripe : _stripes)
+        total += stripe.numRecords.load();
+    return std::max(total, 0LL);
+}
+
+long long WiredTigerSizeStorer::SizeInfo::getDataSize() const {
+    long long total = 0;
+    for (auto&& stripe : _stripes)
+        total += stripe.dataSize.load();
+    return std::max(total, 0LL);
+}
+
+void WiredTigerSizeStorer::SizeInfo::addNumRecords(long long diff) {
+    _stripeForCurrentThread().numRecords.fetchAndAddRelaxed(diff);
+}
+
+void WiredTigerSizeStorer::SizeInfo::addDataSize(long long diff) {
+    _stripeForCurrentThread().dataSize.fetchAndAddRelaxed(diff);
+}
+
+void WiredTigerSizeStorer::SizeInfo::setNumRecords(long long records) {
+    _stripes[0].numRecords.store(records);
+    for (size_t i = 1; i < kNumStripes; ++i)
+        _stripes[i].numRecords.store(0);
+}
+
+void WiredTigerSizeStorer::SizeInfo::setDataSize(long long size) {
+    _stripes[0].dataSize.store(size);
+    for (size_t i = 1; i < kNumStripes; ++i)
+        _stripes[i].dataSize.store(0);
+}
+
+void WiredTigerSizeStorer::SizeInfo::_resetIfNegative() {
+    long long numRecords = 0;
+    long long dataSize = 0;
+    for (auto&& stripe : _stripes) {
+        numRecords += stripe.numRecords.load();
+        dataSize += stripe.dataSize.load();
+    }
+    if (numRecords < 0)
+        setNumRecords(0);
+    if (dataSize < 0)
+        setDataSize(0);
+}
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool readOnly)
@@ -88,8 +146,8 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         "WiredTigerSizeStorer::store Marking {uri} dirty, numRecords: {sizeInfo_numRecords_load}, "
         "dataSize: {sizeInfo_dataSize_load}, use_count: {entry_use_count}",
         "uri"_attr = uri,
-        "sizeInfo_numRecords_load"_attr = sizeInfo->numRecords.load(),
-        "sizeInfo_dataSize_load"_attr = sizeInfo->dataSize.load(),
+        "sizeInfo_numRecords_load"_attr = sizeInfo->getNumRecords(),
+        "sizeInfo_dataSize_load"_attr = sizeInfo->getDataSize(),
         "entry_use_count"_attr = entry.use_count());
 }
 
@@ -126,8 +184,11 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                 "WiredTigerSizeStorer::load {uri} -> {data}",
                 "uri"_attr = uri,
                 "data"_attr = redact(data));
-    return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
-                                      data["dataSize"].safeNumberLong());
+    auto sizeInfo = std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
+                                               data["dataSize"].safeNumberLong());
+    sizeInfo->_flushedNumRecords = sizeInfo->getNumRecords();
+    sizeInfo->_flushedDataSize = sizeInfo->getDataSize();
+    return sizeInfo;
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
@@ -163,8 +224,17 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            sizeInfo._resetIfNegative();
+
+            const long long numRecords = sizeInfo.getNumRecords();
+            const long long dataSize = sizeInfo.getDataSize();
+            if (numRecords == sizeInfo._flushedNumRecords &&
+                dataSize == sizeInfo._flushedDataSize) {
+                // Updates since the last flush cancelled out, so there is nothing to write.
+                continue;
+            }
+
+            BSONObj data = BSON("numRecords" << numRecords << "dataSize" << dataSize);
 
             auto& uri = it->first;
             LOGV2_DEBUG(22425,
@@ -177,6 +247,8 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             _cursor->set_key(_cursor, key.Get());
             _cursor->set_value(_cursor, value.Get());
             invariantWTOK(_cursor->insert(_cursor));
+            sizeInfo._flushedNumRecords = numRecords;
+            sizeInfo._flushedDataSize = dataSize;
         }
         txnOpen.done();
         invariantWTOK(session->commit_transaction(session, nullptr));
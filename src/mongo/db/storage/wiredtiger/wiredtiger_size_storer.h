@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
@@ -38,6 +39,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -60,20 +62,59 @@ public:
      * ownership. The SizeInfo may still be updated after it is stored in the SizeStorer.
      * The 'dirty' field is used by the size storer to cheaply merge duplicate stores of the same
      * SizeInfo.
+     *
+     * Updates are spread over several cache-line-aligned stripes, each thread always updating the
+     * same stripe, so that concurrent writers to a collection do not contend on a single cache
+     * line. Reads sum the stripes and clamp the result at zero.
      */
-    struct SizeInfo {
+    class SizeInfo {
+    public:
         SizeInfo() = default;
-        SizeInfo(long long records, long long size) : numRecords(records), dataSize(size) {}
+        SizeInfo(long long records, long long size) {
+            setNumRecords(records);
+            setDataSize(size);
+        }
 
         ~SizeInfo() {
             invariant(!_dirty.load());
         }
-        AtomicWord<long long> numRecords;
-        AtomicWord<long long> dataSize;
+
+        long long getNumRecords() const;
+        long long getDataSize() const;
+
+        void addNumRecords(long long diff);
+        void addDataSize(long long diff);
+
+        /**
+         * Replaces the current value. Updates made concurrently by other threads may be lost, so
+         * these are only meant for resetting the size when it is known to be inaccurate.
+         */
+        void setNumRecords(long long records);
+        void setDataSize(long long size);
 
     private:
         friend WiredTigerSizeStorer;
+
+        static constexpr size_t kNumStripes = 8;
+
+        struct Stripe {
+            AtomicWord<long long> numRecords;
+            AtomicWord<long long> dataSize;
+        };
+
+        Stripe& _stripeForCurrentThread();
+
+        // Resets either count to zero if it has become negative, so that earlier underflow does
+        // not hide subsequent increments.
+        void _resetIfNegative();
+
+        std::array<CacheAligned<Stripe>, kNumStripes> _stripes;
         AtomicWord<bool> _dirty;
+
+        // The values most recently written back by flush(), which skips entries whose values have
+        // not changed since. Only accessed by flush() while holding the '_cursorMutex'.
+        long long _flushedNumRecords = -1;
+        long long _flushedDataSize = -1;
     };
 
     WiredTigerSizeStorer(WT_CONNECTION* conn,
@@ -54,6 +54,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -248,7 +249,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
 
     {
         auto& info = *ss.load(uri);
-        ASSERT_EQUALS(N, info.numRecords.load());
+        ASSERT_EQUALS(N, info.getNumRecords());
     }
 
     {
@@ -294,7 +295,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
         const bool enableWtLogging = false;
         WiredTigerSizeStorer ss2(harnessHelper->conn(), indexUri, enableWtLogging);
         auto info = ss2.load(uri);
-        ASSERT_EQUALS(N, info->numRecords.load());
+        ASSERT_EQUALS(N, info->getNumRecords());
     }
 
     rs.reset(nullptr);  // this has to be deleted before ss
@@ -324,11 +325,11 @@ private:
 
 protected:
     long long getNumRecords() const {
-        return sizeStorer->load(uri)->numRecords.load();
+        return sizeStorer->load(uri)->getNumRecords();
     }
 
     long long getDataSize() const {
-        return sizeStorer->load(uri)->dataSize.load();
+        return sizeStorer->load(uri)->getDataSize();
     }
 
     std::unique_ptr<WiredTigerHarnessHelper> harnessHelper;
@@ -347,5 +348,34 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+TEST(WiredTigerSizeInfoTest, SumsUpdatesFromConcurrentThreads) {
+    WiredTigerSizeStorer::SizeInfo info(10, 100);
+
+    const int kNumThreads = 16;
+    const int kUpdatesPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&info] {
+            for (int j = 0; j < kUpdatesPerThread; ++j) {
+                info.addNumRecords(1);
+                info.addDataSize(3);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(10 + kNumThreads * kUpdatesPerThread, info.getNumRecords());
+    ASSERT_EQUALS(100 + 3 * kNumThreads * kUpdatesPerThread, info.getDataSize());
+
+    info.setNumRecords(7);
+    ASSERT_EQUALS(7, info.getNumRecords());
+
+    // Underflow is reported as an empty collection.
+    info.addNumRecords(-8);
+    ASSERT_EQUALS(0, info.getNumRecords());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,287 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <boost/optional.hpp>
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+namespace {
+
+// A filter is sized for at least this many keys, so that the index of a new or small collection
+// can grow for a while before its filter fills up.
+const uint64_t kMinCapacity = 64 * 1024;
+
+// A filter is sized for this many times the number of keys the index held when it was loaded.
+const uint64_t kGrowthFactor = 2;
+
+// The bit positions of a key are derived from two 32-bit hashes, which cannot address more bits.
+const uint64_t kMaxBits = uint64_t(1) << 32;
+
+// How many keys the scan of the index reads in each of its transactions, so that none of them
+// keeps old versions of the index pinned in the cache for long.
+const int kKeysPerTransaction = 1000;
+
+uint64_t hashKey(const char* key, size_t size) {
+    uint64_t hash[2];
+    MurmurHash3_x64_128(key, size, 0, hash);
+    return hash[0];
+}
+
+}  // namespace
+
+WiredTigerUniqueIndexKeyFilter::WiredTigerUniqueIndexKeyFilter(std::string uri, int bitsPerKey)
+    : _uri(std::move(uri)),
+      _bitsPerKey(bitsPerKey),
+      _numHashes(std::max(1, static_cast<int>(std::lround(bitsPerKey * std::log(2.0))))) {}
+
+WiredTigerUniqueIndexKeyFilter::~WiredTigerUniqueIndexKeyFilter() {
+    _shuttingDown.store(true);
+    if (_loader.joinable()) {
+        _loader.join();
+    }
+}
+
+void WiredTigerUniqueIndexKeyFilter::startLoading(WT_CONNECTION* conn) {
+    if (_loadingStarted.load()) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_loadingStarted.load()) {
+        return;
+    }
+    _loadingStarted.store(true);
+    _loader = stdx::thread([this, conn] {
+        setThreadName("UniqueIndexKeyFilterLoader");
+        _load(conn);
+    });
+}
+
+bool WiredTigerUniqueIndexKeyFilter::testAndAdd(const char* key, size_t size) {
+    if (_disabled.load()) {
+        return true;
+    }
+
+    const uint64_t hash = hashKey(key, size);
+    if (!_ready.load()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_ready.load()) {
+            if (!_disabled.load()) {
+                _hashes.push_back(hash);
+            }
+            return true;
+        }
+    }
+
+    if (_testAndSetBits(hash)) {
+        return true;
+    }
+
+    if (_numKeys.addAndFetch(1) > _capacity) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _disable(lk, "More keys were added than the filter was sized for");
+        return true;
+    }
+    _numNegativeLookups.addAndFetch(1);
+    return false;
+}
+
+void WiredTigerUniqueIndexKeyFilter::disable() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _disable(lk, "Keys were added to the index in bulk");
+}
+
+void WiredTigerUniqueIndexKeyFilter::waitUntilLoaded() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _loadedCV.wait(lk, [&] { return _ready.load() || _disabled.load(); });
+}
+
+void WiredTigerUniqueIndexKeyFilter::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("state",
+                    _disabled.load() ? "disabled" : (_ready.load() ? "ready" : "loading"));
+    builder->appendNumber("bytes", static_cast<long long>(_numBits / 8));
+    builder->appendNumber("capacity", static_cast<long long>(_capacity));
+    builder->appendNumber("keys", static_cast<long long>(_numKeys.load()));
+    builder->appendNumber("negativeLookups", _numNegativeLookups.load());
+}
+
+void WiredTigerUniqueIndexKeyFilter::_load(WT_CONNECTION* conn) {
+    Status status = [&]() -> Status {
+        WiredTigerSession session(conn);
+        WT_SESSION* s = session.getSession();
+        WT_CURSOR* c;
+        int ret = s->open_cursor(s, _uri.c_str(), nullptr, nullptr, &c);
+        if (ret != 0) {
+            return wtRCToStatus(ret, "Failed to open a cursor on the index");
+        }
+
+        // The key the previous transaction stopped at, if any.
+        boost::optional<std::string> lastKey;
+        std::vector<uint64_t> hashes;
+        while (!_shuttingDown.load()) {
+            // Keys added by prepared transactions were seen by the filter when they were added.
+            invariantWTOK(s->begin_transaction(s, "ignore_prepare=true"));
+            if (lastKey) {
+                WiredTigerItem item(lastKey->data(), lastKey->size());
+                c->set_key(c, item.Get());
+                int cmp;
+                ret = c->search_near(c, &cmp);
+                if (ret == 0 && cmp <= 0) {
+                    ret = c->next(c);
+                }
+            } else {
+                ret = c->next(c);
+            }
+
+            hashes.clear();
+            for (; ret == 0; ret = c->next(c)) {
+                WT_ITEM key;
+                invariantWTOK(c->get_key(c, &key));
+                const char* data = static_cast<const char*>(key.data);
+
+                // Entries in the timestamp unsafe format, which can remain from before an upgrade,
+                // have no RecordId at the end of their key. Inserts find duplicates of those
+                // without consulting the filter, but their keys must not be taken apart as if
+                // they had one.
+                const auto lastByte = static_cast<unsigned char>(data[key.size - 1]);
+                if (key.size >= 2 + static_cast<size_t>(lastByte & 0x7)) {
+                    hashes.push_back(
+                        hashKey(data, KeyString::sizeWithoutRecordIdAtEnd(data, key.size)));
+                }
+
+                if (hashes.size() == kKeysPerTransaction) {
+                    lastKey.emplace(data, key.size);
+                    break;
+                }
+            }
+            invariantWTOK(s->rollback_transaction(s, nullptr));
+
+            if (ret == WT_ROLLBACK) {
+                // Read the same keys again in a new transaction.
+                continue;
+            }
+            if (ret != 0 && ret != WT_NOTFOUND) {
+                return wtRCToStatus(ret, "Failed to scan the index");
+            }
+
+            stdx::lock_guard<Latch> lk(_mutex);
+            _hashes.insert(_hashes.end(), hashes.begin(), hashes.end());
+            if (ret == WT_NOTFOUND) {
+                break;
+            }
+        }
+        return Status::OK();
+    }();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!status.isOK()) {
+        _disable(lk, status.reason());
+    } else if (_shuttingDown.load()) {
+        _disabled.store(true);
+    } else if (!_disabled.load()) {
+        _finishLoading(lk);
+    }
+    _loadedCV.notify_all();
+}
+
+void WiredTigerUniqueIndexKeyFilter::_finishLoading(WithLock lk) {
+    const uint64_t capacity = std::max(kGrowthFactor * _hashes.size(), kMinCapacity);
+    const uint64_t numBits = (capacity * _bitsPerKey + 63) / 64 * 64;
+    if (numBits > kMaxBits) {
+        _disable(lk, "The index holds too many keys");
+        return;
+    }
+
+    _capacity = capacity;
+    _numBits = numBits;
+    _bits = std::make_unique<AtomicWord<uint64_t>[]>(numBits / 64);
+
+    uint64_t numKeys = 0;
+    for (auto hash : _hashes) {
+        if (!_testAndSetBits(hash)) {
+            ++numKeys;
+        }
+    }
+    _numKeys.store(numKeys);
+    std::vector<uint64_t>().swap(_hashes);
+    _ready.store(true);
+
+    LOGV2_DEBUG(5155007,
+                1,
+                "Loaded the key filter of a unique index",
+                "uri"_attr = _uri,
+                "keys"_attr = numKeys,
+                "bytes"_attr = numBits / 8);
+}
+
+bool WiredTigerUniqueIndexKeyFilter::_testAndSetBits(uint64_t hash) {
+    const uint64_t h1 = static_cast<uint32_t>(hash);
+    const uint64_t h2 = hash >> 32;
+    bool allSet = true;
+    for (int i = 0; i < _numHashes; ++i) {
+        const uint64_t bit = (h1 + i * h2) % _numBits;
+        const uint64_t mask = uint64_t(1) << (bit % 64);
+        auto& word = _bits[bit / 64];
+        if (!(word.load() & mask)) {
+            word.fetchAndBitOr(mask);
+            allSet = false;
+        }
+    }
+    return allSet;
+}
+
+void WiredTigerUniqueIndexKeyFilter::_disable(WithLock, StringData reason) {
+    if (_disabled.load()) {
+        return;
+    }
+    _disabled.store(true);
+    std::vector<uint64_t>().swap(_hashes);
+    LOGV2(5155008,
+          "Stopped using the key filter of a unique index",
+          "uri"_attr = _uri,
+          "reason"_attr = reason);
+}
+
+}  // namespace mongo
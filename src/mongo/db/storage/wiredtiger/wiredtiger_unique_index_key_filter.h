@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <wiredtiger.h>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * An in-memory Bloom filter over the keys of a timestamp safe unique index. It lets an insert skip
+ * searching the index for a duplicate of a key that the index has definitely never held.
+ *
+ * To answer that, the filter must see every key added to the index from its construction on, and
+ * learns the keys already present from a scan of the index on a background thread. Until the scan
+ * finishes, or after keys were added without the filter seeing them, any key may be present.
+ * Removed keys stay in the filter, which therefore only gets less selective over time, and it is
+ * no longer consulted once more keys were added than it was sized for.
+ */
+class WiredTigerUniqueIndexKeyFilter {
+    WiredTigerUniqueIndexKeyFilter(const WiredTigerUniqueIndexKeyFilter&) = delete;
+    WiredTigerUniqueIndexKeyFilter& operator=(const WiredTigerUniqueIndexKeyFilter&) = delete;
+
+public:
+    WiredTigerUniqueIndexKeyFilter(std::string uri, int bitsPerKey);
+
+    /**
+     * Stops and waits for the scan of the index, which must finish before the index is dropped.
+     */
+    ~WiredTigerUniqueIndexKeyFilter();
+
+    /**
+     * Starts scanning the index for the keys it already holds, unless that has been started
+     * before.
+     */
+    void startLoading(WT_CONNECTION* conn);
+
+    /**
+     * Records that the index holds 'key', the KeyString of an index key without its RecordId.
+     * Returns false only if the index definitely did not hold it before.
+     */
+    bool testAndAdd(const char* key, size_t size);
+
+    /**
+     * Stops the filter from ever ruling out a key again, for when keys are added to the index
+     * without going through testAndAdd().
+     */
+    void disable();
+
+    /**
+     * Blocks until the filter either finished loading or was disabled. For testing only.
+     */
+    void waitUntilLoaded();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _load(WT_CONNECTION* conn);
+
+    // Sizes the filter for the keys in '_hashes' and adds them to it.
+    void _finishLoading(WithLock);
+
+    // Sets the bits of 'hash' and returns whether they were all set before.
+    bool _testAndSetBits(uint64_t hash);
+
+    void _disable(WithLock, StringData reason);
+
+    const std::string _uri;
+    const int _bitsPerKey;
+
+    // Set once the filter is fully loaded and rules keys out, and once it no longer may.
+    AtomicWord<bool> _ready{false};
+    AtomicWord<bool> _disabled{false};
+    AtomicWord<bool> _loadingStarted{false};
+    AtomicWord<bool> _shuttingDown{false};
+
+    // The number of keys the filter was sized for, and how many were added to it.
+    uint64_t _capacity = 0;
+    AtomicWord<uint64_t> _numKeys{0};
+
+    // Number of inserts that skipped searching the index.
+    AtomicWord<long long> _numNegativeLookups{0};
+
+    uint64_t _numBits = 0;
+    int _numHashes = 0;
+    std::unique_ptr<AtomicWord<uint64_t>[]> _bits;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerUniqueIndexKeyFilter::_mutex");
+    stdx::condition_variable _loadedCV;
+
+    // Hashes of the keys added while loading, which are only added to the filter once its final
+    // size is known.
+    std::vector<uint64_t> _hashes;
+
+    stdx::thread _loader;
+};
+
+}  // namespace mongo
@@ -0,0 +1,171 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_unique_index_key_filter.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const std::string kUri = "table:index";
+const auto kVersion = KeyString::Version::kLatestVersion;
+
+KeyString::Value makeKey(int i) {
+    return KeyString::Builder(kVersion, BSON("" << i), Ordering::make(BSONObj())).getValueCopy();
+}
+
+KeyString::Value makeKeyWithRecordId(int i) {
+    return KeyString::Builder(kVersion, BSON("" << i), Ordering::make(BSONObj()), RecordId(i))
+        .getValueCopy();
+}
+
+bool testAndAdd(WiredTigerUniqueIndexKeyFilter* filter, int i) {
+    auto key = makeKey(i);
+    return filter->testAndAdd(key.getBuffer(), key.getSize());
+}
+
+class WiredTigerUniqueIndexKeyFilterTest : public unittest::Test {
+public:
+    WiredTigerUniqueIndexKeyFilterTest() : _dbpath("wt_test") {
+        invariantWTOK(wiredtiger_open(_dbpath.path().c_str(), nullptr, "create", &_conn));
+        WiredTigerSession session(_conn);
+        WT_SESSION* s = session.getSession();
+        invariantWTOK(s->create(s, kUri.c_str(), "key_format=u,value_format=u"));
+    }
+
+    ~WiredTigerUniqueIndexKeyFilterTest() {
+        _conn->close(_conn, nullptr);
+    }
+
+    void insertKeys(int begin, int end) {
+        WiredTigerSession session(_conn);
+        WT_SESSION* s = session.getSession();
+        WT_CURSOR* c;
+        invariantWTOK(s->open_cursor(s, kUri.c_str(), nullptr, nullptr, &c));
+        for (int i = begin; i < end; ++i) {
+            insert(c, makeKeyWithRecordId(i));
+        }
+    }
+
+    void insert(WT_CURSOR* c, const KeyString::Value& key) {
+        WiredTigerItem keyItem(key.getBuffer(), key.getSize());
+        WiredTigerItem valueItem("", 0);
+        c->set_key(c, keyItem.Get());
+        c->set_value(c, valueItem.Get());
+        invariantWTOK(c->insert(c));
+    }
+
+protected:
+    unittest::TempDir _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+};
+
+TEST_F(WiredTigerUniqueIndexKeyFilterTest, RulesOutOnlyKeysNotInTheIndex) {
+    // More keys than the scan reads in one transaction.
+    const int numKeys = 2500;
+    insertKeys(0, numKeys);
+
+    WiredTigerUniqueIndexKeyFilter filter(kUri, 10);
+    filter.startLoading(_conn);
+    filter.waitUntilLoaded();
+
+    for (int i = 0; i < numKeys; ++i) {
+        ASSERT_TRUE(testAndAdd(&filter, i));
+    }
+
+    int numRuledOut = 0;
+    for (int i = numKeys; i < 2 * numKeys; ++i) {
+        if (!testAndAdd(&filter, i)) {
+            ++numRuledOut;
+        }
+        ASSERT_TRUE(testAndAdd(&filter, i));
+    }
+    ASSERT_GT(numRuledOut, numKeys * 9 / 10);
+
+    BSONObjBuilder builder;
+    filter.appendStats(&builder);
+    BSONObj stats = builder.obj();
+    ASSERT_EQ("ready", stats["state"].str());
+    ASSERT_EQ(numRuledOut, stats["negativeLookups"].numberLong());
+}
+
+TEST_F(WiredTigerUniqueIndexKeyFilterTest, RemembersKeysAddedBeforeLoading) {
+    insertKeys(0, 10);
+
+    WiredTigerUniqueIndexKeyFilter filter(kUri, 10);
+    ASSERT_TRUE(testAndAdd(&filter, 100));
+    ASSERT_TRUE(testAndAdd(&filter, 101));
+
+    filter.startLoading(_conn);
+    filter.waitUntilLoaded();
+    ASSERT_TRUE(testAndAdd(&filter, 5));
+    ASSERT_TRUE(testAndAdd(&filter, 100));
+    ASSERT_TRUE(testAndAdd(&filter, 101));
+}
+
+TEST_F(WiredTigerUniqueIndexKeyFilterTest, SkipsKeysWithoutRecordId) {
+    {
+        WiredTigerSession session(_conn);
+        WT_SESSION* s = session.getSession();
+        WT_CURSOR* c;
+        invariantWTOK(s->open_cursor(s, kUri.c_str(), nullptr, nullptr, &c));
+        insert(c, makeKey(1));
+    }
+    insertKeys(2, 3);
+
+    WiredTigerUniqueIndexKeyFilter filter(kUri, 10);
+    filter.startLoading(_conn);
+    filter.waitUntilLoaded();
+    ASSERT_TRUE(testAndAdd(&filter, 2));
+}
+
+TEST_F(WiredTigerUniqueIndexKeyFilterTest, DisabledFilterRulesOutNothing) {
+    WiredTigerUniqueIndexKeyFilter filter(kUri, 10);
+    filter.startLoading(_conn);
+    filter.waitUntilLoaded();
+    ASSERT_FALSE(testAndAdd(&filter, 1));
+
+    filter.disable();
+    ASSERT_TRUE(testAndAdd(&filter, 2));
+
+    BSONObjBuilder builder;
+    filter.appendStats(&builder);
+    ASSERT_EQ("disabled", builder.obj()["state"].str());
+}
+
+}  // namespace
+}  // namespace mongo
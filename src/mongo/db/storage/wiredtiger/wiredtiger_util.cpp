@@ -39,6 +39,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/snapshot_window_options_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
@@ -387,14 +388,15 @@ int64_t WiredTigerUtil::getIdentSize(WT_SESSION* s, const std::string& uri) {
     return result.getValue();
 }
 
-size_t WiredTigerUtil::getCacheSizeMB(double requestedCacheSizeGB) {
+size_t WiredTigerUtil::getCacheSizeMB(double requestedCacheSizeGB, double reservedGB) {
     double cacheSizeMB;
     const double kMaxSizeCacheMB = 10 * 1000 * 1000;
     if (requestedCacheSizeGB == 0) {
         // Choose a reasonable amount of cache when not explicitly specified by user.
-        // Set a minimum of 256MB, otherwise use 50% of available memory over 1GB.
+        // Set a minimum of 256MB, otherwise use 50% of available memory over 1GB, not counting
+        // memory that has been reserved for other uses.
         ProcessInfo pi;
-        double memSizeMB = pi.getMemSizeMB();
+        double memSizeMB = pi.getMemSizeMB() - 1024 * reservedGB;
         cacheSizeMB = std::max((memSizeMB - 1024) * 0.5, 256.0);
     } else {
         cacheSizeMB = 1024 * requestedCacheSizeGB;
@@ -756,4 +758,31 @@ void WiredTigerUtil::appendSnapshotWindowSettings(WiredTigerKVEngine* engine,
                     oldestTimestamp.toStringPretty());
 }
 
+void WiredTigerUtil::appendCompressedCacheStats(WT_SESSION* session, BSONObjBuilder* bob) {
+    invariant(session);
+    invariant(bob);
+
+    auto getConnectionStat = [&](int statisticsKey) -> long long {
+        auto result =
+            getStatisticsValue(session, "statistics:", "statistics=(fast)", statisticsKey);
+        return result.isOK() ? result.getValue() : 0;
+    };
+
+    const long long bytesReadIntoCache = getConnectionStat(WT_STAT_CONN_CACHE_BYTES_READ);
+    const long long blockBytesRead = getConnectionStat(WT_STAT_CONN_BLOCK_BYTE_READ);
+
+    BSONObjBuilder stats(bob->subobjStart("compressed cache"));
+    stats.append("configured size bytes",
+                 static_cast<long long>(wiredTigerGlobalOptions.compressedCacheSizeGB * 1024 *
+                                        1024 * 1024));
+    stats.append("bytes read into cache", bytesReadIntoCache);
+    stats.append("block bytes read", blockBytesRead);
+    stats.append("compression ratio of pages read",
+                 blockBytesRead > 0 ? static_cast<double>(bytesReadIntoCache) / blockBytesRead
+                                    : 0.0);
+    stats.append("pages read into cache", getConnectionStat(WT_STAT_CONN_CACHE_READ));
+    stats.append("unmodified pages evicted", getConnectionStat(WT_STAT_CONN_CACHE_EVICTION_CLEAN));
+    stats.append("modified pages evicted", getConnectionStat(WT_STAT_CONN_CACHE_EVICTION_DIRTY));
+}
+
 }  // namespace mongo
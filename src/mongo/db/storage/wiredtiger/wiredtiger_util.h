@@ -169,6 +169,22 @@ public:
                                              WiredTigerSession* session,
                                              BSONObjBuilder* bob);
 
+    /**
+     * Appends information about the memory reserved for block-compressed pages outside of the
+     * WiredTiger cache, along with the cache read and eviction statistics needed to size it.
+     *
+     * "compressed cache" : {
+     *      "configured size bytes" : <num>,
+     *      "bytes read into cache" : <num>,
+     *      "block bytes read" : <num>,
+     *      "compression ratio of pages read" : <num>,
+     *      "pages read into cache" : <num>,
+     *      "unmodified pages evicted" : <num>,
+     *      "modified pages evicted" : <num>
+     * }
+     */
+    static void appendCompressedCacheStats(WT_SESSION* session, BSONObjBuilder* bob);
+
     /**
      * Gets the creation metadata string for a collection or index at a given URI. Accepts an
      * OperationContext or session.
@@ -223,9 +239,10 @@ public:
 
     /**
      * Return amount of memory to use for the WiredTiger cache based on either the startup
-     * option chosen or the amount of available memory on the host.
+     * option chosen or the amount of available memory on the host. When no size was requested,
+     * 'reservedGB' is subtracted from the available memory before the default is computed.
      */
-    static size_t getCacheSizeMB(double requestedCacheSizeGB);
+    static size_t getCacheSizeMB(double requestedCacheSizeGB, double reservedGB = 0);
 
     class ErrorAccumulator : public WT_EVENT_HANDLER {
     public:
@@ -349,4 +349,36 @@ TEST(WiredTigerUtilTest, GetStatisticsValueValidKey) {
     ASSERT_EQUALS(0U, result.getValue());
 }
 
+TEST(WiredTigerUtilTest, GetCacheSizeMBHonorsCompressedCacheReservation) {
+    // An explicitly requested cache size is never reduced by the reservation.
+    ASSERT_EQUALS(2048U, WiredTigerUtil::getCacheSizeMB(2, 8));
+
+    // The default cache size shrinks by half of the reserved memory but keeps its minimum.
+    const size_t defaultMB = WiredTigerUtil::getCacheSizeMB(0);
+    const size_t reservedMB = WiredTigerUtil::getCacheSizeMB(0, 1);
+    ASSERT_LTE(reservedMB, defaultMB);
+    ASSERT_GTE(reservedMB, 256U);
+    ASSERT_EQUALS(256U, WiredTigerUtil::getCacheSizeMB(0, 1000 * 1000));
+}
+
+TEST(WiredTigerUtilTest, AppendCompressedCacheStats) {
+    WiredTigerUtilHarnessHelper harnessHelper("statistics=(fast)");
+    WiredTigerRecoveryUnit recoveryUnit(harnessHelper.getSessionCache(),
+                                        harnessHelper.getOplogManager());
+    WiredTigerSession* session = recoveryUnit.getSession();
+
+    BSONObjBuilder bob;
+    WiredTigerUtil::appendCompressedCacheStats(session->getSession(), &bob);
+    BSONObj stats = bob.obj()["compressed cache"].Obj();
+    for (auto&& field : {"configured size bytes",
+                         "bytes read into cache",
+                         "block bytes read",
+                         "compression ratio of pages read",
+                         "pages read into cache",
+                         "unmodified pages evicted",
+                         "modified pages evicted"}) {
+        ASSERT_TRUE(stats.hasField(field)) << field;
+    }
+}
+
 }  // namespace mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/time_support.h"
@@ -112,6 +113,7 @@ void WriteUnitOfWork::commit() {
             sleepFor(Milliseconds(100));
         }
 
+        OperationTrace::Span commitSpan(_opCtx, "storageCommit"_sd);
         _opCtx->recoveryUnit()->runPreCommitHooks(_opCtx);
         _opCtx->recoveryUnit()->commitUnitOfWork();
         _opCtx->_ruState = RecoveryUnitState::kNotInUnitOfWork;
@@ -71,16 +71,6 @@ namespace mongo {
 
 namespace {
 
-// Packet struct
-struct TrafficReaderPacket {
-    uint64_t id;
-    StringData local;
-    StringData remote;
-    Date_t date;
-    uint64_t order;
-    MsgData::ConstView message;
-};
-
 bool readBytes(size_t toRead, char* buf, int fd) {
     while (toRead) {
 #ifdef _WIN32
@@ -109,7 +99,9 @@ bool readBytes(size_t toRead, char* buf, int fd) {
     return true;
 }
 
-boost::optional<TrafficReaderPacket> readPacket(char* buf, int fd) {
+}  // namespace
+
+boost::optional<TrafficReaderPacket> readTrafficRecordingPacket(char* buf, int fd) {
     if (!readBytes(4, buf, fd)) {
         return boost::none;
     }
@@ -134,6 +126,8 @@ boost::optional<TrafficReaderPacket> readPacket(char* buf, int fd) {
         id, local, remote, Date_t::fromMillisSinceEpoch(date), order, message};
 }
 
+namespace {
+
 void getBSONObjFromPacket(TrafficReaderPacket& packet, BSONObjBuilder* builder) {
     {
         // RawOp Field
@@ -220,7 +214,7 @@ BSONArray trafficRecordingFileToBSONArr(const std::string& inputFile) {
     const auto guard = makeGuard([&] { ::close(inputFd); });
 
     auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
-    while (auto packet = readPacket(buf.get(), inputFd)) {
+    while (auto packet = readTrafficRecordingPacket(buf.get(), inputFd)) {
         BSONObjBuilder bob(builder.subobjStart());
         getBSONObjFromPacket(*packet, &bob);
         addOpType(*packet, &bob);
@@ -240,7 +234,7 @@ void trafficRecordingFileToMongoReplayFile(int inputFd, std::ostream& outputStre
     BSONObjBuilder bob;
     auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
 
-    while (auto packet = readPacket(buf.get(), inputFd)) {
+    while (auto packet = readTrafficRecordingPacket(buf.get(), inputFd)) {
         getBSONObjFromPacket(*packet, &bob);
 
         auto obj = bob.asTempObj();
@@ -31,8 +31,29 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/rpc/message.h"
+#include "mongo/util/time_support.h"
+
 namespace mongo {
 
+// A single wire message from a traffic recording, along with the session it was observed on
+struct TrafficReaderPacket {
+    uint64_t id;
+    StringData local;
+    StringData remote;
+    Date_t date;
+    uint64_t order;
+    MsgData::ConstView message;
+};
+
+// Reads the next packet of the traffic recording open as 'fd' into 'buf', which must be able to
+// hold MaxMessageSizeBytes. The returned packet points into 'buf'. Returns boost::none at the end
+// of the recording.
+boost::optional<TrafficReaderPacket> readTrafficRecordingPacket(char* buf, int fd);
+
 // Method for testing, takes the recorded traffic and returns a BSONArray
 BSONArray trafficRecordingFileToBSONArr(const std::string& inputFile);
 
@@ -39,7 +39,10 @@
 #endif
 
 #include "mongo/base/initializer.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/traffic_reader.h"
+#include "mongo/db/traffic_replay.h"
+#include "mongo/transport/transport_layer_manager.h"
 #include "mongo/util/signal_handlers.h"
 #include "mongo/util/text.h"
 
@@ -67,15 +70,26 @@ int main(int argc, char* argv[]) {
     int inputFd = 0;
     std::ofstream outputStream;
 
+    // target to replay the recorded requests against instead of dumping them
+    boost::optional<TrafficReplayOptions> replayOptions;
+
     try {
         // Define the program options
         auto inputStr = "Path to file input file (defaults to stdin)";
         auto outputStr =
             "Path to file that mongotrafficreader will place its output (defaults to stdout)";
+        auto replayStr =
+            "host:port of a mongod or mongos to replay the recorded requests against, in which "
+            "case the output is a latency report per command shape";
+        auto speedupStr =
+            "Factor by which to shorten the recorded time between requests when replaying, 0 to "
+            "replay as fast as possible (defaults to 1)";
         boost::program_options::options_description desc{"Options"};
         desc.add_options()("help,h", "help")(
             "input,i", boost::program_options::value<std::string>(), inputStr)(
-            "output,o", boost::program_options::value<std::string>(), outputStr);
+            "output,o", boost::program_options::value<std::string>(), outputStr)(
+            "replay,r", boost::program_options::value<std::string>(), replayStr)(
+            "speedup,s", boost::program_options::value<double>(), speedupStr);
 
         // Parse the program options
         store(parse_command_line(argc, argv, desc), vm);
@@ -84,7 +98,8 @@ int main(int argc, char* argv[]) {
         // Handle the help option
         if (vm.count("help")) {
             std::cout << "Mongo Traffic Reader Help: \n\n\t./mongotrafficreader "
-                         "-i trafficinput.txt -o mongotrafficreader_dump.bson \n\n"
+                         "-i trafficinput.txt -o mongotrafficreader_dump.bson \n"
+                         "\t./mongotrafficreader -i trafficinput.txt -r localhost:27017 -s 2 \n\n"
                       << desc << std::endl;
             return EXIT_SUCCESS;
         }
@@ -122,12 +137,39 @@ int main(int argc, char* argv[]) {
             outputStream.clear(std::cout.rdstate());
             outputStream.basic_ios<char>::rdbuf(std::cout.rdbuf());
         }
+
+        if (vm.count("replay")) {
+            auto target = HostAndPort::parse(vm["replay"].as<std::string>());
+            if (!target.isOK()) {
+                std::cerr << "Error: Invalid replay target: " << target.getStatus() << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            replayOptions.emplace();
+            replayOptions->target = std::move(target.getValue());
+            if (vm.count("speedup")) {
+                replayOptions->speedup = vm["speedup"].as<double>();
+                if (replayOptions->speedup < 0) {
+                    std::cerr << "Error: speedup must not be negative" << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
     } catch (const boost::program_options::error& ex) {
         std::cerr << ex.what() << '\n';
         return EXIT_FAILURE;
     }
 
-    mongo::trafficRecordingFileToMongoReplayFile(inputFd, outputStream);
+    if (replayOptions) {
+        // The replay connections need a service context with an egress transport layer
+        setGlobalServiceContext(ServiceContext::make());
+        getGlobalServiceContext()->setTransportLayer(
+            transport::TransportLayerManager::makeAndStartDefaultEgressTransportLayer());
+
+        mongo::replayTrafficRecording(inputFd, *replayOptions, outputStream);
+    } else {
+        mongo::trafficRecordingFileToMongoReplayFile(inputFd, outputStream);
+    }
 
     return 0;
 }
@@ -0,0 +1,392 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/traffic_replay.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/db/traffic_reader.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+const char kAppName[] = "mongotrafficreader";
+
+// Commands, which are never replayed, because they depend on the state of the recorded connection
+// or deployment (authentication, cursors, transactions), or would change the configuration of the
+// target rather than its data
+const std::set<StringData> kUnsafeCommands{"abortTransaction",
+                                           "authenticate",
+                                           "commitTransaction",
+                                           "endSessions",
+                                           "fsync",
+                                           "fsyncUnlock",
+                                           "getMore",
+                                           "getnonce",
+                                           "killAllSessions",
+                                           "killAllSessionsByPattern",
+                                           "killCursors",
+                                           "killOp",
+                                           "killSessions",
+                                           "logout",
+                                           "replSetFreeze",
+                                           "replSetReconfig",
+                                           "replSetStepDown",
+                                           "saslContinue",
+                                           "saslStart",
+                                           "setFeatureCompatibilityVersion",
+                                           "setParameter",
+                                           "shutdown",
+                                           "startRecordingTraffic",
+                                           "stopRecordingTraffic"};
+
+// Fields tying a request to the recorded deployment's sessions and cluster time, which the target
+// would reject or misinterpret
+const std::set<StringData> kStrippedFields{"lsid", "txnNumber", "$clusterTime"};
+
+// Maximum number of requests queued for replay on a single session, after which reading the
+// recording waits for the session to catch up
+const size_t kMaxQueuedRequestsPerSession = 1000;
+
+/**
+ * Latencies observed for a command shape, in microseconds.
+ */
+class LatencySamples {
+public:
+    void add(long long micros) {
+        _micros.push_back(micros);
+    }
+
+    void append(StringData fieldName, BSONObjBuilder* builder) {
+        BSONObjBuilder latencies(builder->subobjStart(fieldName));
+        latencies.append("count", static_cast<long long>(_micros.size()));
+        if (_micros.empty()) {
+            return;
+        }
+
+        std::sort(_micros.begin(), _micros.end());
+        long long total = 0;
+        for (auto micros : _micros) {
+            total += micros;
+        }
+        latencies.append("meanMicros", total / static_cast<long long>(_micros.size()));
+        latencies.append("p50Micros", _micros[_micros.size() / 2]);
+        latencies.append("p99Micros", _micros[_micros.size() * 99 / 100]);
+        latencies.append("maxMicros", _micros.back());
+    }
+
+private:
+    std::vector<long long> _micros;
+};
+
+/**
+ * Accumulates the recorded and replayed latencies of every command shape, and the requests that
+ * were skipped. May be used concurrently from several threads.
+ */
+class ReplayReport {
+public:
+    void addRecorded(const std::string& shape, long long micros) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shapes[shape].recorded.add(micros);
+    }
+
+    void addReplayed(const std::string& shape, long long micros, bool succeeded) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& stats = _shapes[shape];
+        stats.replayed.add(micros);
+        if (!succeeded) {
+            stats.errors++;
+        }
+    }
+
+    void addSkipped(StringData commandName) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _skipped[commandName.toString()]++;
+    }
+
+    void write(std::ostream& stream) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto& [shape, stats] : _shapes) {
+            BSONObjBuilder builder;
+            builder.append("shape", shape);
+            builder.append("errors", stats.errors);
+            stats.recorded.append("recorded", &builder);
+            stats.replayed.append("replayed", &builder);
+            stream << builder.obj().jsonString(ExtendedRelaxedV2_0_0) << std::endl;
+        }
+
+        BSONObjBuilder builder;
+        {
+            BSONObjBuilder skipped(builder.subobjStart("skipped"));
+            for (const auto& [commandName, count] : _skipped) {
+                skipped.append(commandName, count);
+            }
+        }
+        stream << builder.obj().jsonString(ExtendedRelaxedV2_0_0) << std::endl;
+    }
+
+private:
+    struct ShapeStats {
+        LatencySamples recorded;
+        LatencySamples replayed;
+        long long errors{0};
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ReplayReport::_mutex");
+    std::map<std::string, ShapeStats> _shapes;
+    std::map<std::string, long long> _skipped;
+};
+
+/**
+ * A request to replay, and when to send it.
+ */
+struct ReplayRequest {
+    OpMsgRequest request;
+    std::string shape;
+    Date_t scheduledAt;
+};
+
+/**
+ * Replays the requests of a single recorded session, in order, on its own connection and thread.
+ */
+class ReplaySession {
+    ReplaySession(const ReplaySession&) = delete;
+    ReplaySession& operator=(const ReplaySession&) = delete;
+
+public:
+    ReplaySession(const HostAndPort& target, ReplayReport* report)
+        : _target(target), _report(report), _thread([this] { _run(); }) {}
+
+    /**
+     * Queues a request to be replayed, waiting while the session has too many requests queued.
+     */
+    void push(ReplayRequest request) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _queueNotFull.wait(lk, [&] { return _queue.size() < kMaxQueuedRequestsPerSession; });
+        _queue.push_back(std::move(request));
+        _queueNotEmpty.notify_one();
+    }
+
+    /**
+     * Waits for all queued requests to be replayed and stops the session's thread.
+     */
+    void finish() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _finished = true;
+            _queueNotEmpty.notify_one();
+        }
+        _thread.join();
+    }
+
+private:
+    void _run() {
+        DBClientConnection conn(true /* autoReconnect */);
+        auto status = conn.connect(_target, kAppName);
+        if (!status.isOK()) {
+            LOGV2_WARNING(5155043,
+                          "Unable to connect to the replay target",
+                          "target"_attr = _target,
+                          "error"_attr = status);
+        }
+
+        while (true) {
+            ReplayRequest request;
+            {
+                stdx::unique_lock<Latch> lk(_mutex);
+                _queueNotEmpty.wait(lk, [&] { return _finished || !_queue.empty(); });
+                if (_queue.empty()) {
+                    return;
+                }
+                request = std::move(_queue.front());
+                _queue.pop_front();
+                _queueNotFull.notify_one();
+            }
+
+            const auto delay = request.scheduledAt - Date_t::now();
+            if (delay > Milliseconds(0)) {
+                sleepFor(delay);
+            }
+
+            Timer timer;
+            bool succeeded = false;
+            try {
+                auto reply = conn.runCommand(std::move(request.request));
+                succeeded = getStatusFromCommandResult(reply->getCommandReply()).isOK();
+            } catch (const DBException&) {
+            }
+            _report->addReplayed(request.shape, timer.micros(), succeeded);
+        }
+    }
+
+    const HostAndPort _target;
+    ReplayReport* const _report;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ReplaySession::_mutex");
+    stdx::condition_variable _queueNotEmpty;
+    stdx::condition_variable _queueNotFull;
+    std::deque<ReplayRequest> _queue;
+    bool _finished{false};
+
+    // Started last, once the state it uses is initialized
+    stdx::thread _thread;
+};
+
+/**
+ * Returns the command name and namespace the request operates on.
+ */
+std::string getCommandShape(const OpMsgRequest& request) {
+    std::string shape =
+        request.getCommandName().toString() + " " + request.getDatabase().toString();
+    const auto firstElement = request.body.firstElement();
+    if (firstElement.type() == String) {
+        shape += "." + firstElement.str();
+    }
+    return shape;
+}
+
+/**
+ * Returns the request's body without the fields tying it to the recorded deployment.
+ */
+BSONObj stripRecordedSessionFields(const BSONObj& body) {
+    BSONObjBuilder builder;
+    for (const auto& element : body) {
+        if (!kStrippedFields.count(element.fieldNameStringData())) {
+            builder.append(element);
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace
+
+void replayTrafficRecording(int inputFd,
+                            const TrafficReplayOptions& options,
+                            std::ostream& reportStream) {
+    ReplayReport report;
+    std::map<uint64_t, std::unique_ptr<ReplaySession>> sessions;
+
+    // Replayed requests, by recorded session and request id, awaiting their recorded response
+    struct PendingRequest {
+        std::string shape;
+        Date_t recordedAt;
+    };
+    std::map<std::pair<uint64_t, int32_t>, PendingRequest> pendingRequests;
+
+    Date_t recordingStart;
+    Date_t replayStart;
+
+    auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
+    while (auto packet = readTrafficRecordingPacket(buf.get(), inputFd)) {
+        if (replayStart == Date_t()) {
+            recordingStart = packet->date;
+            replayStart = Date_t::now();
+        }
+
+        // Responses are only used for the recorded latency of the request they answer
+        if (auto responseTo = packet->message.getResponseToMsgId()) {
+            auto it = pendingRequests.find({packet->id, responseTo});
+            if (it != pendingRequests.end()) {
+                const auto& pending = it->second;
+                report.addRecorded(pending.shape,
+                                   durationCount<Microseconds>(packet->date - pending.recordedAt));
+                pendingRequests.erase(it);
+            }
+            continue;
+        }
+
+        if (packet->message.getNetworkOp() != dbMsg) {
+            report.addSkipped("legacy");
+            continue;
+        }
+
+        Message message;
+        message.setData(dbMsg, packet->message.data(), packet->message.dataLen());
+        // Some header fields like requestId are missing, so the checksum won't match.
+        OpMsg::removeChecksum(&message);
+
+        // Fire-and-forget requests get no response to wait for
+        if (OpMsg::isFlagSet(message, OpMsg::kMoreToCome)) {
+            report.addSkipped("moreToCome");
+            continue;
+        }
+
+        auto request = OpMsgRequest::parseOwned(message);
+        if (kUnsafeCommands.count(request.getCommandName()) ||
+            request.body.hasField("autocommit")) {
+            report.addSkipped(request.getCommandName());
+            continue;
+        }
+
+        request.body = stripRecordedSessionFields(request.body);
+        auto shape = getCommandShape(request);
+
+        auto scheduledAt = replayStart;
+        if (options.speedup > 0) {
+            scheduledAt += Milliseconds(static_cast<long long>(
+                durationCount<Milliseconds>(packet->date - recordingStart) / options.speedup));
+        }
+
+        pendingRequests[{packet->id, packet->message.getId()}] = {shape, packet->date};
+
+        auto& session = sessions[packet->id];
+        if (!session) {
+            session = std::make_unique<ReplaySession>(options.target, &report);
+        }
+        session->push({std::move(request), std::move(shape), scheduledAt});
+    }
+
+    for (auto& [id, session] : sessions) {
+        session->finish();
+    }
+
+    report.write(reportStream);
+}
+
+}  // namespace mongo
@@ -0,0 +1,67 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <iosfwd>
+
+#include "mongo/util/net/hostandport.h"
+
+namespace mongo {
+
+/**
+ * Options controlling how a traffic recording is replayed.
+ */
+struct TrafficReplayOptions {
+    // The mongod or mongos to send the recorded requests to.
+    HostAndPort target;
+
+    // Factor by which the recorded time between requests is shortened. Zero sends the requests of
+    // each session as fast as the target answers them.
+    double speedup = 1.0;
+};
+
+/**
+ * Replays the requests of the traffic recording open as 'inputFd' against 'options.target'.
+ *
+ * Every recorded session is replayed in order on its own connection and thread, with each request
+ * sent at its recorded offset from the start of the recording, divided by 'options.speedup'.
+ * Requests which cannot be replayed safely or meaningfully against another deployment, such as
+ * legacy opcodes, authentication, cursor continuation, multi-document transactions and
+ * administrative commands, are skipped. Session and cluster time fields are stripped from the rest.
+ *
+ * Writes a report to 'reportStream' with one JSON document per command shape, that is command name
+ * and namespace, comparing the recorded and replayed latencies, followed by the number of requests
+ * skipped per command.
+ */
+void replayTrafficRecording(int inputFd,
+                            const TrafficReplayOptions& options,
+                            std::ostream& reportStream);
+
+}  // namespace mongo
@@ -62,6 +62,7 @@
 #include "mongo/db/server_transactions_metrics.h"
 #include "mongo/db/stats/fill_locker_info.h"
 #include "mongo/db/storage/flow_control.h"
+#include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/transaction_participant_gen.h"
 #include "mongo/logv2/log.h"
@@ -1248,6 +1249,19 @@ void TransactionParticipant::Participant::addTransactionOperation(
                           << "server parameter 'transactionSizeLimitBytes' = "
                           << transactionSizeLimitBytes,
             p().transactionOperationBytes <= static_cast<size_t>(transactionSizeLimitBytes));
+
+    // The uncommitted writes stay pinned in the storage engine cache until the transaction ends,
+    // and take up more room there than their oplog size. Fail a transaction that can't fit with
+    // a non-transient error well before it forces eviction onto every other operation.
+    auto cacheThreshold = gTransactionTooLargeForCacheThreshold.load();
+    auto cacheSizeBytes =
+        opCtx->getServiceContext()->getStorageEngine()->getEngine()->getCacheSizeBytes();
+    uassert(ErrorCodes::TransactionTooLargeForCache,
+            str::stream() << "Total size of all transaction operations must be less than "
+                          << "server parameter 'transactionTooLargeForCacheThreshold' = "
+                          << cacheThreshold << " of the storage engine cache",
+            cacheThreshold >= 1.0 || !cacheSizeBytes ||
+                p().transactionOperationBytes <= cacheThreshold * *cacheSizeBytes);
 }
 
 std::vector<repl::ReplOperation>&
@@ -36,6 +36,7 @@
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -55,6 +56,7 @@
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/db/ttl_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 
@@ -77,6 +79,22 @@ ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 
+/**
+ * Reports how far behind the expiry of its documents TTL deletion was left at the end of the last
+ * pass, as the largest span of expiry times, over all TTL indexes, whose documents are still to be
+ * deleted. This is zero if the pass deleted every expired document.
+ */
+class TTLLagMetric : public ServerStatusMetric {
+public:
+    TTLLagMetric() : ServerStatusMetric("ttl.lagSecs") {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        b.appendNumber(_leafName, lagSecs.load());
+    }
+
+    AtomicWord<long long> lagSecs{0};
+} ttlLagMetric;
+
 class TTLMonitor : public BackgroundJob {
 public:
     explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
@@ -111,8 +129,12 @@ public:
 
         while (true) {
             {
-                // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
-                auto deadline = Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+                // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested. A pass
+                // which ran out of time with expired documents left is continued right away.
+                auto deadline = _resumeImmediately
+                    ? Date_t::now()
+                    : Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+                _resumeImmediately = false;
                 stdx::unique_lock<Latch> lk(_stateMutex);
 
                 MONGO_IDLE_THREAD_BLOCK;
@@ -166,6 +188,27 @@ public:
     }
 
 private:
+    /**
+     * The TTL indexes of one collection, and whether each may still index expired documents.
+     */
+    struct TTLCollection {
+        NamespaceString nss;
+        std::vector<BSONObj> indexes;
+        std::vector<bool> hasExpired;
+        Seconds lag{0};
+    };
+
+    /**
+     * The outcome of deleting a batch of expired documents through one TTL index.
+     */
+    struct TTLIndexResult {
+        // True if the batch was full, so that the index may still have expired documents.
+        bool hasExpired = false;
+
+        // The span of expiry times of the documents still to be deleted if 'hasExpired' is true.
+        Seconds lag{0};
+    };
+
     /**
      * Gets all TTL indexes from every collection and performs doTTLForIndex().
      */
@@ -233,35 +276,142 @@ private:
             ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
         }
 
-        for (const auto& it : ttlIndexes) {
+        // Group the indexes by collection, so that collections can be processed in parallel
+        // without contending with themselves.
+        std::vector<TTLCollection> collections;
+        for (const auto& ttlIndex : ttlIndexes) {
+            auto coll = std::find_if(
+                collections.begin(), collections.end(), [&](const TTLCollection& entry) {
+                    return entry.nss == ttlIndex.first;
+                });
+            if (coll == collections.end()) {
+                coll = collections.insert(collections.end(), TTLCollection{ttlIndex.first});
+            }
+            coll->indexes.push_back(ttlIndex.second);
+            coll->hasExpired.push_back(true);
+        }
+
+        // Each round deletes a batch of documents through every index which may still have expired
+        // documents, until none do or the pass has taken as long as the period between passes.
+        const auto passDeadline = Date_t::now() + Seconds(ttlMonitorSleepSecs.load());
+        while (true) {
+            if (!doTTLRound(&opCtx, &collections)) {
+                return;
+            }
+
+            const bool hasExpired =
+                std::any_of(collections.begin(), collections.end(), [](const auto& coll) {
+                    return std::find(coll.hasExpired.begin(), coll.hasExpired.end(), true) !=
+                        coll.hasExpired.end();
+                });
+            if (!hasExpired || Date_t::now() >= passDeadline) {
+                _resumeImmediately = hasExpired;
+                break;
+            }
+
+            const auto batchDelay = Milliseconds(ttlMonitorBatchDelayMS.load());
+            if (batchDelay > Milliseconds(0)) {
+                opCtx.sleepFor(batchDelay);
+            }
+        }
+
+        Seconds lag{0};
+        for (auto&& coll : collections) {
+            lag = std::max(lag, coll.lag);
+        }
+        ttlLagMetric.lagSecs.store(durationCount<Seconds>(lag));
+    }
+
+    /**
+     * Deletes a batch of expired documents through each index of 'collections' which may still
+     * have expired documents, processing up to 'ttlMonitorConcurrency' collections in parallel.
+     * Returns false if the pass should stop because the operation was interrupted.
+     */
+    bool doTTLRound(OperationContext* opCtx, std::vector<TTLCollection>* collections) {
+        const auto numWorkers = std::min(static_cast<size_t>(ttlMonitorConcurrency.load()),
+                                         collections->size());
+        if (numWorkers <= 1) {
+            for (auto&& coll : *collections) {
+                if (!doTTLForCollection(opCtx, &coll)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        AtomicWord<size_t> nextCollection{0};
+        AtomicWord<bool> interrupted{false};
+        std::vector<stdx::thread> workers;
+        for (size_t i = 0; i < numWorkers; ++i) {
+            workers.emplace_back([&] {
+                ThreadClient tc("TTLMonitorWorker", getGlobalServiceContext());
+                AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+                {
+                    stdx::lock_guard<Client> lk(*tc.get());
+                    tc.get()->setSystemOperationKillable(lk);
+                }
+                const auto workerOpCtx = cc().makeOperationContext();
+
+                for (auto next = nextCollection.fetchAndAdd(1);
+                     next < collections->size() && !interrupted.load();
+                     next = nextCollection.fetchAndAdd(1)) {
+                    if (!doTTLForCollection(workerOpCtx.get(), &(*collections)[next])) {
+                        interrupted.store(true);
+                    }
+                }
+            });
+        }
+        for (auto&& worker : workers) {
+            worker.join();
+        }
+        return !interrupted.load();
+    }
+
+    /**
+     * Deletes a batch of expired documents through each index of 'coll' which may still have
+     * expired documents. Returns false if the operation was interrupted.
+     */
+    bool doTTLForCollection(OperationContext* opCtx, TTLCollection* coll) {
+        coll->lag = Seconds(0);
+        for (size_t i = 0; i < coll->indexes.size(); ++i) {
+            if (!coll->hasExpired[i]) {
+                continue;
+            }
+            coll->hasExpired[i] = false;
             try {
-                doTTLForIndex(&opCtx, it.first, it.second);
+                const auto result = doTTLForIndex(opCtx, coll->nss, coll->indexes[i]);
+                coll->hasExpired[i] = result.hasExpired;
+                coll->lag = std::max(coll->lag, result.lag);
             } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
                 LOGV2_WARNING(22537,
                               "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
                               "seconds before doing another pass",
                               "TTLMonitor was interrupted, waiting before doing another pass",
                               "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
+                return false;
             } catch (const DBException& dbex) {
                 LOGV2_ERROR(22538,
                             "Error processing ttl index: {it_second} -- {dbex}",
                             "Error processing TTL index",
-                            "index"_attr = it.second,
+                            "index"_attr = coll->indexes[i],
                             "error"_attr = dbex);
                 // Continue on to the next index.
                 continue;
             }
         }
+        return true;
     }
 
     /**
      * Removes documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. Deletes at most
+     * 'ttlMonitorDeleteBatchSize' documents, if it is set.
      */
-    void doTTLForIndex(OperationContext* opCtx, NamespaceString collectionNSS, BSONObj idx) {
+    TTLIndexResult doTTLForIndex(OperationContext* opCtx,
+                                 NamespaceString collectionNSS,
+                                 BSONObj idx) {
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return {};
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             LOGV2_ERROR(
@@ -270,7 +420,7 @@ private:
                 "Namespace doesn't allow deletes, skipping TTL job",
                 logAttrs(collectionNSS),
                 "index"_attr = idx);
-            return;
+            return {};
         }
 
         const BSONObj key = idx["key"].Obj();
@@ -280,7 +430,7 @@ private:
                         "key for ttl index can only have 1 field, skipping ttl job for: {index}",
                         "Key for ttl index can only have 1 field, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return {};
         }
 
         LOGV2_DEBUG(22533,
@@ -300,11 +450,11 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return {};
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return {};
         }
 
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
@@ -314,7 +464,7 @@ private:
                         "index not found (index build in progress? index dropped?), skipping ttl "
                         "job for: {idx}",
                         "idx"_attr = idx);
-            return;
+            return {};
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -326,7 +476,7 @@ private:
                         "special index can't be used as a ttl index, skipping ttl job for: {index}",
                         "Special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = idx);
-            return;
+            return {};
         }
 
         BSONElement secondsExpireElt = idx[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -338,7 +488,7 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = idx);
-            return;
+            return {};
         }
 
         const Date_t kDawnOfTime =
@@ -363,9 +513,11 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
 
+        const long long batchSize = ttlMonitorDeleteBatchSize.load();
         auto params = std::make_unique<DeleteStageParams>();
         params->isMulti = true;
         params->canonicalQuery = canonicalQuery.getValue().get();
+        params->returnDeleted = batchSize > 0;
 
         auto exec =
             InternalPlanner::deleteWithIndexScan(opCtx,
@@ -378,20 +530,46 @@ private:
                                                  PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
                                                  direction);
 
+        long long numDeleted = 0;
+        BSONObj lastDeleted;
         try {
-            exec->executePlan();
+            if (batchSize == 0) {
+                exec->executePlan();
+                numDeleted = DeleteStage::getNumDeleted(*exec);
+            } else {
+                BSONObj deleted;
+                while (numDeleted < batchSize &&
+                       exec->getNext(&deleted, nullptr) == PlanExecutor::ADVANCED) {
+                    lastDeleted = deleted.getOwned();
+                    ++numDeleted;
+                }
+            }
         } catch (const DBException& exception) {
             LOGV2_WARNING(22543,
                           "ttl query execution for index {index} failed with status: {error}",
                           "TTL query execution failed",
                           "index"_attr = idx,
                           "error"_attr = redact(exception.toStatus()));
-            return;
+            return {};
         }
 
-        const long long numDeleted = DeleteStage::getNumDeleted(*exec);
         ttlDeletedDocuments.increment(numDeleted);
         LOGV2_DEBUG(22536, 1, "deleted: {numDeleted}", "numDeleted"_attr = numDeleted);
+
+        TTLIndexResult result;
+        if (batchSize == 0 || numDeleted < batchSize) {
+            return result;
+        }
+
+        // The index is scanned in order of expiry, so every document remaining to be deleted
+        // expired after the last one which was.
+        result.hasExpired = true;
+        const auto lastExpiry =
+            dotted_path_support::extractElementAtPath(lastDeleted, keyFieldName);
+        if (lastExpiry.type() == BSONType::Date && lastExpiry.date() < expirationTime) {
+            result.lag = duration_cast<Seconds>(expirationTime - lastExpiry.date());
+        }
+        return result;
     }
 
     // Protects the state below.
@@ -402,6 +580,10 @@ private:
     mutable stdx::condition_variable _shuttingDownCV;
 
     bool _shuttingDown = false;
+
+    // Set by a pass which ran out of time with expired documents left, so that the next pass starts
+    // without waiting. Only accessed by the TTL monitor thread.
+    bool _resumeImmediately = false;
 };
 
 void startTTLMonitor(ServiceContext* serviceContext) {
@@ -52,6 +52,8 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/protocol.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/latency_histogram.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -62,6 +64,10 @@ using std::string;
 static TimerStats gleWtimeStats;
 static ServerStatusMetricField<TimerStats> displayGleLatency("getLastError.wtime", &gleWtimeStats);
 
+// Time spent making writes durable and waiting for them to replicate, with microsecond precision.
+static LatencyHistogram syncWaitHistogram("writeConcernSyncWait");
+static LatencyHistogram replicationWaitHistogram("replicationWait");
+
 static Counter64 gleWtimeouts;
 static ServerStatusMetricField<Counter64> gleWtimeoutsDisplay("getLastError.wtimeouts",
                                                               &gleWtimeouts);
@@ -328,6 +334,9 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     result->syncMillis = syncTimer.millis();
+    if (writeConcernWithPopulatedSyncMode.syncMode != WriteConcernOptions::SyncMode::NONE) {
+        syncWaitHistogram.record(Microseconds(syncTimer.micros()));
+    }
 
     // Now wait for replication
 
@@ -343,8 +352,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
+    Timer replicationTimer;
     repl::ReplicationCoordinator::StatusAndDuration replStatus =
         replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
+    replicationWaitHistogram.record(Microseconds(replicationTimer.micros()));
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
         gleWtimeouts.increment();
         if (!writeConcern.getProvenance().isClientSupplied()) {
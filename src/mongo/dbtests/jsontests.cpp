@@ -97,6 +97,29 @@ TEST(JsonStringTest, BasicTest) {
     });
 }
 
+TEST(JsonStringTest, EscapesInLongStrings) {
+    // Place each character needing an escape at every offset of a string long enough to be
+    // scanned a word at a time, and check that it is escaped and that the result parses back.
+    const std::vector<std::pair<std::string, std::string>> escapes = {
+        {"\"", R"(\")"},
+        {"\\", R"(\\)"},
+        {"\n", R"(\n)"},
+        {"\x7f", R"(\u007f)"},
+        {"\xc2\x80", R"(\u0080)"},
+    };
+    for (const auto& [raw, escaped] : escapes) {
+        for (size_t pos = 0; pos <= 24; ++pos) {
+            std::string str = std::string(pos, 'x') + raw + std::string(24 - pos, 'y');
+            BSONObj obj = B().append("a", str).obj();
+            std::string json = obj.jsonString(ExtendedRelaxedV2_0_0);
+            ASSERT_NE(json.find(std::string(pos, 'x') + escaped + std::string(24 - pos, 'y')),
+                      std::string::npos)
+                << json;
+            ASSERT_BSONOBJ_EQ(fromjson(json), obj);
+        }
+    }
+}
+
 /**
  * JavaScript's JSON.stringify(x,null,4) is the goal with our pretty==true formatting.
  * Expected string captured from node.js interpreter.
@@ -46,7 +46,9 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageFetch {
 
@@ -226,6 +228,63 @@ public:
     }
 };
 
+//
+// Test that reading ahead fetches the buffered records but returns them in the child's order.
+//
+class FetchStageReadAheadPreservesChildOrder : public QueryStageFetchBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll =
+            CollectionCatalog::get(&_opCtx).lookupCollectionByNamespace(&_opCtx, nss());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        const int kNumDocs = 5;
+        for (int i = 0; i < kNumDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(kNumDocs), recordIds.size());
+
+        const int oldWindow = internalQueryFetchReadAheadWindow.load();
+        internalQueryFetchReadAheadWindow.store(3);
+        ON_BLOCK_EXIT([&] { internalQueryFetchReadAheadWindow.store(oldWindow); });
+
+        // Feed the fetch stage RecordIds in descending order, as a reverse index scan might.
+        WorkingSet ws;
+        auto mockStage = std::make_unique<QueuedDataStage>(_expCtx.get(), &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            ws.get(id)->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        auto fetchStage =
+            std::make_unique<FetchStage>(_expCtx.get(), &ws, std::move(mockStage), nullptr, coll);
+
+        std::vector<int> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state;
+        while ((state = fetchStage->work(&id)) != PlanStage::IS_EOF) {
+            if (state == PlanStage::ADVANCED) {
+                WorkingSetMember* member = ws.get(id);
+                ASSERT_TRUE(member->hasObj());
+                results.push_back(member->doc.value()["foo"].getInt());
+            }
+        }
+
+        ASSERT(std::vector<int>({4, 3, 2, 1, 0}) == results);
+        ASSERT_EQUALS(size_t(kNumDocs), fetchStage->getStats()->common.advanced);
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_fetch") {}
@@ -233,6 +292,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageReadAheadPreservesChildOrder>();
     }
 };
 
@@ -275,6 +275,29 @@ TEST_F(QueryStageMultiPlanTest, MPSCollectionScanVsHighlySelectiveIXScan) {
     ASSERT_EQUALS(results, N / 10);
 }
 
+TEST_F(QueryStageMultiPlanTest, MPSAbandonsDominatedPlansWhenHalving) {
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    internalQueryPlanEvaluationHalvingWorks.store(10);
+    ON_BLOCK_EXIT([] { internalQueryPlanEvaluationHalvingWorks.store(0); });
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const Collection* coll = ctx.getCollection();
+
+    // The index scan returns a result nearly every time it is worked, against one in ten for the
+    // collection scan, so the latter is abandoned at the first halving and the trial period ends.
+    auto mps = runMultiPlanner(_expCtx.get(), nss, coll, 7);
+    ASSERT_EQ(10U, getBestPlanWorks(mps.get()));
+
+    auto explainStats = mps->getStats();
+    ASSERT_EQ(10U, explainStats->children[1]->common.works);
+}
+
 TEST_F(QueryStageMultiPlanTest, MPSDoesNotCreateActiveCacheEntryImmediately) {
     const int N = 100;
     for (int i = 0; i < N; ++i) {
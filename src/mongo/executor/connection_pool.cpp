@@ -47,6 +47,7 @@
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/lru_cache.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 using namespace fmt::literals;
 
@@ -241,7 +242,7 @@ public:
     auto guardCallback(Callback&& cb) {
         return
             [this, cb = std::forward<Callback>(cb), anchor = shared_from_this()](auto&&... args) {
-                stdx::lock_guard lk(_parent->_mutex);
+                auto lk = _parent->_lockPool();
                 cb(std::forward<decltype(args)>(args)...);
                 updateState();
             };
@@ -267,12 +268,28 @@ public:
      */
     void updateState();
 
+    /**
+     * Runs the controller update scheduled by updateState().
+     *
+     * This should only be called by the ConnectionPool's batched update task
+     */
+    void runScheduledUpdate() {
+        _updateScheduled = false;
+        updateController();
+    }
+
     /**
      * Gets a connection from the specific pool. Sinks a unique_lock from the
      * parent to preserve the lock on _mutex
      */
     Future<ConnectionHandle> getConnection(Milliseconds timeout);
 
+    /**
+     * Starts establishing connections up to the controller's target without waiting on a request,
+     * and keeps the pool from expiring for hostTimeout.
+     */
+    void warmUp();
+
     /**
      * Triggers the shutdown procedure. This function sets isShutdown to true
      * and calls processFailure below with the status provided. This immediately removes this pool
@@ -476,24 +493,60 @@ ConnectionPool::~ConnectionPool() {
     shutdown();
 }
 
+stdx::unique_lock<Latch> ConnectionPool::_lockPool() const {
+    _lockAcquisitions.fetchAndAddRelaxed(1);
+
+    stdx::unique_lock<Latch> lk(_mutex, stdx::try_to_lock);
+    if (lk.owns_lock()) {
+        return lk;
+    }
+
+    Timer timer;
+    lk.lock();
+    _lockContendedAcquisitions.fetchAndAddRelaxed(1);
+    _lockWaitMicros.fetchAndAddRelaxed(timer.micros());
+
+    return lk;
+}
+
+void ConnectionPool::_scheduleControllerUpdate(std::shared_ptr<SpecificPool> pool) {
+    _poolsToUpdate.push_back(std::move(pool));
+    if (_poolsToUpdate.size() > 1) {
+        // A task is already scheduled and will pick this pool up
+        return;
+    }
+
+    ExecutorFuture(ExecutorPtr(_factory->getExecutor()))  //
+        .getAsync([this, anchor = shared_from_this()](Status&& status) mutable {
+            invariant(status);
+
+            auto lk = _lockPool();
+            auto pools = std::exchange(_poolsToUpdate, {});
+            for (const auto& pool : pools) {
+                pool->runScheduledUpdate();
+            }
+        });
+}
+
 void ConnectionPool::shutdown() {
     _factory->shutdown();
 
     // Grab all current pools (under the lock)
     auto pools = [&] {
-        stdx::lock_guard lk(_mutex);
+        auto lk = _lockPool();
+        _inShutdown = true;
         return _pools;
     }();
 
     for (const auto& pair : pools) {
-        stdx::lock_guard lk(_mutex);
+        auto lk = _lockPool();
         pair.second->triggerShutdown(
             Status(ErrorCodes::ShutdownInProgress, "Shutting down the connection pool"));
     }
 }
 
 void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
 
     auto iter = _pools.find(hostAndPort);
 
@@ -506,7 +559,7 @@ void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
 }
 
 void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
 
     for (const auto& pair : _pools) {
         auto& pool = pair.second;
@@ -522,7 +575,7 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
 void ConnectionPool::mutateTags(
     const HostAndPort& hostAndPort,
     const std::function<transport::Session::TagMask(transport::Session::TagMask)>& mutateFunc) {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
 
     auto iter = _pools.find(hostAndPort);
 
@@ -548,7 +601,7 @@ void ConnectionPool::get_forTest(const HostAndPort& hostAndPort,
 SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPort& hostAndPort,
                                                                  transport::ConnectSSLMode sslMode,
                                                                  Milliseconds timeout) {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
 
     auto& pool = _pools[hostAndPort];
     if (!pool) {
@@ -565,8 +618,34 @@ SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPo
     return std::move(connFuture).semi();
 }
 
+void ConnectionPool::warmUp(const std::vector<HostAndPort>& hosts,
+                            transport::ConnectSSLMode sslMode) {
+    // Controllers may ask for a warm-up from their own threads, while we are still being
+    // constructed or already being destroyed
+    auto self = weak_from_this().lock();
+    if (!self) {
+        return;
+    }
+
+    auto lk = _lockPool();
+    if (_inShutdown) {
+        return;
+    }
+
+    for (const auto& host : hosts) {
+        auto& pool = _pools[host];
+        if (pool) {
+            // Pools in use already keep their minimum of connections
+            continue;
+        }
+
+        pool = SpecificPool::make(self, host, sslMode);
+        pool->warmUp();
+    }
+}
+
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
 
     for (const auto& kv : _pools) {
         HostAndPort host = kv.first;
@@ -578,10 +657,15 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->refreshingConnections()};
         stats->updateStatsForHost(_name, host, hostStats);
     }
+
+    stats->updateLockStatsForPool(_name,
+                                  {_lockAcquisitions.load(),
+                                   _lockContendedAcquisitions.load(),
+                                   _lockWaitMicros.load()});
 }
 
 size_t ConnectionPool::getNumConnectionsPerHost(const HostAndPort& hostAndPort) const {
-    stdx::lock_guard lk(_mutex);
+    auto lk = _lockPool();
     auto iter = _pools.find(hostAndPort);
     if (iter != _pools.end()) {
         return iter->second->openConnections();
@@ -635,6 +719,17 @@ size_t ConnectionPool::SpecificPool::requestsPending() const {
     return _requests.size();
 }
 
+void ConnectionPool::SpecificPool::warmUp() {
+    LOGV2_DEBUG(5155033,
+                kDiagnosticLogLevel,
+                "Warming up connection pool",
+                "hostAndPort"_attr = _hostAndPort);
+
+    // Count the warm-up as activity so that the pool lives long enough to see its first requests
+    _lastActiveTime = _parent->_factory->now();
+    updateState();
+}
+
 Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnection(
     Milliseconds timeout) {
 
@@ -678,7 +773,7 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
 
 auto ConnectionPool::SpecificPool::makeHandle(ConnectionInterface* connection) -> ConnectionHandle {
     auto deleter = [this, anchor = shared_from_this()](ConnectionInterface* connection) {
-        stdx::lock_guard lk(_parent->_mutex);
+        auto lk = _parent->_lockPool();
         returnConnection(connection);
         _lastActiveTime = _parent->_factory->now();
         updateState();
@@ -1234,14 +1329,7 @@ void ConnectionPool::SpecificPool::updateState() {
         return;
     }
 
-    ExecutorFuture(ExecutorPtr(_parent->_factory->getExecutor()))  //
-        .getAsync([this, anchor = shared_from_this()](Status&& status) mutable {
-            invariant(status);
-
-            stdx::lock_guard lk(_parent->_mutex);
-            _updateScheduled = false;
-            updateController();
-        });
+    _parent->_scheduleControllerUpdate(shared_from_this());
 }
 
 }  // namespace executor
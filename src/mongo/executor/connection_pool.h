@@ -32,9 +32,11 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "mongo/executor/egress_tag_closer.h"
 #include "mongo/executor/egress_tag_closer_manager.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/session.h"
@@ -249,11 +251,32 @@ public:
                      Milliseconds timeout,
                      GetConnectionCallback cb);
 
+    /**
+     * Creates the pools for those of 'hosts' that have none yet and starts connecting them up to
+     * the controller's target (at least minConnections) ahead of any request, so that the first
+     * requests after startup or a topology change do not all pay for connection setup. Each pool
+     * connects at most maxConnecting at a time.
+     */
+    void warmUp(const std::vector<HostAndPort>& hosts, transport::ConnectSSLMode sslMode);
+
     void appendConnectionStats(ConnectionPoolStats* stats) const;
 
     size_t getNumConnectionsPerHost(const HostAndPort& hostAndPort) const;
 
 private:
+    /**
+     * Acquires _mutex, counting the acquisitions which had to wait for it and for how long. These
+     * counters are reported by appendConnectionStats().
+     */
+    stdx::unique_lock<Latch> _lockPool() const;
+
+    /**
+     * Queues 'pool' for a controller update, must be called with _mutex held. The pools queued in
+     * the meantime are all updated by a single task on the executor, under one acquisition of
+     * _mutex, rather than by a task and an acquisition each.
+     */
+    void _scheduleControllerUpdate(std::shared_ptr<SpecificPool> pool);
+
     std::string _name;
 
     const std::shared_ptr<DependentTypeFactoryInterface> _factory;
@@ -265,8 +288,17 @@ private:
     mutable Mutex _mutex =
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "ExecutorConnectionPool::_mutex");
     PoolId _nextPoolId = 0;
+    bool _inShutdown = false;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 
+    // Pools waiting for the scheduled controller update task, see _scheduleControllerUpdate().
+    std::vector<std::shared_ptr<SpecificPool>> _poolsToUpdate;
+
+    // Contention on _mutex, see _lockPool().
+    mutable AtomicWord<long long> _lockAcquisitions{0};
+    mutable AtomicWord<long long> _lockContendedAcquisitions{0};
+    mutable AtomicWord<long long> _lockWaitMicros{0};
+
     EgressTagCloserManager* _manager;
 };
 
@@ -53,6 +53,14 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     return *this;
 }
 
+ConnectionPoolLockStats& ConnectionPoolLockStats::operator+=(const ConnectionPoolLockStats& other) {
+    acquisitions += other.acquisitions;
+    contendedAcquisitions += other.contendedAcquisitions;
+    waitMicros += other.waitMicros;
+
+    return *this;
+}
+
 void ConnectionPoolStats::updateStatsForHost(std::string pool,
                                              HostAndPort host,
                                              ConnectionStatsPer newStats) {
@@ -76,11 +84,25 @@ void ConnectionPoolStats::updateStatsForHost(std::string pool,
     totalRefreshing += newStats.refreshing;
 }
 
+void ConnectionPoolStats::updateLockStatsForPool(const std::string& pool,
+                                                 const ConnectionPoolLockStats& lockStats) {
+    auto it = statsByPool.find(pool);
+    if (it == statsByPool.end()) {
+        return;
+    }
+
+    it->second.lockStats += lockStats;
+    totalLockStats += lockStats;
+}
+
 void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC) {
     result.appendNumber("totalInUse", totalInUse);
     result.appendNumber("totalAvailable", totalAvailable);
     result.appendNumber("totalCreated", totalCreated);
     result.appendNumber("totalRefreshing", totalRefreshing);
+    result.append("totalLockAcquisitions", totalLockStats.acquisitions);
+    result.append("totalLockContendedAcquisitions", totalLockStats.contendedAcquisitions);
+    result.append("totalLockWaitMicros", totalLockStats.waitMicros);
 
     if (forFTDC) {
         BSONObjBuilder poolBuilder(result.subobjStart("connectionsInUsePerPool"));
@@ -106,6 +128,10 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             poolInfo.appendNumber("poolAvailable", poolStats.available);
             poolInfo.appendNumber("poolCreated", poolStats.created);
             poolInfo.appendNumber("poolRefreshing", poolStats.refreshing);
+            poolInfo.append("poolLockAcquisitions", poolStats.lockStats.acquisitions);
+            poolInfo.append("poolLockContendedAcquisitions",
+                            poolStats.lockStats.contendedAcquisitions);
+            poolInfo.append("poolLockWaitMicros", poolStats.lockStats.waitMicros);
 
             for (const auto& host : poolStats.statsByHost) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
@@ -52,6 +52,18 @@ struct ConnectionStatsPer {
     size_t refreshing = 0u;
 };
 
+/**
+ * Counts the acquisitions of a connection pool's mutex, and how many of them and for how long had
+ * to wait because another thread held it.
+ */
+struct ConnectionPoolLockStats {
+    ConnectionPoolLockStats& operator+=(const ConnectionPoolLockStats& other);
+
+    long long acquisitions = 0;
+    long long contendedAcquisitions = 0;
+    long long waitMicros = 0;
+};
+
 /**
  * Aggregates connection information for the connPoolStats command. Connection pools should
  * use the updateStatsForHost() method to append their host-specific information to this object.
@@ -60,17 +72,25 @@ struct ConnectionStatsPer {
 struct ConnectionPoolStats {
     void updateStatsForHost(std::string pool, HostAndPort host, ConnectionStatsPer newStats);
 
+    /**
+     * Records the mutex contention of a pool. Like for host statistics, pools which never created
+     * a connection are not listed.
+     */
+    void updateLockStatsForPool(const std::string& pool, const ConnectionPoolLockStats& lockStats);
+
     void appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC = false);
 
     size_t totalInUse = 0u;
     size_t totalAvailable = 0u;
     size_t totalCreated = 0u;
     size_t totalRefreshing = 0u;
+    ConnectionPoolLockStats totalLockStats;
 
     using StatsByHost = std::map<HostAndPort, ConnectionStatsPer>;
 
     struct PoolStats final : public ConnectionStatsPer {
         StatsByHost statsByHost;
+        ConnectionPoolLockStats lockStats;
     };
     using StatsByPool = std::map<std::string, PoolStats>;
 
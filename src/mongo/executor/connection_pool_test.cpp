@@ -41,6 +41,7 @@
 #include <fmt/ostream.h>
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -84,6 +85,15 @@ protected:
             .semi();
     }
 
+    /**
+     * Warm up the pool with out-of-line execution, for the same reason as getFromPool()
+     */
+    void warmUp(std::vector<HostAndPort> hosts) {
+        ExecutorFuture(_executor).getAsync([pool = _pool, hosts = std::move(hosts)](auto) {
+            pool->warmUp(hosts, transport::kGlobalSSLMode);
+        });
+    }
+
     void doneWith(ConnectionPool::ConnectionHandle& conn) {
         dynamic_cast<ConnectionImpl*>(conn.get())->indicateSuccess();
 
@@ -716,6 +726,38 @@ TEST_F(ConnectionPoolTest, maxConnectingRespected) {
     doneWith(conn3);
 }
 
+/**
+ * Verify that warming up a pool establishes minConnections ahead of any request, maxConnecting at a
+ * time, and leaves pools already in use alone
+ */
+TEST_F(ConnectionPoolTest, warmUpEstablishesMinConnections) {
+    ConnectionPool::Options options;
+    options.minConnections = 3;
+    options.maxConnecting = 2;
+    auto pool = makePool(options);
+
+    warmUp({HostAndPort()});
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 2u);
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 2u);
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 1u);
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0u);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 3u);
+
+    // The first request finds a connection ready
+    auto connFuture = getFromPool(HostAndPort(), transport::kGlobalSSLMode, Seconds(1));
+    ASSERT_TRUE(connFuture.isReady());
+    auto conn = std::move(connFuture).get();
+
+    warmUp({HostAndPort()});
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0u);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 3u);
+
+    doneWith(conn);
+}
+
 /**
  * Verify that refresh callbacks block new connections, then trigger new connection spawns after
  * they return
@@ -1530,6 +1572,27 @@ TEST_F(ConnectionPoolTest, ReturnAfterShutdown) {
     pool->shutdown();
 }
 
+TEST_F(ConnectionPoolTest, StatsReportLockAcquisitions) {
+    auto pool = makePool();
+
+    auto connFuture = getFromPool(HostAndPort(), transport::kGlobalSSLMode, Seconds(1));
+    ConnectionImpl::pushSetup(Status::OK());
+    auto conn = std::move(connFuture).get();
+    doneWith(conn);
+
+    ConnectionPoolStats stats;
+    pool->appendConnectionStats(&stats);
+    ASSERT_GT(stats.totalLockStats.acquisitions, 0);
+    ASSERT_LTE(stats.totalLockStats.contendedAcquisitions, stats.totalLockStats.acquisitions);
+
+    BSONObjBuilder bob;
+    stats.appendToBSON(bob, false /* forFTDC */);
+    auto obj = bob.obj();
+    auto poolInfo = obj["pools"]["test pool"];
+    ASSERT_EQ(poolInfo["poolLockAcquisitions"].numberLong(), stats.totalLockStats.acquisitions);
+    ASSERT_TRUE(poolInfo["poolLockWaitMicros"].isNumber());
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
@@ -32,13 +32,19 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/string_map.h"
 
 
@@ -69,15 +75,179 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 
 struct FileRotateSink::Impl {
     Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+
+    // Formats a record logged by the sink itself, which cannot go through the log domain.
+    std::string format(LogSeverity severity,
+                       int32_t id,
+                       StringData message,
+                       const DynamicAttributes& attrs);
+
+    // Aborts the process if writing to any of the files failed.
+    void abortIfAnyFileFailed();
+
+    // Background writer thread body, writes batches of records until shutdown.
+    void writerLoop();
+
+    // Blocks until every buffered record has been written.
+    void drain();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Serializes access to the files between the background writer and the logging threads.
+    stdx::mutex filesMutex;
+
+    // Background writer state, all protected by asyncMutex.
+    stdx::mutex asyncMutex;
+    stdx::condition_variable dataAvailable;
+    stdx::condition_variable spaceAvailable;
+    std::string buffer;
+    size_t maxBufferBytes = 0;
+    bool dropOnOverflow = false;
+    bool writing = false;
+    bool shutdown = false;
+    long long droppedSinceLastWrite = 0;
+    stdx::thread writer;
+
+    AtomicWord<long long> dropped{0};
 };
 
+std::string FileRotateSink::Impl::format(LogSeverity severity,
+                                         int32_t id,
+                                         StringData message,
+                                         const DynamicAttributes& attrs) {
+    fmt::memory_buffer formatted;
+    JSONFormatter(nullptr, timestampFormat)
+        .format(formatted,
+                severity,
+                LogComponent::kControl,
+                Date_t::now(),
+                id,
+                getThreadName(),
+                message,
+                TypeErasedAttributeStorage(attrs),
+                LogTag::kNone,
+                LogTruncation::Disabled);
+    return fmt::to_string(formatted);
+}
+
+void FileRotateSink::Impl::abortIfAnyFileFailed() {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::any_of(files.begin(), files.end(), isFailed)) {
+        try {
+            auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+            auto failedEnd = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+
+            auto getFilename = [](const auto& file) -> const auto& {
+                return file.first;
+            };
+            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+            auto end = boost::make_transform_iterator(failedEnd, getFilename);
+            auto sequence = logv2::seqLog(begin, end);
+
+            DynamicAttributes attrs;
+            attrs.add("files", sequence);
+
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+            std::cout << format(LogSeverity::Severe(),
+                                4522200,
+                                "Writing to log file failed, aborting application",
+                                attrs)
+                      << std::endl;
+        } catch (...) {
+            // If the formatting code throws for any reason, ignore and proceed with aborting the
+            // application.
+        }
+
+        std::abort();
+    }
+}
+
+void FileRotateSink::Impl::writerLoop() {
+    // Swapping with the shared buffer lets both strings keep their capacity across batches.
+    std::string batch;
+
+    stdx::unique_lock<stdx::mutex> lk(asyncMutex);
+    while (true) {
+        dataAvailable.wait(lk, [&] { return shutdown || !buffer.empty(); });
+        if (buffer.empty()) {
+            return;
+        }
+
+        batch.swap(buffer);
+        long long droppedCount = std::exchange(droppedSinceLastWrite, 0);
+        writing = true;
+        lk.unlock();
+        spaceAvailable.notify_all();
+
+        {
+            if (droppedCount > 0) {
+                DynamicAttributes attrs;
+                attrs.add("droppedRecords", droppedCount);
+                // LOGV2_WARNING(5155021, "Dropped log records because the log writer fell behind");
+                batch.append(format(LogSeverity::Warning(),
+                                    5155021,
+                                    "Dropped log records because the log writer fell behind",
+                                    attrs));
+                batch.push_back('\n');
+            }
+
+            stdx::lock_guard<stdx::mutex> filesLock(filesMutex);
+            for (auto& file : files) {
+                if (file.second->good()) {
+                    file.second->write(batch.data(), batch.size());
+                    file.second->flush();
+                }
+            }
+            abortIfAnyFileFailed();
+        }
+        batch.clear();
+
+        lk.lock();
+        writing = false;
+        spaceAvailable.notify_all();
+    }
+}
+
+void FileRotateSink::Impl::drain() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(asyncMutex);
+    spaceAvailable.wait(lk, [&] { return buffer.empty() && !writing; });
+}
+
 FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
     : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->asyncMutex);
+            _impl->shutdown = true;
+        }
+        _impl->dataAvailable.notify_one();
+        _impl->writer.join();
+    }
+}
+
+void FileRotateSink::startAsyncWriter(size_t maxBufferBytes, bool dropOnOverflow) {
+    invariant(!_impl->writer.joinable());
+    _impl->maxBufferBytes = maxBufferBytes;
+    _impl->dropOnOverflow = dropOnOverflow;
+    _impl->buffer.reserve(maxBufferBytes);
+    _impl->writer = stdx::thread([impl = _impl.get()] { impl->writerLoop(); });
+}
+
+long long FileRotateSink::droppedRecords() const {
+    return _impl->dropped.load();
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    _impl->drain();
+    stdx::lock_guard<stdx::mutex> filesLock(_impl->filesMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -87,6 +257,8 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus();
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    _impl->drain();
+    stdx::lock_guard<stdx::mutex> filesLock(_impl->filesMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -95,6 +267,9 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    // Records logged before the rotation belong in the old file.
+    _impl->drain();
+    stdx::lock_guard<stdx::mutex> filesLock(_impl->filesMutex);
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -140,47 +315,44 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
-
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
-
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (...) {
-            // If the formatting code throws for any reason, ignore and proceed with aborting the
-            // application.
+    if (_impl->writer.joinable() &&
+        boost::log::extract<LogSeverity>(attributes::severity(), rec).get() <
+            LogSeverity::Error()) {
+        stdx::unique_lock<stdx::mutex> lk(_impl->asyncMutex);
+        const size_t size = formatted_string.size() + 1;
+        if (!_impl->buffer.empty() && _impl->buffer.size() + size > _impl->maxBufferBytes) {
+            if (_impl->dropOnOverflow) {
+                ++_impl->droppedSinceLastWrite;
+                _impl->dropped.addAndFetch(1);
+                return;
+            }
+            _impl->spaceAvailable.wait(lk, [&] {
+                return _impl->buffer.empty() ||
+                    _impl->buffer.size() + size <= _impl->maxBufferBytes;
+            });
         }
 
-        std::abort();
+        const bool wasEmpty = _impl->buffer.empty();
+        _impl->buffer.append(formatted_string);
+        _impl->buffer.push_back('\n');
+        lk.unlock();
+        if (wasEmpty) {
+            _impl->dataAvailable.notify_one();
+        }
+        return;
     }
+
+    // Keep the order of records by writing out anything buffered first.
+    _impl->drain();
+    stdx::lock_guard<stdx::mutex> filesLock(_impl->filesMutex);
+    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+    _impl->abortIfAnyFileFailed();
+}
+
+void FileRotateSink::flush() {
+    _impl->drain();
+    stdx::lock_guard<stdx::mutex> filesLock(_impl->filesMutex);
+    boost::log::sinks::text_ostream_backend::flush();
 }
 
 }  // namespace mongo::logv2
@@ -40,6 +40,10 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// By default records are written and flushed on the logging thread. After startAsyncWriter() they
+// are appended to a buffer instead, and a background thread writes and flushes the buffer in
+// batches. Records of severity Error and above are still written before consume() returns.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
     FileRotateSink(LogTimestampFormat timestampFormat);
@@ -52,6 +56,17 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    // Waits for buffered records to be written, then flushes the files.
+    void flush();
+
+    // Starts writing on a background thread. Once maxBufferBytes of records are waiting to be
+    // written, further records are dropped if dropOnOverflow is set, and otherwise block the
+    // logging thread until there is room. Must be called at most once.
+    void startAsyncWriter(size_t maxBufferBytes, bool dropOnOverflow);
+
+    // Number of records dropped because the buffer of the background writer was full.
+    long long droppedRecords() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
@@ -177,6 +177,11 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         if (!ret.isOK())
             return ret;
         backend->lockedBackend<0>()->auto_flush(true);
+        if (options.fileAsyncWrites) {
+            backend->lockedBackend<0>()->startAsyncWriter(
+                options.fileAsyncBufferBytes,
+                options.fileAsyncOverflowPolicy == ConfigurationOptions::OverflowPolicy::kDrop);
+        }
         backend->setFilter<2>(
             TaggedSeverityFilter(_parent, {LogTag::kStartupWarnings}, LogSeverity::Log()));
 
@@ -39,12 +39,16 @@ public:
     struct ConfigurationOptions {
         enum class RotationMode { kRename, kReopen };
         enum class OpenMode { kTruncate, kAppend };
+        enum class OverflowPolicy { kBlock, kDrop };
 
         bool consoleEnabled{true};
         bool fileEnabled{false};
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        bool fileAsyncWrites{false};
+        size_t fileAsyncBufferBytes{8 * 1024 * 1024};
+        OverflowPolicy fileAsyncOverflowPolicy{OverflowPolicy::kBlock};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
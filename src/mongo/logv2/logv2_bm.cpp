@@ -30,12 +30,15 @@
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
 
 #include "mongo/logv2/component_settings_filter.h"
+#include "mongo/logv2/file_rotate_sink.h"
+#include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
 #include "mongo/logv2/text_formatter.h"
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <boost/filesystem/operations.hpp>
 #include <boost/iostreams/device/null.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
@@ -97,6 +100,60 @@ private:
     bool _shouldInit;
 };
 
+// RAII style helper class for logging JSON to a file through FileRotateSink, like mongod does
+class ScopedFileLogV2Bench {
+public:
+    ScopedFileLogV2Bench(benchmark::State& state, bool async) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            setupAppender(async);
+        }
+    }
+
+    ~ScopedFileLogV2Bench() {
+        if (_shouldInit) {
+            tearDownAppender();
+        }
+    }
+
+private:
+    void setupAppender(bool async) {
+        logv2::LogDomainGlobal::ConfigurationOptions config;
+        config.makeDisabled();
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+
+        _path = boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("logv2_bm_%%%%-%%%%-%%%%-%%%%.log");
+
+        auto backend =
+            boost::make_shared<logv2::FileRotateSink>(logv2::LogTimestampFormat::kISO8601UTC);
+        invariant(backend->addFile(_path.string(), false).isOK());
+        backend->auto_flush(true);
+        if (async) {
+            backend->startAsyncWriter(8 * 1024 * 1024, false);
+        }
+
+        _sink = boost::make_shared<boost::log::sinks::synchronous_sink<logv2::FileRotateSink>>(
+            backend);
+        _sink->set_filter(
+            logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
+                                           logv2::LogManager::global().getGlobalSettings()));
+        _sink->set_formatter(logv2::JSONFormatter());
+        boost::log::core::get()->add_sink(_sink);
+    }
+
+    void tearDownAppender() {
+        boost::log::core::get()->remove_sink(_sink);
+        _sink.reset();
+        boost::filesystem::remove(_path);
+        invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+    }
+
+    boost::shared_ptr<boost::log::sinks::synchronous_sink<logv2::FileRotateSink>> _sink;
+    boost::filesystem::path _path;
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,6 +207,22 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_FileLogV2(benchmark::State& state) {
+    ScopedFileLogV2Bench init(state, false);
+
+    for (auto _ : state)
+        LOGV2(5155022, "file log", "str"_attr = "str"_sd, "int"_attr = 5);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_AsyncFileLogV2(benchmark::State& state) {
+    ScopedFileLogV2Bench init(state, true);
+
+    for (auto _ : state)
+        LOGV2(5155023, "async file log", "str"_attr = "str"_sd, "int"_attr = 5);
+    state.SetItemsProcessed(state.iterations());
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +234,8 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_FileLogV2)->Apply(ThreadCounts);
+BENCHMARK(BM_AsyncFileLogV2)->Apply(ThreadCounts);
 
 }  // namespace
 }  // namespace mongo
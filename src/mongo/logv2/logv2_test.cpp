@@ -44,6 +44,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1703,6 +1704,62 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, AsyncFileRotateSink) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    auto backend = boost::make_shared<FileRotateSink>(LogTimestampFormat::kISO8601UTC);
+    ASSERT_OK(backend->addFile(file_name, false));
+    backend->startAsyncWriter(1024 * 1024, false);
+
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    auto readFile = [&](std::string const& filename) {
+        std::vector<std::string> lines;
+        std::ifstream file(filename);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumRecords = 100;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([] {
+            for (int j = 0; j < kNumRecords; ++j)
+                LOGV2(5155024, "async");
+        });
+    }
+    for (auto&& thread : threads)
+        thread.join();
+
+    // Records are written by the background thread, flushing waits for them.
+    sink->flush();
+    auto lines = readFile(file_name);
+    ASSERT_EQ(lines.size(), size_t(kNumThreads * kNumRecords));
+    for (auto&& line : lines)
+        ASSERT_EQ(line, "async");
+
+    // Errors are written before returning, after the records buffered before them.
+    LOGV2(5155025, "before error");
+    LOGV2_ERROR(5155026, "error");
+    lines = readFile(file_name);
+    ASSERT_EQ(lines.size(), size_t(kNumThreads * kNumRecords + 2));
+    ASSERT_EQ(lines[lines.size() - 2], "before error");
+    ASSERT_EQ(lines.back(), "error");
+
+    // Rotation keeps everything logged before it in the rotated file.
+    LOGV2(5155027, "before rotation");
+    ASSERT_OK(sink->locked_backend()->rotate(true, ".rotated"));
+    ASSERT_EQ(readFile(file_name + ".rotated").back(), "before rotation");
+    ASSERT(readFile(file_name).empty());
+    ASSERT_EQ(backend->droppedRecords(), 0);
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
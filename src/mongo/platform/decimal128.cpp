@@ -32,13 +32,17 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <boost/optional.hpp>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+
 // The Intel C library typedefs wchar_t, but it is a distinct fundamental type
 // in C++, so we #define _WCHAR_T here to prevent the library from trying to typedef.
 #define _WCHAR_T
@@ -191,6 +195,107 @@ BID_UINT128 decimal128ToLibraryType(Decimal128::Value value) {
     dec128.w[kHigh64] = value.high64;
     return dec128;
 }
+
+// Powers of ten below 2^63, for aligning coefficients in the exact arithmetic fast paths.
+constexpr std::uint64_t kPowersOfTen[] = {1ull,
+                                          10ull,
+                                          100ull,
+                                          1000ull,
+                                          10000ull,
+                                          100000ull,
+                                          1000000ull,
+                                          10000000ull,
+                                          100000000ull,
+                                          1000000000ull,
+                                          10000000000ull,
+                                          100000000000ull,
+                                          1000000000000ull,
+                                          10000000000000ull,
+                                          100000000000000ull,
+                                          1000000000000000ull,
+                                          10000000000000000ull,
+                                          100000000000000000ull,
+                                          1000000000000000000ull};
+
+constexpr std::uint64_t kMaxSmallCoefficient = std::numeric_limits<std::int64_t>::max();
+
+/**
+ * A finite decimal whose coefficient fits in 63 bits, which covers most values seen in practice,
+ * such as monetary amounts. Sums and products of these can often be computed exactly with integer
+ * arithmetic. An exact result needs no rounding, raises no flags and takes the ideal exponent, so
+ * it is bit for bit what the library would return.
+ */
+struct SmallDecimal {
+    bool negative;
+    std::int32_t biasedExponent;
+    std::uint64_t coefficient;
+};
+
+boost::optional<SmallDecimal> toSmallDecimal(const Decimal128& dec) {
+    const auto value = dec.getValue();
+    // The two leading bits of the combination field are both set for infinities, NaNs and the
+    // encoding form whose coefficients are too large to be canonical.
+    if (((value.high64 >> 61) & 3) == 3 || dec.getCoefficientHigh() != 0 ||
+        dec.getCoefficientLow() > kMaxSmallCoefficient) {
+        return boost::none;
+    }
+    return SmallDecimal{static_cast<bool>(value.high64 >> 63),
+                        static_cast<std::int32_t>(dec.getBiasedExponent()),
+                        dec.getCoefficientLow()};
+}
+
+/**
+ * Computes 'lhs' + 'rhs' exactly if the coefficient aligned to the smaller exponent still fits,
+ * otherwise returns boost::none.
+ */
+boost::optional<Decimal128> addExact(const SmallDecimal& lhs,
+                                     const SmallDecimal& rhs,
+                                     Decimal128::RoundingMode roundMode) {
+    const auto& larger = lhs.biasedExponent >= rhs.biasedExponent ? lhs : rhs;
+    const auto& smaller = lhs.biasedExponent >= rhs.biasedExponent ? rhs : lhs;
+    const auto shift = static_cast<std::size_t>(larger.biasedExponent - smaller.biasedExponent);
+    if (shift >= std::size(kPowersOfTen) ||
+        larger.coefficient > kMaxSmallCoefficient / kPowersOfTen[shift]) {
+        return boost::none;
+    }
+
+    // Both terms are below 2^63, so neither the sum nor the difference can overflow.
+    const std::uint64_t scaled = larger.coefficient * kPowersOfTen[shift];
+    std::uint64_t coefficient;
+    bool negative;
+    if (larger.negative == smaller.negative) {
+        coefficient = scaled + smaller.coefficient;
+        negative = larger.negative;
+    } else if (scaled >= smaller.coefficient) {
+        coefficient = scaled - smaller.coefficient;
+        negative = larger.negative;
+    } else {
+        coefficient = smaller.coefficient - scaled;
+        negative = smaller.negative;
+    }
+
+    // An exact zero sum of operands with opposite signs is +0 in every rounding mode but
+    // roundTowardNegative (IEEE 754-2008 section 6.3).
+    if (coefficient == 0 && larger.negative != smaller.negative) {
+        negative = roundMode == Decimal128::kRoundTowardNegative;
+    }
+    return Decimal128(negative, smaller.biasedExponent, 0, coefficient);
+}
+
+/**
+ * Computes 'lhs' * 'rhs' exactly if the product of the coefficients fits in 64 bits and the
+ * exponent is in range, otherwise returns boost::none.
+ */
+boost::optional<Decimal128> multiplyExact(const SmallDecimal& lhs, const SmallDecimal& rhs) {
+    constexpr std::uint64_t kMaxFactor = std::numeric_limits<std::uint32_t>::max();
+    const std::int32_t exponent =
+        lhs.biasedExponent + rhs.biasedExponent - Decimal128::kExponentBias;
+    if (lhs.coefficient > kMaxFactor || rhs.coefficient > kMaxFactor || exponent < 0 ||
+        exponent > static_cast<std::int32_t>(Decimal128::kMaxBiasedExponent)) {
+        return boost::none;
+    }
+    return Decimal128(lhs.negative != rhs.negative, exponent, 0, lhs.coefficient * rhs.coefficient);
+}
 }  // namespace
 
 /**
@@ -748,6 +853,14 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    if (auto lhs = toSmallDecimal(*this)) {
+        if (auto rhs = toSmallDecimal(other)) {
+            if (auto sum = addExact(*lhs, *rhs, roundMode)) {
+                return *sum;
+            }
+        }
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
@@ -764,6 +877,15 @@ Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::subtract(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    if (auto lhs = toSmallDecimal(*this)) {
+        if (auto rhs = toSmallDecimal(other)) {
+            rhs->negative = !rhs->negative;
+            if (auto difference = addExact(*lhs, *rhs, roundMode)) {
+                return *difference;
+            }
+        }
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 sub = decimal128ToLibraryType(other.getValue());
     current = bid128_sub(current, sub, roundMode, signalingFlags);
@@ -780,6 +902,14 @@ Decimal128 Decimal128::multiply(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::multiply(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    if (auto lhs = toSmallDecimal(*this)) {
+        if (auto rhs = toSmallDecimal(other)) {
+            if (auto product = multiplyExact(*lhs, *rhs)) {
+                return *product;
+            }
+        }
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 factor = decimal128ToLibraryType(other.getValue());
     current = bid128_mul(current, factor, roundMode, signalingFlags);
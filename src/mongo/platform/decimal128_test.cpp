@@ -1074,6 +1074,34 @@ TEST(Decimal128Test, TestDecimal128MultiplicationCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+void assertSameBits(const Decimal128& result, const Decimal128& expected) {
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128ExactSumOfOppositesIsSignedByRoundingMode) {
+    assertSameBits(Decimal128("1.50").add(Decimal128("-1.5")), Decimal128("0.00"));
+    assertSameBits(Decimal128("1.50").add(Decimal128("-1.5"), Decimal128::kRoundTowardNegative),
+                   Decimal128("-0.00"));
+    assertSameBits(Decimal128("1.50").subtract(Decimal128("1.5"), Decimal128::kRoundTowardNegative),
+                   Decimal128("-0.00"));
+    assertSameBits(Decimal128("-0.0").add(Decimal128("-0")), Decimal128("-0.0"));
+}
+
+TEST(Decimal128Test, TestDecimal128ExactProductOfSmallCoefficients) {
+    assertSameBits(Decimal128("-0.5").multiply(Decimal128("0")), Decimal128("-0.0"));
+    assertSameBits(Decimal128("4294967296").multiply(Decimal128("4294967296")),
+                   Decimal128("18446744073709551616"));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionNeedingRoundingIsInexact) {
+    // The aligned coefficients no longer fit in 64 bits, so the sum must be rounded.
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = Decimal128("9999999999999999999E10").add(Decimal128("1E-20"), &sigFlags);
+    assertSameBits(result, Decimal128("9999999999999999999000000000000000E-5"));
+    ASSERT_TRUE(Decimal128::hasFlag(sigFlags, Decimal128::SignalingFlag::kInexact));
+}
+
 TEST(Decimal128Test, TestDecimal128DivisionCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
@@ -29,10 +29,28 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <chrono>
+
 #include "mongo/base/init.h"
 
 namespace mongo::latch_detail {
 
+namespace {
+
+int64_t nowNanos() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void updateMax(AtomicWord<long long>& max, long long value) noexcept {
+    auto current = max.loadRelaxed();
+    while (value > current && !max.compareAndSwap(&current, value)) {
+    }
+}
+
+}  // namespace
+
 Mutex::Mutex(std::shared_ptr<Data> data) : _data{std::move(data)} {
     invariant(_data);
 
@@ -53,12 +71,20 @@ void Mutex::lock() {
     }
 
     _onContendedLock();
+    const int64_t waitStartNanos =
+        getContentionProfilingSettings().enabled.loadRelaxed() ? nowNanos() : 0;
     _mutex.lock();
     _isLocked = true;
+    if (waitStartNanos) {
+        _recordWait(waitStartNanos);
+    }
     _onSlowLock();
 }
 
 void Mutex::unlock() {
+    if (_holdStartNanos) {
+        _recordHold();
+    }
     _onUnlock();
     _isLocked = false;
     _mutex.unlock();
@@ -77,6 +103,37 @@ StringData Mutex::getName() const {
     return StringData(_data->identity().name());
 }
 
+void Mutex::_startHoldTimer() noexcept {
+    auto& settings = getContentionProfilingSettings();
+    if (MONGO_likely(!settings.enabled.loadRelaxed())) {
+        return;
+    }
+
+    thread_local int acquisitionsUntilSample = 0;
+    if (--acquisitionsUntilSample > 0) {
+        return;
+    }
+    acquisitionsUntilSample = settings.holdSampleInterval.loadRelaxed();
+    _holdStartNanos = nowNanos();
+}
+
+void Mutex::_recordWait(int64_t waitStartNanos) noexcept {
+    const auto waitNanos = nowNanos() - waitStartNanos;
+    auto& counts = _data->counts();
+    counts.timedWaits.fetchAndAddRelaxed(1);
+    counts.waitNanos.fetchAndAddRelaxed(waitNanos);
+    updateMax(counts.maxWaitNanos, waitNanos);
+}
+
+void Mutex::_recordHold() noexcept {
+    const auto holdNanos = nowNanos() - _holdStartNanos;
+    _holdStartNanos = 0;
+    auto& counts = _data->counts();
+    counts.timedHolds.fetchAndAddRelaxed(1);
+    counts.holdNanos.fetchAndAddRelaxed(holdNanos);
+    updateMax(counts.maxHoldNanos, holdNanos);
+}
+
 void Mutex::_onContendedLock() noexcept {
     _data->counts().contended.fetchAndAdd(1);
 
@@ -92,6 +149,7 @@ void Mutex::_onContendedLock() noexcept {
 
 void Mutex::_onQuickLock() noexcept {
     _data->counts().acquired.fetchAndAdd(1);
+    _startHoldTimer();
 
     auto& state = getDiagnosticListenerState();
     if (!state.isFinalized.load()) {
@@ -105,6 +163,7 @@ void Mutex::_onQuickLock() noexcept {
 
 void Mutex::_onSlowLock() noexcept {
     _data->counts().acquired.fetchAndAdd(1);
+    _startHoldTimer();
 
     auto& state = getDiagnosticListenerState();
     if (!state.isFinalized.load()) {
@@ -200,6 +200,24 @@ void installDiagnosticListener() {
     invariant(!state.isFinalized.load());
 }
 
+/**
+ * Settings for latch contention profiling
+ *
+ * While enabled, every Mutex times how long lock() blocks for, and one of every
+ * holdSampleInterval acquisitions on each thread also times how long the latch is held. The
+ * uncontended path only pays for the check of the enabled flag and the sampling counter.
+ */
+struct ContentionProfilingSettings {
+    AtomicWord<bool> enabled{false};
+    AtomicWord<int> holdSampleInterval{100};
+};
+
+inline auto& getContentionProfilingSettings() noexcept {
+    // Make settings immortal
+    static const auto settings = new ContentionProfilingSettings();  // Intentionally leaked!
+    return *settings;
+}
+
 /**
  * This class holds working data for a latchable resource
  *
@@ -231,6 +249,14 @@ private:
         AtomicWord<int> contended{0};
         AtomicWord<int> acquired{0};
         AtomicWord<int> released{0};
+
+        // Only updated while latch contention profiling is enabled.
+        AtomicWord<long long> timedWaits{0};
+        AtomicWord<long long> waitNanos{0};
+        AtomicWord<long long> maxWaitNanos{0};
+        AtomicWord<long long> timedHolds{0};
+        AtomicWord<long long> holdNanos{0};
+        AtomicWord<long long> maxHoldNanos{0};
     };
 
     Counts _counts;
@@ -346,10 +372,18 @@ private:
     void _onSlowLock() noexcept;
     void _onUnlock() noexcept;
 
+    void _startHoldTimer() noexcept;
+    void _recordWait(int64_t waitStartNanos) noexcept;
+    void _recordHold() noexcept;
+
     const std::shared_ptr<Data> _data;
 
     stdx::mutex _mutex;  // NOLINT
     bool _isLocked = false;
+
+    // When the current holder's acquisition was sampled for hold timing, the time it acquired the
+    // latch at. Only accessed while the latch is held.
+    int64_t _holdStartNanos = 0;
 };
 }  // namespace latch_detail
 
@@ -37,6 +37,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/logical_time_validator.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/vector_clock.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
 #include "mongo/rpc/metadata/config_server_metadata.h"
@@ -62,6 +63,7 @@ void readRequestMetadata(OperationContext* opCtx,
     BSONElement clientElem;
     BSONElement impersonationElem;
     BSONElement clientOperationKeyElem;
+    BSONElement traceParentElem;
 
     for (const auto& metadataElem : metadataObj) {
         auto fieldName = metadataElem.fieldNameStringData();
@@ -77,19 +79,26 @@ void readRequestMetadata(OperationContext* opCtx,
             impersonationElem = metadataElem;
         } else if (fieldName == "clientOperationKey"_sd) {
             clientOperationKeyElem = metadataElem;
+        } else if (fieldName == OperationTrace::kMetadataFieldName) {
+            traceParentElem = metadataElem;
         }
     }
 
     AuthorizationSession* authSession = AuthorizationSession::get(opCtx->getClient());
+    auto isInternalRequest = [&] {
+        return TestingProctor::instance().isEnabled() ||
+            authSession->isAuthorizedForActionsOnResource(ResourcePattern::forClusterResource(),
+                                                          ActionType::internal);
+    };
 
-    if (clientOperationKeyElem &&
-        (TestingProctor::instance().isEnabled() ||
-         authSession->isAuthorizedForActionsOnResource(ResourcePattern::forClusterResource(),
-                                                       ActionType::internal))) {
+    if (clientOperationKeyElem && isInternalRequest()) {
         auto opKey = uassertStatusOK(UUID::parse(clientOperationKeyElem));
         opCtx->setOperationKey(std::move(opKey));
     }
 
+    OperationTrace::readFromMetadata(
+        opCtx, traceParentElem, traceParentElem && isInternalRequest());
+
     if (readPreferenceElem) {
         ReadPreferenceSetting::get(opCtx) =
             uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(readPreferenceElem));
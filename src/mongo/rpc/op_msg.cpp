@@ -33,6 +33,7 @@
 
 #include "mongo/rpc/op_msg.h"
 
+#include <algorithm>
 #include <bitset>
 #include <set>
 
@@ -306,6 +307,24 @@ BSONObjBuilder OpMsgBuilder::resumeBody() {
 
 AtomicWord<bool> OpMsgBuilder::disableDupeFieldCheck_forTest{false};
 
+namespace {
+thread_local size_t recentReplySize = 0;
+}  // namespace
+
+size_t OpMsgReplySizeHistory::initialBufferSize() {
+    return std::clamp(recentReplySize + kCrc32Size,
+                      BufBuilder::kDefaultInitSizeBytes,
+                      kMaxInitialBufferSize);
+}
+
+void OpMsgReplySizeHistory::record(size_t replySize) {
+    if (replySize >= recentReplySize) {
+        recentReplySize = replySize;
+    } else {
+        recentReplySize -= (recentReplySize - replySize) / 8;
+    }
+}
+
 Message OpMsgBuilder::finish() {
     const auto size = _buf.len();
     uassert(ErrorCodes::BSONObjectTooLarge,
@@ -209,6 +209,13 @@ public:
         skipHeaderAndFlags();
     }
 
+    /**
+     * Starts with a buffer of 'initialSizeBytes' rather than growing into it through reallocs.
+     */
+    explicit OpMsgBuilder(size_t initialSizeBytes) : _buf(initialSizeBytes) {
+        skipHeaderAndFlags();
+    }
+
     /**
      * See the documentation for DocSequenceBuilder below.
      */
@@ -387,4 +394,30 @@ private:
     const int _sizeOffset;
 };
 
+/**
+ * Remembers how large the replies recently built on the current thread were, so that the next
+ * reply builder can allocate its buffer once, instead of starting small and reallocating as the
+ * reply grows and once more when the checksum is appended.
+ *
+ * The estimate follows larger replies immediately and decays slowly towards smaller ones.
+ */
+class OpMsgReplySizeHistory {
+public:
+    /**
+     * Returns the size of the buffer to start the next reply with.
+     */
+    static size_t initialBufferSize();
+
+    /**
+     * Records the size of a reply that has been built on this thread.
+     */
+    static void record(size_t replySize);
+
+    /**
+     * Upper bound on initialBufferSize(), so that an occasional huge reply does not make every
+     * following reply allocate that much.
+     */
+    static constexpr size_t kMaxInitialBufferSize = 1024 * 1024;
+};
+
 }  // namespace mongo
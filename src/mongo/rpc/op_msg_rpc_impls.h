@@ -53,6 +53,8 @@ private:
 
 class OpMsgReplyBuilder final : public rpc::ReplyBuilderInterface {
 public:
+    OpMsgReplyBuilder() : _builder(OpMsgReplySizeHistory::initialBufferSize()) {}
+
     ReplyBuilderInterface& setRawCommandReply(const BSONObj& reply) override {
         _builder.beginBody().appendElements(reply);
         return *this;
@@ -73,7 +75,9 @@ public:
         _builder.reset();
     }
     Message done() override {
-        return _builder.finish();
+        auto reply = _builder.finish();
+        OpMsgReplySizeHistory::record(reply.size());
+        return reply;
     }
     void reserveBytes(const std::size_t bytes) override {
         _builder.reserveBytes(bytes);
@@ -39,6 +39,8 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/op_msg.h"
+#include "mongo/rpc/op_msg_rpc_impls.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/hex.h"
@@ -926,6 +928,43 @@ TEST(OpMsgTest, ChecksumResizesMessage) {
     OpMsg::parse(msg);
 }
 
+TEST(OpMsgReplySizeHistory, FollowsLargerRepliesAndDecaysTowardsSmallerOnes) {
+    stdx::thread([] {
+        ASSERT_EQ(OpMsgReplySizeHistory::initialBufferSize(), BufBuilder::kDefaultInitSizeBytes);
+
+        // A larger reply is followed immediately, with room left for the checksum.
+        OpMsgReplySizeHistory::record(8 * 1024);
+        ASSERT_EQ(OpMsgReplySizeHistory::initialBufferSize(), 8 * 1024 + 4);
+
+        // Smaller replies only shrink the estimate gradually.
+        OpMsgReplySizeHistory::record(100);
+        const auto afterOneSmallReply = OpMsgReplySizeHistory::initialBufferSize();
+        ASSERT_LT(afterOneSmallReply, 8 * 1024 + 4);
+        ASSERT_GT(afterOneSmallReply, 4 * 1024);
+
+        for (int i = 0; i < 100; ++i) {
+            OpMsgReplySizeHistory::record(100);
+        }
+        ASSERT_EQ(OpMsgReplySizeHistory::initialBufferSize(), BufBuilder::kDefaultInitSizeBytes);
+
+        // Huge replies are capped.
+        OpMsgReplySizeHistory::record(16 * 1024 * 1024);
+        ASSERT_EQ(OpMsgReplySizeHistory::initialBufferSize(),
+                  OpMsgReplySizeHistory::kMaxInitialBufferSize);
+    }).join();
+}
+
+TEST(OpMsgReplyBuilder, StartsWithBufferSizedFromRecentReplies) {
+    stdx::thread([] {
+        OpMsgReplySizeHistory::record(64 * 1024);
+
+        rpc::OpMsgReplyBuilder replyBuilder;
+        replyBuilder.getBodyBuilder().append("ok", 1);
+        auto reply = replyBuilder.done();
+        ASSERT_GTE(reply.sharedBuffer().capacity(), 64 * 1024 + 4);
+    }).join();
+}
+
 TEST(OpMsgTest, EmptyMessageWithChecksumFlag) {
     // Checks that an empty message that would normally be invalid because it's
     // missing a body, is invalid because a checksum was specified in the flag
@@ -37,6 +37,7 @@
 #include <memory>
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -47,6 +48,7 @@
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 using namespace fmt::literals;
 
@@ -157,10 +159,25 @@ std::shared_ptr<Shard> AsyncRequestsSender::RemoteData::getShard() {
 }
 
 void AsyncRequestsSender::RemoteData::executeRequest() {
+    _startMicros = curTimeMicros64();
     scheduleRequest()
         .thenRunOn(*_ars->_subBaton)
         .getAsync([this](StatusWith<RemoteCommandOnAnyCallbackArgs> rcr) {
             _done = true;
+            if (OperationTrace::get(_ars->_opCtx)) {
+                BSONObjBuilder attributes;
+                attributes.append("shardId", _shardId.toString());
+                if (_shardHostAndPort) {
+                    attributes.append("host", _shardHostAndPort->toString());
+                }
+                attributes.append("retries", _retryCount);
+                attributes.append("ok", rcr.isOK() && rcr.getValue().response.isOK());
+                OperationTrace::addSpan(_ars->_opCtx,
+                                        "remoteCall"_sd,
+                                        _startMicros,
+                                        curTimeMicros64(),
+                                        attributes.obj());
+            }
             if (rcr.isOK()) {
                 _ars->_responseQueue.push(
                     {std::move(_shardId), rcr.getValue().response, std::move(_shardHostAndPort)});
@@ -250,6 +250,9 @@ private:
 
         // The number of times we've retried sending the command to this remote.
         int _retryCount = 0;
+
+        // When the request was first scheduled, for the operation's trace.
+        long long _startMicros = 0;
     };
 
     OperationContext* _opCtx;
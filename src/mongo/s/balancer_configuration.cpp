@@ -77,6 +77,7 @@ const char kMode[] = "mode";
 const char kActiveWindow[] = "activeWindow";
 const char kWaitForDelete[] = "_waitForDelete";
 const char kAttemptToBalanceJumboChunks[] = "attemptToBalanceJumboChunks";
+const char kBalanceByLoad[] = "balanceByLoad";
 
 }  // namespace
 
@@ -181,6 +182,11 @@ bool BalancerConfiguration::attemptToBalanceJumboChunks() const {
     return _balancerSettings.attemptToBalanceJumboChunks();
 }
 
+bool BalancerConfiguration::balanceByLoad() const {
+    stdx::lock_guard<Latch> lk(_balancerSettingsMutex);
+    return _balancerSettings.balanceByLoad();
+}
+
 Status BalancerConfiguration::refreshAndCheck(OperationContext* opCtx) {
     // Balancer configuration
     Status balancerSettingsStatus = _refreshBalancerSettings(opCtx);
@@ -387,6 +393,16 @@ StatusWith<BalancerSettingsType> BalancerSettingsType::fromBSON(const BSONObj& o
         settings._attemptToBalanceJumboChunks = attemptToBalanceJumboChunks;
     }
 
+    {
+        bool balanceByLoad;
+        Status status =
+            bsonExtractBooleanFieldWithDefault(obj, kBalanceByLoad, false, &balanceByLoad);
+        if (!status.isOK())
+            return status;
+
+        settings._balanceByLoad = balanceByLoad;
+    }
+
     return settings;
 }
 
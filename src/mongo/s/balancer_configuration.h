@@ -52,7 +52,8 @@ class StatusWith;
  * balancer: {
  *  stopped: <true|false>,
  *  mode: <full|autoSplitOnly|off>,         // Only consulted if "stopped" is missing or false
- *  activeWindow: { start: "<HH:MM>", stop: "<HH:MM>" }
+ *  activeWindow: { start: "<HH:MM>", stop: "<HH:MM>" },
+ *  balanceByLoad: <true|false>             // Also migrate chunks off of the busiest shards
  * }
  */
 class BalancerSettingsType {
@@ -116,6 +117,15 @@ public:
         return _attemptToBalanceJumboChunks;
     }
 
+    /**
+     * Returns whether the balancer should, in addition to evening out chunk counts, schedule
+     * migrations from the most loaded shards to the least loaded ones, based on their operation
+     * rates.
+     */
+    bool balanceByLoad() const {
+        return _balanceByLoad;
+    }
+
 private:
     BalancerSettingsType();
 
@@ -129,6 +139,8 @@ private:
     bool _waitForDelete{false};
 
     bool _attemptToBalanceJumboChunks{false};
+
+    bool _balanceByLoad{false};
 };
 
 /**
@@ -253,6 +265,12 @@ public:
      */
     bool attemptToBalanceJumboChunks() const;
 
+    /**
+     * Returns whether the balancer should also migrate chunks in order to even out the operation
+     * load across the shards.
+     */
+    bool balanceByLoad() const;
+
     /**
      * Returns the max chunk size after which a chunk would be considered jumbo.
      */
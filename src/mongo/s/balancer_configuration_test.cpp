@@ -328,6 +328,15 @@ TEST(BalancerSettingsType, InvalidBalancingWindowFormat) {
                       .getStatus());
 }
 
+TEST(BalancerSettingsType, BalanceByLoad) {
+    ASSERT(!assertGet(BalancerSettingsType::fromBSON(BSONObj())).balanceByLoad());
+    ASSERT(
+        assertGet(BalancerSettingsType::fromBSON(BSON("balanceByLoad" << true))).balanceByLoad());
+    ASSERT_NOT_OK(BalancerSettingsType::fromBSON(BSON("balanceByLoad"
+                                                      << "yes"))
+                      .getStatus());
+}
+
 TEST(ChunkSizeSettingsType, NormalValues) {
     ASSERT_EQ(
         1024 * 1024ULL,
@@ -71,13 +71,13 @@ void checkAllElementsAreOfType(BSONType type, const BSONObj& o) {
 
 ShardVersionMap ChunkMap::constructShardVersionMap(const OID& epoch) const {
     ShardVersionMap shardVersions;
-    ChunkInfoMap::const_iterator current = _chunkMap.cbegin();
+    auto current = _begin();
 
     boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
+    std::shared_ptr<ChunkInfo> lastChunk;
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+    while (current != _end()) {
+        const auto& firstChunkInRange = *current;
         const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
 
         // Tracks the max shard version for the shard on which the current range will reside
@@ -88,78 +88,169 @@ ShardVersionMap ChunkMap::constructShardVersionMap(const OID& epoch) const {
 
         auto& maxShardVersion = shardVersionIt->second.shardVersion;
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId,
-                          &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                             const auto& currentChunk = chunkMapEntry.second;
+        auto rangeLast = current;
+        for (; current != _end(); ++current) {
+            const auto& currentChunk = *current;
 
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+            if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
+                break;
 
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
+            if (currentChunk->getLastmod() > maxShardVersion)
+                maxShardVersion = currentChunk->getLastmod();
 
-                             return false;
-                         });
-
-        const auto rangeLast = std::prev(current);
+            rangeLast = current;
+        }
 
         const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->second->getMax();
 
         // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
+        if (lastChunk &&
+            !SimpleBSONObjComparator::kInstance.evaluate(lastChunk->getMax() == rangeMin)) {
+            if (SimpleBSONObjComparator::kInstance.evaluate(lastChunk->getMax() < rangeMin))
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << _chunkMap.at(ShardKeyPattern::toKeyString(*lastMax))
-                                               ->getRange()
-                                               .toString()
-                                        << " and " << rangeLast->second->getRange().toString());
+                          str::stream()
+                              << "Gap exists in the routing table between chunks "
+                              << lastChunk->getRange().toString() << " and "
+                              << (*rangeLast)->getRange().toString());
             else
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << _chunkMap.at(ShardKeyPattern::toKeyString(*lastMax))
-                                               ->getRange()
-                                               .toString()
-                                        << " and " << rangeLast->second->getRange().toString());
+                          str::stream()
+                              << "Overlap exists in the routing table between chunks "
+                              << lastChunk->getRange().toString() << " and "
+                              << (*rangeLast)->getRange().toString());
         }
 
         if (!firstMin)
             firstMin = rangeMin;
 
-        lastMax = rangeMax;
+        lastChunk = *rangeLast;
 
         // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
         // somewhere, which should have been caught at chunk load time
         invariant(maxShardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (_size > 0) {
         invariant(!shardVersions.empty());
         invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
+        invariant(lastChunk);
 
         checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+        checkAllElementsAreOfType(MaxKey, lastChunk->getMax());
+    }
+
+    return shardVersions;
+}
+
+ShardVersionMap ChunkMap::updateShardVersionMap(const ShardVersionMap& baseShardVersions,
+                                                const Diff& diff,
+                                                const OID& epoch) const {
+    // A chunk which was added and then replaced again by the same diff neither contributes to the
+    // shard versions nor was present in the base map
+    stdx::unordered_set<const ChunkInfo*> added;
+    stdx::unordered_set<const ChunkInfo*> removed;
+    for (const auto& chunk : diff.added)
+        added.insert(chunk.get());
+    for (const auto& chunk : diff.removed)
+        removed.insert(chunk.get());
+
+    std::map<ShardId, ChunkVersion> maxShardVersions;
+    for (const auto& [shardId, targetingInfo] : baseShardVersions)
+        maxShardVersions.emplace(shardId, targetingInfo.shardVersion);
+
+    // Since changes are applied in increasing version order, every chunk added by the diff has a
+    // version greater than or equal to all the chunks in the base map. A shard which received at
+    // least one chunk therefore has its version determined only by the added chunks.
+    std::set<ShardId> shardsWithAddedChunks;
+    for (const auto& chunk : diff.added) {
+        if (removed.count(chunk.get()))
+            continue;
+
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        auto& maxShardVersion =
+            maxShardVersions.emplace(shardId, ChunkVersion(0, 0, epoch)).first->second;
+        if (shardsWithAddedChunks.insert(shardId).second || chunk->getLastmod() > maxShardVersion)
+            maxShardVersion = chunk->getLastmod();
+
+        // All the chunks outside of the ranges of the added chunks are unchanged from the base
+        // map, which was already known to be continuous, so any gap or overlap must be next to
+        // one of the added chunks
+        auto it = _findIntersectingChunk(chunk->getMin());
+        invariant(it != _end());
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                str::stream() << "Overlap exists in the routing table between chunks "
+                              << (*it)->getRange().toString() << " and "
+                              << chunk->getRange().toString(),
+                (*it).get() == chunk.get());
+
+        if (it == _begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            auto prev = it;
+            const auto& prevChunk = *(--prev);
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap exists in the routing table between chunks "
+                                  << prevChunk->getRange().toString() << " and "
+                                  << chunk->getRange().toString(),
+                    SimpleBSONObjComparator::kInstance.evaluate(prevChunk->getMax() ==
+                                                                chunk->getMin()));
+        }
+
+        auto next = it;
+        if (++next == _end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            const auto& nextChunk = *next;
+            if (!SimpleBSONObjComparator::kInstance.evaluate(chunk->getMax() ==
+                                                             nextChunk->getMin())) {
+                uasserted(ErrorCodes::ConflictingOperationInProgress,
+                          str::stream()
+                              << (SimpleBSONObjComparator::kInstance.evaluate(
+                                      chunk->getMax() < nextChunk->getMin())
+                                      ? "Gap"
+                                      : "Overlap")
+                              << " exists in the routing table between chunks "
+                              << chunk->getRange().toString() << " and "
+                              << nextChunk->getRange().toString());
+            }
+        }
+    }
+
+    // A shard which lost the chunk with its max version without receiving a newer one may now
+    // have a lower version or no chunks at all, which can only be determined by a full scan
+    for (const auto& chunk : diff.removed) {
+        if (added.count(chunk.get()))
+            continue;
+
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        if (shardsWithAddedChunks.count(shardId))
+            continue;
+
+        auto it = maxShardVersions.find(shardId);
+        invariant(it != maxShardVersions.end());
+        if (chunk->getLastmod() == it->second)
+            return constructShardVersionMap(epoch);
+    }
+
+    ShardVersionMap shardVersions;
+    for (const auto& [shardId, maxShardVersion] : maxShardVersions) {
+        shardVersions.emplace(shardId, epoch).first->second.shardVersion = maxShardVersion;
     }
 
     return shardVersions;
 }
 
-void ChunkMap::addChunk(const ChunkType& chunk) {
+void ChunkMap::addChunk(const ChunkType& chunk, Diff* diff) {
     const auto chunkMinKeyString = ShardKeyPattern::toKeyString(chunk.getMin());
     const auto chunkMaxKeyString = ShardKeyPattern::toKeyString(chunk.getMax());
 
     // Returns the first chunk with a max key that is > min - implies that the chunk overlaps
     // min
-    const auto low = _chunkMap.upper_bound(chunkMinKeyString);
+    const auto low = _upperBound(chunkMinKeyString);
 
     // Returns the first chunk with a max key that is > max - implies that the next chunk cannot
     // not overlap max
-    const auto high = _chunkMap.upper_bound(chunkMaxKeyString);
+    const auto high = _upperBound(chunkMaxKeyString);
 
     // If we are in the middle of splitting a chunk, for the first few
     // chunks inserted, low == high, because both lookups will point to the
@@ -172,50 +263,147 @@ void ChunkMap::addChunk(const ChunkType& chunk) {
     // empty and the first chunk that is inserted will find that low ==
     // high, but low == chunkMap.end(), and we aren't doing a split in that
     // case.
-    auto foundSingleChunk =
-        ((low == high || std::distance(low, high) == 1) && low != _chunkMap.end());
+    auto foundSingleChunk = low != _end() && (low == high || ++ConstIterator(low) == high);
 
     auto newChunk = std::make_shared<ChunkInfo>(chunk);
     if (foundSingleChunk) {
-        auto chunkBeingReplacedBySplit = low->second;
+        auto chunkBeingReplacedBySplit = *low;
         auto bytesInReplacedChunk =
             chunkBeingReplacedBySplit->getWritesTracker()->getBytesWritten();
         newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
     }
 
-    // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-    _chunkMap.erase(low, high);
+    if (diff) {
+        for (auto it = low; it != high; ++it)
+            diff->removed.push_back(*it);
+        diff->added.push_back(newChunk);
+    }
 
-    // Insert only the chunk itself
-    _chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+    // Replace all chunks in the map, which overlap the chunk we got from the persistent store, with
+    // only the chunk itself
+    _replaceRange(low, high, std::move(newChunk));
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return it->second;
+    if (it != _end())
+        return *it;
 
     return std::shared_ptr<ChunkInfo>();
 }
 
-ChunkMap::ChunkInfoMap::const_iterator ChunkMap::_findIntersectingChunk(
-    const BSONObj& shardKey) const {
-    return _chunkMap.upper_bound(ShardKeyPattern::toKeyString(shardKey));
+ChunkMap::ConstIterator ChunkMap::_upperBound(const std::string& keyString) const {
+    const auto blockIt = std::upper_bound(
+        _blocks.begin(), _blocks.end(), keyString, [](const auto& key, const auto& block) {
+            return key < block->back()->getMaxKeyString();
+        });
+    if (blockIt == _blocks.end())
+        return _end();
+
+    const auto& block = **blockIt;
+    const auto chunkIt =
+        std::upper_bound(block.begin(), block.end(), keyString, [](const auto& key, const auto& c) {
+            return key < c->getMaxKeyString();
+        });
+
+    return ConstIterator(&_blocks, blockIt - _blocks.begin(), chunkIt - block.begin());
+}
+
+ChunkMap::ConstIterator ChunkMap::_lowerBound(const std::string& keyString) const {
+    const auto blockIt = std::lower_bound(
+        _blocks.begin(), _blocks.end(), keyString, [](const auto& block, const auto& key) {
+            return block->back()->getMaxKeyString() < key;
+        });
+    if (blockIt == _blocks.end())
+        return _end();
+
+    const auto& block = **blockIt;
+    const auto chunkIt =
+        std::lower_bound(block.begin(), block.end(), keyString, [](const auto& c, const auto& key) {
+            return c->getMaxKeyString() < key;
+        });
+
+    return ConstIterator(&_blocks, blockIt - _blocks.begin(), chunkIt - block.begin());
+}
+
+ChunkMap::ConstIterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey) const {
+    return _upperBound(ShardKeyPattern::toKeyString(shardKey));
 }
 
-std::pair<ChunkMap::ChunkInfoMap::const_iterator, ChunkMap::ChunkInfoMap::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
-    const auto itMin = _chunkMap.upper_bound(ShardKeyPattern::toKeyString(min));
+std::pair<ChunkMap::ConstIterator, ChunkMap::ConstIterator> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+    const auto itMin = _upperBound(ShardKeyPattern::toKeyString(min));
     const auto itMax = [&]() {
-        auto it = isMaxInclusive ? _chunkMap.upper_bound(ShardKeyPattern::toKeyString(max))
-                                 : _chunkMap.lower_bound(ShardKeyPattern::toKeyString(max));
-        return it == _chunkMap.end() ? it : ++it;
+        auto it = isMaxInclusive ? _upperBound(ShardKeyPattern::toKeyString(max))
+                                 : _lowerBound(ShardKeyPattern::toKeyString(max));
+        return it == _end() ? it : ++it;
     }();
 
     return {itMin, itMax};
 }
 
+void ChunkMap::_replaceRange(ConstIterator low,
+                             ConstIterator high,
+                             std::shared_ptr<ChunkInfo> chunk) {
+    if (_blocks.empty()) {
+        _blocks.push_back(std::make_shared<ChunkBlock>(1, std::move(chunk)));
+        _exclusiveBlocks.insert(_blocks.back().get());
+        _size = 1;
+        return;
+    }
+
+    // The end position of the map is treated as the position past the last chunk of the last
+    // block, so that both ends of the range always refer to an existing block
+    auto toBlockPosition = [&](const ConstIterator& it) -> std::pair<size_t, size_t> {
+        if (it == _end())
+            return {_blocks.size() - 1, _blocks.back()->size()};
+        return {it._block, it._pos};
+    };
+
+    const auto [firstBlock, firstPos] = toBlockPosition(low);
+    const auto [lastBlock, lastPos] = toBlockPosition(high);
+
+    size_t numReplaced = 0;
+    for (size_t i = firstBlock; i <= lastBlock; ++i)
+        numReplaced += _blocks[i]->size();
+    numReplaced -= firstPos + (_blocks[lastBlock]->size() - lastPos);
+
+    std::shared_ptr<ChunkBlock> block;
+    if (firstBlock == lastBlock && _exclusiveBlocks.count(_blocks[firstBlock].get())) {
+        block = _blocks[firstBlock];
+        block->erase(block->begin() + firstPos, block->begin() + lastPos);
+        block->insert(block->begin() + firstPos, std::move(chunk));
+    } else {
+        const auto& first = *_blocks[firstBlock];
+        const auto& last = *_blocks[lastBlock];
+
+        block = std::make_shared<ChunkBlock>();
+        block->reserve(firstPos + 1 + last.size() - lastPos);
+        block->insert(block->end(), first.begin(), first.begin() + firstPos);
+        block->push_back(std::move(chunk));
+        block->insert(block->end(), last.begin() + lastPos, last.end());
+
+        for (size_t i = firstBlock; i <= lastBlock; ++i)
+            _exclusiveBlocks.erase(_blocks[i].get());
+        _exclusiveBlocks.insert(block.get());
+
+        _blocks.erase(_blocks.begin() + firstBlock + 1, _blocks.begin() + lastBlock + 1);
+        _blocks[firstBlock] = block;
+    }
+
+    _size = _size - numReplaced + 1;
+
+    // Keep the blocks bounded in size, so that the cost of copying a shared block stays constant
+    if (block->size() > kMaxChunkBlockSize) {
+        const auto mid = block->begin() + block->size() / 2;
+        auto upperHalf = std::make_shared<ChunkBlock>(mid, block->end());
+        block->erase(mid, block->end());
+        _exclusiveBlocks.insert(upperHalf.get());
+        _blocks.insert(_blocks.begin() + firstBlock + 1, std::move(upperHalf));
+    }
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
@@ -225,7 +413,8 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkMap chunkMap,
-                                         ChunkVersion collectionVersion)
+                                         ChunkVersion collectionVersion,
+                                         ShardVersionMap shardVersions)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
@@ -234,7 +423,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_chunkMap.constructShardVersionMap(collectionVersion.epoch())) {}
+      _shardVersions(std::move(shardVersions)) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -632,7 +821,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(defaultCollator),
                                std::move(unique),
                                ChunkMap{},
-                               {0, 0, epoch})
+                               {0, 0, epoch},
+                               ShardVersionMap{})
         .makeUpdated(chunks);
 }
 
@@ -640,7 +830,13 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
+
+    // Only the blocks of the chunk map which contain changed chunks are copied. When building the
+    // routing table from scratch every chunk is new, so there is nothing to gain from tracking the
+    // changes in order to compute the shard versions incrementally.
     auto chunkMap = _chunkMap;
+    const bool isIncremental = _chunkMap.size() > 0;
+    ChunkMap::Diff diff;
 
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
@@ -657,7 +853,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         invariant(chunkVersion >= collectionVersion);
         collectionVersion = chunkVersion;
 
-        chunkMap.addChunk(chunk);
+        chunkMap.addChunk(chunk, isIncremental ? &diff : nullptr);
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -671,6 +867,10 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    auto shardVersions = isIncremental
+        ? chunkMap.updateShardVersionMap(_shardVersions, diff, collectionVersion.epoch())
+        : chunkMap.constructShardVersionMap(collectionVersion.epoch());
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -678,7 +878,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
-                                collectionVersion));
+                                collectionVersion,
+                                std::move(shardVersions)));
 }
 
 }  // namespace mongo
@@ -40,6 +40,7 @@
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard.h"
 #include "mongo/s/shard_key_pattern.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
@@ -67,23 +68,96 @@ using ShardVersionMap = std::map<ShardId, ShardVersionTargetingInfo>;
 // This class serves as a Facade around how the mapping of ranges to chunks is represented. It also
 // provides a simpler, high-level interface for domain specific operations without exposing the
 // underlying implementation.
+//
+// The chunks are kept sorted by their max key in blocks of at most kMaxChunkBlockSize entries,
+// which are reference counted and shared between copies of the map. Copying a ChunkMap therefore
+// only copies the block pointers and a block is duplicated only when a shared copy of it is about
+// to be modified. This allows the routing table built by an incremental refresh to share all the
+// blocks not touched by the refresh with the routing table it was built from.
 class ChunkMap {
-    // Ordered map from the max for each chunk to an entry describing the chunk
-    using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
+    using ChunkBlock = std::vector<std::shared_ptr<ChunkInfo>>;
+    using ChunkBlockVector = std::vector<std::shared_ptr<ChunkBlock>>;
+
+    // Iterates over the chunks of the map in ascending order of their max key. The end position
+    // is represented by the block index one past the last block.
+    class ConstIterator {
+    public:
+        ConstIterator(const ChunkBlockVector* blocks, size_t block, size_t pos)
+            : _blocks(blocks), _block(block), _pos(pos) {}
+
+        const std::shared_ptr<ChunkInfo>& operator*() const {
+            return (*(*_blocks)[_block])[_pos];
+        }
+
+        ConstIterator& operator++() {
+            if (++_pos == (*_blocks)[_block]->size()) {
+                ++_block;
+                _pos = 0;
+            }
+            return *this;
+        }
+
+        ConstIterator& operator--() {
+            if (_pos == 0) {
+                --_block;
+                _pos = (*_blocks)[_block]->size();
+            }
+            --_pos;
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return _block == other._block && _pos == other._pos;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkMap;
+
+        const ChunkBlockVector* _blocks;
+        size_t _block;
+        size_t _pos;
+    };
 
 public:
+    // Maximum number of chunks stored in a single block of the map
+    static constexpr size_t kMaxChunkBlockSize = 256;
+
+    /**
+     * Accumulates the chunks which were inserted in and removed from a map by a sequence of calls
+     * to addChunk, so that state derived from the chunks can be updated without rescanning the
+     * entire map.
+     */
+    struct Diff {
+        std::vector<std::shared_ptr<ChunkInfo>> added;
+        std::vector<std::shared_ptr<ChunkInfo>> removed;
+    };
+
     ChunkMap() {}
 
+    // Copies share all blocks with the original map, so neither of them may modify those blocks
+    // in place anymore
+    ChunkMap(const ChunkMap& other) : _blocks(other._blocks), _size(other._size) {
+        other._exclusiveBlocks.clear();
+    }
+    ChunkMap& operator=(const ChunkMap&) = delete;
+
+    ChunkMap(ChunkMap&&) = default;
+    ChunkMap& operator=(ChunkMap&&) = default;
+
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(it->second))
+        for (; it != _end(); ++it) {
+            if (!handler(*it))
                 break;
         }
     }
@@ -96,21 +170,68 @@ public:
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
 
         for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(it->second))
+            if (!handler(*it))
                 break;
         }
     }
 
     ShardVersionMap constructShardVersionMap(const OID& epoch) const;
-    void addChunk(const ChunkType& chunk);
+
+    /**
+     * Returns the shard versions of this map, assuming that it was produced by applying 'diff' to
+     * a map whose shard versions were 'baseShardVersions'. Only the neighbourhood of the chunks
+     * added by 'diff' is checked for continuity, because the rest of the map is unchanged. Falls
+     * back to constructShardVersionMap if a shard lost the chunk which determined its version
+     * without gaining a newer one.
+     */
+    ShardVersionMap updateShardVersionMap(const ShardVersionMap& baseShardVersions,
+                                          const Diff& diff,
+                                          const OID& epoch) const;
+
+    /**
+     * Inserts 'chunk' in the map, replacing all the chunks which overlap with it. If 'diff' is
+     * specified, the inserted and replaced chunks are appended to it.
+     */
+    void addChunk(const ChunkType& chunk, Diff* diff = nullptr);
+
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
 private:
-    ChunkInfoMap::const_iterator _findIntersectingChunk(const BSONObj& shardKey) const;
-    std::pair<ChunkInfoMap::const_iterator, ChunkInfoMap::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ConstIterator _begin() const {
+        return ConstIterator(&_blocks, 0, 0);
+    }
+
+    ConstIterator _end() const {
+        return ConstIterator(&_blocks, _blocks.size(), 0);
+    }
+
+    /**
+     * Returns the first chunk whose max key string is greater than (or, for _lowerBound, not less
+     * than) 'keyString'.
+     */
+    ConstIterator _upperBound(const std::string& keyString) const;
+    ConstIterator _lowerBound(const std::string& keyString) const;
+
+    ConstIterator _findIntersectingChunk(const BSONObj& shardKey) const;
+    std::pair<ConstIterator, ConstIterator> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    /**
+     * Replaces the chunks in the range [low, high) with 'chunk', copying the affected blocks if
+     * they are shared with other maps.
+     */
+    void _replaceRange(ConstIterator low, ConstIterator high, std::shared_ptr<ChunkInfo> chunk);
+
+    // Blocks of chunks, ordered by the max key of the chunks they contain. Blocks are never empty.
+    ChunkBlockVector _blocks;
+
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
-    ChunkInfoMap _chunkMap;
+    // Blocks which were created by this map and are not shared with any other map, which can
+    // therefore be modified in place
+    mutable stdx::unordered_set<const ChunkBlock*> _exclusiveBlocks;
 };
 
 /**
@@ -257,7 +378,8 @@ private:
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkMap chunkMap,
-                        ChunkVersion collectionVersion);
+                        ChunkVersion collectionVersion,
+                        ShardVersionMap shardVersions);
 
     ChunkVersion _getVersion(const ShardId& shardName, bool throwOnStaleShard) const;
 
@@ -289,8 +411,6 @@ private:
 
     // The representation of shard versions and staleness indicators for this namespace. If a
     // shard does not exist, it will not have an entry in the map.
-    // Note: this declaration must not be moved before _chunkMap since it is initialized by using
-    // the _chunkMap instance.
     ShardVersionMap _shardVersions;
 
     friend class ChunkManager;
@@ -147,4 +147,101 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestAddChunksBeyondSingleBlock) {
+    ChunkMap chunkMap{};
+
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    chunkMap.addChunk(ChunkType{
+        kNss,
+        ChunkRange{getShardKeyPattern().globalMin(), getShardKeyPattern().globalMax()},
+        version,
+        kThisShard});
+
+    // Split off chunks from the end of the key space in descending order, so that every new
+    // chunk is inserted in front of the previously inserted ones
+    const int numChunks = 3 * ChunkMap::kMaxChunkBlockSize + 1;
+    for (int i = numChunks - 1; i > 0; --i) {
+        version.incMinor();
+        chunkMap.addChunk(ChunkType{kNss,
+                                    ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << i)},
+                                    version,
+                                    kThisShard});
+        version.incMinor();
+        chunkMap.addChunk(ChunkType{kNss,
+                                    ChunkRange{BSON("a" << i),
+                                               i == numChunks - 1 ? getShardKeyPattern().globalMax()
+                                                                  : BSON("a" << i + 1)},
+                                    version,
+                                    kThisShard});
+    }
+
+    ASSERT_EQ(chunkMap.size(), numChunks);
+
+    int count = 0;
+    auto lastMax = getShardKeyPattern().globalMin();
+    chunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        count++;
+        return true;
+    });
+
+    ASSERT_EQ(count, numChunks);
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+
+    for (int i = 1; i < numChunks; ++i) {
+        auto intersectingChunk = chunkMap.findIntersectingChunk(BSON("a" << i));
+        ASSERT(intersectingChunk);
+        ASSERT_BSONOBJ_EQ(intersectingChunk->getMin(), BSON("a" << i));
+    }
+
+    count = 0;
+    chunkMap.forEachOverlappingChunk(BSON("a" << 100), BSON("a" << 700), false, [&](const auto&) {
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, 600);
+}
+
+TEST_F(ChunkMapTest, TestModifyingCopyDoesNotAffectOriginal) {
+    ChunkMap chunkMap{};
+
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    chunkMap.addChunk(ChunkType{
+        kNss, ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)}, version, kThisShard});
+
+    chunkMap.addChunk(
+        ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 100)}, version, kThisShard});
+
+    chunkMap.addChunk(ChunkType{
+        kNss, ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()}, version, kThisShard});
+
+    auto copy = chunkMap;
+
+    version.incMajor();
+    ChunkMap::Diff diff;
+    copy.addChunk(ChunkType{kNss, ChunkRange{BSON("a" << 0), BSON("a" << 50)}, version, kThisShard},
+                  &diff);
+    copy.addChunk(
+        ChunkType{kNss, ChunkRange{BSON("a" << 50), BSON("a" << 100)}, version, kThisShard},
+        &diff);
+
+    ASSERT_EQ(copy.size(), 4);
+    ASSERT_EQ(diff.added.size(), 2);
+    ASSERT_EQ(diff.removed.size(), 1);
+    ASSERT_BSONOBJ_EQ(copy.findIntersectingChunk(BSON("a" << 50))->getMin(), BSON("a" << 50));
+
+    // The original map still contains the chunk, which was split in the copy
+    ASSERT_EQ(chunkMap.size(), 3);
+    ASSERT_BSONOBJ_EQ(chunkMap.findIntersectingChunk(BSON("a" << 50))->getMin(), BSON("a" << 0));
+
+    // Chunks which were not modified are shared between both maps
+    ASSERT_EQ(chunkMap.findIntersectingChunk(BSON("a" << 200)),
+              copy.findIntersectingChunk(BSON("a" << 200)));
+}
+
 }  // namespace mongo
\ No newline at end of file
@@ -37,6 +37,48 @@
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Scrambles the ordinal of a write into a well-distributed 64 bit value, so that the reservoir
+ * sampling in addWrite() can pick a slot without a shared random number generator.
+ */
+uint64_t mixWriteOrdinal(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+}  // namespace
+
+void ChunkWritesTracker::addWrite(const BSONObj& shardKey, uint64_t bytesWritten) {
+    addBytesWritten(bytesWritten);
+    _totalBytesWritten.fetchAndAdd(bytesWritten);
+
+    // Reservoir sampling: the n-th write replaces a random slot of the sample with probability
+    // kMaxSampledKeys / n, which is decided before taking the mutex so that most writes to a busy
+    // chunk never contend on it.
+    const uint64_t ordinal = _writesRecorded.addAndFetch(1);
+    const uint64_t slot =
+        ordinal <= kMaxSampledKeys ? ordinal - 1 : mixWriteOrdinal(ordinal) % ordinal;
+    if (slot >= kMaxSampledKeys) {
+        return;
+    }
+
+    auto ownedKey = shardKey.getOwned();
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    if (_sampledKeys.size() < kMaxSampledKeys) {
+        _sampledKeys.push_back(std::move(ownedKey));
+    } else {
+        _sampledKeys[slot] = std::move(ownedKey);
+    }
+}
+
+std::vector<BSONObj> ChunkWritesTracker::getSampledKeys() const {
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    return _sampledKeys;
+}
 
 uint64_t ChunkWritesTracker::clearBytesWritten() {
     return _bytesWritten.swap(0);
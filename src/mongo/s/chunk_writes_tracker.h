@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -42,6 +46,11 @@ public:
      */
     static constexpr uint64_t kSplitTestFactor = 5;
 
+    /**
+     * The maximum number of shard keys kept in the sample of keys written to the chunk.
+     */
+    static constexpr size_t kMaxSampledKeys = 64;
+
     /**
      * Add more bytes written to the chunk.
      */
@@ -49,6 +58,13 @@ public:
         _bytesWritten.fetchAndAdd(bytesWritten);
     }
 
+    /**
+     * Records a write of the document with the given shard key to the chunk. Adds the bytes written
+     * like addBytesWritten() and also counts them towards getTotalBytesWritten(), and maintains a
+     * uniform sample of the shard keys written to the chunk.
+     */
+    void addWrite(const BSONObj& shardKey, uint64_t bytesWritten);
+
     /**
      * Returns the total number of bytes that have been written to the chunk.
      */
@@ -56,6 +72,28 @@ public:
         return _bytesWritten.loadRelaxed();
     }
 
+    /**
+     * Returns the number of bytes recorded through addWrite() since this tracker was created.
+     * Unlike getBytesWritten(), it is not affected by clearing the bytes written when splitting.
+     */
+    uint64_t getTotalBytesWritten() {
+        return _totalBytesWritten.loadRelaxed();
+    }
+
+    /**
+     * Returns when this tracker started recording writes, so that getTotalBytesWritten() can be
+     * turned into a write rate.
+     */
+    Date_t getTrackingStartTime() const {
+        return _trackingStartTime;
+    }
+
+    /**
+     * Returns the shard keys currently in the sample of keys recorded through addWrite(), in no
+     * particular order. Keys written more often are proportionally more likely to be sampled.
+     */
+    std::vector<BSONObj> getSampledKeys() const;
+
     /**
      * Sets the number of bytes in the tracker to zero and returns the number
      * of bytes in the tracker prior to clearing it.
@@ -86,6 +124,31 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * When this tracker was created.
+     */
+    const Date_t _trackingStartTime = Date_t::now();
+
+    /**
+     * The number of bytes recorded through addWrite(), never cleared.
+     */
+    AtomicWord<unsigned long long> _totalBytesWritten{0};
+
+    /**
+     * The number of writes recorded through addWrite(), used to decide whether a write is sampled.
+     */
+    AtomicWord<unsigned long long> _writesRecorded{0};
+
+    /**
+     * Protects _sampledKeys.
+     */
+    mutable Mutex _sampleMutex = MONGO_MAKE_LATCH("ChunkWritesTracker::_sampleMutex");
+
+    /**
+     * Reservoir sample of the shard keys written to the chunk, at most kMaxSampledKeys of them.
+     */
+    std::vector<BSONObj> _sampledKeys;
+
     /**
      * Protects _splitState when starting a split.
      */
@@ -31,6 +31,9 @@
 
 #include "mongo/s/chunk_writes_tracker.h"
 
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -144,6 +147,49 @@ TEST(ChunkWritesTrackerTest, AcquireSplitLockThenReleaseThenReacquireReturnsTrue
     ASSERT_TRUE(wt.acquireSplitLock());
 }
 
+TEST(ChunkWritesTrackerTest, AddWriteCountsTowardsBytesWrittenAndTotalBytesWritten) {
+    ChunkWritesTracker wt;
+    wt.addWrite(BSON("a" << 1), 4ull);
+    ASSERT_EQ(wt.getBytesWritten(), 4ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 4ull);
+    wt.clearBytesWritten();
+    wt.addWrite(BSON("a" << 2), 3ull);
+    ASSERT_EQ(wt.getBytesWritten(), 3ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 7ull);
+}
+
+TEST(ChunkWritesTrackerTest, AddBytesWrittenDoesNotCountTowardsTotalBytesWritten) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(4ull);
+    ASSERT_EQ(wt.getTotalBytesWritten(), 0ull);
+    ASSERT(wt.getSampledKeys().empty());
+}
+
+TEST(ChunkWritesTrackerTest, SampledKeysHoldAllKeysWhileBelowSampleSize) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 10; ++i) {
+        wt.addWrite(BSON("a" << i), 1ull);
+    }
+    auto keys = wt.getSampledKeys();
+    ASSERT_EQ(keys.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_BSONOBJ_EQ(keys[i], BSON("a" << i));
+    }
+}
+
+TEST(ChunkWritesTrackerTest, SampledKeysAreBoundedAndFollowWriteDistribution) {
+    ChunkWritesTracker wt;
+    // Nine out of ten writes go to the hot key.
+    for (int i = 0; i < 10000; ++i) {
+        wt.addWrite(BSON("a" << (i % 10 == 0 ? i : -1)), 1ull);
+    }
+    auto keys = wt.getSampledKeys();
+    ASSERT_EQ(keys.size(), ChunkWritesTracker::kMaxSampledKeys);
+    auto hotKeys = std::count_if(
+        keys.begin(), keys.end(), [](const BSONObj& key) { return key["a"].numberInt() == -1; });
+    ASSERT_GT(hotKeys, static_cast<long>(keys.size() / 2));
+}
+
 DEATH_TEST(ChunkWritesTrackerTest, ReleaseSplitLockWithoutAcquiringErrors, "Invariant failure") {
     ChunkWritesTracker wt;
     wt.releaseSplitLock();
@@ -200,13 +200,19 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
         Status(ErrorCodes::InternalError,
                str::stream() << "Failed to run remote command request cmd: " << cmdObj);
 
+    // The wait below runs the operation's baton, so poll the connection and run the callback on
+    // this thread instead of handing both off to the executor's threads. The sub baton is shut
+    // down before any wait which does not run it, so that the work then falls back to the executor.
+    auto subBaton = opCtx->getBaton()->makeSubBaton();
+
     auto asyncStatus = _scheduleCommand(
         opCtx,
         readPref,
         dbName,
         maxTimeMSOverride,
         cmdObj,
-        [&response](const RemoteCommandCallbackArgs& args) { response = args.response; });
+        [&response](const RemoteCommandCallbackArgs& args) { response = args.response; },
+        *subBaton);
 
     if (!asyncStatus.isOK()) {
         return asyncStatus.getStatus();
@@ -224,6 +230,7 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
         // Since the callback references local state, it would be invalid for the callback to run
         // after leaving the scope of this method.  Therefore we cancel the callback and wait
         // uninterruptably for the callback to be run.
+        subBaton.shutdown();
         executor->cancel(asyncHandle.handle);
         executor->wait(asyncHandle.handle);
         return e.toStatus();
@@ -421,7 +428,8 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
     StringData dbName,
     Milliseconds maxTimeMSOverride,
     const BSONObj& cmdObj,
-    const TaskExecutor::RemoteCommandCallbackFn& cb) {
+    const TaskExecutor::RemoteCommandCallbackFn& cb,
+    const BatonHandle& baton) {
     ReadPreferenceSetting readPrefWithMinOpTime(readPref);
 
     if (isConfig()) {
@@ -448,7 +456,7 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
         requestTimeout < Milliseconds::max() ? requestTimeout : RemoteCommandRequest::kNoTimeout);
 
     auto executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    auto swHandle = executor->scheduleRemoteCommand(request, cb);
+    auto swHandle = executor->scheduleRemoteCommand(request, cb, baton);
 
     if (!swHandle.isOK()) {
         return swHandle.getStatus();
@@ -122,13 +122,18 @@ private:
         const BSONObj& sort,
         boost::optional<long long> limit) final;
 
+    /**
+     * Schedules 'cmdObj' on the fixed executor. When given a baton, the networking and 'cb' run on
+     * it while the caller waits on the operation, rather than on the executor's threads.
+     */
     StatusWith<AsyncCmdHandle> _scheduleCommand(
         OperationContext* opCtx,
         const ReadPreferenceSetting& readPref,
         StringData dbName,
         Milliseconds maxTimeMSOverride,
         const BSONObj& cmdObj,
-        const executor::TaskExecutor::RemoteCommandCallbackFn& cb);
+        const executor::TaskExecutor::RemoteCommandCallbackFn& cb,
+        const BatonHandle& baton = nullptr);
 
     /**
      * Protects _lastCommittedOpTime.
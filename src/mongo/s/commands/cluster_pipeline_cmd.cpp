@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/s/query/cluster_aggregate.h"
+#include "mongo/s/query/cluster_aggregate_result_cache.h"
 
 namespace mongo {
 namespace {
@@ -136,7 +137,24 @@ public:
                 opCtx, !Pipeline::aggHasWriteStage(_request.body));
 
             auto bob = reply->getBodyBuilder();
+
+            // Repeated identical reads may be answered from the responses to earlier ones.
+            auto resultCache = ClusterAggregateResultCache::get(opCtx);
+            const auto cacheKey = ClusterAggregateResultCache::makeKey(
+                opCtx, _aggregationRequest, _liteParsedPipeline, _request.body);
+            auto clockSource = opCtx->getServiceContext()->getFastClockSource();
+            if (cacheKey) {
+                if (auto cachedResponse = resultCache->lookup(*cacheKey, clockSource->now())) {
+                    bob.appendElements(*cachedResponse);
+                    return;
+                }
+            }
+
             _runAggCommand(opCtx, _dbName, _request.body, &bob);
+
+            if (cacheKey) {
+                resultCache->insert(*cacheKey, bob.asTempObj(), clockSource->now());
+            }
         }
 
         void explain(OperationContext* opCtx,
@@ -45,6 +45,34 @@ const std::set<std::string> supportedCmds{"collStats",
                                           "listCollections",
                                           "listIndexes",
                                           "planCacheListFilters"};
+
+// Aggregation stages which either write or consume cursors established on specific hosts, and
+// which therefore must not be run on more than one member of a shard.
+const std::set<StringData> unsupportedAggStages{
+    "$changeStream"_sd, "$merge"_sd, "$mergeCursors"_sd, "$out"_sd};
+
+/**
+ * Returns true if the aggregation 'cmdObj' only reads, so that running it on more than one host
+ * has no side effects besides the work done by the hosts whose responses are discarded.
+ */
+bool isHedgeableAggregate(const BSONObj& cmdObj) {
+    if (cmdObj.hasField("exchange")) {
+        return false;
+    }
+
+    const auto pipeline = cmdObj["pipeline"];
+    if (pipeline.type() != Array) {
+        return false;
+    }
+
+    for (auto&& stage : pipeline.Obj()) {
+        if (stage.type() != Object || stage.Obj().isEmpty() ||
+            unsupportedAggStages.count(stage.Obj().firstElementFieldNameStringData())) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace
 
 boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeOptions(
@@ -56,7 +84,7 @@ boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeO
 
     auto cmdName(cmdObj.firstElement().fieldNameStringData().toString());
 
-    if (supportedCmds.count(cmdName)) {
+    if (supportedCmds.count(cmdName) || (cmdName == "aggregate" && isHedgeableAggregate(cmdObj))) {
         return executor::RemoteCommandRequestOnAny::HedgeOptions{1,
                                                                  gMaxTimeMSForHedgedReads.load()};
     }
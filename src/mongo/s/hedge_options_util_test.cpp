@@ -122,10 +122,47 @@ TEST_F(HedgeOptionsUtilTestFixture, ImplicitOperationHedging) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true);
 }
 
-TEST_F(HedgeOptionsUtilTestFixture, BlacklistAggregate) {
+TEST_F(HedgeOptionsUtilTestFixture, ReadOnlyAggregate) {
     const auto parameters = BSONObj();
+    const auto cmdObj = BSON("aggregate" << kCollName << "pipeline"
+                                         << BSON_ARRAY(BSON("$match" << BSON("x" << 1))
+                                                       << BSON("$group" << BSON("_id"
+                                                                                << "$y")))
+                                         << "cursor" << BSONObj());
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+
+    checkHedgeOptions(parameters, cmdObj, rspObj, true);
+}
+
+TEST_F(HedgeOptionsUtilTestFixture, BlacklistAggregateWithUnsupportedStages) {
+    const auto parameters = BSONObj();
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+
+    for (auto&& stage : {BSON("$out"
+                              << "targetColl"),
+                         BSON("$merge"
+                              << "targetColl"),
+                         BSON("$mergeCursors" << BSONObj()),
+                         BSON("$changeStream" << BSONObj())}) {
+        const auto cmdObj = BSON("aggregate" << kCollName << "pipeline"
+                                             << BSON_ARRAY(BSON("$match" << BSONObj()) << stage)
+                                             << "cursor" << BSONObj());
+        checkHedgeOptions(parameters, cmdObj, rspObj, false);
+    }
+
+    // The pipeline must be a well-formed array of stages
     const auto cmdObj =
         BSON("aggregate" << kCollName << "pipeline" << BSONObj() << "cursor" << BSONObj());
+    checkHedgeOptions(parameters, cmdObj, rspObj, false);
+}
+
+TEST_F(HedgeOptionsUtilTestFixture, BlacklistGetMore) {
+    const auto parameters = BSONObj();
+    const auto cmdObj = BSON("getMore" << 123LL << "collection" << kCollName);
     const auto rspObj = BSON("mode"
                              << "nearest"
                              << "hedge" << BSONObj());
@@ -35,7 +35,9 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -308,6 +310,11 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // For a sorted merge whose sort key can be KeyString-encoded, the encoded sort key of each
+        // result in 'docBuffer', in the same order. Sort keys are extracted and encoded once, when
+        // a batch is buffered, so that the merge queue compares them with a memcmp.
+        std::queue<KeyString::Value> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -318,14 +325,22 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // The number of results in the most recently received batch. Used to bound how far ahead
+        // of consumption getMores are requested when prefetching.
+        size_t lastBatchSize = 0;
     };
 
     class MergingComparator {
     public:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
                           const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+                          bool compareWholeSortKey,
+                          bool compareKeyStrings)
+            : _remotes(remotes),
+              _sort(sort),
+              _compareWholeSortKey(compareWholeSortKey),
+              _compareKeyStrings(compareKeyStrings) {}
 
         bool operator()(const size_t& lhs, const size_t& rhs);
 
@@ -338,6 +353,10 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // When true, remotes are compared by the pre-encoded keys in their 'sortKeyBuffer' rather
+        // than by extracting and comparing the $sortKey of their next results.
+        const bool _compareKeyStrings;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -372,6 +391,15 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * If 'internalQueryAsyncResultsMergerPrefetchBatches' is positive, asks the remote at
+     * 'remoteIndex' for its next batch even though it still has buffered results, as long as it
+     * has no outstanding request and fewer than that many batches' worth of results buffered.
+     * Only applies to non-tailable cursors outside of multi-statement transactions. Any error
+     * scheduling the request is stored as the remote's status.
+     */
+    void _prefetchNextBatchIfAllowed(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -488,6 +516,11 @@ private:
 
     // The top of this priority queue is the index into '_remotes' for the remote host that has the
     // next document to return, according to the sort order. Used only if there is a sort.
+    // The ordering used to KeyString-encode sort keys for the merge queue. Not set if there is no
+    // sort, or if the sort pattern has too many fields to be described by an Ordering, in which
+    // case the merge queue compares the $sortKey values directly.
+    const boost::optional<Ordering> _sortKeyOrdering;
+
     std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
@@ -0,0 +1,250 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_aggregate_result_cache.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterAggregateResultCache =
+    ServiceContext::declareDecoration<ClusterAggregateResultCache>();
+
+// Stages which only transform their input, so that running the same pipeline again over the same
+// data produces the same results. Stages with sub-pipelines are left out, as are those which
+// report on the state of the server rather than on the contents of a collection.
+const StringDataSet kCacheableStages{"$addFields",
+                                     "$bucket",
+                                     "$bucketAuto",
+                                     "$count",
+                                     "$group",
+                                     "$limit",
+                                     "$match",
+                                     "$project",
+                                     "$replaceRoot",
+                                     "$replaceWith",
+                                     "$set",
+                                     "$skip",
+                                     "$sort",
+                                     "$sortByCount",
+                                     "$unset",
+                                     "$unwind"};
+
+// Operators whose results vary between runs over the same data.
+const StringDataSet kVolatileOperators{"$accumulator", "$function", "$rand", "$where"};
+
+// Fields of the aggregate command which do not influence its results.
+const StringDataSet kIgnoredCommandFields{"$audit",
+                                          "$client",
+                                          "$clusterTime",
+                                          "$configServerState",
+                                          "comment",
+                                          "lsid",
+                                          "maxTimeMS",
+                                          "txnNumber"};
+
+bool containsVolatileExpression(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        if (kVolatileOperators.count(elem.fieldNameStringData())) {
+            return true;
+        }
+
+        switch (elem.type()) {
+            case BSONType::Object:
+            case BSONType::Array:
+                if (containsVolatileExpression(elem.Obj())) {
+                    return true;
+                }
+                break;
+            case BSONType::String:
+                if (elem.valueStringData().startsWith("$$NOW") ||
+                    elem.valueStringData().startsWith("$$CLUSTER_TIME")) {
+                    return true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+bool isCacheableReadConcern(const repl::ReadConcernArgs& readConcernArgs) {
+    // Reads which must observe a particular point in time would be answered with results which
+    // may predate it.
+    if (readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime()) {
+        return false;
+    }
+
+    switch (readConcernArgs.getLevel()) {
+        case repl::ReadConcernLevel::kLocalReadConcern:
+        case repl::ReadConcernLevel::kAvailableReadConcern:
+        case repl::ReadConcernLevel::kMajorityReadConcern:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t entrySize(const std::string& key, const BSONObj& response) {
+    return key.size() + response.objsize();
+}
+
+}  // namespace
+
+ClusterAggregateResultCache* ClusterAggregateResultCache::get(ServiceContext* service) {
+    return &getClusterAggregateResultCache(service);
+}
+
+ClusterAggregateResultCache* ClusterAggregateResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<std::string> ClusterAggregateResultCache::makeKey(
+    OperationContext* opCtx,
+    const AggregationRequest& request,
+    const LiteParsedPipeline& liteParsedPipeline,
+    const BSONObj& cmdObj) {
+    if (internalQueryClusterAggregateResultCacheTTLMillis.load() <= 0) {
+        return boost::none;
+    }
+
+    if (request.getExplain() || request.isFromMongos() || request.getExchangeSpec() ||
+        liteParsedPipeline.hasChangeStream() || opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (!isCacheableReadConcern(readConcernArgs)) {
+        return boost::none;
+    }
+
+    for (auto&& stage : request.getPipeline()) {
+        if (!kCacheableStages.count(stage.firstElementFieldNameStringData()) ||
+            containsVolatileExpression(stage)) {
+            return boost::none;
+        }
+    }
+
+    // The read concern may have been supplied by the cluster-wide default rather than by the
+    // command itself, so it is added to the key separately.
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", request.getNamespaceString().ns());
+    keyBuilder.append("readConcern", readConcernArgs.toBSONInner());
+    {
+        BSONObjBuilder cmdBuilder(keyBuilder.subobjStart("cmd"));
+        for (auto&& elem : cmdObj) {
+            if (!kIgnoredCommandFields.count(elem.fieldNameStringData())) {
+                cmdBuilder.append(elem);
+            }
+        }
+    }
+
+    const auto key = keyBuilder.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+boost::optional<BSONObj> ClusterAggregateResultCache::lookup(const std::string& key, Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        _numMisses.fetchAndAdd(1);
+        return boost::none;
+    }
+
+    if (it->second.expiresAt <= now) {
+        _erase(lk, it);
+        _numMisses.fetchAndAdd(1);
+        return boost::none;
+    }
+
+    _numHits.fetchAndAdd(1);
+    return it->second.response;
+}
+
+void ClusterAggregateResultCache::insert(const std::string& key,
+                                         const BSONObj& response,
+                                         Date_t now) {
+    const auto ttl = internalQueryClusterAggregateResultCacheTTLMillis.load();
+    const auto maxBytes = internalQueryClusterAggregateResultCacheMaxBytes.load();
+    if (ttl <= 0 || entrySize(key, response) > static_cast<size_t>(maxBytes)) {
+        return;
+    }
+
+    // A response whose cursor is still open only holds the first batch of the results.
+    const auto cursor = response["cursor"];
+    if (cursor.type() != BSONType::Object || cursor.Obj()["id"].safeNumberLong() != 0) {
+        return;
+    }
+
+    Entry entry{response.getOwned(), now + Milliseconds(ttl)};
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.cfind(key);
+    if (it != _entries.cend()) {
+        _totalBytes -= entrySize(it->first, it->second.response);
+    }
+
+    _totalBytes += entrySize(key, entry.response);
+    _entries.add(key, std::move(entry));
+    _evictToSize(lk, maxBytes);
+}
+
+void ClusterAggregateResultCache::report(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("numEntries", static_cast<long long>(_entries.size()));
+    builder->append("totalBytes", static_cast<long long>(_totalBytes));
+    builder->append("numHits", _numHits.load());
+    builder->append("numMisses", _numMisses.load());
+    builder->append("numEvictions", _numEvictions.load());
+}
+
+void ClusterAggregateResultCache::_evictToSize(WithLock lk, size_t maxBytes) {
+    while (_totalBytes > maxBytes && !_entries.empty()) {
+        _erase(lk, std::prev(_entries.end()));
+        _numEvictions.fetchAndAdd(1);
+    }
+}
+
+void ClusterAggregateResultCache::_erase(WithLock, LRUCache<std::string, Entry>::iterator it) {
+    _totalBytes -= entrySize(it->first, it->second.response);
+    _entries.erase(it);
+}
+
+}  // namespace mongo
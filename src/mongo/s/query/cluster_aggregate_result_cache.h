@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <limits>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Caches the complete responses of recent read-only aggregations routed through this mongos, so
+ * that clients which repeatedly issue the same aggregation, such as dashboards, can be answered
+ * without dispatching the pipeline to the shards again.
+ *
+ * Only responses whose results fit entirely in the first batch are cached. An entry is never
+ * refreshed and may be returned until 'internalQueryClusterAggregateResultCacheTTLMillis' after
+ * it was stored, after which it is discarded. Setting that parameter to 0 disables the cache. The
+ * total size of the cached responses is bounded by
+ * 'internalQueryClusterAggregateResultCacheMaxBytes', beyond which the least recently used entries
+ * are evicted.
+ *
+ * This class is thread-safe.
+ */
+class ClusterAggregateResultCache {
+    ClusterAggregateResultCache(const ClusterAggregateResultCache&) = delete;
+    ClusterAggregateResultCache& operator=(const ClusterAggregateResultCache&) = delete;
+
+public:
+    ClusterAggregateResultCache() = default;
+
+    static ClusterAggregateResultCache* get(ServiceContext* service);
+    static ClusterAggregateResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns the key under which the response to the aggregate command 'cmdObj' may be cached, or
+     * boost::none if the cache is disabled or the response must not be served from it. The latter
+     * is the case for explains, change streams, writes, reads inside transactions or tied to a
+     * point in time, and pipelines with stages or expressions whose results vary between runs.
+     */
+    static boost::optional<std::string> makeKey(OperationContext* opCtx,
+                                                const AggregationRequest& request,
+                                                const LiteParsedPipeline& liteParsedPipeline,
+                                                const BSONObj& cmdObj);
+
+    /**
+     * Returns the response cached under 'key', if there is one which has not expired by 'now'.
+     */
+    boost::optional<BSONObj> lookup(const std::string& key, Date_t now);
+
+    /**
+     * Caches 'response' under 'key' if it holds the complete results of the aggregation, i.e. its
+     * cursor is already exhausted and it is small enough to fit in the cache.
+     */
+    void insert(const std::string& key, const BSONObj& response, Date_t now);
+
+    /**
+     * Appends the number of entries, their total size and the hit, miss and eviction counters of
+     * the cache to 'builder'.
+     */
+    void report(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        BSONObj response;
+        Date_t expiresAt;
+    };
+
+    // Removes the least recently used entries until the cached responses fit in 'maxBytes'.
+    void _evictToSize(WithLock, size_t maxBytes);
+
+    void _erase(WithLock, LRUCache<std::string, Entry>::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterAggregateResultCache::_mutex");
+
+    // The size of the cache is bounded by the number of bytes held by its entries rather than by
+    // their number.
+    LRUCache<std::string, Entry> _entries{std::numeric_limits<size_t>::max()};
+
+    // The combined size of the keys and responses of all the entries.
+    size_t _totalBytes{0};
+
+    AtomicWord<long long> _numHits{0};
+    AtomicWord<long long> _numMisses{0};
+    AtomicWord<long long> _numEvictions{0};
+};
+
+}  // namespace mongo
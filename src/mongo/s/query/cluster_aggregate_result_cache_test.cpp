@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/s/query/cluster_aggregate_result_cache.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.collection");
+
+class ClusterAggregateResultCacheTest : public ServiceContextTest {
+protected:
+    void setUp() override {
+        _originalTTLMillis = internalQueryClusterAggregateResultCacheTTLMillis.load();
+        _originalMaxBytes = internalQueryClusterAggregateResultCacheMaxBytes.load();
+        internalQueryClusterAggregateResultCacheTTLMillis.store(1000);
+    }
+
+    void tearDown() override {
+        internalQueryClusterAggregateResultCacheTTLMillis.store(_originalTTLMillis);
+        internalQueryClusterAggregateResultCacheMaxBytes.store(_originalMaxBytes);
+    }
+
+    boost::optional<std::string> makeKey(const BSONObj& cmdObj) {
+        auto request = uassertStatusOK(AggregationRequest::parseFromBSON(kNss, cmdObj));
+        LiteParsedPipeline liteParsedPipeline(request);
+        return ClusterAggregateResultCache::makeKey(
+            _opCtx.get(), request, liteParsedPipeline, cmdObj);
+    }
+
+    BSONObj makeResponse(CursorId cursorId, std::vector<BSONObj> batch) {
+        return CursorResponse(kNss, cursorId, std::move(batch))
+            .toBSON(CursorResponse::ResponseType::InitialResponse);
+    }
+
+    ClusterAggregateResultCache _cache;
+    const Date_t _now = Date_t::fromMillisSinceEpoch(100000);
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx{makeOperationContext()};
+
+    int _originalTTLMillis;
+    long long _originalMaxBytes;
+};
+
+TEST_F(ClusterAggregateResultCacheTest, KeyIgnoresFieldsWhichDoNotAffectResults) {
+    auto key = makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 1}}], "
+                                "cursor: {}, $db: 'test'}"));
+    ASSERT_TRUE(key);
+    ASSERT_TRUE(key ==
+                makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 1}}], "
+                                 "cursor: {}, $db: 'test', comment: 'dashboard', maxTimeMS: 10}")));
+    ASSERT_FALSE(key ==
+                 makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 2}}], "
+                                  "cursor: {}, $db: 'test'}")));
+    ASSERT_FALSE(key ==
+                 makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 1}}], "
+                                  "cursor: {batchSize: 1}, $db: 'test'}")));
+}
+
+TEST_F(ClusterAggregateResultCacheTest, NoKeyWhenDisabled) {
+    internalQueryClusterAggregateResultCacheTTLMillis.store(0);
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 1}}], "
+                                  "cursor: {}, $db: 'test'}")));
+}
+
+TEST_F(ClusterAggregateResultCacheTest, NoKeyForUncacheablePipelines) {
+    // Writes.
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$out: 'other'}], "
+                                  "cursor: {}, $db: 'test'}")));
+    // Stages whose results vary between runs.
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$sample: {size: 1}}], "
+                                  "cursor: {}, $db: 'test'}")));
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$changeStream: {}}], "
+                                  "cursor: {}, $db: 'test'}")));
+    // Expressions whose results vary between runs.
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {$expr: "
+                                  "{$lt: ['$date', '$$NOW']}}}], cursor: {}, $db: 'test'}")));
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$project: {r: "
+                                  "{$rand: {}}}}], cursor: {}, $db: 'test'}")));
+    // Explains.
+    ASSERT_FALSE(makeKey(fromjson("{aggregate: 'collection', pipeline: [{$match: {a: 1}}], "
+                                  "explain: true, $db: 'test'}")));
+}
+
+TEST_F(ClusterAggregateResultCacheTest, LookupReturnsInsertedResponseUntilItExpires) {
+    const std::string key = "key";
+    const auto response = makeResponse(CursorId(0), {BSON("_id" << 1), BSON("_id" << 2)});
+    ASSERT_FALSE(_cache.lookup(key, _now));
+
+    _cache.insert(key, response, _now);
+    auto cached = _cache.lookup(key, _now + Milliseconds(999));
+    ASSERT_TRUE(cached);
+    ASSERT_BSONOBJ_EQ(*cached, response);
+
+    ASSERT_FALSE(_cache.lookup(key, _now + Milliseconds(1000)));
+
+    BSONObjBuilder bob;
+    _cache.report(&bob);
+    ASSERT_BSONOBJ_EQ(bob.obj(),
+                      BSON("numEntries" << 0 << "totalBytes" << 0 << "numHits" << 1 << "numMisses"
+                                        << 2 << "numEvictions" << 0));
+}
+
+TEST_F(ClusterAggregateResultCacheTest, ResponsesWithOpenCursorsAreNotCached) {
+    const std::string key = "key";
+    _cache.insert(key, makeResponse(CursorId(123), {BSON("_id" << 1)}), _now);
+    ASSERT_FALSE(_cache.lookup(key, _now));
+}
+
+TEST_F(ClusterAggregateResultCacheTest, LeastRecentlyUsedEntriesAreEvictedBeyondByteBudget) {
+    const auto response = makeResponse(CursorId(0), {BSON("_id" << 1)});
+    const auto entryBytes = static_cast<long long>(std::string("key0").size() + response.objsize());
+    internalQueryClusterAggregateResultCacheMaxBytes.store(2 * entryBytes);
+
+    _cache.insert("key0", response, _now);
+    _cache.insert("key1", response, _now);
+
+    // Using 'key0' makes 'key1' the least recently used entry.
+    ASSERT_TRUE(_cache.lookup("key0", _now));
+    _cache.insert("key2", response, _now);
+
+    ASSERT_TRUE(_cache.lookup("key0", _now));
+    ASSERT_FALSE(_cache.lookup("key1", _now));
+    ASSERT_TRUE(_cache.lookup("key2", _now));
+
+    BSONObjBuilder bob;
+    _cache.report(&bob);
+    const auto report = bob.obj();
+    ASSERT_EQ(report["numEntries"].numberLong(), 2);
+    ASSERT_EQ(report["totalBytes"].numberLong(), 2 * entryBytes);
+    ASSERT_EQ(report["numEvictions"].numberLong(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
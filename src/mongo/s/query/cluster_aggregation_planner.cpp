@@ -370,6 +370,17 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
     std::vector<std::pair<ShardId, BSONObj>> requests;
     auto numConsumers = shardDispatchResults->exchangeSpec->consumerShards.size();
     std::vector<SplitPipeline> consumerPipelines;
+
+    // Separate the stages run by each of the consumers from those, if any, which must still run on
+    // the merging host over the union of the consumers' results.
+    const auto& mergeSources = shardDispatchResults->splitPipeline->mergePipeline->getSources();
+    const auto numConsumerStages = std::min(
+        shardDispatchResults->exchangeSpec->numConsumerStages.value_or(mergeSources.size()),
+        mergeSources.size());
+    const Pipeline::SourceContainer consumerSources(
+        mergeSources.begin(), std::next(mergeSources.begin(), numConsumerStages));
+    Pipeline::SourceContainer finalMergeSources(std::next(mergeSources.begin(), numConsumerStages),
+                                                mergeSources.end());
     for (size_t idx = 0; idx < numConsumers; ++idx) {
         // Pick this consumer's cursors from producers.
         std::vector<OwnedRemoteCursor> producers;
@@ -379,8 +390,7 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
         }
 
         // Create a pipeline for a consumer and add the merging stage.
-        auto consumerPipeline = Pipeline::create(
-            shardDispatchResults->splitPipeline->mergePipeline->getSources(), expCtx);
+        auto consumerPipeline = Pipeline::create(consumerSources, expCtx);
 
         sharded_agg_helpers::addMergeCursorsSource(
             consumerPipeline.get(),
@@ -414,9 +424,11 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
         ownedCursors.emplace_back(OwnedRemoteCursor(opCtx, std::move(cursor), executionNss));
     }
 
-    // The merging pipeline is just a union of the results from each of the shards involved on the
-    // consumer side of the exchange.
-    auto mergePipeline = Pipeline::create({}, expCtx);
+    // The merging pipeline is a union of the results from each of the shards involved on the
+    // consumer side of the exchange, followed by any stages which the consumers did not run.
+    const bool needsPrimaryShardMerge =
+        !finalMergeSources.empty() && shardDispatchResults->needsPrimaryShardMerge;
+    auto mergePipeline = Pipeline::create(std::move(finalMergeSources), expCtx);
     mergePipeline->setSplitState(Pipeline::SplitState::kSplitForMerge);
 
     SplitPipeline splitPipeline{nullptr, std::move(mergePipeline), boost::none};
@@ -428,7 +440,7 @@ DispatchShardPipelineResults dispatchExchangeConsumerPipeline(
             static_cast<DocumentSourceMergeCursors*>(pipeline.shardsPipeline->peekFront());
         mergeCursors->dismissCursorOwnership();
     }
-    return DispatchShardPipelineResults{false,
+    return DispatchShardPipelineResults{needsPrimaryShardMerge,
                                         std::move(ownedCursors),
                                         {},
                                         std::move(splitPipeline),
@@ -702,7 +714,10 @@ Status dispatchPipelineAndMerge(OperationContext* opCtx,
     auto expCtx = targeter.pipeline->getContext();
     // If not, split the pipeline as necessary and dispatch to the relevant shards.
     auto shardDispatchResults = sharded_agg_helpers::dispatchShardPipeline(
-        serializedCommand, hasChangeStream, std::move(targeter.pipeline));
+        serializedCommand,
+        hasChangeStream,
+        std::move(targeter.pipeline),
+        true /* allowGroupExchange */);
 
     // If the operation is an explain, then we verify that it succeeded on all targeted
     // shards, write the results to the output builder, and return immediately.
@@ -153,14 +153,19 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
+    for (const auto& partition : _partitions) {
+        invariant(partition.namespaceToEntryMap.empty());
+    }
     invariant(_cursorIdPrefixToNamespaceMap.empty());
-    invariant(_namespaceToContainerMap.empty());
+    invariant(_namespaceToPrefixMap.empty());
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
+    // Once a partition is flagged, no more cursors can be registered in it, so killing all the
+    // cursors afterwards cannot miss any.
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        partition.inShutdown = true;
     }
     killAllCursors(opCtx);
 }
@@ -175,65 +180,47 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (_inShutdown) {
-        lk.unlock();
-        cursor->kill(opCtx);
-        return Status(ErrorCodes::ShutdownInProgress,
-                      "Cannot register new cursors as we are in the process of shutting down");
-    }
-
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        uint32_t containerPrefix = 0;
-        do {
-            // The server has always generated positive values for CursorId (which is a signed
-            // type), so we use std::abs() here on the prefix for consistency with this historical
-            // behavior. If the random number generated is INT_MIN, calling std::abs on it is
-            // undefined behavior on 2's complement systems so we need to generate a new number.
-            int32_t randomNumber = 0;
-            do {
-                randomNumber = _pseudoRandom.nextInt32();
-            } while (randomNumber == std::numeric_limits<int32_t>::min());
-            containerPrefix = static_cast<uint32_t>(std::abs(randomNumber));
-        } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
-        _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
+    const uint32_t containerPrefix = _acquireNamespacePrefix(nss);
 
-        auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
-        invariant(emplaceResult.second);
-        invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+    while (true) {
+        // Generate a CursorId (which can't be the invalid value zero).
+        const CursorId cursorId = createCursorId(containerPrefix, _generateCursorSuffix());
+        if (cursorId == 0) {
+            continue;
+        }
 
-        nsToContainerIt = emplaceResult.first;
-    } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
-    }
-    CursorEntryContainer& container = nsToContainerIt->second;
+        auto& partition = _getPartition(cursorId);
+        stdx::unique_lock<Latch> lk(partition.mutex);
 
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
-    CursorId cursorId = 0;
-    do {
-        const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
-        cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
+        if (partition.inShutdown) {
+            lk.unlock();
+            _releaseNamespacePrefix(nss);
+            cursor->kill(opCtx);
+            return Status(ErrorCodes::ShutdownInProgress,
+                          "Cannot register new cursors as we are in the process of shutting down");
+        }
 
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(cursorId,
-                                          CursorEntry(std::move(cursor),
-                                                      cursorType,
-                                                      cursorLifetime,
-                                                      now,
-                                                      authenticatedUsers,
-                                                      opCtx->getOperationKey()));
-    invariant(emplaceResult.second);
+        // Find the entries of this partition for the namespace. If none exist, create them.
+        CursorEntryMap& entryMap = partition.namespaceToEntryMap[nss];
+        if (entryMap.count(cursorId) > 0) {
+            continue;
+        }
 
-    return cursorId;
+        // Create a new CursorEntry and register it in the partition.
+        auto emplaceResult = entryMap.emplace(cursorId,
+                                              CursorEntry(std::move(cursor),
+                                                          cursorType,
+                                                          cursorLifetime,
+                                                          now,
+                                                          authenticatedUsers,
+                                                          opCtx->getOperationKey()));
+        invariant(emplaceResult.second);
+
+        return cursorId;
+    }
 }
 
 StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCursor(
@@ -242,14 +229,15 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     OperationContext* opCtx,
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    if (_inShutdown) {
+    if (partition.inShutdown) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -275,6 +263,9 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
 
     auto cursorGuard = entry->releaseCursor(opCtx);
 
+    // The cursor is now pinned by this operation, so the rest can be done out of the lock.
+    lk.unlock();
+
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
     if (cursorGuard->getLsid()) {
@@ -302,9 +293,10 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -320,15 +312,16 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    auto& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto entry = _getEntry(lk, partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -355,9 +348,10 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
                                         CursorId cursorId) {
     invariant(opCtx);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -372,7 +366,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
@@ -380,10 +374,11 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
 }
 
 void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                                               Partition& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = _detachCursor(lk, partition, opCtx, nss, cursorId);
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
@@ -393,8 +388,6 @@ void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal &&
             !entry.getOperationUsingCursor() && entry.getLastActive() <= cutoff;
@@ -410,98 +403,101 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    return killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred));
+    killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
-            auto cursorId = cursorIdEntryIt->first;
-            auto& entry = cursorIdEntryIt->second;
-
-            if (!pred(cursorId, entry)) {
-                ++cursorIdEntryIt;
-                continue;
-            }
+    for (auto& partition : _partitions) {
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
 
-            ++nKilled;
+        stdx::unique_lock<Latch> lk(partition.mutex);
+        auto nsEntriesIt = partition.namespaceToEntryMap.begin();
+        while (nsEntriesIt != partition.namespaceToEntryMap.end()) {
+            auto&& entryMap = nsEntriesIt->second;
+            auto cursorIdEntryIt = entryMap.begin();
+            while (cursorIdEntryIt != entryMap.end()) {
+                auto cursorId = cursorIdEntryIt->first;
+                auto& entry = cursorIdEntryIt->second;
 
-            if (entry.getOperationUsingCursor()) {
-                // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
-                ++cursorIdEntryIt;
-                continue;
-            }
+                if (!pred(cursorId, entry)) {
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+                ++nKilled;
 
-            // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
-        }
+                if (entry.getOperationUsingCursor()) {
+                    // Mark the OperationContext using the cursor as killed, and move on.
+                    killOperationUsingCursor(lk, &entry);
+                    ++cursorIdEntryIt;
+                    continue;
+                }
+
+                cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+                // Destroy the entry and set the iterator to the next element.
+                entryMap.erase(cursorIdEntryIt++);
+                _releaseNamespacePrefix(nsEntriesIt->first);
+            }
+
+            if (entryMap.empty()) {
+                partition.namespaceToEntryMap.erase(nsEntriesIt++);
+            } else {
+                ++nsEntriesIt;
+            }
         }
-    }
 
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
+        // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks
+        // to finish.
+        lk.unlock();
 
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
+        }
     }
 
     return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
 
-            if (entry.isKillPending()) {
-                // Killed cursors do not count towards the number of pinned cursors or the number of
-                // open cursors.
-                continue;
-            }
+        for (auto& nsEntriesPair : partition.namespaceToEntryMap) {
+            for (auto& cursorIdEntryPair : nsEntriesPair.second) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
 
-            if (entry.getOperationUsingCursor()) {
-                ++stats.cursorsPinned;
-            }
+                if (entry.isKillPending()) {
+                    // Killed cursors do not count towards the number of pinned cursors or the
+                    // number of open cursors.
+                    continue;
+                }
 
-            switch (entry.getCursorType()) {
-                case CursorType::SingleTarget:
-                    ++stats.cursorsSingleTarget;
-                    break;
-                case CursorType::MultiTarget:
-                    ++stats.cursorsMultiTarget;
-                    break;
+                if (entry.getOperationUsingCursor()) {
+                    ++stats.cursorsPinned;
+                }
+
+                switch (entry.getCursorType()) {
+                    case CursorType::SingleTarget:
+                        ++stats.cursorsSingleTarget;
+                        break;
+                    case CursorType::MultiTarget:
+                        ++stats.cursorsMultiTarget;
+                        break;
+                }
             }
         }
     }
@@ -510,20 +506,22 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
+        for (const auto& nsEntriesPair : partition.namespaceToEntryMap) {
+            for (const auto& cursorIdEntryPair : nsEntriesPair.second) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
 
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
 
-            auto lsid = entry.getLsid();
-            if (lsid) {
-                lsids->insert(*lsid);
+                auto lsid = entry.getLsid();
+                if (lsid) {
+                    lsids->insert(*lsid);
+                }
             }
         }
     }
@@ -551,28 +549,30 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
 
-            const CursorEntry& entry = cursorIdEntryPair.second;
-            // If auth is enabled, and userMode is allUsers, check if the current user has
-            // permission to see this cursor.
-            if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
-                userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
-                !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
-                continue;
-            }
-            if (entry.isKillPending() || entry.getOperationUsingCursor()) {
-                // Don't include sessions for killed or pinned cursors.
-                continue;
-            }
+        for (const auto& nsEntriesPair : partition.namespaceToEntryMap) {
+            for (const auto& cursorIdEntryPair : nsEntriesPair.second) {
 
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+                const CursorEntry& entry = cursorIdEntryPair.second;
+                // If auth is enabled, and userMode is allUsers, check if the current user has
+                // permission to see this cursor.
+                if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
+                    userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
+                    !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
+                    continue;
+                }
+                if (entry.isKillPending() || entry.getOperationUsingCursor()) {
+                    // Don't include sessions for killed or pinned cursors.
+                    continue;
+                }
+
+                cursors.emplace_back(
+                    entry.cursorToGenericCursor(cursorIdEntryPair.first, nsEntriesPair.first));
+            }
         }
     }
 
@@ -603,20 +603,22 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
 
-            auto cursorLsid = entry.getLsid();
-            if (lsid == cursorLsid) {
-                cursorIds.insert(cursorId);
+        for (auto&& nsEntriesPair : partition.namespaceToEntryMap) {
+            for (auto&& [cursorId, entry] : nsEntriesPair.second) {
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
+
+                auto cursorLsid = entry.getLsid();
+                if (lsid == cursorLsid) {
+                    cursorIds.insert(cursorId);
+                }
             }
         }
     }
@@ -626,23 +628,25 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
     // While we could maintain a cached mapping of OperationKey to CursorID to increase performance,
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
-    for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-                if (entry.isKillPending()) {
-                    // Don't include any killed cursors.
-                    continue;
-                }
-
-                if (opKey == entry.getOperationKey()) {
-                    cursorIds.insert(cursorId);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+
+        for (auto&& opKey : opKeys) {
+            for (auto&& nsEntriesPair : partition.namespaceToEntryMap) {
+                for (auto&& [cursorId, entry] : nsEntriesPair.second) {
+                    if (entry.isKillPending()) {
+                        // Don't include any killed cursors.
+                        continue;
+                    }
+
+                    if (opKey == entry.getOperationKey()) {
+                        cursorIds.insert(cursorId);
+                    }
                 }
             }
         }
@@ -653,7 +657,7 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_namespacesMutex);
 
     const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
     if (it == _cursorIdPrefixToNamespaceMap.end()) {
@@ -662,14 +666,20 @@ boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
+auto ClusterCursorManager::_getPartition(CursorId cursorId) -> Partition& {
+    return _partitions[static_cast<uint32_t>(cursorId) % kNumPartitions];
+}
+
+auto ClusterCursorManager::_getEntry(WithLock,
+                                     Partition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
 
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    auto nsToEntriesIt = partition.namespaceToEntryMap.find(nss);
+    if (nsToEntriesIt == partition.namespaceToEntryMap.end()) {
         return nullptr;
     }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
+    CursorEntryMap& entryMap = nsToEntriesIt->second;
     auto entryMapIt = entryMap.find(cursorId);
     if (entryMapIt == entryMap.end()) {
         return nullptr;
@@ -678,27 +688,67 @@ auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, Curso
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
-    -> NssToCursorContainerMap::iterator {
-    auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
+uint32_t ClusterCursorManager::_acquireNamespacePrefix(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_namespacesMutex);
+
+    auto nsToPrefixIt = _namespaceToPrefixMap.find(nss);
+    if (nsToPrefixIt == _namespaceToPrefixMap.end()) {
+        uint32_t containerPrefix = 0;
+        do {
+            // The server has always generated positive values for CursorId (which is a signed
+            // type), so we use std::abs() here on the prefix for consistency with this historical
+            // behavior. If the random number generated is INT_MIN, calling std::abs on it is
+            // undefined behavior on 2's complement systems so we need to generate a new number.
+            int32_t randomNumber = 0;
+            do {
+                randomNumber = _pseudoRandom.nextInt32();
+            } while (randomNumber == std::numeric_limits<int32_t>::min());
+            containerPrefix = static_cast<uint32_t>(std::abs(randomNumber));
+        } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
+        _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
+
+        auto emplaceResult =
+            _namespaceToPrefixMap.emplace(nss, NamespacePrefix{containerPrefix, 0});
+        invariant(emplaceResult.second);
+        invariant(_namespaceToPrefixMap.size() == _cursorIdPrefixToNamespaceMap.size());
+
+        nsToPrefixIt = emplaceResult.first;
+    }
+
+    ++nsToPrefixIt->second.numCursors;
+    return nsToPrefixIt->second.prefix;
+}
+
+void ClusterCursorManager::_releaseNamespacePrefix(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_namespacesMutex);
+
+    auto nsToPrefixIt = _namespaceToPrefixMap.find(nss);
+    invariant(nsToPrefixIt != _namespaceToPrefixMap.end());
+    invariant(nsToPrefixIt->second.numCursors > 0);
+    if (--nsToPrefixIt->second.numCursors > 0) {
+        return;
+    }
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
+    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(nsToPrefixIt->second.prefix);
     invariant(numDeleted == 1);
-    _namespaceToContainerMap.erase(it++);
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
-    return it;
+    _namespaceToPrefixMap.erase(nsToPrefixIt);
+    invariant(_namespaceToPrefixMap.size() == _cursorIdPrefixToNamespaceMap.size());
+}
+
+uint32_t ClusterCursorManager::_generateCursorSuffix() {
+    stdx::lock_guard<Latch> lk(_namespacesMutex);
+    return static_cast<uint32_t>(_pseudoRandom.nextInt32());
 }
 
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
+                                                                         Partition& partition,
                                                                          OperationContext* opCtx,
                                                                          const NamespaceString& nss,
                                                                          CursorId cursorId) {
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -711,14 +761,15 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
+    auto nsToEntriesIt = partition.namespaceToEntryMap.find(nss);
+    invariant(nsToEntriesIt != partition.namespaceToEntryMap.end());
+    CursorEntryMap& entryMap = nsToEntriesIt->second;
     size_t eraseResult = entryMap.erase(cursorId);
     invariant(1 == eraseResult);
     if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
+        partition.namespaceToEntryMap.erase(nsToEntriesIt);
     }
+    _releaseNamespacePrefix(nss);
 
     return std::move(cursor);
 }
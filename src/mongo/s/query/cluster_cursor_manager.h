@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -68,6 +69,11 @@ class StatusWith;
  * The manager supports killing of registered cursors, either through the PinnedCursor object or
  * with the kill*() suite of methods.
  *
+ * The cursors are spread over several partitions according to their ids, each with its own mutex,
+ * so that operations on different cursors rarely contend with each other, even when the cursors
+ * are on the same namespace. Operations which visit every cursor, such as the periodic reaping of
+ * inactive cursors, lock one partition at a time.
+ *
  * No public methods throw exceptions, and all public methods are thread-safe.
  */
 class ClusterCursorManager {
@@ -388,9 +394,9 @@ public:
 
 private:
     class CursorEntry;
-    struct CursorEntryContainer;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
-    using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
+    using NssToCursorEntryMap = stdx::unordered_map<NamespaceString, CursorEntryMap>;
 
     /**
      * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
@@ -409,20 +415,47 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * Will detach a cursor, release the lock of its partition and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                             Partition& partition,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
 
+    /**
+     * Returns the partition which holds the cursor with the given id.
+     */
+    Partition& _getPartition(CursorId cursorId);
+
     /**
      * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
      * registered, returns null.
      *
-     * Not thread-safe.
+     * Must be called while holding the mutex of 'partition'.
+     */
+    CursorEntry* _getEntry(WithLock,
+                           Partition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
+
+    /**
+     * Returns the cursor id prefix of the given namespace, assigning a new one if there are no
+     * cursors on it yet, and counts one more cursor against it. Each call must be paired with a
+     * call to _releaseNamespacePrefix() once the cursor is destroyed or fails to be registered.
+     */
+    uint32_t _acquireNamespacePrefix(const NamespaceString& nss);
+
+    /**
+     * Counts one fewer cursor against the prefix of the given namespace, and forgets the prefix
+     * once no cursors are left on the namespace.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    void _releaseNamespacePrefix(const NamespaceString& nss);
+
+    /**
+     * Returns a random suffix for a new cursor id.
+     */
+    uint32_t _generateCursorSuffix();
 
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
@@ -431,9 +464,10 @@ private:
      * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
      * cursor is not registered, returns an error Status with code CursorNotFound.
      *
-     * Not thread-safe.
+     * Must be called while holding the mutex of 'partition'.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const NamespaceString& nss,
                                                        CursorId cursorId);
@@ -444,12 +478,12 @@ private:
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry.
+     * Kill the cursors satisfying the given predicate. The partitions are visited one at a time,
+     * and the cursors of each are killed after its mutex has been released.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred);
 
     /**
@@ -581,39 +615,39 @@ private:
     };
 
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * A subset of the registered cursors, selected by the low bits of their ids.
      */
-    struct CursorEntryContainer {
-        CursorEntryContainer(const CursorEntryContainer&) = delete;
-        CursorEntryContainer& operator=(const CursorEntryContainer&) = delete;
+    struct Partition {
+        // Synchronizes access to the members below.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
 
-        CursorEntryContainer(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
+        bool inShutdown{false};
 
-        CursorEntryContainer(CursorEntryContainer&& other) = default;
-        CursorEntryContainer& operator=(CursorEntryContainer&& other) = default;
-
-        // Common cursor id prefix for all cursors in this container.
-        uint32_t containerPrefix;
+        // Map from namespace to the entries of this partition's cursors on that namespace.
+        //
+        // Entries are added when the first cursor of this partition on the given namespace is
+        // registered, and removed when the last one is destroyed.
+        NssToCursorEntryMap namespaceToEntryMap;
+    };
 
-        // Map from cursor id to cursor entry.
-        CursorEntryMap entryMap;
+    // The cursor id prefix assigned to a namespace, along with the number of cursors which are
+    // registered on it.
+    struct NamespacePrefix {
+        uint32_t prefix;
+        size_t numCursors;
     };
 
-    /**
-     * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
-     */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    static constexpr size_t kNumPartitions = 16;
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    std::array<Partition, kNumPartitions> _partitions;
 
-    bool _inShutdown{false};
+    // Synchronizes access to the cursor id prefixes and to the randomness source below. Partition
+    // mutexes may be held while acquiring it, but not the other way around.
+    mutable Mutex _namespacesMutex = MONGO_MAKE_LATCH("ClusterCursorManager::_namespacesMutex");
 
     // Randomness source.  Used for cursor id generation.
     PseudoRandom _pseudoRandom;
@@ -630,11 +664,9 @@ private:
     // when the last cursor on the given namespace is destroyed.
     stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
 
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    // Map from namespace to its cursor id prefix, with the same lifetime as the entries of
+    // '_cursorIdPrefixToNamespaceMap'.
+    stdx::unordered_map<NamespaceString, NamespacePrefix> _namespaceToPrefixMap;
 
     size_t _cursorsTimedOut = 0;
 };
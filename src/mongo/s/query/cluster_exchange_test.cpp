@@ -38,7 +38,9 @@
 #include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -608,5 +610,104 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
 
     future.default_timed_get();
 }
+
+class ClusterGroupExchangeTest : public ClusterExchangeTest {
+protected:
+    void setUp() override {
+        ClusterExchangeTest::setUp();
+        _originalNumConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    }
+
+    void tearDown() override {
+        internalQueryGroupMergeExchangeConsumers.store(_originalNumConsumers);
+        ClusterExchangeTest::tearDown();
+    }
+
+    std::unique_ptr<Pipeline, PipelineDeleter> makeGroupMergePipeline() {
+        return Pipeline::create({parseStage("{$group: {"
+                                            "  _id: '$word',"
+                                            "  count: {$sum: 1},"
+                                            "  $doingMerge: true"
+                                            "}}"),
+                                 DocumentSourceLimit::create(expCtx(), 10)},
+                                expCtx());
+    }
+
+    const std::set<ShardId> _shardIds{ShardId("0"), ShardId("1"), ShardId("2"), ShardId("3")};
+
+private:
+    int _originalNumConsumers;
+};
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotExchangeGroupIfDisabled) {
+    internalQueryGroupMergeExchangeConsumers.store(0);
+    auto mergePipe = makeGroupMergePipeline();
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _shardIds));
+}
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotExchangeIfMergePipelineDoesNotStartWithGroup) {
+    internalQueryGroupMergeExchangeConsumers.store(4);
+    auto mergePipe = Pipeline::create({DocumentSourceLimit::create(expCtx(), 1)}, expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _shardIds));
+}
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotExchangeGroupWithNonSimpleCollation) {
+    internalQueryGroupMergeExchangeConsumers.store(4);
+    expCtx()->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    auto mergePipe = makeGroupMergePipeline();
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _shardIds));
+}
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotExchangeGroupOnSingleShard) {
+    internalQueryGroupMergeExchangeConsumers.store(4);
+    auto mergePipe = makeGroupMergePipeline();
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), {ShardId("0")}));
+}
+
+TEST_F(ClusterGroupExchangeTest, GroupMergeIsPartitionedByHashOfGroupKey) {
+    internalQueryGroupMergeExchangeConsumers.store(3);
+    auto mergePipe = makeGroupMergePipeline();
+    auto exchangeSpec = sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _shardIds);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+
+    // Only the $group runs on the consumers; the $limit stays on the merging host.
+    ASSERT_TRUE(exchangeSpec->numConsumerStages == size_t{1});
+
+    // The consumers are distinct shards chosen among the targeted ones.
+    const auto& consumerShards = exchangeSpec->consumerShards;
+    ASSERT_EQ(consumerShards.size(), 3UL);
+    ASSERT_EQ(std::set<ShardId>(consumerShards.begin(), consumerShards.end()).size(), 3UL);
+    for (auto&& shardId : consumerShards) {
+        ASSERT_EQ(_shardIds.count(shardId), 1UL);
+    }
+
+    // The hash space is split into ascending, evenly sized ranges.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    const auto& consumerIds = exchangeSpec->exchangeSpec.getConsumerIds().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_EQ(consumerIds.size(), 3UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+    const auto firstSplit = boundaries[1]["_id"].numberLong();
+    const auto secondSplit = boundaries[2]["_id"].numberLong();
+    ASSERT_LT(firstSplit, secondSplit);
+    ASSERT_LT(firstSplit, 0);
+    ASSERT_GT(secondSplit, 0);
+    for (int idx = 0; idx < 3; ++idx) {
+        ASSERT_EQ(consumerIds[idx], idx);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
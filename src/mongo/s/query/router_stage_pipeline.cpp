@@ -45,6 +45,12 @@ RouterStagePipeline::RouterStagePipeline(std::unique_ptr<Pipeline, PipelineDelet
     invariant(!_mergePipeline->getSources().empty());
     _mergeCursorsStage =
         dynamic_cast<DocumentSourceMergeCursors*>(_mergePipeline->getSources().front().get());
+    for (auto&& source : _mergePipeline->getSources()) {
+        if (auto postImageLookupStage =
+                dynamic_cast<DocumentSourceLookupChangePostImage*>(source.get())) {
+            _postImageLookupStage = postImageLookupStage;
+        }
+    }
 }
 
 StatusWith<ClusterQueryResult> RouterStagePipeline::next(RouterExecStage::ExecContext execContext) {
@@ -54,7 +60,11 @@ StatusWith<ClusterQueryResult> RouterStagePipeline::next(RouterExecStage::ExecCo
 
     // Pipeline::getNext will return a boost::optional<Document> or boost::none if EOF.
     if (auto result = _mergePipeline->getNext()) {
-        return _validateAndConvertToBSON(*result);
+        auto resultObj = _validateAndConvertToBSON(*result);
+        if (_postImageLookupStage) {
+            _lastReturnedResumeToken = resultObj.getObjectField("_id").getOwned();
+        }
+        return resultObj;
     }
 
     // If we reach this point, we have hit EOF.
@@ -87,6 +97,10 @@ std::size_t RouterStagePipeline::getNumRemotes() const {
 }
 
 BSONObj RouterStagePipeline::getPostBatchResumeToken() const {
+    // The merged cursors are past any events the pipeline has read ahead but not yet returned.
+    if (_postImageLookupStage && _postImageLookupStage->hasBufferedEvents()) {
+        return _lastReturnedResumeToken;
+    }
     return _mergeCursorsStage ? _mergeCursorsStage->getHighWaterMark() : BSONObj();
 }
 
@@ -32,6 +32,7 @@
 #include "mongo/s/query/router_exec_stage.h"
 
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
 
@@ -69,5 +70,12 @@ private:
 
     // May be null if this pipeline runs exclusively on mongos without contacting the shards at all.
     boost::intrusive_ptr<DocumentSourceMergeCursors> _mergeCursorsStage;
+
+    // Null unless this is a change stream which looks up post-images, and may then read events
+    // ahead of those it returns.
+    boost::intrusive_ptr<DocumentSourceLookupChangePostImage> _postImageLookupStage;
+
+    // The resume token of the last event returned, if '_postImageLookupStage' is set.
+    BSONObj _lastReturnedResumeToken;
 };
 }  // namespace mongo
@@ -315,5 +315,59 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+TEST_F(RoutingTableHistoryTestThreeInitialChunks, MigratingChunksUpdatesShardVersions) {
+    const ShardId kOtherShard("otherShard");
+    const auto& boundaries = getInitialChunkBoundaryPoints();
+    auto version = getInitialRoutingTable()->getVersion();
+
+    // Move the middle chunk to another shard, bumping the version of the donor
+    version.incMajor();
+    auto movedChunk =
+        ChunkType{kNss, ChunkRange{boundaries[1], boundaries[2]}, version, kOtherShard};
+    version.incMinor();
+    auto controlChunk =
+        ChunkType{kNss, ChunkRange{boundaries[0], boundaries[1]}, version, kThisShard};
+
+    auto rt = getInitialRoutingTable()->makeUpdated({movedChunk, controlChunk});
+    ASSERT_EQ(rt->numChunks(), 3ull);
+    ASSERT_EQ(rt->getNShardsOwningChunks(), 2);
+    ASSERT_EQ(rt->getVersion(kThisShard), controlChunk.getVersion());
+    ASSERT_EQ(rt->getVersion(kOtherShard), movedChunk.getVersion());
+
+    // Move all the remaining chunks away from the original shard, which leaves it without chunks
+    version.incMajor();
+    auto firstChunk =
+        ChunkType{kNss, ChunkRange{boundaries[0], boundaries[1]}, version, kOtherShard};
+    version.incMinor();
+    auto lastChunk =
+        ChunkType{kNss, ChunkRange{boundaries[2], boundaries[3]}, version, kOtherShard};
+
+    rt = rt->makeUpdated({firstChunk, lastChunk});
+    ASSERT_EQ(rt->numChunks(), 3ull);
+    ASSERT_EQ(rt->getNShardsOwningChunks(), 1);
+    ASSERT_EQ(rt->getVersion(kThisShard), ChunkVersion(0, 0, version.epoch()));
+    ASSERT_EQ(rt->getVersion(kOtherShard), lastChunk.getVersion());
+}
+
+TEST_F(RoutingTableHistoryTestThreeInitialChunks, IncompleteUpdateIsDetected) {
+    const auto& boundaries = getInitialChunkBoundaryPoints();
+    auto version = getInitialRoutingTable()->getVersion();
+
+    // Applying only one half of a split of the middle chunk leaves it overlapping the new chunk
+    version.incMajor();
+    ASSERT_THROWS_CODE(
+        getInitialRoutingTable()->makeUpdated(
+            {ChunkType{kNss, ChunkRange{boundaries[1], BSON("a" << 15)}, version, kThisShard}}),
+        DBException,
+        ErrorCodes::ConflictingOperationInProgress);
+
+    // A chunk which extends into its successor's range overlaps with it
+    ASSERT_THROWS_CODE(
+        getInitialRoutingTable()->makeUpdated(
+            {ChunkType{kNss, ChunkRange{boundaries[1], BSON("a" << 25)}, version, kThisShard}}),
+        DBException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -37,6 +37,7 @@
 #include "mongo/s/client/num_hosts_targeted_metrics.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_aggregate_result_cache.h"
 
 namespace mongo {
 namespace {
@@ -110,5 +111,22 @@ public:
 
 } hedgingMetricsServerStatus;
 
+class AggregateResultCacheServerStatus final : public ServerStatusSection {
+public:
+    AggregateResultCacheServerStatus() : ServerStatusSection("aggregateResultCache") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder result;
+        ClusterAggregateResultCache::get(opCtx)->report(&result);
+        return result.obj();
+    }
+
+} aggregateResultCacheServerStatus;
+
 }  // namespace
 }  // namespace mongo
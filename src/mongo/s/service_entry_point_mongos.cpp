@@ -39,6 +39,7 @@
 #include "mongo/db/dbmessage.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_trace.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/message.h"
@@ -57,6 +58,20 @@ BSONObj buildErrReply(const DBException& ex) {
     return errB.obj();
 }
 
+void finishOperationTrace(OperationContext* opCtx, NetworkOp op, const DbResponse& dbResponse) {
+    if (!OperationTrace::get(opCtx)) {
+        return;
+    }
+
+    const auto curOp = CurOp::get(opCtx);
+    const auto command = curOp->getCommand();
+    OperationTrace::finish(
+        opCtx,
+        command ? StringData(command->getName()) : StringData(networkOpToString(op)),
+        BSON("ns" << curOp->getNS() << "responseLength"
+                  << static_cast<int>(dbResponse.response.size())));
+}
+
 }  // namespace
 
 
@@ -93,6 +108,7 @@ DbResponse ServiceEntryPointMongos::handleRequest(OperationContext* opCtx, const
         // Mark the op as complete, populate the response length, and log it if appropriate.
         CurOp::get(opCtx)->completeAndLogOperation(
             opCtx, logv2::LogComponent::kCommand, dbResponse.response.size());
+        finishOperationTrace(opCtx, op, dbResponse);
 
         return dbResponse;
     }
@@ -178,6 +194,7 @@ DbResponse ServiceEntryPointMongos::handleRequest(OperationContext* opCtx, const
     // Mark the op as complete, populate the response length, and log it if appropriate.
     CurOp::get(opCtx)->completeAndLogOperation(
         opCtx, logv2::LogComponent::kCommand, dbResponse.response.size());
+    finishOperationTrace(opCtx, op, dbResponse);
 
     return dbResponse;
 }
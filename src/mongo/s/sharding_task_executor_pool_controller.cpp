@@ -159,10 +159,27 @@ public:
     }
 
     void onConfirmedSet(const State& state) noexcept override {
-        stdx::lock_guard lk(_controller->_mutex);
+        {
+            stdx::lock_guard lk(_controller->_mutex);
+
+            _controller->_removeGroup(lk, state.connStr.getSetName());
+            _controller->_addGroup(lk, state);
+        }
 
-        _controller->_removeGroup(lk, state.connStr.getSetName());
-        _controller->_addGroup(lk, state);
+        if (!gParameters.warmUpOnTopologyChange.load()) {
+            return;
+        }
+
+        // Connect to the active members ahead of the first requests, so that they do not all wait
+        // on connection setup at once after startup or an election. The pool must not be called
+        // into with _mutex held.
+        std::vector<HostAndPort> members;
+        for (auto& host : state.connStr.getServers()) {
+            if (!state.passives.count(host)) {
+                members.push_back(host);
+            }
+        }
+        _controller->_pool->warmUp(members, transport::kGlobalSSLMode);
     }
 
     void onPossibleSet(const State& state) noexcept override {
@@ -214,9 +231,11 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
 
     const size_t minConns = gParameters.minConnections.load();
     const size_t maxConns = gParameters.maxConnections.load();
+    const size_t requestsPerConn = gParameters.requestsPerConnection.load();
 
-    // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    // Update the target for just the pool first. Each new connection is on behalf of up to
+    // requestsPerConn pending requests, the others wait for an active connection to be returned.
+    poolData.target = stats.active + (stats.requests + requestsPerConn - 1) / requestsPerConn;
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -82,6 +82,8 @@ public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
+        AtomicWord<int> requestsPerConnection;
+        AtomicWord<bool> warmUpOnTopologyChange;
 
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
@@ -67,6 +67,9 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// Number of writes with which the targeting of the inserts of an ordered batch starts
+const size_t kMinOrderedInsertsTargetingWindow = 64;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -302,6 +305,38 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted in groups through NSTargeter::targetInserts, so that the targeter can
+    // share the routing table lookups between documents. Since ordered batches stop at the first
+    // write which goes to a different shard, they are targeted in windows of growing size in order
+    // to not waste work on writes which will not be part of this round.
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    size_t insertsTargetedEnd = 0;
+    size_t insertsWindowSize = ordered ? kMinOrderedInsertsTargetingWindow : numWriteOps;
+
+    auto targetInserts = [&](size_t begin) {
+        const size_t end = std::min(numWriteOps, begin + insertsWindowSize);
+        insertsWindowSize *= 2;
+
+        std::vector<size_t> readyOps;
+        std::vector<BSONObj> docs;
+        for (size_t i = begin; i < end; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready) {
+                readyOps.push_back(i);
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+            }
+        }
+
+        auto endpoints = targeter.targetInserts(_opCtx, docs);
+        invariant(endpoints.size() == readyOps.size());
+
+        insertEndpoints.resize(numWriteOps);
+        insertsTargetedEnd = end;
+        for (size_t i = 0; i < readyOps.size(); ++i) {
+            insertEndpoints[readyOps[i]] = std::move(endpoints[i]);
+        }
+    };
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -319,7 +354,15 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (isInsert) {
+                if (i >= insertsTargetedEnd) {
+                    targetInserts(i);
+                }
+                writeOp.targetInsertWrite(uassertStatusOK(std::move(*insertEndpoints[i])),
+                                          &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -451,6 +451,57 @@ TEST_F(BatchWriteOpTest, MultiOpTwoShardsOrdered) {
     ASSERT_EQUALS(clientResponse.getN(), 2);
 }
 
+// Multi-op targeting test (ordered) with more inserts than fit in the initial targeting window.
+// All the inserts to the first shard should still be sent in a single batch.
+TEST_F(BatchWriteOpTest, ManyInsertsTwoShardsOrdered) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    BatchedCommandRequest request([&] {
+        write_ops::Insert insertOp(nss);
+        std::vector<BSONObj> docs;
+        for (int i = -200; i < 100; ++i) {
+            docs.push_back(BSON("x" << i));
+        }
+        insertOp.setDocuments(std::move(docs));
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT(!batchOp.isFinished());
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 200u);
+    assertEndpointsEqual(targeted.begin()->second->getEndpoint(), endpointA);
+
+    BatchedCommandResponse response;
+    buildResponse(200, &response);
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 1u);
+    ASSERT_EQUALS(targeted.begin()->second->getWrites().size(), 100u);
+    assertEndpointsEqual(targeted.begin()->second->getEndpoint(), endpointB);
+
+    buildResponse(100, &response);
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 300);
+}
+
 void verifyTargetedBatches(std::map<ShardId, size_t> expected,
                            const std::map<ShardId, TargetedWriteBatch*>& targeted) {
     // 'expected' contains each ShardId that was expected to be targeted and the size of the batch
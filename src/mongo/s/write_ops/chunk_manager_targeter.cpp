@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/counter.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -403,6 +404,69 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                          _routingInfo->db().databaseVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    const auto cm = _routingInfo->cm();
+    if (!cm) {
+        return std::vector<StatusWith<ShardEndpoint>>(
+            docs.size(),
+            ShardEndpoint(_routingInfo->db().primary()->getId(),
+                          ChunkVersion::UNSHARDED(),
+                          _routingInfo->db().databaseVersion()));
+    }
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+
+    std::vector<size_t> sortedDocs;
+    sortedDocs.reserve(docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        shardKeys.push_back(cm->getShardKeyPattern().extractShardKeyFromDoc(docs[i]));
+
+        // See targetInsert for why an empty shard key implies an array along the shard key path
+        if (shardKeys.back().isEmpty()) {
+            endpoints.push_back(Status(ErrorCodes::ShardKeyNotFound,
+                                       "Shard key cannot contain array values or array "
+                                       "descendants."));
+            continue;
+        }
+
+        endpoints.push_back(Status(ErrorCodes::InternalError, "Insert was not targeted"));
+        sortedDocs.push_back(i);
+    }
+
+    std::sort(sortedDocs.begin(), sortedDocs.end(), [&](size_t lhs, size_t rhs) {
+        return SimpleBSONObjComparator::kInstance.evaluate(shardKeys[lhs] < shardKeys[rhs]);
+    });
+
+    // The chunk which contained the previous shard key in sorted order and its endpoint
+    boost::optional<Chunk> chunk;
+    boost::optional<ShardEndpoint> chunkEndpoint;
+
+    for (auto i : sortedDocs) {
+        const auto& shardKey = shardKeys[i];
+
+        if (!chunk || !chunk->containsKey(shardKey)) {
+            try {
+                chunk.emplace(cm->findIntersectingChunkWithSimpleCollation(shardKey));
+                chunkEndpoint.emplace(chunk->getShardId(), cm->getVersion(chunk->getShardId()));
+            } catch (const DBException& ex) {
+                chunk.reset();
+                endpoints[i] = ex.toStatus();
+                continue;
+            }
+        }
+
+        endpoints[i] = *chunkEndpoint;
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
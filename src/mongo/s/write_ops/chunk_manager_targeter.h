@@ -76,6 +76,14 @@ public:
 
     ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const override;
 
+    /**
+     * Extracts the shard keys of all the documents and looks them up in ascending order, so that
+     * consecutive documents which fall in the same chunk are targeted without searching the
+     * routing table again.
+     */
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     std::vector<ShardEndpoint> targetUpdate(OperationContext* opCtx,
                                             const BatchItemRef& itemRef) const override;
 
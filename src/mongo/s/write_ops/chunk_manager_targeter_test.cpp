@@ -185,6 +185,38 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertsWithConstantHashedPrefixAndVarying
     ASSERT_EQUALS(res.shardName, "1");
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsBatchMatchesSingleInsertTargeting) {
+    std::vector<BSONObj> splitPoints;
+    for (int i = -500; i < 500; i += 50) {
+        splitPoints.push_back(BSON("a" << i));
+    }
+    auto cmTargeter = prepare(BSON("a" << 1), splitPoints);
+
+    // Mix documents which are out of shard key order and fall in the same chunks with ones which
+    // cannot be targeted
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 1000; i++) {
+        docs.push_back(BSON("a" << (i * 37) % 1000 - 500));
+    }
+    docs.insert(docs.begin() + 10, fromjson("{a: [1, 2]}"));
+    docs.push_back(BSONObj());
+
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size(); i++) {
+        if (i == 10) {
+            ASSERT_EQ(endpoints[i].getStatus(), ErrorCodes::ShardKeyNotFound);
+            continue;
+        }
+
+        auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_OK(endpoints[i].getStatus());
+        ASSERT_EQUALS(endpoints[i].getValue().shardName, expected.shardName);
+        ASSERT_EQUALS(endpoints[i].getValue().shardVersion, expected.shardVersion);
+    }
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetUpdateWithRangePrefixHashedShardKey) {
     // Create 5 chunks and 5 shards such that shardId '0' has chunk [MinKey, null), '1' has chunk
     // [null, -100), '2' has chunk [-100, 0), '3' has chunk ['0', 100) and '4' has chunk
@@ -123,6 +123,12 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites, but for an insert whose endpoint was already determined through
+     * NSTargeter::targetInserts.
+     */
+    void targetInsertWrite(ShardEndpoint endpoint, std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +167,14 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a child write and a TargetedWrite for each of the 'endpoints' on which this write
+     * did not already succeed.
+     */
+    void _createChildWrites(std::vector<ShardEndpoint> endpoints,
+                            bool inTransaction,
+                            std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
@@ -29,6 +29,8 @@
 
 #include "mongo/scripting/bson_template_evaluator.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 
@@ -42,8 +44,10 @@ using std::string;
 void BsonTemplateEvaluator::initializeEvaluator() {
     addOperator("RAND_INT", &BsonTemplateEvaluator::evalRandInt);
     addOperator("RAND_INT_PLUS_THREAD", &BsonTemplateEvaluator::evalRandPlusThread);
+    addOperator("ZIPF_INT", &BsonTemplateEvaluator::evalZipfInt);
     addOperator("SEQ_INT", &BsonTemplateEvaluator::evalSeqInt);
     addOperator("RAND_STRING", &BsonTemplateEvaluator::evalRandString);
+    addOperator("RAND_CHOICE", &BsonTemplateEvaluator::evalRandChoice);
     addOperator("CONCAT", &BsonTemplateEvaluator::evalConcat);
     addOperator("OID", &BsonTemplateEvaluator::evalObjId);
     addOperator("VARIABLE", &BsonTemplateEvaluator::evalVariable);
@@ -180,6 +184,40 @@ BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalRandInt(BsonTemplateEva
     return StatusSuccess;
 }
 
+BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalZipfInt(BsonTemplateEvaluator* btl,
+                                                                 const char* fieldName,
+                                                                 const BSONObj& in,
+                                                                 BSONObjBuilder& out) {
+    // in = { #ZIPF_INT: [1000, 1.0] }
+    BSONObj args = in.firstElement().embeddedObject();
+    if (!args["0"].isNumber())
+        return StatusOpEvaluationError;
+    const int numValues = args["0"].numberInt();
+    if (numValues <= 0 || numValues > (1 << 24))
+        return StatusOpEvaluationError;
+    double exponent = 1.0;
+    if (args.nFields() == 2) {
+        if (!args["1"].isNumber() || args["1"].numberDouble() < 0)
+            return StatusOpEvaluationError;
+        exponent = args["1"].numberDouble();
+    }
+
+    auto& cdf = btl->_zipfCdfMap[std::make_pair(numValues, exponent)];
+    if (cdf.empty()) {
+        cdf.reserve(numValues);
+        double total = 0;
+        for (int k = 1; k <= numValues; ++k) {
+            total += 1.0 / std::pow(k, exponent);
+            cdf.push_back(total);
+        }
+    }
+
+    const double target = btl->rng.nextCanonicalDouble() * cdf.back();
+    const auto chosen = std::upper_bound(cdf.begin(), cdf.end(), target) - cdf.begin();
+    out.append(fieldName, static_cast<int>(std::min<ptrdiff_t>(chosen, numValues - 1)));
+    return StatusSuccess;
+}
+
 BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalRandPlusThread(BsonTemplateEvaluator* btl,
                                                                         const char* fieldName,
                                                                         const BSONObj& in,
@@ -283,6 +321,20 @@ BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalRandString(BsonTemplate
     return StatusSuccess;
 }
 
+BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalRandChoice(BsonTemplateEvaluator* btl,
+                                                                    const char* fieldName,
+                                                                    const BSONObj& in,
+                                                                    BSONObjBuilder& out) {
+    // in = { #RAND_CHOICE: ["a", 2, { x: 1 }] }
+    if (in.firstElement().type() != Array)
+        return StatusOpEvaluationError;
+    std::vector<BSONElement> choices = in.firstElement().Array();
+    if (choices.empty())
+        return StatusOpEvaluationError;
+    out.appendAs(choices[btl->rng.nextInt32(choices.size())], fieldName);
+    return StatusSuccess;
+}
+
 BsonTemplateEvaluator::Status BsonTemplateEvaluator::evalConcat(BsonTemplateEvaluator* btl,
                                                                 const char* fieldName,
                                                                 const BSONObj& in,
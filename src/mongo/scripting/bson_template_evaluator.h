@@ -30,7 +30,8 @@
 /*
  * This library supports a templating language that helps in generating BSON documents from a
  * template. The language supports the following templates:
- * #RAND_INT, #SEQ_INT, #RAND_STRING, #CONCAT, #CUR_DATE, $VARIABLE and #OID.
+ * #RAND_INT, #ZIPF_INT, #SEQ_INT, #RAND_STRING, #RAND_CHOICE, #CONCAT, #CUR_DATE, $VARIABLE and
+ * #OID.
  *
  * The language will help in quickly expressing richer documents  for use in benchRun.
  * Ex. : { key : { #RAND_INT: [10, 20] } } or  { key : { #CONCAT: ["hello", " ", "world"] } }
@@ -47,6 +48,8 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/random.h"
@@ -161,6 +164,10 @@ private:
     // instance. Maps from the seq_id of the sequence to its current value.
     std::map<int, long long> _seqIdMap;
 
+    // Cumulative distributions used by ZIPF_INT, keyed by the (number of values, exponent) pair so
+    // that each distribution is only computed once per evaluator.
+    std::map<std::pair<int, double>, std::vector<double>> _zipfCdfMap;
+
     /*
      * Operator method to support #RAND_INT :  { key : { #RAND_INT: [10, 20] } }
      * The array arguments to #RAND_INT are the min and mix range between which a random number
@@ -176,6 +183,19 @@ private:
                               const BSONObj& in,
                               BSONObjBuilder& out);
 
+    /*
+     * Operator method to support #ZIPF_INT : { key : { #ZIPF_INT: [1000, 1.0] } }
+     * The array arguments to #ZIPF_INT are the number of distinct values n and the exponent s.
+     * The chosen number k is in [0, n) with a probability proportional to 1 / (k + 1)^s, so that
+     * small values are "hot" and large values form a long tail. The exponent is optional and
+     * defaults to 1.0. The number of values is limited to 2^24.
+     * This will evaluate to something like { key : 3 }
+     */
+    static Status evalZipfInt(BsonTemplateEvaluator* btl,
+                              const char* fieldName,
+                              const BSONObj& in,
+                              BSONObjBuilder& out);
+
     /*
      * Operator method to support
      *  #RAND_INT_PLUS_THREAD : { key : { #RAND_INT_PLUS_THREAD: [10, 20] } }
@@ -226,6 +246,15 @@ private:
                                  const char* fieldName,
                                  const BSONObj& in,
                                  BSONObjBuilder& out);
+    /*
+     * Operator method to support #RAND_CHOICE : { key : { #RAND_CHOICE: ["a", 2, { x: 1 }] } }
+     * Evaluates to one of the elements of the array argument, chosen uniformly at random.
+     * This will evaluate to something like { key : 2 }
+     */
+    static Status evalRandChoice(BsonTemplateEvaluator* btl,
+                                 const char* fieldName,
+                                 const BSONObj& in,
+                                 BSONObjBuilder& out);
     /*
      * Operator method to support #CONCAT : { key : { #CONCAT: ["hello", " ", "world", 2012] } }
      * The array argument to CONCAT are the strings to be concatenated. If the argument is not
@@ -269,6 +269,71 @@ TEST(BSONTemplateEvaluatorTest, RAND_INT_PLUS_THREAD) {
     ASSERT_LESS_THAN(randValue1, 5);
 }
 
+TEST(BSONTemplateEvaluatorTest, ZIPF_INT) {
+    BsonTemplateEvaluator t(1234567);
+
+    // Errors: a non-numeric, non-positive or negative-exponent argument.
+    for (auto&& args : {BSON_ARRAY("hello"), BSON_ARRAY(0), BSON_ARRAY(10 << -1.0)}) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                      t.evaluate(BSON("zipfField" << BSON("#ZIPF_INT" << args)), builder));
+    }
+
+    // Values stay in range, and with an exponent of 1.0 over 100 values the hottest value is
+    // chosen about 19% of the time, far more than the coldest half combined.
+    const int kIterations = 10000;
+    int hottest = 0;
+    int coldestHalf = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(
+            BsonTemplateEvaluator::StatusSuccess,
+            t.evaluate(BSON("zipfField" << BSON("#ZIPF_INT" << BSON_ARRAY(100 << 1.0))), builder));
+        const int value = builder.obj()["zipfField"].numberInt();
+        ASSERT_GTE(value, 0);
+        ASSERT_LT(value, 100);
+        hottest += (value == 0);
+        coldestHalf += (value >= 50);
+    }
+    ASSERT_GT(hottest, coldestHalf);
+
+    // The exponent defaults to 1.0.
+    BSONObjBuilder builder;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                  t.evaluate(BSON("zipfField" << BSON("#ZIPF_INT" << BSON_ARRAY(10))), builder));
+}
+
+TEST(BSONTemplateEvaluatorTest, RAND_CHOICE) {
+    BsonTemplateEvaluator t(1234567);
+
+    // Errors: the argument must be a non-empty array.
+    BSONObjBuilder builder1;
+    ASSERT_EQUALS(BsonTemplateEvaluator::StatusOpEvaluationError,
+                  t.evaluate(BSON("choiceField" << BSON("#RAND_CHOICE" << BSONArray())), builder1));
+
+    // Each choice keeps its type and the field name of the template.
+    bool sawString = false;
+    bool sawObject = false;
+    for (int i = 0; i < 100; ++i) {
+        BSONObjBuilder builder;
+        ASSERT_EQUALS(BsonTemplateEvaluator::StatusSuccess,
+                      t.evaluate(BSON("choiceField" << BSON("#RAND_CHOICE" << BSON_ARRAY(
+                                                                "a" << BSON("x" << 1)))),
+                                 builder));
+        BSONObj obj = builder.obj();
+        BSONElement choice = obj["choiceField"];
+        if (choice.type() == String) {
+            ASSERT_EQUALS(choice.str(), "a");
+            sawString = true;
+        } else {
+            ASSERT_BSONOBJ_EQ(choice.Obj(), BSON("x" << 1));
+            sawObject = true;
+        }
+    }
+    ASSERT_TRUE(sawString);
+    ASSERT_TRUE(sawObject);
+}
+
 TEST(BSONTemplateEvaluatorTest, SEQ_INT) {
     std::unique_ptr<BsonTemplateEvaluator> t(new BsonTemplateEvaluator(131415));
     BSONObj seqObj;
@@ -346,6 +346,10 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+// Pooled scopes are discarded once they are this old, so that garbage left in their globals by
+// earlier users doesn't build up.
+constexpr Seconds kMaxScopeReuseTime = Seconds(10);
+
 class ScopeCache {
 public:
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
@@ -404,7 +408,6 @@ private:
 
     // Note: if these numbers change, reconsider choice of datastructure for _pools
     static const unsigned kMaxPoolSize = 10;
-    constexpr static inline Seconds kMaxScopeReuseTime = Seconds(10);
 
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
@@ -412,10 +415,67 @@ private:
 };
 
 ScopeCache scopeCache;
+
+/**
+ * The idle scope kept by a thread for reuse by its next operation. Scopes created for the current
+ * thread own a JavaScript context bound to that thread, and a thread may only have one context at
+ * a time, so each thread keeps at most one.
+ */
+struct ThreadScope {
+    const ScriptEngine* engine = nullptr;
+    std::string poolKey;
+    std::unique_ptr<Scope> scope;
+};
+
+thread_local ThreadScope threadScope;
 }  // anonymous namespace
 
 void ScriptEngine::dropScopeCache() {
     scopeCache.clear();
+    dropScopeForCurrentThread();
+}
+
+Scope* ScriptEngine::newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB) {
+    dropScopeForCurrentThread();
+    return createScopeForCurrentThread(jsHeapLimitMB);
+}
+
+std::unique_ptr<Scope> ScriptEngine::tryAcquireScopeForCurrentThread(StringData poolKey) {
+    if (!threadScope.scope) {
+        return nullptr;
+    }
+
+    if (threadScope.engine != this || threadScope.poolKey != poolKey ||
+        Date_t::now() - threadScope.scope->getCreateTime() > kMaxScopeReuseTime) {
+        dropScopeForCurrentThread();
+        return nullptr;
+    }
+
+    auto scope = std::move(threadScope.scope);
+    threadScope.engine = nullptr;
+    threadScope.poolKey.clear();
+    scope->reset();
+    return scope;
+}
+
+void ScriptEngine::releaseScopeForCurrentThread(std::string poolKey,
+                                                std::unique_ptr<Scope> scope) {
+    scope->unregisterOperation();
+    if (threadScope.scope || scope->hasOutOfMemoryException() || !scope->getError().empty() ||
+        Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime) {
+        return;
+    }
+
+    scope->reset();
+    threadScope.engine = this;
+    threadScope.poolKey = std::move(poolKey);
+    threadScope.scope = std::move(scope);
+}
+
+void ScriptEngine::dropScopeForCurrentThread() {
+    threadScope.scope.reset();
+    threadScope.engine = nullptr;
+    threadScope.poolKey.clear();
 }
 
 class PooledScope : public Scope {
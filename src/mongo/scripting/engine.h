@@ -217,9 +217,12 @@ public:
         return createScope();
     }
 
-    virtual Scope* newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB) {
-        return createScopeForCurrentThread(jsHeapLimitMB);
-    }
+    /**
+     * Creates a scope which runs on the calling thread. A thread can only run one such scope at a
+     * time, so any idle scope this thread kept with releaseScopeForCurrentThread() is destroyed
+     * first.
+     */
+    virtual Scope* newScopeForCurrentThread(boost::optional<int> jsHeapLimitMB);
 
     Scope* newScopeForCurrentThread() {
         return newScopeForCurrentThread(boost::none);
@@ -256,6 +259,27 @@ public:
                                           const std::string& db,
                                           const std::string& scopeType);
 
+    /**
+     * Returns the scope the calling thread last kept with releaseScopeForCurrentThread() if it was
+     * kept under 'poolKey', or nullptr otherwise. The returned scope has been reset and is not
+     * registered with any operation.
+     */
+    std::unique_ptr<Scope> tryAcquireScopeForCurrentThread(StringData poolKey);
+
+    /**
+     * Keeps 'scope', which must have been created by newScopeForCurrentThread() on the calling
+     * thread, so that a later operation on this thread can reuse it along with the functions it
+     * has compiled. A thread keeps at most one idle scope, and never keeps scopes which are too
+     * old, have failed or ran out of memory. 'poolKey' must identify everything that must match
+     * for the scope to be shared, including the authenticated users.
+     */
+    void releaseScopeForCurrentThread(std::string poolKey, std::unique_ptr<Scope> scope);
+
+    /**
+     * Destroys the idle scope kept by the calling thread, if any.
+     */
+    static void dropScopeForCurrentThread();
+
     void setScopeInitCallback(void (*func)(Scope&)) {
         _scopeInitCallback = func;
     }
@@ -70,6 +70,8 @@ MozJSScriptEngine::MozJSScriptEngine(bool disableLoadStored) : ScriptEngine(disa
 }
 
 MozJSScriptEngine::~MozJSScriptEngine() {
+    // The idle scope this thread may have kept must go before the engine it runs on.
+    dropScopeForCurrentThread();
     JS_ShutDown();
 }
 
@@ -33,6 +33,8 @@
 
 #include "mongo/shell/bench.h"
 
+#include <algorithm>
+#include <cmath>
 #include <pcrecpp.h>
 
 #include "mongo/base/shim.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/scripting/bson_template_evaluator.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/md5.h"
@@ -331,6 +334,49 @@ BenchRunEventCounter::BenchRunEventCounter() = default;
 void BenchRunEventCounter::updateFrom(const BenchRunEventCounter& other) {
     _numEvents += other._numEvents;
     _totalTimeMicros += other._totalTimeMicros;
+    _maxTimeMicros = std::max(_maxTimeMicros, other._maxTimeMicros);
+    for (int i = 0; i < kHistogramBuckets; ++i) {
+        _histogram[i] += other._histogram[i];
+    }
+}
+
+int BenchRunEventCounter::histogramBucket(long long timeMicros) {
+    if (timeMicros < kHistogramLinearBuckets) {
+        return std::max(timeMicros, 0LL);
+    }
+
+    // The leading bit picks the power of two, and the 3 bits after it pick the sub-bucket.
+    const int exponent = 63 - countLeadingZeros64(timeMicros);
+    const int subBucket = (timeMicros >> (exponent - 3)) & (kHistogramSubBuckets - 1);
+    return kHistogramLinearBuckets + (exponent - 4) * kHistogramSubBuckets + subBucket;
+}
+
+long long BenchRunEventCounter::histogramBucketUpperBound(int bucket) {
+    if (bucket < kHistogramLinearBuckets) {
+        return bucket;
+    }
+
+    const int exponent = (bucket - kHistogramLinearBuckets) / kHistogramSubBuckets + 4;
+    const int subBucket = (bucket - kHistogramLinearBuckets) % kHistogramSubBuckets;
+    const long long width = 1LL << (exponent - 3);
+    return (kHistogramSubBuckets + subBucket) * width + width - 1;
+}
+
+long long BenchRunEventCounter::getPercentileMicros(double percentile) const {
+    if (_numEvents == 0) {
+        return 0;
+    }
+
+    const auto rank =
+        std::max(1LL, static_cast<long long>(std::ceil(percentile / 100 * _numEvents)));
+    long long seen = 0;
+    for (int i = 0; i < kHistogramBuckets; ++i) {
+        seen += _histogram[i];
+        if (seen >= rank) {
+            return std::min(histogramBucketUpperBound(i), _maxTimeMicros);
+        }
+    }
+    return _maxTimeMicros;
 }
 
 void BenchRunStats::updateFrom(const BenchRunStats& other) {
@@ -363,6 +409,7 @@ void BenchRunConfig::initializeToDefaults() {
 
     parallel = 1;
     seconds = 1.0;
+    opsPerSecond = 0;
     hideResults = true;
     handleErrors = false;
     hideErrors = false;
@@ -675,6 +722,13 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
                                   << typeName(arg.type()),
                     arg.isNumber());
             seconds = arg.number();
+        } else if (name == "opsPerSecond") {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Field '" << name
+                                  << "' should be a non-negative number. Type is "
+                                  << typeName(arg.type()),
+                    arg.isNumber() && arg.number() >= 0);
+            opsPerSecond = arg.number();
         } else if (name == "useSessions") {
             uassert(40641,
                     str::stream() << "Field '" << name << "' should be a boolean. . Type is "
@@ -895,11 +949,27 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
         }
     });
 
+    // In open-loop mode this worker issues its share of the target rate on a fixed schedule.
+    const double opIntervalMicros =
+        _config->opsPerSecond > 0 ? _config->parallel * 1000000.0 / _config->opsPerSecond : 0;
+    double nextOpDueMicros = 0;
+
     while (!shouldStop()) {
         for (const auto& op : _config->ops) {
             if (shouldStop())
                 break;
 
+            if (opIntervalMicros > 0) {
+                const auto nowMicros = static_cast<double>(timer.micros());
+                if (nowMicros < nextOpDueMicros) {
+                    sleepmicros(static_cast<long long>(nextOpDueMicros - nowMicros));
+                    opState.scheduleLagMicros = 0;
+                } else {
+                    opState.scheduleLagMicros = static_cast<long long>(nowMicros - nextOpDueMicros);
+                }
+                nextOpDueMicros += opIntervalMicros;
+            }
+
             opState.stats = shouldCollectStats() ? &_stats : &_statsBlackHole;
 
             try {
@@ -1001,7 +1071,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                 }
                 invariant(qr->validate());
 
-                BenchRunEventTrace _bret(&state->stats->findOneCounter);
+                BenchRunEventTrace _bret(&state->stats->findOneCounter,
+                                         state->takeScheduleLagMicros());
                 boost::optional<TxnNumber> txnNumberForOp;
                 if (config.useSnapshotReads) {
                     ++state->txnNumber;
@@ -1011,7 +1082,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                 runQueryWithReadCommands(
                     conn, lsid, txnNumberForOp, std::move(qr), Milliseconds(0), &result);
             } else {
-                BenchRunEventTrace _bret(&state->stats->findOneCounter);
+                BenchRunEventTrace _bret(&state->stats->findOneCounter,
+                                         state->takeScheduleLagMicros());
                 result = conn->findOne(
                     this->ns, fixedQuery, nullptr, DBClientCursor::QueryOptionLocal_forceOpQuery);
             }
@@ -1023,7 +1095,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
             bool ok;
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->commandCounter);
+                BenchRunEventTrace _bret(&state->stats->commandCounter,
+                                         state->takeScheduleLagMicros());
                 ok = runCommandWithSession(conn,
                                            this->ns,
                                            fixQuery(this->command, *state->bsonTemplateEvaluator),
@@ -1102,7 +1175,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
 
                 invariant(qr->validate());
 
-                BenchRunEventTrace _bret(&state->stats->queryCounter);
+                BenchRunEventTrace _bret(&state->stats->queryCounter,
+                                         state->takeScheduleLagMicros());
                 boost::optional<TxnNumber> txnNumberForOp;
                 if (config.useSnapshotReads) {
                     ++state->txnNumber;
@@ -1123,7 +1197,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
             } else {
                 // Use special query function for exhaust query option.
                 if (this->options & QueryOption_Exhaust) {
-                    BenchRunEventTrace _bret(&state->stats->queryCounter);
+                    BenchRunEventTrace _bret(&state->stats->queryCounter,
+                                             state->takeScheduleLagMicros());
                     std::function<void(const BSONObj&)> castedDoNothing(doNothing);
                     count =
                         conn->query(castedDoNothing,
@@ -1132,7 +1207,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
                                     &this->projection,
                                     this->options | DBClientCursor::QueryOptionLocal_forceOpQuery);
                 } else {
-                    BenchRunEventTrace _bret(&state->stats->queryCounter);
+                    BenchRunEventTrace _bret(&state->stats->queryCounter,
+                                             state->takeScheduleLagMicros());
                     std::unique_ptr<DBClientCursor> cursor(
                         conn->query(NamespaceString(this->ns),
                                     fixedQuery,
@@ -1161,7 +1237,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::UPDATE: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->updateCounter);
+                BenchRunEventTrace _bret(&state->stats->updateCounter,
+                                         state->takeScheduleLagMicros());
                 BSONObj query = fixQuery(this->query, *state->bsonTemplateEvaluator);
 
                 if (this->useWriteCmd) {
@@ -1238,7 +1315,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::INSERT: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->insertCounter);
+                BenchRunEventTrace _bret(&state->stats->insertCounter,
+                                         state->takeScheduleLagMicros());
 
                 BSONObj insertDoc;
                 if (this->useWriteCmd) {
@@ -1303,7 +1381,8 @@ void BenchRunOp::executeOnce(DBClientBase* conn,
         case OpType::REMOVE: {
             BSONObj result;
             {
-                BenchRunEventTrace _bret(&state->stats->deleteCounter);
+                BenchRunEventTrace _bret(&state->stats->deleteCounter,
+                                         state->takeScheduleLagMicros());
                 BSONObj predicate = fixQuery(this->query, *state->bsonTemplateEvaluator);
                 if (this->useWriteCmd) {
                     BSONObjBuilder builder;
@@ -1513,6 +1592,26 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     appendAverageMicrosIfAvailable("queryLatencyAverageMicros", stats.queryCounter);
     appendAverageMicrosIfAvailable("commandsLatencyAverageMicros", stats.commandCounter);
 
+    // Tail latencies, from the merged per-thread histograms.
+    const auto appendPercentilesIfAvailable = [&buf](StringData name,
+                                                     const BenchRunEventCounter& counter) {
+        if (counter.getNumEvents() > 0) {
+            BSONObjBuilder percentiles(buf.subobjStart(name));
+            percentiles.append("p50", counter.getPercentileMicros(50));
+            percentiles.append("p95", counter.getPercentileMicros(95));
+            percentiles.append("p99", counter.getPercentileMicros(99));
+            percentiles.append("p999", counter.getPercentileMicros(99.9));
+            percentiles.append("max", counter.getMaxTimeMicros());
+        }
+    };
+
+    appendPercentilesIfAvailable("findOneLatencyPercentilesMicros", stats.findOneCounter);
+    appendPercentilesIfAvailable("insertLatencyPercentilesMicros", stats.insertCounter);
+    appendPercentilesIfAvailable("deleteLatencyPercentilesMicros", stats.deleteCounter);
+    appendPercentilesIfAvailable("updateLatencyPercentilesMicros", stats.updateCounter);
+    appendPercentilesIfAvailable("queryLatencyPercentilesMicros", stats.queryCounter);
+    appendPercentilesIfAvailable("commandsLatencyPercentilesMicros", stats.commandCounter);
+
     buf.append("totalOps", static_cast<long long>(stats.opCount));
 
     const auto appendPerSec = [&buf, runner](StringData name, double total) {
@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <boost/optional.hpp>
 #include <string>
+#include <utility>
 
 #include "mongo/client/dbclient_base.h"
 #include "mongo/db/jsobj.h"
@@ -85,6 +88,17 @@ struct BenchRunOp {
         // Transaction state
         TxnNumber txnNumber = 0;
         bool inProgressMultiStatementTxn = false;
+
+        // How late the current op started relative to its open-loop schedule, in microseconds.
+        long long scheduleLagMicros = 0;
+
+        /**
+         * Returns the schedule lag of the current op, so that the first latency it records covers
+         * the time spent waiting behind earlier ops. Later calls for the same op return 0.
+         */
+        long long takeScheduleLagMicros() {
+            return std::exchange(scheduleLagMicros, 0);
+        }
     };
 
     void executeOnce(DBClientBase* conn,
@@ -201,6 +215,16 @@ public:
      */
     double seconds;
 
+    /**
+     * Target rate of operations per second across all threads, or 0 to run closed-loop.
+     *
+     * In a closed loop each thread issues its next operation as soon as the previous one returns,
+     * so a slow operation also delays the ones behind it and hides their latency. With a target
+     * rate, operations are issued on a fixed schedule and latencies are measured from the time an
+     * operation was due, not from when it was actually sent.
+     */
+    double opsPerSecond;
+
     /**
      * Whether the individual benchRun thread connections should be creating and using sessions.
      */
@@ -279,6 +303,22 @@ public:
         }
         ++_numEvents;
         _totalTimeMicros += timeMicros;
+        ++_histogram[histogramBucket(timeMicros)];
+        _maxTimeMicros = std::max(_maxTimeMicros, timeMicros);
+    }
+
+    /**
+     * Get the latency, in microseconds, below which "percentile" percent of the observed events
+     * fall. The result is the upper bound of a histogram bucket, so it overestimates by at most
+     * 1/8th, but never exceeds the largest observed latency.
+     */
+    long long getPercentileMicros(double percentile) const;
+
+    /**
+     * Get the largest observed latency in microseconds.
+     */
+    long long getMaxTimeMicros() const {
+        return _maxTimeMicros;
     }
 
     /**
@@ -295,9 +335,22 @@ public:
         return _numEvents;
     }
 
+    /**
+     * Latencies are recorded in a log-linear histogram: exact below 16 microseconds, then 8
+     * buckets per power of two.
+     */
+    static constexpr int kHistogramLinearBuckets = 16;
+    static constexpr int kHistogramSubBuckets = 8;
+    static constexpr int kHistogramBuckets = kHistogramLinearBuckets + 59 * kHistogramSubBuckets;
+
+    static int histogramBucket(long long timeMicros);
+    static long long histogramBucketUpperBound(int bucket);
+
 private:
     long long _totalTimeMicros{0};
     long long _numEvents{0};
+    long long _maxTimeMicros{0};
+    std::array<long long, kHistogramBuckets> _histogram{};
 };
 
 /**
@@ -318,7 +371,12 @@ class BenchRunEventTrace {
     BenchRunEventTrace& operator=(const BenchRunEventTrace&) = delete;
 
 public:
-    explicit BenchRunEventTrace(BenchRunEventCounter* eventCounter) {
+    /**
+     * "startedLateMicros" is added to the measured duration, to account for time an event spent
+     * waiting to be issued.
+     */
+    explicit BenchRunEventTrace(BenchRunEventCounter* eventCounter, long long startedLateMicros = 0)
+        : _startedLateMicros(startedLateMicros) {
         initialize(eventCounter, eventCounter, false);
     }
 
@@ -329,7 +387,8 @@ public:
     }
 
     ~BenchRunEventTrace() {
-        (_succeeded ? _successCounter : _failCounter)->countOne(_timer.micros());
+        (_succeeded ? _successCounter : _failCounter)
+            ->countOne(_timer.micros() + _startedLateMicros);
     }
 
     void succeed() {
@@ -349,6 +408,7 @@ private:
     }
 
     Timer _timer;
+    long long _startedLateMicros = 0;
     BenchRunEventCounter* _successCounter;
     BenchRunEventCounter* _failCounter;
     bool _succeeded;
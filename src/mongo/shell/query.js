@@ -95,8 +95,8 @@ DBQuery.prototype._canUseFindCommand = function() {
     // Since runCommand() is implemented by running a findOne() against the $cmd collection, we have
     // to make sure that we don't try to run a find command against the $cmd collection.
     //
-    // We also forbid queries with the exhaust option from running as find commands, because the
-    // find command does not support exhaust.
+    // We also forbid queries with the exhaust option from running as find commands, because
+    // runCommand() cannot receive the batches a server streams back for an exhaust find command.
     return (this._collection.getName().indexOf("$cmd") !== 0) &&
         (this._options & DBQuery.Option.exhaust) === 0;
 };
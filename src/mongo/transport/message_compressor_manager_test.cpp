@@ -43,7 +43,9 @@
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/transport/message_compressor_zstd_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -240,6 +242,15 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, FidelityAtMaximumCompressionLevel) {
+    const int oldLevel = gZstdNetworkMessageCompressionLevel.load();
+    gZstdNetworkMessageCompressionLevel.store(22);
+    ON_BLOCK_EXIT([&] { gZstdNetworkMessageCompressionLevel.store(oldLevel); });
+
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
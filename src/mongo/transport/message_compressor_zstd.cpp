@@ -36,8 +36,32 @@
 #include "mongo/base/init.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/transport/message_compressor_zstd_gen.h"
 
 namespace mongo {
+namespace {
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+/**
+ * The one-shot ZSTD_compress() and ZSTD_decompress() allocate and initialize a context for every
+ * message, which costs more than compressing a small message. The compressor is shared by all the
+ * sessions, so each thread instead keeps the contexts it used last and resets them per message.
+ */
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> compressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> decompressionContext;
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +71,20 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    if (!compressionContext) {
+        compressionContext.reset(ZSTD_createCCtx());
+        if (!compressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit,
+                          "Could not allocate a zstd compression context"};
+        }
+    }
+
+    size_t ret = ZSTD_compressCCtx(compressionContext.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   gZstdNetworkMessageCompressionLevel.load());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +96,19 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    if (!decompressionContext) {
+        decompressionContext.reset(ZSTD_createDCtx());
+        if (!decompressionContext) {
+            return Status{ErrorCodes::ExceededMemoryLimit,
+                          "Could not allocate a zstd decompression context"};
+        }
+    }
+
+    size_t ret = ZSTD_decompressDCtx(decompressionContext.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -0,0 +1,317 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_fixed.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/transport/service_executor_gen.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "fixed"_sd;
+constexpr auto kTotalQueued = "totalQueued"_sd;
+constexpr auto kTotalExecuted = "totalExecuted"_sd;
+constexpr auto kQueueingDelay = "queueingDelayMicros"_sd;
+
+constexpr auto kSynchronousServiceExecutor = "synchronous"_sd;
+constexpr auto kFixedServiceExecutor = "fixed"_sd;
+
+constexpr auto kWorkersPerNumaNode = "workersPerNumaNode"_sd;
+
+// How long a worker runs the reactor before checking whether the executor is shutting down.
+constexpr Milliseconds kWorkerRunTime{1000};
+
+/**
+ * Returns the CPUs of every NUMA node of the host, read from sysfs. Returns nothing if the host
+ * does not expose NUMA information.
+ */
+std::vector<std::vector<int>> readNumaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    for (int node = 0;; ++node) {
+        std::ifstream cpuList(str::stream()
+                              << "/sys/devices/system/node/node" << node << "/cpulist");
+        if (!cpuList) {
+            break;
+        }
+
+        // The list is made of comma separated CPU numbers or ranges, such as "0-3,8-11".
+        std::vector<int> cpus;
+        std::string range;
+        while (std::getline(cpuList, range, ',')) {
+            int first, last;
+            auto matched = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+            if (matched < 1) {
+                continue;
+            }
+            for (auto cpu = first; cpu <= (matched == 2 ? last : first); ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+#endif
+    return nodes;
+}
+
+/**
+ * Binds the calling thread to 'cpus'.
+ */
+Status pinThreadToCpus(const std::vector<int>& cpus) {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+
+    if (auto error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+        return {ErrorCodes::InternalError, errnoWithDescription(error)};
+    }
+    return Status::OK();
+#else
+    return {ErrorCodes::IllegalOperation, "Binding threads to CPUs is not supported"};
+#endif
+}
+}  // namespace
+
+Status validateServiceExecutor(const std::string& value) {
+    if (value == kSynchronousServiceExecutor || value == kFixedServiceExecutor) {
+        return Status::OK();
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Unknown service executor '" << value << "', expected '"
+                          << kSynchronousServiceExecutor << "' or '" << kFixedServiceExecutor
+                          << "'"};
+}
+
+thread_local bool ServiceExecutorFixed::_isWorkerThread = false;
+thread_local int ServiceExecutorFixed::_localRecursionDepth = 0;
+
+ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx, ReactorHandle reactor)
+    : _reactor(std::move(reactor)), _tickSource(ctx->getTickSource()) {
+    invariant(_reactor);
+}
+
+Status ServiceExecutorFixed::start() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const int threadLimit = fixedServiceExecutorThreadLimit.load();
+        _numWorkerThreads = threadLimit > 0
+            ? static_cast<size_t>(threadLimit)
+            : std::max<size_t>(1, ProcessInfo::getNumAvailableCores());
+
+        if (fixedServiceExecutorPinWorkersToNumaNodes.load()) {
+            _numaNodeCpus = readNumaNodeCpus();
+            if (_numaNodeCpus.size() < 2) {
+                LOGV2(5154003,
+                      "Not pinning the fixed service executor workers, the host does not have "
+                      "several NUMA nodes",
+                      "numNodes"_attr = _numaNodeCpus.size());
+                _numaNodeCpus.clear();
+            }
+            _numPinnedWorkersPerNode.assign(_numaNodeCpus.size(), 0);
+        }
+
+        _stillRunning.store(true);
+    }
+
+    LOGV2(5154000,
+          "Starting {numThreads} worker threads for the fixed service executor",
+          "Starting worker threads for the fixed service executor",
+          "numThreads"_attr = _numWorkerThreads);
+
+    for (size_t i = 0; i < _numWorkerThreads; ++i) {
+        auto numaNode = _numaNodeCpus.empty()
+            ? boost::none
+            : boost::make_optional(i % _numaNodeCpus.size());
+        auto status = launchServiceWorkerThread([this, numaNode] { _runWorker(numaNode); });
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    return Status::OK();
+}
+
+void ServiceExecutorFixed::_runWorker(boost::optional<size_t> numaNode) {
+    _numRunningWorkerThreads.addAndFetch(1);
+
+    bool pinned = false;
+    if (numaNode) {
+        if (auto status = pinThreadToCpus(_numaNodeCpus[*numaNode]); status.isOK()) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            ++_numPinnedWorkersPerNode[*numaNode];
+            pinned = true;
+        } else {
+            LOGV2_WARNING(5154004,
+                          "Could not pin a fixed service executor worker to its NUMA node",
+                          "numaNode"_attr = *numaNode,
+                          "error"_attr = status);
+        }
+    }
+
+    auto numRunningGuard = makeGuard([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (pinned) {
+            --_numPinnedWorkersPerNode[*numaNode];
+        }
+        _numRunningWorkerThreads.subtractAndFetch(1);
+        _shutdownCondition.notify_one();
+    });
+
+    _isWorkerThread = true;
+    while (_stillRunning.load()) {
+        _reactor->runFor(kWorkerRunTime);
+    }
+
+    LOGV2_DEBUG(5154001, 3, "Exiting worker thread in fixed service executor");
+}
+
+Status ServiceExecutorFixed::shutdown(Milliseconds timeout) {
+    LOGV2_DEBUG(5154002, 3, "Shutting down fixed executor");
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    _stillRunning.store(false);
+    _reactor->stop();
+
+    bool result = _shutdownCondition.wait_for(lk, timeout.toSystemDuration(), [this]() {
+        return _numRunningWorkerThreads.load() == 0;
+    });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "fixed executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorFixed::schedule(Task task,
+                                      ScheduleFlags flags,
+                                      ServiceExecutorTaskName taskName) {
+    if (!_stillRunning.load()) {
+        return Status{ErrorCodes::ShutdownInProgress, "Executor is not running"};
+    }
+
+    // Run the task directly on the current worker if the caller allows it, bounding the depth so
+    // that a connection which keeps finding its next message already buffered cannot blow up the
+    // stack.
+    if (_isWorkerThread && (flags & ScheduleFlags::kMayRecurse) &&
+        (_localRecursionDepth < fixedServiceExecutorRecursionLimit.loadRelaxed())) {
+        ++_localRecursionDepth;
+        task();
+        return Status::OK();
+    }
+
+    _totalQueued.addAndFetch(1);
+    _reactor->schedule(
+        [this, task = std::move(task), scheduledAt = _tickSource->getTicks()](Status) {
+            _recordQueueingDelay(scheduledAt);
+            _localRecursionDepth = 1;
+            task();
+            _totalExecuted.addAndFetch(1);
+        });
+
+    return Status::OK();
+}
+
+void ServiceExecutorFixed::_recordQueueingDelay(TickSource::Tick scheduledAt) {
+    const auto delayMicros = durationCount<Microseconds>(
+        _tickSource->ticksTo<Microseconds>(_tickSource->getTicks() - scheduledAt));
+    _totalQueueingDelayMicros.addAndFetch(delayMicros);
+
+    size_t bucket = 0;
+    if (delayMicros > 0) {
+        bucket = std::min<size_t>(64 - countLeadingZeros64(delayMicros),
+                                  kNumQueueingDelayBuckets - 1);
+    }
+    _queueingDelayBuckets[bucket].addAndFetch(1);
+}
+
+void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
+    *bob << kExecutorLabel << kExecutorName << kThreadsRunning
+         << static_cast<int>(_numRunningWorkerThreads.loadRelaxed()) << kTotalQueued
+         << static_cast<long long>(_totalQueued.loadRelaxed()) << kTotalExecuted
+         << static_cast<long long>(_totalExecuted.loadRelaxed());
+
+    BSONObjBuilder delayBuilder(bob->subobjStart(kQueueingDelay));
+    {
+        BSONArrayBuilder histogramBuilder(delayBuilder.subarrayStart("histogram"));
+        for (size_t i = 0; i < kNumQueueingDelayBuckets; ++i) {
+            const auto count = _queueingDelayBuckets[i].loadRelaxed();
+            if (count == 0) {
+                continue;
+            }
+            BSONObjBuilder entryBuilder(histogramBuilder.subobjStart());
+            entryBuilder.append("micros", i == 0 ? 0LL : 1LL << (i - 1));
+            entryBuilder.append("count", static_cast<long long>(count));
+        }
+    }
+    delayBuilder.append("total", static_cast<long long>(_totalQueueingDelayMicros.loadRelaxed()));
+    delayBuilder.doneFast();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_numPinnedWorkersPerNode.empty()) {
+        BSONArrayBuilder nodesBuilder(bob->subarrayStart(kWorkersPerNumaNode));
+        for (auto numWorkers : _numPinnedWorkersPerNode) {
+            nodesBuilder.append(static_cast<int>(numWorkers));
+        }
+    }
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_task_names.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/tick_source.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * Validates the value of the 'serviceExecutor' server parameter.
+ */
+Status validateServiceExecutor(const std::string& value);
+
+/**
+ * The fixed service executor runs the work of every connection on a bounded pool of worker
+ * threads instead of dedicating a thread to each connection.
+ *
+ * Each worker thread runs the event loop of the reactor it is given, which is expected to be the
+ * ingress reactor of the transport layer. Scheduled tasks are posted onto that reactor, and since
+ * the executor runs in asynchronous mode, the ServiceStateMachine sources and sinks its messages
+ * with asynchronous reads and writes whose completions are dispatched to the same workers. An
+ * idle connection therefore holds no thread.
+ *
+ * The time every task spends queued before a worker picks it up is recorded in a histogram that
+ * is reported in serverStatus.
+ *
+ * On hosts with several NUMA nodes, the workers can be spread across the nodes and bound to their
+ * CPUs, so that they do not migrate between nodes and the memory they first touch stays local.
+ */
+class ServiceExecutorFixed final : public ServiceExecutor {
+public:
+    ServiceExecutorFixed(ServiceContext* ctx, ReactorHandle reactor);
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status schedule(Task task, ScheduleFlags flags, ServiceExecutorTaskName taskName) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+    /**
+     * Number of buckets of the queueing delay histogram. Bucket 0 counts the tasks that waited
+     * less than one microsecond, bucket i > 0 the tasks that waited [2^(i-1), 2^i) microseconds,
+     * and the last bucket everything above.
+     */
+    static constexpr size_t kNumQueueingDelayBuckets = 32;
+
+private:
+    void _runWorker(boost::optional<size_t> numaNode);
+    void _recordQueueingDelay(TickSource::Tick scheduledAt);
+
+    static thread_local bool _isWorkerThread;
+    static thread_local int _localRecursionDepth;
+
+    ReactorHandle _reactor;
+    TickSource* const _tickSource;
+
+    AtomicWord<bool> _stillRunning{false};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ServiceExecutorFixed::_mutex");
+    stdx::condition_variable _shutdownCondition;
+    size_t _numWorkerThreads{0};
+
+    // The CPUs of each NUMA node when workers are pinned to them, and how many workers are pinned
+    // to each node. Both are empty otherwise.
+    std::vector<std::vector<int>> _numaNodeCpus;
+    std::vector<size_t> _numPinnedWorkersPerNode;
+
+    AtomicWord<size_t> _numRunningWorkerThreads{0};
+    AtomicWord<int64_t> _totalQueued{0};
+    AtomicWord<int64_t> _totalExecuted{0};
+    AtomicWord<int64_t> _totalQueueingDelayMicros{0};
+    std::array<AtomicWord<int64_t>, kNumQueueingDelayBuckets> _queueingDelayBuckets;
+};
+
+}  // namespace transport
+}  // namespace mongo
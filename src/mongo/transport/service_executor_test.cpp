@@ -35,11 +35,14 @@
 
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/transport/service_executor_fixed.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/service_executor_task_names.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 #include <asio.hpp>
 
@@ -161,6 +164,89 @@ TEST_F(ServiceExecutorSynchronousFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+class ServiceExecutorFixedFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = ServiceContext::make();
+        setGlobalServiceContext(std::move(scOwned));
+
+        executor = std::make_unique<ServiceExecutorFixed>(getGlobalServiceContext(),
+                                                          std::make_shared<ASIOReactor>());
+    }
+
+    std::unique_ptr<ServiceExecutorFixed> executor;
+};
+
+TEST_F(ServiceExecutorFixedFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorFixedFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorFixedFixture, ScheduleFailsAfterShutdown) {
+    ASSERT_OK(executor->start());
+    ASSERT_OK(executor->shutdown(kShutdownTime));
+
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorFixedFixture, StatsReportQueueingDelay) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+    scheduleBasicTask(executor.get(), true);
+
+    // The stats are updated once the task returns, which may be after the waiter was notified.
+    BSONObj stats;
+    for (int i = 0; i < 100; ++i) {
+        BSONObjBuilder bob;
+        executor->appendStats(&bob);
+        stats = bob.obj();
+        if (stats["totalExecuted"].numberLong() == 2) {
+            break;
+        }
+        sleepmillis(10);
+    }
+
+    ASSERT_EQ(stats["executor"].str(), "fixed");
+    ASSERT_EQ(stats["totalQueued"].numberLong(), 2);
+    ASSERT_EQ(stats["totalExecuted"].numberLong(), 2);
+
+    long long histogramCount = 0;
+    for (auto&& entry : stats["queueingDelayMicros"]["histogram"].Obj()) {
+        histogramCount += entry["count"].numberLong();
+    }
+    ASSERT_EQ(histogramCount, 2);
+}
+
+TEST_F(ServiceExecutorFixedFixture, TasksRunWithWorkersPinnedToNumaNodes) {
+    fixedServiceExecutorPinWorkersToNumaNodes.store(true);
+    ON_BLOCK_EXIT([] { fixedServiceExecutorPinWorkersToNumaNodes.store(false); });
+
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+
+    // Workers are only pinned on hosts with several NUMA nodes, each of them to a single node.
+    BSONObjBuilder bob;
+    executor->appendStats(&bob);
+    auto stats = bob.obj();
+    if (auto workersPerNode = stats["workersPerNumaNode"]; !workersPerNode.eoo()) {
+        int numPinnedWorkers = 0;
+        for (auto&& numWorkers : workersPerNode.Obj()) {
+            numPinnedWorkers += numWorkers.numberInt();
+        }
+        ASSERT_LTE(numPinnedWorkers, stats["threadsRunning"].numberInt());
+    }
+}
+
 
 }  // namespace
 }  // namespace mongo
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -37,8 +40,10 @@
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/timer.h"
 #ifdef MONGO_CONFIG_SSL
 #include "mongo/util/net/ssl_manager.h"
 #include "mongo/util/net/ssl_types.h"
@@ -259,6 +264,9 @@ protected:
             std::move(_socket), *_tl->_egressSSLContext, removeFQDNRoot(target.host()));
         lk.unlock();
 
+        getSSLManager()->prepareEgressHandshake(_sslSocket->native_handle(), target);
+        Timer handshakeTimer;
+
         auto doHandshake = [&] {
             if (_blockingMode == Sync) {
                 std::error_code ec;
@@ -268,8 +276,9 @@ protected:
                 return _sslSocket->async_handshake(asio::ssl::stream_base::client, UseFuture{});
             }
         };
-        return doHandshake().then([this, target, reactor] {
+        return doHandshake().then([this, target, reactor, handshakeTimer] {
             _ranHandshake = true;
+            recordTLSHandshake(handshakeTimer);
 
             return getSSLManager()
                 ->parseAndValidatePeerCertificate(_sslSocket->native_handle(),
@@ -283,6 +292,12 @@ protected:
         });
     }
 
+    void recordTLSHandshake(const Timer& handshakeTimer) {
+        auto& counts = TLSSessionCounts::get(getGlobalServiceContext());
+        counts.handshakes.addAndFetch(1);
+        counts.handshakeMicros.addAndFetch(handshakeTimer.micros());
+    }
+
     // For synchronous connections where we don't have an async timer, just take a dummy lock and
     // pass it to the WithLock version of handshakeSSLForEgress
     Future<void> handshakeSSLForEgress(const HostAndPort& target) {
@@ -379,8 +394,30 @@ private:
         return _socket;
     }
 
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+    Status validateMessageLength(size_t msgLen) {
+        if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+            StringBuilder sb;
+            sb << "recv(): message msgLen " << msgLen << " is invalid. "
+               << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+            const auto str = sb.str();
+            LOGV2(4615638,
+                  "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+                  "recv(): message mstLen is invalid.",
+                  "msgLen"_attr = msgLen,
+                  "min"_attr = kHeaderSize,
+                  "max"_attr = MaxMessageSizeBytes);
+
+            return Status(ErrorCodes::ProtocolError, str);
+        }
+        return Status::OK();
+    }
+
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+        if (canReadAhead(baton)) {
+            return sourceMessageWithReadAhead();
+        }
 
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
@@ -391,19 +428,8 @@ private:
                 }
 
                 const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOGV2(4615638,
-                          "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                          "recv(): message mstLen is invalid.",
-                          "msgLen"_attr = msgLen,
-                          "min"_attr = kHeaderSize,
-                          "max"_attr = MaxMessageSizeBytes);
-
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+                if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+                    return Future<Message>::makeReady(std::move(status));
                 }
 
                 if (msgLen == kHeaderSize) {
@@ -428,6 +454,99 @@ private:
             });
     }
 
+    /**
+     * Returns true if the next message can be sourced through the read-ahead buffer. This is only
+     * done for plain ingress sessions without a baton, once the first read has established that
+     * the session does not use TLS.
+     */
+    bool canReadAhead(const BatonHandle& baton) const {
+        if (!_isIngressSession || baton || gIngressReadAheadBufferBytes == 0) {
+            return false;
+        }
+#ifdef MONGO_CONFIG_SSL
+        return _ranHandshake && !_sslSocket;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * Sources a message by reading as many bytes as are available into the read-ahead buffer, so
+     * that the header and body of a small message arrive with a single read instead of two. Any
+     * bytes past the end of the message stay buffered for the next call. A message which does not
+     * fit in what was read ahead has its remainder read directly into the message buffer.
+     */
+    Future<Message> sourceMessageWithReadAhead() {
+        if (!_readAheadBuffer) {
+            _readAheadCapacity =
+                std::max(static_cast<size_t>(gIngressReadAheadBufferBytes), kHeaderSize);
+            _readAheadBuffer = std::make_unique<char[]>(_readAheadCapacity);
+        }
+
+        if (_readAheadEnd - _readAheadBegin < kHeaderSize) {
+            // Move the partial header, if any, to the front of the buffer and fill the rest.
+            std::memmove(_readAheadBuffer.get(),
+                         _readAheadBuffer.get() + _readAheadBegin,
+                         _readAheadEnd - _readAheadBegin);
+            _readAheadEnd -= _readAheadBegin;
+            _readAheadBegin = 0;
+
+            return opportunisticReadSome(asio::buffer(_readAheadBuffer.get() + _readAheadEnd,
+                                                      _readAheadCapacity - _readAheadEnd))
+                .then([this](size_t size) {
+                    _readAheadEnd += size;
+                    return sourceMessageWithReadAhead();
+                });
+        }
+
+        const char* header = _readAheadBuffer.get() + _readAheadBegin;
+        if (checkForHTTPRequest(asio::buffer(header, kHeaderSize))) {
+            return sendHTTPResponse();
+        }
+
+        const auto msgLen = size_t(MSGHEADER::ConstView(header).getMessageLength());
+        if (auto status = validateMessageLength(msgLen); !status.isOK()) {
+            return Future<Message>::makeReady(std::move(status));
+        }
+
+        auto buffer = SharedBuffer::allocate(msgLen);
+        const size_t buffered = std::min(msgLen, _readAheadEnd - _readAheadBegin);
+        memcpy(buffer.get(), header, buffered);
+        _readAheadBegin += buffered;
+        if (_readAheadBegin == _readAheadEnd) {
+            _readAheadBegin = _readAheadEnd = 0;
+        }
+
+        if (buffered == msgLen) {
+            networkCounter.hitPhysicalIn(msgLen);
+            return Future<Message>::makeReady(Message(std::move(buffer)));
+        }
+
+        auto ptr = buffer.get() + buffered;
+        return read(asio::buffer(ptr, msgLen - buffered))
+            .then([buffer = std::move(buffer), msgLen]() mutable {
+                networkCounter.hitPhysicalIn(msgLen);
+                return Message(std::move(buffer));
+            });
+    }
+
+    /**
+     * Reads whatever is available on the plain socket into 'buffer', waiting for at least one byte.
+     */
+    Future<size_t> opportunisticReadSome(asio::mutable_buffer buffer) {
+        std::error_code ec;
+        size_t size;
+        do {
+            size = _socket.read_some(buffer, ec);
+        } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            return _socket.async_read_some(buffer, UseFuture{});
+        }
+        return futurize(ec, size);
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancelation here.
@@ -460,6 +579,8 @@ private:
 #ifdef MONGO_CONFIG_SSL
         _ranHandshake = true;
         if (_sslSocket) {
+            TLSSessionCounts::get(getGlobalServiceContext())
+                .bytesEncrypted.addAndFetch(asio::buffer_size(buffers));
 #ifdef __linux__
             // We do some trickery in asio (see moreToSend), which appears to work well on linux,
             // but fails on other platforms.
@@ -678,6 +799,7 @@ private:
             }
 
             _sslSocket.emplace(std::move(_socket), *_tl->_ingressSSLContext, "");
+            Timer handshakeTimer;
             auto doHandshake = [&] {
                 if (_blockingMode == Sync) {
                     std::error_code ec;
@@ -688,7 +810,8 @@ private:
                         asio::ssl::stream_base::server, buffer, UseFuture{});
                 }
             };
-            return doHandshake().then([this](size_t size) {
+            return doHandshake().then([this, handshakeTimer](size_t size) {
+                recordTLSHandshake(handshakeTimer);
                 if (SSLPeerInfo::forSession(shared_from_this()).subjectName.empty()) {
                     return getSSLManager()
                         ->parseAndValidatePeerCertificate(_sslSocket->native_handle(),
@@ -784,6 +907,13 @@ private:
     bool _ranHandshake = false;
 #endif
 
+    // Bytes read from the socket ahead of the message being sourced, see
+    // sourceMessageWithReadAhead(). The unconsumed bytes are [_readAheadBegin, _readAheadEnd).
+    std::unique_ptr<char[]> _readAheadBuffer;
+    size_t _readAheadCapacity = 0;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
@@ -36,9 +36,11 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/net/sock.h"
+#include "mongo/util/scopeguard.h"
 
 #include "asio.hpp"
 
@@ -272,16 +274,31 @@ public:
         }
     }
 
-    void sendMessage() {
+    static Message makeMessage(size_t padding = 0) {
         OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
+        builder.setBody(BSON("ping" << 1 << "padding" << std::string(padding, 'x')));
         Message msg = builder.finish();
         msg.header().setResponseToMsgId(0);
         msg.header().setId(0);
         OpMsg::appendChecksum(&msg);
+        return msg;
+    }
+
+    void sendMessage() {
+        sendMessages({makeMessage()});
+    }
+
+    /**
+     * Sends all of 'messages' with a single write.
+     */
+    void sendMessages(const std::vector<Message>& messages) {
+        std::string bytes;
+        for (const auto& msg : messages) {
+            bytes.append(msg.buf(), msg.size());
+        }
 
         std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        asio::write(_sock, asio::buffer(bytes.data(), bytes.size()), ec);
         ASSERT_FALSE(ec);
     }
 
@@ -366,6 +383,61 @@ public:
     }
 };
 
+/* check that messages are sourced intact when the session reads ahead of them */
+class ReadAheadSEP : public TimeoutSEP {
+public:
+    explicit ReadAheadSEP(size_t numMessages) : _numMessages(numMessages) {}
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (size_t i = 0; i < _numMessages; ++i) {
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                _messageSizes.push_back(swMessage.getValue().size());
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+
+    const std::vector<int>& messageSizes() const {
+        return _messageSizes;
+    }
+
+private:
+    const size_t _numMessages;
+    std::vector<int> _messageSizes;
+};
+
+TEST(TransportLayerASIO, SourceMessagesWithReadAhead) {
+    const auto originalReadAheadBufferBytes = transport::gIngressReadAheadBufferBytes;
+    transport::gIngressReadAheadBufferBytes = 1024;
+    ON_BLOCK_EXIT([&] { transport::gIngressReadAheadBufferBytes = originalReadAheadBufferBytes; });
+
+    // Several small messages which arrive together, one larger than the read-ahead buffer and a
+    // last small one.
+    std::vector<Message> messages{TimeoutConnector::makeMessage(),
+                                  TimeoutConnector::makeMessage(),
+                                  TimeoutConnector::makeMessage(),
+                                  TimeoutConnector::makeMessage(4 * 1024),
+                                  TimeoutConnector::makeMessage()};
+
+    ReadAheadSEP sep(messages.size() + 1);
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), true);
+    connector.sendMessages(messages);
+
+    ASSERT_TRUE(sep.waitForTimeout(Milliseconds{10 * 1000}));
+    tla->shutdown();
+
+    ASSERT_EQ(sep.messageSizes().size(), messages.size() + 1);
+    for (size_t i = 0; i < messages.size(); ++i) {
+        ASSERT_EQ(sep.messageSizes()[i + 1], messages[i].size());
+    }
+}
+
 TEST(TransportLayerASIO, SwitchTimeoutModes) {
     TimeoutSwitchModesSEP sep;
     auto tla = makeAndStartTL(&sep);
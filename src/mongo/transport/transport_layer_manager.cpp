@@ -41,6 +41,8 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/transport/service_executor_fixed.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
@@ -134,13 +136,24 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     const ServerGlobalParams* config, ServiceContext* ctx) {
     auto sep = ctx->getServiceEntryPoint();
 
-    transport::TransportLayerASIO::Options opts(config);
-    opts.transportMode = transport::Mode::kSynchronous;
+    const bool useFixedExecutor = serviceExecutor == "fixed";
 
-    ctx->setServiceExecutor(std::make_unique<ServiceExecutorSynchronous>(ctx));
+    transport::TransportLayerASIO::Options opts(config);
+    opts.transportMode =
+        useFixedExecutor ? transport::Mode::kAsynchronous : transport::Mode::kSynchronous;
+
+    auto tl = std::make_unique<transport::TransportLayerASIO>(opts, sep);
+    if (useFixedExecutor) {
+        // The fixed executor's workers run the ingress reactor, on which the asynchronous reads
+        // and writes of accepted sessions complete.
+        ctx->setServiceExecutor(std::make_unique<ServiceExecutorFixed>(
+            ctx, tl->getReactor(TransportLayer::kIngress)));
+    } else {
+        ctx->setServiceExecutor(std::make_unique<ServiceExecutorSynchronous>(ctx));
+    }
 
     std::vector<std::unique_ptr<TransportLayer>> retVector;
-    retVector.emplace_back(std::make_unique<transport::TransportLayerASIO>(opts, sep));
+    retVector.emplace_back(std::move(tl));
     return std::make_unique<TransportLayerManager>(std::move(retVector));
 }
 
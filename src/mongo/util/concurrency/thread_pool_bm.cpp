@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kTasksPerIteration = 10'000;
+constexpr int kChainLength = 100;
+
+std::unique_ptr<ThreadPoolInterface> makeThreadPool(size_t numThreads) {
+    ThreadPool::Options options;
+    options.minThreads = numThreads;
+    options.maxThreads = numThreads;
+    return std::make_unique<ThreadPool>(options);
+}
+
+std::unique_ptr<ThreadPoolInterface> makeWorkStealingThreadPool(size_t numThreads) {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = numThreads;
+    return std::make_unique<WorkStealingThreadPool>(options);
+}
+
+/**
+ * Counts the tasks of an iteration down and lets the benchmark thread wait for them all.
+ */
+class TaskCounter {
+public:
+    void reset(int count) {
+        _remaining.store(count);
+    }
+
+    void countDown() {
+        if (_remaining.subtractAndFetch(1) == 0) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _done = true;
+            _cv.notify_one();
+        }
+    }
+
+    void wait() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _done; });
+        _done = false;
+    }
+
+private:
+    AtomicWord<int> _remaining{0};
+    Mutex _mutex = MONGO_MAKE_LATCH("TaskCounter::_mutex");
+    stdx::condition_variable _cv;
+    bool _done = false;
+};
+
+void scheduleChainStep(ThreadPoolInterface* pool, TaskCounter* counter, int remaining) {
+    if (remaining == 0) {
+        counter->countDown();
+        return;
+    }
+    pool->schedule([=](Status) { scheduleChainStep(pool, counter, remaining - 1); });
+}
+
+/**
+ * Schedules independent tasks from outside the pool, as a task executor does for the callbacks of
+ * responses read on a networking thread.
+ */
+template <typename MakePool>
+void runIndependentTasks(benchmark::State& state, MakePool makePool) {
+    auto pool = makePool(state.range(0));
+    pool->startup();
+
+    TaskCounter counter;
+    for (auto _ : state) {
+        counter.reset(kTasksPerIteration);
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            pool->schedule([&](Status) { counter.countDown(); });
+        }
+        counter.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+
+    pool->shutdown();
+    pool->join();
+}
+
+/**
+ * Runs chains of tasks in which each task schedules the next one, as continuations do.
+ */
+template <typename MakePool>
+void runChainedTasks(benchmark::State& state, MakePool makePool) {
+    const int numThreads = state.range(0);
+    auto pool = makePool(numThreads);
+    pool->startup();
+
+    TaskCounter counter;
+    for (auto _ : state) {
+        counter.reset(numThreads);
+        for (int i = 0; i < numThreads; ++i) {
+            scheduleChainStep(pool.get(), &counter, kChainLength);
+        }
+        counter.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * numThreads * kChainLength);
+
+    pool->shutdown();
+    pool->join();
+}
+
+void BM_threadPoolIndependentTasks(benchmark::State& state) {
+    runIndependentTasks(state, makeThreadPool);
+}
+
+void BM_workStealingThreadPoolIndependentTasks(benchmark::State& state) {
+    runIndependentTasks(state, makeWorkStealingThreadPool);
+}
+
+void BM_threadPoolChainedTasks(benchmark::State& state) {
+    runChainedTasks(state, makeThreadPool);
+}
+
+void BM_workStealingThreadPoolChainedTasks(benchmark::State& state) {
+    runChainedTasks(state, makeWorkStealingThreadPool);
+}
+
+BENCHMARK(BM_threadPoolIndependentTasks)->RangeMultiplier(2)->Range(1, 128)->UseRealTime();
+BENCHMARK(BM_workStealingThreadPoolIndependentTasks)
+    ->RangeMultiplier(2)
+    ->Range(1, 128)
+    ->UseRealTime();
+BENCHMARK(BM_threadPoolChainedTasks)->RangeMultiplier(2)->Range(1, 128)->UseRealTime();
+BENCHMARK(BM_workStealingThreadPoolChainedTasks)->RangeMultiplier(2)->Range(1, 128)->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include <iostream>
 
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -89,16 +90,25 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
+    waitForTicketUntil(opCtx, Date_t::max(), priority);
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
+    if (priority == AdmissionPriority::kLow) {
+        return _waitForLowPriorityTicketUntil(opCtx, until);
+    }
+
     // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
     if (sem_trywait(&_sem) == 0) {
         return true;
     }
 
+    _normalPriorityWaiters.fetchAndAdd(1);
+    ON_BLOCK_EXIT([&] { _normalPriorityWaiters.fetchAndSubtract(1); });
+
     const Milliseconds intervalMs(500);
     struct timespec ts;
 
@@ -129,6 +139,25 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     return true;
 }
 
+bool TicketHolder::_waitForLowPriorityTicketUntil(OperationContext* opCtx, Date_t until) {
+    // Semaphore waiters are woken in no particular order, so rather than competing with normal
+    // priority operations on '_sem', poll for a ticket whenever none of them is waiting.
+    const Milliseconds intervalMs(10);
+    while (_normalPriorityWaiters.load() > 0 || !tryAcquire()) {
+        const auto now = Date_t::now();
+        if (now >= until)
+            return false;
+
+        const auto interval = std::min<Milliseconds>(intervalMs, until - now);
+        if (opCtx) {
+            opCtx->sleepFor(interval);
+        } else {
+            sleepFor(interval);
+        }
+    }
+    return true;
+}
+
 void TicketHolder::release() {
     check(sem_post(&_sem));
 }
@@ -184,34 +213,62 @@ bool TicketHolder::tryAcquire() {
     return _tryAcquire();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
     stdx::unique_lock<Latch> lk(_mutex);
 
+    const bool lowPriority = priority == AdmissionPriority::kLow;
+    int& waiters = lowPriority ? _lowPriorityWaiters : _normalPriorityWaiters;
+    waiters++;
+    ON_BLOCK_EXIT([&] {
+        waiters--;
+        // Low priority waiters may have skipped tickets while this operation was queued.
+        if (!lowPriority && _normalPriorityWaiters == 0 && _lowPriorityWaiters > 0)
+            _newTicket.notify_all();
+    });
+
+    auto pred = [&] { return (!lowPriority || _normalPriorityWaiters == 0) && _tryAcquire(); };
     if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
+        opCtx->waitForConditionOrInterrupt(_newTicket, lk, pred);
     } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+        _newTicket.wait(lk, pred);
     }
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
     stdx::unique_lock<Latch> lk(_mutex);
 
+    const bool lowPriority = priority == AdmissionPriority::kLow;
+    int& waiters = lowPriority ? _lowPriorityWaiters : _normalPriorityWaiters;
+    waiters++;
+    ON_BLOCK_EXIT([&] {
+        waiters--;
+        if (!lowPriority && _normalPriorityWaiters == 0 && _lowPriorityWaiters > 0)
+            _newTicket.notify_all();
+    });
+
+    auto pred = [&] { return (!lowPriority || _normalPriorityWaiters == 0) && _tryAcquire(); };
     if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
+        return opCtx->waitForConditionOrInterruptUntil(_newTicket, lk, until, pred);
     } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+        return _newTicket.wait_until(lk, until.toSystemTimePoint(), pred);
     }
 }
 
 void TicketHolder::release() {
+    bool wakeAll;
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _num++;
+        // A single wakeup could go to a low priority waiter that has to keep waiting.
+        wakeAll = _lowPriorityWaiters > 0;
+    }
+    if (wakeAll) {
+        _newTicket.notify_all();
+    } else {
+        _newTicket.notify_one();
     }
-    _newTicket.notify_one();
 }
 
 Status TicketHolder::resize(int newSize) {
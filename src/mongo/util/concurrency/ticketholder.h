@@ -35,6 +35,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
@@ -55,8 +56,10 @@ public:
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
+     * A low 'priority' waiter does not take a ticket while normal priority waiters are queued.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       AdmissionPriority priority = AdmissionPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +71,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            AdmissionPriority priority = AdmissionPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -84,8 +89,14 @@ public:
 
 private:
 #if defined(__linux__)
+    bool _waitForLowPriorityTicketUntil(OperationContext* opCtx, Date_t until);
+
     mutable sem_t _sem;
 
+    // Number of normal priority operations blocked on '_sem'. Low priority operations poll for a
+    // ticket instead and only take one while this is zero.
+    AtomicWord<int> _normalPriorityWaiters{0};
+
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
@@ -95,6 +106,8 @@ private:
 
     AtomicWord<int> _outof;
     int _num;
+    int _normalPriorityWaiters = 0;
+    int _lowPriorityWaiters = 0;
     Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
     stdx::condition_variable _newTicket;
 #endif
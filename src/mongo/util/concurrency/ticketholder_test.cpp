@@ -72,4 +72,22 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, LowPriorityTimeout) {
+    TicketHolder holder(1);
+
+    {
+        ScopedTicket ticket(&holder);
+        ASSERT_FALSE(holder.waitForTicketUntil(nullptr, Date_t::now(), AdmissionPriority::kLow));
+        ASSERT_FALSE(holder.waitForTicketUntil(
+            nullptr, Date_t::now() + Milliseconds(42), AdmissionPriority::kLow));
+    }
+
+    // With no normal priority operation queued, a low priority one gets the ticket right away.
+    ASSERT(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(20), AdmissionPriority::kLow));
+    ASSERT_EQ(holder.used(), 1);
+    holder.release();
+    ASSERT_EQ(holder.used(), 0);
+}
 }  // namespace
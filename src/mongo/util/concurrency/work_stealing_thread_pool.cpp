@@ -0,0 +1,267 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+#include "mongo/base/status.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// Counter used to assign unique names to otherwise-unnamed thread pools.
+AtomicWord<int> nextUnnamedPoolId{1};
+
+// The pool and the index of the worker the current thread runs, if any.
+thread_local const WorkStealingThreadPool* currentPool = nullptr;
+thread_local size_t currentWorkerIndex = 0;
+
+WorkStealingThreadPool::Options cleanUpOptions(WorkStealingThreadPool::Options&& options) {
+    if (options.poolName.empty()) {
+        options.poolName = str::stream()
+            << "WorkStealingThreadPool" << nextUnnamedPoolId.fetchAndAdd(1);
+    }
+    if (options.threadNamePrefix.empty()) {
+        options.threadNamePrefix = str::stream() << options.poolName << '-';
+    }
+    if (options.numThreads < 1) {
+        LOGV2_FATAL(5155000,
+                    "Cannot create a work stealing pool without threads",
+                    "poolName"_attr = options.poolName);
+    }
+    return {std::move(options)};
+}
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(Options options)
+    : _options(cleanUpOptions(std::move(options))) {
+    _workers.reserve(_options.numThreads);
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    shutdown();
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (_state != shutdownComplete) {
+        lk.unlock();
+        join();
+    }
+}
+
+void WorkStealingThreadPool::startup() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != preStart) {
+        LOGV2_FATAL(5155001,
+                    "Attempted to start pool that has already started",
+                    "poolName"_attr = _options.poolName);
+    }
+    _setState_inlock(running);
+
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        const std::string threadName = str::stream() << _options.threadNamePrefix << i;
+        _threads.emplace_back([this, i, threadName] {
+            setThreadName(threadName);
+            _options.onCreateThread(threadName);
+            LOGV2_DEBUG(5155002,
+                        1,
+                        "Starting thread",
+                        "threadName"_attr = threadName,
+                        "poolName"_attr = _options.poolName);
+            _consumeTasks(i);
+        });
+    }
+}
+
+void WorkStealingThreadPool::shutdown() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != preStart && _state != running) {
+        return;
+    }
+
+    _scheduleState.fetchAndBitOr(kShutdownMask);
+    _setState_inlock(joinRequired);
+
+    stdx::lock_guard<Latch> idleLk(_idleMutex);
+    _workAvailable.notify_all();
+}
+
+void WorkStealingThreadPool::join() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _stateChange.wait(lk, [this] {
+        switch (_state) {
+            case preStart:
+            case running:
+                return false;
+            case joinRequired:
+                return true;
+            case joining:
+            case shutdownComplete:
+                LOGV2_FATAL(5155003,
+                            "Attempted to join pool more than once",
+                            "poolName"_attr = _options.poolName);
+        }
+        MONGO_UNREACHABLE;
+    });
+    _setState_inlock(joining);
+    auto threadsToJoin = std::exchange(_threads, {});
+    lk.unlock();
+
+    // The workers only exit once the queues are empty, but the calls to schedule() which were past
+    // the shutdown check when the pool shut down may still queue tasks.
+    for (auto& thread : threadsToJoin) {
+        thread.join();
+    }
+    while (_scheduleState.load() != kShutdownMask) {
+        stdx::this_thread::yield();
+    }
+    _drainPendingTasks();
+
+    lk.lock();
+    _setState_inlock(shutdownComplete);
+}
+
+void WorkStealingThreadPool::schedule(Task task) {
+    if (_scheduleState.fetchAndAdd(1) & kShutdownMask) {
+        _scheduleState.fetchAndSubtract(1);
+        task(Status(ErrorCodes::ShutdownInProgress,
+                    str::stream() << "Shutdown of thread pool " << _options.poolName
+                                  << " in progress"));
+        return;
+    }
+
+    // Keep the tasks scheduled by a worker on its own queue.
+    const auto workerIndex = currentPool == this
+        ? currentWorkerIndex
+        : _nextWorker.fetchAndAdd(1) % _workers.size();
+    {
+        auto& worker = *_workers[workerIndex];
+        stdx::lock_guard<Latch> lk(worker.mutex);
+        worker.tasks.emplace_back(std::move(task));
+        _numPendingTasks.fetchAndAdd(1);
+    }
+
+    // A worker going to sleep counts itself idle before it checks for pending tasks, so either it
+    // sees this task or this sees it idle.
+    if (_numIdleWorkers.load() > 0) {
+        stdx::lock_guard<Latch> lk(_idleMutex);
+        _workAvailable.notify_one();
+    }
+
+    // The pool may be destroyed as soon as join() sees this call finished.
+    _scheduleState.fetchAndSubtract(1);
+}
+
+WorkStealingThreadPool::Stats WorkStealingThreadPool::getStats() const {
+    return {_numPendingTasks.load(), _numStolenTasks.load()};
+}
+
+void WorkStealingThreadPool::_consumeTasks(size_t workerIndex) {
+    currentPool = this;
+    currentWorkerIndex = workerIndex;
+
+    while (true) {
+        if (auto task = _takeTask(workerIndex)) {
+            task(Status::OK());
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_idleMutex);
+        _numIdleWorkers.fetchAndAdd(1);
+        {
+            MONGO_IDLE_THREAD_BLOCK;
+            _workAvailable.wait(lk, [&] {
+                return _numPendingTasks.load() > 0 || (_scheduleState.load() & kShutdownMask);
+            });
+        }
+        _numIdleWorkers.fetchAndSubtract(1);
+
+        if (_numPendingTasks.load() == 0 && (_scheduleState.load() & kShutdownMask)) {
+            break;
+        }
+    }
+
+    currentPool = nullptr;
+}
+
+WorkStealingThreadPool::Task WorkStealingThreadPool::_takeTask(size_t workerIndex) {
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto& worker = *_workers[(workerIndex + i) % _workers.size()];
+        stdx::lock_guard<Latch> lk(worker.mutex);
+        if (worker.tasks.empty()) {
+            continue;
+        }
+
+        auto task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        _numPendingTasks.fetchAndSubtract(1);
+        if (i > 0) {
+            _numStolenTasks.fetchAndAdd(1);
+        }
+        return task;
+    }
+
+    return {};
+}
+
+void WorkStealingThreadPool::_drainPendingTasks() {
+    // Tasks cannot be run inline because they can create OperationContexts and the join() caller
+    // may already have one associated with the thread.
+    stdx::thread cleanThread = stdx::thread([&] {
+        const std::string threadName = str::stream() << _options.threadNamePrefix << "drain";
+        setThreadName(threadName);
+        _options.onCreateThread(threadName);
+        while (auto task = _takeTask(0)) {
+            task(Status::OK());
+        }
+    });
+    cleanThread.join();
+}
+
+void WorkStealingThreadPool::_setState_inlock(LifecycleState newState) {
+    if (newState == _state) {
+        return;
+    }
+    _state = newState;
+    _stateChange.notify_all();
+}
+
+}  // namespace mongo
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
+#include "mongo/util/hierarchical_acquisition.h"
+
+namespace mongo {
+
+/**
+ * A thread pool with a fixed number of threads, each of which owns a queue of tasks.
+ *
+ * Tasks scheduled by a worker of the pool are queued on that worker's own queue, so that a chain of
+ * continuations keeps running on the thread whose caches it warmed. Tasks scheduled from outside
+ * the pool are spread over the queues in turn. A worker whose queue is empty steals tasks from the
+ * queues of the others before going to sleep. Since every queue has its own mutex, workers only
+ * contend when stealing, where the ThreadPool serializes every schedule and every dequeue on a
+ * single mutex.
+ *
+ * Tasks run in the order they were queued on each queue, but there is no ordering between tasks
+ * queued on different workers.
+ */
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+public:
+    /**
+     * Structure used to configure an instance of WorkStealingThreadPool.
+     */
+    struct Options {
+        // Name of the thread pool. If this string is empty, the pool will be assigned a name
+        // unique to the current process.
+        std::string poolName;
+
+        // Prefix used to name threads for logging purposes. An integer will be appended to this
+        // string to create the thread name for each thread in the pool. If you leave this empty,
+        // the prefix will be the pool name followed by a hyphen.
+        std::string threadNamePrefix;
+
+        // Number of worker threads, all of which are started by startup().
+        size_t numThreads = 8;
+
+        // This function is run before each worker thread begins consuming tasks.
+        using OnCreateThreadFn = std::function<void(const std::string& threadName)>;
+        OnCreateThreadFn onCreateThread = [](const std::string&) {};
+    };
+
+    /**
+     * Structure used to return information about the thread pool via getStats().
+     */
+    struct Stats {
+        // The number of tasks waiting to be executed by the pool.
+        size_t numPendingTasks;
+
+        // The number of tasks which were run by another worker than the one they were queued on.
+        size_t numStolenTasks;
+    };
+
+    explicit WorkStealingThreadPool(Options options);
+
+    ~WorkStealingThreadPool() override;
+
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    void schedule(Task task) override;
+
+    Stats getStats() const;
+
+private:
+    struct Worker {
+        Mutex mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0),
+                                       "WorkStealingThreadPool::Worker::mutex");
+        std::deque<Task> tasks;
+    };
+
+    enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
+
+    /**
+     * The run loop of the worker thread owning _workers[workerIndex].
+     */
+    void _consumeTasks(size_t workerIndex);
+
+    /**
+     * Takes a task from the queue of the worker at 'workerIndex', or else steals one from the other
+     * queues. Returns an empty task if every queue is empty.
+     */
+    Task _takeTask(size_t workerIndex);
+
+    /**
+     * Runs every task left in the queues on a new thread, once no more tasks can be scheduled.
+     */
+    void _drainPendingTasks();
+
+    void _setState_inlock(LifecycleState newState);
+
+    const Options _options;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // Used as follows:
+    //   The low 31 bits are a count of the calls to schedule() in progress.
+    //   The high bit is a flag that is set once the pool is shutting down.
+    AtomicWord<unsigned> _scheduleState{0};
+    static constexpr unsigned kShutdownMask = 1u << 31;
+
+    AtomicWord<size_t> _nextWorker{0};
+    AtomicWord<size_t> _numPendingTasks{0};
+    AtomicWord<size_t> _numStolenTasks{0};
+
+    // Idle workers sleep on _workAvailable, which is signaled when tasks are queued while some
+    // workers sleep, and when the pool shuts down.
+    Mutex _idleMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "WorkStealingThreadPool::_idleMutex");
+    stdx::condition_variable _workAvailable;
+    AtomicWord<size_t> _numIdleWorkers{0};
+
+    // Guards the lifecycle state and the threads.
+    Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "WorkStealingThreadPool::_mutex");
+    stdx::condition_variable _stateChange;
+    LifecycleState _state = preStart;
+    std::vector<stdx::thread> _threads;
+};
+
+}  // namespace mongo
@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/unittest/death_test.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/thread_pool_test_common.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+namespace mongo {
+namespace {
+
+MONGO_INITIALIZER(WorkStealingThreadPoolCommonTests)(InitializerContext*) {
+    addTestsForThreadPool("WorkStealingThreadPoolCommon", [] {
+        return std::make_unique<WorkStealingThreadPool>(WorkStealingThreadPool::Options());
+    });
+    return Status::OK();
+}
+
+TEST(WorkStealingThreadPoolTest, IdleWorkersStealQueuedTasks) {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = 2;
+    WorkStealingThreadPool pool(options);
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+    bool blockerStarted = false;
+    bool releaseBlocker = false;
+    size_t numRun = 0;
+
+    // Before startup, scheduled tasks alternate between the two queues. The first one blocks its
+    // worker, so the task queued behind it can only run if the other worker steals it.
+    pool.schedule([&](auto status) {
+        ASSERT_OK(status);
+        stdx::unique_lock<Latch> lk(mutex);
+        blockerStarted = true;
+        cv.notify_all();
+        cv.wait(lk, [&] { return releaseBlocker; });
+    });
+    for (int i = 0; i < 3; ++i) {
+        pool.schedule([&](auto status) {
+            ASSERT_OK(status);
+            stdx::lock_guard<Latch> lk(mutex);
+            ++numRun;
+            cv.notify_all();
+        });
+    }
+    pool.startup();
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return blockerStarted && numRun == 3; });
+        releaseBlocker = true;
+        cv.notify_all();
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    auto stats = pool.getStats();
+    ASSERT_EQ(stats.numPendingTasks, 0U);
+    ASSERT_GTE(stats.numStolenTasks, 1U);
+}
+
+TEST(WorkStealingThreadPoolTest, TasksScheduledByAWorkerRunOnIt) {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = 4;
+    WorkStealingThreadPool pool(options);
+    pool.startup();
+
+    auto mutex = MONGO_MAKE_LATCH();
+    stdx::condition_variable cv;
+    bool done = false;
+    stdx::thread::id parentThread;
+    stdx::thread::id childThread;
+
+    // The child waits behind its parent on the parent's queue. Unless another worker steals it
+    // first, the parent's thread runs it once the parent returns.
+    pool.schedule([&](auto status) {
+        ASSERT_OK(status);
+        parentThread = stdx::this_thread::get_id();
+        pool.schedule([&](auto status) {
+            ASSERT_OK(status);
+            stdx::lock_guard<Latch> lk(mutex);
+            childThread = stdx::this_thread::get_id();
+            done = true;
+            cv.notify_all();
+        });
+    });
+
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        cv.wait(lk, [&] { return done; });
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    if (pool.getStats().numStolenTasks == 0) {
+        ASSERT_TRUE(parentThread == childThread);
+    }
+}
+
+DEATH_TEST(WorkStealingThreadPoolTest, NoThreadsDies, "Cannot create a work stealing pool") {
+    WorkStealingThreadPool::Options options;
+    options.numThreads = 0;
+    WorkStealingThreadPool pool(options);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,374 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/config.h"
+
+#if defined(__linux__) && defined(MONGO_CONFIG_USE_LIBUNWIND)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <sys/time.h>
+#include <unordered_map>
+
+#include "mongo/base/init.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/logv2/log.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/cpu_profiler_gen.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/stacktrace.h"
+
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+//
+// Sampling CPU profiler
+//
+// Samples the stacks of threads that are using CPU, so that CPU hotspots can be correlated with
+// the other FTDC metrics after the fact.
+//
+// An ITIMER_PROF interval timer raises SIGPROF every 1/cpuProfilingSampleHz seconds of process
+// CPU time, which the kernel delivers to a thread that is running. The signal handler takes a
+// raw backtrace with libunwind, which unlike glibc's backtrace is async-signal-safe, into a slot
+// of a pre-allocated sample buffer. It never allocates or takes locks; if no slot is free the
+// sample is counted as dropped.
+//
+// Samples are drained from the buffer, counted per unique stack, and symbolized each time the
+// cpuProfile serverStatus section is generated, which FTDC does once per expensive period.
+//
+// Enable at startup time (only) with
+//     mongod --setParameter cpuProfilingEnabled=true
+//
+// If enabled, adds a cpuProfile section to serverStatus as follows:
+//
+// cpuProfile: {
+//     stats: {
+//         // internal stats related to CPU profiling (samples, dropped samples, stacks, etc.)
+//     }
+//     stacks: {
+//         stack_n_: {         // one for each stack _n_
+//             samples: ...,   // cumulative number of samples taken in this stack
+//         }
+//     }
+// }
+//
+// As with the heap profiler, FTDC does not capture strings, so each new stack is logged once to
+// the mongod log, and FTDC records the sample count of each stack over time. The rate of change
+// of the count of stack_n_ is proportional to the CPU spent in it.
+//
+
+namespace mongo {
+namespace {
+
+using Hash = uint32_t;
+
+class CpuProfiler {
+private:
+    static const size_t kMaxFramesPerStack = 64;  // max depth of stack
+    static const size_t kMaxPendingSamples = 16 * 1024;
+    static const size_t kMaxStacks = 20000;  // max number of unique stacks we count
+
+    // Frames to skip at the top of a backtrace: the profiler's own and the signal trampoline.
+    static const size_t kSkipStartFrames = 3;
+
+    struct Stack {
+        size_t numFrames = 0;
+        std::array<void*, kMaxFramesPerStack> frames;
+
+        bool operator==(const Stack& that) const {
+            return numFrames == that.numFrames &&
+                std::equal(frames.begin(), frames.begin() + numFrames, that.frames.begin());
+        }
+    };
+
+    struct StackHash {
+        size_t operator()(const Stack& stack) const {
+            Hash hash;
+            MurmurHash3_x86_32(stack.frames.data(), stack.numFrames * sizeof(void*), 0, &hash);
+            return hash;
+        }
+    };
+
+    struct StackInfo {
+        int stackNum = 0;    // used for stack short name
+        size_t samples = 0;  // cumulative samples taken in this stack
+    };
+
+    // A slot of the sample buffer, written by the signal handler and read by the drain.
+    struct PendingSample {
+        enum State : int { kFree, kWriting, kReady };
+        std::atomic<int> state{kFree};  // NOLINT
+        Stack stack;
+    };
+
+    // Pre-allocated so the signal handler never allocates.
+    std::unique_ptr<PendingSample[]> pendingSamples{new PendingSample[kMaxPendingSamples]};
+    std::atomic_size_t nextPendingSample{0};  // NOLINT
+
+    std::atomic_size_t totalSamples{0};    // NOLINT
+    std::atomic_size_t droppedSamples{0};  // NOLINT
+
+    // Guards the stack table and the set of important stacks, used by the drain only.
+    stdx::mutex stacks_mutex;  // NOLINT
+    std::unordered_map<Stack, StackInfo, StackHash> stacks;
+    size_t overflowSamples = 0;  // samples of new stacks once kMaxStacks is reached
+
+    // As in the heap profiler, a stack that has ever accounted for a significant share of the
+    // samples remains important, and important stacks are emitted in stackNum order, so the set
+    // of fields in the section changes rarely and FTDC compresses it well.
+    std::set<StackInfo*, bool (*)(StackInfo*, StackInfo*)> importantStacks{
+        [](StackInfo* a, StackInfo* b) -> bool { return a->stackNum < b->stackNum; }};
+    const size_t kMaxImportantStacks = 100;
+
+    //
+    // Signal handler, must be async-signal-safe.
+    //
+    void _sample() {
+        totalSamples.fetch_add(1, std::memory_order_relaxed);
+
+        auto& slot = pendingSamples[nextPendingSample.fetch_add(1, std::memory_order_relaxed) %
+                                    kMaxPendingSamples];
+        int expected = PendingSample::kFree;
+        if (!slot.state.compare_exchange_strong(
+                expected, PendingSample::kWriting, std::memory_order_acquire)) {
+            droppedSamples.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        slot.stack.numFrames = rawBacktrace(slot.stack.frames.data(), kMaxFramesPerStack);
+        slot.state.store(PendingSample::kReady, std::memory_order_release);
+    }
+
+    //
+    // Move the pending samples into the stack table.
+    //
+    void _drain(WithLock) {
+        for (size_t i = 0; i < kMaxPendingSamples; ++i) {
+            auto& slot = pendingSamples[i];
+            if (slot.state.load(std::memory_order_acquire) != PendingSample::kReady)
+                continue;
+
+            auto it = stacks.find(slot.stack);
+            if (it == stacks.end()) {
+                if (stacks.size() < kMaxStacks) {
+                    it = stacks.emplace(slot.stack, StackInfo{int(stacks.size()), 0}).first;
+                    _logStack(it->first, it->second);
+                }
+            }
+            if (it != stacks.end()) {
+                ++it->second.samples;
+            } else {
+                ++overflowSamples;
+            }
+
+            slot.state.store(PendingSample::kFree, std::memory_order_release);
+        }
+    }
+
+    //
+    // Log the symbolized representation of a new stack.
+    //
+    void _logStack(const Stack& stack, const StackInfo& stackInfo) {
+        StackTraceAddressMetadataGenerator metaGen;
+        BSONArrayBuilder builder;
+        for (size_t j = std::min(stack.numFrames, kSkipStartFrames); j < stack.numFrames; ++j) {
+            void* addr = stack.frames[j];
+            std::string frameString;
+            const auto& meta = metaGen.load(addr);
+            if (meta.symbol()) {
+                if (StringData name = meta.symbol().name(); !name.empty()) {
+                    frameString = name.toString();
+                    int status = 0;
+                    if (char* dm =
+                            abi::__cxa_demangle(frameString.c_str(), nullptr, nullptr, &status)) {
+                        // We strip function parameters as they are very verbose and not useful.
+                        frameString = dm;
+                        free(dm);
+                        if (auto paren = frameString.find('('); paren != std::string::npos)
+                            frameString.erase(paren);
+                    }
+                }
+            }
+            if (frameString.empty()) {
+                std::ostringstream s;
+                s << addr;
+                frameString = s.str();
+            }
+            builder.append(frameString);
+        }
+        LOGV2(5155028,
+              "cpuProfile stack",
+              "stackNum"_attr = stackInfo.stackNum,
+              "stackObj"_attr = builder.arr());
+    }
+
+    //
+    // Generate serverStatus section.
+    //
+    void _generateServerStatusSection(BSONObjBuilder& builder) {
+        stdx::lock_guard<stdx::mutex> lk(stacks_mutex);
+        _drain(lk);
+
+        BSONObjBuilder statsBuilder(builder.subobjStart("stats"));
+        statsBuilder.appendNumber("sampleHz", CpuProfilingSampleHz);
+        statsBuilder.appendNumber("samples", totalSamples.load());
+        statsBuilder.appendNumber("droppedSamples", droppedSamples.load());
+        statsBuilder.appendNumber("overflowSamples", overflowSamples);
+        statsBuilder.appendNumber("numStacks", stacks.size());
+        statsBuilder.doneFast();
+
+        // Find the stacks accounting for 99% of the samples and deem them important, up to a
+        // limit that keeps the section small.
+        std::vector<StackInfo*> stackInfos;
+        size_t drainedSamples = 0;
+        for (auto& [stack, stackInfo] : stacks) {
+            stackInfos.push_back(&stackInfo);
+            drainedSamples += stackInfo.samples;
+        }
+        std::stable_sort(stackInfos.begin(), stackInfos.end(), [](StackInfo* a, StackInfo* b) {
+            return a->samples > b->samples;
+        });
+        size_t threshold = drainedSamples * 0.99;
+        size_t cumulative = 0;
+        for (auto stackInfo : stackInfos) {
+            if (cumulative > threshold || importantStacks.size() >= kMaxImportantStacks)
+                break;
+            importantStacks.insert(stackInfo);
+            cumulative += stackInfo->samples;
+        }
+
+        BSONObjBuilder stacksBuilder(builder.subobjStart("stacks"));
+        for (auto stackInfo : importantStacks) {
+            std::ostringstream shortName;
+            shortName << "stack" << stackInfo->stackNum;
+            BSONObjBuilder stackBuilder(stacksBuilder.subobjStart(shortName.str()));
+            stackBuilder.appendNumber("samples", stackInfo->samples);
+        }
+        stacksBuilder.doneFast();
+    }
+
+    static void handleSignal(int, siginfo_t*, void*) {
+        int savedErrno = errno;
+        cpuProfiler->_sample();
+        errno = savedErrno;
+    }
+
+public:
+    static CpuProfiler* cpuProfiler;
+
+    CpuProfiler() {
+        // Take a first backtrace outside of a signal handler, so that libunwind initializes
+        // itself here rather than in the handler.
+        std::array<void*, kMaxFramesPerStack> frames;
+        rawBacktrace(frames.data(), frames.size());
+    }
+
+    void start() {
+        struct sigaction sa = {};
+        sa.sa_sigaction = handleSignal;
+        sa.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+            LOGV2_WARNING(5155029,
+                          "Failed to install the CPU profiler signal handler",
+                          "error"_attr = errnoWithDescription());
+            return;
+        }
+
+        struct itimerval timer = {};
+        timer.it_interval.tv_usec = 1000 * 1000 / CpuProfilingSampleHz;
+        timer.it_value = timer.it_interval;
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            LOGV2_WARNING(5155030,
+                          "Failed to start the CPU profiler timer",
+                          "error"_attr = errnoWithDescription());
+            return;
+        }
+
+        LOGV2(5155031, "Started CPU profiling", "sampleHz"_attr = CpuProfilingSampleHz);
+    }
+
+    static void generateServerStatusSection(BSONObjBuilder& builder) {
+        if (cpuProfiler)
+            cpuProfiler->_generateServerStatusSection(builder);
+    }
+};
+
+//
+// serverStatus section
+//
+
+class CpuProfilerServerStatusSection final : public ServerStatusSection {
+public:
+    CpuProfilerServerStatusSection() : ServerStatusSection("cpuProfile") {}
+
+    bool includeByDefault() const override {
+        return CpuProfilingEnabled;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        CpuProfiler::generateServerStatusSection(builder);
+        return builder.obj();
+    }
+} cpuProfilerServerStatusSection;
+
+//
+// startup
+//
+
+CpuProfiler* CpuProfiler::cpuProfiler;
+
+MONGO_INITIALIZER_GENERAL(StartCpuProfiling, ("EndStartupOptionHandling"), ("default"))
+(InitializerContext* context) {
+    if (CpuProfilingEnabled) {
+        CpuProfiler::cpuProfiler = new CpuProfiler();
+        CpuProfiler::cpuProfiler->start();
+    }
+    return Status::OK();
+}
+
+}  // namespace
+}  // namespace mongo
+
+#endif  // defined(__linux__) && defined(MONGO_CONFIG_USE_LIBUNWIND)
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
 #include <benchmark/benchmark.h>
 
 #include "mongo/util/future.h"
@@ -199,6 +200,31 @@ void BM_futureInt4xDeferredThenChained(benchmark::State& state) {
 }
 
 
+// The captured state is too large to be stored inline in the SharedState, so this measures the
+// cost of a continuation whose callback must be heap-allocated.
+void BM_futureIntDeferredThenLargeCapture(benchmark::State& state) {
+    std::array<int64_t, 16> captured{};
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto pf = makePromiseFuture<int>();
+        auto fut = std::move(pf.future).then([captured](int i) { return i + int(captured[0]); });
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(std::move(fut).get());
+    }
+}
+
+void BM_futureIntDeferredGetAsync(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        int result = 0;
+        auto pf = makePromiseFuture<int>();
+        std::move(pf.future).getAsync([&](StatusWith<int> swi) { result = swi.getValue(); });
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+
 BENCHMARK(BM_plainIntReady);
 BENCHMARK(BM_futureIntReady);
 BENCHMARK(BM_futureIntReadyThen);
@@ -207,6 +233,8 @@ BENCHMARK(BM_futureIntReadyWithPromiseThen);
 BENCHMARK(BM_futureIntDeferredThen);
 BENCHMARK(BM_futureIntDeferredThenImmediate);
 BENCHMARK(BM_futureIntDeferredThenReady);
+BENCHMARK(BM_futureIntDeferredThenLargeCapture);
+BENCHMARK(BM_futureIntDeferredGetAsync);
 BENCHMARK(BM_futureIntDoubleDeferredThen);
 BENCHMARK(BM_futureInt3xDeferredThenNested);
 BENCHMARK(BM_futureInt3xDeferredThenChained);
@@ -31,7 +31,9 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
+#include <cstddef>
 #include <forward_list>
+#include <new>
 #include <type_traits>
 
 #include "mongo/base/checked_cast.h"
@@ -359,6 +361,70 @@ enum class SSBState : uint8_t {
     kFinished,
 };
 
+class SharedStateBase;
+
+/**
+ * The callback a Future registers on its SharedState to be run when the Promise is completed.
+ *
+ * This is a type-erased holder like unique_function, except that callables that fit in
+ * kInlineSize bytes are stored inside the SharedState itself. Almost every continuation captures
+ * just the user's functor, so this saves a heap allocation on each deferred hop of a chain. The
+ * callable is never moved once stored, so any callable type can be held inline.
+ */
+class SharedStateCallback {
+public:
+    static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+    SharedStateCallback() = default;
+    SharedStateCallback(const SharedStateCallback&) = delete;
+    SharedStateCallback& operator=(const SharedStateCallback&) = delete;
+
+    ~SharedStateCallback() {
+        reset();
+    }
+
+    template <typename Func>
+    SharedStateCallback& operator=(Func&& func) {
+        using F = std::decay_t<Func>;
+        static_assert(std::is_invocable_v<F&, SharedStateBase*>);
+
+        reset();
+        if constexpr (sizeof(F) <= kInlineSize && alignof(F) <= alignof(Storage)) {
+            _target = new (&_storage) F(std::forward<Func>(func));
+            _destroy = [](void* target) { static_cast<F*>(target)->~F(); };
+        } else {
+            _target = new F(std::forward<Func>(func));
+            _destroy = [](void* target) { delete static_cast<F*>(target); };
+        }
+        _invoke = [](void* target, SharedStateBase* ssb) { (*static_cast<F*>(target))(ssb); };
+        return *this;
+    }
+
+    void operator()(SharedStateBase* ssb) const {
+        invariant(_target);
+        _invoke(_target, ssb);
+    }
+
+    explicit operator bool() const noexcept {
+        return _target;
+    }
+
+private:
+    using Storage = std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)>;
+
+    void reset() noexcept {
+        if (_target) {
+            _destroy(_target);
+            _target = nullptr;
+        }
+    }
+
+    void* _target = nullptr;
+    void (*_invoke)(void*, SharedStateBase*) = nullptr;
+    void (*_destroy)(void*) = nullptr;
+    Storage _storage;
+};
+
 class SharedStateBase : public RefCountable {
 public:
     using Children = std::forward_list<boost::intrusive_ptr<SharedStateBase>>;
@@ -493,7 +559,7 @@ public:
     boost::intrusive_ptr<SharedStateBase> continuation;  // F
 
     // Takes this as argument and usually writes to continuation.
-    unique_function<void(SharedStateBase* input)> callback;  // F
+    SharedStateCallback callback;  // F
 
     // These are only used to signal completion to blocking waiters. Benchmarks showed that it was
     // worth deferring the construction of cv, so it can be avoided when it isn't necessary.
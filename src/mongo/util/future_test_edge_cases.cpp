@@ -31,6 +31,8 @@
 
 #include "mongo/util/future.h"
 
+#include <array>
+
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
@@ -342,6 +344,25 @@ TEST(Future_EdgeCases, SharedPromise_CompleteWithUnreadyFuture) {
     sf.get();
 }
 
+TEST(Future_EdgeCases, Deferred_then_callbacks_inline_and_out_of_line) {
+    // Continuations small enough to be stored inside the SharedState and ones that must be
+    // heap-allocated should both run and release their captures.
+    auto token = std::make_shared<int>(1);
+    std::array<char, 2 * future_details::SharedStateCallback::kInlineSize> padding{};
+
+    {
+        auto [promise, future] = makePromiseFuture<int>();
+        auto fut = std::move(future)
+                       .then([token](int i) { return i + *token; })
+                       .then([token, padding](int i) { return i + *token + padding[0]; });
+        ASSERT_GT(token.use_count(), 1);
+
+        promise.emplaceValue(1);
+        ASSERT_EQ(std::move(fut).get(), 3);
+    }
+    ASSERT_EQ(token.use_count(), 1);
+}
+
 // Make sure we actually die if someone throws from the getAsync callback.
 //
 // With gcc 5.8 we terminate, but print "terminate() called. No exception is active". This works in
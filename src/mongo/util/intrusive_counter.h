@@ -70,7 +70,12 @@ public:
     };
 
     friend void intrusive_ptr_release(const RefCountable* ptr) {
-        if (ptr->_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // If this is the only reference, no other thread can be accessing the object or its count,
+        // so the atomic read-modify-write can be skipped. Most documents and values built by a
+        // pipeline are never shared, so this avoids the cost of a locked instruction when they are
+        // destroyed. The acquire load orders the delete after any releases by other threads.
+        if (ptr->_count.load(std::memory_order_acquire) == 1 ||
+            ptr->_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
             delete ptr;
         }
     };
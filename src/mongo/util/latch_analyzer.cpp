@@ -33,8 +33,10 @@
 
 #include "mongo/util/latch_analyzer.h"
 
+#include <algorithm>
 #include <boost/iterator/transform_iterator.hpp>
 #include <deque>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -47,6 +49,8 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/latch_analyzer.h"
+#include "mongo/util/latch_analyzer_gen.h"
+#include "mongo/util/string_map.h"
 #include "mongo/util/testing_proctor.h"
 
 namespace mongo {
@@ -54,6 +58,7 @@ namespace mongo {
 namespace {
 
 auto kLatchAnalysisName = "latchAnalysis"_sd;
+auto kLatchContentionName = "latchContention"_sd;
 auto kLatchViolationKey = "hierarchicalAcquisitionLevelViolations"_sd;
 
 // LatchAnalyzer Decoration getter
@@ -121,6 +126,25 @@ public:
     };
 } gLatchAnalysisSection;
 
+// Define a new serverStatus section "latchContention"
+class LatchContentionSection final : public ServerStatusSection {
+public:
+    LatchContentionSection() : ServerStatusSection(kLatchContentionName.toString()) {}
+
+    bool includeByDefault() const override {
+        return latch_detail::getContentionProfilingSettings().enabled.load();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement&) const override {
+        BSONObjBuilder contention;
+        LatchAnalyzer::get(opCtx->getClient()).appendContentionToBSON(contention);
+        return contention.obj();
+    };
+} gLatchContentionSection;
+
+// The most latch names the latchContention section reports, to bound its size.
+constexpr size_t kMaxContentionLatches = 100;
+
 // Latching state object to pin onto the Client (i.e. thread)
 struct LatchSetState {
     using LatchIdentitySet = std::deque<const latch_detail::Identity*>;
@@ -386,6 +410,74 @@ void LatchAnalyzer::appendToBSON(mongo::BSONObjBuilder& result) const {
     }
 }
 
+void LatchAnalyzer::appendContentionToBSON(mongo::BSONObjBuilder& result) const {
+    struct Totals {
+        long long acquired = 0;
+        long long contended = 0;
+        long long timedWaits = 0;
+        long long waitNanos = 0;
+        long long maxWaitNanos = 0;
+        long long timedHolds = 0;
+        long long holdNanos = 0;
+        long long maxHoldNanos = 0;
+    };
+
+    // Latches made at different call sites may share a name, so sum them into one entry.
+    StringMap<Totals> totalsByName;
+    for (auto iter = latch_detail::Catalog::get().iter(); iter.more();) {
+        auto data = iter.next();
+        if (!data) {
+            continue;
+        }
+
+        auto& counts = data->counts();
+        const auto timedWaits = counts.timedWaits.loadRelaxed();
+        const auto timedHolds = counts.timedHolds.loadRelaxed();
+        if (!timedWaits && !timedHolds) {
+            continue;
+        }
+
+        auto& totals = totalsByName[data->identity().name()];
+        totals.acquired += counts.acquired.loadRelaxed();
+        totals.contended += counts.contended.loadRelaxed();
+        totals.timedWaits += timedWaits;
+        totals.waitNanos += counts.waitNanos.loadRelaxed();
+        totals.maxWaitNanos = std::max(totals.maxWaitNanos, counts.maxWaitNanos.loadRelaxed());
+        totals.timedHolds += timedHolds;
+        totals.holdNanos += counts.holdNanos.loadRelaxed();
+        totals.maxHoldNanos = std::max(totals.maxHoldNanos, counts.maxHoldNanos.loadRelaxed());
+    }
+
+    std::vector<StringMap<Totals>::const_iterator> byWaitTime;
+    for (auto it = totalsByName.cbegin(); it != totalsByName.cend(); ++it) {
+        byWaitTime.push_back(it);
+    }
+    std::sort(byWaitTime.begin(), byWaitTime.end(), [](const auto& a, const auto& b) {
+        return a->second.waitNanos > b->second.waitNanos;
+    });
+    if (byWaitTime.size() > kMaxContentionLatches) {
+        byWaitTime.resize(kMaxContentionLatches);
+    }
+
+    auto& settings = latch_detail::getContentionProfilingSettings();
+    result.append("enabled", settings.enabled.load());
+    result.append("holdSampleInterval", settings.holdSampleInterval.load());
+
+    BSONObjBuilder latchesObj = result.subobjStart("latches");
+    for (auto& it : byWaitTime) {
+        auto& totals = it->second;
+        BSONObjBuilder latchObj = latchesObj.subobjStart(it->first);
+        latchObj.append("acquired", totals.acquired);
+        latchObj.append("contended", totals.contended);
+        latchObj.append("timedWaits", totals.timedWaits);
+        latchObj.append("totalWaitMicros", totals.waitNanos / 1000);
+        latchObj.append("maxWaitMicros", totals.maxWaitNanos / 1000);
+        latchObj.append("sampledHolds", totals.timedHolds);
+        latchObj.append("totalSampledHoldMicros", totals.holdNanos / 1000);
+        latchObj.append("maxHoldMicros", totals.maxHoldNanos / 1000);
+    }
+}
+
 void LatchAnalyzer::dump() {
     if (!shouldAnalyzeLatches()) {
         return;
@@ -68,6 +68,10 @@ public:
     // Append the current statistics in a form appropriate for server status to a BOB
     void appendToBSON(mongo::BSONObjBuilder& result) const;
 
+    // Append the wait and hold times recorded by latch contention profiling, per latch name and
+    // longest total wait first, to a BOB
+    void appendContentionToBSON(mongo::BSONObjBuilder& result) const;
+
     // Log the current statistics in JSON form to INFO
     void dump();
 
@@ -33,7 +33,11 @@
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/hierarchical_acquisition.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/barrier.h"
 #include "mongo/util/latch_analyzer.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
@@ -103,5 +107,38 @@ TEST_F(LatchAnalyzerTest, RemoveValidWasPresent) {
     higherLevel.unlock();
 }
 
+TEST_F(LatchAnalyzerTest, ContentionProfilingTimesWaitsAndHolds) {
+    auto& settings = latch_detail::getContentionProfilingSettings();
+    settings.enabled.store(true);
+    settings.holdSampleInterval.store(1);
+    ON_BLOCK_EXIT([&] {
+        settings.enabled.store(false);
+        settings.holdSampleInterval.store(100);
+    });
+
+    Mutex mutex = MONGO_MAKE_LATCH("ContentionProfilingTimesWaitsAndHolds::mutex");
+
+    unittest::Barrier barrier(2);
+    stdx::thread holder([&] {
+        stdx::lock_guard<Latch> lk(mutex);
+        barrier.countDownAndWait();
+        sleepmillis(50);
+    });
+
+    barrier.countDownAndWait();
+    { stdx::lock_guard<Latch> lk(mutex); }
+    holder.join();
+
+    BSONObjBuilder builder;
+    LatchAnalyzer::get(getClient()).appendContentionToBSON(builder);
+    auto latch =
+        builder.obj()["latches"]["ContentionProfilingTimesWaitsAndHolds::mutex"].Obj();
+    ASSERT_EQ(latch["acquired"].numberLong(), 2);
+    ASSERT_EQ(latch["timedWaits"].numberLong(), 1);
+    ASSERT_GT(latch["totalWaitMicros"].numberLong(), 0);
+    ASSERT_EQ(latch["sampledHolds"].numberLong(), 2);
+    ASSERT_GT(latch["maxHoldMicros"].numberLong(), 0);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/latency_histogram.h"
+
+#include <cmath>
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+namespace {
+
+struct Registry {
+    Mutex mutex = MONGO_MAKE_LATCH("LatencyHistogram::Registry::mutex");
+    std::map<std::string, const LatencyHistogram*> histograms;
+};
+
+Registry& getRegistry() {
+    static auto& registry = *new Registry;
+    return registry;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram(std::string name) : _name(std::move(name)) {
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    invariant(registry.histograms.emplace(_name, this).second);
+}
+
+LatencyHistogram::~LatencyHistogram() {
+    if (_name.empty()) {
+        return;
+    }
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    registry.histograms.erase(_name);
+}
+
+int LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(kSubBuckets)) {
+        return micros;
+    }
+
+    const int exponent = 63 - countLeadingZeros64(micros);
+    if (exponent >= kMaxExponent) {
+        return kNumBuckets - 1;
+    }
+
+    // The bits below the leading one select the linear bucket within this power of two.
+    const int subBucket = (micros >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + subBucket;
+}
+
+uint64_t LatencyHistogram::lowerBound(int bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    const int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    const uint64_t subBucket = bucket % kSubBuckets;
+    return (kSubBuckets + subBucket) << (exponent - kSubBucketBits);
+}
+
+void LatencyHistogram::append(BSONObjBuilder* builder) const {
+    std::array<long long, kNumBuckets> counts;
+    long long count = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        counts[i] = _buckets[i].loadRelaxed();
+        count += counts[i];
+    }
+
+    builder->append("count", count);
+    builder->append("totalMicros", _totalMicros.loadRelaxed());
+
+    const std::array<std::pair<StringData, double>, 4> percentiles{{{"p50Micros"_sd, 0.5},
+                                                                     {"p90Micros"_sd, 0.9},
+                                                                     {"p99Micros"_sd, 0.99},
+                                                                     {"p999Micros"_sd, 0.999}}};
+    int bucket = 0;
+    long long cumulative = 0;
+    for (const auto& [field, quantile] : percentiles) {
+        const auto rank = static_cast<long long>(std::ceil(quantile * count));
+        while (bucket < kNumBuckets - 1 && cumulative + counts[bucket] < rank) {
+            cumulative += counts[bucket++];
+        }
+        const uint64_t upperBound =
+            bucket < kNumBuckets - 1 ? lowerBound(bucket + 1) - 1 : lowerBound(bucket);
+        builder->append(field, count ? static_cast<long long>(upperBound) : 0LL);
+    }
+}
+
+void LatencyHistogram::appendAll(BSONObjBuilder* builder) {
+    auto& registry = getRegistry();
+    stdx::lock_guard<Latch> lk(registry.mutex);
+    for (const auto& [name, histogram] : registry.histograms) {
+        BSONObjBuilder sub(builder->subobjStart(name));
+        histogram->append(&sub);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A histogram of latencies in microseconds with log-linear buckets in the style of HDR
+ * histograms: every power of two is split into kSubBuckets linear buckets, so reported
+ * percentiles are within 1/kSubBuckets of the recorded values across the whole range, instead of
+ * within a factor of two.
+ *
+ * Recording is a relaxed atomic increment of one bucket and of the latency total, so it is safe
+ * and cheap to call concurrently from any number of threads.
+ *
+ * Histograms constructed with a name register themselves for reporting through appendAll(), which
+ * the 'latencyHistograms' serverStatus section uses and so FTDC collects as well. Such histograms
+ * are meant to be defined at namespace scope.
+ */
+class LatencyHistogram {
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    // Latencies of 2^kMaxExponent microseconds (about 13 days) and more share the last bucket.
+    static constexpr int kMaxExponent = 40;
+    static constexpr int kNumBuckets = kSubBuckets * (kMaxExponent - kSubBucketBits + 1);
+
+    LatencyHistogram() = default;
+    explicit LatencyHistogram(std::string name);
+    ~LatencyHistogram();
+
+    void record(Microseconds latency) {
+        const auto micros = std::max<long long>(durationCount<Microseconds>(latency), 0);
+        _buckets[bucketFor(micros)].fetchAndAddRelaxed(1);
+        _totalMicros.fetchAndAddRelaxed(micros);
+    }
+
+    /**
+     * Returns the bucket that counts a latency of 'micros'.
+     */
+    static int bucketFor(uint64_t micros);
+
+    /**
+     * Returns the smallest latency counted by 'bucket'.
+     */
+    static uint64_t lowerBound(int bucket);
+
+    /**
+     * Appends the number of recorded latencies, their total, and estimates of the 50th, 90th,
+     * 99th and 99.9th percentiles, each reported as the upper bound of the bucket it falls in.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    /**
+     * Appends a subobject for every named histogram.
+     */
+    static void appendAll(BSONObjBuilder* builder);
+
+private:
+    const std::string _name;
+    std::array<AtomicWord<long long>, kNumBuckets> _buckets{};
+    AtomicWord<long long> _totalMicros{0};
+};
+
+}  // namespace mongo
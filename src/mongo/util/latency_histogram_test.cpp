@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/latency_histogram.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(LatencyHistogramTest, SmallLatenciesHaveTheirOwnBuckets) {
+    for (uint64_t micros = 0; micros < 16; ++micros) {
+        ASSERT_EQ(LatencyHistogram::bucketFor(micros), static_cast<int>(micros));
+        ASSERT_EQ(LatencyHistogram::lowerBound(micros), micros);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsAreContiguousAndIncreasing) {
+    for (int bucket = 0; bucket < LatencyHistogram::kNumBuckets; ++bucket) {
+        const auto lower = LatencyHistogram::lowerBound(bucket);
+        ASSERT_EQ(LatencyHistogram::bucketFor(lower), bucket);
+        if (bucket > 0) {
+            ASSERT_EQ(LatencyHistogram::bucketFor(lower - 1), bucket - 1);
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, BucketWidthIsBoundedByTheSubBucketCount) {
+    for (int bucket = LatencyHistogram::kSubBuckets; bucket < LatencyHistogram::kNumBuckets - 1;
+         ++bucket) {
+        const auto lower = LatencyHistogram::lowerBound(bucket);
+        const auto width = LatencyHistogram::lowerBound(bucket + 1) - lower;
+        ASSERT_LTE(width * LatencyHistogram::kSubBuckets, lower);
+    }
+}
+
+TEST(LatencyHistogramTest, HugeLatenciesShareTheLastBucket) {
+    ASSERT_EQ(LatencyHistogram::bucketFor(1ULL << LatencyHistogram::kMaxExponent),
+              LatencyHistogram::kNumBuckets - 1);
+    ASSERT_EQ(LatencyHistogram::bucketFor(std::numeric_limits<uint64_t>::max()),
+              LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, AppendReportsCountTotalAndPercentiles) {
+    LatencyHistogram histogram;
+    for (int micros = 1; micros <= 100; ++micros) {
+        histogram.record(Microseconds(micros));
+    }
+    histogram.record(Microseconds(-5));
+
+    BSONObjBuilder builder;
+    histogram.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("count" << 101LL << "totalMicros" << 5050LL << "p50Micros" << 51LL
+                                   << "p90Micros" << 95LL << "p99Micros" << 103LL
+                                   << "p999Micros" << 103LL));
+}
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZeroes) {
+    LatencyHistogram histogram;
+    BSONObjBuilder builder;
+    histogram.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("count" << 0LL << "totalMicros" << 0LL << "p50Micros" << 0LL
+                                   << "p90Micros" << 0LL << "p99Micros" << 0LL << "p999Micros"
+                                   << 0LL));
+}
+
+TEST(LatencyHistogramTest, NamedHistogramsAreReportedUntilDestroyed) {
+    {
+        LatencyHistogram histogram("latencyHistogramTest");
+        histogram.record(Microseconds(10));
+
+        BSONObjBuilder builder;
+        LatencyHistogram::appendAll(&builder);
+        const auto obj = builder.obj();
+        ASSERT_EQ(obj["latencyHistogramTest"]["count"].numberLong(), 1);
+    }
+
+    BSONObjBuilder builder;
+    LatencyHistogram::appendAll(&builder);
+    ASSERT_FALSE(builder.obj().hasField("latencyHistogramTest"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -281,6 +281,7 @@ std::pair<std::string, RFC4514Parser::ValueTerminator> RFC4514Parser::extractVal
 }
 
 const auto getTLSVersionCounts = ServiceContext::declareDecoration<TLSVersionCounts>();
+const auto getTLSSessionCounts = ServiceContext::declareDecoration<TLSSessionCounts>();
 
 
 void canonicalizeClusterDN(std::vector<std::string>* dn) {
@@ -548,6 +549,10 @@ TLSVersionCounts& TLSVersionCounts::get(ServiceContext* serviceContext) {
     return getTLSVersionCounts(serviceContext);
 }
 
+TLSSessionCounts& TLSSessionCounts::get(ServiceContext* serviceContext) {
+    return getTLSSessionCounts(serviceContext);
+}
+
 MONGO_INITIALIZER_WITH_PREREQUISITES(SSLManagerLogger, ("SSLManager", "GlobalLogManager"))
 (InitializerContext*) {
     if (!isSSLServer || (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled)) {
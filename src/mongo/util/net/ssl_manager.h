@@ -177,6 +177,19 @@ struct TLSVersionCounts {
     static TLSVersionCounts& get(ServiceContext* serviceContext);
 };
 
+/**
+ * Counts of the work done by TLS connections: the handshakes completed, in either direction, with
+ * the time they took and how many resumed an earlier session, and the bytes encrypted for sending.
+ */
+struct TLSSessionCounts {
+    AtomicWord<long long> handshakes;
+    AtomicWord<long long> handshakeMicros;
+    AtomicWord<long long> resumedHandshakes;
+    AtomicWord<long long> bytesEncrypted;
+
+    static TLSSessionCounts& get(ServiceContext* serviceContext);
+};
+
 class SSLManagerInterface : public Decorable<SSLManagerInterface> {
 public:
     static std::unique_ptr<SSLManagerInterface> create(const SSLParams& params, bool isServer);
@@ -270,6 +283,14 @@ public:
                                                                 const HostAndPort& hostForLogging,
                                                                 const ExecutorPtr& reactor) = 0;
 
+    /**
+     * Prepares an outgoing connection to 'target' for its handshake, before it starts. The OpenSSL
+     * implementation offers the TLS session saved from an earlier connection to the same target,
+     * so that the handshake can resume it instead of repeating the key exchange and the
+     * certificate validation. No-op function for SChannel and SecureTransport.
+     */
+    virtual void prepareEgressHandshake(SSLConnectionType ssl, const HostAndPort& target) {}
+
     /**
      * No-op function for SChannel and SecureTransport. Attaches stapled OCSP response to the
      * SSL_CTX obect.
@@ -50,6 +50,7 @@
 #include "mongo/config.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/debug_util.h"
@@ -66,6 +67,7 @@
 #include "mongo/util/periodic_runner.h"
 #include "mongo/util/read_through_cache.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
 #include "mongo/util/strong_weak_finish_line.h"
 #include "mongo/util/text.h"
@@ -1000,6 +1002,86 @@ ServiceContext::ConstructorActionRegisterer OCSPCacheRegisterer("CreateOCSPCache
 
 using OCSPCacheVal = OCSPCache::ValueHandle;
 
+using UniqueSSLSession =
+    std::unique_ptr<SSL_SESSION, OpenSSLDeleter<decltype(::SSL_SESSION_free), ::SSL_SESSION_free>>;
+
+/**
+ * The TLS sessions of outgoing connections, by target, for later connections to the same target to
+ * resume. OpenSSL hands each session over as it is established (with TLS 1.3, as the server sends
+ * its session tickets after the handshake) to the new session callback of the client context, which
+ * finds the target in the connection's ex data set by prepareEgressHandshake().
+ */
+class EgressSessionCache {
+public:
+    static EgressSessionCache& get() {
+        static StaticImmortal<EgressSessionCache> cache;
+        return *cache;
+    }
+
+    /**
+     * Sets up 'context' to hand its sessions to the cache. The sessions of the contexts set up
+     * before are dropped, they may have been established with other certificates.
+     */
+    void initContext(SSL_CTX* context) {
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, &EgressSessionCache::_onNewSession);
+
+        stdx::lock_guard lk(_mutex);
+        _sessions.clear();
+    }
+
+    void prepare(SSL* ssl, const HostAndPort& target) {
+        if (tlsEgressSessionCacheSize <= 0) {
+            return;
+        }
+
+        auto key = std::make_unique<std::string>(target.toString());
+        {
+            stdx::lock_guard lk(_mutex);
+            auto it = _sessions.find(*key);
+            if (it != _sessions.end()) {
+                // The connection takes its own reference to the session
+                ::SSL_set_session(ssl, it->second.get());
+            }
+        }
+        if (::SSL_set_ex_data(ssl, _keyIndex(), key.get())) {
+            key.release();
+        }
+    }
+
+private:
+    static int _keyIndex() {
+        static const int index = ::SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, &_freeKey);
+        return index;
+    }
+
+    static void _freeKey(
+        void* parent, void* ptr, CRYPTO_EX_DATA* ad, int idx, long argl, void* argp) {
+        delete static_cast<std::string*>(ptr);
+    }
+
+    static int _onNewSession(SSL* ssl, SSL_SESSION* session) {
+        auto key = static_cast<std::string*>(::SSL_get_ex_data(ssl, _keyIndex()));
+        if (!key) {
+            return 0;
+        }
+
+        auto& cache = get();
+        stdx::lock_guard lk(cache._mutex);
+        if (cache._sessions.size() >= static_cast<size_t>(tlsEgressSessionCacheSize)) {
+            cache._sessions.clear();
+        }
+
+        // Returning 1 keeps the reference to the session OpenSSL passed us
+        cache._sessions[*key] = UniqueSSLSession(session);
+        return 1;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("EgressSessionCache::_mutex");
+    stdx::unordered_map<std::string, UniqueSSLSession> _sessions;
+};
+
 class SSLManagerOpenSSL : public SSLManagerInterface {
 public:
     explicit SSLManagerOpenSSL(const SSLParams& params, bool isServer);
@@ -1026,6 +1108,10 @@ public:
                                                         const HostAndPort& hostForLogging,
                                                         const ExecutorPtr& reactor) final;
 
+    void prepareEgressHandshake(SSL* ssl, const HostAndPort& target) final {
+        EgressSessionCache::get().prepare(ssl, target);
+    }
+
     /**
      * Sets the OCSP Response to be stapled to the TLS Connection. Sets the _ocspStaplingAnchor
      * object in the class.
@@ -1899,6 +1985,10 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+    if (direction == ConnectionDirection::kOutgoing) {
+        EgressSessionCache::get().initContext(context);
+    }
+
     if (direction == ConnectionDirection::kOutgoing && params.tlsWithholdClientCertificate) {
         // Do not send a client certificate if they have been suppressed.
 
@@ -2415,6 +2505,9 @@ Future<SSLPeerInfo> SSLManagerOpenSSL::parseAndValidatePeerCertificate(
     }
 
     recordTLSVersion(tlsVersionStatus.getValue(), hostForLogging);
+    if (::SSL_session_reused(conn)) {
+        TLSSessionCounts::get(getGlobalServiceContext()).resumedHandshakes.addAndFetch(1);
+    }
 
     if (!_sslConfiguration.hasCA && isSSLServer)
         return SSLPeerInfo(sni);
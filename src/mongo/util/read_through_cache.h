@@ -33,6 +33,7 @@
 
 #include "mongo/bson/oid.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/thread_pool_interface.h"
 #include "mongo/util/functional.h"
@@ -170,13 +171,23 @@ public:
             return _valueHandle->updateWallClockTime;
         }
 
+        /**
+         * Returns true if this is the previous value of a key, which was served while a refresh of
+         * the key is still in progress. See 'setStaleWhileRevalidateBound' below.
+         */
+        bool isStale() const {
+            return _isStale;
+        }
+
     private:
         friend class ReadThroughCache;
 
-        ValueHandle(typename Cache::ValueHandle&& valueHandle)
-            : _valueHandle(std::move(valueHandle)) {}
+        ValueHandle(typename Cache::ValueHandle&& valueHandle, bool isStale = false)
+            : _valueHandle(std::move(valueHandle)), _isStale(isStale) {}
 
         typename Cache::ValueHandle _valueHandle;
+
+        bool _isStale{false};
     };
 
     /**
@@ -242,6 +253,21 @@ public:
         if (auto cachedValue = _cache.get(key, causalConsistency))
             return {std::move(cachedValue)};
 
+        // Serve the previous value of an invalidated key while a single lookup refreshes it
+        if (auto staleValue = _getStaleValue(ul, key)) {
+            if (!_inProgressLookups.count(key)) {
+                _inProgressLookups.emplace(
+                    key,
+                    std::make_unique<InProgressLookup>(*this, key, _cache.getTimeInStore(key)));
+                ul.unlock();
+
+                _doLookupWhileNotValid(key, Status(ErrorCodes::Error(461540), ""))
+                    .getAsync([](auto) {});
+            }
+
+            return {std::move(*staleValue)};
+        }
+
         // Join an in-progress lookup if one has already been scheduled
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             return it->second->addWaiter(ul);
@@ -280,6 +306,7 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _staleValues.erase(key);
         return _cache.insertOrAssignAndGet(key, {std::move(newValue), updateWallClockTime});
     }
 
@@ -296,6 +323,8 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->advanceTimeInStore(lg, newTime);
+        _pruneStaleValues(lg);
+        _stashStaleValue(lg, key);
         _cache.advanceTimeInStore(key, newTime);
     }
 
@@ -313,6 +342,8 @@ public:
         stdx::lock_guard lg(_mutex);
         if (auto it = _inProgressLookups.find(key); it != _inProgressLookups.end())
             it->second->invalidateAndCancelCurrentLookupRound(lg);
+        _pruneStaleValues(lg);
+        _stashStaleValue(lg, key);
         _cache.invalidate(key);
     }
 
@@ -323,6 +354,13 @@ public:
             if (predicate(entry.first))
                 entry.second->invalidateAndCancelCurrentLookupRound(lg);
         }
+        _pruneStaleValues(lg);
+        if (_maxStalenessMillis.load() > 0) {
+            for (const auto& cachedItem : _cache.getCacheInfo()) {
+                if (predicate(cachedItem.key))
+                    _stashStaleValue(lg, cachedItem.key);
+            }
+        }
         _cache.invalidateIf([&](const Key& key, const StoredValue*) { return predicate(key); });
     }
 
@@ -337,6 +375,27 @@ public:
         return _cache.getCacheInfo();
     }
 
+    /**
+     * Enables stale-while-revalidate mode if 'maxStaleness' is positive (it is disabled by
+     * default). In this mode, after a cached key is invalidated or its time in store is advanced,
+     * 'acquireAsync' keeps returning the previous value (with ValueHandle::isStale() set) for up to
+     * 'maxStaleness', while a single lookup refreshes the key in the background. Past that bound,
+     * callers wait for the lookup as usual.
+     *
+     * This relaxes the "barrier" guarantee of the invalidate methods, so it must only be enabled for
+     * caches whose users can tolerate acting on a bounded-staleness value.
+     */
+    void setStaleWhileRevalidateBound(Milliseconds maxStaleness) {
+        _maxStalenessMillis.store(durationCount<Milliseconds>(maxStaleness));
+    }
+
+    /**
+     * Returns the number of times a stale value was returned instead of waiting for a lookup.
+     */
+    long long getStaleServesCount() const {
+        return _numStaleServes.load();
+    }
+
 protected:
     /**
      * ReadThroughCache constructor, to be called by sub-classes, which implement 'lookup'.
@@ -372,6 +431,73 @@ protected:
 private:
     using InProgressLookupsMap = stdx::unordered_map<Key, std::unique_ptr<InProgressLookup>>;
 
+    /**
+     * The previous value of a key, which may be returned while the key is being refreshed in
+     * stale-while-revalidate mode.
+     */
+    struct StaleValue {
+        typename Cache::ValueHandle valueHandle;
+
+        // When the value was invalidated, used to bound how long it can still be returned
+        Date_t staleSince;
+    };
+    using StaleValuesMap = stdx::unordered_map<Key, StaleValue>;
+
+    /**
+     * If stale-while-revalidate is enabled and 'key' is currently cached, remembers its value so
+     * that it can be returned until the key is refreshed. Keeps the earlier entry if 'key' was
+     * already stale.
+     */
+    void _stashStaleValue(WithLock, const Key& key) {
+        if (_maxStalenessMillis.load() <= 0)
+            return;
+
+        if (auto cachedValue = _cache.get(key, CacheCausalConsistency::kLatestCached))
+            _staleValues.try_emplace(key, StaleValue{std::move(cachedValue), _now()});
+    }
+
+    /**
+     * Drops the stale values which can no longer be returned, so that keys which are not acquired
+     * again do not keep their previous values alive.
+     */
+    void _pruneStaleValues(WithLock) {
+        const auto maxStaleness = Milliseconds(_maxStalenessMillis.load());
+        if (maxStaleness <= Milliseconds(0)) {
+            _staleValues.clear();
+            return;
+        }
+
+        const auto now = _now();
+        for (auto it = _staleValues.begin(); it != _staleValues.end();) {
+            if (now - it->second.staleSince > maxStaleness)
+                _staleValues.erase(it++);
+            else
+                ++it;
+        }
+    }
+
+    /**
+     * Returns the stale value for 'key' if there is one and it has not exceeded the configured
+     * staleness bound.
+     */
+    boost::optional<ValueHandle> _getStaleValue(WithLock, const Key& key) {
+        const auto maxStaleness = Milliseconds(_maxStalenessMillis.load());
+        if (maxStaleness <= Milliseconds(0))
+            return boost::none;
+
+        auto it = _staleValues.find(key);
+        if (it == _staleValues.end())
+            return boost::none;
+
+        if (_now() - it->second.staleSince > maxStaleness) {
+            _staleValues.erase(it);
+            return boost::none;
+        }
+
+        _numStaleServes.fetchAndAdd(1);
+        return ValueHandle(typename Cache::ValueHandle(it->second.valueHandle), true);
+    }
+
     /**
      * This method implements an asynchronous "while (!valid)" loop over 'key', which must be on the
      * in-progress map.
@@ -406,6 +532,7 @@ private:
             // signal (those which are waiting for time < time at the store).
             auto& result = sw.getValue();
             auto promisesToSet = inProgressLookup.getPromisesLessThanTime(ul, result.t);
+            _staleValues.erase(key);
 
             auto valueHandleToSet = [&] {
                 if (result.v) {
@@ -469,6 +596,19 @@ private:
     //
     // This map is protected by '_mutex'.
     InProgressLookupsMap _inProgressLookups;
+
+    // Previous values of keys which were invalidated while stale-while-revalidate is enabled. An
+    // entry is removed once a lookup for its key succeeds or it exceeds '_maxStalenessMillis'.
+    //
+    // This map is protected by '_mutex' and must be destroyed before '_cache', since it holds
+    // handles to its values.
+    StaleValuesMap _staleValues;
+
+    // How long a stale value may be returned, or zero if stale-while-revalidate is disabled
+    AtomicWord<long long> _maxStalenessMillis{0};
+
+    // Number of times '_getStaleValue' returned a value
+    AtomicWord<long long> _numStaleServes{0};
 };
 
 /**
@@ -35,6 +35,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/read_through_cache.h"
 #include "mongo/util/scopeguard.h"
@@ -589,6 +590,67 @@ TEST_F(ReadThroughCacheAsyncTest, InvalidateCalledBeforeLookupTaskExecutes) {
     ASSERT_EQ(123, future.get()->counter);
 }
 
+TEST_F(ReadThroughCacheAsyncTest, StaleWhileRevalidateReturnsPreviousValueDuringRefresh) {
+    MockThreadPool threadPool;
+    int nextValue = 0;
+    Cache cache(getServiceContext(), threadPool, 1, [&](OperationContext*, const std::string&) {
+        return Cache::LookupResult(CachedValue(100 * ++nextValue));
+    });
+    cache.setStaleWhileRevalidateBound(Seconds(30));
+
+    auto future = cache.acquireAsync("TestKey");
+    threadPool.runMostRecentTask();
+    ASSERT_EQ(100, future.get()->counter);
+    ASSERT(!future.get().isStale());
+
+    cache.invalidate("TestKey");
+
+    // Readers get the previous value without waiting and share a single refresh (the mock thread
+    // pool asserts if a second lookup gets scheduled)
+    for (int i = 0; i < 2; i++) {
+        auto staleFuture = cache.acquireAsync("TestKey");
+        ASSERT(staleFuture.isReady());
+        ASSERT(staleFuture.get().isStale());
+        ASSERT_EQ(100, staleFuture.get()->counter);
+    }
+    ASSERT_EQ(2, cache.getStaleServesCount());
+
+    threadPool.runMostRecentTask();
+    ASSERT_EQ(2, cache.countLookups);
+
+    auto refreshedFuture = cache.acquireAsync("TestKey");
+    ASSERT(refreshedFuture.isReady());
+    ASSERT(!refreshedFuture.get().isStale());
+    ASSERT_EQ(200, refreshedFuture.get()->counter);
+}
+
+TEST_F(ReadThroughCacheAsyncTest, StaleWhileRevalidateWaitsForRefreshPastBound) {
+    auto clockSource = std::make_unique<ClockSourceMock>();
+    auto clock = clockSource.get();
+    getServiceContext()->setFastClockSource(std::move(clockSource));
+
+    MockThreadPool threadPool;
+    int nextValue = 0;
+    Cache cache(getServiceContext(), threadPool, 1, [&](OperationContext*, const std::string&) {
+        return Cache::LookupResult(CachedValue(100 * ++nextValue));
+    });
+    cache.setStaleWhileRevalidateBound(Seconds(30));
+
+    auto future = cache.acquireAsync("TestKey");
+    threadPool.runMostRecentTask();
+    ASSERT_EQ(100, future.get()->counter);
+
+    cache.invalidate("TestKey");
+    clock->advance(Seconds(31));
+
+    auto refreshedFuture = cache.acquireAsync("TestKey");
+    ASSERT(!refreshedFuture.isReady());
+    threadPool.runMostRecentTask();
+    ASSERT(!refreshedFuture.get().isStale());
+    ASSERT_EQ(200, refreshedFuture.get()->counter);
+    ASSERT_EQ(0, cache.getStaleServesCount());
+}
+
 TEST_F(ReadThroughCacheAsyncTest, CacheSizeZero) {
     MockThreadPool threadPool;
     auto fnTest = [&](auto cache) {
@@ -33,10 +33,27 @@
 #include <array>
 #include <iterator>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
+
 namespace mongo::str {
 namespace {
 constexpr char kHexChar[] = "0123456789abcdef";
 
+// Returns true if none of the 8 bytes at 'data' is a control character, a backslash, a double
+// quote, DEL or part of a multi-byte sequence. Such bytes are copied unchanged by every escaper.
+bool isPlainAscii8(const char* data) {
+    constexpr uint64_t kLowBits = 0x0101010101010101ULL;
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    auto hasZeroByte = [](uint64_t v) { return (v - kLowBits) & ~v & kHighBits; };
+
+    const uint64_t chunk = ConstDataView(data).read<LittleEndian<uint64_t>>();
+    // With no high bits set, the subtraction only borrows out of bytes below 0x20.
+    return !(chunk & kHighBits) && !((chunk - 0x20 * kLowBits) & ~chunk & kHighBits) &&
+        !hasZeroByte(chunk ^ ('\\' * kLowBits)) && !hasZeroByte(chunk ^ ('"' * kLowBits)) &&
+        !hasZeroByte(chunk ^ (0x7f * kLowBits));
+}
+
 // 'singleHandler' Function to write a valid single byte UTF-8 sequence with desired escaping.
 // 'invalidByteHandler' Function to write a byte of invalid UTF-8 encoding
 // 'twoEscaper' Function to write a valid two byte UTF-8 sequence with desired escaping, for C1
@@ -99,6 +116,11 @@ void escape(fmt::memory_buffer& buffer,
 
 
     while (it != end) {
+        if (std::distance(it, end) >= 8 && isPlainAscii8(it)) {
+            it += 8;
+            continue;
+        }
+
         uint8_t c = *it;
         bool bit7 = (c >> 7) & 1;
         if (MONGO_likely(!bit7)) {